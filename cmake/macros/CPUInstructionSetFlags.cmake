@@ -97,9 +97,13 @@ IF(CPU_i386 OR CPU_amd64)
 			SET(SSSE3_FLAG "/arch:SSE2")
 			SET(SSE41_FLAG "/arch:SSE2")
 		ENDIF(CPU_i386)
+		# MSVC does not need a flag for PCLMULQDQ intrinsics.
+		SET(AVX2_FLAG "/arch:AVX2")
 		IF(CMAKE_CXX_COMPILER_ID STREQUAL "Clang")
 			SET(SSSE3_FLAG "-mssse3")
 			SET(SSE41_FLAG "-msse4.1")
+			SET(PCLMUL_FLAG "-mpclmul")
+			SET(AVX2_FLAG "-mavx2")
 		ENDIF(CMAKE_CXX_COMPILER_ID STREQUAL "Clang")
 	ELSE()
 		IF(CPU_i386)
@@ -108,5 +112,7 @@ IF(CPU_i386 OR CPU_amd64)
 		ENDIF(CPU_i386)
 		SET(SSSE3_FLAG "-mssse3")
 		SET(SSE41_FLAG "-msse4.1")
+		SET(PCLMUL_FLAG "-mpclmul")
+		SET(AVX2_FLAG "-mavx2")
 	ENDIF()
 ENDIF(CPU_i386 OR CPU_amd64)
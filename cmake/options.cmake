@@ -134,6 +134,12 @@ IF(ENABLE_COVERAGE)
 	ADD_DEFINITIONS(-DGCOV)
 ENDIF(ENABLE_COVERAGE)
 
+# Tracing instrumentation for hot paths. (see src/rp_trace.h)
+OPTION(ENABLE_RP_TRACE "Enable opt-in tracing instrumentation. (chrome://tracing JSON)" OFF)
+IF(ENABLE_RP_TRACE)
+	ADD_DEFINITIONS(-DENABLE_RP_TRACE=1)
+ENDIF(ENABLE_RP_TRACE)
+
 # Enable NLS. (internationalization)
 IF(NOT WIN32 OR NOT MSVC)
 	OPTION(ENABLE_NLS "Enable NLS using gettext for localized messages." ON)
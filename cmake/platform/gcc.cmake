@@ -30,7 +30,7 @@ IF(MINGW)
 	# MinGW: Ignore warnings caused by casting from GetProcAddress().
 	SET(CFLAGS_WARNINGS ${CFLAGS_WARNINGS} -Wno-cast-function-type)
 ENDIF(MINGW)
-FOREACH(FLAG_TEST ${CFLAGS_WARNINGS} ${CFLAGS_WERROR_FORMAT} "-fstrict-aliasing" "-Werror=strict-aliasing" "-fno-common" "-fcf-protection" "-fno-math-errno")
+FOREACH(FLAG_TEST ${CFLAGS_WARNINGS} ${CFLAGS_WERROR_FORMAT} "-fstrict-aliasing" "-Werror=strict-aliasing" "-fno-common" "-fcf-protection" "-fno-math-errno" "-ffunction-sections" "-fdata-sections")
 	# CMake doesn't like certain characters in variable names.
 	STRING(REGEX REPLACE "/|:|=" "_" FLAG_TEST_VARNAME "${FLAG_TEST}")
 
@@ -243,6 +243,30 @@ IF(NOT CMAKE_SYSTEM MATCHES "Linux")
 		STRING(REPLACE "-Wl,${FLAG_REMOVE}" "" RP_MODULE_LINKER_FLAGS_COMMON "${RP_MODULE_LINKER_FLAGS_COMMON}")
 	ENDFOREACH(FLAG_REMOVE)
 ENDIF(NOT CMAKE_SYSTEM MATCHES "Linux")
+
+# Garbage-collect unreferenced sections in shared libraries and modules.
+# Together with -ffunction-sections/-fdata-sections, every parser
+# function and static table gets its own section, so the linker drops
+# anything unreachable from the exported API and groups what's left.
+# Parsers for systems that are never probed then stay in pages that
+# are never faulted in, reducing per-process RSS.
+SET(FLAG_TEST "--gc-sections")
+	IF(NOT DEFINED LDFLAG_${FLAG_TEST})
+		MESSAGE(STATUS "Checking if ld supports ${FLAG_TEST}")
+		IF(_ld_out MATCHES "${FLAG_TEST}")
+			MESSAGE(STATUS "Checking if ld supports ${FLAG_TEST} - yes")
+			SET(LDFLAG_${FLAG_TEST} 1 CACHE INTERNAL "Linker supports ${FLAG_TEST}")
+		ELSE()
+			MESSAGE(STATUS "Checking if ld supports ${FLAG_TEST} - no")
+			SET(LDFLAG_${FLAG_TEST} "" CACHE INTERNAL "Linker supports ${FLAG_TEST}")
+		ENDIF()
+	ENDIF()
+
+	IF(LDFLAG_${FLAG_TEST})
+		SET(RP_SHARED_LINKER_FLAGS_COMMON "${RP_SHARED_LINKER_FLAGS_COMMON} -Wl,${FLAG_TEST}")
+		SET(RP_MODULE_LINKER_FLAGS_COMMON "${RP_MODULE_LINKER_FLAGS_COMMON} -Wl,${FLAG_TEST}")
+	ENDIF(LDFLAG_${FLAG_TEST})
+UNSET(FLAG_TEST)
 ENDIF(NOT EMSCRIPTEN)
 
 # Debug builds: Check for -Og.
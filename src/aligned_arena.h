@@ -0,0 +1,229 @@
+/***************************************************************************
+ * ROM Properties Page shell extension.                                    *
+ * aligned_arena.h: Reusable per-thread arena for aligned scratch memory.  *
+ *                                                                         *
+ * Copyright (c) 2015-2023 by David Korth                                  *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#pragma once
+
+// Arena/region allocator built on aligned_malloc().
+//
+// Texture and image decoders allocate aligned scratch memory once per
+// image and free it immediately afterwards. During batch thumbnailing,
+// that's an aligned_malloc()/aligned_free() pair per file for buffers
+// of nearly identical size. The arena keeps one per-thread region
+// alive across images: allocations bump a pointer, and reset() makes
+// the region reusable without returning it to the system, so the
+// steady state performs no allocations at all.
+//
+// Usage (per image):
+//	AlignedArenaScope arena;
+//	uint8_t *const buf = arena.alloc<uint8_t>(16, size);
+//
+// The scratch memory is valid until the outermost scope on the current
+// thread is destroyed; do NOT keep pointers into the arena past that.
+
+#ifndef __cplusplus
+#  error aligned_arena.h is C++-only.
+#endif
+
+#include "aligned_malloc.h"
+
+// C includes (C++ namespace)
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+// C++ includes
+#include <vector>
+
+/**
+ * Per-thread arena of aligned scratch memory.
+ * Use AlignedArenaScope instead of accessing this class directly.
+ */
+class AlignedArena
+{
+public:
+	AlignedArena()
+		: m_highWater(0)
+		, m_baseSize(0)
+		, m_scopeDepth(0)
+	{}
+
+	~AlignedArena()
+	{
+		freeBlocks();
+	}
+
+	// Disable copy/assignment constructors.
+	AlignedArena(const AlignedArena &) = delete;
+	AlignedArena &operator=(const AlignedArena &) = delete;
+
+public:
+	/**
+	 * Get the arena for the current thread.
+	 * @return AlignedArena instance.
+	 */
+	static AlignedArena &instanceForCurrentThread(void)
+	{
+		static thread_local AlignedArena arena;
+		return arena;
+	}
+
+	/**
+	 * Allocate scratch memory from the arena.
+	 * The memory is NOT initialized, and is valid until the
+	 * outermost AlignedArenaScope on this thread is destroyed.
+	 *
+	 * @param alignment Alignment, in bytes. (power of two; maximum 64)
+	 * @param size Size, in bytes.
+	 * @return Allocated memory, or nullptr on allocation failure.
+	 */
+	void *alloc(size_t alignment, size_t size)
+	{
+		assert(alignment > 0 && alignment <= BLOCK_ALIGN);
+		assert((alignment & (alignment - 1)) == 0);
+
+		// Try the current block first.
+		if (!m_blocks.empty()) {
+			Block &block = m_blocks.back();
+			const size_t offset = alignUp(block.used, alignment);
+			if (offset + size <= block.size) {
+				block.used = offset + size;
+				m_highWater += size + alignment;
+				return &block.data[offset];
+			}
+		}
+
+		// Doesn't fit. Chain a new block.
+		// (The blocks are coalesced on the next reset().)
+		size_t block_size = (m_baseSize > MIN_BLOCK_SIZE ? m_baseSize : MIN_BLOCK_SIZE);
+		if (block_size < size) {
+			block_size = size;
+		}
+		uint8_t *const data = static_cast<uint8_t*>(aligned_malloc(BLOCK_ALIGN, block_size));
+		if (!data) {
+			// Allocation failure.
+			return nullptr;
+		}
+		m_blocks.push_back(Block{data, block_size, size});
+		m_highWater += size + alignment;
+		return data;
+	}
+
+	/**
+	 * Reset the arena for the next image.
+	 * All outstanding scratch pointers are invalidated.
+	 * The region is kept (and grown to the high-water mark if it
+	 * was split across multiple blocks) for reuse.
+	 */
+	void reset(void)
+	{
+		if (m_baseSize < m_highWater) {
+			m_baseSize = m_highWater;
+		}
+		m_highWater = 0;
+
+		if (m_blocks.size() == 1 && m_blocks[0].size >= m_baseSize) {
+			// Single block of sufficient size. Just rewind it.
+			m_blocks[0].used = 0;
+			return;
+		}
+
+		// Multiple blocks, or the block is smaller than the
+		// high-water mark. Free everything; the next alloc()
+		// will start with a single right-sized block.
+		freeBlocks();
+	}
+
+	/** Scope tracking (used by AlignedArenaScope) **/
+
+	void enterScope(void)
+	{
+		m_scopeDepth++;
+	}
+
+	void leaveScope(void)
+	{
+		assert(m_scopeDepth > 0);
+		if (m_scopeDepth > 0 && --m_scopeDepth == 0) {
+			// Outermost scope is done with the arena.
+			reset();
+		}
+	}
+
+private:
+	static inline size_t alignUp(size_t value, size_t alignment)
+	{
+		return (value + (alignment - 1)) & ~(alignment - 1);
+	}
+
+	void freeBlocks(void)
+	{
+		for (Block &block : m_blocks) {
+			aligned_free(block.data);
+		}
+		m_blocks.clear();
+	}
+
+private:
+	// Block alignment covers cache lines and all SIMD types in use.
+	static constexpr size_t BLOCK_ALIGN = 64;
+	// Don't bother with blocks smaller than this.
+	static constexpr size_t MIN_BLOCK_SIZE = 4096;
+
+	struct Block {
+		uint8_t *data;
+		size_t size;	// Total size, in bytes.
+		size_t used;	// Bytes allocated so far.
+	};
+
+	std::vector<Block> m_blocks;
+	size_t m_highWater;	// Bytes requested this cycle. (incl. alignment slack)
+	size_t m_baseSize;	// Largest cycle seen; target size after coalescing.
+	unsigned int m_scopeDepth;
+};
+
+/**
+ * RAII scope for per-thread arena scratch memory.
+ * The current thread's arena is reset when the outermost
+ * scope is destroyed.
+ */
+class AlignedArenaScope
+{
+public:
+	AlignedArenaScope()
+		: m_arena(AlignedArena::instanceForCurrentThread())
+	{
+		m_arena.enterScope();
+	}
+
+	~AlignedArenaScope()
+	{
+		m_arena.leaveScope();
+	}
+
+	// Disable copy/assignment constructors.
+	AlignedArenaScope(const AlignedArenaScope &) = delete;
+	AlignedArenaScope &operator=(const AlignedArenaScope &) = delete;
+
+	/**
+	 * Allocate scratch memory from the arena.
+	 * The memory is NOT initialized.
+	 *
+	 * @tparam T Element type.
+	 * @param alignment Alignment, in bytes. (power of two; maximum 64)
+	 * @param count Number of elements to allocate.
+	 * @return Allocated memory, or nullptr on allocation failure.
+	 */
+	template<typename T>
+	T *alloc(size_t alignment, size_t count)
+	{
+		return static_cast<T*>(m_arena.alloc(alignment, count * sizeof(T)));
+	}
+
+private:
+	AlignedArena &m_arena;
+};
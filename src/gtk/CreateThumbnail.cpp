@@ -15,7 +15,9 @@
 
 // Other rom-properties libraries
 #include "libromdata/RomDataFactory.hpp"
+#include "librpbase/img/RpPng.hpp"
 #include "librpfile/FileSystem.hpp"
+#include "libcachecommon/CacheKeys.hpp"
 using namespace LibRpBase;
 using namespace LibRpTexture;
 using namespace LibRomData;
@@ -335,6 +337,34 @@ static RomDataPtr openFromFilenameOrURI(const char *source_file, string &s_uri,
 	return {};
 }
 
+/**
+ * Store a copy of a generated thumbnail in the content-keyed cache.
+ * The copy is written to a temporary file and renamed into place.
+ * @param output_file		[in] Generated thumbnail (PNG)
+ * @param cache_filename	[in] Content cache filename
+ */
+static void storeContentCacheFile(const char *output_file, const string &cache_filename)
+{
+	if (FileSystem::rmkdir(cache_filename) != 0) {
+		// Unable to create the cache subdirectories.
+		return;
+	}
+
+	gchar *contents = nullptr;
+	gsize length = 0;
+	if (!g_file_get_contents(output_file, &contents, &length, nullptr)) {
+		return;
+	}
+
+	const string tmpFilename = cache_filename + ".tmp";
+	if (g_file_set_contents(tmpFilename.c_str(), contents, length, nullptr)) {
+		if (rename(tmpFilename.c_str(), cache_filename.c_str()) != 0) {
+			remove(tmpFilename.c_str());
+		}
+	}
+	g_free(contents);
+}
+
 /**
  * Thumbnail creator function for wrapper programs. (v2)
  * @param source_file Source file or URI (UTF-8)
@@ -356,6 +386,13 @@ G_MODULE_EXPORT int RP_C_API rp_create_thumbnail2(
 		return RPCT_ERROR_INVALID_FLAGS;
 	}
 
+	if (flags & RPCT_FLAG_USE_BUFFER_POOL) {
+		// Pool image buffers to reduce allocation churn when
+		// thumbnailing many files in a row, e.g. from the
+		// D-Bus thumbnailer daemon.
+		rp_image::setBufferPoolEnabled(true);
+	}
+
 	// Make sure glib is initialized.
 	// NOTE: This is a no-op as of glib-2.35.1.
 #if !GLIB_CHECK_VERSION(2,35,1)
@@ -375,13 +412,54 @@ G_MODULE_EXPORT int RP_C_API rp_create_thumbnail2(
 		return ret;
 	}
 
+	// Check the content-keyed thumbnail cache. Multiple dumps of the
+	// same title in different formats (e.g. ISO, WBFS, GCZ, and RVZ
+	// of one disc) share a single rendered image.
+	string content_cache_file;
+	bool fromContentCache = false;
+	const string contentId = romData->contentId();
+	if (!contentId.empty()) {
+		const string cacheKey = LibCacheCommon::getContentIdCacheKey(contentId, maximum_size);
+		if (!cacheKey.empty()) {
+			content_cache_file = LibCacheCommon::getCacheFilename(cacheKey);
+		}
+	}
+
 	// Create the thumbnail.
 	unique_ptr<CreateThumbnailPrivate> d(new CreateThumbnailPrivate());
 	CreateThumbnailPrivate::GetThumbnailOutParams_t outParams;
-	ret = d->getThumbnail(romData, maximum_size, &outParams);
-	if (ret != 0) {
-		// No image.
-		return RPCT_ERROR_SOURCE_FILE_NO_IMAGE;
+
+	if (!content_cache_file.empty()) {
+		const IRpFilePtr f_cache = std::make_shared<RpFile>(content_cache_file.c_str(), RpFile::FM_OPEN_READ);
+		if (f_cache->isOpen()) {
+			const rp_image_const_ptr cachedImg = RpPng::load(f_cache);
+			if (cachedImg && cachedImg->isValid()) {
+				// Content cache hit: reuse the rendered image.
+				// The output PNG is still written fresh below so
+				// the XDG tEXt chunks (URI, MTime) match this
+				// source file.
+				outParams.retImg = d->rpImageToImgClass(cachedImg);
+				if (d->isImgClassValid(outParams.retImg)) {
+					outParams.thumbSize.width = cachedImg->width();
+					outParams.thumbSize.height = cachedImg->height();
+					// NOTE: The original image dimensions aren't
+					// stored in the cache, so Thumb::Image::* will
+					// reflect the thumbnail size on a hit.
+					outParams.fullSize = outParams.thumbSize;
+					memset(&outParams.sBIT, 0, sizeof(outParams.sBIT));
+					cachedImg->get_sBIT(&outParams.sBIT);
+					fromContentCache = true;
+				}
+			}
+		}
+	}
+
+	if (!fromContentCache) {
+		ret = d->getThumbnail(romData, maximum_size, &outParams);
+		if (ret != 0) {
+			// No image.
+			return RPCT_ERROR_SOURCE_FILE_NO_IMAGE;
+		}
 	}
 
 	// Save the image using RpPngWriter.
@@ -409,6 +487,9 @@ G_MODULE_EXPORT int RP_C_API rp_create_thumbnail2(
 		goto cleanup;
 	}
 
+	// Thumbnails don't need maximum compression.
+	pngWriter->setCompressionProfile(RpPngWriter::CompressionProfile::Speed);
+
 	/** tEXt chunks. **/
 	// NOTE: These are written before IHDR in order to put the
 	// tEXt chunks before the IDAT chunk.
@@ -553,6 +634,13 @@ G_MODULE_EXPORT int RP_C_API rp_create_thumbnail2(
 		goto cleanup;
 	}
 
+	// Store a copy in the content-keyed cache for other dumps of
+	// the same title. Only the pixels are reused on a hit; the
+	// XDG tEXt chunks are rewritten per-file.
+	if (!fromContentCache && !content_cache_file.empty()) {
+		storeContentCacheFile(output_file, content_cache_file);
+	}
+
 cleanup:
 	d->freeImgClass(outParams.retImg);
 	return ret;
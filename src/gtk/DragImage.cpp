@@ -82,6 +82,9 @@ struct _RpDragImageClass {
 struct _RpDragImageCxx {
 	_RpDragImageCxx()
 		: anim(nullptr)
+		, last_req_width(-1)
+		, last_req_height(-1)
+		, force_update(true)
 	{}
 
 	~_RpDragImageCxx()
@@ -106,32 +109,47 @@ struct _RpDragImageCxx {
 		guint tmrIconAnim;	// Timer ID
 		int last_delay;		// Last delay value.
 		int last_frame_number;	// Last frame number.
+		int frames_width;	// Size iconFrames are rendered at.
+		int frames_height;	// (0 == original frame size)
 
 		void unregister_timer(void)
 		{
 			g_clear_handle_id(&tmrIconAnim, g_source_remove);
 		}
 
+		void clear_frame_cache(void)
+		{
+			for (PIMGTYPE &frame : iconFrames) {
+				if (frame) {
+					PIMGTYPE_unref(frame);
+					frame = nullptr;
+				}
+			}
+		}
+
 		anim_vars()
 			: tmrIconAnim(0)
 			, last_delay(0)
 			, last_frame_number(0)
+			, frames_width(0)
+			, frames_height(0)
 		{
 			iconFrames.fill(nullptr);
 		}
 		~anim_vars()
 		{
 			g_clear_handle_id(&tmrIconAnim, g_source_remove);
-
-			for (PIMGTYPE frame : iconFrames) {
-				if (frame) {
-					PIMGTYPE_unref(frame);
-				}
-			}
+			clear_frame_cache();
 		}
 	};
 	anim_vars *anim;
 
+	// Last size the pixmaps were rendered at.
+	// Used with force_update to skip redundant re-renders.
+	int last_req_width;
+	int last_req_height;
+	bool force_update;
+
 #if GTK_CHECK_VERSION(4,0,0)
 	// Temporary buffer for PNG data when dragging and dropping images.
 	VectorFilePtr pngData;
@@ -278,6 +296,53 @@ rp_drag_image_new(void)
 	return static_cast<GtkWidget*>(g_object_new(RP_TYPE_DRAG_IMAGE, nullptr));
 }
 
+/**
+ * Get the specified animation frame, rendered at the current size.
+ * Frames are converted and rescaled on demand, then cached until
+ * the size or the icon data changes.
+ * @param image RpDragImage
+ * @param frame Frame number
+ * @return PIMGTYPE, or nullptr on error. (owned by the frame cache)
+ */
+static PIMGTYPE
+rp_drag_image_get_anim_frame(RpDragImage *image, int frame)
+{
+	auto *const anim = image->cxx->anim;
+	assert(anim != nullptr);
+	assert(frame >= 0);
+	assert(frame < static_cast<int>(anim->iconFrames.size()));
+	if (!anim || frame < 0 || frame >= static_cast<int>(anim->iconFrames.size())) {
+		return nullptr;
+	}
+
+	if (anim->iconFrames[frame]) {
+		// Frame is already rendered.
+		return anim->iconFrames[frame];
+	}
+
+	const rp_image_const_ptr &src_frame = anim->iconAnimData->frames[frame];
+	if (!src_frame || !src_frame->isValid()) {
+		// NOTE: Allowing NULL frames here...
+		return nullptr;
+	}
+
+	PIMGTYPE img = rp_image_to_PIMGTYPE(src_frame);
+	if (img && anim->frames_width > 0 && anim->frames_height > 0 &&
+	    (src_frame->width() != anim->frames_width || src_frame->height() != anim->frames_height))
+	{
+		// Need to rescale the image.
+		// TODO: Verify High-DPI.
+		// TODO: Nearest-neighbor scaling?
+		PIMGTYPE scale_img = PIMGTYPE_scale(img, anim->frames_width, anim->frames_height, true);
+		if (scale_img) {
+			PIMGTYPE_unref(img);
+			img = scale_img;
+		}
+	}
+	anim->iconFrames[frame] = img;
+	return img;
+}
+
 /**
  * Update the pixmap(s).
  * @param image RpDragImage
@@ -306,11 +371,6 @@ rp_drag_image_update_pixmaps(RpDragImage *image)
 		return bRet;
 	}
 
-	if (image->curFrame) {
-		PIMGTYPE_unref(image->curFrame);
-		image->curFrame = nullptr;
-	}
-
 #if GTK_CHECK_VERSION(3,0,0)
 	// NOTE: In testing, the two sizes (minimum and natural) returned by
 	// gtk_widget_get_preferred_size() are both the same if
@@ -324,40 +384,42 @@ rp_drag_image_update_pixmaps(RpDragImage *image)
 #endif /* GTK_CHECK_VERSION(3,0,0) */
 	const bool doRescaleIfNeeded = (req_sz.width > 0 && req_sz.height > 0);
 
+	// If neither the data nor the size has changed, the current
+	// rendering is still valid, so keep it as-is.
+	// NOTE: The width/height notification handlers can call this
+	// function twice in a row if both values are changed.
+	if (!cxx->force_update && image->curFrame &&
+	    req_sz.width == cxx->last_req_width && req_sz.height == cxx->last_req_height)
+	{
+		image->dirty = false;
+		return true;
+	}
+	cxx->force_update = false;
+	cxx->last_req_width = req_sz.width;
+	cxx->last_req_height = req_sz.height;
+
+	if (image->curFrame) {
+		PIMGTYPE_unref(image->curFrame);
+		image->curFrame = nullptr;
+	}
+
 	// FIXME: Transparency isn't working for e.g. GALE01.gci.
 	// (Super Smash Bros. Melee)
 	if (anim && anim->iconAnimData) {
-		const IconAnimDataConstPtr &iconAnimData = anim->iconAnimData;
-
-		// Convert the frames to PIMGTYPE.
-		for (int i = iconAnimData->count-1; i >= 0; i--) {
-			// Remove the existing frame first.
-			if (anim->iconFrames[i]) {
-				PIMGTYPE_unref(anim->iconFrames[i]);
-				anim->iconFrames[i] = nullptr;
-			}
-
-			const rp_image_const_ptr &frame = iconAnimData->frames[i];
-			if (frame && frame->isValid()) {
-				// NOTE: Allowing NULL frames here...
-				PIMGTYPE img = rp_image_to_PIMGTYPE(frame);
-				if (img && doRescaleIfNeeded && (frame->width() != req_sz.width || frame->height() != req_sz.height)) {
-					// Need to rescale the image.
-					// TODO: Only check the first frame, then set a bool?
-					// TODO: Verify High-DPI.
-					// TODO: Nearest-neighbor scaling?
-					PIMGTYPE scale_img = PIMGTYPE_scale(img, req_sz.width, req_sz.height, true);
-					if (scale_img) {
-						PIMGTYPE_unref(img);
-						img = scale_img;
-					}
-				}
-				anim->iconFrames[i] = img;
-			}
+		// Invalidate the frame cache. Frames are converted on demand
+		// by rp_drag_image_get_anim_frame() and kept until the size
+		// or the icon data changes.
+		anim->clear_frame_cache();
+		if (doRescaleIfNeeded) {
+			anim->frames_width = req_sz.width;
+			anim->frames_height = req_sz.height;
+		} else {
+			anim->frames_width = 0;
+			anim->frames_height = 0;
 		}
 
 		// Set up the IconAnimHelper.
-		anim->iconAnimHelper.setIconAnimData(iconAnimData);
+		anim->iconAnimHelper.setIconAnimData(anim->iconAnimData);
 		if (anim->iconAnimHelper.isAnimated()) {
 			// Initialize the animation.
 			anim->last_frame_number = anim->iconAnimHelper.frameNumber();
@@ -366,7 +428,7 @@ rp_drag_image_update_pixmaps(RpDragImage *image)
 		}
 
 		// Show the first frame.
-		image->curFrame = PIMGTYPE_ref(anim->iconFrames[anim->iconAnimHelper.frameNumber()]);
+		image->curFrame = PIMGTYPE_ref(rp_drag_image_get_anim_frame(image, anim->iconAnimHelper.frameNumber()));
 #ifdef USE_GTK_PICTURE
 		gtk_picture_set_paintable(GTK_PICTURE(image->imageWidget), GDK_PAINTABLE(image->curFrame));
 #else /* !USE_GTK_PICTURE */
@@ -569,6 +631,7 @@ rp_drag_image_set_rp_image(RpDragImage *image, const rp_image_const_ptr &img)
 	// have changed.
 
 	cxx->img = img;
+	cxx->force_update = true;
 	if (!img) {
 		if (!cxx->anim || !cxx->anim->iconAnimData) {
 #ifdef USE_GTK_PICTURE
@@ -610,6 +673,7 @@ rp_drag_image_set_icon_anim_data(RpDragImage *image, const IconAnimDataConstPtr
 	// have changed.
 
 	anim->iconAnimData = iconAnimData;
+	cxx->force_update = true;
 	if (!iconAnimData) {
 		g_clear_handle_id(&anim->tmrIconAnim, g_source_remove);
 
@@ -645,6 +709,7 @@ rp_drag_image_clear(RpDragImage *image)
 	}
 
 	cxx->img.reset();
+	cxx->force_update = true;
 #ifdef USE_GTK_PICTURE
 	gtk_picture_set_paintable(GTK_PICTURE(image->imageWidget), nullptr);
 #else /* !USE_GTK_PICTURE */
@@ -681,10 +746,11 @@ rp_drag_image_anim_timer_func(RpDragImage *image)
 	if (frame != anim->last_frame_number) {
 		// New frame number.
 		// Update the icon.
+		PIMGTYPE frame_img = rp_drag_image_get_anim_frame(image, frame);
 #ifdef USE_GTK_PICTURE
-		gtk_picture_set_paintable(GTK_PICTURE(image->imageWidget), GDK_PAINTABLE(anim->iconFrames[frame]));
+		gtk_picture_set_paintable(GTK_PICTURE(image->imageWidget), GDK_PAINTABLE(frame_img));
 #else /* !USE_GTK_PICTURE */
-		gtk_image_set_from_PIMGTYPE(GTK_IMAGE(image->imageWidget), anim->iconFrames[frame]);
+		gtk_image_set_from_PIMGTYPE(GTK_IMAGE(image->imageWidget), frame_img);
 #endif /* USE_GTK_PICTURE */
 		anim->last_frame_number = frame;
 	}
@@ -14,6 +14,22 @@ using LibRpTexture::argb32_t;
 using LibRpTexture::rp_image;
 using LibRpTexture::rp_image_ptr;
 
+// C++ STL classes
+#include <mutex>
+#include <unordered_map>
+
+// Process-wide cache of decoded sprite sheets, keyed by resource filename.
+// Sprite sheet objects are usually short-lived, so this caches the decoded
+// sheet for the lifetime of the process instead of the object.
+// rp_image is reference-counted, so all instances share the same pixel data.
+static std::mutex map_imgCache_mutex;
+static std::unordered_map<std::string, rp_image_ptr> map_imgCache;
+
+// Process-wide cache of extracted sub-icons, keyed by resource filename and position.
+// PIMGTYPE is reference-counted, so cache hits hand out a new reference to the
+// same texture/surface/pixbuf instead of copying the sheet region again.
+static std::unordered_map<std::string, PIMGTYPE> map_subIconCache;
+
 /**
  * Sprite sheet loader
  * @param cols Number of columns
@@ -46,53 +62,73 @@ PIMGTYPE ISpriteSheet::getIcon(int col, int row, bool gray) const
 		return nullptr;
 	}
 
+	char gres_filename[64];
+	int ret = getFilename(gres_filename, sizeof(gres_filename), m_width, m_height, gray);
+	if (ret != 0) {
+		// Unable to get the filename.
+		return nullptr;
+	}
+
+	// Check the sub-icon cache first.
+	char subicon_key[80];
+	snprintf(subicon_key, sizeof(subicon_key), "%s?%d,%d", gres_filename, col, row);
+	std::lock_guard<std::mutex> lock(map_imgCache_mutex);
+	auto subIconIter = map_subIconCache.find(subicon_key);
+	if (subIconIter != map_subIconCache.end()) {
+		return PIMGTYPE_ref(subIconIter->second);
+	}
+
 	// Do we need to load the sprite sheet?
 	rp_image_ptr &imgSpriteSheet = gray
 		? const_cast<ISpriteSheet*>(this)->m_imgGray
 		: const_cast<ISpriteSheet*>(this)->m_img;
 	if (!imgSpriteSheet) {
-		// Load the sprite sheet.
-		char gres_filename[64];
-		int ret = getFilename(gres_filename, sizeof(gres_filename), m_width, m_height, gray);
-		if (ret != 0) {
-			// Unable to get the filename.
-			return nullptr;
+		// Check the process-wide cache first.
+		auto iter = map_imgCache.find(gres_filename);
+		if (iter != map_imgCache.end()) {
+			imgSpriteSheet = iter->second;
 		}
 
-		imgSpriteSheet = rp_image_load_png_from_gresource(gres_filename);
-		assert((bool)imgSpriteSheet);
 		if (!imgSpriteSheet) {
-			// Unable to load the sprite sheet.
-			return nullptr;
-		}
-
-		// Needs to be ARGB32.
-		switch (imgSpriteSheet->format()) {
-			case rp_image::Format::CI8:
-				imgSpriteSheet = imgSpriteSheet->dup_ARGB32();
-				break;
-			case rp_image::Format::ARGB32:
-				break;
-			default:
-				assert(!"Invalid rp_image format");
-				imgSpriteSheet.reset();
+			// Load the sprite sheet.
+			imgSpriteSheet = rp_image_load_png_from_gresource(gres_filename);
+			assert((bool)imgSpriteSheet);
+			if (!imgSpriteSheet) {
+				// Unable to load the sprite sheet.
 				return nullptr;
-		}
+			}
+
+			// Needs to be ARGB32.
+			switch (imgSpriteSheet->format()) {
+				case rp_image::Format::CI8:
+					imgSpriteSheet = imgSpriteSheet->dup_ARGB32();
+					break;
+				case rp_image::Format::ARGB32:
+					break;
+				default:
+					assert(!"Invalid rp_image format");
+					imgSpriteSheet.reset();
+					return nullptr;
+			}
 
 #ifdef RP_GTK_USE_CAIRO
-		// Cairo needs premultiplied alpha.
-		imgSpriteSheet->premultiply();
+			// Cairo needs premultiplied alpha.
+			imgSpriteSheet->premultiply();
 #endif /* RP_GTK_USE_CAIRO */
 
-		// Make sure the bitmap has the expected size.
-		assert(imgSpriteSheet->width()  == (int)(m_width * m_cols));
-		assert(imgSpriteSheet->height() == (int)(m_height * m_rows));
-		if (imgSpriteSheet->width()  != (int)(m_width * m_cols) ||
-		    imgSpriteSheet->height() != (int)(m_height * m_rows))
-		{
-			// Incorrect size. We can't use it.
-			imgSpriteSheet.reset();
-			return nullptr;
+			// Make sure the bitmap has the expected size.
+			assert(imgSpriteSheet->width()  == (int)(m_width * m_cols));
+			assert(imgSpriteSheet->height() == (int)(m_height * m_rows));
+			if (imgSpriteSheet->width()  != (int)(m_width * m_cols) ||
+			    imgSpriteSheet->height() != (int)(m_height * m_rows))
+			{
+				// Incorrect size. We can't use it.
+				imgSpriteSheet.reset();
+				return nullptr;
+			}
+
+			// Cache the decoded sprite sheet.
+			map_imgCache.emplace(gres_filename, imgSpriteSheet);
 		}
 	}
 
@@ -107,7 +143,7 @@ PIMGTYPE ISpriteSheet::getIcon(int col, int row, bool gray) const
 		static_cast<const uint8_t*>(imgSpriteSheet->bits()) + yoffset + xoffset);
 	PIMGTYPE subIcon = nullptr;
 #if defined(RP_GTK_USE_GDKTEXTURE)
-	const int data_len = ((m_height - 1) * src_stride) + (m_height * sizeof(uint32_t));
+	const int data_len = ((m_height - 1) * src_stride) + (m_width * sizeof(uint32_t));
 	GBytes *const pBytes = g_bytes_new(pSrcBits, data_len);
 	if (pBytes) {
 		subIcon = gdk_memory_texture_new(m_width, m_height, GDK_MEMORY_B8G8R8A8, pBytes, src_stride);
@@ -188,5 +224,9 @@ PIMGTYPE ISpriteSheet::getIcon(int col, int row, bool gray) const
 	}
 #endif
 
+	// Cache the extracted sub-icon for future requests.
+	if (subIcon) {
+		map_subIconCache.emplace(subicon_key, PIMGTYPE_ref(subIcon));
+	}
 	return subIcon;
 }
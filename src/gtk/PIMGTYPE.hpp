@@ -87,7 +87,14 @@ static inline PIMGTYPE rp_image_to_PIMGTYPE(const LibRpTexture::rp_image *img, b
  */
 static inline PIMGTYPE rp_image_to_PIMGTYPE(const LibRpTexture::rp_image_ptr &img, bool premultiply = true)
 {
+#if defined(RP_GTK_USE_GDKTEXTURE)
+	// Zero-copy: The GdkTexture adopts the pixel data and
+	// holds a reference to the rp_image for its lifetime.
+	((void)premultiply);
+	return GdkTextureConv::rp_image_to_GdkTexture(img);
+#else
 	return rp_image_to_PIMGTYPE(img.get(), premultiply);
+#endif
 }
 
 /**
@@ -98,7 +105,14 @@ static inline PIMGTYPE rp_image_to_PIMGTYPE(const LibRpTexture::rp_image_ptr &im
  */
 static inline PIMGTYPE rp_image_to_PIMGTYPE(const LibRpTexture::rp_image_const_ptr &img, bool premultiply = true)
 {
+#if defined(RP_GTK_USE_GDKTEXTURE)
+	// Zero-copy: The GdkTexture adopts the pixel data and
+	// holds a reference to the rp_image for its lifetime.
+	((void)premultiply);
+	return GdkTextureConv::rp_image_to_GdkTexture(img);
+#else
 	return rp_image_to_PIMGTYPE(img.get(), premultiply);
+#endif
 }
 
 /**
@@ -109,7 +123,7 @@ static inline PIMGTYPE rp_image_to_PIMGTYPE(const LibRpTexture::rp_image_const_p
  */
 static inline PIMGTYPE rp_image_to_PIMGTYPE(const LibRpTexture::rp_image_ptr *pImg, bool premultiply = true)
 {
-	return rp_image_to_PIMGTYPE(pImg->get(), premultiply);
+	return rp_image_to_PIMGTYPE(*pImg, premultiply);
 }
 
 /**
@@ -120,7 +134,7 @@ static inline PIMGTYPE rp_image_to_PIMGTYPE(const LibRpTexture::rp_image_ptr *pI
  */
 static inline PIMGTYPE rp_image_to_PIMGTYPE(const LibRpTexture::rp_image_const_ptr *pImg, bool premultiply = true)
 {
-	return rp_image_to_PIMGTYPE(pImg->get(), premultiply);
+	return rp_image_to_PIMGTYPE(*pImg, premultiply);
 }
 #endif /* __cplusplus **/
 
@@ -9,11 +9,118 @@
 #include "stdafx.h"
 #include "ProxyForUrl.hpp"
 
+// C includes (C++ namespace)
+#include <ctime>
+
 // C++ STL classes
+#include <mutex>
+#include <unordered_map>
 using std::string;
 
+namespace {
+
+/**
+ * Proxy resolution cache, keyed by URL scheme+host.
+ *
+ * g_proxy_resolver_lookup() can involve a D-Bus round trip on
+ * GNOME, so a fetch burst should only resolve the proxy once.
+ * The short TTL bounds staleness; proxyForUrl_clearCache() can
+ * be used as an invalidation hook on settings change.
+ */
+class ProxyCache
+{
+public:
+	ProxyCache() = default;
+
+private:
+	RP_DISABLE_COPY(ProxyCache)
+
+public:
+	// Cache TTL, in seconds.
+	static constexpr time_t TTL = 30;
+
+	/**
+	 * Look up a cached proxy resolution.
+	 * @param key		[in] URL scheme+host.
+	 * @param pProxy	[out] Cached proxy. (may be empty for "no proxy")
+	 * @return True if a valid cache entry was found.
+	 */
+	bool lookup(const string &key, string *pProxy)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto iter = m_map.find(key);
+		if (iter == m_map.end()) {
+			return false;
+		}
+		if (time(nullptr) >= iter->second.expiry) {
+			// Entry has expired.
+			m_map.erase(iter);
+			return false;
+		}
+		*pProxy = iter->second.proxy;
+		return true;
+	}
+
+	/**
+	 * Store a proxy resolution.
+	 * @param key	[in] URL scheme+host.
+	 * @param proxy	[in] Resolved proxy. (may be empty for "no proxy")
+	 */
+	void store(const string &key, const string &proxy)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		Entry &entry = m_map[key];
+		entry.proxy = proxy;
+		entry.expiry = time(nullptr) + TTL;
+	}
+
+	/**
+	 * Clear the cache.
+	 */
+	void clear(void)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_map.clear();
+	}
+
+private:
+	struct Entry {
+		string proxy;
+		time_t expiry;
+	};
+
+	std::mutex m_mutex;
+	std::unordered_map<string, Entry> m_map;
+};
+
+// Proxy resolution cache.
+ProxyCache g_proxyCache;
+
+/**
+ * Get the scheme+host portion of a URL, e.g. "https://art.gametdb.com".
+ * @param url URL
+ * @return Scheme+host, or empty string if the URL has no scheme.
+ */
+string urlSchemeHost(const char *url)
+{
+	const char *const scheme_end = strstr(url, "://");
+	if (!scheme_end) {
+		// No scheme.
+		return {};
+	}
+	const char *const host_end = strchr(scheme_end + 3, '/');
+	return (host_end ? string(url, host_end - url) : string(url));
+}
+
+} //namespace (anonymous)
+
 /**
  * Get the proxy for the specified URL.
+ *
+ * Results are cached per URL scheme+host with a short TTL,
+ * since the GProxyResolver lookup can involve a D-Bus round
+ * trip on GNOME.
+ *
  * @param url URL
  * @return Proxy, or empty string if no proxy is needed.
  */
@@ -22,6 +129,13 @@ string proxyForUrl(const char *url)
 	// TODO: Support multiple proxies?
 	string ret;
 
+	// Check the cache first.
+	const string cache_key = urlSchemeHost(url);
+	if (!cache_key.empty() && g_proxyCache.lookup(cache_key, &ret)) {
+		// Cache hit. (possibly "no proxy")
+		return ret;
+	}
+
 	GProxyResolver *const proxy_resolver = g_proxy_resolver_get_default();
 	assert(proxy_resolver != nullptr);
 	if (!proxy_resolver) {
@@ -43,5 +157,19 @@ string proxyForUrl(const char *url)
 		ret.assign(proxy);
 	}
 	g_strfreev(proxies);
+
+	// Cache the result, including "no proxy" results.
+	if (!cache_key.empty()) {
+		g_proxyCache.store(cache_key, ret);
+	}
 	return ret;
 }
+
+/**
+ * Clear the proxy resolution cache.
+ * Call this when the system proxy settings have changed.
+ */
+void proxyForUrl_clearCache(void)
+{
+	g_proxyCache.clear();
+}
@@ -13,7 +13,18 @@
 
 /**
  * Get the proxy for the specified URL.
+ *
+ * Results are cached per URL scheme+host with a short TTL,
+ * since the GProxyResolver lookup can involve a D-Bus round
+ * trip on GNOME.
+ *
  * @param url URL
  * @return Proxy, or empty string if no proxy is needed.
  */
 std::string proxyForUrl(const char *url);
+
+/**
+ * Clear the proxy resolution cache.
+ * Call this when the system proxy settings have changed.
+ */
+void proxyForUrl_clearCache(void);
@@ -61,6 +61,7 @@ static GParamSpec *props[PROP_LAST];
 // NOTE: Don't make these static. They're needed in RomDataView_ops.cpp.
 GQuark RFT_BITFIELD_value_quark = 0;
 GQuark RFT_LISTDATA_rows_visible_quark = 0;
+GQuark RFT_LISTDATA_icon_src_quark = 0;
 GQuark RFT_fieldIdx_quark = 0;
 GQuark RFT_STRING_warning_quark = 0;
 
@@ -127,6 +128,7 @@ rp_rom_data_view_class_init(RpRomDataViewClass *klass)
 	// because the extension can be unloaded.
 	RFT_BITFIELD_value_quark = g_quark_from_string("RFT_BITFIELD_value");
 	RFT_LISTDATA_rows_visible_quark = g_quark_from_string("RFT_LISTDATA_rows_visible");
+	RFT_LISTDATA_icon_src_quark = g_quark_from_string("RFT_LISTDATA_icon_src");
 	RFT_fieldIdx_quark = g_quark_from_string("RFT_fieldIdx");
 	RFT_STRING_warning_quark = g_quark_from_string("RFT_STRING_warning");
 
@@ -134,7 +134,27 @@ bind_listitem_cb(GtkListItemFactory *factory, GtkListItem *list_item, gpointer u
 		case RP_LIST_DATA_ITEM_COL0_TYPE_ICON:
 			// Column 0 is an icon.
 			if (column == 0) {
-				gtk_picture_set_paintable(GTK_PICTURE(widget), GDK_PAINTABLE(rp_list_data_item_get_icon(item)));
+				PIMGTYPE icon = rp_list_data_item_get_icon(item);
+				if (!icon) {
+					// Icon hasn't been converted yet.
+					// Icons are converted when a row is first bound,
+					// so only rows that are actually displayed pay
+					// for the conversion. The converted icon is
+					// cached in the RpListDataItem.
+					auto *const pIconSrc = static_cast<const rp_image_const_ptr*>(
+						g_object_get_qdata(G_OBJECT(item), RFT_LISTDATA_icon_src_quark));
+					if (pIconSrc && *pIconSrc) {
+						PIMGTYPE pixbuf = rp_image_to_PIMGTYPE(*pIconSrc);
+						if (pixbuf) {
+							// NOTE: GtkPicture *can* scale the pixbuf itself.
+							// Using GtkPicture to scale it instead of scaling here.
+							rp_list_data_item_set_icon(item, pixbuf);
+							PIMGTYPE_unref(pixbuf);
+							icon = rp_list_data_item_get_icon(item);
+						}
+					}
+				}
+				gtk_picture_set_paintable(GTK_PICTURE(widget), GDK_PAINTABLE(icon));
 			} else {
 				gtk_label_set_markup(GTK_LABEL(widget), rp_list_data_item_get_column_text(item, column-1));
 			}
@@ -361,6 +381,10 @@ rp_rom_data_view_init_listdata(RpRomDataView *page, const RomFields::Field &fiel
 	if (hasCheckboxes) {
 		checkboxes = field.data.list_data.mxd.checkboxes;
 	}
+	// NOTE: Items are collected and added with a single splice
+	// so the sort model only re-sorts once instead of per-row.
+	vector<gpointer> items;
+	items.reserve(list_data->size());
 	unsigned int row = 0;	// for icons [TODO: Use iterator?]
 	for (const vector<string> &data_row : *list_data) {
 		// FIXME: Skip even if we don't have checkboxes?
@@ -379,15 +403,16 @@ rp_rom_data_view_init_listdata(RpRomDataView *page, const RomFields::Field &fiel
 			checkboxes >>= 1;
 		} else if (hasIcons) {
 			// Icon column
+			// NOTE: The icon is converted when the row is first bound
+			// (see bind_listitem_cb), so opening a property page with
+			// a large list doesn't convert an icon for every row.
+			// Save a pointer to the source rp_image for the bind handler.
+			// The field (and hence the icons vector) outlives the view.
 			const rp_image_const_ptr &icon = field.data.list_data.mxd.icons->at(row);
 			if (icon) {
-				PIMGTYPE pixbuf = rp_image_to_PIMGTYPE(icon);
-				if (pixbuf) {
-					// NOTE: GtkPicture *can* scale the pixbuf itself.
-					// Using GtkPicture to scale it instead of scaling here.
-					rp_list_data_item_set_icon(item, pixbuf);
-					PIMGTYPE_unref(pixbuf);
-				}
+				g_object_set_qdata(G_OBJECT(item),
+					RFT_LISTDATA_icon_src_quark,
+					(gpointer)&icon);
 			}
 		}
 
@@ -415,11 +440,18 @@ rp_rom_data_view_init_listdata(RpRomDataView *page, const RomFields::Field &fiel
 			}
 		}
 
-		g_list_store_append(listStore, item);
-		g_object_unref(item);
+		items.push_back(item);
 		row++;
 	}
 
+	// Add all of the items in one pass.
+	if (!items.empty()) {
+		g_list_store_splice(listStore, 0, 0, items.data(), static_cast<guint>(items.size()));
+		for (gpointer item : items) {
+			g_object_unref(item);
+		}
+	}
+
 	// Scroll area for the GtkTreeView.
 #if GTK_CHECK_VERSION(4,0,0)
 	GtkWidget *const scrolledWindow = gtk_scrolled_window_new();
@@ -147,6 +147,7 @@ G_BEGIN_DECLS
 
 extern GQuark RFT_BITFIELD_value_quark;
 extern GQuark RFT_LISTDATA_rows_visible_quark;
+extern GQuark RFT_LISTDATA_icon_src_quark;
 extern GQuark RFT_fieldIdx_quark;
 extern GQuark RFT_STRING_warning_quark;
 
@@ -38,13 +38,16 @@ GdkTexture *GdkTextureConv::rp_image_to_GdkTexture(const rp_image *img)
 	GdkTexture *texture = nullptr;
 	switch (img->format()) {
 		case rp_image::Format::ARGB32: {
-			// Create a GdkMemoryTexture using the original image data directly.
-			// NOTE: The data here technically isn't static, but we don't want to do *two* copies.
+			// Create a GdkMemoryTexture using a copy of the image data.
+			// NOTE: GdkMemoryTexture does a g_bytes_ref() if the stride matches
+			// what it expects, so g_bytes_new_static() would leave the texture
+			// pointing at freed memory if the rp_image is deleted first.
+			// Without a reference to keep the rp_image alive, we have to copy.
+			// Use the rp_image_const_ptr overload to get zero-copy adoption.
 			const int stride = img->stride();
-			GBytes *const pBytes = g_bytes_new_static(img->bits(), img->data_len());
+			GBytes *const pBytes = g_bytes_new(img->bits(), img->data_len());
 			assert(pBytes != nullptr);
 			if (pBytes) {
-				// gdk_memory_texture_new() creates a copy of pBytes.
 				// TODO: Verify format on big-endian.
 				texture = gdk_memory_texture_new(width, height, GDK_MEMORY_B8G8R8A8, pBytes, stride);
 				g_bytes_unref(pBytes);
@@ -133,3 +136,55 @@ GdkTexture *GdkTextureConv::rp_image_to_GdkTexture(const rp_image *img)
 
 	return texture;
 }
+
+/**
+ * Convert an rp_image to GdkTexture.
+ *
+ * For ARGB32 images, the texture adopts the rp_image's pixel data
+ * directly and holds a reference to the rp_image for its lifetime,
+ * so no copy is made.
+ *
+ * @param img	[in] rp_image.
+ * @return GdkTexture, or nullptr on error.
+ */
+GdkTexture *GdkTextureConv::rp_image_to_GdkTexture(const rp_image_const_ptr &img)
+{
+	assert(img != nullptr);
+	if (unlikely(!img || !img->isValid()))
+		return nullptr;
+
+	if (img->format() != rp_image::Format::ARGB32) {
+		// CI8 (and anything else) needs a conversion pass,
+		// so there's nothing to adopt. Use the copying version.
+		return rp_image_to_GdkTexture(img.get());
+	}
+
+	const int width = img->width();
+	const int height = img->height();
+	assert(width > 0);
+	assert(height > 0);
+	if (width <= 0 || height <= 0)
+		return nullptr;
+
+	// Wrap the image data in a GBytes that holds an rp_image reference.
+	// GdkMemoryTexture does a g_bytes_ref() if the stride matches what
+	// it expects, so no pixel data is copied in the common case.
+	// The rp_image is immutable once decoded, so sharing the buffer is safe.
+	GdkTexture *texture = nullptr;
+	auto *const pImgRef = new rp_image_const_ptr(img);
+	GBytes *const pBytes = g_bytes_new_with_free_func(img->bits(), img->data_len(),
+		[](gpointer data) {
+			delete static_cast<rp_image_const_ptr*>(data);
+		}, pImgRef);
+	assert(pBytes != nullptr);
+	if (pBytes) {
+		// TODO: Verify format on big-endian.
+		texture = gdk_memory_texture_new(width, height, GDK_MEMORY_B8G8R8A8, pBytes, img->stride());
+		g_bytes_unref(pBytes);
+	} else {
+		// g_bytes_new_with_free_func() failed.
+		delete pImgRef;
+	}
+
+	return texture;
+}
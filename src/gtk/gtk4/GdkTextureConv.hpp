@@ -13,9 +13,9 @@
 // make a GdkTexture rp_image backend.
 
 #include "librpcpuid/cpu_dispatch.h"
-namespace LibRpTexture {
-	class rp_image;
-}
+
+// librptexture
+#include "librptexture/img/rp_image.hpp"
 
 namespace GdkTextureConv {
 
@@ -26,4 +26,16 @@ namespace GdkTextureConv {
  */
 GdkTexture *rp_image_to_GdkTexture(const LibRpTexture::rp_image *img);
 
+/**
+ * Convert an rp_image to GdkTexture.
+ *
+ * For ARGB32 images, the texture adopts the rp_image's pixel data
+ * directly and holds a reference to the rp_image for its lifetime,
+ * so no copy is made.
+ *
+ * @param img	[in] rp_image.
+ * @return GdkTexture, or nullptr on error.
+ */
+GdkTexture *rp_image_to_GdkTexture(const LibRpTexture::rp_image_const_ptr &img);
+
 } //namespace GdkTextureConv
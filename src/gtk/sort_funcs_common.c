@@ -9,6 +9,56 @@
 #include "stdafx.h"
 #include "sort_funcs_common.h"
 
+/** Memoized collation keys **/
+
+// Casefolding and collating both strings on every comparison is
+// expensive for large lists, since an O(n log n) sort re-processes
+// each string O(log n) times. Instead, compute a collation key with
+// g_utf8_collate_key() once per distinct string and compare the keys
+// with strcmp().
+// NOTE: GTK sorting happens on the main thread, so no locking is needed.
+#define COLLATE_KEY_CACHE_MAX_ENTRIES 16384U
+static GHashTable *collate_key_cache = NULL;
+
+/**
+ * Get the casefolded collation key for a string, caching it.
+ * @param str String (must not be NULL)
+ * @return Collation key (owned by the cache)
+ */
+static const char *get_collate_key(const char *str)
+{
+	const char *key = g_hash_table_lookup(collate_key_cache, str);
+	if (!key) {
+		gchar *const strCF = g_utf8_casefold(str, -1);
+		gchar *const newKey = g_utf8_collate_key(strCF, -1);
+		g_free(strCF);
+		g_hash_table_insert(collate_key_cache, g_strdup(str), newKey);
+		key = newKey;
+	}
+	return key;
+}
+
+/**
+ * Compare two strings using memoized casefolded collation keys.
+ * Both strings must be non-NULL.
+ * @param strA
+ * @param strB
+ * @return -1, 0, or 1 (like strcmp())
+ */
+static gint collate_key_compare(const char *strA, const char *strB)
+{
+	if (G_UNLIKELY(!collate_key_cache)) {
+		collate_key_cache = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
+	} else if (G_UNLIKELY(g_hash_table_size(collate_key_cache) >= COLLATE_KEY_CACHE_MAX_ENTRIES)) {
+		// The cache is getting too big. Clear it out.
+		// NOTE: Must be done before looking up either key;
+		// otherwise, the first key could be freed by the second lookup.
+		g_hash_table_remove_all(collate_key_cache);
+	}
+
+	return strcmp(get_collate_key(strA), get_collate_key(strB));
+}
+
 /**
  * String sorting function for COLSORT_STANDARD (case-sensitive).
  * @param strA
@@ -41,13 +91,8 @@ gint rp_sort_string_nocase(const char *strA, const char *strB)
 			ret = (!strA ? -1 : 1);
 		}
 	} else {
-		// Casefold the strings, then use glib's string collation function.
-		// TODO: Maybe precompute collation values with g_utf8_collate_key()?
-		gchar *strCF_A = g_utf8_casefold(strA, -1);
-		gchar *strCF_B = g_utf8_casefold(strB, -1);
-		ret = g_utf8_collate(strCF_A, strCF_B);
-		g_free(strCF_A);
-		g_free(strCF_B);
+		// Compare memoized casefolded collation keys.
+		ret = collate_key_compare(strA, strB);
 	}
 
 	return ret;
@@ -85,13 +130,8 @@ gint rp_sort_string_numeric(const char *strA, const char *strB)
 				ret = (!strA ? -1 : 1);
 			}
 		} else {
-			// Casefold the strings, then use glib's string collation function.
-			// TODO: Maybe precompute collation values with g_utf8_collate_key()?
-			gchar *strCF_A = g_utf8_casefold(strA, -1);
-			gchar *strCF_B = g_utf8_casefold(strB, -1);
-			ret = g_utf8_collate(strCF_A, strCF_B);
-			g_free(strCF_A);
-			g_free(strCF_B);
+			// Compare memoized casefolded collation keys.
+			ret = collate_key_compare(strA, strB);
 		}
 	} else if (valA < valB) {
 		ret = -1;
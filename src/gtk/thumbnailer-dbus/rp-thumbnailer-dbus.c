@@ -21,6 +21,7 @@
 #include <stdbool.h>
 #include <stdio.h>
 #include <string.h>
+#include <unistd.h>
 
 // from tumbler-utils.h
 #define g_dbus_async_return_val_if_fail(expr, invocation, val) \
@@ -35,6 +36,14 @@ G_STMT_START { \
 	} \
 } G_STMT_END
 
+/**
+ * rp_create_thumbnail2() flags
+ */
+typedef enum {
+	RPCT_FLAG_NO_XDG_THUMBNAIL_METADATA	= (1U << 0),	/*< Don't add XDG thumbnail metadata */
+	RPCT_FLAG_USE_BUFFER_POOL		= (1U << 1),	/*< Pool image buffers (batch thumbnailing) */
+} RpCreateThumbnailFlags;
+
 /* Property identifiers. */
 typedef enum {
 	PROP_0,
@@ -69,7 +78,9 @@ static void	rp_thumbnailer_get_property	(GObject	*object,
 						 GParamSpec	*pspec);
 
 static gboolean	rp_thumbnailer_timeout		(RpThumbnailer	*thumbnailer);
-static gboolean	rp_thumbnailer_process		(RpThumbnailer	*thumbnailer);
+static void	rp_thumbnailer_process_request	(gpointer	 data,
+						 gpointer	 user_data);
+static gboolean	rp_thumbnailer_request_done	(gpointer	 user_data);
 
 // D-Bus methods.
 static gboolean	rp_thumbnailer_queue		(SpecializedThumbnailer1 *skeleton,
@@ -93,6 +104,9 @@ struct _RpThumbnailerClass {
 
 #define SHUTDOWN_TIMEOUT_SECONDS 30U
 
+// Maximum number of worker threads.
+#define MAX_WORKER_THREADS 8
+
 // Thumbnail request information.
 struct request_info {
 	gchar *uri;
@@ -101,13 +115,64 @@ struct request_info {
 	bool urgent;	// 'urgent' value
 };
 
+// Completed request information.
+// Allocated by the worker thread; signals are emitted
+// from the main loop by rp_thumbnailer_request_done().
+struct request_done_info {
+	RpThumbnailer *thumbnailer;	// owned reference
+	gchar *uri;			// owned
+	guint32 handle;
+	int ret;			// 0 on success
+	int error_code;			// D-Bus Error signal code
+	const char *message;		// Error message (static string)
+};
+
+// In-flight request coalescing.
+// Concurrent requests for the same URI and flavor run the pipeline
+// once; duplicates attach to the first request and get their
+// completion signals when it finishes.
+struct inflight_entry {
+	GSList *followers;	// duplicate requests (element: struct request_info*)
+};
+
+/**
+ * Build the in-flight request table key for a URI and flavor.
+ * @param uri	[in] URI
+ * @param large	[in] True for the 'large' flavor; false for 'normal'
+ * @return Newly-allocated key string. (g_free() when done)
+ */
+static gchar *
+rp_thumbnailer_inflight_key(const gchar *uri, bool large)
+{
+	return g_strdup_printf("%c%s", (large ? 'L' : 'N'), uri);
+}
+
+/**
+ * Free an in-flight entry, including any attached duplicate requests.
+ * @param data struct inflight_entry*
+ */
+static void
+rp_thumbnailer_inflight_entry_free(gpointer data)
+{
+	struct inflight_entry *const entry = (struct inflight_entry*)data;
+	for (GSList *l = entry->followers; l != NULL; l = l->next) {
+		struct request_info *const req = (struct request_info*)l->data;
+		g_free(req->uri);
+		g_free(req);
+	}
+	g_slist_free(entry->followers);
+	g_free(entry);
+}
+
 struct _RpThumbnailer {
 	GObject __parent__;
 	SpecializedThumbnailer1 *skeleton;
 
-	GQueue request_queue;	// Request queue (element is struct request_info*)
+	GThreadPool *pool;	// Worker pool (element is struct request_info*)
+	GMutex inflight_mutex;	// Guards 'inflight'
+	GHashTable *inflight;	// In-flight requests (key: flavor+URI; value: struct inflight_entry*)
+	gint num_pending;	// Number of requests in flight (atomic)
 	guint timeout_id;	// Shutdown timeout
-	guint idle_process;	// Idle function for processing
 	guint32 last_handle;	// Last handle value
 
 	/** Status **/
@@ -206,6 +271,25 @@ rp_thumbnailer_constructed(GObject *object)
 	g_signal_connect(thumbnailer->skeleton, "handle-dequeue",
 		G_CALLBACK(rp_thumbnailer_dequeue), thumbnailer);
 
+	// Create the worker pool, bounded by the number of CPU cores.
+	// The file manager can hand us hundreds of URIs in a row, so
+	// running the decodes in parallel saturates the machine instead
+	// of one core. libromdata stays loaded in this process, so its
+	// state stays warm across requests.
+	long n_threads = sysconf(_SC_NPROCESSORS_ONLN);
+	if (n_threads < 1) {
+		n_threads = 1;
+	} else if (n_threads > MAX_WORKER_THREADS) {
+		n_threads = MAX_WORKER_THREADS;
+	}
+	thumbnailer->pool = g_thread_pool_new(rp_thumbnailer_process_request,
+		thumbnailer, (gint)n_threads, FALSE, NULL);
+
+	// In-flight request table for coalescing duplicate requests.
+	g_mutex_init(&thumbnailer->inflight_mutex);
+	thumbnailer->inflight = g_hash_table_new_full(g_str_hash, g_str_equal,
+		g_free, rp_thumbnailer_inflight_entry_free);
+
 	// Make sure we shut down after inactivity.
 	thumbnailer->timeout_id = g_timeout_add_seconds(SHUTDOWN_TIMEOUT_SECONDS,
 		G_SOURCE_FUNC(rp_thumbnailer_timeout), thumbnailer);
@@ -229,7 +313,21 @@ rp_thumbnailer_dispose(GObject *object)
 
 	// Unregister timer sources.
 	g_clear_handle_id(&thumbnailer->timeout_id, g_source_remove);
-	g_clear_handle_id(&thumbnailer->idle_process, g_source_remove);
+
+	// Shut down the worker pool.
+	// Queued requests are dropped; running requests are finished.
+	if (thumbnailer->pool) {
+		g_thread_pool_free(thumbnailer->pool, TRUE, TRUE);
+		thumbnailer->pool = NULL;
+	}
+
+	// Free the in-flight request table.
+	// Entries for dropped queued requests are freed here,
+	// including any attached duplicates.
+	if (thumbnailer->inflight) {
+		g_clear_pointer(&thumbnailer->inflight, g_hash_table_unref);
+		g_mutex_clear(&thumbnailer->inflight_mutex);
+	}
 
 	/** Properties **/
 	g_clear_object(&thumbnailer->connection);
@@ -244,16 +342,6 @@ rp_thumbnailer_finalize(GObject *object)
 	RpThumbnailer *const thumbnailer = RP_THUMBNAILER(object);
 	g_clear_object(&thumbnailer->skeleton);
 
-	// Delete any remaining requests and free the queue.
-	for (GList *p = thumbnailer->request_queue.head; p != NULL; p = p->next) {
-		if (p->data) {
-			struct request_info *const req = (struct request_info*)p->data;
-			g_free(req->uri);
-			g_free(req);
-		}
-	}
-	g_queue_clear(&thumbnailer->request_queue);
-
 	/** Properties **/
 	g_free(thumbnailer->cache_dir);
 
@@ -387,20 +475,31 @@ rp_thumbnailer_queue(SpecializedThumbnailer1 *skeleton,
 		handle = ++thumbnailer->last_handle;
 	}
 
-	// Add the URI to the queue.
+	// Push the URI to the worker pool.
 	// NOTE: Currently handling all flavors that aren't "large" as "normal".
 	struct request_info *const req = g_malloc(sizeof(struct request_info));
 	req->uri = g_strdup(uri);
 	req->handle = handle;
 	req->large = flavor && (g_ascii_strcasecmp(flavor, "large") == 0);
 	req->urgent = urgent;
-	// TODO Put 'urgent' requests at the front of the queue?
-	g_queue_push_tail(&thumbnailer->request_queue, req);
-
-	// Make sure the idle process is started.
-	// TODO: Make it multi-threaded? (needs atomic compare and/or mutex...)
-	if (thumbnailer->idle_process == 0) {
-		thumbnailer->idle_process = g_idle_add(G_SOURCE_FUNC(rp_thumbnailer_process), thumbnailer);
+	// TODO: Put 'urgent' requests at the front of the pool queue?
+	g_atomic_int_inc(&thumbnailer->num_pending);
+
+	// Coalesce identical in-flight requests: if the same URI and
+	// flavor is already queued or running, attach to it instead of
+	// running the pipeline again.
+	gchar *const key = rp_thumbnailer_inflight_key(req->uri, req->large);
+	g_mutex_lock(&thumbnailer->inflight_mutex);
+	struct inflight_entry *entry = g_hash_table_lookup(thumbnailer->inflight, key);
+	if (entry) {
+		entry->followers = g_slist_prepend(entry->followers, req);
+		g_mutex_unlock(&thumbnailer->inflight_mutex);
+		g_free(key);
+	} else {
+		entry = g_malloc0(sizeof(struct inflight_entry));
+		g_hash_table_insert(thumbnailer->inflight, key, entry);
+		g_mutex_unlock(&thumbnailer->inflight_mutex);
+		g_thread_pool_push(thumbnailer->pool, req, NULL);
 	}
 
 	specialized_thumbnailer1_complete_queue(skeleton, invocation, handle);
@@ -437,7 +536,7 @@ static gboolean
 rp_thumbnailer_timeout(RpThumbnailer *thumbnailer)
 {
 	g_return_val_if_fail(RP_IS_THUMBNAILER(thumbnailer), false);
-	if (!g_queue_is_empty(&thumbnailer->request_queue)) {
+	if (g_atomic_int_get(&thumbnailer->num_pending) != 0) {
 		// Still processing stuff.
 		return true;
 	}
@@ -451,40 +550,43 @@ rp_thumbnailer_timeout(RpThumbnailer *thumbnailer)
 }
 
 /**
- * Process a thumbnail.
- * @param thumbnailer RpThumbnailer object.
+ * Process a thumbnail request. (worker pool thread)
+ *
+ * The heavy lifting (decode, scale, PNG write) happens here.
+ * D-Bus signal emission is marshalled back to the main loop
+ * via rp_thumbnailer_request_done().
+ *
+ * @param data		struct request_info*
+ * @param user_data	RpThumbnailer object.
  */
-static gboolean
-rp_thumbnailer_process(RpThumbnailer *thumbnailer)
+static void
+rp_thumbnailer_process_request(gpointer data, gpointer user_data)
 {
+	struct request_info *const req = (struct request_info*)data;
+	RpThumbnailer *const thumbnailer = RP_THUMBNAILER(user_data);
+
 	gchar *cache_dir = NULL;	// cache directory (g_strdup_printf())
 	gchar *md5_string = NULL;	// MD5 of the original filename (owned by us)
 	gchar *cache_filename = NULL;	// full cache filename (g_strdup_printf())
-	int ret;
 
-	g_return_val_if_fail(RP_IS_THUMBNAILER(thumbnailer), FALSE);
-
-	// Process one thumbnail.
-	const struct request_info *req = (struct request_info*)g_queue_pop_head(&thumbnailer->request_queue);
-	if (req == NULL) {
-		// Nothing in the queue.
-		goto cleanup;
-	}
+	// Completion info. The URI is transferred from the request.
+	struct request_done_info *const done = g_malloc0(sizeof(struct request_done_info));
+	done->thumbnailer = (RpThumbnailer*)g_object_ref(thumbnailer);
+	done->uri = req->uri;
+	done->handle = req->handle;
+	done->ret = -1;
+	done->error_code = 0;
 
 	// NOTE: cache_dir and pfn_rp_create_thumbnail2 should NOT be NULL
 	// at this point, but we're checking it anyway.
 	if (!thumbnailer->cache_dir || thumbnailer->cache_dir[0] == 0) {
 		// No cache directory...
-		specialized_thumbnailer1_emit_error(
-			thumbnailer->skeleton, req->handle, "",
-			0, "Thumbnail cache directory is empty.");
+		done->message = "Thumbnail cache directory is empty.";
 		goto finished;
 	}
 	if (!thumbnailer->pfn_rp_create_thumbnail2) {
 		// No thumbnailer function.
-		specialized_thumbnailer1_emit_error(
-			thumbnailer->skeleton, req->handle, "",
-			0, "No thumbnailer function is available.");
+		done->message = "No thumbnailer function is available.";
 		goto finished;
 	}
 
@@ -495,16 +597,12 @@ rp_thumbnailer_process(RpThumbnailer *thumbnailer)
 		thumbnailer->cache_dir, (req->large ? "large" : "normal"));
 	if (!cache_dir) {
 		// g_strdup_printf() failed.
-		specialized_thumbnailer1_emit_error(
-			thumbnailer->skeleton, req->handle, req->uri,
-			0, "Cannot g_strdup_printf() the thumbnail cache directory.");
+		done->message = "Cannot g_strdup_printf() the thumbnail cache directory.";
 		goto finished;
 	}
 
 	if (g_mkdir_with_parents(cache_dir, 0777) != 0) {
-		specialized_thumbnailer1_emit_error(
-			thumbnailer->skeleton, req->handle, req->uri,
-			0, "Cannot mkdir() the thumbnail cache directory.");
+		done->message = "Cannot mkdir() the thumbnail cache directory.";
 		goto finished;
 	}
 
@@ -512,9 +610,7 @@ rp_thumbnailer_process(RpThumbnailer *thumbnailer)
 	md5_string = g_compute_checksum_for_data(G_CHECKSUM_MD5, (const guchar*)req->uri, strlen(req->uri));
 	if (!md5_string) {
 		// Cannot compute the checksum...
-		specialized_thumbnailer1_emit_error(
-			thumbnailer->skeleton, req->handle, req->uri,
-			0, "g_compute_checksum_for_data() failed.");
+		done->message = "g_compute_checksum_for_data() failed.";
 		goto finished;
 	}
 
@@ -522,56 +618,108 @@ rp_thumbnailer_process(RpThumbnailer *thumbnailer)
 	cache_filename = g_strdup_printf("%s/%s.png", cache_dir, md5_string);
 	if (!cache_filename) {
 		// g_strdup_printf() failed.
-		specialized_thumbnailer1_emit_error(
-			thumbnailer->skeleton, req->handle, req->uri,
-			0, "Cannot g_strdup_printf() the thumbnail cache filename.");
+		done->message = "Cannot g_strdup_printf() the thumbnail cache filename.";
 		goto finished;
 	}
 
 	// Thumbnail the image.
-	ret = thumbnailer->pfn_rp_create_thumbnail2(req->uri, cache_filename, req->large ? 256 : 128, 0);
-	if (ret == 0) {
+	// Using the buffer pool, since the daemon usually handles
+	// many thumbnail requests in a row.
+	done->ret = thumbnailer->pfn_rp_create_thumbnail2(req->uri, cache_filename,
+		req->large ? 256 : 128, RPCT_FLAG_USE_BUFFER_POOL);
+	if (done->ret == 0) {
 		// Image thumbnailed successfully.
 		g_debug("rom-properties thumbnail: %s -> %s [OK]", req->uri, cache_filename);
-		specialized_thumbnailer1_emit_ready(
-			thumbnailer->skeleton, req->handle, req->uri);
 	} else {
 		// Error thumbnailing the image...
-		g_debug("rom-properties thumbnail: %s -> %s [ERR=%d]", req->uri, cache_filename, ret);
-		specialized_thumbnailer1_emit_error(
-			thumbnailer->skeleton, req->handle, req->uri,
-			2, "Image thumbnailing failed... (TODO: return code)");
+		g_debug("rom-properties thumbnail: %s -> %s [ERR=%d]", req->uri, cache_filename, done->ret);
+		done->error_code = 2;
+		done->message = "Image thumbnailing failed... (TODO: return code)";
 	}
 
 finished:
-	// Request is finished. Emit the finished signal.
-	specialized_thumbnailer1_emit_finished(
-		thumbnailer->skeleton, req->handle);
+	// Detach the in-flight entry and complete any coalesced
+	// duplicate requests with the same result.
+	{
+		gchar *const key = rp_thumbnailer_inflight_key(done->uri, req->large);
+		GSList *followers = NULL;
+		g_mutex_lock(&thumbnailer->inflight_mutex);
+		struct inflight_entry *const entry = g_hash_table_lookup(thumbnailer->inflight, key);
+		if (entry) {
+			followers = entry->followers;
+			entry->followers = NULL;
+			g_hash_table_remove(thumbnailer->inflight, key);
+		}
+		g_mutex_unlock(&thumbnailer->inflight_mutex);
+		g_free(key);
+
+		for (GSList *l = followers; l != NULL; l = l->next) {
+			struct request_info *const freq = (struct request_info*)l->data;
+			struct request_done_info *const fdone = g_malloc0(sizeof(struct request_done_info));
+			fdone->thumbnailer = (RpThumbnailer*)g_object_ref(thumbnailer);
+			fdone->uri = freq->uri;	// transferred
+			fdone->handle = freq->handle;
+			fdone->ret = done->ret;
+			fdone->error_code = done->error_code;
+			fdone->message = done->message;
+			g_idle_add(rp_thumbnailer_request_done, fdone);
+			g_free(freq);
+		}
+		g_slist_free(followers);
+	}
+
+	// Emit the D-Bus signals from the main loop.
+	g_idle_add(rp_thumbnailer_request_done, done);
 
-cleanup:
 	// Free allocated things.
+	// NOTE: req->uri was transferred to the completion info.
 	g_free(cache_filename);
 	g_free(md5_string);
 	g_free(cache_dir);
+	g_free(req);
+}
+
+/**
+ * A thumbnail request has completed. (main loop)
+ *
+ * Emits the Ready/Error and Finished signals, and restarts
+ * the inactivity timeout once no requests are in flight.
+ *
+ * @param user_data struct request_done_info*
+ * @return G_SOURCE_REMOVE
+ */
+static gboolean
+rp_thumbnailer_request_done(gpointer user_data)
+{
+	struct request_done_info *const done = (struct request_done_info*)user_data;
+	RpThumbnailer *const thumbnailer = done->thumbnailer;
 
-	// req was allocated using g_malloc() before it was
-	// added to the queue. We'll need to free it here.
-	g_free((gpointer)req);
+	if (done->ret == 0) {
+		specialized_thumbnailer1_emit_ready(
+			thumbnailer->skeleton, done->handle, done->uri);
+	} else {
+		specialized_thumbnailer1_emit_error(
+			thumbnailer->skeleton, done->handle, done->uri,
+			done->error_code, (done->message ? done->message : "Unknown error."));
+	}
 
-	// Return TRUE if we still have more thumbnails queued.
-	const bool isEmpty = g_queue_is_empty(&thumbnailer->request_queue);
-	if (isEmpty) {
-		// Clear the idle process.
-		// FIXME: Atomic compare and/or mutex? (assuming multi-threaded...)
-		thumbnailer->idle_process = 0;
+	// Request is finished. Emit the finished signal.
+	specialized_thumbnailer1_emit_finished(
+		thumbnailer->skeleton, done->handle);
 
+	if (g_atomic_int_dec_and_test(&thumbnailer->num_pending)) {
+		// No requests are in flight.
 		// Restart the inactivity timeout.
 		if (G_LIKELY(thumbnailer->timeout_id == 0)) {
 			thumbnailer->timeout_id = g_timeout_add_seconds(SHUTDOWN_TIMEOUT_SECONDS,
 				G_SOURCE_FUNC(rp_thumbnailer_timeout), thumbnailer);
 		}
 	}
-	return !isEmpty;
+
+	g_object_unref(done->thumbnailer);
+	g_free(done->uri);
+	g_free(done);
+	return G_SOURCE_REMOVE;
 }
 
 /**
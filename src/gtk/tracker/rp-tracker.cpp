@@ -263,7 +263,10 @@ tracker_extract_get_metadata(TrackerExtractInfo *info, GError **error)
 	}
 
 	// Attempt to open the file using RomDataFactory.
-	RomDataPtr romData = RomDataFactory::create(filename);
+	// Metadata-only extraction: skip RomData subclasses that can't
+	// provide metadata, so their header probes aren't run at all.
+	// (Fields and images are lazy-loaded and never requested here.)
+	RomDataPtr romData = RomDataFactory::create(filename, RomDataFactory::RDA_HAS_METADATA);
 	g_free(filename);
 	if (!romData) {
 		// No RomData was created.
@@ -423,6 +426,10 @@ tracker_extract_get_metadata(TrackerExtractInfo *info, GError **error)
 
 	// Process metadata properties.
 	const RomMetaData *const metaData = romData->metaData();
+	// The metadata is cached in the RomData object at this point.
+	// Close the underlying file now so a large disc image isn't
+	// held open while the SPARQL output is built and serialized.
+	romData->close();
 	if (!metaData) {
 		// No metadata properties. Can't do much else here.
 		if (rp_tracker_api >= 2) {
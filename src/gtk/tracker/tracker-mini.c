@@ -11,6 +11,7 @@
 
 #include "tracker-mini.h"
 #include "tracker-file-utils.h"
+#include "stdboolx.h"
 
 // C includes
 #include <dlfcn.h>
@@ -146,12 +147,20 @@ static void init_tracker_v2(void)
  */
 int rp_tracker_init_pfn(void)
 {
+	// NOTE: This is called once per extracted file, so a failed
+	// initialization is memoized too. Otherwise, the full dlopen()
+	// cascade would be retried for every file in the batch.
+	static bool init_failed = false;
+
 	// Attempt to open Tracker libraries.
 	// TODO: Use a config.h file for the library paths.
 	// Hard-coding 32-bit Ubuntu paths for now.
 	if (rp_tracker_api > 0) {
 		// Already initialized.
 		return 0;
+	} else if (init_failed) {
+		// Initialization failed previously.
+		return -ENOENT;
 	}
 
 	// Check for Tracker 3.0.
@@ -191,6 +200,7 @@ int rp_tracker_init_pfn(void)
 
 	// One or more libraries were not found.
 	close_modules();
+	init_failed = true;
 	return -ENOENT;
 }
 
@@ -153,16 +153,19 @@ void DragImageLabel::clearRp(void)
  * Convert a QImage to QPixmap.
  * Automatically resizes the QImage if it's smaller
  * than the minimum size.
- * @param img QImage.
+ * @param img QImage. (Taken by value; move in if possible.)
  * @return QPixmap.
  */
-QPixmap DragImageLabel::imgToPixmap(const QImage &img) const
+QPixmap DragImageLabel::imgToPixmap(QImage img) const
 {
 	if (img.width() >= m_minimumImageSize.width() &&
 	    img.height() >= m_minimumImageSize.height())
 	{
 		// No resize necessary.
-		return QPixmap::fromImage(img);
+		// NOTE: Using the fromImage() rvalue overload (Qt 5.3+) so
+		// the pixel buffer can be adopted instead of copied if our
+		// handle is the last reference.
+		return QPixmap::fromImage(std::move(img));
 	}
 
 	// Resize the image.
@@ -186,19 +189,12 @@ QPixmap DragImageLabel::imgToPixmap(const QImage &img) const
 bool DragImageLabel::updatePixmaps(void)
 {
 	if (m_anim && m_anim->iconAnimData) {
-		const IconAnimDataConstPtr &iconAnimData = m_anim->iconAnimData;
-
-		// Convert the icons to QPixmaps.
-		for (int i = iconAnimData->count-1; i >= 0; i--) {
-			const rp_image_ptr &frame = iconAnimData->frames[i];
-			if (frame && frame->isValid()) {
-				// NOTE: Allowing NULL frames here...
-				m_anim->iconFrames[i] = imgToPixmap(rpToQImage(frame));
-			}
-		}
+		// Reset the frame cache. Frames are converted on demand
+		// by framePixmap() and kept until the size or data changes.
+		m_anim->iconFrames.fill(QPixmap());
 
 		// Set up the IconAnimHelper.
-		m_anim->iconAnimHelper.setIconAnimData(iconAnimData);
+		m_anim->iconAnimHelper.setIconAnimData(m_anim->iconAnimData);
 		if (m_anim->iconAnimHelper.isAnimated()) {
 			// Initialize the animation.
 			m_anim->last_frame_number = m_anim->iconAnimHelper.frameNumber();
@@ -213,7 +209,7 @@ bool DragImageLabel::updatePixmaps(void)
 		}
 
 		// Show the first frame.
-		this->setPixmap(m_anim->iconFrames[m_anim->iconAnimHelper.frameNumber()]);
+		this->setPixmap(framePixmap(m_anim->iconAnimHelper.frameNumber()));
 		return true;
 	}
 
@@ -221,14 +217,16 @@ bool DragImageLabel::updatePixmaps(void)
 		// Single image.
 
 		// Convert the rp_image to a QImage.
-		const QImage qImg = rpToQImage(m_img);
+		// NOTE: The QImage shares the backend's pixel buffer;
+		// no copies are made until QPixmap conversion.
+		QImage qImg = rpToQImage(m_img);
 		if (qImg.isNull()) {
 			// Unable to convert the image.
 			return false;
 		}
 
 		// Image converted successfully.
-		this->setPixmap(imgToPixmap(qImg));
+		this->setPixmap(imgToPixmap(std::move(qImg)));
 		return true;
 	}
 
@@ -236,6 +234,36 @@ bool DragImageLabel::updatePixmaps(void)
 	return false;
 }
 
+/**
+ * Get the specified animation frame, rendered at the current size.
+ * Frames are converted on demand and cached until the
+ * size or the icon data changes.
+ * @param frame Frame number
+ * @return QPixmap (null QPixmap on error)
+ */
+QPixmap DragImageLabel::framePixmap(int frame)
+{
+	assert(m_anim != nullptr);
+	assert(frame >= 0);
+	assert(frame < static_cast<int>(m_anim->iconFrames.size()));
+	if (!m_anim || frame < 0 || frame >= static_cast<int>(m_anim->iconFrames.size())) {
+		return {};
+	}
+
+	QPixmap &pxm = m_anim->iconFrames[frame];
+	if (!pxm.isNull()) {
+		// Frame is already rendered.
+		return pxm;
+	}
+
+	const rp_image_ptr &img = m_anim->iconAnimData->frames[frame];
+	if (img && img->isValid()) {
+		// NOTE: Allowing NULL frames here...
+		pxm = imgToPixmap(rpToQImage(img));
+	}
+	return pxm;
+}
+
 /**
  * Start the animation timer.
  */
@@ -296,7 +324,7 @@ void DragImageLabel::tmrIconAnim_timeout(void)
 	if (frame != m_anim->last_frame_number) {
 		// New frame number.
 		// Update the icon.
-		this->setPixmap(m_anim->iconFrames[frame]);
+		this->setPixmap(framePixmap(frame));
 		m_anim->last_frame_number = frame;
 	}
 
@@ -372,9 +400,9 @@ void DragImageLabel::mouseMoveEvent(QMouseEvent *event)
 
 	// Get the first frame and use it for the drag pixmap.
 	if (m_anim && m_anim->iconAnimHelper.isAnimated()) {
-		const int frame = m_anim->iconAnimData->seq_index[0];
-		if (!m_anim->iconFrames[frame].isNull()) {
-			drag->setPixmap(m_anim->iconFrames[frame]);
+		const QPixmap pxm = framePixmap(m_anim->iconAnimData->seq_index[0]);
+		if (!pxm.isNull()) {
+			drag->setPixmap(pxm);
 		}
 	} else {
 		// Not animated. Use the QLabel pixmap directly.
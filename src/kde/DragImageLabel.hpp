@@ -95,10 +95,10 @@ protected:
 	 * Convert a QImage to QPixmap.
 	 * Automatically resizes the QImage if it's smaller
 	 * than the minimum size.
-	 * @param img QImage.
+	 * @param img QImage. (Taken by value; move in if possible.)
 	 * @return QPixmap.
 	 */
-	QPixmap imgToPixmap(const QImage &img) const;
+	QPixmap imgToPixmap(QImage img) const;
 
 	/**
 	 * Update the pixmap(s).
@@ -106,6 +106,15 @@ protected:
 	 */
 	bool updatePixmaps(void);
 
+	/**
+	 * Get the specified animation frame, rendered at the current size.
+	 * Frames are converted on demand and cached until the
+	 * size or the icon data changes.
+	 * @param frame Frame number
+	 * @return QPixmap (null QPixmap on error)
+	 */
+	QPixmap framePixmap(int frame);
+
 public:
 	/**
 	 * Start the animation timer.
@@ -9,6 +9,84 @@
 #include "stdafx.h"
 #include "GettextTranslator.hpp"
 
+// C includes (C++ namespace)
+#include <clocale>
+
+// C++ STL classes
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Cache of translation lookups, keyed by the context and source text pointers.
+// Qt passes string literals here, so the pointers are stable for the lifetime
+// of the process. RomDataView rebuilds re-query the same strings repeatedly,
+// so this avoids hitting the gettext catalog for every translate() call.
+// The cache is invalidated if LC_MESSAGES changes.
+namespace {
+
+struct TrCacheKey {
+	const char *context;
+	const char *sourceText;
+
+	bool operator==(const TrCacheKey &other) const
+	{
+		return (context == other.context &&
+		        sourceText == other.sourceText);
+	}
+};
+
+struct TrCacheKeyHash {
+	size_t operator()(const TrCacheKey &key) const
+	{
+		return std::hash<const char*>()(key.context) ^
+		       (std::hash<const char*>()(key.sourceText) << 1);
+	}
+};
+
+}
+
+static std::mutex tr_cache_mutex;
+static std::unordered_map<TrCacheKey, QString, TrCacheKeyHash> tr_cache;
+static std::string tr_cache_locale;
+
+/**
+ * Look up a non-plural translation, using the cache if possible.
+ * @param context Translation context
+ * @param sourceText Source text
+ * @return Translated QString, or empty QString if no translation is available.
+ */
+static QString translate_cached(const char *context, const char *sourceText)
+{
+	std::lock_guard<std::mutex> lock(tr_cache_mutex);
+
+	// Invalidate the cache if the locale has changed.
+	const char *const locale = setlocale(LC_MESSAGES, nullptr);
+	if (locale && tr_cache_locale != locale) {
+		tr_cache.clear();
+		// Flush libi18n's memoized lookups as well; otherwise, the
+		// pgettext_expr() refill below would return msgstr pointers
+		// from the old locale's catalog.
+		rp_i18n_invalidate_cache();
+		tr_cache_locale = locale;
+	}
+
+	const TrCacheKey key = {context, sourceText};
+	auto iter = tr_cache.find(key);
+	if (iter != tr_cache.end()) {
+		return iter->second;
+	}
+
+	QString qs_txt;
+	const char *const txt = pgettext_expr(context, sourceText);
+	if (txt != sourceText) {
+		qs_txt = QString::fromUtf8(txt);
+	}
+	// NOTE: Empty QStrings are cached as well.
+	// Untranslated strings are the common case.
+	tr_cache.emplace(key, qs_txt);
+	return qs_txt;
+}
+
 GettextTranslator::GettextTranslator(QObject *parent)
 	: super(parent)
 { }
@@ -26,6 +104,7 @@ QString GettextTranslator::translate(const char *context,
 	{
 		// NOTE: gettext() requires two message IDs for plurals.
 		// Qt only has one, since it does all plural processing in the translation.
+		// NOTE 2: Plural lookups are not cached, since the result depends on n.
 		const char *const txt = npgettext_expr(context, sourceText, sourceText, n);
 		if (txt == sourceText) {
 			// No translation is available from gettext.
@@ -36,12 +115,7 @@ QString GettextTranslator::translate(const char *context,
 
 #if QT_VERSION >= QT_VERSION_CHECK(5,0,0)
 	// Qt5: No plurals here.
-	const char *const txt = pgettext_expr(context, sourceText);
-	if (txt == sourceText) {
-		// No translation is available from gettext.
-		return {};
-	}
-	return QString::fromUtf8(txt);
+	return translate_cached(context, sourceText);
 #endif
 }
 
@@ -52,11 +126,6 @@ QString GettextTranslator::translate(const char *context,
 	// FIXME: Make use of disambiguation.
 	Q_UNUSED(disambiguation)
 
-	const char *const txt = pgettext_expr(context, sourceText);
-	if (txt == sourceText) {
-		// No translation is available from gettext.
-		return {};
-	}
-	return QString::fromUtf8(txt);
+	return translate_cached(context, sourceText);
 }
 #endif
@@ -9,6 +9,9 @@
 #include "stdafx.h"
 #include "ISpriteSheet.hpp"
 
+// for sharing decoded sprite sheets between instances
+#include <QtGui/QPixmapCache>
+
 /**
  * Sprite sheet loader
  * @param cols Number of columns
@@ -41,38 +44,59 @@ QPixmap ISpriteSheet::getIcon(int col, int row, bool gray) const
 		return {};
 	}
 
+	char qres_filename[64];
+	int ret = getFilename(qres_filename, sizeof(qres_filename), m_width, m_height, gray);
+	if (ret != 0) {
+		// Unable to get the filename.
+		return {};
+	}
+
+	// Check the sub-icon cache first.
+	// QPixmap is implicitly shared, so cache hits hand out a reference
+	// to the extracted sprite instead of copying the sheet region again.
+	char subicon_key[80];
+	snprintf(subicon_key, sizeof(subicon_key), "%s?%d,%d", qres_filename, col, row);
+	const QString qs_subicon_key = QString::fromUtf8(subicon_key);
+	QPixmap subIcon;
+	if (QPixmapCache::find(qs_subicon_key, &subIcon)) {
+		return subIcon;
+	}
+
 	// Do we need to load the sprite sheet?
 	QPixmap &imgSpriteSheet = gray
 		? const_cast<ISpriteSheet*>(this)->m_imgGray
 		: const_cast<ISpriteSheet*>(this)->m_img;
 	if (imgSpriteSheet.isNull()) {
-		// Load the sprite sheet.
-		char qres_filename[64];
-		int ret = getFilename(qres_filename, sizeof(qres_filename), m_width, m_height, gray);
-		if (ret != 0) {
-			// Unable to get the filename.
-			return {};
-		}
+		// Check QPixmapCache first. Sprite sheet objects are usually
+		// short-lived, so this caches the decoded sheet for the
+		// lifetime of the process instead of the object.
+		const QString qs_filename = QString::fromUtf8(qres_filename);
+		if (!QPixmapCache::find(qs_filename, &imgSpriteSheet)) {
+			// Load the sprite sheet.
+			imgSpriteSheet.load(qs_filename);
+			assert(!imgSpriteSheet.isNull());
+			if (imgSpriteSheet.isNull()) {
+				// Unable to load the sprite sheet.
+				return {};
+			}
 
-		imgSpriteSheet.load(QString::fromUtf8(qres_filename));
-		assert(!imgSpriteSheet.isNull());
-		if (imgSpriteSheet.isNull()) {
-			// Unable to load the sprite sheet.
-			return {};
-		}
+			// Make sure the bitmap has the expected size.
+			assert(imgSpriteSheet.width()  == (int)(m_width * m_cols));
+			assert(imgSpriteSheet.height() == (int)(m_height * m_rows));
+			if (imgSpriteSheet.width()  != (int)(m_width * m_cols) ||
+			    imgSpriteSheet.height() != (int)(m_height * m_rows))
+			{
+				// Incorrect size. We can't use it.
+				imgSpriteSheet = QPixmap();
+				return {};
+			}
 
-		// Make sure the bitmap has the expected size.
-		assert(imgSpriteSheet.width()  == (int)(m_width * m_cols));
-		assert(imgSpriteSheet.height() == (int)(m_height * m_rows));
-		if (imgSpriteSheet.width()  != (int)(m_width * m_cols) ||
-		    imgSpriteSheet.height() != (int)(m_height * m_rows))
-		{
-			// Incorrect size. We can't use it.
-			imgSpriteSheet = QPixmap();
-			return {};
+			QPixmapCache::insert(qs_filename, imgSpriteSheet);
 		}
 	}
 
-	// Extract the sub-icon.
-	return imgSpriteSheet.copy(col*m_width, row*m_height, m_width, m_height);
+	// Extract the sub-icon and cache it for future requests.
+	subIcon = imgSpriteSheet.copy(col*m_width, row*m_height, m_width, m_height);
+	QPixmapCache::insert(qs_subicon_key, subIcon);
+	return subIcon;
 }
@@ -38,8 +38,16 @@ private:
 
 public:
 	// Row/column count
+	// NOTE: rowCount is the number of rows currently provisioned
+	// to the view. Rows are provisioned in batches via fetchMore()
+	// so multi-thousand-row lists don't have to be materialized
+	// up front. rowCountTotal is the total number of data rows.
 	int columnCount;
 	int rowCount;
+	int rowCountTotal;
+
+	// Number of rows to provision per fetchMore() call.
+	static constexpr int ROW_FETCH_SIZE = 256;
 
 	// Header strings
 	vector<QString> headers;
@@ -59,7 +67,10 @@ public:
 	// Icons
 	// NOTE: References to rp_image* are kept in case
 	// the icon size is changed.
-	vector<QPixmap> icons;
+	// NOTE 2: icons[] is a cache of converted pixmaps.
+	// Icons are converted on demand by getIconPixmap(),
+	// so it's mutable for use in the const data() path.
+	mutable vector<QPixmap> icons;
 	vector<rp_image_const_ptr> icons_rp;
 	QSize iconSize;
 
@@ -84,9 +95,12 @@ public:
 	void clearData(void);
 
 	/**
-	 * Update the icons pixmap vector.
+	 * Get the icon pixmap for a row, converting it if necessary.
+	 * Converted pixmaps are cached in icons[].
+	 * @param row Row number
+	 * @return Icon pixmap, or null pixmap if this row has no icon.
 	 */
-	void updateIconPixmaps(void);
+	const QPixmap &getIconPixmap(int row) const;
 
 	/**
 	 * Convert a single language from RFT_LISTDATA or RFT_LISTDATA_MULTI to vector<QString>.
@@ -132,6 +146,7 @@ ListDataModelPrivate::ListDataModelPrivate(ListDataModel *q)
 	: q_ptr(q)
 	, columnCount(0)
 	, rowCount(0)
+	, rowCountTotal(0)
 	, pData(nullptr)
 	, iconSize(QSize(32, 32))
 	, itemFlags(Qt::NoItemFlags)
@@ -152,6 +167,7 @@ void ListDataModelPrivate::clearData(void)
 	headers.clear();
 	map_data.clear();
 	pData = nullptr;
+	rowCountTotal = 0;
 	itemFlags = Qt::NoItemFlags;
 	checkboxes = 0;
 	hasCheckboxes = false;
@@ -164,31 +180,40 @@ void ListDataModelPrivate::clearData(void)
 }
 
 /**
- * Update the icons pixmap vector.
+ * Get the icon pixmap for a row, converting it if necessary.
+ * Converted pixmaps are cached in icons[].
+ * @param row Row number
+ * @return Icon pixmap, or null pixmap if this row has no icon.
  */
-void ListDataModelPrivate::updateIconPixmaps(void)
+const QPixmap &ListDataModelPrivate::getIconPixmap(int row) const
 {
-	icons.clear();
-	icons.reserve(icons_rp.size());
+	assert(row >= 0);
+	assert(row < static_cast<int>(icons_rp.size()));
 
-	for (const auto &img : icons_rp) {
-		if (!img) {
-			icons.emplace_back();
-			continue;
-		}
+	if (icons.size() != icons_rp.size()) {
+		// Initialize the pixmap cache with null pixmaps.
+		icons.clear();
+		icons.resize(icons_rp.size());
+	}
 
-		QPixmap pixmap = QPixmap::fromImage(rpToQImage(img));
+	QPixmap &pixmap = icons[row];
+	const rp_image_const_ptr &img = icons_rp[row];
+	if (!pixmap.isNull() || !img) {
+		// Already converted, or this row has no icon.
+		return pixmap;
+	}
 
-		// Do we need to resize the icon?
-		if (img->width() != iconSize.width() ||
-		    img->height() != iconSize.height())
-		{
-			// Resize is needed.
-			pixmap = pixmap.scaled(iconSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-		}
+	pixmap = QPixmap::fromImage(rpToQImage(img));
 
-		icons.emplace_back(std::move(pixmap));
+	// Do we need to resize the icon?
+	if (img->width() != iconSize.width() ||
+	    img->height() != iconSize.height())
+	{
+		// Resize is needed.
+		pixmap = pixmap.scaled(iconSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
 	}
+
+	return pixmap;
 }
 
 /**
@@ -405,16 +430,18 @@ QVariant ListDataModel::data(const QModelIndex &index, int role) const
 			return (d->checkboxes & (1U << row)) ? Qt::Checked : Qt::Unchecked;
 
 		case Qt::DecorationRole:
-			if (column != 0 || d->icons.empty())
+			if (column != 0 || d->icons_rp.empty())
 				break;
-			if (row <= (int)d->icons.size())
-				return d->icons[row];
+			if (row < (int)d->icons_rp.size()) {
+				// Icon pixmaps are converted on demand and cached.
+				return d->getIconPixmap(row);
+			}
 			break;
 
 		case RpImageRole:
-			if (column != 0 || d->icons.empty())
+			if (column != 0 || d->icons_rp.empty())
 				break;
-			if (row <= (int)d->icons.size()) {
+			if (row < (int)d->icons_rp.size()) {
 				// NOTE: We can't put an std::shared_ptr<> in QVariant.
 				// Pass a pointer to the std::shared_ptr<> instead.
 				if (d->icons_rp[row]) {
@@ -633,26 +660,61 @@ void ListDataModel::setField(const RomFields::Field *pField)
 
 		// NOTE 2: Since we're using shared_ptr<> now, we can just
 		// copy the entire vector over without manually iterating.
+		// Pixmap conversion is done on demand by getIconPixmap().
 		d->icons_rp = *(pField->data.list_data.mxd.icons);
-
-		// Update the icons pixmap vector.
-		d->updateIconPixmaps();
 	}
 
 	if (d->pData) {
-		beginInsertRows(QModelIndex(), 0, (rowCount - 1));
-
 		// NOTE: We may have skipped empty rows if checkboxes are enabled.
 		if (likely(!hasCheckboxes)) {
-			d->rowCount = rowCount;
+			d->rowCountTotal = rowCount;
 		} else {
-			d->rowCount = static_cast<int>(d->pData->size() / d->columnCount);
+			d->rowCountTotal = static_cast<int>(d->pData->size() / d->columnCount);
 		}
 
+		// Only provision the first batch of rows here.
+		// The rest are provisioned on demand via fetchMore().
+		const int initialRowCount = std::min(d->rowCountTotal, ListDataModelPrivate::ROW_FETCH_SIZE);
+		beginInsertRows(QModelIndex(), 0, (initialRowCount - 1));
+		d->rowCount = initialRowCount;
 		endInsertRows();
 	}
 }
 
+/**
+ * Can more rows be fetched?
+ * @param parent Parent index
+ * @return True if more rows can be provisioned; false if not.
+ */
+bool ListDataModel::canFetchMore(const QModelIndex &parent) const
+{
+	if (parent.isValid())
+		return false;
+	Q_D(const ListDataModel);
+	return (d->rowCount < d->rowCountTotal);
+}
+
+/**
+ * Fetch more rows.
+ * Provisions the next batch of rows to the view.
+ * @param parent Parent index
+ */
+void ListDataModel::fetchMore(const QModelIndex &parent)
+{
+	if (parent.isValid())
+		return;
+	Q_D(ListDataModel);
+	const int itemsToFetch = std::min(
+		d->rowCountTotal - d->rowCount,
+		ListDataModelPrivate::ROW_FETCH_SIZE);
+	if (itemsToFetch <= 0)
+		return;
+
+	beginInsertRows(QModelIndex(), d->rowCount, (d->rowCount + itemsToFetch - 1));
+	d->rowCount += itemsToFetch;
+	endInsertRows();
+}
+
 /** Properties **/
 
 /**
@@ -729,7 +791,9 @@ void ListDataModel::setIconSize(QSize iconSize)
 
 	d->iconSize = iconSize;
 	if (!d->icons_rp.empty()) {
-		d->updateIconPixmaps();
+		// Drop the cached pixmaps. They'll be re-converted
+		// at the new size on demand.
+		d->icons.clear();
 		const QModelIndex indexFirst = createIndex(0, 0);
 		const QModelIndex indexLast = createIndex(d->rowCount-1, 0);
 		emit dataChanged(indexFirst, indexLast);
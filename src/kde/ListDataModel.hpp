@@ -50,6 +50,22 @@ public:
 	Qt::ItemFlags flags(const QModelIndex &index) const final;
 	QVariant headerData(int section, Qt::Orientation orientation, int role) const final;
 
+	/**
+	 * Can more rows be fetched?
+	 * Rows are provisioned to the view in batches so large
+	 * lists don't have to be materialized up front.
+	 * @param parent Parent index
+	 * @return True if more rows can be provisioned; false if not.
+	 */
+	bool canFetchMore(const QModelIndex &parent) const final;
+
+	/**
+	 * Fetch more rows.
+	 * Provisions the next batch of rows to the view.
+	 * @param parent Parent index
+	 */
+	void fetchMore(const QModelIndex &parent) final;
+
 	/**
 	 * Set the field to use in this model.
 	 * Field data is *copied* into the model.
@@ -46,35 +46,45 @@ qlonglong ListDataSortProxyModel::parseQString(const QString &str, bool *pbAllNu
 }
 
 /**
- * Numeric comparison function.
- * @param strA
- * @param strB
- * @return True if strA < strB
+ * Get the case-folded sort key for a cell, caching it.
+ * @param index Source model index.
+ * @return Case-folded cell text.
  */
-bool ListDataSortProxyModel::doNumericCompare(const QString &strA, const QString &strB)
+QString ListDataSortProxyModel::caseFoldedKey(const QModelIndex &index) const
 {
-	if (strA.isEmpty() && strB.isEmpty()) {
-		// Both strings are empty.
-		return false;
+	const quint64 key = (static_cast<quint64>(index.row()) << 32) |
+	                     static_cast<quint32>(index.column());
+	auto iter = m_caseFoldCache.constFind(key);
+	if (iter != m_caseFoldCache.constEnd()) {
+		return iter.value();
 	}
 
-	bool okA = false, okB = false;
-	const qlonglong valA = parseQString(strA, &okA);
-	const qlonglong valB = parseQString(strB, &okB);
-
-	if (valA == valB) {
-		// Values are identical.
-		if (okA && !okB) {
-			// Second string is not fully numeric.
-			// strA < strB
-			return true;
-		} else {
-			// Other cases: strA >= strB
-			return false;
-		}
+	const QString folded = index.data().toString().toCaseFolded();
+	m_caseFoldCache.insert(key, folded);
+	return folded;
+}
+
+/**
+ * Get the numeric sort key for a cell, caching it.
+ * @param index	[in] Source model index.
+ * @param pbAllNumeric	[out] Set to true if the entire cell text is numeric.
+ * @return Numeric value.
+ */
+qlonglong ListDataSortProxyModel::numericKey(const QModelIndex &index, bool *pbAllNumeric) const
+{
+	const quint64 key = (static_cast<quint64>(index.row()) << 32) |
+	                     static_cast<quint32>(index.column());
+	auto iter = m_numericCache.constFind(key);
+	if (iter != m_numericCache.constEnd()) {
+		*pbAllNumeric = iter.value().ok;
+		return iter.value().val;
 	}
 
-	return (valA < valB);
+	NumericKey nkey;
+	nkey.val = parseQString(index.data().toString(), &nkey.ok);
+	m_numericCache.insert(key, nkey);
+	*pbAllNumeric = nkey.ok;
+	return nkey.val;
 }
 
 /**
@@ -104,18 +114,73 @@ bool ListDataSortProxyModel::lessThan(const QModelIndex &source_left, const QMod
 			break;
 		case RomFields::COLSORT_NOCASE: {
 			// Case-insensitive sorting.
-			const QString strA = source_left.data().toString();
-			const QString strB = source_right.data().toString();
-			bRet = (QString::compare(strA, strB, Qt::CaseInsensitive) < 0);
+			// NOTE: Comparing cached case-folded keys, which is
+			// equivalent to QString::compare(Qt::CaseInsensitive).
+			bRet = (QString::compare(caseFoldedKey(source_left), caseFoldedKey(source_right)) < 0);
 			break;
 		}
 		case RomFields::COLSORT_NUMERIC: {
-			// Numeric sorting.
-			const QString strA = source_left.data().toString();
-			const QString strB = source_right.data().toString();
-			bRet = doNumericCompare(strA, strB);
+			// Numeric sorting. (using cached parsed values)
+			bool okA = false, okB = false;
+			const qlonglong valA = numericKey(source_left, &okA);
+			const qlonglong valB = numericKey(source_right, &okB);
+			if (valA == valB) {
+				// Values are identical.
+				// A < B only if A is fully numeric and B is not.
+				bRet = (okA && !okB);
+			} else {
+				bRet = (valA < valB);
+			}
 			break;
 		}
 	}
 	return bRet;
 }
+
+/**
+ * Set the source model.
+ * The cached sort keys are cleared, and will be invalidated
+ * whenever the new source model's data changes.
+ * @param sourceModel Source model.
+ */
+void ListDataSortProxyModel::setSourceModel(QAbstractItemModel *sourceModel)
+{
+	QAbstractItemModel *const oldModel = this->sourceModel();
+	if (oldModel) {
+		disconnect(oldModel, &QAbstractItemModel::dataChanged,
+			   this, &ListDataSortProxyModel::invalidateSortCaches);
+		disconnect(oldModel, &QAbstractItemModel::modelReset,
+			   this, &ListDataSortProxyModel::invalidateSortCaches);
+		disconnect(oldModel, &QAbstractItemModel::layoutChanged,
+			   this, &ListDataSortProxyModel::invalidateSortCaches);
+		disconnect(oldModel, &QAbstractItemModel::rowsInserted,
+			   this, &ListDataSortProxyModel::invalidateSortCaches);
+		disconnect(oldModel, &QAbstractItemModel::rowsRemoved,
+			   this, &ListDataSortProxyModel::invalidateSortCaches);
+	}
+
+	super::setSourceModel(sourceModel);
+	invalidateSortCaches();
+
+	if (sourceModel) {
+		connect(sourceModel, &QAbstractItemModel::dataChanged,
+			this, &ListDataSortProxyModel::invalidateSortCaches);
+		connect(sourceModel, &QAbstractItemModel::modelReset,
+			this, &ListDataSortProxyModel::invalidateSortCaches);
+		connect(sourceModel, &QAbstractItemModel::layoutChanged,
+			this, &ListDataSortProxyModel::invalidateSortCaches);
+		connect(sourceModel, &QAbstractItemModel::rowsInserted,
+			this, &ListDataSortProxyModel::invalidateSortCaches);
+		connect(sourceModel, &QAbstractItemModel::rowsRemoved,
+			this, &ListDataSortProxyModel::invalidateSortCaches);
+	}
+}
+
+/**
+ * Invalidate the cached sort keys.
+ */
+void ListDataSortProxyModel::invalidateSortCaches(void)
+{
+	m_caseFoldCache.clear();
+	m_numericCache.clear();
+}
@@ -12,6 +12,7 @@
 #include <stdint.h>
 
 // Qt includes.
+#include <QHash>
 #include <QSortFilterProxyModel>
 
 class ListDataSortProxyModelPrivate;
@@ -41,14 +42,6 @@ private:
 	 */
 	static qlonglong parseQString(const QString &str, bool *pbAllNumeric);
 
-	/**
-	 * Numeric comparison function.
-	 * @param strA
-	 * @param strB
-	 * @return True if strA < strB
-	 */
-	static bool doNumericCompare(const QString &strA, const QString &strB);
-
 public:
 	/**
 	 * Comparison function.
@@ -58,6 +51,36 @@ public:
 	 */
 	bool lessThan(const QModelIndex &source_left, const QModelIndex &source_right) const final;
 
+	/**
+	 * Set the source model.
+	 * The cached sort keys are cleared, and will be invalidated
+	 * whenever the new source model's data changes.
+	 * @param sourceModel Source model.
+	 */
+	void setSourceModel(QAbstractItemModel *sourceModel) final;
+
+private slots:
+	/**
+	 * Invalidate the cached sort keys.
+	 */
+	void invalidateSortCaches(void);
+
+private:
+	/**
+	 * Get the case-folded sort key for a cell, caching it.
+	 * @param index Source model index.
+	 * @return Case-folded cell text.
+	 */
+	QString caseFoldedKey(const QModelIndex &index) const;
+
+	/**
+	 * Get the numeric sort key for a cell, caching it.
+	 * @param index	[in] Source model index.
+	 * @param pbAllNumeric	[out] Set to true if the entire cell text is numeric.
+	 * @return Numeric value.
+	 */
+	qlonglong numericKey(const QModelIndex &index, bool *pbAllNumeric) const;
+
 public:
 	/**
 	 * Set the sorting methods.
@@ -89,4 +112,15 @@ signals:
 
 private:
 	uint16_t m_sortingMethods;
+
+	// Per-cell sort keys, built lazily the first time a cell is
+	// used in a comparison, so an O(n log n) sort only case-folds
+	// or parses each cell once instead of per comparison.
+	// Key: (source row << 32) | source column
+	struct NumericKey {
+		qlonglong val;
+		bool ok;	// true if the entire cell text is numeric
+	};
+	mutable QHash<quint64, QString> m_caseFoldCache;
+	mutable QHash<quint64, NumericKey> m_numericCache;
 };
@@ -10,7 +10,12 @@
 #include "ProxyForUrl.hpp"
 #include "RpQt.hpp"
 
+// C includes (C++ namespace)
+#include <ctime>
+
 // C++ STL classes
+#include <mutex>
+#include <unordered_map>
 using std::string;
 
 #if QT_VERSION >= QT_VERSION_CHECK(6,0,0)
@@ -22,12 +27,108 @@ using std::string;
 #  include <kprotocolmanager.h>
 #endif /* QT_VERSION >= QT_VERSION_CHECK(6,0,0) */
 
+namespace {
+
 /**
- * Get the proxy for the specified URL.
+ * Proxy resolution cache, keyed by URL scheme+host.
+ *
+ * KProtocolManager/QNetworkProxyFactory may re-read the proxy
+ * configuration on every query, so a fetch burst should only
+ * resolve the proxy once. The short TTL bounds staleness;
+ * proxyForUrl_clearCache() can be used as an invalidation hook
+ * on settings change.
+ */
+class ProxyCache
+{
+public:
+	ProxyCache() = default;
+
+private:
+	RP_DISABLE_COPY(ProxyCache)
+
+public:
+	// Cache TTL, in seconds.
+	static constexpr time_t TTL = 30;
+
+	/**
+	 * Look up a cached proxy resolution.
+	 * @param key		[in] URL scheme+host.
+	 * @param pProxy	[out] Cached proxy. (may be empty for "no proxy")
+	 * @return True if a valid cache entry was found.
+	 */
+	bool lookup(const string &key, string *pProxy)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto iter = m_map.find(key);
+		if (iter == m_map.end()) {
+			return false;
+		}
+		if (time(nullptr) >= iter->second.expiry) {
+			// Entry has expired.
+			m_map.erase(iter);
+			return false;
+		}
+		*pProxy = iter->second.proxy;
+		return true;
+	}
+
+	/**
+	 * Store a proxy resolution.
+	 * @param key	[in] URL scheme+host.
+	 * @param proxy	[in] Resolved proxy. (may be empty for "no proxy")
+	 */
+	void store(const string &key, const string &proxy)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		Entry &entry = m_map[key];
+		entry.proxy = proxy;
+		entry.expiry = time(nullptr) + TTL;
+	}
+
+	/**
+	 * Clear the cache.
+	 */
+	void clear(void)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_map.clear();
+	}
+
+private:
+	struct Entry {
+		string proxy;
+		time_t expiry;
+	};
+
+	std::mutex m_mutex;
+	std::unordered_map<string, Entry> m_map;
+};
+
+// Proxy resolution cache.
+ProxyCache g_proxyCache;
+
+/**
+ * Get the scheme+host portion of a URL, e.g. "https://art.gametdb.com".
+ * @param url URL
+ * @return Scheme+host, or empty string if the URL has no scheme.
+ */
+string urlSchemeHost(const char *url)
+{
+	const char *const scheme_end = strstr(url, "://");
+	if (!scheme_end) {
+		// No scheme.
+		return {};
+	}
+	const char *const host_end = strchr(scheme_end + 3, '/');
+	return (host_end ? string(url, host_end - url) : string(url));
+}
+
+/**
+ * Resolve the proxy for the specified URL. (uncached)
  * @param url URL
  * @return Proxy, or empty string if no proxy is needed.
  */
-string proxyForUrl(const char *url)
+string proxyForUrl_int(const char *url)
 {
 #if QT_VERSION >= QT_VERSION_CHECK(6,0,0)
 	QList<QNetworkProxy> proxies = QNetworkProxyFactory::proxyForQuery(
@@ -87,3 +188,43 @@ string proxyForUrl(const char *url)
 	return Q2U8(proxy);
 #endif /* QT_VERSION >= QT_VERSION_CHECK(6,0,0) */
 }
+
+} //namespace (anonymous)
+
+/**
+ * Get the proxy for the specified URL.
+ *
+ * Results are cached per URL scheme+host with a short TTL,
+ * since KProtocolManager/QNetworkProxyFactory may re-read the
+ * proxy configuration on every query.
+ *
+ * @param url URL
+ * @return Proxy, or empty string if no proxy is needed.
+ */
+string proxyForUrl(const char *url)
+{
+	// Check the cache first.
+	const string cache_key = urlSchemeHost(url);
+	string ret;
+	if (!cache_key.empty() && g_proxyCache.lookup(cache_key, &ret)) {
+		// Cache hit. (possibly "no proxy")
+		return ret;
+	}
+
+	ret = proxyForUrl_int(url);
+
+	// Cache the result, including "no proxy" results.
+	if (!cache_key.empty()) {
+		g_proxyCache.store(cache_key, ret);
+	}
+	return ret;
+}
+
+/**
+ * Clear the proxy resolution cache.
+ * Call this when the system proxy settings have changed.
+ */
+void proxyForUrl_clearCache(void)
+{
+	g_proxyCache.clear();
+}
@@ -945,6 +945,10 @@ void RomDataViewPrivate::initDisplayWidgets(void)
 			char tab_name[32];
 			snprintf(tab_name, sizeof(tab_name), "tab%d", i);
 			widget->setObjectName(QLatin1String(tab_name));
+			// Save the tabs[] index for lazy population.
+			// NOTE: The QTabWidget index may not match tabs[]
+			// if any tabs are hidden.
+			widget->setProperty("RFT_tabIdx", i);
 
 			// Layouts.
 			// NOTE: We shouldn't zero out the QVBoxLayout margins here.
@@ -982,11 +986,67 @@ void RomDataViewPrivate::initDisplayWidgets(void)
 	// TODO: Ensure the description column has the
 	// same width on all tabs.
 
+	// Populate the first visible tab immediately. The remaining
+	// tabs are populated lazily when they're first selected, which
+	// keeps field-heavy ROM images from freezing the properties
+	// dialog while it opens.
+	for (int i = 0; i < static_cast<int>(tabs.size()); i++) {
+		if (tabs[i].form) {
+			initFieldsForTab(i);
+			break;
+		}
+	}
+
+	// Close the file.
+	// Keeping the file open may prevent the user from
+	// changing the file.
+	// NOTE: The remaining tabs only use the parsed RomFields,
+	// so they can be populated after the file is closed.
+	romData->close();
+}
+
+/**
+ * Initialize the display widgets for a single tab.
+ * Called lazily when the tab is first selected.
+ * @param tabIdx Tab index
+ */
+void RomDataViewPrivate::initFieldsForTab(int tabIdx)
+{
+	assert(tabIdx >= 0);
+	assert(tabIdx < (int)tabs.size());
+	if (tabIdx < 0 || tabIdx >= (int)tabs.size()) {
+		// Tab index is out of bounds.
+		return;
+	}
+
+	auto &tab = tabs[tabIdx];
+	if (tab.populated || !tab.form) {
+		// Tab is already populated, or is hidden.
+		return;
+	}
+	tab.populated = true;
+
+	if (!romData) {
+		// No ROM data to display.
+		return;
+	}
+	const RomFields *const pFields = romData->fields();
+	assert(pFields != nullptr);
+	if (!pFields) {
+		// No fields.
+		return;
+	}
+
+	Q_Q(RomDataView);
+
 	// tr: Field description label.
 	const char *const desc_label_fmt = C_("RomDataView", "%s:");
 
+	// Check if any multi-language fields are added by this tab.
+	const size_t prevStringMulti = vecStringMulti.size();
+	const size_t prevListDataMulti = vecListDataMulti.size();
+
 	// Create the data widgets.
-	int prevTabIdx = 0;
 	int fieldIdx = 0;
 	const auto pFields_cend = pFields->cend();
 	for (auto iter = pFields->cbegin(); iter != pFields_cend; ++iter, fieldIdx++) {
@@ -995,25 +1055,9 @@ void RomDataViewPrivate::initDisplayWidgets(void)
 		if (!field.isValid())
 			continue;
 
-		// Verify the tab index.
-		const int tabIdx = field.tabIdx;
-		assert(tabIdx >= 0 && tabIdx < (int)tabs.size());
-		if (tabIdx < 0 || tabIdx >= (int)tabs.size()) {
-			// Tab index is out of bounds.
-			continue;
-		} else if (!tabs[tabIdx].form) {
-			// Tab name is empty. Tab is hidden.
+		// Only process fields on this tab.
+		if (field.tabIdx != tabIdx)
 			continue;
-		}
-
-		// Did the tab index change?
-		if (prevTabIdx != tabIdx) {
-			// Check if the last field in the previous tab
-			// was RFT_LISTDATA. If it is, expand it vertically.
-			// NOTE: Only for RFT_LISTDATA_SEPARATE_ROW.
-			adjustListData(prevTabIdx);
-			prevTabIdx = tabIdx;
-		}
 
 		// tr: Field description label.
 		const string txt = rp_sprintf(desc_label_fmt, field.name);
@@ -1066,29 +1110,24 @@ void RomDataViewPrivate::initDisplayWidgets(void)
 		}
 	}
 
-	// Initial update of RFT_STRING_MULTI and RFT_LISTDATA_MULTI fields.
-	if (!vecStringMulti.empty() || !vecListDataMulti.empty()) {
-		def_lc = pFields->defaultLanguageCode();
-		updateMulti(0);
-	}
-
-	// Check if the last field in the last tab
-	// was RFT_LISTDATA. If it is, expand it vertically.
+	// Check if the last field in the tab was RFT_LISTDATA.
+	// If it is, expand it vertically.
 	// NOTE: Only for RFT_LISTDATA_SEPARATE_ROW.
-	if (!tabs.empty()) {
-		adjustListData(static_cast<int>(tabs.size()-1));
-	}
+	adjustListData(tabIdx);
 
-	// Add vertical spacers to each QFormLayout.
+	// Add a vertical spacer to the QFormLayout.
 	// This is mostly needed for e.g. DSi and 3DS permissions.
-	for (const tab &tab : tabs) {
-		tab.form->addItem(new QSpacerItem(0, 0));
-	}
+	tab.form->addItem(new QSpacerItem(0, 0));
 
-	// Close the file.
-	// Keeping the file open may prevent the user from
-	// changing the file.
-	romData->close();
+	// Update any newly-added RFT_STRING_MULTI and RFT_LISTDATA_MULTI fields.
+	if (vecStringMulti.size() != prevStringMulti ||
+	    vecListDataMulti.size() != prevListDataMulti)
+	{
+		if (def_lc == 0) {
+			def_lc = pFields->defaultLanguageCode();
+		}
+		updateMulti(cboLanguage ? cboLanguage->selectedLC() : 0);
+	}
 }
 
 /** RomDataView **/
@@ -1100,6 +1139,10 @@ RomDataView::RomDataView(QWidget *parent)
 	Q_D(RomDataView);
 	d->ui.setupUi(this);
 
+	// Populate tabs lazily when they're first selected.
+	QObject::connect(d->ui.tabWidget, SIGNAL(currentChanged(int)),
+	                 this, SLOT(tabWidget_currentChanged_slot(int)));
+
 	// Create the "Options" button in the parent window.
 	d->createOptionsButton();
 }
@@ -1111,6 +1154,10 @@ RomDataView::RomDataView(const RomDataPtr &romData, QWidget *parent)
 	Q_D(RomDataView);
 	d->ui.setupUi(this);
 
+	// Populate tabs lazily when they're first selected.
+	QObject::connect(d->ui.tabWidget, SIGNAL(currentChanged(int)),
+	                 this, SLOT(tabWidget_currentChanged_slot(int)));
+
 	// Create the "Options" button in the parent window.
 	d->createOptionsButton();
 
@@ -1275,6 +1322,27 @@ void RomDataView::cboLanguage_lcChanged_slot(uint32_t lc)
 	d->updateMulti(lc);
 }
 
+/**
+ * A tab was selected in the tab widget.
+ * Populates the tab's fields if necessary.
+ * @param index Tab index
+ */
+void RomDataView::tabWidget_currentChanged_slot(int index)
+{
+	Q_D(RomDataView);
+	QWidget *const widget = d->ui.tabWidget->widget(index);
+	if (!widget)
+		return;
+
+	// NOTE: The QTabWidget index may not match tabs[]
+	// if any tabs are hidden, so use the saved index.
+	bool ok = false;
+	const int tabIdx = widget->property("RFT_tabIdx").toInt(&ok);
+	if (ok) {
+		d->initFieldsForTab(tabIdx);
+	}
+}
+
 /** Properties **/
 
 /**
@@ -84,6 +84,13 @@ protected slots:
 	 */
 	void cboLanguage_lcChanged_slot(uint32_t lc);
 
+	/**
+	 * A tab was selected in the tab widget.
+	 * Populates the tab's fields if necessary.
+	 * @param index Tab index
+	 */
+	void tabWidget_currentChanged_slot(int index);
+
 public:
 	/** Properties **/
 
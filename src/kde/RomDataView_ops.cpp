@@ -61,6 +61,14 @@ int RomDataViewPrivate::updateField(int fieldIdx)
 	if (!field)
 		return 3;
 
+	// If the field's tab hasn't been populated yet, there's
+	// nothing to update. The current field value will be used
+	// when the tab is populated.
+	const int tabIdx = field->tabIdx;
+	if (tabIdx >= 0 && tabIdx < (int)tabs.size() && !tabs[tabIdx].populated) {
+		return 0;
+	}
+
 	// Lambda function to check a QObject's RFT_fieldIdx.
 	auto checkFieldIdx = [](QObject *qObj, int fieldIdx) -> bool {
 		const QVariant qVar = qObj->property("RFT_fieldIdx");
@@ -75,6 +83,10 @@ int RomDataViewPrivate::updateField(int fieldIdx)
 	QObject *qObj = nullptr;
 	for (const auto &tab : tabs) {
 		QFormLayout *const form = tab.form;
+		if (!form) {
+			// Tab is hidden.
+			continue;
+		}
 		const int rowCount = form->rowCount();
 		for (int row = 0; row < rowCount && qObj == nullptr; row++) {
 			// TODO: Also check LabelRole in some cases?
@@ -70,8 +70,9 @@ public:
 		QVBoxLayout *vbox;
 		QFormLayout *form;
 		QLabel *lblCredits;
+		bool populated;	// Have the fields been created yet?
 
-		tab() : vbox(nullptr), form(nullptr), lblCredits(nullptr)
+		tab() : vbox(nullptr), form(nullptr), lblCredits(nullptr), populated(false)
 		{}
 	};
 	std::vector<tab> tabs;
@@ -226,9 +227,20 @@ public:
 	 * Initialize the display widgets.
 	 * If the widgets already exist, they will
 	 * be deleted and recreated.
+	 *
+	 * Only the first visible tab is populated here; the
+	 * remaining tabs are populated by initFieldsForTab()
+	 * when they're first selected.
 	 */
 	void initDisplayWidgets(void);
 
+	/**
+	 * Initialize the display widgets for a single tab.
+	 * Called lazily when the tab is first selected.
+	 * @param tabIdx Tab index
+	 */
+	void initFieldsForTab(int tabIdx);
+
 public:
 	/**
 	 * ROM operation: Standard Operations
@@ -194,8 +194,14 @@ int RpQImageBackend::shrink(int width, int height)
 QImage RpQImageBackend::getQImage(void) const
 {
 	if (this->format == rp_image::Format::CI8) {
-		// Copy the local color table to the QImage.
-		const_cast<RpQImageBackend*>(this)->m_qImage.setColorTable(m_qPalette);
+		// Copy the local color table to the QImage,
+		// but only if it changed. setColorTable() detaches,
+		// which would deep-copy the pixel data if a previously
+		// returned QImage is still alive. After the first call,
+		// the comparison is a cheap shared-data check.
+		if (m_qImage.colorTable() != m_qPalette) {
+			const_cast<RpQImageBackend*>(this)->m_qImage.setColorTable(m_qPalette);
+		}
 	}
 
 	return m_qImage;
@@ -71,16 +71,19 @@ protected:
 
 	/**
 	 * Initialize the "Credits" tab.
+	 * Called lazily by initTabContents().
 	 */
 	void initCreditsTab(void);
 
 	/**
 	 * Initialize the "Libraries" tab.
+	 * Called lazily by initTabContents().
 	 */
 	void initLibrariesTab(void);
 
 	/**
 	 * Initialize the "Support" tab.
+	 * Called lazily by initTabContents().
 	 */
 	void initSupportTab(void);
 
@@ -90,6 +93,12 @@ public:
 	 */
 	void init(void);
 
+	/**
+	 * Initialize a tab's contents if they haven't been initialized yet.
+	 * @param index Tab index
+	 */
+	void initTabContents(int index);
+
 	/**
 	 * Check for updates.
 	 */
@@ -102,6 +111,9 @@ public:
 
 	// Checked for updates yet?
 	bool checkedForUpdates;
+
+	// Has each tab's contents been initialized yet?
+	bool tabInit[3];
 };
 
 /** AboutTabPrivate **/
@@ -118,6 +130,7 @@ AboutTabPrivate::AboutTabPrivate(AboutTab *q)
 	, thrUpdate(q)
 	, updChecker()
 	, checkedForUpdates(false)
+	, tabInit{false, false, false}
 {
 	thrUpdate.setObjectName(QLatin1String("thrUpdate"));
 
@@ -566,9 +579,43 @@ void AboutTabPrivate::initSupportTab(void)
 void AboutTabPrivate::init(void)
 {
 	initProgramTitleText();
-	initCreditsTab();
-	initLibrariesTab();
-	initSupportTab();
+
+	// Tab contents are initialized lazily when each tab is
+	// first selected, so opening the dialog doesn't pay for
+	// all three tabs up front. (LanguageChange re-runs init(),
+	// so drop any previously-initialized contents.)
+	memset(tabInit, 0, sizeof(tabInit));
+	initTabContents(ui.tabWidget->currentIndex());
+}
+
+/**
+ * Initialize a tab's contents if they haven't been initialized yet.
+ * @param index Tab index
+ */
+void AboutTabPrivate::initTabContents(int index)
+{
+	assert(index >= 0);
+	assert(index < ARRAY_SIZE_I(tabInit));
+	if (index < 0 || index >= ARRAY_SIZE_I(tabInit))
+		return;
+	if (tabInit[index])
+		return;
+	tabInit[index] = true;
+
+	switch (index) {
+		case 0:
+			initCreditsTab();
+			break;
+		case 1:
+			initLibrariesTab();
+			break;
+		case 2:
+			initSupportTab();
+			break;
+		default:
+			assert(!"Invalid tab index.");
+			break;
+	}
 }
 
 /**
@@ -593,6 +640,10 @@ AboutTab::AboutTab(QWidget *parent)
 	Q_D(AboutTab);
 	d->ui.setupUi(this);
 
+	// Initialize tab contents lazily when a tab is selected.
+	QObject::connect(d->ui.tabWidget, SIGNAL(currentChanged(int)),
+			 this, SLOT(tabWidget_currentChanged_slot(int)));
+
 	// Initialize the dialog.
 	d->init();
 }
@@ -636,6 +687,17 @@ void AboutTab::showEvent(QShowEvent *event)
 	}
 }
 
+/**
+ * A tab was selected in the tab widget.
+ * Initializes the tab's contents if necessary.
+ * @param index Tab index
+ */
+void AboutTab::tabWidget_currentChanged_slot(int index)
+{
+	Q_D(AboutTab);
+	d->initTabContents(index);
+}
+
 /** UpdateChecker slots **/
 
 /**
@@ -55,6 +55,13 @@ public slots:
 	}
 
 protected slots:
+	/**
+	 * A tab was selected in the tab widget.
+	 * Initializes the tab's contents if necessary.
+	 * @param index Tab index
+	 */
+	void tabWidget_currentChanged_slot(int index);
+
 	/** UpdateChecker slots **/
 
 	/**
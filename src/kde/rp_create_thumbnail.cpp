@@ -131,6 +131,9 @@ Q_DECL_EXPORT int RP_C_API rp_create_thumbnail2(const char *source_file, const c
 		return RPCT_ERROR_OUTPUT_FILE_FAILED;
 	}
 
+	// Thumbnails don't need maximum compression.
+	pngWriter->setCompressionProfile(RpPngWriter::CompressionProfile::Speed);
+
 	const bool doXDG = !(flags & RPCT_FLAG_NO_XDG_THUMBNAIL_METADATA);
 	kv.reserve(doXDG ? 5 : 1);
 
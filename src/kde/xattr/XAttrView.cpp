@@ -16,10 +16,83 @@
 #include "librpfile/xattr/XAttrReader.hpp"
 using LibRpFile::XAttrReader;
 
+// Qt includes
+#include <QtCore/QThread>
+
 // C++ STL classes
 using std::string;
 using std::unique_ptr;
 
+/** XAttrReaderTask **/
+
+/**
+ * XAttrReaderTask: Worker object for reading attributes without
+ * blocking the UI thread.
+ *
+ * Constructing the XAttrReader is the only part that touches the
+ * file, so it runs on a worker thread; the UI thread takes the
+ * finished reader and populates the display widgets.
+ */
+class XAttrReaderTask : public QObject
+{
+Q_OBJECT
+
+public:
+	explicit XAttrReaderTask(QObject *parent = nullptr)
+		: super(parent)
+	{}
+
+private:
+	typedef QObject super;
+	Q_DISABLE_COPY(XAttrReaderTask)
+
+public:
+	/**
+	 * Set the filename to read attributes from.
+	 * Must be set before starting the thread.
+	 * @param filename Local filename (UTF-8)
+	 */
+	void setFilename(const string &filename)
+	{
+		m_filename = filename;
+	}
+
+	/**
+	 * Take ownership of the constructed XAttrReader.
+	 * @return XAttrReader, or nullptr if the read failed.
+	 */
+	XAttrReader *takeReader(void)
+	{
+		return m_reader.release();
+	}
+
+public slots:
+	/**
+	 * Run the task.
+	 * This should be connected to QThread::started().
+	 */
+	void run(void)
+	{
+		m_reader.reset(new XAttrReader(m_filename.c_str()));
+		if (m_reader->lastError() != 0) {
+			// Error reading attributes.
+			m_reader.reset();
+		}
+		emit finished();
+	}
+
+signals:
+	/**
+	 * The attribute read has completed.
+	 * Use takeReader() to get the result.
+	 */
+	void finished(void);
+
+private:
+	string m_filename;
+	unique_ptr<XAttrReader> m_reader;
+};
+
 /** XAttrViewPrivate **/
 
 #include "ui_XAttrView.h"
@@ -27,11 +100,42 @@ class XAttrViewPrivate
 {
 public:
 	// TODO: Remove localizeQUrl() once non-local QUrls are supported.
-	explicit XAttrViewPrivate(const QUrl &filename)
-		: filename(localizeQUrl(filename))
+	explicit XAttrViewPrivate(XAttrView *q, const QUrl &filename)
+		: q_ptr(q)
+		, filename(localizeQUrl(filename))
+		, thrReader(q)
+		, loadPending(false)
 		, hasAttributes(false)
-	{}
+	{
+		thrReader.setObjectName(QLatin1String("thrReader"));
+		readerTask.setObjectName(QLatin1String("readerTask"));
+		readerTask.moveToThread(&thrReader);
+
+		// Thread signals
+		QObject::connect(&thrReader, SIGNAL(started()),
+				 &readerTask, SLOT(run()));
+		QObject::connect(&readerTask, SIGNAL(finished()),
+				 &thrReader, SLOT(quit()));
+		QObject::connect(&thrReader, SIGNAL(finished()),
+				 q, SLOT(thrReader_finished_slot()));
+	}
 
+	~XAttrViewPrivate()
+	{
+		if (thrReader.isRunning()) {
+			// Make sure the thread is stopped.
+			thrReader.quit();
+			bool ok = thrReader.wait(5000);
+			if (!ok) {
+				// Thread is hung. Terminate it.
+				thrReader.terminate();
+			}
+		}
+	}
+
+protected:
+	XAttrView *const q_ptr;
+	Q_DECLARE_PUBLIC(XAttrView)
 private:
 	Q_DISABLE_COPY(XAttrViewPrivate)
 
@@ -42,6 +146,13 @@ public:
 	// XAttrReader
 	unique_ptr<XAttrReader> xattrReader;
 
+	// Attribute reader task and thread.
+	QThread thrReader;
+	XAttrReaderTask readerTask;
+
+	// Is another load waiting for the current one to finish?
+	bool loadPending;
+
 	// Do we have attributes for this file?
 	bool hasAttributes;
 
@@ -72,12 +183,20 @@ private:
 
 public:
 	/**
-	 * Load the attributes from the specified file.
-	 * The attributes will be loaded into the display widgets.
+	 * Start loading the attributes from the specified file.
+	 * The attributes are read on a worker thread; the display
+	 * widgets are populated by populateAttributes() when
+	 * the read finishes.
 	 * @return 0 on success; negative POSIX error code on error.
 	 */
 	int loadAttributes(void);
 
+	/**
+	 * Populate the display widgets using the attributes
+	 * read by the worker thread.
+	 */
+	void populateAttributes(void);
+
 	/**
 	 * Clear the display widgets.
 	 */
@@ -213,8 +332,10 @@ int XAttrViewPrivate::loadPosixXattrs(void)
 }
 
 /**
- * Load the attributes from the specified file.
- * The attributes will be loaded into the display widgets.
+ * Start loading the attributes from the specified file.
+ * The attributes are read on a worker thread; the display
+ * widgets are populated by populateAttributes() when
+ * the read finishes.
  * @return 0 on success; negative POSIX error code on error.
  */
 int XAttrViewPrivate::loadAttributes(void)
@@ -243,13 +364,36 @@ int XAttrViewPrivate::loadAttributes(void)
 		s_local_filename = filename.toLocalFile().toUtf8().constData();
 	}
 
-	// Open an XAttrReader.
-	xattrReader.reset(new XAttrReader(s_local_filename.c_str()));
-	int err = xattrReader->lastError();
-	if (err != 0) {
+	if (thrReader.isRunning()) {
+		// A read is already in progress.
+		// Restart it with the new filename once it finishes.
+		loadPending = true;
+		return 0;
+	}
+
+	// Read the attributes on the worker thread. This can stall on
+	// slow file systems (e.g. NFS), and we don't want to block the
+	// properties dialog while it's happening.
+	readerTask.setFilename(s_local_filename);
+	thrReader.start();
+	return 0;
+}
+
+/**
+ * Populate the display widgets using the attributes
+ * read by the worker thread.
+ */
+void XAttrViewPrivate::populateAttributes(void)
+{
+	Q_Q(XAttrView);
+
+	xattrReader.reset(readerTask.takeReader());
+	if (!xattrReader) {
 		// Error reading attributes.
-		xattrReader.reset();
-		return err;
+		hasAttributes = false;
+		clearDisplayWidgets();
+		emit q->hasAttributesChanged(false);
+		return;
 	}
 
 	// Load the attributes.
@@ -279,7 +423,7 @@ int XAttrViewPrivate::loadAttributes(void)
 		hasAttributes = false;
 		clearDisplayWidgets();
 	}
-	return 0;
+	emit q->hasAttributesChanged(hasAttributes);
 }
 
 /**
@@ -296,7 +440,7 @@ void XAttrViewPrivate::clearDisplayWidgets()
 
 XAttrView::XAttrView(QWidget *parent)
 	: super(parent)
-	, d_ptr(new XAttrViewPrivate(QUrl()))
+	, d_ptr(new XAttrViewPrivate(this, QUrl()))
 {
 	Q_D(XAttrView);
 	d->ui.setupUi(this);
@@ -304,7 +448,7 @@ XAttrView::XAttrView(QWidget *parent)
 
 XAttrView::XAttrView(const QUrl &filename, QWidget *parent)
 	: super(parent)
-	, d_ptr(new XAttrViewPrivate(filename))
+	, d_ptr(new XAttrViewPrivate(this, filename))
 {
 	Q_D(XAttrView);
 	d->ui.setupUi(this);
@@ -313,6 +457,11 @@ XAttrView::XAttrView(const QUrl &filename, QWidget *parent)
 	d->loadAttributes();
 }
 
+XAttrView::~XAttrView()
+{
+	delete d_ptr;
+}
+
 /**
  * Get the current filename.
  * @return Current filename
@@ -343,6 +492,10 @@ void XAttrView::setFilename(const QUrl &filename)
 
 /**
  * Do we have attributes for the specified filename?
+ *
+ * NOTE: Attributes are read asynchronously. Connect to
+ * hasAttributesChanged() to find out when the read finishes.
+ *
  * @return True if we have attributes; false if not.
  */
 bool XAttrView::hasAttributes(void) const
@@ -350,3 +503,34 @@ bool XAttrView::hasAttributes(void) const
 	Q_D(const XAttrView);
 	return d->hasAttributes;
 }
+
+/**
+ * Is an attribute read currently in progress?
+ * @return True if the worker thread is reading attributes.
+ */
+bool XAttrView::isLoading(void) const
+{
+	Q_D(const XAttrView);
+	return (d->thrReader.isRunning() || d->loadPending);
+}
+
+/**
+ * The attribute reader thread has finished.
+ */
+void XAttrView::thrReader_finished_slot(void)
+{
+	Q_D(XAttrView);
+
+	if (d->loadPending) {
+		// The filename changed while the attributes were
+		// being read. Discard this result and start over.
+		d->loadPending = false;
+		delete d->readerTask.takeReader();
+		d->loadAttributes();
+		return;
+	}
+
+	d->populateAttributes();
+}
+
+#include "XAttrView.moc"
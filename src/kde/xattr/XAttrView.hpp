@@ -22,6 +22,7 @@ Q_PROPERTY(QUrl filename READ filename WRITE setFilename NOTIFY filenameChanged)
 public:
 	explicit XAttrView(QWidget *parent = nullptr);
 	explicit XAttrView(const QUrl &url, QWidget *parent = nullptr);
+	~XAttrView() override;
 
 private:
 	typedef QWidget super;
@@ -45,14 +46,36 @@ public:
 public:
 	/**
 	 * Do we have attributes for the specified filename?
+	 *
+	 * NOTE: Attributes are read asynchronously. Connect to
+	 * hasAttributesChanged() to find out when the read finishes.
+	 *
 	 * @return True if we have attributes; false if not.
 	 */
 	bool hasAttributes(void) const;
 
+	/**
+	 * Is an attribute read currently in progress?
+	 * @return True if the worker thread is reading attributes.
+	 */
+	bool isLoading(void) const;
+
+protected slots:
+	/**
+	 * The attribute reader thread has finished.
+	 */
+	void thrReader_finished_slot(void);
+
 signals:
 	/**
 	 * The filename has been changed.
 	 * @param url New filename
 	 */
 	void filenameChanged(const QUrl &url);
+
+	/**
+	 * An asynchronous attribute read has completed.
+	 * @param hasAttributes True if attributes were found; false if not.
+	 */
+	void hasAttributesChanged(bool hasAttributes);
 };
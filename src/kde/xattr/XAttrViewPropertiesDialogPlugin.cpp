@@ -32,16 +32,49 @@ using LibRpBase::Config;
 XAttrView *XAttrViewPropertiesDialogPlugin::createXAttrView(const KFileItem &fileItem, KPropertiesDialog *props)
 {
 	XAttrView *const xattrView = new XAttrView(fileItem.url(), props);
-	if (!xattrView->hasAttributes()) {
-		// No attributes. Don't show the page.
+	if (!xattrView->isLoading() && !xattrView->hasAttributes()) {
+		// Attribute read failed immediately, e.g. a non-local URL.
+		// Don't show the page.
 		delete xattrView;
 		return nullptr;
 	}
 
 	xattrView->setObjectName(QLatin1String("xattrView"));
+
+	// The attributes are read asynchronously so the dialog isn't
+	// blocked on slow file systems. Add the page once the read
+	// finishes, if attributes were actually found.
+	connect(xattrView, SIGNAL(hasAttributesChanged(bool)),
+		this, SLOT(xattrView_hasAttributesChanged_slot(bool)));
 	return xattrView;
 }
 
+/**
+ * An XAttrView has finished reading attributes.
+ * Adds the page to the dialog if attributes were found.
+ * @param hasAttributes True if attributes were found; false if not.
+ */
+void XAttrViewPropertiesDialogPlugin::xattrView_hasAttributesChanged_slot(bool hasAttributes)
+{
+	XAttrView *const xattrView = qobject_cast<XAttrView*>(sender());
+	assert(xattrView != nullptr);
+	if (!xattrView)
+		return;
+
+	if (!hasAttributes) {
+		// No attributes. Don't show the page.
+		xattrView->deleteLater();
+		return;
+	}
+
+	KPropertiesDialog *const props = qobject_cast<KPropertiesDialog*>(parent());
+	assert(props != nullptr);
+	if (props) {
+		// tr: XAttrView tab title
+		props->addPage(xattrView, U82Q(C_("XAttrView", "xattrs")));
+	}
+}
+
 /**
  * Instantiate properties pages for the given KPropertiesDialog.
  * @param parent KPropertiesDialog (NOTE: QObject* is used for registerPlugin() compatibility.)
@@ -77,9 +110,7 @@ XAttrViewPropertiesDialogPlugin::XAttrViewPropertiesDialogPlugin(QObject *parent
 	}
 
 	// Create the XAttrView.
-	XAttrView *const xattrView = createXAttrView(fileItem, props);
-	if (xattrView) {
-		// tr: XAttrView tab title
-		props->addPage(xattrView, U82Q(C_("XAttrView", "xattrs")));
-	}
+	// The page is added by xattrView_hasAttributesChanged_slot()
+	// once the asynchronous attribute read finishes.
+	createXAttrView(fileItem, props);
 }
@@ -47,4 +47,12 @@ protected:
 	 * @return XAttrView object, or nullptr if the file is not supported.
 	 */
 	XAttrView *createXAttrView(const KFileItem &fileItem, KPropertiesDialog *props = nullptr);
+
+protected slots:
+	/**
+	 * An XAttrView has finished reading attributes.
+	 * Adds the page to the dialog if attributes were found.
+	 * @param hasAttributes True if attributes were found; false if not.
+	 */
+	void xattrView_hasAttributesChanged_slot(bool hasAttributes);
 };
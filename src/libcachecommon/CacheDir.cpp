@@ -12,7 +12,7 @@
 using std::string;
 
 // librpthreads
-#include "librpthreads/pthread_once.h"
+#include "librpthreads/rp_once.h"
 
 // OS-specific userdirs
 #ifdef _WIN32
@@ -28,14 +28,14 @@ using std::string;
 namespace LibCacheCommon {
 
 /** Configuration directories. **/
-// pthread_once() control variable.
-static pthread_once_t cache_dir_once_control = PTHREAD_ONCE_INIT;
+// rp_once() control variable.
+static rp_once_t cache_dir_once_control = RP_ONCE_INIT;
 // User's cache directory.
 static string cache_dir;
 
 /**
  * Initialize the cache directory.
- * Called by pthread_once().
+ * Called by rp_once().
  */
 static void initCacheDirectory(void)
 {
@@ -66,7 +66,7 @@ static void initCacheDirectory(void)
  */
 const std::string &getCacheDirectory(void)
 {
-	pthread_once(&cache_dir_once_control, initCacheDirectory);
+	rp_once(&cache_dir_once_control, initCacheDirectory);
 	return cache_dir;
 }
 
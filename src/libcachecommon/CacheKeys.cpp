@@ -10,6 +10,8 @@
 #include "CacheKeys.hpp"
 #include "CacheDir.hpp"
 
+#include "common.h"	// for RP_DISABLE_COPY()
+
 // C includes (C++ namespace)
 #include <cassert>
 #include <cerrno>
@@ -19,13 +21,27 @@
 
 // C++ STL classes
 #include <array>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 using std::array;
 using std::string;
 #ifdef _WIN32
 using std::wstring;
 #endif /* _WIN32 */
 
+// Vectorized chunk scanning for filterCacheKey().
+// amd64 always has SSE2, and arm64 always has NEON,
+// so no runtime dispatch is needed.
+#include "librpcpuid/cpu_dispatch.h"
+#if defined(RP_CPU_AMD64) || (defined(RP_CPU_I386) && defined(__SSE2__))
+#  define CACHEKEY_HAS_SSE2 1
+#  include <emmintrin.h>
+#elif defined(RP_CPU_ARM64)
+#  define CACHEKEY_HAS_NEON 1
+#  include <arm_neon.h>
+#endif
+
 // OS-specific directory separator.
 #ifdef _WIN32
 #  include "libwin32common/RpWin32_sdk.h"
@@ -60,6 +76,63 @@ static constexpr array<uint8_t, 0x80> valid_ascii_tbl = {{
 	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 1, 1, 1, // 0x80 (|)
 }};
 
+#if defined(CACHEKEY_HAS_SSE2) || defined(CACHEKEY_HAS_NEON)
+/**
+ * Check if a 16-byte chunk of a cache key consists entirely of
+ * plain valid characters. (valid_ascii_tbl class 1)
+ *
+ * Dots, slashes, UTF-8 sequences, and characters that need to be
+ * replaced or rejected must be handled by the scalar loop.
+ *
+ * @param p Chunk. (unaligned)
+ * @return True if all 16 bytes are plain valid characters.
+ */
+static inline bool isPlainChunk(const char *p)
+{
+#ifdef CACHEKEY_HAS_SSE2
+	const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+
+	// Control characters (0x00-0x1F).
+	// NOTE: Signed compare, so UTF-8 bytes (0x80-0xFF) match here too.
+	__m128i special = _mm_cmplt_epi8(chunk, _mm_set1_epi8(0x20));
+
+	// Characters with class != 1 in valid_ascii_tbl.
+	special = _mm_or_si128(special, _mm_cmpeq_epi8(chunk, _mm_set1_epi8('"')));
+	special = _mm_or_si128(special, _mm_cmpeq_epi8(chunk, _mm_set1_epi8('*')));
+	special = _mm_or_si128(special, _mm_cmpeq_epi8(chunk, _mm_set1_epi8('.')));
+	special = _mm_or_si128(special, _mm_cmpeq_epi8(chunk, _mm_set1_epi8('/')));
+	special = _mm_or_si128(special, _mm_cmpeq_epi8(chunk, _mm_set1_epi8(':')));
+	special = _mm_or_si128(special, _mm_cmpeq_epi8(chunk, _mm_set1_epi8('<')));
+	special = _mm_or_si128(special, _mm_cmpeq_epi8(chunk, _mm_set1_epi8('>')));
+	special = _mm_or_si128(special, _mm_cmpeq_epi8(chunk, _mm_set1_epi8('?')));
+	special = _mm_or_si128(special, _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\\')));
+	special = _mm_or_si128(special, _mm_cmpeq_epi8(chunk, _mm_set1_epi8('|')));
+
+	return (_mm_movemask_epi8(special) == 0);
+#else /* CACHEKEY_HAS_NEON */
+	const uint8x16_t chunk = vld1q_u8(reinterpret_cast<const uint8_t*>(p));
+
+	// Control characters (0x00-0x1F) and UTF-8 bytes (0x80-0xFF).
+	uint8x16_t special = vcltq_u8(chunk, vdupq_n_u8(0x20));
+	special = vorrq_u8(special, vcgeq_u8(chunk, vdupq_n_u8(0x80)));
+
+	// Characters with class != 1 in valid_ascii_tbl.
+	special = vorrq_u8(special, vceqq_u8(chunk, vdupq_n_u8('"')));
+	special = vorrq_u8(special, vceqq_u8(chunk, vdupq_n_u8('*')));
+	special = vorrq_u8(special, vceqq_u8(chunk, vdupq_n_u8('.')));
+	special = vorrq_u8(special, vceqq_u8(chunk, vdupq_n_u8('/')));
+	special = vorrq_u8(special, vceqq_u8(chunk, vdupq_n_u8(':')));
+	special = vorrq_u8(special, vceqq_u8(chunk, vdupq_n_u8('<')));
+	special = vorrq_u8(special, vceqq_u8(chunk, vdupq_n_u8('>')));
+	special = vorrq_u8(special, vceqq_u8(chunk, vdupq_n_u8('?')));
+	special = vorrq_u8(special, vceqq_u8(chunk, vdupq_n_u8('\\')));
+	special = vorrq_u8(special, vceqq_u8(chunk, vdupq_n_u8('|')));
+
+	return (vmaxvq_u8(special) == 0);
+#endif
+}
+#endif /* CACHEKEY_HAS_SSE2 || CACHEKEY_HAS_NEON */
+
 /**
  * Filter invalid characters from a cache key.
  * This updates the cache key in place.
@@ -81,7 +154,26 @@ int filterCacheKey(char *pCacheKey)
 		return -EINVAL;
 	}
 
+#if defined(CACHEKEY_HAS_SSE2) || defined(CACHEKEY_HAS_NEON)
+	// NOTE: Replacements never change the length,
+	// so pEnd stays valid throughout.
+	const char *const pEnd = pCacheKey + strlen(pCacheKey);
+#endif
+
 	for (char *p = pCacheKey; *p != '\0'; p++) {
+#if defined(CACHEKEY_HAS_SSE2) || defined(CACHEKEY_HAS_NEON)
+		// Fast path: Skip over chunks of plain valid characters.
+		// Most cache keys are mostly plain ASCII, with only a few
+		// slashes and one dot for the file extension.
+		while (p + 16 <= pEnd && isPlainChunk(p)) {
+			p += 16;
+			foundSlash = false;
+		}
+		if (*p == '\0') {
+			break;
+		}
+#endif /* CACHEKEY_HAS_SSE2 || CACHEKEY_HAS_NEON */
+
 		// See valid_ascii_table for a description of valid characters.
 		const uint8_t chr = (uint8_t)*p;
 		if (chr & 0x80) {
@@ -305,6 +397,82 @@ int filterCacheKey(wchar_t *pCacheKey)
 }
 #endif /* RP_WIS16 */
 
+namespace {
+
+/**
+ * Memoization table for getCacheFilename().
+ *
+ * Filtering a cache key and building the full path is deterministic
+ * per process, so hot keys (e.g. boxart re-requested for each view)
+ * resolve with one hash probe instead of rebuilding the string.
+ *
+ * The table is cleared when it gets full; proper LRU bookkeeping
+ * isn't worth it at this size.
+ */
+class CacheFilenameMemo
+{
+	public:
+		CacheFilenameMemo() = default;
+
+	private:
+		RP_DISABLE_COPY(CacheFilenameMemo)
+
+	private:
+		// Entry: filtered cache key plus the resolved filename in
+		// the user's cache directory. An empty filtered key marks
+		// an invalid cache key.
+		struct Entry {
+			string filteredCacheKey;
+			string cacheFilename_user;
+		};
+
+		static constexpr size_t CAPACITY = 64;
+
+		std::mutex m_mutex;
+		std::unordered_map<string, Entry> m_map;
+
+	public:
+		/**
+		 * Look up a cache key.
+		 * @param cache_key		[in] Cache key.
+		 * @param pFilteredCacheKey	[out] Filtered cache key; empty if the key is invalid.
+		 * @param pCacheFilename_user	[out] Filename in the user's cache directory.
+		 * @return True if the key was memoized; false otherwise.
+		 */
+		bool lookup(const char *cache_key, string *pFilteredCacheKey, string *pCacheFilename_user)
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			auto iter = m_map.find(cache_key);
+			if (iter == m_map.end()) {
+				return false;
+			}
+
+			*pFilteredCacheKey = iter->second.filteredCacheKey;
+			*pCacheFilename_user = iter->second.cacheFilename_user;
+			return true;
+		}
+
+		/**
+		 * Memoize a cache key resolution.
+		 * @param cache_key		[in] Cache key.
+		 * @param filteredCacheKey	[in] Filtered cache key; empty if the key is invalid.
+		 * @param cacheFilename_user	[in] Filename in the user's cache directory.
+		 */
+		void store(const char *cache_key, const string &filteredCacheKey, const string &cacheFilename_user)
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (m_map.size() >= CAPACITY) {
+				m_map.clear();
+			}
+			m_map.emplace(cache_key, Entry{filteredCacheKey, cacheFilename_user});
+		}
+};
+
+// Process-wide memoization table.
+CacheFilenameMemo g_cacheFilenameMemo;
+
+}
+
 /**
  * Combine a cache key with the cache directory to get a cache filename.
  * @param cacheKey Cache key. (Must be UTF-8, NULL-terminated.) (Will be filtered using filterCacheKey().)
@@ -319,29 +487,41 @@ string getCacheFilename(const char *pCacheKey)
 		return {};
 	}
 
-	// Filter the cache key.
-	string filteredCacheKey = pCacheKey;
-	int ret = filterCacheKey(filteredCacheKey);
-	if (ret != 0) {
-		// Invalid cache key.
-		return {};
-	}
-
-	// Cache filename in the user's directory.
+	// Filtered cache key and cache filename in the user's directory.
+	string filteredCacheKey;
 	string cacheFilename_user;
 
-	// Make sure the cache directory is initialized.
-	// NOTE: May be empty if the cache directory isn't
-	// accessible, e.g. when running under bubblewrap.
-	const string &cache_dir = getCacheDirectory();
-	if (!cache_dir.empty()) {
-		// Get the cache filename.
-		// This is the cache directory plus the cache key.
-		cacheFilename_user = cache_dir;
-		if (cacheFilename_user.at(cacheFilename_user.size()-1) != DIR_SEP_CHR) {
-			cacheFilename_user += DIR_SEP_CHR;
+	// Check the memoization table first.
+	if (!g_cacheFilenameMemo.lookup(pCacheKey, &filteredCacheKey, &cacheFilename_user)) {
+		// Filter the cache key.
+		filteredCacheKey = pCacheKey;
+		int ret = filterCacheKey(filteredCacheKey);
+		if (ret != 0) {
+			// Invalid cache key.
+			// Memoized as an empty filtered cache key.
+			filteredCacheKey.clear();
+		} else {
+			// Make sure the cache directory is initialized.
+			// NOTE: May be empty if the cache directory isn't
+			// accessible, e.g. when running under bubblewrap.
+			const string &cache_dir = getCacheDirectory();
+			if (!cache_dir.empty()) {
+				// Get the cache filename.
+				// This is the cache directory plus the cache key.
+				cacheFilename_user = cache_dir;
+				if (cacheFilename_user.at(cacheFilename_user.size()-1) != DIR_SEP_CHR) {
+					cacheFilename_user += DIR_SEP_CHR;
+				}
+				cacheFilename_user += filteredCacheKey;
+			}
 		}
-		cacheFilename_user += filteredCacheKey;
+
+		g_cacheFilenameMemo.store(pCacheKey, filteredCacheKey, cacheFilename_user);
+	}
+
+	if (filteredCacheKey.empty()) {
+		// Invalid cache key.
+		return {};
 	}
 
 #ifdef DIR_INSTALL_CACHE
@@ -349,6 +529,8 @@ string getCacheFilename(const char *pCacheKey)
 	// but is not in the user's cache directory, use the system-wide
 	// version. This is useful in cases where the thumbnailer cannot
 	// download files, e.g. bubblewrap.
+	// NOTE: The access() checks are repeated on memoized hits,
+	// since the cache contents can change at any time.
 	string cacheFilename_sys = DIR_INSTALL_CACHE;
 	if (cacheFilename_sys.at(cacheFilename_sys.size()-1) != DIR_SEP_CHR) {
 		cacheFilename_sys += DIR_SEP_CHR;
@@ -431,6 +613,40 @@ wstring getCacheFilename(const wchar_t *pCacheKey)
 }
 #endif /* _WIN32 */
 
+/**
+ * Get a cache key for a content-keyed thumbnail.
+ *
+ * This is a second-level thumbnail cache keyed by content identity
+ * (RomData::contentId()) instead of source filename, so multiple
+ * dumps of the same title in different formats (e.g. ISO, WBFS,
+ * GCZ, and RVZ of one disc) share a single generated thumbnail.
+ * Thumbnailers should check this cache first and link or copy the
+ * existing image instead of regenerating it.
+ *
+ * @param contentId Content ID. (Must be UTF-8, NULL-terminated.)
+ * @param size Thumbnail size, in pixels.
+ * @return Cache key, or empty string on error.
+ */
+string getContentIdCacheKey(const char *contentId, int size)
+{
+	assert(contentId != nullptr);
+	assert(size > 0);
+	if (!contentId || contentId[0] == '\0' || size <= 0) {
+		// Invalid content ID and/or size.
+		return {};
+	}
+
+	string cacheKey;
+	cacheKey.reserve(8 + strlen(contentId) + 16);
+	cacheKey = "thumbs/";
+	cacheKey += contentId;
+
+	char buf[16];
+	snprintf(buf, sizeof(buf), "-%d.png", size);
+	cacheKey += buf;
+	return cacheKey;
+}
+
 /**
  * urlencode a URL component.
  * This only encodes essential characters, e.g. ' ' and '%'.
@@ -112,6 +112,42 @@ static inline std::wstring getCacheFilename(const std::wstring &cacheKey)
 }
 #endif /* _WIN32 */
 
+/**
+ * Get a cache key for a content-keyed thumbnail.
+ *
+ * This is a second-level thumbnail cache keyed by content identity
+ * (RomData::contentId()) instead of source filename, so multiple
+ * dumps of the same title in different formats (e.g. ISO, WBFS,
+ * GCZ, and RVZ of one disc) share a single generated thumbnail.
+ * Thumbnailers should check this cache first and link or copy the
+ * existing image instead of regenerating it.
+ *
+ * @param contentId Content ID. (Must be UTF-8, NULL-terminated.)
+ * @param size Thumbnail size, in pixels.
+ * @return Cache key, or empty string on error.
+ */
+RP_LIBROMDATA_PUBLIC
+std::string getContentIdCacheKey(const char *contentId, int size);
+
+/**
+ * Get a cache key for a content-keyed thumbnail.
+ *
+ * This is a second-level thumbnail cache keyed by content identity
+ * (RomData::contentId()) instead of source filename, so multiple
+ * dumps of the same title in different formats (e.g. ISO, WBFS,
+ * GCZ, and RVZ of one disc) share a single generated thumbnail.
+ * Thumbnailers should check this cache first and link or copy the
+ * existing image instead of regenerating it.
+ *
+ * @param contentId Content ID. (Must be UTF-8.)
+ * @param size Thumbnail size, in pixels.
+ * @return Cache key, or empty string on error.
+ */
+static inline std::string getContentIdCacheKey(const std::string &contentId, int size)
+{
+	return getContentIdCacheKey(contentId.c_str(), size);
+}
+
 /**
  * urlencode a URL component.
  * This only encodes essential characters, e.g. ' ' and '%'.
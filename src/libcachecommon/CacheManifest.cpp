@@ -0,0 +1,421 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libcachecommon)                   *
+ * CacheManifest.cpp: Cache directory manifest.                            *
+ *                                                                         *
+ * Copyright (c) 2016-2023 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "CacheManifest.hpp"
+#include "CacheDir.hpp"
+
+#include "common.h"	// for RP_DISABLE_COPY()
+
+// C includes (C++ namespace)
+#include <cassert>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+// C++ STL classes
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+using std::string;
+
+#ifdef _WIN32
+#  define DIR_SEP_CHR '\\'
+#else /* !_WIN32 */
+#  define DIR_SEP_CHR '/'
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif /* _WIN32 */
+
+namespace LibCacheCommon {
+
+namespace {
+
+/** On-disk manifest format **/
+// The manifest is native-endian, since it's a per-machine cache.
+// It consists of a header followed by fixed-size records; updates
+// are appended, and later records for a key override earlier ones.
+
+#define MANIFEST_MAGIC "RPCM"
+static constexpr uint32_t MANIFEST_VERSION = 1;
+
+// Record flags
+static constexpr uint32_t MANIFEST_F_DELETED = (1U << 0);
+
+struct ManifestHeader {
+	char magic[4];		// "RPCM"
+	uint32_t version;	// MANIFEST_VERSION
+};
+ASSERT_STRUCT(ManifestHeader, 8);
+
+struct ManifestRecord {
+	uint64_t keyHash;	// 64-bit FNV-1a hash of the cache key
+	int64_t size;		// File size
+	int64_t mtime;		// File mtime
+	uint32_t flags;		// MANIFEST_F_* flags
+	uint32_t reserved;	// Reserved; set to 0
+};
+ASSERT_STRUCT(ManifestRecord, 32);
+
+/**
+ * Hash a cache key. (64-bit FNV-1a)
+ * @param pCacheKey Cache key. (Must be UTF-8, NULL-terminated.)
+ * @return Hash.
+ */
+static inline uint64_t hashCacheKey(const char *pCacheKey)
+{
+	uint64_t hash = 0xCBF29CE484222325ULL;
+	for (; *pCacheKey != '\0'; pCacheKey++) {
+		hash ^= static_cast<uint8_t>(*pCacheKey);
+		hash *= 0x00000100000001B3ULL;
+	}
+	return hash;
+}
+
+/**
+ * In-memory view of the cache manifest.
+ *
+ * The manifest file is loaded once per process (mmap()'d on POSIX)
+ * and flattened into a hash table; updates append a record to the
+ * file and patch the table. If the file has accumulated many stale
+ * records, it's compacted at load time.
+ */
+class CacheManifest
+{
+	public:
+		CacheManifest() = default;
+
+	private:
+		RP_DISABLE_COPY(CacheManifest)
+
+	private:
+		struct Entry {
+			int64_t size;
+			int64_t mtime;
+		};
+
+		// Compact the manifest at load time if it has this many
+		// records and most of them are stale.
+		static constexpr size_t COMPACT_THRESHOLD = 1024;
+
+		std::mutex m_mutex;
+		std::unordered_map<uint64_t, Entry> m_map;
+		string m_filename;	// Empty if the cache directory is unavailable.
+		bool m_loaded = false;
+
+	private:
+		/**
+		 * Flatten loaded manifest records into the hash table.
+		 * @param pRecords	[in] Records.
+		 * @param count		[in] Record count.
+		 */
+		void flattenRecords(const ManifestRecord *pRecords, size_t count)
+		{
+			for (size_t i = 0; i < count; i++) {
+				const ManifestRecord &rec = pRecords[i];
+				if (rec.flags & MANIFEST_F_DELETED) {
+					m_map.erase(rec.keyHash);
+				} else {
+					m_map[rec.keyHash] = Entry{rec.size, rec.mtime};
+				}
+			}
+		}
+
+		/**
+		 * Append a record to the manifest file.
+		 * The header is written first if the file is new.
+		 * @param rec	[in] Record.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int appendRecord(const ManifestRecord &rec)
+		{
+			FILE *const f = fopen(m_filename.c_str(), "ab");
+			if (!f) {
+				return (errno != 0) ? -errno : -EIO;
+			}
+
+			int ret = 0;
+			fseek(f, 0, SEEK_END);
+			if (ftell(f) == 0) {
+				// New file. Write the header first.
+				ManifestHeader hdr;
+				memcpy(hdr.magic, MANIFEST_MAGIC, sizeof(hdr.magic));
+				hdr.version = MANIFEST_VERSION;
+				if (fwrite(&hdr, sizeof(hdr), 1, f) != 1) {
+					ret = -EIO;
+				}
+			}
+			if (ret == 0 && fwrite(&rec, sizeof(rec), 1, f) != 1) {
+				ret = -EIO;
+			}
+			fclose(f);
+			return ret;
+		}
+
+		/**
+		 * Rewrite the manifest file with one record per live key.
+		 */
+		void compact(void)
+		{
+			const string tmp_filename = m_filename + ".tmp";
+			FILE *const f = fopen(tmp_filename.c_str(), "wb");
+			if (!f) {
+				// Can't compact. The manifest still works; it's just big.
+				return;
+			}
+
+			ManifestHeader hdr;
+			memcpy(hdr.magic, MANIFEST_MAGIC, sizeof(hdr.magic));
+			hdr.version = MANIFEST_VERSION;
+			bool ok = (fwrite(&hdr, sizeof(hdr), 1, f) == 1);
+			for (auto iter = m_map.cbegin(); ok && iter != m_map.cend(); ++iter) {
+				const ManifestRecord rec = {iter->first,
+					iter->second.size, iter->second.mtime, 0, 0};
+				ok = (fwrite(&rec, sizeof(rec), 1, f) == 1);
+			}
+			fclose(f);
+
+			if (!ok) {
+				remove(tmp_filename.c_str());
+				return;
+			}
+#ifdef _WIN32
+			// rename() doesn't replace existing files on Windows.
+			remove(m_filename.c_str());
+#endif /* _WIN32 */
+			rename(tmp_filename.c_str(), m_filename.c_str());
+		}
+
+		/**
+		 * Load the manifest file. (Called once, under lock.)
+		 */
+		void load(void)
+		{
+			m_loaded = true;
+
+			const string &cache_dir = getCacheDirectory();
+			if (cache_dir.empty()) {
+				// No cache directory. Manifest is unavailable.
+				return;
+			}
+			m_filename = cache_dir;
+			if (m_filename.at(m_filename.size()-1) != DIR_SEP_CHR) {
+				m_filename += DIR_SEP_CHR;
+			}
+			m_filename += "cache.manifest";
+
+			size_t nRecords = 0;
+#ifdef _WIN32
+			// Read the manifest using stdio.
+			FILE *const f = fopen(m_filename.c_str(), "rb");
+			if (!f) {
+				// No manifest yet.
+				return;
+			}
+
+			ManifestHeader hdr;
+			if (fread(&hdr, sizeof(hdr), 1, f) != 1 ||
+			    memcmp(hdr.magic, MANIFEST_MAGIC, sizeof(hdr.magic)) != 0 ||
+			    hdr.version != MANIFEST_VERSION)
+			{
+				// Invalid manifest. Delete it; it will be rebuilt.
+				fclose(f);
+				remove(m_filename.c_str());
+				return;
+			}
+
+			std::vector<ManifestRecord> records;
+			ManifestRecord rec;
+			while (fread(&rec, sizeof(rec), 1, f) == 1) {
+				records.push_back(rec);
+			}
+			fclose(f);
+
+			nRecords = records.size();
+			flattenRecords(records.data(), nRecords);
+#else /* !_WIN32 */
+			// mmap() the manifest.
+			const int fd = open(m_filename.c_str(), O_RDONLY | O_CLOEXEC);
+			if (fd < 0) {
+				// No manifest yet.
+				return;
+			}
+
+			struct stat sb;
+			if (fstat(fd, &sb) != 0 ||
+			    static_cast<size_t>(sb.st_size) < sizeof(ManifestHeader))
+			{
+				close(fd);
+				return;
+			}
+
+			void *const map = mmap(nullptr, sb.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+			close(fd);
+			if (map == MAP_FAILED) {
+				return;
+			}
+
+			const ManifestHeader *const pHdr =
+				static_cast<const ManifestHeader*>(map);
+			if (memcmp(pHdr->magic, MANIFEST_MAGIC, sizeof(pHdr->magic)) != 0 ||
+			    pHdr->version != MANIFEST_VERSION)
+			{
+				// Invalid manifest. Delete it; it will be rebuilt.
+				munmap(map, sb.st_size);
+				remove(m_filename.c_str());
+				return;
+			}
+
+			// NOTE: A truncated trailing record is ignored.
+			nRecords = (sb.st_size - sizeof(ManifestHeader)) / sizeof(ManifestRecord);
+			flattenRecords(reinterpret_cast<const ManifestRecord*>(pHdr + 1), nRecords);
+
+			// The hash table has everything; the mapping isn't needed anymore.
+			munmap(map, sb.st_size);
+#endif /* _WIN32 */
+
+			// Compact the file if most of its records are stale.
+			if (nRecords >= COMPACT_THRESHOLD && nRecords > (m_map.size() * 4)) {
+				compact();
+			}
+		}
+
+		/**
+		 * Make sure the manifest is loaded. (Must be called under lock.)
+		 * @return True if the manifest is available; false otherwise.
+		 */
+		inline bool ensureLoaded(void)
+		{
+			if (!m_loaded) {
+				load();
+			}
+			return !m_filename.empty();
+		}
+
+	public:
+		/**
+		 * Look up a cache key.
+		 * @param pCacheKey	[in] Cache key.
+		 * @param pSize		[out] File size.
+		 * @param pMtime	[out] File mtime.
+		 * @return 0 on success; -ENOENT if not in the manifest.
+		 */
+		int lookup(const char *pCacheKey, int64_t *pSize, time_t *pMtime)
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (!ensureLoaded()) {
+				return -ENOENT;
+			}
+
+			auto iter = m_map.find(hashCacheKey(pCacheKey));
+			if (iter == m_map.end()) {
+				return -ENOENT;
+			}
+
+			*pSize = iter->second.size;
+			*pMtime = static_cast<time_t>(iter->second.mtime);
+			return 0;
+		}
+
+		/**
+		 * Update a cache key.
+		 * @param pCacheKey	[in] Cache key.
+		 * @param size		[in] File size.
+		 * @param mtime		[in] File mtime.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int update(const char *pCacheKey, int64_t size, time_t mtime)
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (!ensureLoaded()) {
+				return -ENOENT;
+			}
+
+			const uint64_t keyHash = hashCacheKey(pCacheKey);
+			auto iter = m_map.find(keyHash);
+			if (iter != m_map.end() &&
+			    iter->second.size == size &&
+			    iter->second.mtime == static_cast<int64_t>(mtime))
+			{
+				// Nothing changed. Don't grow the file.
+				return 0;
+			}
+
+			m_map[keyHash] = Entry{size, static_cast<int64_t>(mtime)};
+			const ManifestRecord rec = {keyHash, size,
+				static_cast<int64_t>(mtime), 0, 0};
+			return appendRecord(rec);
+		}
+
+		/**
+		 * Remove a cache key.
+		 * @param pCacheKey	[in] Cache key.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int remove_key(const char *pCacheKey)
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (!ensureLoaded()) {
+				return -ENOENT;
+			}
+
+			const uint64_t keyHash = hashCacheKey(pCacheKey);
+			if (m_map.erase(keyHash) == 0) {
+				// Key wasn't in the manifest.
+				return 0;
+			}
+
+			const ManifestRecord rec = {keyHash, 0, 0, MANIFEST_F_DELETED, 0};
+			return appendRecord(rec);
+		}
+};
+
+// Process-wide manifest.
+CacheManifest g_cacheManifest;
+
+}
+
+/** Public functions **/
+// (See CacheManifest.hpp for documentation.)
+
+int manifestLookup(const char *pCacheKey, int64_t *pSize, time_t *pMtime)
+{
+	assert(pCacheKey != nullptr);
+	assert(pCacheKey[0] != '\0');
+	if (!pCacheKey || pCacheKey[0] == '\0') {
+		return -EINVAL;
+	}
+
+	return g_cacheManifest.lookup(pCacheKey, pSize, pMtime);
+}
+
+int manifestUpdate(const char *pCacheKey, int64_t size, time_t mtime)
+{
+	assert(pCacheKey != nullptr);
+	assert(pCacheKey[0] != '\0');
+	if (!pCacheKey || pCacheKey[0] == '\0') {
+		return -EINVAL;
+	}
+
+	return g_cacheManifest.update(pCacheKey, size, mtime);
+}
+
+int manifestRemove(const char *pCacheKey)
+{
+	assert(pCacheKey != nullptr);
+	assert(pCacheKey[0] != '\0');
+	if (!pCacheKey || pCacheKey[0] == '\0') {
+		return -EINVAL;
+	}
+
+	return g_cacheManifest.remove_key(pCacheKey);
+}
+
+} //namespace LibCacheCommon
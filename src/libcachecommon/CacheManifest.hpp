@@ -0,0 +1,61 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libcachecommon)                   *
+ * CacheManifest.hpp: Cache directory manifest.                            *
+ *                                                                         *
+ * Copyright (c) 2016-2023 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#pragma once
+
+#include "dll-macros.h"	// for RP_LIBROMDATA_PUBLIC
+
+// C includes (C++ namespace)
+#include <ctime>
+#include <stdint.h>
+
+namespace LibCacheCommon {
+
+/**
+ * Look up a cache key in the cache manifest.
+ *
+ * The manifest is an append-only binary file in the cache directory
+ * that records the size and mtime of cached files, so existence
+ * checks are in-memory lookups instead of per-key stat() calls.
+ * This matters on network home directories, where a large cache
+ * makes every miss cost a round trip.
+ *
+ * NOTE: The manifest is advisory. If cache files are deleted without
+ * deleting the manifest, entries are stale until the next update for
+ * that key. Deleting the cache directory also deletes the manifest.
+ *
+ * @param pCacheKey	[in] Cache key. (Must be UTF-8, NULL-terminated.)
+ * @param pSize		[out] File size.
+ * @param pMtime	[out] File mtime.
+ * @return 0 on success; -ENOENT if the key is not in the manifest.
+ */
+RP_LIBROMDATA_PUBLIC
+int manifestLookup(const char *pCacheKey, int64_t *pSize, time_t *pMtime);
+
+/**
+ * Update a cache key in the cache manifest.
+ * A record is appended to the manifest file and the in-memory
+ * table is updated.
+ * @param pCacheKey	[in] Cache key. (Must be UTF-8, NULL-terminated.)
+ * @param size		[in] File size.
+ * @param mtime		[in] File mtime.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+RP_LIBROMDATA_PUBLIC
+int manifestUpdate(const char *pCacheKey, int64_t size, time_t mtime);
+
+/**
+ * Remove a cache key from the cache manifest.
+ * Call this after deleting the corresponding cache file.
+ * @param pCacheKey	[in] Cache key. (Must be UTF-8, NULL-terminated.)
+ * @return 0 on success; negative POSIX error code on error.
+ */
+RP_LIBROMDATA_PUBLIC
+int manifestRemove(const char *pCacheKey);
+
+} //namespace LibCacheCommon
@@ -21,9 +21,15 @@
 #  include <stdlib.h>	// _countof() on 32-bit MinGW-w64
 #endif
 
+// C includes
+#include <locale.h>	// LC_MESSAGES for dpgettext_expr()
+#include <stdint.h>
+#include <string.h>	// memset()
+
 // Initialized?
 #include "stdboolx.h"
-#include "librpthreads/pthread_once.h"
+#include "librpthreads/Atomics.h"
+#include "librpthreads/rp_once.h"
 static bool i18n_is_init = false;
 
 #ifdef _WIN32
@@ -55,7 +61,7 @@ static bool i18n_is_init = false;
  * Initialize the internationalization subsystem.
  * (Windows version)
  *
- * Called by pthread_once().
+ * Called by rp_once().
  */
 static void rp_i18n_init_int(void)
 {
@@ -136,7 +142,7 @@ static void rp_i18n_init_int(void)
  * Initialize the internationalization subsystem.
  * (Unix/Linux version)
  *
- * Called by pthread_once().
+ * Called by rp_once().
  */
 static void rp_i18n_init_int(void)
 {
@@ -154,9 +160,142 @@ static void rp_i18n_init_int(void)
  */
 int rp_i18n_init(void)
 {
-	static pthread_once_t i18n_once_control = PTHREAD_ONCE_INIT;
-	pthread_once(&i18n_once_control, rp_i18n_init_int);
+	static rp_once_t i18n_once_control = RP_ONCE_INIT;
+	rp_once(&i18n_once_control, rp_i18n_init_int);
 	return (i18n_is_init ? 0 : -1);
 }
 
+/** Memoized translation lookups **/
+
+// gettext does a hash+strcmp per call, and pgettext_expr() also has
+// to glue the context and msgid together in a temporary buffer.
+// Since the msgid/msgctxt arguments are almost always string literals,
+// lookups can be memoized by pointer identity: the same call site
+// always passes the same pointers. Unmerged duplicate literals merely
+// result in an extra cache entry, not an incorrect translation.
+//
+// The cache is thread-local, so no locking is needed. Translated
+// string pointers are stable for the lifetime of the loaded catalog,
+// but not across a runtime locale change: callers that change
+// LC_MESSAGES must call rp_i18n_invalidate_cache() afterwards, which
+// bumps a process-wide generation counter. Each thread's table is
+// flushed lazily on its next lookup when the generation has moved.
+
+// Thread-local storage qualifier
+#ifdef _MSC_VER
+#  define I18N_TLS __declspec(thread)
+#else
+#  define I18N_TLS __thread
+#endif
+
+#define I18N_CACHE_SIZE 256U	/* must be a power of two */
+#define I18N_CACHE_PROBES 8U
+
+typedef struct _i18n_cache_entry_t {
+	const char *msgctxt;	// may be NULL
+	const char *msgid;	// NULL if the entry is empty
+	const char *msgstr;
+} i18n_cache_entry_t;
+
+static I18N_TLS i18n_cache_entry_t i18n_cache[I18N_CACHE_SIZE];
+
+// Cache generation. (see rp_i18n_invalidate_cache())
+static volatile int i18n_cache_gen = 0;
+static I18N_TLS int i18n_cache_local_gen = 0;
+
+/**
+ * Invalidate the memoized translation caches.
+ *
+ * Must be called after changing the process locale (LC_MESSAGES)
+ * at runtime; otherwise, memoized lookups keep returning msgstr
+ * pointers from the previously-loaded catalog.
+ */
+void rp_i18n_invalidate_cache(void)
+{
+	ATOMIC_INC_FETCH(&i18n_cache_gen);
+}
+
+/**
+ * Full (uncached) translation lookup. Called on cache misses.
+ *
+ * Ensures the text domain is bound before the first lookup.
+ * If binding failed, e.g. because the locale directory is missing,
+ * gettext is skipped entirely: looking up an unbound domain would
+ * otherwise probe the default locale directories on every miss,
+ * which is slow on networked filesystems.
+ *
+ * @param msgctxt Message context (may be NULL)
+ * @param msgid Message ID
+ * @return Translated string, or msgid if no translation was found.
+ */
+static const char *i18n_lookup(const char *msgctxt, const char *msgid)
+{
+	if (rp_i18n_init() != 0) {
+		// i18n subsystem failed to initialize.
+		return msgid;
+	}
+
+	return (msgctxt)
+		? dpgettext_expr(RP_I18N_DOMAIN, msgctxt, msgid)
+		: dgettext(RP_I18N_DOMAIN, msgid);
+}
+
+/**
+ * Memoized dpgettext() lookup, using the default text domain.
+ * @param msgctxt Message context (may be NULL; must be a stable pointer)
+ * @param msgid Message ID (must be a stable pointer, e.g. a string literal)
+ * @return Translated string, or msgid if no translation was found.
+ */
+const char *rp_dpgettext_cached(const char *msgctxt, const char *msgid)
+{
+	// Flush this thread's table if the locale has changed.
+	// (see rp_i18n_invalidate_cache())
+	const int gen = i18n_cache_gen;
+	if (gen != i18n_cache_local_gen) {
+		memset(i18n_cache, 0, sizeof(i18n_cache));
+		i18n_cache_local_gen = gen;
+	}
+
+	// Mix the two pointers into a table index.
+	// (Fibonacci hashing; low pointer bits are mostly zero.)
+	uintptr_t h = ((uintptr_t)msgid >> 4) ^ ((uintptr_t)msgctxt >> 2);
+	h *= (uintptr_t)2654435761U;
+	const unsigned int slot = (unsigned int)(h >> 8) & (I18N_CACHE_SIZE - 1U);
+
+	unsigned int i;
+	for (i = 0; i < I18N_CACHE_PROBES; i++) {
+		i18n_cache_entry_t *const entry =
+			&i18n_cache[(slot + i) & (I18N_CACHE_SIZE - 1U)];
+		if (entry->msgid == msgid && entry->msgctxt == msgctxt) {
+			// Cache hit.
+			return entry->msgstr;
+		}
+		if (!entry->msgid) {
+			// Empty slot. Do the full lookup and cache it.
+			entry->msgctxt = msgctxt;
+			entry->msgid = msgid;
+			entry->msgstr = i18n_lookup(msgctxt, msgid);
+			return entry->msgstr;
+		}
+	}
+
+	// All probed slots are taken by other strings.
+	// Evict the first probed slot.
+	i18n_cache_entry_t *const entry = &i18n_cache[slot];
+	entry->msgctxt = msgctxt;
+	entry->msgid = msgid;
+	entry->msgstr = i18n_lookup(msgctxt, msgid);
+	return entry->msgstr;
+}
+
+/**
+ * Memoized dgettext() lookup, using the default text domain.
+ * @param msgid Message ID (must be a stable pointer, e.g. a string literal)
+ * @return Translated string, or msgid if no translation was found.
+ */
+const char *rp_dgettext_cached(const char *msgid)
+{
+	return rp_dpgettext_cached(NULL, msgid);
+}
+
 #endif /* ENABLE_NLS */
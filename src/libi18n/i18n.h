@@ -25,10 +25,19 @@
  */
 #ifdef HAVE_GETTEXT
 #  include "gettext.h"
-#  define _(msgid)				dgettext(RP_I18N_DOMAIN, msgid)
-#  define C_(msgctxt, msgid)			dpgettext(RP_I18N_DOMAIN, msgctxt, msgid)
+// NOTE: _() and C_() use memoized lookups. (see rp_dpgettext_cached())
+// The msgid/msgctxt arguments must be stable pointers, i.e. string
+// literals or other static storage. The plural forms N_() and NC_()
+// depend on `n`, so they use gettext directly.
+#  define _(msgid)				rp_dgettext_cached(msgid)
+#  define C_(msgctxt, msgid)			rp_dpgettext_cached(msgctxt, msgid)
 #  define N_(msgid1, msgid2, n)			dngettext(RP_I18N_DOMAIN, msgid1, msgid2, n)
 #  define NC_(msgctxt, msgid1, msgid2, n)	dnpgettext(RP_I18N_DOMAIN, msgctxt, msgid1, msgid2, n)
+// Memoized runtime-context lookup. (replaces gnulib's pgettext_expr(),
+// which glues the context and msgid together in a temporary buffer on
+// every call)
+#  undef pgettext_expr
+#  define pgettext_expr(msgctxt, msgid)		rp_dpgettext_cached(msgctxt, msgid)
 #else
 #  define _(msgid)				(msgid)
 #  define C_(msgctxt, msgid)			(msgid)
@@ -56,15 +65,44 @@ extern "C" {
 RP_LIBROMDATA_PUBLIC
 int rp_i18n_init(void);
 
+/**
+ * Memoized dgettext() lookup, using the default text domain.
+ * @param msgid Message ID (must be a stable pointer, e.g. a string literal)
+ * @return Translated string, or msgid if no translation was found.
+ */
+RP_LIBROMDATA_PUBLIC
+const char *rp_dgettext_cached(const char *msgid);
+
+/**
+ * Memoized dpgettext() lookup, using the default text domain.
+ * @param msgctxt Message context (may be NULL; must be a stable pointer)
+ * @param msgid Message ID (must be a stable pointer, e.g. a string literal)
+ * @return Translated string, or msgid if no translation was found.
+ */
+RP_LIBROMDATA_PUBLIC
+const char *rp_dpgettext_cached(const char *msgctxt, const char *msgid);
+
+/**
+ * Invalidate the memoized translation caches.
+ *
+ * Must be called after changing the process locale (LC_MESSAGES)
+ * at runtime; otherwise, memoized lookups keep returning msgstr
+ * pointers from the previously-loaded catalog.
+ */
+RP_LIBROMDATA_PUBLIC
+void rp_i18n_invalidate_cache(void);
+
 #ifdef __cplusplus
 }
 #endif
 
 #else
 /**
- * Dummy macro for rp_i18n_init() that does nothing.
+ * Dummy macros for rp_i18n_init() and rp_i18n_invalidate_cache()
+ * that do nothing.
  */
 #define rp_i18n_init() do { } while (0)
+#define rp_i18n_invalidate_cache() do { } while (0)
 #endif /* HAVE_GETTEXT */
 
 // Positional printf().
@@ -617,7 +617,7 @@ int SAP::loadFieldData(void)
 		d->fields.addField_string(type_title, s_tag_type);
 	} else {
 		d->fields.addField_string(type_title,
-			rp_sprintf("0x%02X", static_cast<unsigned int>(tags.type)),
+			fmt_hex_0x<2>(static_cast<unsigned int>(tags.type)),
 			RomFields::STRF_MONOSPACE);
 	}
 
@@ -680,7 +680,7 @@ int SAP::loadFieldData(void)
 			const uint32_t min = (duration / 1000) / 60;
 			const uint32_t sec = (duration / 1000) % 60;
 			const uint32_t ms =  (duration % 1000);
-			data_row.emplace_back(rp_sprintf("%u", song_num));
+			data_row.emplace_back(fmt_dec(song_num));
 			data_row.emplace_back(rp_sprintf("%u:%02u.%03u", min, sec, ms));
 			data_row.emplace_back(src_iter->second ? s_yes : s_no);
 		}
@@ -104,6 +104,10 @@ public:
 		{
 			return map.find(key);
 		}
+		inline map_t::const_iterator end(void) const
+		{
+			return map.end();
+		}
 		inline map_t::const_iterator cbegin(void) const
 		{
 			return map.cbegin();
@@ -171,11 +175,19 @@ public:
 		}
 	};
 
+	// Parsed ID666 tags.
+	// Cached so loadFieldData() and loadMetaData() don't
+	// re-read and re-convert the tags.
+	spc_tags_t tags;
+	bool tags_parsed;
+
 	/**
 	 * Parse the ID666 tags for the open SPC file.
+	 * The parsed tags are cached; subsequent calls
+	 * return the cached map.
 	 * @return Map containing key/value entries.
 	 */
-	spc_tags_t parseTags(void);
+	const spc_tags_t &parseTags(void);
 
 	/**
 	 * Get the duration from the SPC tags.
@@ -207,6 +219,7 @@ const RomDataInfo SPCPrivate::romDataInfo = {
 
 SPCPrivate::SPCPrivate(const IRpFilePtr &file)
 	: super(file, &romDataInfo)
+	, tags_parsed(false)
 {
 	// Clear the SPC header struct.
 	memset(&spcHeader, 0, sizeof(spcHeader));
@@ -216,9 +229,14 @@ SPCPrivate::SPCPrivate(const IRpFilePtr &file)
  * Parse the tag section.
  * @return Map containing key/value entries.
  */
-SPCPrivate::spc_tags_t SPCPrivate::parseTags(void)
+const SPCPrivate::spc_tags_t &SPCPrivate::parseTags(void)
 {
-	spc_tags_t kv;
+	spc_tags_t &kv = tags;
+	if (tags_parsed) {
+		// Tags have already been parsed.
+		return kv;
+	}
+	tags_parsed = true;
 
 	if (spcHeader.has_id666 != 26) {
 		// No ID666 tags.
@@ -747,7 +765,7 @@ int SPC::loadFieldData(void)
 	}
 
 	// Get the ID666 tags.
-	auto kv = d->parseTags();
+	const auto &kv = d->parseTags();
 	if (kv.empty()) {
 		// No tags.
 		return 0;
@@ -947,7 +965,7 @@ int SPC::loadMetaData(void)
 	}
 
 	// Get the ID666 tags.
-	auto kv = d->parseTags();
+	const auto &kv = d->parseTags();
 	if (kv.empty()) {
 		// No tags.
 		// TODO: Return 0 instead of -ENOENT?
@@ -7,6 +7,7 @@
  ***************************************************************************/
 
 #include "stdafx.h"
+#include "config.librpbase.h"
 #include "GameCube.hpp"
 
 #include "gcn_structs.h"
@@ -653,6 +654,12 @@ const char *GameCubePrivate::wii_getCryptoStatus(const WiiPartition *partition)
  *
  * NOTE: Check isValid() to determine if this is a valid ROM.
  *
+ * NOTE: Construction is header-only: only the disc header and
+ * region code are read here. Wii partition tables and opening.bnr
+ * (banner image and game information) are loaded on demand by
+ * loadFieldData(), loadMetaData(), and loadInternalImage(), so
+ * metadata-only consumers never open the banner partition.
+ *
  * @param file Open disc image.
  */
 GameCube::GameCube(const IRpFilePtr &file)
@@ -770,9 +777,14 @@ GameCube::GameCube(const IRpFilePtr &file)
 	}
 
 	// Save the disc header for later.
-	d->discReader->rewind();
-	if ((d->discType & GameCubePrivate::DISC_FORMAT_MASK) != GameCubePrivate::DISC_FORMAT_PARTITION) {
+	if ((d->discType & GameCubePrivate::DISC_FORMAT_MASK) == GameCubePrivate::DISC_FORMAT_RAW) {
+		// Raw disc image: The disc header is in header[] already.
+		memcpy(&d->discHeader, header, sizeof(d->discHeader));
+		d->hasDiscHeader = true;
+		d->hasRegionCode = true;
+	} else if ((d->discType & GameCubePrivate::DISC_FORMAT_MASK) != GameCubePrivate::DISC_FORMAT_PARTITION) {
 		// Regular disc image.
+		d->discReader->rewind();
 		size = d->discReader->read(&d->discHeader, sizeof(d->discHeader));
 		if (size != sizeof(d->discHeader)) {
 			// Error reading the disc header.
@@ -923,10 +935,17 @@ GameCube::GameCube(const IRpFilePtr &file)
 		case GameCubePrivate::DISC_SYSTEM_GCN:
 		case GameCubePrivate::DISC_SYSTEM_TRIFORCE: {	// TODO?
 			GCN_Boot_Info bootInfo;	// TODO: Save in GameCubePrivate?
-			size = d->discReader->seekAndRead(GCN_Boot_Info_ADDRESS, &bootInfo, sizeof(bootInfo));
-			if (size != sizeof(bootInfo)) {
-				// Cannot read bi2.bin.
-				goto notSupported;
+			if ((d->discType & GameCubePrivate::DISC_FORMAT_MASK) == GameCubePrivate::DISC_FORMAT_RAW) {
+				// Raw disc image: bi2.bin is in header[] already.
+				static_assert(GCN_Boot_Info_ADDRESS + sizeof(bootInfo) <= sizeof(header),
+					"GCN_Boot_Info does not fit in the header buffer.");
+				memcpy(&bootInfo, &header[GCN_Boot_Info_ADDRESS], sizeof(bootInfo));
+			} else {
+				size = d->discReader->seekAndRead(GCN_Boot_Info_ADDRESS, &bootInfo, sizeof(bootInfo));
+				if (size != sizeof(bootInfo)) {
+					// Cannot read bi2.bin.
+					goto notSupported;
+				}
 			}
 
 			d->gcnRegion = be32_to_cpu(bootInfo.region_code);
@@ -1412,9 +1431,7 @@ int GameCube::loadFieldData(void)
 			// TID Lo is usually the same as the game ID,
 			// except for some diagnostics discs.
 			d->fields.addField_string(C_("Nintendo", "Title ID"),
-				rp_sprintf("%08X-%08X",
-					be32_to_cpu(tmdHeader->title_id.hi),
-					be32_to_cpu(tmdHeader->title_id.lo)));
+				fmt_hex<8>(be32_to_cpu(tmdHeader->title_id.hi)) + '-' + fmt_hex<8>(be32_to_cpu(tmdHeader->title_id.lo)));
 
 			// Access rights.
 			vector<string> *const v_access_rights_hdr = new vector<string>();
@@ -1438,9 +1455,7 @@ int GameCube::loadFieldData(void)
 				// Non-standard IOS slot.
 				// Print the full title ID.
 				d->fields.addField_string(ios_version_title,
-					rp_sprintf("%08X-%08X",
-						be32_to_cpu(tmdHeader->sys_version.hi),
-						be32_to_cpu(tmdHeader->sys_version.lo)));
+					fmt_hex<8>(be32_to_cpu(tmdHeader->sys_version.hi)) + '-' + fmt_hex<8>(be32_to_cpu(tmdHeader->sys_version.lo)));
 			}
 		}
 	}
@@ -1690,7 +1705,7 @@ int GameCube::loadFieldData(void)
 					s_ptype = latin1_to_utf8(part_type.chr, sizeof(part_type.chr));
 				} else {
 					// Non-ASCII data. Print the hex values instead.
-					s_ptype = rp_sprintf("%08X", entry.type);
+					s_ptype = fmt_hex<8>(entry.type);
 				}
 			}
 			data_row.emplace_back(std::move(s_ptype));
@@ -1921,6 +1936,62 @@ int GameCube::loadInternalImage(ImageType imageType, rp_image_const_ptr &pImage)
  *                               enum value.
  * @return 0 on success; negative POSIX error code on error.
  */
+/**
+ * Get a content identifier for this ROM image.
+ *
+ * The content ID identifies the *content*, not the file, so two
+ * dumps of the same title in different formats return the same string.
+ *
+ * @return Content ID, or empty string if not available.
+ */
+std::string GameCube::contentId(void) const
+{
+	RP_D(const GameCube);
+	if (d->discType < 0 || !d->hasDiscHeader) {
+		// Unknown disc type, or no disc header.
+		return {};
+	} else if ((d->discType & GameCubePrivate::DISC_FORMAT_MASK) == GameCubePrivate::DISC_FORMAT_TGC) {
+		// TGC game IDs aren't unique.
+		return {};
+	}
+
+	// Game ID.
+	// Replace any non-printable characters with underscores.
+	// (NDDEMO has ID6 "00\0E01".)
+	const GCN_DiscHeader *const discHeader = &d->discHeader;
+	char id6[7];
+	for (unsigned int i = 0; i < 6; i++) {
+		id6[i] = (ISPRINT(discHeader->id6[i]))
+			? discHeader->id6[i]
+			: '_';
+	}
+	id6[6] = 0;
+
+	const char *sysPrefix;
+	switch (d->discType & GameCubePrivate::DISC_SYSTEM_MASK) {
+		case GameCubePrivate::DISC_SYSTEM_GCN:
+			sysPrefix = "gcn";
+			break;
+		case GameCubePrivate::DISC_SYSTEM_TRIFORCE:
+			sysPrefix = "triforce";
+			break;
+		case GameCubePrivate::DISC_SYSTEM_WII:
+			sysPrefix = "wii";
+			break;
+		default:
+			return {};
+	}
+
+	// Disc number and revision disambiguate e.g. multi-disc
+	// games and rereleases, which may have different art.
+	char buf[40];
+	snprintf(buf, sizeof(buf), "%s/%s-disc%u-rev%02u",
+		 sysPrefix, id6,
+		 static_cast<unsigned int>(discHeader->disc_number) + 1,
+		 discHeader->revision);
+	return {buf};
+}
+
 int GameCube::extURLs(ImageType imageType, vector<ExtURL> *pExtURLs, int size) const
 {
 	ASSERT_extURLs(imageType, pExtURLs);
@@ -2130,4 +2201,114 @@ int GameCube::checkViewedAchievements(void) const
 	return ret;
 }
 
+/**
+ * Get the list of operations that can be performed on this ROM.
+ * Internal function; called by RomData::romOps().
+ * @return List of operations.
+ */
+vector<RomData::RomOp> GameCube::romOps_int(void) const
+{
+	RP_D(const GameCube);
+	vector<RomOp> ops;
+
+	if (!d->isValid || ((d->discType & GameCubePrivate::DISC_SYSTEM_MASK) != GameCubePrivate::DISC_SYSTEM_WII)) {
+		// Hash verification uses the Wii partition hash tree.
+		// GameCube discs don't have one.
+		return ops;
+	}
+
+	RomOp op("Verify partition &hashes", RomOp::ROF_ENABLED);
+#ifndef ENABLE_DECRYPTION
+	// Hash verification requires SHA-1 (and AES for encrypted
+	// partitions) from the crypto backend.
+	op.flags &= ~RomOp::ROF_ENABLED;
+#endif /* !ENABLE_DECRYPTION */
+	ops.emplace_back(std::move(op));
+	return ops;
+}
+
+/**
+ * Perform a ROM operation.
+ * Internal function; called by RomData::doRomOp().
+ * @param id		[in] Operation index.
+ * @param pParams	[in/out] Parameters and results. (for e.g. UI updates)
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int GameCube::doRomOp_int(int id, RomOpParams *pParams)
+{
+	RP_D(GameCube);
+
+	// Currently only one ROM operation.
+	if (id != 0) {
+		pParams->status = -EINVAL;
+		pParams->msg = C_("RomData", "ROM operation ID is invalid for this object.");
+		return -EINVAL;
+	}
+
+	if ((d->discType & GameCubePrivate::DISC_SYSTEM_MASK) != GameCubePrivate::DISC_SYSTEM_WII) {
+		pParams->status = -EINVAL;
+		pParams->msg = C_("GameCube", "Hash verification is only supported for Wii discs.");
+		return -EINVAL;
+	}
+
+	if (d->loadWiiPartitionTables() != 0 || d->wiiPtbl.empty()) {
+		pParams->status = -EIO;
+		pParams->msg = C_("GameCube", "No partitions were found on this disc.");
+		return -EIO;
+	}
+
+	// Verify each partition's hash tree.
+	// NOTE: Unhashed partitions (RVT-H 32K sectors) are skipped,
+	// since there's nothing to verify them against.
+	size_t totalBadSectors = 0;
+	unsigned int verified = 0;
+	int err = 0;
+	for (const auto &entry : d->wiiPtbl) {
+		if (!entry.partition) {
+			continue;
+		}
+
+		size_t badSectors = 0;
+		const int ret = entry.partition->verifyHashes(&badSectors);
+		if (ret == -ENOTSUP) {
+			// No hash tree.
+			continue;
+		} else if (ret < 0) {
+			// I/O or key error. Report the first failing partition.
+			if (err == 0) {
+				err = ret;
+				pParams->msg = rp_sprintf(C_("GameCube", "Partition %dp%d could not be verified."),
+					entry.vg, entry.pt);
+			}
+			continue;
+		}
+
+		verified++;
+		totalBadSectors += badSectors;
+	}
+
+	if (err != 0) {
+		pParams->status = err;
+		return err;
+	}
+
+	if (verified == 0) {
+		// All partitions were skipped.
+		pParams->status = -ENOTSUP;
+		pParams->msg = C_("GameCube", "This disc has no partition hash trees to verify.");
+		return -ENOTSUP;
+	}
+
+	if (totalBadSectors == 0) {
+		pParams->msg = rp_sprintf(C_("GameCube", "All hashes are valid. (%u partition(s) verified)"), verified);
+		pParams->status = 0;
+	} else {
+		pParams->msg = rp_sprintf(C_("GameCube", "Hash verification failed: %u bad sector(s)."),
+			static_cast<unsigned int>(totalBadSectors));
+		// Positive status: the operation ran, but the content is bad.
+		pParams->status = 1;
+	}
+	return 0;
+}
+
 }
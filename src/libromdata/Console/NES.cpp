@@ -1152,7 +1152,7 @@ int NES::loadFieldData(void)
 				static_cast<unsigned int>(mapper), mapper_name);
 		} else {
 			// tr: Print only the mapper ID.
-			s_mapper = rp_sprintf("%u", static_cast<unsigned int>(mapper));
+			s_mapper = fmt_dec(static_cast<unsigned int>(mapper));
 		}
 		d->fields.addField_string(mapper_title, s_mapper);
 	} else {
@@ -1179,7 +1179,7 @@ int NES::loadFieldData(void)
 				static_cast<unsigned int>(submapper), submapper_name);
 		} else {
 			// tr: Print only the submapper ID.
-			s_submapper = rp_sprintf("%u", static_cast<unsigned int>(submapper));
+			s_submapper = fmt_dec(static_cast<unsigned int>(submapper));
 		}
 		d->fields.addField_string(C_("NES", "Submapper"), s_submapper);
 	}
@@ -1556,7 +1556,7 @@ int NES::loadFieldData(void)
 					footer_mapper, footer_mapper_tbl[footer_mapper]);
 			} else {
 				// tr: Print only the mapper ID.
-				s_footer_mapper = rp_sprintf("%u", footer_mapper);
+				s_footer_mapper = fmt_dec(footer_mapper);
 			}
 			d->fields.addField_string(C_("NES", "Board Type"), s_footer_mapper);
 
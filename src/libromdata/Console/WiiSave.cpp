@@ -456,9 +456,7 @@ int WiiSave::loadFieldData(void)
 	if (isSvValid) {
 		// Savegame ID. (title ID)
 		d->fields.addField_string(C_("WiiSave", "Savegame ID"),
-			rp_sprintf("%08X-%08X",
-				be32_to_cpu(svHeader->savegame_id.hi),
-				be32_to_cpu(svHeader->savegame_id.lo)));
+			fmt_hex<8>(be32_to_cpu(svHeader->savegame_id.hi)) + '-' + fmt_hex<8>(be32_to_cpu(svHeader->savegame_id.lo)));
 
 	}
 
@@ -10,10 +10,13 @@
 #include "WiiTicket.hpp"
 #include "wii_structs.h"
 
-// librpbase
+// librpbase, librpthreads
 #ifdef ENABLE_DECRYPTION
 #  include "librpbase/crypto/IAesCipher.hpp"
 #  include "librpbase/crypto/AesCipherFactory.hpp"
+#  include "librpthreads/Mutex.hpp"
+using LibRpThreads::Mutex;
+using LibRpThreads::MutexLocker;
 #endif /* ENABLE_DECRYPTION */
 using namespace LibRpBase;
 
@@ -162,6 +165,17 @@ const uint8_t WiiTicketPrivate::EncryptionKeyVerifyData[static_cast<size_t>(WiiT
 	{0xF3,0xE2,0xED,0xF4,0x8D,0x99,0x2A,0x5B,
 	 0xD8,0xE1,0x3F,0xA2,0x9B,0x89,0x73,0xAA},
 };
+
+// Process-wide cache of verified common keys.
+// KeyManager::getAndVerify() runs an AES verification test per call,
+// and a WAD-heavy directory scan repeats it for every file using the
+// same common key. Only keys that verified OK are cached, so a key
+// imported later in the same process is still picked up.
+static Mutex verifiedKeys_mutex;
+static struct {
+	bool isVerified;
+	uint8_t key[16];
+} verifiedKeys[static_cast<size_t>(WiiTicket::EncryptionKeys::Max)];
 #endif /* ENABLE_DECRYPTION */
 
 WiiTicketPrivate::WiiTicketPrivate(const IRpFilePtr &file)
@@ -574,10 +588,6 @@ int WiiTicket::decryptTitleKey(uint8_t *pKeyBuf, size_t size)
 		return ret;
 	}
 
-	// Get the Key Manager instance.
-	KeyManager *const keyManager = KeyManager::instance();
-	assert(keyManager != nullptr);
-
 	// Initialize the AES cipher.
 	unique_ptr<IAesCipher> cipher(AesCipherFactory::create());
 	if (!cipher || !cipher->isInit()) {
@@ -587,14 +597,40 @@ int WiiTicket::decryptTitleKey(uint8_t *pKeyBuf, size_t size)
 	}
 
 	// Get the common key.
+	// Check the process-wide verified key cache first.
 	KeyManager::KeyData_t keyData;
-	KeyManager::VerifyResult verifyResult = keyManager->getAndVerify(
-		WiiTicket::encryptionKeyName_static(static_cast<int>(d->encKey)), &keyData,
-		WiiTicket::encryptionVerifyData_static(static_cast<int>(d->encKey)), 16);
-	if (verifyResult != KeyManager::VerifyResult::OK) {
-		// An error occurred while loading the common key.
-		d->verifyResult = verifyResult;
-		return -EINVAL;
+	uint8_t cached_key[16];
+	bool foundInCache = false;
+	const size_t encKeyIdx = static_cast<size_t>(d->encKey);
+	{
+		MutexLocker mutexLocker(verifiedKeys_mutex);
+		if (verifiedKeys[encKeyIdx].isVerified) {
+			memcpy(cached_key, verifiedKeys[encKeyIdx].key, sizeof(cached_key));
+			keyData.key = cached_key;
+			keyData.length = sizeof(cached_key);
+			foundInCache = true;
+		}
+	}
+	if (!foundInCache) {
+		// Get the Key Manager instance.
+		KeyManager *const keyManager = KeyManager::instance();
+		assert(keyManager != nullptr);
+
+		KeyManager::VerifyResult verifyResult = keyManager->getAndVerify(
+			WiiTicket::encryptionKeyName_static(static_cast<int>(d->encKey)), &keyData,
+			WiiTicket::encryptionVerifyData_static(static_cast<int>(d->encKey)), 16);
+		if (verifyResult != KeyManager::VerifyResult::OK) {
+			// An error occurred while loading the common key.
+			d->verifyResult = verifyResult;
+			return -EINVAL;
+		}
+
+		// Save the verified key in the cache.
+		if (keyData.length == sizeof(verifiedKeys[encKeyIdx].key)) {
+			MutexLocker mutexLocker(verifiedKeys_mutex);
+			memcpy(verifiedKeys[encKeyIdx].key, keyData.key, keyData.length);
+			verifiedKeys[encKeyIdx].isVerified = true;
+		}
 	}
 
 	// Load the common key into the AES cipher. (CBC mode)
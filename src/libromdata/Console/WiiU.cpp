@@ -400,6 +400,38 @@ int WiiU::loadFieldData(void)
  *                               enum value.
  * @return 0 on success; negative POSIX error code on error.
  */
+/**
+ * Get a content identifier for this ROM image.
+ *
+ * The content ID identifies the *content*, not the file, so two
+ * dumps of the same title in different formats return the same string.
+ *
+ * @return Content ID, or empty string if not available.
+ */
+std::string WiiU::contentId(void) const
+{
+	RP_D(const WiiU);
+	if (!d->isValid) {
+		// Disc image isn't valid.
+		return {};
+	}
+
+	// Game ID.
+	// Replace any non-printable characters with underscores.
+	const WiiU_DiscHeader *const discHeader = &d->discHeader;
+	char id4[5];
+	for (unsigned int i = 0; i < 4; i++) {
+		id4[i] = (ISPRINT(discHeader->id4[i]))
+			? discHeader->id4[i]
+			: '_';
+	}
+	id4[4] = 0;
+
+	char buf[16];
+	snprintf(buf, sizeof(buf), "wiiu/%s", id4);
+	return {buf};
+}
+
 int WiiU::extURLs(ImageType imageType, vector<ExtURL> *pExtURLs, int size) const
 {
 	ASSERT_extURLs(imageType, pExtURLs);
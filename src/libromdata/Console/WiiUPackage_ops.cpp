@@ -0,0 +1,152 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata)                       *
+ * WiiUPackage_ops.cpp: Wii U NUS Package reader. (ROM operations)        *
+ *                                                                         *
+ * Copyright (c) 2016-2024 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "config.librpbase.h"
+
+#include "WiiUPackage.hpp"
+#include "WiiUPackage_p.hpp"
+
+// Other rom-properties libraries
+using namespace LibRpBase;
+using namespace LibRpFile;
+
+// C++ STL classes
+using std::string;
+using std::vector;
+
+namespace LibRomData {
+
+/**
+ * Get the list of operations that can be performed on this ROM.
+ * Internal function; called by RomData::romOps().
+ * @return List of operations.
+ */
+vector<RomData::RomOp> WiiUPackage::romOps_int(void) const
+{
+	RP_D(const WiiUPackage);
+	vector<RomOp> ops;
+
+	if (!d->isValid || d->contentsTable.empty()) {
+		// No contents to verify.
+		return ops;
+	}
+
+	// Only H3-hashed contents have a hash tree to verify.
+	bool hasHashedContent = false;
+	for (const auto &entry : d->contentsTable) {
+		if (entry.type & cpu_to_be16(0x0002)) {
+			hasHashedContent = true;
+			break;
+		}
+	}
+	if (!hasHashedContent) {
+		return ops;
+	}
+
+	RomOp op("Verify content &hashes", RomOp::ROF_ENABLED);
+#ifndef ENABLE_DECRYPTION
+	// Hash verification requires SHA-1 and AES from the crypto backend.
+	op.flags &= ~RomOp::ROF_ENABLED;
+#endif /* !ENABLE_DECRYPTION */
+	ops.emplace_back(std::move(op));
+	return ops;
+}
+
+/**
+ * Perform a ROM operation.
+ * Internal function; called by RomData::doRomOp().
+ * @param id		[in] Operation index.
+ * @param pParams	[in/out] Parameters and results. (for e.g. UI updates)
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int WiiUPackage::doRomOp_int(int id, RomOpParams *pParams)
+{
+	// Currently only one ROM operation.
+	if (id != 0) {
+		pParams->status = -EINVAL;
+		pParams->msg = C_("RomData", "ROM operation ID is invalid for this object.");
+		return -EINVAL;
+	}
+
+#ifdef ENABLE_DECRYPTION
+	RP_D(WiiUPackage);
+
+	// Verify each H3-hashed content's hash tree.
+	// NOTE: Unhashed (CBC) contents have no hash tree, so
+	// they're skipped.
+	size_t totalBadSectors = 0;
+	unsigned int verified = 0;
+	int err = 0;
+	const unsigned int count = static_cast<unsigned int>(d->contentsTable.size());
+	for (unsigned int i = 0; i < count; i++) {
+		const WUP_Content_Entry &entry = d->contentsTable[i];
+		if (!(entry.type & cpu_to_be16(0x0002))) {
+			// Not H3-hashed.
+			continue;
+		}
+
+		const IDiscReaderPtr contentFile = d->openContentFile(i);
+		WiiUH3Reader *const reader = dynamic_cast<WiiUH3Reader*>(contentFile.get());
+		if (!reader) {
+			// Unable to open the content file.
+			if (err == 0) {
+				err = -EIO;
+				pParams->msg = rp_sprintf(C_("WiiUPackage", "Content %08X could not be opened."),
+					be32_to_cpu(entry.content_id));
+			}
+			continue;
+		}
+
+		size_t badSectors = 0;
+		const int ret = reader->verifyHashes(&badSectors);
+		if (ret < 0) {
+			// I/O or key error. Report the first failing content.
+			if (err == 0) {
+				err = ret;
+				pParams->msg = rp_sprintf(C_("WiiUPackage", "Content %08X could not be verified."),
+					be32_to_cpu(entry.content_id));
+			}
+			continue;
+		}
+
+		verified++;
+		totalBadSectors += badSectors;
+	}
+
+	if (err != 0) {
+		pParams->status = err;
+		return err;
+	}
+
+	if (verified == 0) {
+		// All contents were skipped.
+		pParams->status = -ENOTSUP;
+		pParams->msg = C_("WiiUPackage", "This package has no content hash trees to verify.");
+		return -ENOTSUP;
+	}
+
+	if (totalBadSectors == 0) {
+		pParams->msg = rp_sprintf(C_("WiiUPackage", "All hashes are valid. (%u content(s) verified)"), verified);
+		pParams->status = 0;
+	} else {
+		pParams->msg = rp_sprintf(C_("WiiUPackage", "Hash verification failed: %u bad sector(s)."),
+			static_cast<unsigned int>(totalBadSectors));
+		// Positive status: the operation ran, but the content is bad.
+		pParams->status = 1;
+	}
+	return 0;
+#else /* !ENABLE_DECRYPTION */
+	// Hash verification requires SHA-1 and AES from the crypto backend.
+	pParams->status = -ENOTSUP;
+	pParams->msg = C_("WiiUPackage", "Hash verification requires decryption support.");
+	return -ENOTSUP;
+#endif /* ENABLE_DECRYPTION */
+}
+
+}
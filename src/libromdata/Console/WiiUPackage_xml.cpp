@@ -31,7 +31,6 @@ using namespace tinyxml2;
 // C++ STL classes
 using std::array;
 using std::string;
-using std::unique_ptr;
 using std::vector;
 
 namespace LibRomData {
@@ -84,8 +83,16 @@ int WiiUPackagePrivate::loadSystemXml(XMLDocument &doc, const char *filename, co
 		// (Or, it's negative, and wraps around due to unsigned.)
 		return -ENOMEM;
 	}
-	unique_ptr<char[]> xml(new char[xml_size+1]);
-	size_t size = f_xml->read(xml.get(), xml_size);
+	// NOTE: Using the per-thread arena for the read buffer, since
+	// library scans parse thousands of these. XMLDocument::Parse()
+	// makes its own copy, so the buffer isn't needed afterwards.
+	AlignedArenaScope arena;
+	char *const xml = arena.alloc<char>(16, xml_size+1);
+	if (!xml) {
+		// Unable to allocate memory.
+		return -ENOMEM;
+	}
+	size_t size = f_xml->read(xml, xml_size);
 	if (size != xml_size) {
 		// Read error.
 		int err = f_xml->lastError();
@@ -104,7 +111,7 @@ int WiiUPackagePrivate::loadSystemXml(XMLDocument &doc, const char *filename, co
 #if TINYXML2_MAJOR_VERSION >= 2
 	doc.Clear();
 #endif /* TINYXML2_MAJOR_VERSION >= 2 */
-	int xerr = doc.Parse(xml.get());
+	int xerr = doc.Parse(xml);
 	if (xerr != XML_SUCCESS) {
 		// Error parsing the manifest XML.
 		// TODO: Better error code.
@@ -582,7 +589,8 @@ int WiiUPackagePrivate::addMetaData_System_XMLs(void)
 #endif /* defined(_MSC_VER) && defined(XML_IS_DLL) */
 
 	// Load meta.xml.
-	XMLDocument appXml, cosXml, metaXml;
+	// NOTE: app.xml and cos.xml aren't needed for metadata.
+	XMLDocument metaXml;
 	int ret = loadSystemXml(metaXml, "/meta/meta.xml", "menu");
 	if (ret != 0)
 		return ret;
@@ -861,9 +861,7 @@ int WiiWAD::loadFieldData(void)
 	// Title ID.
 	// TODO: Make sure the ticket title ID matches the TMD title ID.
 	d->fields.addField_string(C_("Nintendo", "Title ID"),
-		rp_sprintf("%08X-%08X",
-			be32_to_cpu(tmdHeader->title_id.hi),
-			be32_to_cpu(tmdHeader->title_id.lo)));
+		fmt_hex<8>(be32_to_cpu(tmdHeader->title_id.hi)) + '-' + fmt_hex<8>(be32_to_cpu(tmdHeader->title_id.lo)));
 
 	// Game ID.
 	// NOTE: Only displayed if TID lo is all alphanumeric characters.
@@ -970,9 +968,7 @@ int WiiWAD::loadFieldData(void)
 				// Non-standard IOS slot.
 				// Print the full title ID.
 				d->fields.addField_string(ios_version_title,
-					rp_sprintf("%08X-%08X",
-						be32_to_cpu(tmdHeader->sys_version.hi),
-						be32_to_cpu(tmdHeader->sys_version.lo)));
+					fmt_hex<8>(be32_to_cpu(tmdHeader->sys_version.hi)) + '-' + fmt_hex<8>(be32_to_cpu(tmdHeader->sys_version.lo)));
 			}
 		}
 
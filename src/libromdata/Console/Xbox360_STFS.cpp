@@ -947,7 +947,7 @@ int Xbox360_STFS::loadFieldData(void)
 
 	// Media ID
 	d->fields.addField_string(C_("Xbox360_STFS", "Media ID"),
-		rp_sprintf("%08X", be32_to_cpu(stfsMetadata->media_id)),
+		fmt_hex<8>(be32_to_cpu(stfsMetadata->media_id)),
 		RomFields::STRF_MONOSPACE);
 
 	// Title ID
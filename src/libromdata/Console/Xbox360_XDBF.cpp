@@ -97,6 +97,13 @@ public:
 	// NOTE: These are *pointers* to rp::uvector<>.
 	array<rp::uvector<char>*, XDBF_LANGUAGE_MAX> strTbls;
 
+	// String table indexes: string ID -> entry offset.
+	// Built when the corresponding string table is loaded, so the
+	// achievement list doesn't do a linear scan per lookup.
+	// Key: String ID (big-endian, as stored in the table)
+	// Value: Offset of the XDBF_XSTR_Entry_Header within the table.
+	array<unordered_map<uint16_t, uint32_t>*, XDBF_LANGUAGE_MAX> strTblMaps;
+
 	// If true, this XDBF section is in an XEX executable.
 	// Some fields shouldn't be displayed.
 	bool xex;
@@ -300,6 +307,7 @@ Xbox360_XDBF_Private::Xbox360_XDBF_Private(const IRpFilePtr &file, bool xex)
 
 	// Clear the string table pointers and indexes.
 	strTbls.fill(nullptr);
+	strTblMaps.fill(nullptr);
 	strTblIndexes.fill(0);
 }
 
@@ -309,6 +317,9 @@ Xbox360_XDBF_Private::~Xbox360_XDBF_Private()
 	for (rp::uvector<char> *pStrTbl : strTbls) {
 		delete pStrTbl;
 	}
+	for (unordered_map<uint16_t, uint32_t> *pStrTblMap : strTblMaps) {
+		delete pStrTblMap;
+	}
 }
 
 /**
@@ -456,8 +467,22 @@ const rp::uvector<char> *Xbox360_XDBF_Private::loadStringTable_SPA(XDBF_Language
 		return nullptr;
 	}
 
+	// Build the string ID index.
+	// NOTE: Keys are the big-endian string IDs as stored in the table.
+	unordered_map<uint16_t, uint32_t> *const map = new unordered_map<uint16_t, uint32_t>();
+	const char *const p_start = vec->data();
+	const char *p = p_start + sizeof(XDBF_XSTR_Header);
+	const char *const p_end = p_start + vec->size();
+	while (p + sizeof(XDBF_XSTR_Entry_Header) <= p_end) {
+		const XDBF_XSTR_Entry_Header *const hdr =
+			reinterpret_cast<const XDBF_XSTR_Entry_Header*>(p);
+		map->emplace(hdr->string_id, static_cast<uint32_t>(p - p_start));
+		p += sizeof(XDBF_XSTR_Entry_Header) + be16_to_cpu(hdr->length);
+	}
+
 	// String table loaded successfully.
 	this->strTbls[langID] = vec;
+	this->strTblMaps[langID] = map;
 	return vec;
 }
 
@@ -491,35 +516,35 @@ string Xbox360_XDBF_Private::loadString_SPA(XDBF_Language_e langID, uint16_t str
 	string_id = cpu_to_be16(string_id);
 #endif /* SYS_BYTEORDER == SYS_LIL_ENDIAN */
 
-	// TODO: Optimize by creating an unordered_map of IDs to strings?
-	// Might not be a good optimization if we don't have that many strings...
-
 	// Search for the specified string.
-	const char *p = vec->data() + sizeof(XDBF_XSTR_Header);
-	const char *const p_end = p + vec->size() - sizeof(XDBF_XSTR_Header);
-	while (p < p_end) {
-		// TODO: Verify alignment.
-		const XDBF_XSTR_Entry_Header *const hdr =
-			reinterpret_cast<const XDBF_XSTR_Entry_Header*>(p);
-		const uint16_t length = be16_to_cpu(hdr->length);
-		if (hdr->string_id == string_id) {
-			// Found the string.
-			// Verify that it doesn't go out of bounds.
-			const char *const p_str = p + sizeof(XDBF_XSTR_Entry_Header);
-			const char *const p_str_end = p_str + length;
-			if (p_str_end <= p_end) {
-				// Bounds are OK.
-				// Character set conversion isn't needed, since
-				// the string table is UTF-8, but we do need to
-				// convert from DOS to UNIX line endings.
-				ret = dos2unix(p_str, length);
-			}
-			break;
-		} else {
-			// Not the requested string.
-			// Go to the next string.
-			p += sizeof(XDBF_XSTR_Entry_Header) + length;
-		}
+	// The index is built when the string table is loaded.
+	const unordered_map<uint16_t, uint32_t> *const map = strTblMaps[langID];
+	assert(map != nullptr);
+	if (!map) {
+		return ret;
+	}
+
+	auto iter = map->find(string_id);
+	if (iter == map->end()) {
+		// Not found.
+		return ret;
+	}
+
+	// Found the string.
+	// Verify that it doesn't go out of bounds.
+	const char *const p = vec->data() + iter->second;
+	const char *const p_end = vec->data() + vec->size();
+	const XDBF_XSTR_Entry_Header *const hdr =
+		reinterpret_cast<const XDBF_XSTR_Entry_Header*>(p);
+	const uint16_t length = be16_to_cpu(hdr->length);
+	const char *const p_str = p + sizeof(XDBF_XSTR_Entry_Header);
+	const char *const p_str_end = p_str + length;
+	if (p_str_end <= p_end) {
+		// Bounds are OK.
+		// Character set conversion isn't needed, since
+		// the string table is UTF-8, but we do need to
+		// convert from DOS to UNIX line endings.
+		ret = dos2unix(p_str, length);
 	}
 
 	return ret;
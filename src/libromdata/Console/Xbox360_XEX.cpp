@@ -911,11 +911,36 @@ int Xbox360_XEX_Private::initPeReader(void)
 				lzx_idx = !lzx_idx;
 			}
 
+			// Determine how much of the image is actually needed:
+			// the PE header, plus the XDBF section if present.
+			// The rest of the executable is never read, so don't
+			// spend time (or memory) decompressing it.
+			uint32_t needed_size = PE_HEADER_SIZE;
+			uint32_t xdbf_physaddr = 0;
+			const XEX2_Resource_Info *const pResInfo = getXdbfResInfo();
+			if (pResInfo) {
+				const uint32_t load_address = be32_to_cpu(
+					(xexType != XexType::XEX1
+						? secInfo.xex2.load_address
+						: secInfo.xex1.load_address));
+
+				xdbf_physaddr = pResInfo->vaddr - load_address;
+				if (xdbf_physaddr + pResInfo->size <= image_size &&
+				    xdbf_physaddr + pResInfo->size > needed_size)
+				{
+					needed_size = xdbf_physaddr + pResInfo->size;
+				}
+			}
+
 			// Decompress the data.
-			unique_ptr<uint8_t[]> decompressed_exe(new uint8_t[image_size]);
+			// NOTE: Limiting the output length to needed_size stops
+			// decompression once the required extent has been
+			// materialized; lzxd streams the output in 32 KB frames,
+			// so this is an early exit, not a truncation error.
+			unique_ptr<uint8_t[]> decompressed_exe(new uint8_t[needed_size]);
 			int res = lzx_decompress(compressed_deblock.get(),
 				static_cast<size_t>(p_dblk - compressed_deblock.get()),
-				decompressed_exe.get(), image_size,
+				decompressed_exe.get(), needed_size,
 				window_size, nullptr, 0);
 			if (res != MSPACK_ERR_OK) {
 				// Error decompressing the data.
@@ -936,20 +961,11 @@ int Xbox360_XEX_Private::initPeReader(void)
 			memcpy(lzx_peHeader.data(), decompressed_exe.get(), PE_HEADER_SIZE);
 
 			// Copy the XDBF section.
-			const XEX2_Resource_Info *const pResInfo = getXdbfResInfo();
-			if (pResInfo) {
-				const uint32_t load_address = be32_to_cpu(
-					(xexType != XexType::XEX1
-						? secInfo.xex2.load_address
-						: secInfo.xex1.load_address));
-
-				const uint32_t xdbf_physaddr = pResInfo->vaddr - load_address;
-				if (xdbf_physaddr + pResInfo->size <= image_size) {
-					lzx_xdbfSection.resize(pResInfo->size);
-					memcpy(lzx_xdbfSection.data(),
-						decompressed_exe.get() + xdbf_physaddr,
-						pResInfo->size);
-				}
+			if (pResInfo && xdbf_physaddr + pResInfo->size <= needed_size) {
+				lzx_xdbfSection.resize(pResInfo->size);
+				memcpy(lzx_xdbfSection.data(),
+					decompressed_exe.get() + xdbf_physaddr,
+					pResInfo->size);
 			}
 
 			// Save the correct reader.
@@ -77,9 +77,27 @@ public:
 	rp_image_ptr img_thumbnail;	// handled as icon
 	rp_image_ptr img_title;		// handled as banner
 
+	// Cached ROM title and ISBN
+	// Cached so loadFieldData() and loadMetaData() don't
+	// re-read and re-convert the strings.
+	string rom_title;
+	string rom_isbn;
+	int titleAndISBN_ret;
+	bool titleAndISBN_loaded;
+
+private:
+	/**
+	 * Read the ROM title and ISBN. (internal function)
+	 * Results are stored in rom_title and rom_isbn.
+	 * @return 0 on success; non-zero on error.
+	 */
+	int readTitleAndISBN(void);
+
 public:
 	/**
 	 * Get the ROM title and ISBN.
+	 * The strings are cached, so loadFieldData() and
+	 * loadMetaData() only read the file once.
 	 * @param title Output string for title.
 	 * @param isbn Output string for ISBN.
 	 * @return 0 on success; non-zero on error.
@@ -148,6 +166,8 @@ iQuePlayerPrivate::iQuePlayerPrivate(const IRpFilePtr &file)
 	, iQueFileType(IQueFileType::Unknown)
 	, img_thumbnail(nullptr)
 	, img_title(nullptr)
+	, titleAndISBN_ret(0)
+	, titleAndISBN_loaded(false)
 {
 	// Clear the .cmd structs.
 	memset(&contentDesc, 0, sizeof(contentDesc));
@@ -156,13 +176,15 @@ iQuePlayerPrivate::iQuePlayerPrivate(const IRpFilePtr &file)
 }
 
 /**
- * Get the ROM title and ISBN.
- * @param title Output string for title.
- * @param isbn Output string for ISBN.
+ * Read the ROM title and ISBN. (internal function)
+ * Results are stored in rom_title and rom_isbn.
  * @return 0 on success; non-zero on error.
  */
-int iQuePlayerPrivate::getTitleAndISBN(string &title, string &isbn)
+int iQuePlayerPrivate::readTitleAndISBN(void)
 {
+	string &title = rom_title;
+	string &isbn = rom_isbn;
+
 	// Stored immediately after the thumbnail and title images,
 	// and NULL-terminated.
 	static constexpr size_t title_buf_sz = IQUE_PLAYER_BBCONTENTMETADATAHEAD_ADDRESS - sizeof(contentDesc);
@@ -234,6 +256,26 @@ int iQuePlayerPrivate::getTitleAndISBN(string &title, string &isbn)
 	return 0;
 }
 
+/**
+ * Get the ROM title and ISBN.
+ * The strings are cached, so loadFieldData() and
+ * loadMetaData() only read the file once.
+ * @param title Output string for title.
+ * @param isbn Output string for ISBN.
+ * @return 0 on success; non-zero on error.
+ */
+int iQuePlayerPrivate::getTitleAndISBN(string &title, string &isbn)
+{
+	if (!titleAndISBN_loaded) {
+		titleAndISBN_loaded = true;
+		titleAndISBN_ret = readTitleAndISBN();
+	}
+
+	title = rom_title;
+	isbn = rom_isbn;
+	return titleAndISBN_ret;
+}
+
 /**
  * Load an image. (internal function)
  * @param address	[in] Starting address.
@@ -646,7 +688,7 @@ int iQuePlayer::loadFieldData(void)
 	// This is sort of like Wii title IDs, but only the
 	// title ID low portion.
 	d->fields.addField_string(C_("iQuePlayer", "Content ID"),
-		rp_sprintf("%08X", be32_to_cpu(bbContentMetaDataHead->content_id)),
+		fmt_hex<8>(be32_to_cpu(bbContentMetaDataHead->content_id)),
 		RomFields::STRF_MONOSPACE);
 
 	if (d->iQueFileType == iQuePlayerPrivate::IQueFileType::DAT) {
@@ -669,7 +669,7 @@ void Nintendo3DSPrivate::addTitleIdAndProductCodeFields(bool showContentType)
 	}
 
 	if (tid_desc) {
-		fields.addField_string(tid_desc, rp_sprintf("%08X-%08X", tid_hi, tid_lo));
+		fields.addField_string(tid_desc, fmt_hex<8>(tid_hi) + '-' + fmt_hex<8>(tid_lo));
 	}
 
 	if (!ncch_header) {
@@ -682,7 +682,7 @@ void Nintendo3DSPrivate::addTitleIdAndProductCodeFields(bool showContentType)
 		const uint32_t pid_lo = le32_to_cpu(ncch_header->program_id.lo);
 		const uint32_t pid_hi = le32_to_cpu(ncch_header->program_id.hi);
 		fields.addField_string(C_("Nintendo3DS", "Program ID"),
-			rp_sprintf("%08X-%08X", pid_hi, pid_lo));
+			fmt_hex<8>(pid_hi) + '-' + fmt_hex<8>(pid_lo));
 	}
 
 	// Product code.
@@ -1976,7 +1976,7 @@ int Nintendo3DS::loadFieldData(void)
 			data_row.reserve(5);
 
 			// Partition number.
-			data_row.emplace_back(rp_sprintf("%u", i));
+			data_row.emplace_back(fmt_dec(i));
 
 			// Partition type.
 			// TODO: Use the partition ID to determine the type?
@@ -2039,7 +2039,7 @@ int Nintendo3DS::loadFieldData(void)
 
 			if (keyslots) {
 				// Keyslot.
-				data_row.emplace_back(rp_sprintf("0x%02X", keyslots[i]));
+				data_row.emplace_back(fmt_hex_0x<2>(keyslots[i]));
 			}
 
 			// Partition size.
@@ -2112,7 +2112,7 @@ int Nintendo3DS::loadFieldData(void)
 		// NOTE: Technically part of the ticket.
 		// NOTE: Not including the "0x" hex prefix.
 		d->fields.addField_string(C_("Nintendo", "Console ID"),
-			rp_sprintf("%08X", be32_to_cpu(d->mxh.ticket.console_id)),
+			fmt_hex<8>(be32_to_cpu(d->mxh.ticket.console_id)),
 			RomFields::STRF_MONOSPACE);
 
 		// Contents table.
@@ -2138,7 +2138,7 @@ int Nintendo3DS::loadFieldData(void)
 			data_row.reserve(5);
 
 			// Content index
-			data_row.emplace_back(rp_sprintf("%u", i));
+			data_row.emplace_back(fmt_dec(i));
 
 			// TODO: Use content_chunk->index?
 			const N3DS_NCCH_Header_NoSig_t *content_ncch_header = nullptr;
@@ -827,8 +827,7 @@ int NintendoDS::loadFieldData(void)
 	// Title ID
 	const uint32_t tid_hi = le32_to_cpu(romHeader->dsi.title_id.hi);
 	d->fields.addField_string(C_("Nintendo", "Title ID"),
-		rp_sprintf("%08X-%08X",
-			tid_hi, le32_to_cpu(romHeader->dsi.title_id.lo)));
+		fmt_hex<8>(tid_hi) + '-' + fmt_hex<8>(le32_to_cpu(romHeader->dsi.title_id.lo)));
 
 	// DSi filetype
 	struct dsi_filetype_tbl_t{
@@ -288,7 +288,7 @@ int PokemonMini::loadFieldData(void)
 		data_row.reserve(3);
 
 		// # (decimal)
-		data_row.emplace_back(rp_sprintf("%u", i));
+		data_row.emplace_back(fmt_dec(i));
 
 		// Vector name
 		data_row.emplace_back(vectors_names[i]);
@@ -299,13 +299,13 @@ int PokemonMini::loadFieldData(void)
 			// Standard vector jump opcode.
 			uint32_t offset = (romHeader->irqs[i][5] << 8) | romHeader->irqs[i][4];
 			offset += pc + 3 + 3 - 1;
-			s_address = rp_sprintf("0x%04X", offset);
+			s_address = fmt_hex_0x<4>(offset);
 		} else if (romHeader->irqs[i][0] == 0xF3) {
 			// JMPW without MOV U.
 			// Seen in some homebrew.
 			uint32_t offset = (romHeader->irqs[i][2] << 8) | romHeader->irqs[i][1];
 			offset += pc + 3 - 1;
-			s_address = rp_sprintf("0x%04X", offset);
+			s_address = fmt_hex_0x<4>(offset);
 		} else if (!memcmp(&romHeader->irqs[i][0], vec_empty_ff.data(), vec_empty_ff.size()) ||
 			   !memcmp(&romHeader->irqs[i][0], vec_empty_00.data(), vec_empty_00.size())) {
 			// Empty vector.
@@ -9,6 +9,41 @@
 #include "stdafx.h"
 #include "nds_crc.hpp"
 
+// C++ STL classes
+using std::array;
+
+// Polynomial 0x8005 is processed LSB-first, so the tables are
+// generated with the reflected polynomial 0xA001.
+static constexpr uint16_t CRC16_POLY_REFLECTED = 0xA001;
+
+/**
+ * Generate the CRC16 slicing tables. (polynomial 0x8005, reflected)
+ * Table 0 is the standard byte-at-a-time table; table N advances
+ * the CRC by N additional zero bytes, so eight bytes can be
+ * processed per iteration with one table lookup each.
+ * @return Slicing tables
+ */
+static constexpr array<array<uint16_t, 256>, 8> crc16_make_tables(void)
+{
+	array<array<uint16_t, 256>, 8> tbl{};
+	for (unsigned int i = 0; i < 256; i++) {
+		uint16_t crc = static_cast<uint16_t>(i);
+		for (unsigned int j = 0; j < 8; j++) {
+			crc = (crc >> 1) ^ ((crc & 1) ? CRC16_POLY_REFLECTED : 0);
+		}
+		tbl[0][i] = crc;
+	}
+	for (unsigned int k = 1; k < 8; k++) {
+		for (unsigned int i = 0; i < 256; i++) {
+			const uint16_t crc = tbl[k-1][i];
+			tbl[k][i] = (crc >> 8) ^ tbl[0][crc & 0xFF];
+		}
+	}
+	return tbl;
+}
+
+static constexpr array<array<uint16_t, 256>, 8> crc16_tables = crc16_make_tables();
+
 /**
  * Calculate the CRC16 of a block of data.
  * Polynomial: 0x8005 (for NDS icon/title)
@@ -19,20 +54,28 @@
  */
 uint16_t crc16_0x8005(const uint8_t *buf, size_t size, uint16_t crc)
 {
-	// Reference: https://www.reddit.com/r/embedded/comments/1acoobg/crc16_again_with_a_little_gift_for_you_all/
 	// NOTE: NDS icon/title CRC16 uses polynomial 0x8005.
 
-	while (size--) {
-		uint32_t x = ((crc ^ *buf++) & 0xff) << 8;
-		uint32_t y = x;
-
-		x ^= x << 1;
-		x ^= x << 2;
-		x ^= x << 4;
-
-		x  = (x & 0x8000) | (y >> 1);
+	// Slice-by-8: process eight bytes per iteration.
+	// The CRC only covers the first two bytes; the other six are
+	// pure data, so their lookups are independent of the CRC and
+	// each other.
+	for (; size >= 8; buf += 8, size -= 8) {
+		const uint32_t lo = static_cast<uint32_t>(crc) ^
+			(buf[0] | (static_cast<uint32_t>(buf[1]) << 8));
+		crc =	crc16_tables[7][lo & 0xFF] ^
+			crc16_tables[6][(lo >> 8) & 0xFF] ^
+			crc16_tables[5][buf[2]] ^
+			crc16_tables[4][buf[3]] ^
+			crc16_tables[3][buf[4]] ^
+			crc16_tables[2][buf[5]] ^
+			crc16_tables[1][buf[6]] ^
+			crc16_tables[0][buf[7]];
+	}
 
-		crc = (crc >> 8) ^ (x >> 15) ^ (x >> 1) ^ x;
+	// Remaining bytes.
+	for (; size > 0; buf++, size--) {
+		crc = (crc >> 8) ^ crc16_tables[0][(crc ^ *buf) & 0xFF];
 	}
 
 	return crc;
@@ -38,6 +38,7 @@ using LibRpThreads::MutexLocker;
 // C++ STL classes
 using std::string;
 using std::unique_ptr;
+using std::vector;
 
 // Blowfish data.
 // This is loaded from ~/.config/rom-properties/nds-blowfish.bin.
@@ -55,6 +56,22 @@ static constexpr uint8_t blowfish_md5[3][16] = {
 };
 static unique_ptr<uint8_t[]> blowfish_data[3];
 
+// Cached Blowfish key schedules, keyed by gamecode and key ID.
+// The key schedule for a given gamecode is derived from ~2,600
+// Blowfish encryptions, and repeated header checks of the same
+// title (e.g. in a batch scan) re-derive identical schedules.
+// Entries are immutable once inserted, so readers only need the
+// mutex for the lookup itself.
+struct NDSKeySchedule {
+	uint32_t gamecode;
+	BlowfishKey bfkey;
+	uint32_t card_hash[NDS_BLOWFISH_SIZE/sizeof(uint32_t)];
+	uint32_t keycode[3];
+};
+static Mutex key_schedule_mutex;
+static constexpr size_t KEY_SCHEDULE_CACHE_MAX = 8;
+static vector<unique_ptr<NDSKeySchedule> > key_schedule_cache;
+
 /**
  * Load and verify a Blowfish file.
  * These must be present in order to use ndscrypt_secure_area().
@@ -284,6 +301,19 @@ void NDSCrypt::init2(uint32_t *magic, uint32_t a[3])
 
 void NDSCrypt::init1(BlowfishKey bfkey)
 {
+	// Check the key schedule cache first.
+	{
+		MutexLocker mutexLocker(key_schedule_mutex);
+		for (const auto &sched : key_schedule_cache) {
+			if (sched->gamecode == m_gamecode && sched->bfkey == bfkey) {
+				// Found a cached key schedule.
+				memcpy(m_card_hash, sched->card_hash, sizeof(m_card_hash));
+				memcpy(m_keycode, sched->keycode, sizeof(m_keycode));
+				return;
+			}
+		}
+	}
+
 	// FIXME: Not big-endian safe.
 	memcpy(m_card_hash, blowfish_data[bfkey].get(), 4*(1024 + 18));
 	m_keycode[0] = m_gamecode;
@@ -291,6 +321,27 @@ void NDSCrypt::init1(BlowfishKey bfkey)
 	m_keycode[2] = m_gamecode << 1;
 	init2(m_card_hash, m_keycode);	// level 1 (NDS init)
 	init2(m_card_hash, m_keycode);	// level 2 (DSi init, NDS/DSi before reading Secure Area)
+
+	// Save the computed key schedule in the cache.
+	unique_ptr<NDSKeySchedule> sched(new NDSKeySchedule);
+	sched->gamecode = m_gamecode;
+	sched->bfkey = bfkey;
+	memcpy(sched->card_hash, m_card_hash, sizeof(sched->card_hash));
+	memcpy(sched->keycode, m_keycode, sizeof(sched->keycode));
+
+	MutexLocker mutexLocker(key_schedule_mutex);
+	// Verify again after the mutex is locked.
+	for (const auto &other : key_schedule_cache) {
+		if (other->gamecode == m_gamecode && other->bfkey == bfkey) {
+			// Another thread cached it first.
+			return;
+		}
+	}
+	if (key_schedule_cache.size() >= KEY_SCHEDULE_CACHE_MAX) {
+		// Cache is full. Evict the oldest entry.
+		key_schedule_cache.erase(key_schedule_cache.begin());
+	}
+	key_schedule_cache.push_back(std::move(sched));
 }
 
 void NDSCrypt::init0(BlowfishKey bfkey)
@@ -87,6 +87,12 @@ public:
 	// Currently cached G64/G71 track. (0 == none)
 	uint8_t GCR_track_cache_number;
 
+	// Currently cached track for standard disk images. (0 == none)
+	// Chained directory reads touch each track once instead of
+	// seeking per sector.
+	uint8_t track_cache_number;
+	rp::uvector<uint8_t> track_cache;
+
 	// Error bytes info (for certain D64/D71 format images)
 	unsigned int err_bytes_count;
 	unsigned int err_bytes_offset;
@@ -262,6 +268,7 @@ CBMDOSPrivate::CBMDOSPrivate(const IRpFilePtr &file)
 	, dir_track(0)
 	, dir_first_sector(0)
 	, GCR_track_cache_number(0)
+	, track_cache_number(0)
 	, err_bytes_count(0)
 	, err_bytes_offset(0)
 	, GCR_track_buffer(nullptr)
@@ -761,14 +768,30 @@ size_t CBMDOSPrivate::read_sector(void *buf, size_t siz, uint8_t track, uint8_t
 			ret = siz;
 			break;
 
-		default:
+		default: {
 			// Standard disk image
-			// Get the absolute starting address.
-			const off64_t start_pos = this_track.start_offset + (sector * CBMDOS_SECTOR_SIZE);
+			// Read through the track cache so chained directory
+			// reads touch each track once.
+			if (track != track_cache_number) {
+				const size_t track_size = static_cast<size_t>(this_track.sector_count) * CBMDOS_SECTOR_SIZE;
+				track_cache.resize(track_size);
+				size_t sz_read = file->seekAndRead(this_track.start_offset, track_cache.data(), track_size);
+				if (sz_read != track_size) {
+					// Unable to cache the track.
+					// Fall back to reading the sector directly.
+					track_cache_number = 0;
+					const off64_t start_pos = this_track.start_offset + (sector * CBMDOS_SECTOR_SIZE);
+					ret = file->seekAndRead(start_pos, buf, siz);
+					break;
+				}
+				track_cache_number = track;
+			}
 
-			// Read the sector.
-			ret = file->seekAndRead(start_pos, buf, siz);
+			// Copy from the track cache.
+			memcpy(buf, &track_cache[sector * CBMDOS_SECTOR_SIZE], siz);
+			ret = siz;
 			break;
+		}
 	}
 	return ret;
 }
@@ -852,12 +875,13 @@ string CBMDOSPrivate::getDiskName(unsigned int *pCodepage) const
 	}
 
 	// Try unshifted first.
-	string s_disk_name = cpN_to_utf8(codepage, disk_name, static_cast<int>(disk_name_len));
+	string s_disk_name;
+	cpN_to_utf8(codepage, disk_name, static_cast<int>(disk_name_len), s_disk_name);
 	if (s_disk_name.find(uFFFD) != string::npos) {
 		// Disk name has invalid characters when using Unshifted.
-		// Try again with Shifted.
+		// Try again with Shifted. (reusing the string's buffer)
 		codepage = CP_RP_PETSCII_Shifted;
-		s_disk_name = cpN_to_utf8(codepage, disk_name, static_cast<int>(disk_name_len));
+		cpN_to_utf8(codepage, disk_name, static_cast<int>(disk_name_len), s_disk_name);
 	}
 
 	if (pCodepage) {
@@ -1283,12 +1307,13 @@ int CBMDOS::loadFieldData(void)
 				// NOTE: Using Latin-1...
 				p_list.emplace_back(latin1_to_utf8(p_dir->filename, filename_len));
 			} else {
-				string s_filename = cpN_to_utf8(codepage, p_dir->filename, filename_len);
+				string s_filename;
+				cpN_to_utf8(codepage, p_dir->filename, filename_len, s_filename);
 				if (codepage == CP_RP_PETSCII_Unshifted && s_filename.find(d->uFFFD) != string::npos) {
 					// File name has invalid characters when using Unshifted.
-					// Try again with Shifted.
+					// Try again with Shifted. (reusing the string's buffer)
 					codepage = CP_RP_PETSCII_Shifted;
-					s_filename = cpN_to_utf8(codepage, p_dir->filename, filename_len);
+					cpN_to_utf8(codepage, p_dir->filename, filename_len, s_filename);
 				}
 				p_list.emplace_back(std::move(s_filename));
 			}
@@ -387,7 +387,7 @@ int Amiibo::loadFieldData(void)
 	// tr: amiibo ID. Represents the character and amiibo series.
 	// TODO: Link to https://amiibo.life/nfc/%08X-%08X
 	d->fields.addField_string(C_("Amiibo", "amiibo ID"),
-		rp_sprintf("%08X-%08X", char_id, amiibo_id),
+		fmt_hex<8>(char_id) + '-' + fmt_hex<8>(amiibo_id),
 		RomFields::STRF_MONOSPACE);
 
 	// tr: amiibo type.
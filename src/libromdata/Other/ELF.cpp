@@ -139,7 +139,10 @@ public:
 	// Section Header information
 	string osVersion;	// Operating system version.
 
-	rp::uvector<uint8_t> build_id;	// GNU `ld` build ID. (raw data)
+	// GNU `ld` build ID. (raw data)
+	// NOTE: Standard build IDs are 16-32 bytes (md5/uuid, sha1, xxHash),
+	// so they fit in suvector's inline storage.
+	rp::suvector<uint8_t, 32> build_id;
 	const char *build_id_type;	// Build ID type.
 
 	/**
@@ -323,7 +326,9 @@ int ELFPrivate::checkProgramHeaders(void)
 	off64_t e_phoff;
 	unsigned int e_phnum;
 	unsigned int phsize;
-	uint8_t phbuf[sizeof(Elf64_Phdr)];
+	// Read the program headers in batches instead of one at a time.
+	// Core dumps can have tens of thousands of them.
+	uint8_t phbuf[sizeof(Elf64_Phdr) * 64];
 
 	if (Elf_Header.primary.e_class == ELFCLASS64) {
 		e_phoff = static_cast<off64_t>(elf64_to_cpu(Elf_Header.elf64.e_phoff));
@@ -340,77 +345,92 @@ int ELFPrivate::checkProgramHeaders(void)
 		return 0;
 	}
 
+	// Sanity check: Limit to 1,024 program headers.
+	// Anything past the cap only matters for PT_DYNAMIC VA lookups,
+	// which fail gracefully if the segment isn't in pt_load.
+	if (e_phnum > 1024) {
+		e_phnum = 1024;
+	}
+
 	int ret = file->seek(e_phoff);
 	if (ret != 0) {
 		// Seek error.
 		return ret;
 	}
 
+	// PT_INTERP is read after the scan so the program header
+	// table itself is read sequentially.
+	off64_t interp_offset = 0;
+	unsigned int interp_len = 0;
+
 	// Read all of the program header entries.
-	for (; e_phnum > 0; e_phnum--) {
-		size_t size = file->read(phbuf, phsize);
-		if (size != phsize) {
+	while (e_phnum > 0) {
+		const unsigned int count = std::min(e_phnum, static_cast<unsigned int>(sizeof(phbuf) / sizeof(Elf64_Phdr)));
+		size_t size = file->read(phbuf, count * phsize);
+		if (size != count * phsize) {
 			// Read error.
 			break;
 		}
-
-		const Elf64_Phdr phdr = readProgramHeader(phbuf);
-
-		// Check the type.
-		switch (phdr.p_type) {
-			case PT_INTERP: {
-				// If the file type is ET_DYN, this is a PIE executable.
-				isPie = (elf16_to_cpu(Elf_Header.primary.e_type) == ET_DYN);
-
-				// Sanity check: Interpreter must be 256 characters or less.
-				// NOTE: Interpreter should be NULL-terminated.
-				if (phdr.p_filesz <= 256) {
-					unsigned int len = static_cast<unsigned int>(phdr.p_filesz);
-					char buf[256];
-					const off64_t prevoff = file->tell();
-					size = file->seekAndRead(phdr.p_offset, buf, len);
-					if (size != len) {
-						// Seek and/or read error.
-						return -EIO;
-					}
-					ret = file->seek(prevoff);
-					if (ret != 0) {
-						// Seek error.
-						return ret;
+		e_phnum -= count;
+
+		for (unsigned int i = 0; i < count; i++) {
+			const Elf64_Phdr phdr = readProgramHeader(&phbuf[i * phsize]);
+
+			// Check the type.
+			switch (phdr.p_type) {
+				case PT_INTERP: {
+					// If the file type is ET_DYN, this is a PIE executable.
+					isPie = (elf16_to_cpu(Elf_Header.primary.e_type) == ET_DYN);
+
+					// Sanity check: Interpreter must be 256 characters or less.
+					// NOTE: Interpreter should be NULL-terminated.
+					if (phdr.p_filesz <= 256) {
+						interp_offset = phdr.p_offset;
+						interp_len = static_cast<unsigned int>(phdr.p_filesz);
 					}
 
-					// Remove trailing NULLs.
-					while (len > 0 && buf[len-1] == 0) {
-						len--;
-					}
+					break;
+				}
 
-					if (len > 0) {
-						interpreter.assign(buf, len);
+				case PT_LOAD:
+					pt_load.push_back(phdr);
+					// vaddrs must be sorted
+					assert(pt_load.size() < 2 || pt_load.end()[-2].p_vaddr <= pt_load.end()[-1].p_vaddr);
+					if (pt_load.size() > 1 && unlikely(pt_load.end()[-2].p_vaddr > pt_load.end()[-1].p_vaddr)) {
+						// Not sorted. Remove the last entry.
+						// TODO: Sort it manually?
+						pt_load.resize(pt_load.size()-1);
 					}
-				}
+					break;
 
-				break;
+				case PT_DYNAMIC:
+					// Executable is dynamically linked.
+					// Save the header information for later.
+					pt_dynamic = phdr;
+					break;
+
+				default:
+					break;
 			}
+		}
+	}
 
-			case PT_LOAD:
-				pt_load.push_back(phdr);
-				// vaddrs must be sorted
-				assert(pt_load.size() < 2 || pt_load.end()[-2].p_vaddr <= pt_load.end()[-1].p_vaddr);
-				if (pt_load.size() > 1 && unlikely(pt_load.end()[-2].p_vaddr > pt_load.end()[-1].p_vaddr)) {
-					// Not sorted. Remove the last entry.
-					// TODO: Sort it manually?
-					pt_load.resize(pt_load.size()-1);
-				}
-				break;
+	if (interp_len > 0) {
+		char buf[256];
+		unsigned int len = interp_len;
+		size_t size = file->seekAndRead(interp_offset, buf, len);
+		if (size != len) {
+			// Seek and/or read error.
+			return -EIO;
+		}
 
-			case PT_DYNAMIC:
-				// Executable is dynamically linked.
-				// Save the header information for later.
-				pt_dynamic = phdr;
-				break;
+		// Remove trailing NULLs.
+		while (len > 0 && buf[len-1] == 0) {
+			len--;
+		}
 
-			default:
-				break;
+		if (len > 0) {
+			interpreter.assign(buf, len);
 		}
 	}
 
@@ -475,7 +495,9 @@ int ELFPrivate::checkSectionHeaders(void)
 	off64_t e_shoff;
 	unsigned int e_shnum;
 	unsigned int shsize;
-	uint8_t shbuf[sizeof(Elf64_Shdr)];
+	// Read the section headers in batches instead of one at a time.
+	// Debug-info-laden binaries can have thousands of them.
+	uint8_t shbuf[sizeof(Elf64_Shdr) * 64];
 
 	if (Elf_Header.primary.e_class == ELFCLASS64) {
 		e_shoff = static_cast<off64_t>(elf64_to_cpu(Elf_Header.elf64.e_shoff));
@@ -492,6 +514,11 @@ int ELFPrivate::checkSectionHeaders(void)
 		return 0;
 	}
 
+	// Sanity check: Limit to 4,096 section headers.
+	if (e_shnum > 4096) {
+		e_shnum = 4096;
+	}
+
 	int ret = file->seek(e_shoff);
 	if (ret != 0) {
 		// Seek error.
@@ -500,66 +527,86 @@ int ELFPrivate::checkSectionHeaders(void)
 
 	uint64_t symtab_link = -1, dynsym_link = -1;
 
+	// Note sections are parsed after the scan so the section header
+	// table itself is read sequentially.
+	struct note_section_t {
+		off64_t offset;
+		unsigned int size;
+	};
+	note_section_t noteSections[16];
+	unsigned int noteSectionCount = 0;
+
 	// Read all of the section header entries.
-	for (unsigned int i = 0; i < e_shnum; i++) {
-		size_t size = file->read(shbuf, shsize);
-		if (size != shsize) {
+	unsigned int i = 0;
+	while (i < e_shnum) {
+		const unsigned int count = std::min(e_shnum - i, static_cast<unsigned int>(sizeof(shbuf) / sizeof(Elf64_Shdr)));
+		size_t size = file->read(shbuf, count * shsize);
+		if (size != count * shsize) {
 			// Read error.
 			break;
 		}
 
-		const Elf64_Shdr shdr = readSectionHeader(shbuf);
+		for (unsigned int j = 0; j < count; j++, i++) {
+			const Elf64_Shdr shdr = readSectionHeader(&shbuf[j * shsize]);
 
-		// FIXME: this assumes that STRTABs come after SYMTABs.
-		if (shdr.sh_type == SHT_STRTAB) {
-			if (i == symtab_link) {
-				sht_symtab.strtab_offset = shdr.sh_offset;
-				sht_symtab.strtab_size = shdr.sh_size;
+			// FIXME: this assumes that STRTABs come after SYMTABs.
+			if (shdr.sh_type == SHT_STRTAB) {
+				if (i == symtab_link) {
+					sht_symtab.strtab_offset = shdr.sh_offset;
+					sht_symtab.strtab_size = shdr.sh_size;
+				}
+				if (i == dynsym_link) {
+					sht_dynsym.strtab_offset = shdr.sh_offset;
+					sht_dynsym.strtab_size = shdr.sh_size;
+				}
 			}
-			if (i == dynsym_link) {
-				sht_dynsym.strtab_offset = shdr.sh_offset;
-				sht_dynsym.strtab_size = shdr.sh_size;
+
+			if (shdr.sh_type == SHT_SYMTAB || shdr.sh_type == SHT_DYNSYM) {
+				symtab_info_t &tab = (shdr.sh_type == SHT_SYMTAB ? sht_symtab : sht_dynsym);
+				uint64_t &link = (shdr.sh_type == SHT_SYMTAB ? symtab_link : dynsym_link);
+				tab.offset = shdr.sh_offset;
+				tab.size = shdr.sh_size;
+				tab.entsize = shdr.sh_entsize;
+				link = shdr.sh_link;
+				continue;
 			}
-		}
 
-		if (shdr.sh_type == SHT_SYMTAB || shdr.sh_type == SHT_DYNSYM) {
-			symtab_info_t &tab = (shdr.sh_type == SHT_SYMTAB ? sht_symtab : sht_dynsym);
-			uint64_t &link = (shdr.sh_type == SHT_SYMTAB ? symtab_link : dynsym_link);
-			tab.offset = shdr.sh_offset;
-			tab.size = shdr.sh_size;
-			tab.entsize = shdr.sh_entsize;
-			link = shdr.sh_link;
-			continue;
-		}
+			// Only STRTABs, SYMTABs, DYNSYMs and NOTEs are supported right now.
+			if (shdr.sh_type != SHT_NOTE)
+				continue;
 
-		// Only STRTABs, SYMTABs, DYNSYMs and NOTEs are supported right now.
-		if (shdr.sh_type != SHT_NOTE)
-			continue;
+			// Sanity check: Note must be 256 bytes or less,
+			// and must be greater than sizeof(Elf32_Nhdr).
+			// NOTE: Elf32_Nhdr and Elf64_Nhdr are identical.
+			if (shdr.sh_size < sizeof(Elf32_Nhdr) || shdr.sh_size > 256) {
+				// Out of range. Ignore it.
+				continue;
+			}
 
-		// Sanity check: Note must be 256 bytes or less,
-		// and must be greater than sizeof(Elf32_Nhdr).
-		// NOTE: Elf32_Nhdr and Elf64_Nhdr are identical.
-		if (shdr.sh_size < sizeof(Elf32_Nhdr) || shdr.sh_size > 256) {
-			// Out of range. Ignore it.
-			continue;
+			// Sanity check: Limit to 16 note sections.
+			if (noteSectionCount >= ARRAY_SIZE(noteSections)) {
+				// Too many note sections. Ignore it.
+				continue;
+			}
+
+			// Save the note address and size for later.
+			noteSections[noteSectionCount].offset = shdr.sh_offset;
+			noteSections[noteSectionCount].size = static_cast<unsigned int>(shdr.sh_size);
+			noteSectionCount++;
 		}
+	}
 
-		// Get the note address and size.
-		const off64_t int_addr = shdr.sh_offset;
-		const unsigned int int_size = static_cast<unsigned int>(shdr.sh_size);
+	// Parse the note sections.
+	for (unsigned int n = 0; n < noteSectionCount; n++) {
+		const off64_t int_addr = noteSections[n].offset;
+		const unsigned int int_size = noteSections[n].size;
 
 		uint8_t buf[256];
-		const off64_t prevoff = file->tell();
-		size = file->seekAndRead(int_addr, buf, int_size);
+		size_t size = file->seekAndRead(int_addr, buf, int_size);
 		if (size != int_size) {
 			// Seek and/or read error.
 			return -EIO;
 		}
-		ret = file->seek(prevoff);
-		if (ret != 0) {
-			// Seek error.
-			return ret;
-		}
 
 		// Parse the note.
 		Elf32_Nhdr *const nhdr = reinterpret_cast<Elf32_Nhdr*>(buf);
@@ -1077,7 +1124,7 @@ int ELFPrivate::addSymbolFields(span<const char> dynsym_strtab)
 			else if (sym.st_shndx == SHN_COMMON)
 				row.emplace_back(elf_sym_common);
 			else
-				row.emplace_back(rp_sprintf("%d", sym.st_shndx));
+				row.emplace_back(fmt_dec(sym.st_shndx));
 			row.emplace_back(rp_sprintf("0x%08" PRIX64, sym.st_value));
 			row.emplace_back(rp_sprintf("0x%08" PRIX64, sym.st_size));
 			vv_data->emplace_back(std::move(row));
@@ -1278,9 +1325,10 @@ ELF::ELF(const IRpFilePtr &file)
 		}
 	} else {
 		// Standard ELF executable.
-		// Check program and section headers.
+		// Check program headers. (PT_INTERP determines PIE vs. shared library.)
+		// NOTE: Section headers are only needed for fields (notes, symbol
+		// tables), so they're checked on demand by loadFieldData().
 		d->checkProgramHeaders();
-		d->checkSectionHeaders();
 
 		// Determine the file and MIME types.
 		// NOTE: All of these MIME types are present on FreeDesktop.org,
@@ -1472,6 +1520,13 @@ int ELF::loadFieldData(void)
 		return -EIO;
 	}
 
+	// Check the section headers if we haven't already.
+	// (OS version, build ID, and symbol tables)
+	// NOTE: Not for Wii U RPX/RPL, which has custom section types.
+	if (!d->isWiiU) {
+		d->checkSectionHeaders();
+	}
+
 	// Primary ELF header.
 	const Elf_PrimaryEhdr *const primary = &d->Elf_Header.primary;
 	d->fields.reserve(12);	// Maximum of 12 fields. [3 for machine subtype] [TODO verify this]
@@ -2098,7 +2153,7 @@ int ELF::loadFieldData(void)
 		if (primary->e_class == ELFCLASS64) {
 			entry_point = rp_sprintf("0x%08" PRIX64, d->Elf_Header.elf64.e_entry);
 		} else {
-			entry_point = rp_sprintf("0x%08X", d->Elf_Header.elf32.e_entry);
+			entry_point = fmt_hex_0x<8>(d->Elf_Header.elf32.e_entry);
 		}
 		if (d->isPie) {
 			// tr: Entry point, then "Position-Independent".
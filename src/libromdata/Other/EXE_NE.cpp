@@ -682,7 +682,7 @@ int EXEPrivate::addFields_NE_Entry(void)
 			flags.resize(flags.size()-1);
 		}
 
-		row.emplace_back(rp_sprintf("%d", ent.ordinal));
+		row.emplace_back(fmt_dec(ent.ordinal));
 		if (ent.has_name) {
 			row.emplace_back(ent.name.data(), ent.name.size());
 		} else {
@@ -836,7 +836,7 @@ int EXEPrivate::addFields_NE_Import(void)
 		row.reserve(3);
 		const char *const name = EXENEEntries::lookup_ordinal(modname.c_str(), imp.second);
 		row.emplace_back(name ? name : s_no_name);
-		row.emplace_back(rp_sprintf("%u", imp.second));
+		row.emplace_back(fmt_dec(imp.second));
 		row.emplace_back(std::move(modname));
 		vv_data->emplace_back(std::move(row));
 	}
@@ -912,17 +912,17 @@ int EXEPrivate::addFields_PE_Export(void)
 		auto &row = vv_data->back();
 		row.reserve(5);
 		row.emplace_back(ent.name);
-		row.emplace_back(rp_sprintf("%d", ent.ordinal));
+		row.emplace_back(fmt_dec(ent.ordinal));
 		row.emplace_back(ent.hint != -1
-			? rp_sprintf("%d", ent.hint)
+			? fmt_dec(ent.hint)
 			: C_("EXE|Exports", "None"));
 		if (ent.forwarder.size() != 0) {
 			row.emplace_back(ent.forwarder);
 			row.emplace_back();
 		} else {
-			row.emplace_back(rp_sprintf("0x%08X", ent.vaddr));
+			row.emplace_back(fmt_hex_0x<8>(ent.vaddr));
 			if (ent.paddr)
-				row.emplace_back(rp_sprintf("0x%08X", ent.paddr));
+				row.emplace_back(fmt_hex_0x<8>(ent.paddr));
 			else
 				row.emplace_back(); // it's probably in the bss section
 		}
@@ -1117,7 +1117,7 @@ int EXEPrivate::addFields_PE_Import(void)
 			auto ent = &dll_hint_data[it.value - dll_hint_base];
 			const uint16_t hint = le16_to_cpu(*reinterpret_cast<const uint16_t*>(ent));
 			row.emplace_back(ent+2);
-			row.emplace_back(rp_sprintf("%u", hint));
+			row.emplace_back(fmt_dec(hint));
 		}
 		row.emplace_back(*(it.dllname));
 	}
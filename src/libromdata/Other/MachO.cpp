@@ -480,10 +480,10 @@ int MachO::loadFieldData(void)
 		// TODO: Change addTab() behavior to set the first tab's name?
 		if (i == 0) {
 			d->fields.setTabName(i, s_cpu ? s_cpu :
-				rp_sprintf("0x%08X", machHeader->cputype).c_str());
+				fmt_hex_0x<8>(machHeader->cputype).c_str());
 		} else {
 			d->fields.addTab(s_cpu ? s_cpu :
-				rp_sprintf("0x%08X", machHeader->cputype).c_str());
+				fmt_hex_0x<8>(machHeader->cputype).c_str());
 		}
 
 		// Executable format.
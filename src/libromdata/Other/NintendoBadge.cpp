@@ -752,9 +752,7 @@ int NintendoBadge::loadFieldData(void)
 			} else {
 				// Title ID is present.
 				d->fields.addField_string(launch_title_id_title,
-					rp_sprintf("%08X-%08X",
-						le32_to_cpu(prbs->title_id.hi),
-						le32_to_cpu(prbs->title_id.lo)));
+					fmt_hex<8>(le32_to_cpu(prbs->title_id.hi)) + '-' + fmt_hex<8>(le32_to_cpu(prbs->title_id.lo)));
 
 				// Check if this is a known system title.
 				const char *region = nullptr;
@@ -391,6 +391,35 @@ int RpTextureWrapper::loadInternalMipmap(int mipmapLevel, LibRpTexture::rp_image
 	return ((bool)pImage ? 0 : -EIO);
 }
 
+/**
+ * Load an internal image, with a size hint.
+ * Called by RomData::image() if a size hint was specified.
+ * @param imageType	[in] Image type to load.
+ * @param reqSize	[in] Requested image size. (single dimension; 0 for largest)
+ * @param pImage	[out] Reference to rp_image_const_ptr to store the image in.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int RpTextureWrapper::loadInternalImageForSize(ImageType imageType, int reqSize, LibRpTexture::rp_image_const_ptr &pImage)
+{
+	if (imageType != IMG_INT_IMAGE || reqSize <= 0) {
+		// Size hint is only applicable to IMG_INT_IMAGE.
+		return loadInternalImage(imageType, pImage);
+	}
+
+	RP_D(RpTextureWrapper);
+	if (!d->isValid || !d->texture) {
+		// No texture is loaded...
+		pImage.reset();
+		return -ENOENT;
+	}
+
+	// Decode the smallest mipmap that's still >= the requested size.
+	// For a thumbnail of e.g. a 4K texture, this is significantly
+	// faster than decoding the full-size image and scaling it down.
+	pImage = d->texture->loadClosestMip(reqSize);
+	return ((bool)pImage ? 0 : -EIO);
+}
+
 /** Pixel format **/
 
 /**
@@ -15,12 +15,26 @@
 
 // librpbase, librpfile
 #include "librpfile/DualFile.hpp"
+#include "librpfile/MmapFile.hpp"
+#include "librpfile/OpenPrefixBatch.hpp"
 #include "librpfile/RelatedFile.hpp"
 using namespace LibRpBase;
 using namespace LibRpFile;
 
 // librpthreads
-#include "librpthreads/pthread_once.h"
+#include "librpthreads/rp_once.h"
+#include "librpthreads/SharedMutex.hpp"
+
+// Tracing instrumentation
+#include "rp_trace.h"
+
+// C includes (C++ namespace)
+#include <cstdlib>	// for getenv()
+
+// C++ STL classes (for createBatch and the weak RomData cache)
+#include <atomic>
+#include <map>
+#include <thread>
 
 // librptexture
 #include "librptexture/FileFormatFactory.hpp"
@@ -177,13 +191,22 @@ static RomDataPtr RomData_ctor(const IRpFilePtr &file)
 	 sys::romDataInfo, \
 	 (attrs), (address), (size)}
 
+// Magic-number index for romDataFns_magic[].
+// Maps 32-bit magic (host-endian, from BE) to entries in romDataFns_magic[],
+// so create() only probes classes whose magic number actually matches
+// instead of scanning the whole table for every file.
+std::unordered_multimap<uint32_t, const RomDataFns*> map_magicIdx;
+// Distinct header addresses used by romDataFns_magic[] entries.
+vector<uint32_t> vec_magicAddrs;
+rp_once_t once_magicIdx = RP_ONCE_INIT;
+
 #ifdef ROMDATAFACTORY_USE_FILE_EXTENSIONS
 vector<ExtInfo> vec_exts;
-pthread_once_t once_exts = PTHREAD_ONCE_INIT;
+rp_once_t once_exts = RP_ONCE_INIT;
 #endif /* ROMDATAFACTORY_USE_FILE_EXTENSIONS */
 #ifdef ROMDATAFACTORY_USE_MIME_TYPES
 vector<const char*> vec_mimeTypes;
-pthread_once_t once_mimeTypes = PTHREAD_ONCE_INIT;
+rp_once_t once_mimeTypes = RP_ONCE_INIT;
 #endif /* ROMDATAFACTORY_USE_MIME_TYPES */
 
 #define ATTR_NONE		RomDataFactory::RDA_NONE
@@ -192,6 +215,25 @@ pthread_once_t once_mimeTypes = PTHREAD_ONCE_INIT;
 #define ATTR_HAS_METADATA	RomDataFactory::RDA_HAS_METADATA
 #define ATTR_CHECK_ISO		RomDataFactory::RDA_CHECK_ISO
 #define ATTR_SUPPORTS_DEVICES	RomDataFactory::RDA_SUPPORTS_DEVICES
+#define ATTR_INTENT_SEQUENTIAL	RomDataFactory::RDA_INTENT_SEQUENTIAL
+#define ATTR_INTENT_METADATA_ONLY	RomDataFactory::RDA_INTENT_METADATA_ONLY
+
+/**
+ * Set the access intent on a file based on the matched class's attributes.
+ *
+ * Called when a RomData subclass has matched: the parser will keep
+ * reading the file, usually in small scattered chunks, so adjust the
+ * kernel's readahead to the expected pattern.
+ *
+ * @param file	[in] IRpFile
+ * @param attrs	[in] Matched class's RomDataAttr bitfield.
+ */
+static inline void applyAccessIntent(const IRpFilePtr &file, unsigned int attrs)
+{
+	file->setAccessIntent((attrs & ATTR_INTENT_SEQUENTIAL)
+		? IRpFile::AccessIntent::Sequential
+		: IRpFile::AccessIntent::Random);
+}
 
 /**
  * RomData subclasses that use a header at 0 and
@@ -201,7 +243,7 @@ pthread_once_t once_mimeTypes = PTHREAD_ONCE_INIT;
  *
  * TODO: Add support for multiple magic numbers per class.
  */
-static const RomDataFns romDataFns_magic[] = {
+static constexpr RomDataFns romDataFns_magic[] = {
 	// Consoles
 	GetRomDataFns_addr(Atari7800, ATTR_HAS_METADATA, 4, 'RI78'),	// "ATARI7800"
 	GetRomDataFns_addr(PlayStationEXE, 0, 0, 'PS-X'),
@@ -212,8 +254,8 @@ static const RomDataFns romDataFns_magic[] = {
 	GetRomDataFns_addr(WiiWIBN, ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA, 0, 'WIBN'),
 	GetRomDataFns_addr(Xbox_XBE, ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA, 0, 'XBEH'),
 	GetRomDataFns_addr(Xbox360_XDBF, ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA, 0, 'XDBF'),
-	GetRomDataFns_addr(Xbox360_XEX, ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA, 0, 'XEX1'),
-	GetRomDataFns_addr(Xbox360_XEX, ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA, 0, 'XEX2'),
+	GetRomDataFns_addr(Xbox360_XEX, ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA | ATTR_INTENT_SEQUENTIAL, 0, 'XEX1'),
+	GetRomDataFns_addr(Xbox360_XEX, ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA | ATTR_INTENT_SEQUENTIAL, 0, 'XEX2'),
 
 	// Handhelds
 	GetRomDataFns_addr(DMG, ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA, 0x104, 0xCEED6666),
@@ -262,7 +304,7 @@ static const RomDataFns romDataFns_magic[] = {
  * Headers with addresses other than 0 should be
  * placed at the end of this array.
  */
-static const RomDataFns romDataFns_header[] = {
+static constexpr RomDataFns romDataFns_header[] = {
 	// Consoles
 	GetRomDataFns(ColecoVision, ATTR_HAS_METADATA),
 	GetRomDataFns(Dreamcast, ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA | ATTR_SUPPORTS_DEVICES),
@@ -341,7 +383,7 @@ static const RomDataFns romDataFns_header[] = {
 };
 
 // RomData subclasses that use a footer.
-static const RomDataFns romDataFns_footer[] = {
+static constexpr RomDataFns romDataFns_footer[] = {
 	GetRomDataFns(VirtualBoy, ATTR_HAS_METADATA),
 	GetRomDataFns(WonderSwan, ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA),
 	{nullptr, nullptr, nullptr, ATTR_NONE, 0, 0}
@@ -350,13 +392,41 @@ static const RomDataFns romDataFns_footer[] = {
 // Table of pointers to tables.
 // This reduces duplication by only requiring a single loop
 // in each function.
-static const RomDataFns *const romDataFns_tbl[] = {
+static constexpr const RomDataFns *romDataFns_tbl[] = {
 	romDataFns_magic,
 	romDataFns_header,
 	romDataFns_footer,
 	nullptr
 };
 
+/**
+ * Initialize the magic-number index for romDataFns_magic[].
+ *
+ * Internal function; must be called using rp_once().
+ */
+static void init_magicIdx(void)
+{
+	static constexpr size_t reserve_size = ARRAY_SIZE(romDataFns_magic) - 1;
+	map_magicIdx.reserve(reserve_size);
+	vec_magicAddrs.reserve(8);
+
+	for (const RomDataFns *fns = &romDataFns_magic[0];
+	     fns->romDataInfo != nullptr; fns++)
+	{
+		// NOTE: RomDataFns::size contains the magic number
+		// for entries in romDataFns_magic[].
+		map_magicIdx.emplace(fns->size, fns);
+
+		// Save the header address if we haven't seen it yet.
+		// The address list stays in table order, which preserves
+		// the original probe priority within a single address.
+		auto iter = std::find(vec_magicAddrs.begin(), vec_magicAddrs.end(), fns->address);
+		if (iter == vec_magicAddrs.end()) {
+			vec_magicAddrs.push_back(fns->address);
+		}
+	}
+}
+
 /** IDiscReader / SparseDiscReader check arrays and functions **/
 
 typedef int (*pfnIsDiscSupported)(const uint8_t *pHeader, size_t szHeader);
@@ -389,7 +459,7 @@ static IDiscReaderPtr IDiscReader_ctor(const IRpFilePtr &file)
 	 magic}
 
 #define P99_PROTECT(...) __VA_ARGS__	/* Reference: https://stackoverflow.com/a/5504336 */
-static const IDiscReaderFns iDiscReaderFns[] = {
+static constexpr IDiscReaderFns iDiscReaderFns[] = {
 	GetIDiscReaderFns(CisoGcnReader,	P99_PROTECT({'CISO'})),
 	// NOTE: MSVC doesn't like putting #ifdef within the P99_PROTECT macro.
 	// TODO: Disable ZISO and JISO if LZ4 and LZO aren't available?
@@ -617,7 +687,7 @@ RomDataPtr checkISO(const IRpFilePtr &file)
 #define GetRomDataFns_ISO(sys) \
 	{sys::isRomSupported_static, \
 	 RomData_ctor<sys>}
-	static const RomDataFns_ISO romDataFns_ISO[] = {
+	static constexpr RomDataFns_ISO romDataFns_ISO[] = {
 		GetRomDataFns_ISO(PlayStationDisc),
 		GetRomDataFns_ISO(PSP),
 		GetRomDataFns_ISO(XboxDisc),
@@ -690,6 +760,15 @@ RomDataPtr checkISO(const IRpFilePtr &file)
  */
 RomDataPtr create(const IRpFilePtr &file, unsigned int attrs)
 {
+	RP_TRACE_SCOPE("RomDataFactory::create");
+
+	// Caller intent hints don't participate in subclass attribute
+	// matching, since no subclass declares them. Metadata-only
+	// callers won't do full extraction, so sequential readahead
+	// promotion is skipped for them.
+	const bool metadataOnly = !!(attrs & ATTR_INTENT_METADATA_ONLY);
+	attrs &= ~ATTR_INTENT_METADATA_ONLY;
+
 	RomData::DetectInfo info;
 
 	// Get the file size.
@@ -762,27 +841,48 @@ RomDataPtr create(const IRpFilePtr &file, unsigned int attrs)
 
 	// Check RomData subclasses that take a header at 0
 	// and definitely have a 32-bit magic number in the header.
-	const Private::RomDataFns *fns = &Private::romDataFns_magic[0];
-	for (; fns->romDataInfo != nullptr; fns++) {
-		if ((fns->attrs & attrs) != attrs) {
-			// This RomData subclass doesn't have the
-			// required attributes.
+	// Use the magic-number index to find candidate classes instead of
+	// scanning the whole table. Candidates are probed in table order
+	// to preserve the original probe priority.
+	rp_once(&Private::once_magicIdx, Private::init_magicIdx);
+	vector<const Private::RomDataFns*> vec_magicMatches;
+	for (const uint32_t address : Private::vec_magicAddrs) {
+		// TODO: Verify alignment restrictions.
+		assert(address % 4 == 0);
+		assert(address + sizeof(uint32_t) <= sizeof(header.u32));
+		if (address + sizeof(uint32_t) > info.header.size) {
+			// Short read; can't check this address.
 			continue;
 		}
 
-		// Check the magic number.
-		// TODO: Verify alignment restrictions.
-		assert(fns->address % 4 == 0);
-		assert(fns->address + sizeof(uint32_t) <= sizeof(header.u32));
-		const uint32_t magic = be32_to_cpu(header.u32[fns->address/4]);
-		if (magic == fns->size) {
-			// Found a matching magic number.
-			if (fns->isRomSupported(&info) >= 0) {
-				RomDataPtr romData = fns->newRomData(reader);
-				if (romData->isValid()) {
-					// RomData subclass obtained.
-					return romData;
-				}
+		const uint32_t magic = be32_to_cpu(header.u32[address/4]);
+		auto range = Private::map_magicIdx.equal_range(magic);
+		for (auto iter = range.first; iter != range.second; ++iter) {
+			const Private::RomDataFns *const fns = iter->second;
+			if (fns->address != address) {
+				// Same magic number, but at a different address.
+				continue;
+			}
+			if ((fns->attrs & attrs) != attrs) {
+				// This RomData subclass doesn't have the
+				// required attributes.
+				continue;
+			}
+			vec_magicMatches.push_back(fns);
+		}
+	}
+	// Sort candidates by table position. (entries point into romDataFns_magic[])
+	std::sort(vec_magicMatches.begin(), vec_magicMatches.end());
+	for (const Private::RomDataFns *fns : vec_magicMatches) {
+		// Found a matching magic number.
+		if (fns->isRomSupported(&info) >= 0) {
+			RomDataPtr romData = fns->newRomData(reader);
+			if (romData->isValid()) {
+				// RomData subclass obtained.
+				Private::applyAccessIntent(file, metadataOnly
+				? (fns->attrs & ~ATTR_INTENT_SEQUENTIAL)
+				: fns->attrs);
+				return romData;
 			}
 		}
 	}
@@ -793,13 +893,14 @@ RomDataPtr create(const IRpFilePtr &file, unsigned int attrs)
 		RomDataPtr romData = std::make_shared<RpTextureWrapper>(reader);
 		if (romData->isValid()) {
 			// RomData subclass obtained.
+			Private::applyAccessIntent(file, 0);
 			return romData;
 		}
 	}
 
 	// Check other RomData subclasses that take a header,
 	// but don't have a simple 32-bit magic number check.
-	fns = &Private::romDataFns_header[0];
+	const Private::RomDataFns *fns = &Private::romDataFns_header[0];
 	bool checked_exts = false;
 	for (; fns->romDataInfo != nullptr; fns++) {
 		if ((fns->attrs & attrs) != attrs) {
@@ -887,6 +988,9 @@ RomDataPtr create(const IRpFilePtr &file, unsigned int attrs)
 
 			if (romData && romData->isValid()) {
 				// RomData subclass obtained.
+				Private::applyAccessIntent(file, metadataOnly
+				? (fns->attrs & ~ATTR_INTENT_SEQUENTIAL)
+				: fns->attrs);
 				return romData;
 			}
 		}
@@ -896,6 +1000,7 @@ RomDataPtr create(const IRpFilePtr &file, unsigned int attrs)
 	if (info.szFile > (1LL << 30)) {
 		// No subclasses that expect footers support
 		// files larger than 1 GB.
+		file->setAccessIntent(IRpFile::AccessIntent::HeaderOnly);
 		return {};
 	}
 
@@ -953,6 +1058,9 @@ RomDataPtr create(const IRpFilePtr &file, unsigned int attrs)
 			RomDataPtr romData = fns->newRomData(reader);
 			if (romData->isValid()) {
 				// RomData subclass obtained.
+				Private::applyAccessIntent(file, metadataOnly
+				? (fns->attrs & ~ATTR_INTENT_SEQUENTIAL)
+				: fns->attrs);
 				return romData;
 			}
 		}
@@ -964,14 +1072,168 @@ RomDataPtr create(const IRpFilePtr &file, unsigned int attrs)
 		RomDataPtr romData = Private::checkISO(reader);
 		if (romData && romData->isValid()) {
 			// RomData subclass obtained.
+			Private::applyAccessIntent(file, 0);
 			return romData;
 		}
 	}
 
-	// Not supported.
+	// Not supported. No further reads are expected, so let the
+	// kernel drop whatever probing pulled into the page cache.
+	// (Keeps bulk scans from evicting more useful pages.)
+	file->setAccessIntent(IRpFile::AccessIntent::HeaderOnly);
 	return {};
 }
 
+namespace Private {
+
+/** Process-wide weak RomData cache **/
+
+// Multiple plugins loaded into the same process (properties dialog,
+// overlay icon plugin, metadata extractor) often probe the same file
+// within milliseconds of each other. As long as one consumer is still
+// holding the parsed instance, let the others share it instead of
+// re-running detection and construction. Entries are weak references,
+// so the cache never extends an instance's lifetime.
+
+// NOTE: The cache is opt-in (RP_ROMDATA_CACHE=1) and disabled by
+// default. RomData and RomFields have no internal synchronization;
+// a shared instance also shares the underlying IRpFile's seek
+// position, and one consumer calling close() invalidates the file
+// for the others. Sharing is only safe for single-threaded consumers
+// that don't close() their instances, so it has to be requested
+// explicitly. TODO: Re-enable by default once RomData instances are
+// immutable after construction.
+
+/**
+ * Is the weak RomData cache enabled?
+ * Checks RP_ROMDATA_CACHE on first call.
+ * @return True if enabled; false if not.
+ */
+static bool isWeakCacheEnabled(void)
+{
+	static const bool enabled = []() {
+		// RP_ROMDATA_CACHE=1 enables the cache.
+		const char *const env = getenv("RP_ROMDATA_CACHE");
+		return (env && env[0] == '1' && env[1] == '\0');
+	}();
+	return enabled;
+}
+
+template<typename CharType>
+class WeakRomDataCache
+{
+public:
+	struct Entry {
+		std::weak_ptr<RomData> romData;
+		off64_t fileSize;	// File size when cached. (0 for directories)
+		time_t mtime;		// Modification time when cached.
+		unsigned int attrs;	// RomDataAttr bitfield used for creation.
+	};
+
+	/**
+	 * Look up a previously-created RomData instance.
+	 * @param filename	[in] ROM filename
+	 * @param fileSize	[in] Current file size (0 for directories)
+	 * @param mtime		[in] Current modification time
+	 * @param attrs		[in] RomDataAttr bitfield
+	 * @return RomData instance, or nullptr if not cached or stale.
+	 */
+	RomDataPtr lookup(const std::basic_string<CharType> &filename, off64_t fileSize, time_t mtime, unsigned int attrs)
+	{
+		// Fast path: Check under a shared lock so concurrent
+		// lookups (e.g. Explorer's thumbnail threads) don't
+		// serialize on a cache hit.
+		{
+			LibRpThreads::ReadLocker readLocker(m_mutex);
+			auto iter = m_map.find(filename);
+			if (iter == m_map.end()) {
+				// Not cached.
+				return {};
+			}
+
+			const Entry &entry = iter->second;
+			if (entry.fileSize == fileSize && entry.mtime == mtime && entry.attrs == attrs) {
+				RomDataPtr romData = entry.romData.lock();
+				if (romData && (fileSize <= 0 || romData->isOpen())) {
+					// Cache hit.
+					return romData;
+				}
+			}
+		}
+
+		// The entry is stale: the file has changed, the attribute
+		// requirements are different, all consumers have released
+		// the instance, or a consumer has close()d the underlying
+		// file. (A close()d instance's parsed fields are still
+		// valid for that consumer, but a new consumer may need to
+		// read the file, e.g. for thumbnail extraction. Directory-
+		// based instances have fileSize == 0 and are not file-backed,
+		// so they're always shareable.)
+		// Re-check under the exclusive lock and drop the entry.
+		LibRpThreads::WriteLocker writeLocker(m_mutex);
+		auto iter = m_map.find(filename);
+		if (iter == m_map.end()) {
+			// Another thread already dropped it.
+			return {};
+		}
+
+		const Entry &entry = iter->second;
+		if (entry.fileSize == fileSize && entry.mtime == mtime && entry.attrs == attrs) {
+			RomDataPtr romData = entry.romData.lock();
+			if (romData && (fileSize <= 0 || romData->isOpen())) {
+				// Another thread stored a fresh instance in between.
+				return romData;
+			}
+		}
+
+		m_map.erase(iter);
+		return {};
+	}
+
+	/**
+	 * Store a newly-created RomData instance.
+	 * @param filename	[in] ROM filename
+	 * @param fileSize	[in] File size (0 for directories)
+	 * @param mtime		[in] Modification time
+	 * @param attrs		[in] RomDataAttr bitfield
+	 * @param romData	[in] RomData instance
+	 */
+	void store(const std::basic_string<CharType> &filename, off64_t fileSize, time_t mtime, unsigned int attrs, const RomDataPtr &romData)
+	{
+		LibRpThreads::WriteLocker writeLocker(m_mutex);
+
+		// Drop expired entries so the map doesn't grow without
+		// bound. (Live entries are bounded by the number of
+		// RomData instances consumers are actually holding.)
+		for (auto iter = m_map.begin(); iter != m_map.end(); ) {
+			if (iter->second.romData.expired()) {
+				iter = m_map.erase(iter);
+			} else {
+				++iter;
+			}
+		}
+
+		m_map[filename] = Entry{romData, fileSize, mtime, attrs};
+	}
+
+private:
+	LibRpThreads::SharedMutex m_mutex;
+	std::map<std::basic_string<CharType>, Entry> m_map;
+};
+
+/**
+ * Get the weak RomData cache for the specified character type.
+ * @return WeakRomDataCache instance.
+ */
+template<typename CharType>
+WeakRomDataCache<CharType> &weakRomDataCache(void)
+{
+	static WeakRomDataCache<CharType> cache;
+	return cache;
+}
+
+} // namespace Private
+
 /**
  * Create a RomData subclass for the specified ROM file.
  *
@@ -995,15 +1257,66 @@ template<typename CharType>
 static RomDataPtr T_create(const CharType *filename, unsigned int attrs)
 {
 	RomDataPtr romData;
+	const bool isDirectory = FileSystem::is_directory(filename);
+
+	// Check the process-wide weak cache first. (opt-in; see above)
+	// If another consumer in this process is still holding an
+	// instance for this file, share it instead of re-parsing.
+	off64_t cacheFileSize = 0;
+	time_t cacheMtime = 0;
+	bool canCache = Private::isWeakCacheEnabled();
+	if (canCache) {
+		if (likely(!isDirectory)) {
+			canCache = (FileSystem::get_file_size_and_mtime(filename, &cacheFileSize, &cacheMtime) == 0);
+		} else {
+			// Directory. (e.g. WiiUPackage)
+			// Key on the directory's modification time only.
+			canCache = (FileSystem::get_mtime(filename, &cacheMtime) == 0);
+		}
+	}
+	std::basic_string<CharType> s_filename;
+	if (canCache) {
+		s_filename = filename;
+		romData = Private::weakRomDataCache<CharType>().lookup(s_filename, cacheFileSize, cacheMtime, attrs);
+		if (romData) {
+			// Found a shared instance.
+			return romData;
+		}
+	}
 
 	// Check if this is a file or a directory.
 	// If it's a file, we'll create an RpFile and then
 	// call create(IRpFile*,unsigned int).
-	if (likely(!FileSystem::is_directory(filename))) {
+	if (likely(!isDirectory)) {
 		// Not a directory.
-		shared_ptr<RpFile> file = std::make_shared<RpFile>(filename, RpFile::FM_OPEN_READ_GZ);
-		if (file->isOpen()) {
-			romData = create(file, attrs);
+		// Try to memory-map the file first: parsers do many small
+		// seek+read pairs, which become pointer arithmetic over a
+		// mapping instead of syscalls.
+		shared_ptr<MmapFile> mmapFile = std::make_shared<MmapFile>(filename);
+		bool useMmap = mmapFile->isOpen();
+		if (useMmap) {
+			// Gzipped files need RpFile's transparent decompression.
+			uint8_t gzmagic[2];
+			if (mmapFile->read(gzmagic, sizeof(gzmagic)) == sizeof(gzmagic) &&
+			    gzmagic[0] == 0x1F && gzmagic[1] == 0x8B)
+			{
+				useMmap = false;
+			}
+			mmapFile->rewind();
+		}
+
+		if (useMmap) {
+			romData = create(mmapFile, attrs);
+		} else {
+			// Couldn't map the file. (pipe, device, or gzipped file)
+			// Fall back to the stdio-backed RpFile.
+			// Probing only does a few small reads at scattered offsets,
+			// so suppress stdio buffering and kernel readahead.
+			shared_ptr<RpFile> file = std::make_shared<RpFile>(filename,
+				static_cast<RpFile::FileMode>(RpFile::FM_OPEN_READ_GZ | RpFile::FM_HINT_PROBE));
+			if (file->isOpen()) {
+				romData = create(file, attrs);
+			}
 		}
 	} else {
 		// This is a directory. We currently only have one
@@ -1018,6 +1331,12 @@ static RomDataPtr T_create(const CharType *filename, unsigned int attrs)
 		}
 	}
 
+	if (canCache && romData) {
+		// Store the instance in the weak cache for
+		// other consumers in this process.
+		Private::weakRomDataCache<CharType>().store(s_filename, cacheFileSize, cacheMtime, attrs, romData);
+	}
+
 	return romData;
 }
 
@@ -1045,6 +1364,82 @@ RomDataPtr create(const char *filename, unsigned int attrs)
 	return T_create(filename, attrs);
 }
 
+/**
+ * Create RomData subclasses for multiple ROM files at once.
+ *
+ * Files are probed in parallel using an internal thread pool,
+ * which amortizes factory and library init costs over the batch.
+ * The returned vector matches the order of the input filenames;
+ * entries are nullptr for unsupported files.
+ *
+ * @param filenames ROM filenames (UTF-8)
+ * @param attrs RomDataAttr bitfield. If set, RomData subclass must have the specified attributes.
+ * @param maxThreads Maximum number of threads. (0 for number of CPU cores)
+ * @return RomData subclasses. (nullptr for unsupported files)
+ */
+std::vector<RomDataPtr> createBatch(const std::vector<string> &filenames, unsigned int attrs, unsigned int maxThreads)
+{
+	std::vector<RomDataPtr> ret(filenames.size());
+	if (filenames.empty()) {
+		return ret;
+	}
+
+	unsigned int threadCount = maxThreads;
+	if (threadCount == 0) {
+		threadCount = std::thread::hardware_concurrency();
+		if (threadCount == 0) {
+			// Unable to determine the CPU core count.
+			threadCount = 1;
+		}
+	}
+	if (static_cast<size_t>(threadCount) > filenames.size()) {
+		threadCount = static_cast<unsigned int>(filenames.size());
+	}
+
+	// Warm the cache with an asynchronous open+read pass covering each
+	// file's header area. This keeps dozens of header probes in flight
+	// at once, so a cold-cache scan is bandwidth-bound instead of
+	// latency-bound; the probes below then read from the warmed cache.
+	if (filenames.size() > 1) {
+		openPrefixBatch(filenames, 4096U+256U, nullptr);
+	}
+
+	if (threadCount == 1) {
+		// Single-threaded: Probe the files directly.
+		for (size_t i = 0; i < filenames.size(); i++) {
+			ret[i] = create(filenames[i].c_str(), attrs);
+		}
+		return ret;
+	}
+
+	// Worker threads pull the next un-probed file using a shared
+	// atomic index, so fast files don't leave threads idle while
+	// a slow file is being probed. (Each create() call reads the
+	// header into a per-call stack buffer, so workers don't share
+	// any mutable probing state.)
+	std::atomic<size_t> nextIdx(0);
+	auto workerFn = [&filenames, &ret, &nextIdx, attrs]() {
+		while (true) {
+			const size_t i = nextIdx.fetch_add(1);
+			if (i >= filenames.size()) {
+				break;
+			}
+			ret[i] = create(filenames[i].c_str(), attrs);
+		}
+	};
+
+	vector<std::thread> workers;
+	workers.reserve(threadCount);
+	for (unsigned int i = 0; i < threadCount; i++) {
+		workers.emplace_back(workerFn);
+	}
+	for (std::thread &worker : workers) {
+		worker.join();
+	}
+
+	return ret;
+}
+
 #ifdef _WIN32
 /**
  * Create a RomData subclass for the specified ROM file.
@@ -1078,30 +1473,23 @@ namespace Private {
  * Initialize the vector of supported file extensions.
  * Used for Win32 COM registration.
  *
- * Internal function; must be called using pthread_once().
+ * Internal function; must be called using rp_once().
  *
  * NOTE: The return value is a struct that includes a flag
  * indicating if the file type handler supports thumbnails.
  */
 void init_supportedFileExtensions(void)
 {
-	// In order to handle multiple RomData subclasses
-	// that support the same extensions, we're using
-	// an unordered_map<string, unsigned int>. If any of the
-	// handlers for a given extension support thumbnails,
-	// then the thumbnail handlers will be registered.
-	//
-	// The actual data is stored in the vector<ExtInfo>.
-	std::unordered_map<string, unsigned int> map_exts;
-
+	// All extension strings are static data owned by the RomData
+	// subclasses, so we can collect raw pointers, sort them, and
+	// merge duplicate extensions (OR'ing the attributes) in place.
+	// This avoids building a temporary unordered_map on first use,
+	// which previously dominated DLL init inside Explorer.
 	static constexpr size_t reserve_size =
 		(ARRAY_SIZE(romDataFns_magic) +
 		 ARRAY_SIZE(romDataFns_header) +
 		 ARRAY_SIZE(romDataFns_footer)) * 2;
 	vec_exts.reserve(reserve_size);
-#ifdef HAVE_UNORDERED_MAP_RESERVE
-	map_exts.reserve(reserve_size);
-#endif /* HAVE_UNORDERED_MAP_RESERVE */
 
 	for (const RomDataFns *const *tblptr = &romDataFns_tbl[0];
 	     *tblptr != nullptr; tblptr++)
@@ -1113,16 +1501,7 @@ void init_supportedFileExtensions(void)
 				continue;
 
 			for (; *sys_exts != nullptr; sys_exts++) {
-				auto iter = map_exts.find(*sys_exts);
-				if (iter != map_exts.end()) {
-					// We already had this extension.
-					// Update its attributes.
-					iter->second |= fns->attrs;
-				} else {
-					// First time encountering this extension.
-					map_exts[*sys_exts] = fns->attrs;
-					vec_exts.emplace_back(*sys_exts, fns->attrs);
-				}
+				vec_exts.emplace_back(*sys_exts, fns->attrs);
 			}
 		}
 	}
@@ -1131,22 +1510,28 @@ void init_supportedFileExtensions(void)
 	static constexpr unsigned int FFF_ATTRS = ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA;
 	const vector<const char*> &vec_exts_fileFormat = FileFormatFactory::supportedFileExtensions();
 	for (const char *ext : vec_exts_fileFormat) {
-		auto iter = map_exts.find(ext);
-		if (iter != map_exts.end()) {
-			// We already had this extension.
-			// Update its attributes.
-			iter->second |= FFF_ATTRS;
-		} else {
-			// First time encountering this extension.
-			map_exts[ext] = FFF_ATTRS;
-			vec_exts.emplace_back(ext, FFF_ATTRS);
-		}
+		vec_exts.emplace_back(ext, FFF_ATTRS);
 	}
 
-	// Make sure the vector's attributes fields are up to date.
-	for (ExtInfo &extInfo : vec_exts) {
-		extInfo.attrs = map_exts[extInfo.ext];
+	// Sort by extension, then merge duplicates in place.
+	std::sort(vec_exts.begin(), vec_exts.end(),
+		[](const ExtInfo &lhs, const ExtInfo &rhs) {
+			return (strcmp(lhs.ext, rhs.ext) < 0);
+		});
+	if (vec_exts.empty())
+		return;
+	auto iter_out = vec_exts.begin();
+	for (auto iter = vec_exts.begin() + 1; iter != vec_exts.end(); ++iter) {
+		if (!strcmp(iter_out->ext, iter->ext)) {
+			// Duplicate extension: Merge the attributes.
+			iter_out->attrs |= iter->attrs;
+		} else {
+			// New extension.
+			++iter_out;
+			*iter_out = *iter;
+		}
 	}
+	vec_exts.resize(std::distance(vec_exts.begin(), iter_out) + 1);
 }
 
 } // namespace Private
@@ -1163,7 +1548,7 @@ void init_supportedFileExtensions(void)
  */
 const vector<ExtInfo> &supportedFileExtensions(void)
 {
-	pthread_once(&Private::once_exts, Private::init_supportedFileExtensions);
+	rp_once(&Private::once_exts, Private::init_supportedFileExtensions);
 	return Private::vec_exts;
 }
 #endif /* ROMDATAFACTORY_USE_FILE_EXTENSIONS */
@@ -1175,7 +1560,7 @@ namespace Private {
  * Initialize the vector of supported MIME types.
  * Used for KFileMetaData.
  *
- * Internal function; must be called using pthread_once().
+ * Internal function; must be called using rp_once().
  */
 void init_supportedMimeTypes(void)
 {
@@ -1216,7 +1601,7 @@ void init_supportedMimeTypes(void)
 	}
 
 	// Get MIME types from FileFormatFactory.
-	const vector<const char*> vec_mimeTypes_fileFormat = FileFormatFactory::supportedMimeTypes();
+	const vector<const char*> &vec_mimeTypes_fileFormat = FileFormatFactory::supportedMimeTypes();
 	for (const char *mimeType : vec_mimeTypes_fileFormat) {
 		auto iter = set_mimeTypes.find(mimeType);
 		if (iter == set_mimeTypes.end()) {
@@ -1236,7 +1621,7 @@ void init_supportedMimeTypes(void)
  */
 const vector<const char*> &supportedMimeTypes(void)
 {
-	pthread_once(&Private::once_mimeTypes, Private::init_supportedMimeTypes);
+	rp_once(&Private::once_mimeTypes, Private::init_supportedMimeTypes);
 	return Private::vec_mimeTypes;
 }
 #endif /* ROMDATAFACTORY_USE_MIME_TYPES */
@@ -17,6 +17,7 @@
 
 // C++ includes
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace LibRomData { namespace RomDataFactory {
@@ -53,6 +54,19 @@ enum RomDataAttr {
 	// Check for game-specific disc file systems.
 	// (For internal RomDataFactory use only.)
 	RDA_CHECK_ISO		= (1U << 8),
+
+	// RomData subclass reads large sequential spans of the file
+	// after matching, e.g. to decompress an embedded executable.
+	// If not set, scattered small reads are assumed.
+	// (For internal RomDataFactory use only.)
+	RDA_INTENT_SEQUENTIAL	= (1U << 9),
+
+	// Caller intent hint: only the system name and metadata
+	// properties will be requested, not fields or images.
+	// This does not affect subclass matching; it lets the factory
+	// skip work that only matters for full extraction, e.g.
+	// sequential readahead hints.
+	RDA_INTENT_METADATA_ONLY = (1U << 10),
 };
 
 /**
@@ -95,6 +109,22 @@ LibRpBase::RomDataPtr create(const LibRpFile::IRpFilePtr &file, unsigned int att
 RP_LIBROMDATA_PUBLIC
 LibRpBase::RomDataPtr create(const char *filename, unsigned int attrs = 0);
 
+/**
+ * Create RomData subclasses for multiple ROM files at once.
+ *
+ * Files are probed in parallel using an internal thread pool,
+ * which amortizes factory and library init costs over the batch.
+ * The returned vector matches the order of the input filenames;
+ * entries are nullptr for unsupported files.
+ *
+ * @param filenames ROM filenames (UTF-8)
+ * @param attrs RomDataAttr bitfield. If set, RomData subclass must have the specified attributes.
+ * @param maxThreads Maximum number of threads. (0 for number of CPU cores)
+ * @return RomData subclasses. (nullptr for unsupported files)
+ */
+RP_LIBROMDATA_PUBLIC
+std::vector<LibRpBase::RomDataPtr> createBatch(const std::vector<std::string> &filenames, unsigned int attrs = 0, unsigned int maxThreads = 0);
+
 #ifdef _WIN32
 /**
  * Create a RomData subclass for the specified ROM file.
@@ -27,7 +27,10 @@ using namespace LibRpFile;
 using namespace LibRomData;
 
 // C++ STL classes
+#include <atomic>
+#include <thread>
 using std::array;
+using std::pair;
 using std::string;
 using std::u16string;
 using std::unique_ptr;
@@ -73,6 +76,11 @@ public:
 	// IAesCipher for verifying keys
 	IAesCipher *cipher;
 
+	// Import cancellation flag.
+	// Set by KeyStoreUI::cancelImport(); checked at key
+	// boundaries by the import functions.
+	std::atomic<bool> importCancel;
+
 public:
 	/**
 	 * (Re-)Load the keys from keys.conf.
@@ -111,16 +119,18 @@ public:
 	 * @param keyData	[in] Key data. (16 bytes)
 	 * @param verifyData	[in] Key verification data. (16 bytes)
 	 * @param len		[in] Length of keyData and verifyData. (must be 16)
+	 * @param pCipher	[in] AES-128-ECB cipher to use for verification.
 	 * @return 0 if the key is verified; non-zero if not.
 	 */
-	int verifyKeyData(const uint8_t *keyData, const uint8_t *verifyData, int len);
+	int verifyKeyData(const uint8_t *keyData, const uint8_t *verifyData, int len, IAesCipher *pCipher);
 
 	/**
 	 * Verify a key and update its status.
 	 * @param sectIdx Section index.
 	 * @param keyIdx Key index.
+	 * @param pCipher AES-128-ECB cipher to use for verification.
 	 */
-	void verifyKey(int sectIdx, int keyIdx);
+	void verifyKey(int sectIdx, int keyIdx, IAesCipher *pCipher);
 
 public:
 	// Section enumeration
@@ -242,6 +252,7 @@ KeyStoreUIPrivate::KeyStoreUIPrivate(KeyStoreUI *q)
 	: q_ptr(q)
 	, changed(false)
 	, cipher(AesCipherFactory::create())
+	, importCancel(false)
 {
 	// Make sure the cipher is usable.
 	if (cipher->isInit()) {
@@ -337,6 +348,12 @@ void KeyStoreUIPrivate::reset(void)
 	// Have any keys actually changed?
 	bool hasChanged = false;
 
+	// Keys that need to be verified, as sectIdx/keyIdx pairs.
+	// Verification is deferred until all of the key data has been
+	// loaded so it can be split across multiple threads.
+	vector<pair<int, int> > keysToVerify;
+	keysToVerify.reserve(keys.size());
+
 	int keyIdxStart = 0;
 	KeyManager::KeyData_t keyData;
 	for (int encSysNum = 0; encSysNum < static_cast<int>(encKeyFns.size()); encSysNum++) {
@@ -378,8 +395,8 @@ void KeyStoreUIPrivate::reset(void)
 							hasChanged = true;
 						}
 
-						// Verify the key.
-						verifyKey(encSysNum, i);
+						// Verify the key later.
+						keysToVerify.emplace_back(encSysNum, i);
 					} else {
 						// Key is invalid...
 						// TODO: Show an error message?
@@ -415,6 +432,72 @@ void KeyStoreUIPrivate::reset(void)
 		}
 	}
 
+	// Verify the keys that were loaded.
+	// Each key's AES verify test is independent, so the work is
+	// split across multiple threads, each with its own cipher.
+	if (!keysToVerify.empty()) {
+		unsigned int threadCount = std::thread::hardware_concurrency();
+		if (threadCount == 0 || !cipher) {
+			// Unable to determine the CPU core count,
+			// or no cipher is available.
+			threadCount = 1;
+		}
+		if (static_cast<size_t>(threadCount) > keysToVerify.size()) {
+			threadCount = static_cast<unsigned int>(keysToVerify.size());
+		}
+
+		// Create a cipher for each extra worker thread.
+		// If cipher creation fails, fall back to single-threaded
+		// verification using the existing cipher.
+		vector<unique_ptr<IAesCipher> > extraCiphers;
+		if (threadCount > 1) {
+			extraCiphers.reserve(threadCount - 1);
+			for (unsigned int i = 0; i < threadCount - 1; i++) {
+				unique_ptr<IAesCipher> pCipher(AesCipherFactory::create());
+				if (!pCipher || !pCipher->isInit()) {
+					extraCiphers.clear();
+					threadCount = 1;
+					break;
+				}
+				pCipher->setChainingMode(IAesCipher::ChainingMode::ECB);
+				extraCiphers.push_back(std::move(pCipher));
+			}
+		}
+
+		if (threadCount <= 1) {
+			// Single-threaded verification.
+			for (const auto &sectKey : keysToVerify) {
+				verifyKey(sectKey.first, sectKey.second, cipher);
+			}
+		} else {
+			// Worker threads pull the next key using a shared atomic
+			// index, so fast keys don't leave threads idle while a
+			// slow key is being verified. verifyKey() only writes
+			// its own key's status, so workers don't share any
+			// mutable state except the index.
+			std::atomic<size_t> nextIdx(0);
+			auto workerFn = [this, &keysToVerify, &nextIdx](IAesCipher *pCipher) {
+				while (true) {
+					const size_t i = nextIdx.fetch_add(1);
+					if (i >= keysToVerify.size())
+						break;
+					verifyKey(keysToVerify[i].first, keysToVerify[i].second, pCipher);
+				}
+			};
+
+			vector<std::thread> workers;
+			workers.reserve(threadCount - 1);
+			for (unsigned int i = 0; i < threadCount - 1; i++) {
+				workers.emplace_back(workerFn, extraCiphers[i].get());
+			}
+			// This thread uses the existing cipher.
+			workerFn(cipher);
+			for (std::thread &worker : workers) {
+				worker.join();
+			}
+		}
+	}
+
 	if (hasChanged) {
 		// Keys have changed.
 		RP_Q(KeyStoreUI);
@@ -514,6 +597,11 @@ KeyStoreUI::ImportReturn KeyStoreUIPrivate::importKeysFromBlob(SectionID sectIdx
 	RP_Q(KeyStoreUI);
 	bool wereKeysImported = false;
 	const int keyIdxStart = sections[(int)sectIdx].keyIdxStart;
+
+	// First pass: Import unverifiable keys immediately, and
+	// collect the keys that need AES verification.
+	vector<const KeyBinAddress*> toVerify;
+	toVerify.reserve(kba_len);
 	const KeyBinAddress *const kba_end = &kba[kba_len];
 	for (; kba < kba_end; kba++) {
 		KeyStoreUI::Key *const pKey = &keys[keyIdxStart + kba->keyIdx];
@@ -552,26 +640,109 @@ KeyStoreUI::ImportReturn KeyStoreUIPrivate::importKeysFromBlob(SectionID sectIdx
 			continue;
 		}
 
-		// Verify the key.
-		int ret = verifyKeyData(keyData, verifyData, 16);
-		if (ret == 0) {
-			// Found a match!
-			const string new_value = binToHexStr(keyData, 16);
-			if (pKey->value != new_value) {
-				pKey->value = binToHexStr(keyData, 16);
-				pKey->status = KeyStoreUI::Key::Status::OK;
-				pKey->modified = true;
-				iret.keysImportedVerify++;
-				wereKeysImported = true;
-				emit q->keyChanged_int((int)sectIdx, kba->keyIdx);
-				emit q->keyChanged_int(keyIdxStart + kba->keyIdx);
-			} else {
-				// No change.
-				iret.keysExist++;
+		toVerify.push_back(kba);
+	}
+
+	// Second pass: Verify the collected keys.
+	// As with reset(), each key's AES verify test is independent,
+	// so verification is split across multiple threads. Workers
+	// only write their own slot in results[], so no locking is
+	// needed; the results are applied serially afterwards.
+	// Result codes: 0 == match, 1 == no match, 0xFF == not verified (cancelled)
+	vector<uint8_t> results(toVerify.size(), 0xFF);
+	if (!toVerify.empty()) {
+		const int total = static_cast<int>(toVerify.size());
+		emit q->importProgress_int(0, total);
+
+		unsigned int threadCount = std::thread::hardware_concurrency();
+		if (threadCount == 0) {
+			// Unable to determine the CPU core count.
+			threadCount = 1;
+		}
+		if (static_cast<size_t>(threadCount) > toVerify.size()) {
+			threadCount = static_cast<unsigned int>(toVerify.size());
+		}
+
+		// Create a cipher for each extra worker thread.
+		// If cipher creation fails, fall back to single-threaded
+		// verification using the existing cipher.
+		vector<unique_ptr<IAesCipher> > extraCiphers;
+		if (threadCount > 1) {
+			extraCiphers.reserve(threadCount - 1);
+			for (unsigned int i = 0; i < threadCount - 1; i++) {
+				unique_ptr<IAesCipher> pCipher(AesCipherFactory::create());
+				if (!pCipher || !pCipher->isInit()) {
+					extraCiphers.clear();
+					threadCount = 1;
+					break;
+				}
+				pCipher->setChainingMode(IAesCipher::ChainingMode::ECB);
+				extraCiphers.push_back(std::move(pCipher));
+			}
+		}
+
+		std::atomic<size_t> nextIdx(0);
+		auto workerFn = [this, sectIdx, buf, &toVerify, &results, &nextIdx](IAesCipher *pCipher) {
+			while (!importCancel.load(std::memory_order_relaxed)) {
+				const size_t i = nextIdx.fetch_add(1);
+				if (i >= toVerify.size())
+					break;
+				const KeyBinAddress *const p = toVerify[i];
+				const uint8_t *const verifyData = encKeyFns[(int)sectIdx].pfnVerifyData(p->keyIdx);
+				const int ret = verifyKeyData(&buf[p->address], verifyData, 16, pCipher);
+				results[i] = (ret == 0 ? 0 : 1);
 			}
+		};
+
+		if (threadCount <= 1) {
+			workerFn(cipher);
 		} else {
-			// Not a match.
-			iret.keysInvalid++;
+			vector<std::thread> workers;
+			workers.reserve(threadCount - 1);
+			for (unsigned int i = 0; i < threadCount - 1; i++) {
+				workers.emplace_back(workerFn, extraCiphers[i].get());
+			}
+			// This thread uses the existing cipher.
+			workerFn(cipher);
+			for (std::thread &worker : workers) {
+				worker.join();
+			}
+		}
+
+		// Third pass: Apply the verification results.
+		for (size_t i = 0; i < toVerify.size(); i++) {
+			const KeyBinAddress *const p = toVerify[i];
+			KeyStoreUI::Key *const pKey = &keys[keyIdxStart + p->keyIdx];
+			switch (results[i]) {
+				case 0: {
+					// Found a match!
+					const string new_value = binToHexStr(&buf[p->address], 16);
+					if (pKey->value != new_value) {
+						pKey->value = new_value;
+						pKey->status = KeyStoreUI::Key::Status::OK;
+						pKey->modified = true;
+						iret.keysImportedVerify++;
+						wereKeysImported = true;
+						emit q->keyChanged_int((int)sectIdx, p->keyIdx);
+						emit q->keyChanged_int(keyIdxStart + p->keyIdx);
+					} else {
+						// No change.
+						iret.keysExist++;
+					}
+					break;
+				}
+
+				case 1:
+					// Not a match.
+					iret.keysInvalid++;
+					break;
+
+				default:
+					// Not verified: the import was cancelled.
+					// Don't count this key at all.
+					break;
+			}
+			emit q->importProgress_int(static_cast<int>(i) + 1, total);
 		}
 	}
 
@@ -685,9 +856,10 @@ string KeyStoreUIPrivate::convertKanjiToHex(const char *str)
  * @param keyData	[in] Key data. (16 bytes)
  * @param verifyData	[in] Key verification data. (16 bytes)
  * @param len		[in] Length of keyData and verifyData. (must be 16)
+ * @param pCipher	[in] AES-128-ECB cipher to use for verification.
  * @return 0 if the key is verified; non-zero if not.
  */
-int KeyStoreUIPrivate::verifyKeyData(const uint8_t *keyData, const uint8_t *verifyData, int len)
+int KeyStoreUIPrivate::verifyKeyData(const uint8_t *keyData, const uint8_t *verifyData, int len, IAesCipher *pCipher)
 {
 	assert(len == 16);
 	if (len != 16) {
@@ -698,12 +870,12 @@ int KeyStoreUIPrivate::verifyKeyData(const uint8_t *keyData, const uint8_t *veri
 	// Attempt to decrypt the verification data using the key.
 	uint8_t testData[16];
 	memcpy(testData, verifyData, sizeof(testData));
-	int ret = cipher->setKey(keyData, len);
+	int ret = pCipher->setKey(keyData, len);
 	if (ret != 0) {
 		// Error setting the key.
 		return -EIO;
 	}
-	size_t size = cipher->decrypt(testData, sizeof(testData));
+	size_t size = pCipher->decrypt(testData, sizeof(testData));
 	if (size != sizeof(testData)) {
 		// Error decrypting the data.
 		return -EIO;
@@ -717,8 +889,9 @@ int KeyStoreUIPrivate::verifyKeyData(const uint8_t *keyData, const uint8_t *veri
  * Verify a key and update its status.
  * @param sectIdx Section index.
  * @param keyIdx Key index.
+ * @param pCipher AES-128-ECB cipher to use for verification.
  */
-void KeyStoreUIPrivate::verifyKey(int sectIdx, int keyIdx)
+void KeyStoreUIPrivate::verifyKey(int sectIdx, int keyIdx, IAesCipher *pCipher)
 {
 	const int idx = sectKeyToIdx(sectIdx, keyIdx);
 	if (idx < 0)
@@ -737,7 +910,7 @@ void KeyStoreUIPrivate::verifyKey(int sectIdx, int keyIdx)
 		return;
 	}
 
-	if (!cipher) {
+	if (!pCipher) {
 		// Cipher is unavailable.
 		// Cannot verify the key.
 		key.status = KeyStoreUI::Key::Status::Unknown;
@@ -763,7 +936,7 @@ void KeyStoreUIPrivate::verifyKey(int sectIdx, int keyIdx)
 	}
 
 	// Verify the key.
-	ret = verifyKeyData(keyBytes, verifyData, sizeof(keyBytes));
+	ret = verifyKeyData(keyBytes, verifyData, sizeof(keyBytes), pCipher);
 	if (ret == 0) {
 		// Decrypted data is correct.
 		key.status = KeyStoreUI::Key::Status::OK;
@@ -1032,7 +1205,7 @@ int KeyStoreUI::setKey(int sectIdx, int keyIdx, const char *value)
 		key.value = new_value;
 		key.modified = true;
 		// Verify the key.
-		d->verifyKey(sectIdx, keyIdx);
+		d->verifyKey(sectIdx, keyIdx, d->cipher);
 		// Key has changed.
 		emit keyChanged_int(sectIdx, keyIdx);
 		emit keyChanged_int(idx);
@@ -1362,8 +1535,18 @@ KeyStoreUI::ImportReturn KeyStoreUIPrivate::importN3DSaeskeydb(IRpFile *file)
 	AesKeyInfo *aesKey = reinterpret_cast<AesKeyInfo*>(buf.get());
 	const AesKeyInfo *const aesKeyEnd = reinterpret_cast<const AesKeyInfo*>(buf.get() + fileSize);
 	const int keyIdxStart = sections[(int)KeyStoreUIPrivate::SectionID::N3DSVerifyKeys].keyIdxStart;
+	const int totalKeyCount = static_cast<int>(fileSize / 32);
+	int processed = 0;
 	bool wereKeysImported = false;
 	do {
+		if (importCancel.load(std::memory_order_relaxed)) {
+			// The import was cancelled.
+			// Return the counts for the keys processed so far.
+			break;
+		}
+		emit q->importProgress_int(processed, totalKeyCount);
+		processed++;
+
 		// Check if this is a supported keyslot.
 		// Key indexes: 0 == retail, 1 == debug
 		// except for Slot0x3DKeyY, which has 6 of each
@@ -1523,7 +1706,9 @@ KeyStoreUI::ImportReturn KeyStoreUIPrivate::importN3DSaeskeydb(IRpFile *file)
 			const uint8_t *const verifyData = N3DSVerifyKeys::encryptionVerifyData_static(*pKeyIdx);
 			if (verifyData) {
 				// Verify the key.
-				int ret = verifyKeyData(aesKey->key, verifyData, 16);
+				// NOTE: `cipher` is shadowed here by the aeskeydb.bin
+				// decryption cipher, so use the member cipher explicitly.
+				int ret = verifyKeyData(aesKey->key, verifyData, 16, this->cipher);
 				if (ret == 0) {
 					// Found a match!
 					const string new_value = binToHexStr(aesKey->key, sizeof(aesKey->key));
@@ -1571,6 +1756,7 @@ KeyStoreUI::ImportReturn KeyStoreUIPrivate::importN3DSaeskeydb(IRpFile *file)
 			iret.keysInvalid++;
 		}
 	} while (++aesKey != aesKeyEnd);
+	emit q->importProgress_int(processed, totalKeyCount);
 
 	if (wereKeysImported) {
 		emit q->modified_int();
@@ -1590,6 +1776,8 @@ KeyStoreUI::ImportReturn KeyStoreUIPrivate::importN3DSaeskeydb(IRpFile *file)
 KeyStoreUI::ImportReturn KeyStoreUI::importKeysFromBin(ImportFileID fileID, IRpFile *file)
 {
 	RP_D(KeyStoreUI);
+	// Clear any stale cancellation request.
+	d->importCancel.store(false, std::memory_order_relaxed);
 	switch (fileID) {
 		case ImportFileID::WiiKeysBin:
 			return d->importWiiKeysBin(file);
@@ -1655,4 +1843,39 @@ KeyStoreUI::ImportReturn KeyStoreUI::importKeysFromBin(ImportFileID fileID, cons
 }
 #endif /* _WIN32 */
 
+/**
+ * Import progress update.
+ *
+ * NOTE: Unlike the other signals, this has a default no-op
+ * implementation, since progress reporting is optional.
+ * Subclasses can reimplement this as a notification signal
+ * to drive a progress bar. It is invoked on whichever thread
+ * is running importKeysFromBin(), so subclasses running the
+ * import on a worker thread must marshal it to the UI thread.
+ *
+ * @param cur Number of keys processed so far.
+ * @param max Total number of keys to process.
+ */
+void KeyStoreUI::importProgress_int(int cur, int max)
+{
+	// Default implementation does nothing.
+	RP_UNUSED(cur);
+	RP_UNUSED(max);
+}
+
+/**
+ * Request cancellation of an in-progress import.
+ *
+ * This function is thread-safe: it can be called from the UI
+ * thread while importKeysFromBin() is running on a worker
+ * thread. The import stops at the next key boundary, and the
+ * ImportReturn counts only cover the keys processed up to
+ * that point.
+ */
+void KeyStoreUI::cancelImport(void)
+{
+	RP_D(KeyStoreUI);
+	d->importCancel.store(true, std::memory_order_relaxed);
+}
+
 }
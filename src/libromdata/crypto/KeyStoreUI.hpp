@@ -198,6 +198,21 @@ protected /*signals*/:
 	 */
 	virtual void modified_int(void) = 0;
 
+	/**
+	 * Import progress update.
+	 *
+	 * NOTE: Unlike the other signals, this has a default no-op
+	 * implementation, since progress reporting is optional.
+	 * Subclasses can reimplement this as a notification signal
+	 * to drive a progress bar. It is invoked on whichever thread
+	 * is running importKeysFromBin(), so subclasses running the
+	 * import on a worker thread must marshal it to the UI thread.
+	 *
+	 * @param cur Number of keys processed so far.
+	 * @param max Total number of keys to process.
+	 */
+	virtual void importProgress_int(int cur, int max);
+
 public:
 	enum class ImportStatus : uint8_t {
 		InvalidParams = 0,	// Invalid parameters. (Should not happen!)
@@ -258,6 +273,17 @@ public:
 	 */
 	ImportReturn importKeysFromBin(ImportFileID fileID, const wchar_t *filenameW);
 #endif /* _WIN32 */
+
+	/**
+	 * Request cancellation of an in-progress import.
+	 *
+	 * This function is thread-safe: it can be called from the UI
+	 * thread while importKeysFromBin() is running on a worker
+	 * thread. The import stops at the next key boundary, and the
+	 * ImportReturn counts only cover the keys processed up to
+	 * that point.
+	 */
+	void cancelImport(void);
 };
 
 }
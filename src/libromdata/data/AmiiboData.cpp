@@ -21,6 +21,7 @@
 
 // Other rom-properties libraries
 #include "librpfile/FileSystem.hpp"
+#include "librpfile/MmapFile.hpp"
 #include "librpfile/RpFile.hpp"
 using namespace LibRpFile;
 
@@ -82,7 +83,14 @@ public:
 
 public:
 	// amiibo.bin data
+	// The .bin tables are sorted and fixed-width, so lookups
+	// binary-search the file data in place. Preferably the file is
+	// memory-mapped; amiibo_bin_data is only used as a fallback if
+	// the mapping fails. (pipe, special file, etc.)
+	LibRpFile::MmapFilePtr amiibo_bin_map;
 	rp::uvector<uint8_t> amiibo_bin_data;
+	const uint8_t *pBinData;	// Mapping or fallback buffer
+	size_t binSize;
 
 	// Convenience pointers to amiibo.bin structs.
 	const AmiiboBinHeader *pHeader;
@@ -156,7 +164,9 @@ public:
 TCHAR *AmiiboDataPrivate::amiibo_data_bin_override_filename = nullptr;
 
 AmiiboDataPrivate::AmiiboDataPrivate()
-	: pHeader(nullptr)
+	: pBinData(nullptr)
+	, binSize(0)
+	, pHeader(nullptr)
 	, pStrTbl(nullptr)
 	, pCSeriesTbl(nullptr)
 	, pCharTbl(nullptr)
@@ -276,7 +286,7 @@ tstring AmiiboDataPrivate::getAmiiboBinFilename(AmiiboBinFileType amiiboBinFileT
 int AmiiboDataPrivate::loadIfNeeded(void)
 {
 	const time_t now = time(nullptr);
-	if (!amiibo_bin_data.empty()) {
+	if (pBinData) {
 		// amiibo data is already loaded.
 
 		// Have we checked the timestamp recently?
@@ -347,20 +357,35 @@ int AmiiboDataPrivate::loadIfNeeded(void)
 	if (!ok) {
 		// Unable to find any valid amiibo-data.bin file.
 		// If data was already loaded before, keep using it.
-		return (amiibo_bin_data.empty() ? -ENOENT : 0);
+		return (pBinData ? 0 : -ENOENT);
 	}
 
-	// Load amiibo.bin.
-	unique_ptr<RpFile> f_amiibo_bin(new RpFile(tfilename, RpFile::FM_OPEN_READ));
-	if (!f_amiibo_bin->isOpen()) {
-		// Unable to open the file.
-		int err = -f_amiibo_bin->lastError();
-		return err;
+	// Try to map amiibo-data.bin into memory first.
+	// The tables are sorted and fixed-width, so the lookups can
+	// binary-search the mapping directly; no heap copy is needed,
+	// and the pages are shared across processes.
+	MmapFilePtr f_map = std::make_shared<MmapFile>(tfilename.c_str());
+	const bool useMmap = f_map->isOpen();
+
+	unique_ptr<RpFile> f_amiibo_bin;
+	off64_t fileSize_o;
+	if (useMmap) {
+		fileSize_o = f_map->size();
+	} else {
+		// Couldn't map the file. (pipe, special file, etc.)
+		// Fall back to reading it into a heap buffer.
+		f_map.reset();
+		f_amiibo_bin.reset(new RpFile(tfilename, RpFile::FM_OPEN_READ));
+		if (!f_amiibo_bin->isOpen()) {
+			// Unable to open the file.
+			int err = -f_amiibo_bin->lastError();
+			return err;
+		}
+		fileSize_o = f_amiibo_bin->size();
 	}
 
 	// Make sure the file is larger than sizeof(AmiiboBinHeader)
 	// and it's under 1 MB.
-	const off64_t fileSize_o = f_amiibo_bin->size();
 	if (fileSize_o < (off64_t)sizeof(AmiiboBinHeader) ||
 	    fileSize_o >= 1024*1024)
 	{
@@ -373,25 +398,35 @@ int AmiiboDataPrivate::loadIfNeeded(void)
 
 	// Load the data.
 	const size_t fileSize = static_cast<size_t>(fileSize_o);
-	amiibo_bin_data.resize(fileSize);
-	size_t size = f_amiibo_bin->read(amiibo_bin_data.data(), fileSize);
-	if (size != fileSize) {
-		// Read error.
-		int err = -f_amiibo_bin->lastError();
-		if (err == 0) {
-			err = -EIO;
+	if (useMmap) {
+		// Lookups are scattered binary searches.
+		f_map->setAccessIntent(IRpFile::AccessIntent::Random);
+		pBinData = static_cast<const uint8_t*>(f_map->buffer());
+		binSize = fileSize;
+		amiibo_bin_map = std::move(f_map);
+	} else {
+		amiibo_bin_data.resize(fileSize);
+		size_t size = f_amiibo_bin->read(amiibo_bin_data.data(), fileSize);
+		if (size != fileSize) {
+			// Read error.
+			int err = -f_amiibo_bin->lastError();
+			if (err == 0) {
+				err = -EIO;
+			}
+			clear();
+			return err;
 		}
-		amiibo_bin_data.clear();
-		return err;
+		f_amiibo_bin.reset(nullptr);
+		pBinData = amiibo_bin_data.data();
+		binSize = fileSize;
 	}
-	f_amiibo_bin.reset(nullptr);
 
 	// Verify the header.
 	const AmiiboBinHeader *const pHeader_tmp =
-		reinterpret_cast<const AmiiboBinHeader*>(&amiibo_bin_data[0]);
+		reinterpret_cast<const AmiiboBinHeader*>(pBinData);
 	if (memcmp(pHeader_tmp->magic, AMIIBO_BIN_MAGIC, sizeof(pHeader_tmp->magic)) != 0) {
 		// Invalid magic.
-		amiibo_bin_data.clear();
+		clear();
 		return -EIO;
 	}
 
@@ -402,16 +437,16 @@ int AmiiboDataPrivate::loadIfNeeded(void)
 	    ((uint64_t)strtbl_offset + (uint64_t)strtbl_len) > static_cast<uint64_t>(fileSize))
 	{
 		// String table offsets are invalid.
-		amiibo_bin_data.clear();
+		clear();
 		return -EIO;
 	}
 
 	// Make sure the string table both starts and ends with NULL.
-	if (amiibo_bin_data[strtbl_offset] != 0 ||
-	    amiibo_bin_data[strtbl_offset + strtbl_len - 1] != 0)
+	if (pBinData[strtbl_offset] != 0 ||
+	    pBinData[strtbl_offset + strtbl_len - 1] != 0)
 	{
 		// Missing NULLs.
-		amiibo_bin_data.clear();
+		clear();
 		return -EIO;
 	}
 
@@ -423,7 +458,7 @@ int AmiiboDataPrivate::loadIfNeeded(void)
 	    ((uint64_t)cseries_offset + (uint64_t)cseries_len) > static_cast<uint64_t>(fileSize))
 	{
 		// p.21 character series table offsets are invalid.
-		amiibo_bin_data.clear();
+		clear();
 		return -EIO;
 	}
 
@@ -434,7 +469,7 @@ int AmiiboDataPrivate::loadIfNeeded(void)
 	    ((uint64_t)char_offset + (uint64_t)char_len) > static_cast<uint64_t>(fileSize))
 	{
 		// p.21 character table offsets are invalid.
-		amiibo_bin_data.clear();
+		clear();
 		return -EIO;
 	}
 
@@ -445,7 +480,7 @@ int AmiiboDataPrivate::loadIfNeeded(void)
 	    ((uint64_t)cvar_offset + (uint64_t)cvar_len) > static_cast<uint64_t>(fileSize))
 	{
 		// p.21 character variant table offsets are invalid.
-		amiibo_bin_data.clear();
+		clear();
 		return -EIO;
 	}
 
@@ -456,7 +491,7 @@ int AmiiboDataPrivate::loadIfNeeded(void)
 	    ((uint64_t)aseries_offset + (uint64_t)aseries_len) > static_cast<uint64_t>(fileSize))
 	{
 		// p.22 amiibo series table offsets are invalid.
-		amiibo_bin_data.clear();
+		clear();
 		return -EIO;
 	}
 
@@ -467,7 +502,7 @@ int AmiiboDataPrivate::loadIfNeeded(void)
 	    ((uint64_t)amiibo_offset + (uint64_t)amiibo_len) > static_cast<uint64_t>(fileSize))
 	{
 		// p.22 amiibo ID table offsets are invalid.
-		amiibo_bin_data.clear();
+		clear();
 		return -EIO;
 	}
 
@@ -477,12 +512,12 @@ int AmiiboDataPrivate::loadIfNeeded(void)
 	amiiboBinFileType = bin_ft;
 
 	// Save the table values and offsets.
-	pStrTbl = reinterpret_cast<const char*>(&amiibo_bin_data[strtbl_offset]);
-	pCSeriesTbl = reinterpret_cast<const uint32_t*>(&amiibo_bin_data[cseries_offset]);
-	pCharTbl = reinterpret_cast<const CharTableEntry*>(&amiibo_bin_data[char_offset]);
-	pCharVarTbl = reinterpret_cast<const CharVariantTableEntry*>(&amiibo_bin_data[cvar_offset]);
-	pASeriesTbl = reinterpret_cast<const uint32_t*>(&amiibo_bin_data[aseries_offset]);
-	pAmiiboIDTbl = reinterpret_cast<const AmiiboIDTableEntry*>(&amiibo_bin_data[amiibo_offset]);
+	pStrTbl = reinterpret_cast<const char*>(&pBinData[strtbl_offset]);
+	pCSeriesTbl = reinterpret_cast<const uint32_t*>(&pBinData[cseries_offset]);
+	pCharTbl = reinterpret_cast<const CharTableEntry*>(&pBinData[char_offset]);
+	pCharVarTbl = reinterpret_cast<const CharVariantTableEntry*>(&pBinData[cvar_offset]);
+	pASeriesTbl = reinterpret_cast<const uint32_t*>(&pBinData[aseries_offset]);
+	pAmiiboIDTbl = reinterpret_cast<const AmiiboIDTableEntry*>(&pBinData[amiibo_offset]);
 	strTbl_len = strtbl_len;
 	cseriesTbl_count = cseries_len / sizeof(uint32_t);
 	charTbl_count = char_len / sizeof(CharTableEntry);
@@ -503,6 +538,11 @@ void AmiiboDataPrivate::clear(void)
 	amiibo_bin_file_ts = -1;
 	amiiboBinFileType = AmiiboBinFileType::None;
 
+	amiibo_bin_map.reset();
+	amiibo_bin_data.clear();
+	pBinData = nullptr;
+	binSize = 0;
+
 	pHeader = nullptr;
 	pStrTbl = nullptr;
 	pCSeriesTbl = nullptr;
@@ -21,6 +21,10 @@
 using namespace LibRpBase;
 using namespace LibRpFile;
 
+// C++ STL classes
+#include <thread>
+using std::unique_ptr;
+
 namespace LibRomData {
 
 class CIAReaderPrivate
@@ -30,6 +34,7 @@ public:
 		off64_t content_offset, uint32_t content_length,
 		const N3DS_Ticket_t *ticket,
 		uint16_t tmd_content_index);
+	~CIAReaderPrivate();
 
 private:
 	RP_DISABLE_COPY(CIAReaderPrivate)
@@ -39,12 +44,57 @@ protected:
 public:
 	CBCReaderPtr cbcReader;
 
+	// Content length, in bytes
+	off64_t content_size;
+
 #ifdef ENABLE_DECRYPTION
 	// KeyY index for title key encryption
 	uint8_t titleKeyEncIdx;
 	// TMD content index
 	uint16_t tmd_content_index;
 #endif /* ENABLE_DECRYPTION */
+
+public:
+	/** Decryption readahead pipeline **/
+
+	// For encrypted content, a producer thread decrypts the next
+	// chunk through cbcReader while the caller consumes the current
+	// one, overlapping file I/O and AES-CBC decryption with parsing.
+	// Passthru (NoCrypto) content bypasses this and reads directly.
+	static constexpr size_t CHUNK_SIZE = 64U*1024;
+
+	struct Chunk {
+		int64_t idx;	// chunk index, or -1 if not loaded
+		size_t len;	// number of valid bytes in buf
+		unique_ptr<uint8_t[]> buf;
+	};
+	Chunk chunks[2];
+	int curChunk;		// chunks[] index being consumed
+	off64_t pos;		// current read position
+	bool useReadahead;	// true for encrypted content
+	bool prefetching;	// true if prefetchThread is running
+	std::thread prefetchThread;	// fills chunks[!curChunk]
+
+	/**
+	 * Load a chunk synchronously.
+	 * NOTE: The prefetch thread must not be running if the
+	 * target chunk is the current chunk.
+	 * @param chunk	[out] Chunk buffer to load into.
+	 * @param idx	[in] Chunk index.
+	 */
+	void loadChunk(Chunk &chunk, int64_t idx);
+
+	/**
+	 * Wait for the prefetch thread to finish, if it's running.
+	 */
+	void joinPrefetch(void);
+
+	/**
+	 * Start prefetching a chunk into the non-current chunk buffer.
+	 * The prefetch thread must not be running.
+	 * @param idx Chunk index.
+	 */
+	void startPrefetch(int64_t idx);
 };
 
 /** CIAReaderPrivate **/
@@ -53,11 +103,21 @@ CIAReaderPrivate::CIAReaderPrivate(CIAReader *q,
 	off64_t content_offset, uint32_t content_length,
 	const N3DS_Ticket_t *ticket, uint16_t tmd_content_index)
 	: q_ptr(q)
+	, content_size(content_length)
 #ifdef ENABLE_DECRYPTION
 	, titleKeyEncIdx(0)
 	, tmd_content_index(tmd_content_index)
 #endif /* ENABLE_DECRYPTION */
+	, curChunk(0)
+	, pos(0)
+	, useReadahead(false)
+	, prefetching(false)
 {
+	chunks[0].idx = -1;
+	chunks[0].len = 0;
+	chunks[1].idx = -1;
+	chunks[1].len = 0;
+
 #ifndef ENABLE_DECRYPTION
 	RP_UNUSED(tmd_content_index);
 #endif /* ENABLE_DECRYPTION */
@@ -169,6 +229,9 @@ CIAReaderPrivate::CIAReaderPrivate(CIAReader *q,
 
 	// Create a CBC reader to decrypt the CIA.
 	cbcReader = std::make_shared<CBCReader>(q->m_file, content_offset, content_length, title_key, cia_iv.u8);
+
+	// Content is encrypted, so enable the readahead pipeline.
+	useReadahead = true;
 #else /* !ENABLE_DECRYPTION */
 	// Cannot decrypt the CIA.
 	// TODO: Set an error.
@@ -176,6 +239,58 @@ CIAReaderPrivate::CIAReaderPrivate(CIAReader *q,
 #endif /* ENABLE_DECRYPTION */
 }
 
+CIAReaderPrivate::~CIAReaderPrivate()
+{
+	// Wait for any outstanding prefetch to finish.
+	joinPrefetch();
+}
+
+/**
+ * Load a chunk synchronously.
+ * NOTE: The prefetch thread must not be running if the
+ * target chunk is the current chunk.
+ * @param chunk	[out] Chunk buffer to load into.
+ * @param idx	[in] Chunk index.
+ */
+void CIAReaderPrivate::loadChunk(Chunk &chunk, int64_t idx)
+{
+	if (!chunk.buf) {
+		chunk.buf.reset(new uint8_t[CHUNK_SIZE]);
+	}
+
+	chunk.idx = idx;
+	chunk.len = 0;
+	if (cbcReader->seek(static_cast<off64_t>(idx) * CHUNK_SIZE) == 0) {
+		chunk.len = cbcReader->read(chunk.buf.get(), CHUNK_SIZE);
+	}
+}
+
+/**
+ * Wait for the prefetch thread to finish, if it's running.
+ */
+void CIAReaderPrivate::joinPrefetch(void)
+{
+	if (prefetching) {
+		prefetchThread.join();
+		prefetching = false;
+	}
+}
+
+/**
+ * Start prefetching a chunk into the non-current chunk buffer.
+ * The prefetch thread must not be running.
+ * @param idx Chunk index.
+ */
+void CIAReaderPrivate::startPrefetch(int64_t idx)
+{
+	assert(!prefetching);
+	Chunk &next = chunks[!curChunk];
+	prefetchThread = std::thread([this, &next, idx]() {
+		loadChunk(next, idx);
+	});
+	prefetching = true;
+}
+
 /** CIAReader **/
 
 /**
@@ -229,9 +344,62 @@ size_t CIAReader::read(void *ptr, size_t size)
 		return 0;
 	}
 
-	size_t ret = d->cbcReader->read(ptr, size);
-	m_lastError = d->cbcReader->lastError();
-	return ret;
+	if (!d->useReadahead) {
+		// Passthru content. Read it directly.
+		size_t ret = d->cbcReader->read(ptr, size);
+		m_lastError = d->cbcReader->lastError();
+		return ret;
+	}
+
+	// Encrypted content. Read through the readahead pipeline.
+	uint8_t *p = static_cast<uint8_t*>(ptr);
+	size_t total = 0;
+	while (size > 0 && d->pos < d->content_size) {
+		const int64_t chunkIdx = d->pos / CIAReaderPrivate::CHUNK_SIZE;
+		CIAReaderPrivate::Chunk *cur = &d->chunks[d->curChunk];
+		if (cur->idx != chunkIdx) {
+			// Need a different chunk.
+			d->joinPrefetch();
+			if (d->chunks[!d->curChunk].idx == chunkIdx) {
+				// The prefetch thread already decrypted it.
+				d->curChunk = !d->curChunk;
+			} else {
+				// Not prefetched. Load it synchronously.
+				d->loadChunk(d->chunks[d->curChunk], chunkIdx);
+			}
+			cur = &d->chunks[d->curChunk];
+		}
+
+		// Prefetch the next chunk while this one is being consumed.
+		const int64_t nextIdx = chunkIdx + 1;
+		if (!d->prefetching &&
+		    nextIdx * static_cast<off64_t>(CIAReaderPrivate::CHUNK_SIZE) < d->content_size &&
+		    d->chunks[!d->curChunk].idx != nextIdx)
+		{
+			d->startPrefetch(nextIdx);
+		}
+
+		const size_t offInChunk = static_cast<size_t>(d->pos % CIAReaderPrivate::CHUNK_SIZE);
+		if (offInChunk >= cur->len) {
+			// Short chunk. (read error or EOF)
+			break;
+		}
+
+		const size_t toCopy = std::min(size, cur->len - offInChunk);
+		memcpy(p, &cur->buf[offInChunk], toCopy);
+		p += toCopy;
+		size -= toCopy;
+		d->pos += toCopy;
+		total += toCopy;
+	}
+
+	if (total == 0) {
+		// Nothing was read. Get the error from the CBC reader.
+		// NOTE: Must not be prefetching while checking lastError().
+		d->joinPrefetch();
+		m_lastError = d->cbcReader->lastError();
+	}
+	return total;
 }
 
 /**
@@ -250,6 +418,18 @@ int CIAReader::seek(off64_t pos)
 		return -1;
 	}
 
+	if (d->useReadahead) {
+		// The readahead pipeline tracks its own position.
+		// Handle out-of-range cases the same way as CBCReader.
+		if (pos < 0) {
+			// Negative is invalid.
+			m_lastError = EINVAL;
+			return -1;
+		}
+		d->pos = std::min(pos, d->content_size);
+		return 0;
+	}
+
 	int ret = d->cbcReader->seek(pos);
 	if (ret != 0) {
 		m_lastError = d->cbcReader->lastError();
@@ -271,6 +451,11 @@ off64_t CIAReader::tell(void)
 		return -1;
 	}
 
+	if (d->useReadahead) {
+		// The readahead pipeline tracks its own position.
+		return d->pos;
+	}
+
 	off64_t ret = d->cbcReader->tell();
 	m_lastError = d->cbcReader->lastError();
 	return ret;
@@ -293,6 +478,12 @@ off64_t CIAReader::size(void)
 		return -1;
 	}
 
+	if (d->useReadahead) {
+		// NOTE: Not delegating to cbcReader, since the prefetch
+		// thread may be using it.
+		return d->content_size;
+	}
+
 	off64_t ret = d->cbcReader->size();
 	m_lastError = d->cbcReader->lastError();
 	return ret;
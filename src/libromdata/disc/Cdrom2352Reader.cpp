@@ -209,4 +209,95 @@ int Cdrom2352Reader::readBlock(uint32_t blockIdx, int pos, void *ptr, size_t siz
 	return static_cast<int>(size);
 }
 
+/**
+ * Read multiple consecutive full blocks.
+ *
+ * The raw sectors are read in batches with a single seek+read
+ * round trip per batch, and the user data area is extracted
+ * from each sector afterwards.
+ *
+ * @param blockIdx	[in] Starting block index.
+ * @param blockCount	[in] Number of blocks to read.
+ * @param ptr		[out] Output data buffer. (Must be at least blockCount * block_size bytes.)
+ * @return Number of full blocks read. (< blockCount on error or short read)
+ */
+int Cdrom2352Reader::readBlocks(uint32_t blockIdx, uint32_t blockCount, void *ptr)
+{
+	// NOTE: This can only be called by SparseDiscReader,
+	// so the main assertions are already checked there.
+	RP_D(Cdrom2352Reader);
+	if (unlikely(blockCount == 0)) {
+		// Nothing to read.
+		return 0;
+	}
+
+	// Read the raw sectors in batches so we don't pay for one
+	// seek+read round trip per 2352-byte sector.
+	static constexpr uint32_t SECTORS_PER_BATCH = 64;
+	rp::uvector<uint8_t> rawBuf;
+	rawBuf.resize(std::min(blockCount, SECTORS_PER_BATCH) * d->physBlockSize);
+
+	uint8_t *ptr8 = static_cast<uint8_t*>(ptr);
+	uint32_t blocksRead = 0;
+	while (blocksRead < blockCount) {
+		const uint32_t inBatch = std::min(blockCount - blocksRead, SECTORS_PER_BATCH);
+		const off64_t physBlockAddr = static_cast<off64_t>(blockIdx + blocksRead) * d->physBlockSize;
+		const size_t sz_expected = static_cast<size_t>(inBatch) * d->physBlockSize;
+		const size_t sz_read = m_file->seekAndRead(physBlockAddr, rawBuf.data(), sz_expected);
+
+		// Extract the user data area from each full sector that was read.
+		// NOTE: Sector user data area position depends on the sector mode.
+		const uint32_t sectorsOK = static_cast<uint32_t>(sz_read / d->physBlockSize);
+		for (uint32_t i = 0; i < sectorsOK; i++) {
+			const CDROM_2352_Sector_t *const sector =
+				reinterpret_cast<const CDROM_2352_Sector_t*>(&rawBuf[i * d->physBlockSize]);
+			memcpy(ptr8, cdromSectorDataPtr(sector), d->block_size);
+			ptr8 += d->block_size;
+		}
+
+		blocksRead += sectorsOK;
+		if (sectorsOK != inBatch) {
+			// Short read.
+			m_lastError = m_file->lastError();
+			if (m_lastError == 0) {
+				m_lastError = EIO;
+			}
+			break;
+		}
+	}
+
+	return static_cast<int>(blocksRead);
+}
+
+/**
+ * Advise the disc image of an upcoming read.
+ *
+ * The 2048-byte logical extent is translated into the
+ * corresponding raw sector extent and forwarded to the
+ * underlying file.
+ *
+ * @param offset	[in] Start of the range that will be read.
+ * @param size		[in] Length of the range, in bytes.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int Cdrom2352Reader::advise(off64_t offset, size_t size)
+{
+	RP_D(Cdrom2352Reader);
+	if (!m_file) {
+		m_lastError = EBADF;
+		return -EBADF;
+	}
+
+	if (offset < 0 || size == 0) {
+		// Out of range, or nothing to advise.
+		return 0;
+	}
+
+	// Translate the 2048-byte logical extent to raw sectors.
+	const off64_t blockStart = offset / 2048;
+	const off64_t blockEnd = (offset + size - 1) / 2048;
+	return m_file->advise(blockStart * d->physBlockSize,
+		static_cast<size_t>((blockEnd - blockStart + 1) * d->physBlockSize));
+}
+
 }
@@ -93,6 +93,34 @@ protected:
 	 */
 	ATTR_ACCESS_SIZE(write_only, 4, 5)
 	int readBlock(uint32_t blockIdx, int pos, void *ptr, size_t size) final;
+
+	/**
+	 * Read multiple consecutive full blocks.
+	 *
+	 * The raw sectors are read in batches with a single seek+read
+	 * round trip per batch, and the user data area is extracted
+	 * from each sector afterwards.
+	 *
+	 * @param blockIdx	[in] Starting block index.
+	 * @param blockCount	[in] Number of blocks to read.
+	 * @param ptr		[out] Output data buffer. (Must be at least blockCount * block_size bytes.)
+	 * @return Number of full blocks read. (< blockCount on error or short read)
+	 */
+	int readBlocks(uint32_t blockIdx, uint32_t blockCount, void *ptr) final;
+
+public:
+	/**
+	 * Advise the disc image of an upcoming read.
+	 *
+	 * The 2048-byte logical extent is translated into the
+	 * corresponding raw sector extent and forwarded to the
+	 * underlying file.
+	 *
+	 * @param offset	[in] Start of the range that will be read.
+	 * @param size		[in] Length of the range, in bytes.
+	 * @return 0 on success; negative POSIX error code on error.
+	 */
+	int advise(off64_t offset, size_t size) final;
 };
 
 }
@@ -43,6 +43,9 @@
 using namespace LibRpBase;
 using namespace LibRpFile;
 
+// C++ STL classes
+#include <thread>
+
 namespace LibRomData {
 
 #ifdef _MSC_VER
@@ -109,6 +112,19 @@ public:
 	uint8_t index_shift;		// Index shift value (CISO/ZISO only)
 	bool isDaxWithoutNCTable;	// Convenience variable
 
+	// Readahead windows (double-buffered)
+	// readBlocks() prefetches the next window's compressed data on a
+	// worker thread while the current window is being decompressed.
+	struct ReadaheadWindow {
+		rp::uvector<uint8_t> buf;
+		off64_t addr;	// Physical address. (-1 if the window is empty)
+		size_t len;	// Valid data length, in bytes.
+
+		ReadaheadWindow() : addr(-1), len(0) { }
+	};
+	std::array<ReadaheadWindow, 2> raWindow;
+	unsigned int raCur;	// Current (front) window index.
+
 	/**
 	 * Get the compressed size of a block.
 	 * @param blockNum Block number.
@@ -125,6 +141,7 @@ CisoPspReaderPrivate::CisoPspReaderPrivate(CisoPspReader *q)
 	, blockCacheIdx(~0U)
 	, index_shift(0)
 	, isDaxWithoutNCTable(false)
+	, raCur(0)
 {
 	// Clear the header structs.
 	memset(&header, 0, sizeof(header));
@@ -899,7 +916,7 @@ int CisoPspReader::readBlock(uint32_t blockIdx, int pos, void *ptr, size_t size)
 
 		case CompressionMode::None: {
 			// Reading uncompressed data directly into the cache.
-			size_t sz_read = m_file->seekAndRead(physBlockAddr, d->blockCache.data(), z_block_size);
+			size_t sz_read = this->readPhys(physBlockAddr, d->blockCache.data(), z_block_size);
 			if (sz_read != z_block_size) {
 				// Seek and/or read error.
 				d->blockCacheIdx = ~0U;
@@ -933,7 +950,7 @@ int CisoPspReader::readBlock(uint32_t blockIdx, int pos, void *ptr, size_t size)
 				return 0;
 			}
 
-			size_t sz_read = m_file->seekAndRead(physBlockAddr, d->z_buffer.data(), z_block_size);
+			size_t sz_read = this->readPhys(physBlockAddr, d->z_buffer.data(), z_block_size);
 			if (sz_read != z_block_size) {
 				// Seek and/or read error.
 				m_lastError = m_file->lastError();
@@ -982,7 +999,7 @@ int CisoPspReader::readBlock(uint32_t blockIdx, int pos, void *ptr, size_t size)
 				return 0;
 			}
 
-			size_t sz_read = m_file->seekAndRead(physBlockAddr, d->z_buffer.data(), z_block_size);
+			size_t sz_read = this->readPhys(physBlockAddr, d->z_buffer.data(), z_block_size);
 			if (sz_read != z_block_size) {
 				// Seek and/or read error.
 				m_lastError = m_file->lastError();
@@ -1030,7 +1047,7 @@ int CisoPspReader::readBlock(uint32_t blockIdx, int pos, void *ptr, size_t size)
 				return 0;
 			}
 
-			size_t sz_read = m_file->seekAndRead(physBlockAddr, d->z_buffer.data(), z_block_size);
+			size_t sz_read = this->readPhys(physBlockAddr, d->z_buffer.data(), z_block_size);
 			if (sz_read != z_block_size) {
 				// Seek and/or read error.
 				m_lastError = m_file->lastError();
@@ -1069,4 +1086,174 @@ int CisoPspReader::readBlock(uint32_t blockIdx, int pos, void *ptr, size_t size)
 	return static_cast<int>(size);
 }
 
+/**
+ * Read data at a physical address, using the current readahead window
+ * if the requested range is fully contained in it.
+ *
+ * @param addr	[in] Physical address.
+ * @param ptr	[out] Output data buffer.
+ * @param size	[in] Amount of data to read, in bytes.
+ * @return Number of bytes read.
+ */
+size_t CisoPspReader::readPhys(off64_t addr, void *ptr, size_t size)
+{
+	RP_D(CisoPspReader);
+	const CisoPspReaderPrivate::ReadaheadWindow &w = d->raWindow[d->raCur];
+	if (w.addr >= 0 && addr >= w.addr &&
+	    static_cast<off64_t>(addr + size) <= static_cast<off64_t>(w.addr + w.len))
+	{
+		// Fully contained in the readahead window.
+		memcpy(ptr, &w.buf[static_cast<size_t>(addr - w.addr)], size);
+		return size;
+	}
+
+	// Not in the window. Read from the file.
+	return m_file->seekAndRead(addr, ptr, size);
+}
+
+/**
+ * Read multiple consecutive full blocks.
+ *
+ * The compressed data is read in large windows, and the next window
+ * is prefetched on a worker thread while the current one is being
+ * decompressed, overlapping file I/O with LZ4/deflate work.
+ *
+ * @param blockIdx	[in] Starting block index.
+ * @param blockCount	[in] Number of blocks to read.
+ * @param ptr		[out] Output data buffer. (Must be at least blockCount * block_size bytes.)
+ * @return Number of full blocks read. (< blockCount on error or short read)
+ */
+int CisoPspReader::readBlocks(uint32_t blockIdx, uint32_t blockCount, void *ptr)
+{
+	RP_D(CisoPspReader);
+	if (blockCount < 2) {
+		// Not worth setting up readahead.
+		return super::readBlocks(blockIdx, blockCount, ptr);
+	}
+
+	// Plan spans of blocks whose compressed data will be loaded
+	// into one readahead window each.
+	static constexpr size_t RA_WINDOW_SIZE = 1U*1024*1024;
+	struct Span {
+		uint32_t startBlock;
+		uint32_t numBlocks;
+		off64_t physStart;	// -1 if the span can't be readahead
+		size_t physLen;
+	};
+	std::vector<Span> spans;
+	for (uint32_t i = 0; i < blockCount; ) {
+		const off64_t addr = getPhysBlockAddr(blockIdx + i);
+		const uint32_t z_size = d->getBlockCompressedSize(blockIdx + i);
+		if (addr < 0 || z_size == 0) {
+			// Can't plan this block. Read it individually.
+			spans.push_back({blockIdx + i, 1, -1, 0});
+			i++;
+			continue;
+		}
+
+		Span span = {blockIdx + i, 1, addr, static_cast<size_t>(z_size)};
+		i++;
+		for (; i < blockCount; i++) {
+			const off64_t naddr = getPhysBlockAddr(blockIdx + i);
+			const uint32_t nsize = d->getBlockCompressedSize(blockIdx + i);
+			if (naddr < span.physStart || nsize == 0) {
+				// Out of order, or size unavailable.
+				break;
+			}
+			const size_t newLen = static_cast<size_t>(naddr - span.physStart) + nsize;
+			if (newLen > RA_WINDOW_SIZE) {
+				// Window is full.
+				break;
+			}
+			span.numBlocks++;
+			if (newLen > span.physLen) {
+				span.physLen = newLen;
+			}
+		}
+		spans.push_back(span);
+	}
+
+	// Load a span's compressed data into a readahead window.
+	auto loadWindow = [this](CisoPspReaderPrivate::ReadaheadWindow &w, const Span &span) {
+		if (span.physStart < 0 || span.physLen == 0) {
+			w.addr = -1;
+			w.len = 0;
+			return;
+		}
+		if (w.buf.size() < span.physLen) {
+			w.buf.resize(span.physLen);
+		}
+		size_t sz = m_file->seekAndRead(span.physStart, w.buf.data(), span.physLen);
+		w.addr = span.physStart;
+		w.len = sz;
+	};
+
+	// Load the first window synchronously.
+	loadWindow(d->raWindow[d->raCur], spans[0]);
+
+	uint8_t *ptr8 = static_cast<uint8_t*>(ptr);
+	uint32_t blocksRead = 0;
+	for (size_t si = 0; si < spans.size(); si++) {
+		const Span &span = spans[si];
+
+		// Prefetch the next span into the back window.
+		// NOTE: m_file is only accessed by the prefetch thread
+		// while decompression is running; in-window reads are
+		// served from memory.
+		std::thread raThread;
+		if (si + 1 < spans.size()) {
+			CisoPspReaderPrivate::ReadaheadWindow &back = d->raWindow[d->raCur ^ 1];
+			const Span &next = spans[si + 1];
+			raThread = std::thread([&loadWindow, &back, &next]() {
+				loadWindow(back, next);
+			});
+		}
+
+		// Decompress this span's blocks from the front window.
+		// Blocks that aren't fully in the window (e.g. short read
+		// at EOF) are deferred until the prefetch thread is done,
+		// since the fallback path reads from m_file directly.
+		const CisoPspReaderPrivate::ReadaheadWindow &front = d->raWindow[d->raCur];
+		uint32_t b = 0;
+		for (; b < span.numBlocks; b++) {
+			const uint32_t idx = span.startBlock + b;
+			const off64_t addr = getPhysBlockAddr(idx);
+			const uint32_t z_size = d->getBlockCompressedSize(idx);
+			if (front.addr < 0 || addr < front.addr ||
+			    static_cast<off64_t>(addr + z_size) > static_cast<off64_t>(front.addr + front.len))
+			{
+				// Not fully in the window.
+				break;
+			}
+
+			int rd = this->readBlock(idx, 0,
+				&ptr8[static_cast<size_t>(blocksRead + b) * d->block_size], d->block_size);
+			if (rd != static_cast<int>(d->block_size)) {
+				// Decompression error.
+				break;
+			}
+		}
+
+		if (raThread.joinable()) {
+			raThread.join();
+		}
+
+		// Handle any remaining blocks in this span directly.
+		for (; b < span.numBlocks; b++) {
+			const uint32_t idx = span.startBlock + b;
+			int rd = this->readBlock(idx, 0,
+				&ptr8[static_cast<size_t>(blocksRead + b) * d->block_size], d->block_size);
+			if (rd != static_cast<int>(d->block_size)) {
+				// Error reading the data.
+				return static_cast<int>(blocksRead + b);
+			}
+		}
+
+		blocksRead += span.numBlocks;
+		d->raCur ^= 1;
+	}
+
+	return static_cast<int>(blocksRead);
+}
+
 }
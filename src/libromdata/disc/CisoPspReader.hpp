@@ -76,6 +76,34 @@ protected:
 	 */
 	ATTR_ACCESS_SIZE(write_only, 4, 5)
 	int readBlock(uint32_t blockIdx, int pos, void *ptr, size_t size) final;
+
+	/**
+	 * Read multiple consecutive full blocks.
+	 *
+	 * The compressed data is read in large windows, and the next
+	 * window is prefetched on a worker thread while the current one
+	 * is being decompressed, overlapping file I/O with LZ4/deflate
+	 * work.
+	 *
+	 * @param blockIdx	[in] Starting block index.
+	 * @param blockCount	[in] Number of blocks to read.
+	 * @param ptr		[out] Output data buffer. (Must be at least blockCount * block_size bytes.)
+	 * @return Number of full blocks read. (< blockCount on error or short read)
+	 */
+	int readBlocks(uint32_t blockIdx, uint32_t blockCount, void *ptr) final;
+
+private:
+	/**
+	 * Read data at a physical address, using the current readahead
+	 * window if the requested range is fully contained in it.
+	 *
+	 * @param addr	[in] Physical address.
+	 * @param ptr	[out] Output data buffer.
+	 * @param size	[in] Amount of data to read, in bytes.
+	 * @return Number of bytes read.
+	 */
+	ATTR_ACCESS_SIZE(write_only, 3, 4)
+	size_t readPhys(off64_t addr, void *ptr, size_t size);
 };
 
 }
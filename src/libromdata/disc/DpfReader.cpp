@@ -15,12 +15,16 @@
 #include "DpfReader.hpp"
 #include "dpf_structs.h"
 
+// for SparseDiscReaderPrivate::ExtentRun
+#include "librpbase/disc/SparseDiscReader_p.hpp"
+
 // Other rom-properties libraries
 using namespace LibRpBase;
 using namespace LibRpFile;
 
 // C++ STL classes
 using std::unique_ptr;
+using std::vector;
 
 namespace LibRomData {
 
@@ -36,8 +40,10 @@ public:
 	// DPF/RPF header
 	DpfHeader dpfHeader;
 
-	// RPF entries (DPF entries are converted to RPF on load)
-	rp::uvector<RpfEntry> entries;
+	// Extent map, coalesced from the RPF entries on load.
+	// (DPF entries are converted to RPF first.)
+	// Sorted by virtual offset; binary-searched on read.
+	vector<SparseDiscReaderPrivate::ExtentRun> extentMap;
 
 public:
 	// Disc size
@@ -116,14 +122,15 @@ DpfReader::DpfReader(const IRpFilePtr &file)
 	}
 
 	// Load the entry table.
-	d->entries.resize(d->dpfHeader.entry_count);
+	// NOTE: Coalesced into d->extentMap below; the raw table is discarded.
+	rp::uvector<RpfEntry> entries;
+	entries.resize(d->dpfHeader.entry_count);
 	if (d->dpfHeader.magic == RPF_MAGIC) {
 		// RPF: Load it directly.
 		const size_t load_size = d->dpfHeader.entry_count * sizeof(RpfEntry);
-		size_t size = m_file->seekAndRead(d->dpfHeader.entry_table_offset, d->entries.data(), load_size);
+		size_t size = m_file->seekAndRead(d->dpfHeader.entry_table_offset, entries.data(), load_size);
 		if (size != load_size) {
 			// Load error.
-			d->entries.clear();
 			m_file.reset();
 			m_lastError = EIO;
 			return;
@@ -136,7 +143,7 @@ DpfReader::DpfReader(const IRpFilePtr &file)
 #if SYS_BYTEORDER != SYS_LIL_ENDIAN
 		// Value are stored in little-endian on disk.
 		// Convert to host-endian.
-		for (auto &p : d->entries) {
+		for (auto &p : entries) {
 			p.virt_offset = le64_to_cpu(p.virt_offset);
 			p.phys_offset = le64_to_cpu(p.phys_offset);
 			p.size = le32_to_cpu(p.size);
@@ -150,7 +157,6 @@ DpfReader::DpfReader(const IRpFilePtr &file)
 		size_t size = m_file->seekAndRead(d->dpfHeader.entry_table_offset, dpf_entry_buf.get(), load_size);
 		if (size != load_size) {
 			// Load error.
-			d->entries.clear();
 			m_file.reset();
 			m_lastError = EIO;
 			return;
@@ -158,16 +164,15 @@ DpfReader::DpfReader(const IRpFilePtr &file)
 
 		// TODO: Use pointer arithmetic?
 		for (unsigned int i = 0; i < d->dpfHeader.entry_count; i++) {
-			d->entries[i].virt_offset = static_cast<uint64_t>(le32_to_cpu(dpf_entry_buf[i].virt_offset));
-			d->entries[i].phys_offset = static_cast<uint64_t>(le32_to_cpu(dpf_entry_buf[i].phys_offset));
-			d->entries[i].size = le32_to_cpu(dpf_entry_buf[i].size);
-			d->entries[i].unknown_14 = le32_to_cpu(dpf_entry_buf[i].unknown_0C);
+			entries[i].virt_offset = static_cast<uint64_t>(le32_to_cpu(dpf_entry_buf[i].virt_offset));
+			entries[i].phys_offset = static_cast<uint64_t>(le32_to_cpu(dpf_entry_buf[i].phys_offset));
+			entries[i].size = le32_to_cpu(dpf_entry_buf[i].size);
+			entries[i].unknown_14 = le32_to_cpu(dpf_entry_buf[i].unknown_0C);
 		}
 	}
 
 	// Make sure entries are sorted by virtual address.
-	// TODO: Remove zero-length entries?
-	std::sort(d->entries.begin(), d->entries.end(),
+	std::sort(entries.begin(), entries.end(),
 		[](const RpfEntry &a, const RpfEntry &b) {
 			return (a.virt_offset < b.virt_offset);
 		});
@@ -175,27 +180,52 @@ DpfReader::DpfReader(const IRpFilePtr &file)
 	// The first entry should be virt=0, phys=0.
 	// If it isn't, we'll need to adjust offsets in order to read the beginning of the disc.
 	// TODO: Currently only virt=0, phys!=0.
-	if (d->entries[0].virt_offset == 0 && d->entries[0].phys_offset != 0) {
+	if (entries[0].virt_offset == 0 && entries[0].phys_offset != 0) {
 		// Need to add an extra entry.
-		const uint32_t entry_size = static_cast<uint32_t>(d->entries[0].phys_offset);
+		const uint32_t entry_size = static_cast<uint32_t>(entries[0].phys_offset);
 		const RpfEntry first_entry = {
 			0,		// virt_offset
 			0,		// phys_offset
 			entry_size,	// size
 			0		// unknown_14
 		};
-		d->entries.insert(d->entries.begin(), first_entry);
+		entries.insert(entries.begin(), first_entry);
 
 		// Adjust the virtual address for the remaining entries.
-		for (auto &p : d->entries) {
+		for (auto &p : entries) {
 			p.virt_offset += entry_size;
 		}
 	}
 
 	// Disc size is the highest virtual address, plus size.
-	const auto &last_entry = *(d->entries.crbegin());
+	const auto &last_entry = *(entries.crbegin());
 	d->disc_size = last_entry.virt_offset + last_entry.size;
 
+	// Coalesce the entries into extent runs.
+	// Zero-length entries are dropped, and entries that are
+	// contiguous both virtually and physically are merged.
+	d->extentMap.reserve(entries.size());
+	for (const auto &p : entries) {
+		if (p.size == 0)
+			continue;
+
+		const off64_t virt = static_cast<off64_t>(p.virt_offset);
+		const off64_t phys = static_cast<off64_t>(p.phys_offset);
+		if (!d->extentMap.empty()) {
+			auto &last = d->extentMap.back();
+			if (virt == last.virt_start + last.size &&
+			    phys == last.phys_start + last.size)
+			{
+				// Extend the last run.
+				last.size += p.size;
+				continue;
+			}
+		}
+
+		// Start a new run.
+		d->extentMap.push_back({virt, phys, static_cast<off64_t>(p.size)});
+	}
+
 	// Reset the disc position.
 	d->pos = 0;
 }
@@ -283,47 +313,18 @@ size_t DpfReader::read(void *ptr, size_t size)
 	}
 
 	while (size > 0) {
-		uint64_t virt_start = 0;
-		off64_t phys_offset = -1;
-		size_t virt_size = 0;
-
-		// Find the sparse entry for the current position.
-		// NOTE: Sparse entries are sorted by virtual offset.
-		// TODO: Cache it for d->pos?
-		for (const auto &p : d->entries) {
-			if (p.size == 0)
-				continue;
-
-			if (d->pos < (int64_t)p.virt_offset) {
-				// Requested position is before this entry. This means we don't have a valid entry...
-				phys_offset = -1;
-				break;
-			}
-
-			const int64_t virt_end = static_cast<int64_t>(p.virt_offset) + p.size;
-			if (d->pos >= (int64_t)p.virt_offset && d->pos < virt_end) {
-				// Requested position starts within this entry.
-				virt_start = p.virt_offset;
-				virt_size = static_cast<size_t>(p.size);
-				phys_offset = p.phys_offset;
-
-				// Seek to the current physical position.
-				m_file->seek(phys_offset + (d->pos - virt_start) + d->dpfHeader.data_offset);
-				break;
-			}
-
-			// Requested position is after this entry.
-			// Keep going.
-		}
-		if (virt_size == 0) {
+		// Find the extent run for the current position.
+		// NOTE: Runs are sorted by virtual offset.
+		const auto *const run = SparseDiscReaderPrivate::lookupExtent(d->extentMap, d->pos);
+		if (!run) {
 			// Section not found...
 			break;
 		}
+		const off64_t skip = d->pos - run->virt_start;
 
-		// Read up to virt_size bytes.
-		if (phys_offset < 0) {
+		if (run->phys_start < 0) {
 			// Zero section
-			const size_t to_zero = std::min(size, virt_size);
+			const size_t to_zero = std::min(size, static_cast<size_t>(run->size - skip));
 			// FIXME: memset() here is causing an ICE in gcc-13.2.0.
 			//memset(ptr8, 0, to_zero);
 			//ptr8 += to_zero;
@@ -335,7 +336,9 @@ size_t DpfReader::read(void *ptr, size_t size)
 			ret += to_zero;
 		} else {
 			// Data section
-			size_t to_read = std::min(size, virt_size - static_cast<size_t>(d->pos - virt_start));
+			// Seek to the current physical position.
+			m_file->seek(run->phys_start + skip + d->dpfHeader.data_offset);
+			size_t to_read = std::min(size, static_cast<size_t>(run->size - skip));
 			size_t has_read = m_file->read(ptr8, to_read);
 			size -= has_read;
 			ptr8 += has_read;
@@ -49,6 +49,13 @@ public:
 	// - Value: string.
 	mutable unordered_map<uint32_t, string> u8_string_table;
 
+	// Path index, built incrementally by find_path().
+	// - Key: Normalized absolute path.
+	// - Value: FST entry index.
+	// Directories are indexed as they're traversed, so repeated
+	// lookups only scan directories that haven't been seen before.
+	mutable unordered_map<string, uint32_t> path_index;
+
 	/**
 	 * Check if an fst_entry is a directory.
 	 * @return True if this is a directory; false if it's a regular file.
@@ -121,13 +128,10 @@ GcnFstPrivate::GcnFstPrivate(const uint8_t *fstData, uint32_t len, uint8_t offse
 		return;
 	}
 
-	// Sanity check: String table cannot contain '/'.
+	// NOTE: Individual names are validated on demand in entry_name()
+	// instead of scanning the entire string table here, so FSTs with
+	// 100k+ entries don't pay for entries that are never traversed.
 	string_table_sz = fstData_sz - string_table_offset;
-	if (memchr(&fstData[string_table_offset], '/', string_table_sz) != nullptr) {
-		// String table has '/'!
-		hasErrors = true;
-		return;
-	}
 
 	// Copy the FST data.
 	// NOTE: +1 for NULL termination.
@@ -139,11 +143,9 @@ GcnFstPrivate::GcnFstPrivate(const uint8_t *fstData, uint32_t len, uint8_t offse
 	// Save a pointer to the string table.
 	string_table_ptr = reinterpret_cast<char*>(&fst8[string_table_offset]);
 
-#ifdef HAVE_UNORDERED_MAP_RESERVE
-	// Reserve space in the string table.
-	// NOTE: file_count includes the root directory entry.
-	u8_string_table.reserve(file_count - 1);
-#endif
+	// NOTE: Not reserving u8_string_table space for the full file
+	// count anymore. Names are converted lazily, and most use cases
+	// only touch the root directory or a single file lookup.
 }
 
 GcnFstPrivate::~GcnFstPrivate()
@@ -186,6 +188,10 @@ inline const char *GcnFstPrivate::entry_name(const GCN_FST_Entry *fst_entry) con
 	// Do the conversion now.
 	const char *str = &string_table_ptr[offset];
 	int len = static_cast<int>(strlen(str));	// TODO: Bounds checking.
+	if (memchr(str, '/', len) != nullptr) {
+		// Sanity check: Names cannot contain '/'.
+		return nullptr;
+	}
 	const string u8str = cp1252_sjis_to_utf8(str, len);
 	iter = u8_string_table.emplace(offset, u8str).first;
 	return iter->second.c_str();
@@ -270,15 +276,41 @@ const GCN_FST_Entry *GcnFstPrivate::find_path(const char *path) const
 		return fst_entry;
 	}
 
-	// Set of directory indexes that have already been processed.
-	// Used to prevent infinite loops if the FST has weird corruption.
-	std::unordered_set<int> idx_already;
-
 	// Skip the initial slash.
 	int idx = 1;	// Ignore the root directory.
 	// NOTE: This is the index *after* the last file.
 	int last_fst_idx = be32_to_cpu(fst_entry->root_dir.file_count);
 	size_t slash_pos = 0;
+
+	// Check the path index for this path, or for the longest
+	// parent directory that has already been resolved.
+	auto idx_iter = path_index.find(s_path);
+	if (idx_iter != path_index.end()) {
+		// Exact match.
+		return this->entry(static_cast<int>(idx_iter->second), nullptr);
+	}
+	for (size_t pfx = s_path.rfind('/'); pfx != 0 && pfx != string::npos;
+	     pfx = s_path.rfind('/', pfx - 1))
+	{
+		idx_iter = path_index.find(s_path.substr(0, pfx));
+		if (idx_iter == path_index.end())
+			continue;
+
+		// Found a resolved parent directory.
+		// Resume the traversal from here.
+		const GCN_FST_Entry *const dir_entry = this->entry(static_cast<int>(idx_iter->second), nullptr);
+		if (!dir_entry || !is_dir(dir_entry))
+			break;
+		idx = static_cast<int>(idx_iter->second) + 1;
+		last_fst_idx = be32_to_cpu(dir_entry->dir.next_offset);
+		slash_pos = pfx;
+		break;
+	}
+
+	// Set of directory indexes that have already been processed.
+	// Used to prevent infinite loops if the FST has weird corruption.
+	std::unordered_set<int> idx_already;
+
 	do {
 		const size_t next_slash_pos = s_path.find('/', slash_pos + 1);
 		string path_component;
@@ -346,6 +378,12 @@ const GCN_FST_Entry *GcnFstPrivate::find_path(const char *path) const
 		if (is_dir(fst_entry)) {
 			// Directory. Save the last_fst_idx.
 			last_fst_idx = be32_to_cpu(fst_entry->dir.next_offset);
+
+			// Record this directory in the path index.
+			path_index.emplace((next_slash_pos == string::npos)
+				? s_path
+				: s_path.substr(0, next_slash_pos),
+				static_cast<uint32_t>(idx));
 			idx++;
 		} else {
 			// File: Make sure there's no more slashes.
@@ -353,6 +391,9 @@ const GCN_FST_Entry *GcnFstPrivate::find_path(const char *path) const
 				// More slashes. Not a match.
 				return nullptr;
 			}
+
+			// Record this file in the path index.
+			path_index.emplace(s_path, static_cast<uint32_t>(idx));
 		}
 
 		// Next slash.
@@ -140,6 +140,11 @@ int GcnPartitionPrivate::loadFst(void)
 		return -EIO;
 	}
 
+	// Hint the underlying reader that the FST is about to be read.
+	q->m_file->advise(data_offset +
+		(static_cast<off64_t>(bootBlock.fst_offset) << offsetShift),
+		static_cast<size_t>(bootBlock.fst_size) << offsetShift);
+
 	// Seek to the beginning of the FST.
 	ret = q->seek(static_cast<off64_t>(bootBlock.fst_offset) << offsetShift);
 	if (ret != 0) {
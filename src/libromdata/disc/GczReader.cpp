@@ -28,6 +28,12 @@
 using namespace LibRpBase;
 using namespace LibRpFile;
 
+// C++ STL classes
+#include <atomic>
+#include <thread>
+using std::thread;
+using std::vector;
+
 namespace LibRomData {
 
 #ifdef _MSC_VER
@@ -507,4 +513,183 @@ int GczReader::readBlock(uint32_t blockIdx, int pos, void *ptr, size_t size)
 	return static_cast<int>(size);
 }
 
+/**
+ * Read multiple consecutive full blocks.
+ *
+ * Blocks are independent zlib streams, so bulk reads are
+ * decompressed on multiple threads. Falls back to the serial
+ * implementation for small reads and single-core systems.
+ *
+ * @param blockIdx	[in] Starting block index.
+ * @param blockCount	[in] Number of blocks to read.
+ * @param ptr		[out] Output data buffer. (Must be at least blockCount * block_size bytes.)
+ * @return Number of full blocks read. (< blockCount on error or short read)
+ */
+int GczReader::readBlocks(uint32_t blockIdx, uint32_t blockCount, void *ptr)
+{
+	RP_D(GczReader);
+
+	unsigned int threads = thread::hardware_concurrency();
+	if (threads > 8) {
+		threads = 8;
+	}
+	if (blockCount < 4 || threads <= 1) {
+		// Not worth spinning up worker threads.
+		return super::readBlocks(blockIdx, blockCount, ptr);
+	}
+	if (threads > blockCount) {
+		threads = blockCount;
+	}
+
+	// Per-block decompression job.
+	// I/O is done sequentially on this thread; workers only inflate.
+	struct BlockJob {
+		rp::uvector<uint8_t> z_data;	// Compressed data. (empty if stored uncompressed)
+		uint32_t z_block_size;
+		int result;			// 0 == OK; negative POSIX error code on error
+	};
+
+	uint8_t *ptr8 = static_cast<uint8_t*>(ptr);
+	uint32_t blocksRead = 0;
+
+	// Process the read in batches to bound the amount of
+	// compressed data buffered at once.
+	const uint32_t batch_max = threads * 8;
+	vector<BlockJob> jobs;
+	while (blocksRead < blockCount) {
+		const uint32_t batch = std::min(blockCount - blocksRead, batch_max);
+		jobs.clear();
+		jobs.resize(batch);
+
+		// Read the compressed extents sequentially.
+		uint32_t loaded = 0;
+		for (; loaded < batch; loaded++) {
+			const uint32_t idx = blockIdx + blocksRead + loaded;
+			if (idx >= d->blockPointers.size()) {
+				break;
+			}
+			BlockJob &job = jobs[loaded];
+
+			const uint64_t blockPointer = le64_to_cpu(d->blockPointers[idx]);
+			const off64_t physBlockAddr = static_cast<off64_t>(blockPointer & ~GCZ_FLAG_BLOCK_NOT_COMPRESSED) + d->dataOffset;
+			job.z_block_size = d->getBlockCompressedSize(idx);
+			if (job.z_block_size == 0) {
+				m_lastError = EIO;
+				break;
+			}
+
+			if (blockPointer & GCZ_FLAG_BLOCK_NOT_COMPRESSED) {
+				// Uncompressed block. Read it directly into the output buffer.
+				if (job.z_block_size != d->block_size) {
+					m_lastError = EIO;
+					break;
+				}
+				uint8_t *const p_out = &ptr8[static_cast<size_t>(blocksRead + loaded) * d->block_size];
+				size_t sz_read = m_file->seekAndRead(physBlockAddr, p_out, d->block_size);
+				if (sz_read != d->block_size) {
+					m_lastError = m_file->lastError();
+					if (m_lastError == 0) {
+						m_lastError = EIO;
+					}
+					break;
+				}
+				job.result = 0;
+			} else {
+				// Compressed block. Read it into the job buffer.
+				if (job.z_block_size > d->block_size) {
+					m_lastError = EIO;
+					break;
+				}
+				job.z_data.resize(job.z_block_size);
+				size_t sz_read = m_file->seekAndRead(physBlockAddr, job.z_data.data(), job.z_block_size);
+				if (sz_read != job.z_block_size) {
+					m_lastError = m_file->lastError();
+					if (m_lastError == 0) {
+						m_lastError = EIO;
+					}
+					break;
+				}
+				job.result = -EINPROGRESS;
+			}
+		}
+
+		if (loaded == 0) {
+			// Nothing could be loaded.
+			break;
+		}
+
+		// Inflate the compressed blocks on worker threads.
+		// Each thread reuses a single z_stream via inflateReset().
+		std::atomic<uint32_t> nextIdx(0);
+		auto workerFn = [this, d, &jobs, &nextIdx, blockIdx, loaded, blocksRead, ptr8]() {
+			z_stream z = { };
+			bool z_init = false;
+			for (;;) {
+				const uint32_t i = nextIdx.fetch_add(1);
+				if (i >= loaded) {
+					break;
+				}
+				BlockJob &job = jobs[i];
+				if (job.result != -EINPROGRESS) {
+					// Uncompressed block; already handled.
+					continue;
+				}
+
+				// Verify the hash of the *compressed* data.
+				uint32_t hash_calc = adler32(0L, Z_NULL, 0);
+				hash_calc = adler32(hash_calc, job.z_data.data(), job.z_block_size);
+				if (hash_calc != le32_to_cpu(d->hashes[blockIdx + blocksRead + i])) {
+					// Hash error.
+					job.result = -EIO;
+					continue;
+				}
+
+				if (!z_init) {
+					inflateInit(&z);
+					z_init = true;
+				} else {
+					inflateReset(&z);
+				}
+				z.next_in = job.z_data.data();
+				z.avail_in = job.z_block_size;
+				z.next_out = &ptr8[static_cast<size_t>(blocksRead + i) * d->block_size];
+				z.avail_out = d->block_size;
+
+				int status = inflate(&z, Z_FULL_FLUSH);
+				const uint32_t uncomp_size = d->block_size - z.avail_out;
+				job.result = (status == Z_STREAM_END && uncomp_size == d->block_size) ? 0 : -EIO;
+			}
+			if (z_init) {
+				inflateEnd(&z);
+			}
+		};
+
+		vector<thread> workers;
+		workers.reserve(threads - 1);
+		for (unsigned int t = 0; t < threads - 1; t++) {
+			workers.emplace_back(workerFn);
+		}
+		workerFn();
+		for (thread &t : workers) {
+			t.join();
+		}
+
+		// Count consecutive successful blocks.
+		uint32_t batch_ok = 0;
+		for (; batch_ok < loaded; batch_ok++) {
+			if (jobs[batch_ok].result != 0) {
+				m_lastError = -jobs[batch_ok].result;
+				break;
+			}
+		}
+		blocksRead += batch_ok;
+		if (batch_ok != batch) {
+			// Error or short batch.
+			break;
+		}
+	}
+
+	return static_cast<int>(blocksRead);
+}
+
 }
@@ -76,6 +76,20 @@ protected:
 	 */
 	ATTR_ACCESS_SIZE(write_only, 4, 5)
 	int readBlock(uint32_t blockIdx, int pos, void *ptr, size_t size) final;
+
+	/**
+	 * Read multiple consecutive full blocks.
+	 *
+	 * Blocks are independent zlib streams, so bulk reads are
+	 * decompressed on multiple threads. Falls back to the serial
+	 * implementation for small reads and single-core systems.
+	 *
+	 * @param blockIdx	[in] Starting block index.
+	 * @param blockCount	[in] Number of blocks to read.
+	 * @param ptr		[out] Output data buffer. (Must be at least blockCount * block_size bytes.)
+	 * @return Number of full blocks read. (< blockCount on error or short read)
+	 */
+	int readBlocks(uint32_t blockIdx, uint32_t blockCount, void *ptr) final;
 };
 
 }
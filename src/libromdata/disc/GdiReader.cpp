@@ -623,6 +623,145 @@ int GdiReader::readBlock(uint32_t blockIdx, int pos, void *ptr, size_t size)
 	return (sz_read > 0 ? static_cast<int>(sz_read) : -1);
 }
 
+/**
+ * Read multiple consecutive full blocks.
+ *
+ * Blocks are read per-track: 2048-byte tracks are read directly
+ * into the output buffer, and 2352-byte tracks are read in raw
+ * batches with the user data area extracted from each sector.
+ *
+ * @param blockIdx	[in] Starting block index.
+ * @param blockCount	[in] Number of blocks to read.
+ * @param ptr		[out] Output data buffer. (Must be at least blockCount * block_size bytes.)
+ * @return Number of full blocks read. (< blockCount on error or short read)
+ */
+int GdiReader::readBlocks(uint32_t blockIdx, uint32_t blockCount, void *ptr)
+{
+	// NOTE: This can only be called by SparseDiscReader,
+	// so the main assertions are already checked there.
+	RP_D(GdiReader);
+	if (unlikely(blockCount == 0)) {
+		// Nothing to read.
+		return 0;
+	}
+
+	static constexpr uint32_t SECTORS_PER_BATCH = 64;
+	rp::uvector<uint8_t> rawBuf;
+
+	uint8_t *ptr8 = static_cast<uint8_t*>(ptr);
+	uint32_t blocksRead = 0;
+	while (blocksRead < blockCount) {
+		const uint32_t curBlock = blockIdx + blocksRead;
+
+		// Find the track containing this block.
+		// TODO: Cache this lookup somewhere or something.
+		const GdiReaderPrivate::BlockRange *blockRange = nullptr;
+		for (const GdiReaderPrivate::BlockRange &vbr : d->blockRanges) {
+			if (curBlock < vbr.blockStart) {
+				// Not in this track.
+				continue;
+			}
+
+			// Is the track loaded?
+			if (vbr.blockEnd == 0) {
+				// Track isn't loaded. Load it.
+				int ret = d->openTrack(vbr.trackNumber);
+				if (ret != 0) {
+					// Unable to load the track.
+					// Skip for now.
+					continue;
+				}
+			}
+
+			// Check the end block.
+			if (vbr.blockEnd != 0 && curBlock <= vbr.blockEnd) {
+				// Found the track.
+				blockRange = (const GdiReaderPrivate::BlockRange*)&vbr;
+				break;
+			}
+		}
+
+		if (!blockRange || !blockRange->file) {
+			// Not found in any block range,
+			// or the file isn't open.
+			break;
+		}
+
+		// Number of requested blocks remaining in this track.
+		const uint32_t spanCount = std::min(blockCount - blocksRead,
+			blockRange->blockEnd - curBlock + 1);
+		const off64_t phys_pos = (static_cast<off64_t>(curBlock - blockRange->blockStart) * blockRange->sectorSize);
+
+		if (blockRange->sectorSize == 2048) {
+			// 2048-byte sectors: read directly into the output buffer.
+			const size_t sz_expected = static_cast<size_t>(spanCount) * 2048;
+			const size_t sz_read = blockRange->file->seekAndRead(phys_pos, ptr8, sz_expected);
+			const uint32_t sectorsOK = static_cast<uint32_t>(sz_read / 2048);
+			blocksRead += sectorsOK;
+			ptr8 += static_cast<size_t>(sectorsOK) * 2048;
+			if (sz_read != sz_expected) {
+				// Short read.
+				m_lastError = blockRange->file->lastError();
+				break;
+			}
+			continue;
+		}
+
+		// 2352-byte sectors: read the raw sectors in batches and
+		// extract the user data area from each one.
+		// TODO: Handle audio tracks properly?
+		rawBuf.resize(std::min(spanCount, SECTORS_PER_BATCH) * 2352);
+		uint32_t spanDone = 0;
+		while (spanDone < spanCount) {
+			const uint32_t inBatch = std::min(spanCount - spanDone, SECTORS_PER_BATCH);
+			const size_t sz_expected = static_cast<size_t>(inBatch) * 2352;
+			const size_t sz_read = blockRange->file->seekAndRead(
+				phys_pos + (static_cast<off64_t>(spanDone) * 2352), rawBuf.data(), sz_expected);
+
+			// NOTE: Sector user data area position depends on the sector mode.
+			const uint32_t sectorsOK = static_cast<uint32_t>(sz_read / 2352);
+			for (uint32_t i = 0; i < sectorsOK; i++) {
+				const CDROM_2352_Sector_t *const sector =
+					reinterpret_cast<const CDROM_2352_Sector_t*>(&rawBuf[i * 2352]);
+				memcpy(ptr8, cdromSectorDataPtr(sector), d->block_size);
+				ptr8 += d->block_size;
+			}
+
+			spanDone += sectorsOK;
+			if (sectorsOK != inBatch) {
+				// Short read.
+				m_lastError = blockRange->file->lastError();
+				break;
+			}
+		}
+
+		blocksRead += spanDone;
+		if (spanDone != spanCount) {
+			// Short read in this track.
+			break;
+		}
+	}
+
+	return static_cast<int>(blocksRead);
+}
+
+/**
+ * Advise the disc image of an upcoming read.
+ *
+ * NOTE: Ignored for GDI, since the data is spread across
+ * multiple track files.
+ *
+ * @param offset	[in] Start of the range that will be read.
+ * @param size		[in] Length of the range, in bytes.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int GdiReader::advise(off64_t offset, size_t size)
+{
+	RP_UNUSED(offset);
+	RP_UNUSED(size);
+	return 0;
+}
+
 /** GDI-specific functions **/
 // TODO: "CdromReader" class?
 
@@ -83,7 +83,33 @@ protected:
 	ATTR_ACCESS_SIZE(write_only, 4, 5)
 	int readBlock(uint32_t blockIdx, int pos, void *ptr, size_t size) final;
 
+	/**
+	 * Read multiple consecutive full blocks.
+	 *
+	 * Blocks are read per-track: 2048-byte tracks are read directly
+	 * into the output buffer, and 2352-byte tracks are read in raw
+	 * batches with the user data area extracted from each sector.
+	 *
+	 * @param blockIdx	[in] Starting block index.
+	 * @param blockCount	[in] Number of blocks to read.
+	 * @param ptr		[out] Output data buffer. (Must be at least blockCount * block_size bytes.)
+	 * @return Number of full blocks read. (< blockCount on error or short read)
+	 */
+	int readBlocks(uint32_t blockIdx, uint32_t blockCount, void *ptr) final;
+
 public:
+	/**
+	 * Advise the disc image of an upcoming read.
+	 *
+	 * NOTE: Ignored for GDI, since the data is spread across
+	 * multiple track files.
+	 *
+	 * @param offset	[in] Start of the range that will be read.
+	 * @param size		[in] Length of the range, in bytes.
+	 * @return 0 on success; negative POSIX error code on error.
+	 */
+	int advise(off64_t offset, size_t size) final;
+
 	/** GDI-specific functions **/
 
 	/**
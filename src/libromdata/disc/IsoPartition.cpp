@@ -47,6 +47,14 @@ public:
 	typedef rp::uvector<uint8_t> DirData_t;
 	unordered_map<string, DirData_t> dir_data;
 
+	// Path index, built incrementally by lookup().
+	// - Key: Filename, WITHOUT leading slash. [UTF-8]
+	// - Value: Directory entry. (points into dir_data; dir_data
+	//   entries are never freed while the partition is open)
+	// Probing opens the same well-known paths several times, so
+	// repeated lookups skip the directory scan entirely.
+	unordered_map<string, const ISO_DirEntry*> path_index;
+
 	// ISO start offset (in blocks)
 	// -1 == unknown
 	int iso_start_offset;
@@ -334,6 +342,9 @@ const IsoPartitionPrivate::DirData_t *IsoPartitionPrivate::getDirectory(const ch
 	}
 
 	// Get the parent directory.
+	// NOTE: Saving the full path for the dir_data key;
+	// 'path' is adjusted to the last path component below.
+	const string s_fullPath(path);
 	const DirData_t *pDir;
 	const char *const sl = findLastSlash(path);
 	if (!sl) {
@@ -382,7 +393,7 @@ const IsoPartitionPrivate::DirData_t *IsoPartitionPrivate::getDirectory(const ch
 	}
 
 	// Subdirectory loaded.
-	auto ins = dir_data.emplace(path, std::move(dir));
+	auto ins = dir_data.emplace(s_fullPath, std::move(dir));
 	return &(ins.first->second);
 }
 
@@ -407,6 +418,14 @@ const ISO_DirEntry *IsoPartitionPrivate::lookup(const char *filename)
 		return nullptr;
 	}
 
+	// Check the path index first.
+	const string s_path(filename);
+	auto idx_iter = path_index.find(s_path);
+	if (idx_iter != path_index.end()) {
+		// Path has already been looked up.
+		return idx_iter->second;
+	}
+
 	// TODO: Which encoding?
 	// Assuming cp1252...
 	const DirData_t *pDir;
@@ -432,7 +451,15 @@ const ISO_DirEntry *IsoPartitionPrivate::lookup(const char *filename)
 
 	// Find the file in the directory.
 	const string s_filename = utf8_to_cp1252(filename, -1);
-	return lookup_int(pDir, s_filename.c_str(), false);
+	const ISO_DirEntry *const entry = lookup_int(pDir, s_filename.c_str(), false);
+	if (entry) {
+		// Save the entry in the path index.
+		// NOTE: The entry points into dir_data, which is never
+		// freed while the partition is open, so the pointer
+		// remains valid.
+		path_index.emplace(s_path, entry);
+	}
+	return entry;
 }
 
 /**
@@ -48,15 +48,8 @@ public:
 	};
 	DiscType discType;
 
-	// Block map
-	// Values are absolute block addresses, possibly with a shift amount.
-	// Special value: 0xFFFFFFFF == empty block
-	rp::uvector<uint32_t> blockMap;
-
-	// Block address shift
-	// - GCML: 0
-	// - WIIx: 8
-	uint8_t blockMapShift;
+	// NOTE: The on-disk per-block table is coalesced into the
+	// inherited extentMap at load time, then discarded.
 };
 
 /** NASOSReaderPrivate **/
@@ -64,7 +57,6 @@ public:
 NASOSReaderPrivate::NASOSReaderPrivate(NASOSReader *q)
 	: super(q)
 	, discType(DiscType::Unknown)
-	, blockMapShift(0)
 {
 	// Clear the NASOSHeader structs.
 	memset(&header, 0, sizeof(header));
@@ -95,12 +87,16 @@ NASOSReader::NASOSReader(const IRpFilePtr &file)
 	// TODO: WII9 magic?
 	// TODO: Check the actual disc header magic?
 	unsigned int blockMapStart, blockCount;
+	// Block address shift:
+	// - GCML: 0
+	// - WIIx: 8
+	uint8_t blockMapShift;
 	if (d->header.nasos.magic == cpu_to_be32(NASOS_MAGIC_GCML)) {
 		d->discType = NASOSReaderPrivate::DiscType::GCML;
 		d->block_size = 2048;			// NOTE: Not stored in the header.
 		blockMapStart = sizeof(d->header.gcml);
 		blockCount = NASOS_GCML_BlockCount;	// NOTE: Not stored in the header.
-		d->blockMapShift = 0;
+		blockMapShift = 0;
 	} else if ((d->header.nasos.magic == cpu_to_be32(NASOS_MAGIC_WII5)) ||
 		   (d->header.nasos.magic == cpu_to_be32(NASOS_MAGIC_WII9)))
 	{
@@ -109,7 +105,7 @@ NASOSReader::NASOSReader(const IRpFilePtr &file)
 		blockMapStart = sizeof(d->header.wiix);
 		// TODO: Verify against WII5 (0x460900) and WII9 (0x7ED380).
 		blockCount = le32_to_cpu(d->header.wiix.block_count) >> 8;
-		d->blockMapShift = 8;
+		blockMapShift = 8;
 	} else {
 		// Invalid magic.
 		m_file.reset();
@@ -121,19 +117,48 @@ NASOSReader::NASOSReader(const IRpFilePtr &file)
 
 	// Read the block map.
 	// TODO: Restrict the maximum block count?
-	d->blockMap.resize(blockCount);
-	const size_t sz_blockMap = d->blockMap.size() * sizeof(uint32_t);
-	sz = m_file->seekAndRead(blockMapStart, d->blockMap.data(), sz_blockMap);
+	// Values are absolute block addresses, possibly with a shift amount.
+	// Special value: 0xFFFFFFFF == empty block
+	rp::uvector<uint32_t> blockMap;
+	blockMap.resize(blockCount);
+	const size_t sz_blockMap = blockMap.size() * sizeof(uint32_t);
+	sz = m_file->seekAndRead(blockMapStart, blockMap.data(), sz_blockMap);
 	if (sz != sz_blockMap) {
 		// Error reading the block map.
-		d->blockMap.clear();
 		m_file.reset();
 		m_lastError = EIO;
 		return;
 	}
 
+	// Coalesce the per-block table into extent runs.
+	// Typical images map mostly-contiguous data, so the table
+	// collapses to a few runs; the raw table is then discarded.
+	off64_t virt = 0;
+	for (const uint32_t entry : blockMap) {
+		const off64_t phys = (entry == 0xFFFFFFFF)
+			? -1
+			: (static_cast<off64_t>(entry) << blockMapShift);
+
+		if (!d->extentMap.empty()) {
+			auto &last = d->extentMap.back();
+			const bool contiguous = (phys < 0)
+				? (last.phys_start < 0)
+				: (last.phys_start >= 0 && phys == last.phys_start + last.size);
+			if (contiguous) {
+				// Extend the last run.
+				last.size += d->block_size;
+				virt += d->block_size;
+				continue;
+			}
+		}
+
+		// Start a new run.
+		d->extentMap.push_back({virt, phys, static_cast<off64_t>(d->block_size)});
+		virt += d->block_size;
+	}
+
 	// Disc size is based on the block map size.
-	d->disc_size = static_cast<off64_t>(d->blockMap.size()) * d->block_size;
+	d->disc_size = static_cast<off64_t>(blockCount) * d->block_size;
 
 	// Reset the disc position.
 	d->pos = 0;
@@ -193,21 +218,26 @@ off64_t NASOSReader::getPhysBlockAddr(uint32_t blockIdx) const
 {
 	// Make sure the block index is in range.
 	RP_D(const NASOSReader);
-	assert(blockIdx < d->blockMap.size());
-	if (blockIdx >= d->blockMap.size()) {
+	const off64_t virt_addr = static_cast<off64_t>(blockIdx) * d->block_size;
+	assert(virt_addr < d->disc_size);
+	if (virt_addr >= d->disc_size) {
 		// Out of range.
 		return -1;
 	}
 
-	// Get the physical block address.
-	const uint32_t physBlockAddr = d->blockMap[blockIdx];
-	if (physBlockAddr == 0xFFFFFFFF) {
+	// Find the extent run containing this block.
+	const auto *const run = SparseDiscReaderPrivate::lookupExtent(d->extentMap, virt_addr);
+	assert(run != nullptr);
+	if (!run) {
+		// Shouldn't happen; the extent map covers every block.
+		return -1;
+	}
+
+	if (run->phys_start < 0) {
 		// Empty block.
 		return 0;
 	}
-
-	// Adjust to bytes and return.
-	return static_cast<off64_t>(physBlockAddr) << d->blockMapShift;
+	return run->phys_start + (virt_addr - run->virt_start);
 }
 
 }
@@ -42,6 +42,8 @@ NCCHReaderPrivate::NCCHReaderPrivate(NCCHReader *q,
 	, cipher(nullptr)
 	, tmd_content_index(0)
 	, isDebug(false)
+	, lastKeyIdx(0xFF)
+	, decCacheTick(0)
 #endif /* ENABLE_DECRYPTION */
 {
 	// Clear the various structs.
@@ -352,6 +354,104 @@ int NCCHReaderPrivate::findEncSection(uint32_t address) const
 	// Not an encrypted section.
 	return -1;
 }
+
+/**
+ * Read data from a section, using the decrypted-region cache.
+ *
+ * The data is decrypted in DEC_CACHE_BLOCK_SIZE-aligned blocks
+ * (clamped to the section boundaries), and the AES-CTR keystream
+ * for each block is generated in a single decrypt() call.
+ *
+ * @param section	[in] Section containing the address.
+ * @param address	[in] Starting address, relative to the beginning of the NCCH.
+ * @param ptr		[out] Output buffer.
+ * @param size		[in] Amount of data to read. (Must be within the section!)
+ * @return Number of bytes read.
+ */
+size_t NCCHReaderPrivate::readEncSection(const EncSection *section, uint32_t address, uint8_t *ptr, size_t size)
+{
+	if (decCache.empty()) {
+		// Initialize the decrypted-region cache.
+		decCache.resize(DEC_CACHE_MAX_BLOCKS);
+	}
+
+	const uint32_t sectionEnd = section->address + section->length;
+	size_t sz_total_read = 0;
+	while (size > 0) {
+		// Clamp the cache block to the section boundaries so the
+		// AES-CTR counter stays consistent for the whole block.
+		const uint32_t window = address & ~(DEC_CACHE_BLOCK_SIZE - 1);
+		const uint32_t blkStart = std::max(window, section->address);
+		const uint32_t blkEnd = std::min(window + DEC_CACHE_BLOCK_SIZE, sectionEnd);
+		const uint32_t blkLen = blkEnd - blkStart;
+
+		// Check the cache for this block.
+		DecCacheBlock *pBlock = nullptr;
+		DecCacheBlock *pLRU = &decCache[0];
+		for (auto &block : decCache) {
+			if (block.address == blkStart) {
+				// Cache hit.
+				pBlock = &block;
+				break;
+			}
+			if (block.lruTick < pLRU->lruTick) {
+				// Least-recently-used block found so far.
+				pLRU = &block;
+			}
+		}
+
+		if (!pBlock) {
+			// Cache miss. Read and decrypt the full block into
+			// the least-recently-used cache entry.
+			const size_t sz_read = readFromROM(blkStart, pLRU->data.data(), blkLen);
+			if (sz_read != blkLen) {
+				// Short read.
+				// NOTE: readFromROM() set q->m_lastError.
+				break;
+			}
+
+			if (section->section > N3DS_NCCH_SECTION_PLAIN) {
+				// Set the required key if it isn't set already.
+				if (lastKeyIdx != section->keyIdx) {
+					cipher->setKey(ncch_keys[section->keyIdx].u8, sizeof(ncch_keys[section->keyIdx].u8));
+					lastKeyIdx = section->keyIdx;
+				}
+
+				// Initialize the counter based on section and offset.
+				u128_t ctr;
+				ctr.init_ctr(tid_be, section->section, blkStart - section->ctr_base);
+				cipher->setIV(ctr.u8, sizeof(ctr.u8));
+
+				// Decrypt the entire block in a single call.
+				if (cipher->decrypt(pLRU->data.data(), blkLen) != blkLen) {
+					// Decryption error.
+					pLRU->address = ~0U;
+					pLRU->length = 0;
+					RP_Q(NCCHReader);
+					q->m_lastError = EIO;
+					break;
+				}
+			}
+
+			pLRU->address = blkStart;
+			pLRU->length = static_cast<uint32_t>(blkLen);
+			pBlock = pLRU;
+		}
+
+		// Copy the requested data out of the cache block.
+		pBlock->lruTick = ++decCacheTick;
+		const uint32_t blkOffset = address - pBlock->address;
+		const size_t sz_copy = std::min(size, static_cast<size_t>(pBlock->length - blkOffset));
+		memcpy(ptr, &pBlock->data[blkOffset], sz_copy);
+
+		address += static_cast<uint32_t>(sz_copy);
+		ptr += sz_copy;
+		sz_total_read += sz_copy;
+		size -= sz_copy;
+	}
+
+	return sz_total_read;
+}
 #endif /* ENABLE_DECRYPTION */
 
 /**
@@ -601,25 +701,10 @@ size_t NCCHReader::read(void *ptr, size_t size)
 			}
 		}
 
-		// Read from the ROM image.
-		// This automatically removes the outer CIA
-		// title key encryption if it's present.
-		size_t ret_sz = d->readFromROM(d->pos, ptr8, sz_to_read);
-
-		if (section && section->section > N3DS_NCCH_SECTION_PLAIN) {
-			// Set the required key.
-			// TODO: Don't set the key if it hasn't changed.
-			d->cipher->setKey(d->ncch_keys[section->keyIdx].u8, sizeof(d->ncch_keys[section->keyIdx].u8));
-
-			// Initialize the counter based on section and offset.
-			u128_t ctr;
-			ctr.init_ctr(d->tid_be, section->section, d->pos - section->ctr_base);
-			d->cipher->setIV(ctr.u8, sizeof(ctr.u8));
-
-			// Decrypt the data.
-			// FIXME: Round up to 16 if a short read occurred?
-			ret_sz = d->cipher->decrypt(static_cast<uint8_t*>(ptr), ret_sz);
-		}
+		// Read from the ROM image, decrypting through the
+		// decrypted-region cache. The outer CIA title key
+		// encryption is automatically removed if it's present.
+		const size_t ret_sz = d->readEncSection(section, d->pos, ptr8, sz_to_read);
 
 		d->pos += static_cast<uint32_t>(ret_sz);
 		ptr8 += ret_sz;
@@ -24,6 +24,7 @@
 #include <stdint.h>
 
 // C++ includes.
+#include <array>
 #include <vector>
 
 #ifdef ENABLE_DECRYPTION
@@ -169,6 +170,44 @@ protected:
 	 * @return Index in encSections, or -1 if not encrypted.
 	 */
 	int findEncSection(uint32_t address) const;
+
+	// Last key index set on the cipher. (0xFF == none)
+	// Used to skip redundant setKey() calls.
+	uint8_t lastKeyIdx;
+
+	// Decrypted-region cache.
+	// Probing a CIA reads the same small regions (ExHeader,
+	// ExeFS header, SMDH) repeatedly through different code
+	// paths, so recently decrypted extents are cached in
+	// aligned blocks.
+	static constexpr uint32_t DEC_CACHE_BLOCK_SIZE = 4096;
+	static constexpr unsigned int DEC_CACHE_MAX_BLOCKS = 8;
+	struct DecCacheBlock {
+		uint32_t address;	// Start address, relative to ncch_offset. (~0U == empty)
+		uint32_t length;	// Valid data length, in bytes.
+		uint64_t lruTick;	// Last access tick, for LRU eviction.
+		std::array<uint8_t, DEC_CACHE_BLOCK_SIZE> data;
+
+		DecCacheBlock() : address(~0U), length(0), lruTick(0) {}
+	};
+	std::vector<DecCacheBlock> decCache;
+	uint64_t decCacheTick;
+
+	/**
+	 * Read data from a section, using the decrypted-region cache.
+	 *
+	 * The data is decrypted in DEC_CACHE_BLOCK_SIZE-aligned blocks
+	 * (clamped to the section boundaries), and the AES-CTR keystream
+	 * for each block is generated in a single decrypt() call.
+	 *
+	 * @param section	[in] Section containing the address.
+	 * @param address	[in] Starting address, relative to the beginning of the NCCH.
+	 * @param ptr		[out] Output buffer.
+	 * @param size		[in] Amount of data to read. (Must be within the section!)
+	 * @return Number of bytes read.
+	 */
+	ATTR_ACCESS_SIZE(write_only, 4, 5)
+	size_t readEncSection(const EncSection *section, uint32_t address, uint8_t *ptr, size_t size);
 #endif /* ENABLE_DECRYPTION */
 };
 
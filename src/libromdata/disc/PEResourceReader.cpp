@@ -55,6 +55,12 @@ public:
 	};
 	typedef rp::uvector<ResDirEntry> rsrc_dir_t;
 
+	// Prefetched directory region of .rsrc.
+	// Directory headers, entry tables, and data entries are clustered
+	// at the start of the section, so one block read serves all of the
+	// tree traversals. Anything past the block falls back to file reads.
+	rp::uvector<uint8_t> dirData;
+
 	// Resource types (Top-level directory)
 	rsrc_dir_t res_types;
 
@@ -162,6 +168,16 @@ PEResourceReaderPrivate::PEResourceReaderPrivate(
 		return;
 	}
 
+	// Prefetch the directory region.
+	static constexpr uint32_t DirData_MAX = 64U*1024;
+	dirData.resize(std::min(rsrc_size, DirData_MAX));
+	size_t size = q->m_file->seekAndRead(rsrc_addr, dirData.data(), dirData.size());
+	if (size != dirData.size()) {
+		// Seek and/or read error.
+		// Fall back to individual file reads.
+		dirData.clear();
+	}
+
 	// Load the root resource directory.
 	int ret = loadResDir(0, res_types);
 	if (ret <= 0) {
@@ -185,11 +201,17 @@ int PEResourceReaderPrivate::loadResDir(uint32_t addr, rsrc_dir_t &dir)
 	RP_Q(PEResourceReader);
 
 	IMAGE_RESOURCE_DIRECTORY root;
-	size_t size = q->m_file->seekAndRead(rsrc_addr + addr, &root, sizeof(root));
-	if (size != sizeof(root)) {
-		// Seek and/or read error.
-		q->m_lastError = q->m_file->lastError();
-		return q->m_lastError;
+	// NOTE: Checking with subtraction to avoid integer overflow.
+	if (addr < dirData.size() && sizeof(root) <= dirData.size() - addr) {
+		// Directory header is in the prefetched region.
+		memcpy(&root, &dirData[addr], sizeof(root));
+	} else {
+		size_t size = q->m_file->seekAndRead(rsrc_addr + addr, &root, sizeof(root));
+		if (size != sizeof(root)) {
+			// Seek and/or read error.
+			q->m_lastError = q->m_file->lastError();
+			return q->m_lastError;
+		}
 	}
 
 	// Total number of entries.
@@ -199,13 +221,18 @@ int PEResourceReaderPrivate::loadResDir(uint32_t addr, rsrc_dir_t &dir)
 		// Sanity check; constrain to 64 entries.
 		entryCount = 64;
 	}
-	uint32_t szToRead = static_cast<uint32_t>(entryCount * sizeof(IMAGE_RESOURCE_DIRECTORY_ENTRY));
+	const uint32_t szToRead = static_cast<uint32_t>(entryCount * sizeof(IMAGE_RESOURCE_DIRECTORY_ENTRY));
 	unique_ptr<IMAGE_RESOURCE_DIRECTORY_ENTRY[]> irdEntries(new IMAGE_RESOURCE_DIRECTORY_ENTRY[entryCount]);
-	size = q->m_file->read(irdEntries.get(), szToRead);
-	if (size != szToRead) {
-		// Read error.
-		q->m_lastError = q->m_file->lastError();
-		return q->m_lastError;
+	if (addr < dirData.size() && sizeof(root) + szToRead <= dirData.size() - addr) {
+		// Entry table is in the prefetched region.
+		memcpy(irdEntries.get(), &dirData[addr + sizeof(root)], szToRead);
+	} else {
+		size_t size = q->m_file->seekAndRead(rsrc_addr + addr + sizeof(root), irdEntries.get(), szToRead);
+		if (size != szToRead) {
+			// Seek and/or read error.
+			q->m_lastError = q->m_file->lastError();
+			return q->m_lastError;
+		}
 	}
 
 	// Read each directory header.
@@ -742,12 +769,20 @@ IRpFilePtr PEResourceReader::open(uint16_t type, int id, int lang)
 	}
 
 	// Get the IMAGE_RESOURCE_DATA_ENTRY.
+	// NOTE: Checking with subtraction to avoid integer overflow.
 	IMAGE_RESOURCE_DATA_ENTRY irdata;
-	size_t size = m_file->seekAndRead(d->rsrc_addr + dirEntry->addr, &irdata, sizeof(irdata));
-	if (size != sizeof(irdata)) {
-		// Seek and/or read error.
-		m_lastError = m_file->lastError();
-		return nullptr;
+	if (dirEntry->addr < d->dirData.size() &&
+	    sizeof(irdata) <= d->dirData.size() - dirEntry->addr)
+	{
+		// Data entry is in the prefetched region.
+		memcpy(&irdata, &d->dirData[dirEntry->addr], sizeof(irdata));
+	} else {
+		size_t size = m_file->seekAndRead(d->rsrc_addr + dirEntry->addr, &irdata, sizeof(irdata));
+		if (size != sizeof(irdata)) {
+			// Seek and/or read error.
+			m_lastError = m_file->lastError();
+			return nullptr;
+		}
 	}
 
 	// NOTE: OffsetToData is an RVA, not relative to the physical address.
@@ -34,6 +34,22 @@ public:
 
 	const be16_t *wlba_table;	// Pointer to m_wbfs_disc->disc->header->wlba_table
 
+	// Lazy wlba_table[] loading.
+	// The table is loaded in 1 KB chunks on demand, so a header-only
+	// probe only reads the chunk covering block 0 instead of the
+	// entire table.
+	static constexpr uint32_t WLBA_CHUNK_ENTRIES = 512;
+	std::vector<uint8_t> wlbaChunkLoaded;	// Per-chunk loaded flags
+	off64_t wlbaTableOffset;		// File offset of wlba_table[]
+
+	/**
+	 * Ensure the wlba_table[] chunk covering the specified
+	 * block index has been loaded from the file.
+	 * @param blockIdx Block index.
+	 * @return 0 on success; negative POSIX error code on error.
+	 */
+	int ensureWlbaChunk(uint32_t blockIdx);
+
 	/** WBFS functions **/
 
 	/**
@@ -72,7 +88,7 @@ public:
 	 * @param disc wbfs_disc_t struct.
 	 * @return Non-sparse size, in bytes.
 	 */
-	off64_t getWbfsDiscSize(const wbfs_disc_t *disc) const;
+	off64_t getWbfsDiscSize(const wbfs_disc_t *disc);
 };
 
 /** WbfsReaderPrivate **/
@@ -82,6 +98,7 @@ WbfsReaderPrivate::WbfsReaderPrivate(WbfsReader *q)
 	, m_wbfs(nullptr)
 	, m_wbfs_disc(nullptr)
 	, wlba_table(nullptr)
+	, wlbaTableOffset(0)
 { }
 
 WbfsReaderPrivate::~WbfsReaderPrivate()
@@ -259,22 +276,33 @@ wbfs_disc_t *WbfsReaderPrivate::openWbfsDisc(wbfs_t *p, uint32_t index)
 				disc->p = p;
 				disc->i = i;
 
-				// Read the disc header.
+				// Read the disc header copy.
+				// NOTE: wlba_table[] is loaded lazily, in chunks,
+				// by ensureWlbaChunk(). A header-only probe only
+				// needs the chunk covering block 0.
 				disc->header = static_cast<wbfs_disc_info_t*>(malloc(p->disc_info_sz));
 				if (!disc->header) {
 					// ENOMEM
 					free(disc);
 					return nullptr;
 				}
-				size_t size = q->m_file->seekAndRead((p->hd_sec_sz + (i*p->disc_info_sz)),
-					disc->header, p->disc_info_sz);
-				if (size != p->disc_info_sz) {
+				const off64_t disc_info_addr = p->hd_sec_sz + (i*p->disc_info_sz);
+				size_t size = q->m_file->seekAndRead(disc_info_addr,
+					disc->header, sizeof(wbfs_disc_info_t));
+				if (size != sizeof(wbfs_disc_info_t)) {
 					// Error reading the disc information.
 					free(disc->header);
 					free(disc);
 					return nullptr;
 				}
 
+				// Initialize the lazy wlba_table[] state.
+				wlbaTableOffset = disc_info_addr + sizeof(wbfs_disc_info_t);
+				const uint32_t num_chunks =
+					(p->n_wbfs_sec_per_disc + WLBA_CHUNK_ENTRIES - 1) / WLBA_CHUNK_ENTRIES;
+				wlbaChunkLoaded.clear();
+				wlbaChunkLoaded.resize(num_chunks, 0);
+
 				// TODO: Byteswap wlba_table[] here?
 				// Removes unnecessary byteswaps when reading,
 				// but may not be necessary if we're not reading
@@ -309,6 +337,49 @@ void WbfsReaderPrivate::closeWbfsDisc(wbfs_disc_t *disc)
 	free(disc);
 }
 
+/**
+ * Ensure the wlba_table[] chunk covering the specified
+ * block index has been loaded from the file.
+ * @param blockIdx Block index.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int WbfsReaderPrivate::ensureWlbaChunk(uint32_t blockIdx)
+{
+	const uint32_t chunkIdx = blockIdx / WLBA_CHUNK_ENTRIES;
+	assert(chunkIdx < wlbaChunkLoaded.size());
+	if (chunkIdx >= wlbaChunkLoaded.size()) {
+		// Out of range.
+		return -EINVAL;
+	}
+	if (wlbaChunkLoaded[chunkIdx]) {
+		// Chunk is already loaded.
+		return 0;
+	}
+
+	// Load the chunk.
+	RP_Q(WbfsReader);
+	const uint32_t startEntry = chunkIdx * WLBA_CHUNK_ENTRIES;
+	uint32_t numEntries = m_wbfs->n_wbfs_sec_per_disc - startEntry;
+	if (numEntries > WLBA_CHUNK_ENTRIES) {
+		numEntries = WLBA_CHUNK_ENTRIES;
+	}
+	be16_t *const p_dest = &m_wbfs_disc->header->wlba_table[startEntry];
+	const size_t expected_size = numEntries * sizeof(be16_t);
+	size_t size = q->m_file->seekAndRead(
+		wlbaTableOffset + (startEntry * sizeof(be16_t)), p_dest, expected_size);
+	if (size != expected_size) {
+		// Read error.
+		int err = q->m_file->lastError();
+		if (err == 0) {
+			err = EIO;
+		}
+		return -err;
+	}
+
+	wlbaChunkLoaded[chunkIdx] = 1;
+	return 0;
+}
+
 /**
  * Get the non-sparse size of an open WBFS disc, in bytes.
  * This scans the block table to find the first block
@@ -316,13 +387,21 @@ void WbfsReaderPrivate::closeWbfsDisc(wbfs_disc_t *disc)
  * @param disc wbfs_disc_t struct.
  * @return Non-sparse size, in bytes.
  */
-off64_t WbfsReaderPrivate::getWbfsDiscSize(const wbfs_disc_t *disc) const
+off64_t WbfsReaderPrivate::getWbfsDiscSize(const wbfs_disc_t *disc)
 {
 	// Find the last block that's used on the disc.
 	// NOTE: This is in WBFS blocks, not Wii blocks.
+	// NOTE: Scanning backwards in chunks; only the chunks that are
+	// actually scanned get loaded, which for a typical image is just
+	// the last chunk or two instead of the whole table.
 	const wbfs_t *const p = disc->p;
 	int lastBlock = p->n_wbfs_sec_per_disc - 1;
 	for (; lastBlock >= 0; lastBlock--) {
+		if (ensureWlbaChunk(static_cast<uint32_t>(lastBlock)) != 0) {
+			// Read error; assume the full size.
+			lastBlock = p->n_wbfs_sec_per_disc - 1;
+			break;
+		}
 		if (wlba_table[lastBlock] != cpu_to_be16(0))
 			break;
 	}
@@ -444,6 +523,12 @@ off64_t WbfsReader::getPhysBlockAddr(uint32_t blockIdx) const
 		return -1;
 	}
 
+	// Make sure the wlba_table[] chunk for this block is loaded.
+	if (const_cast<WbfsReaderPrivate*>(d)->ensureWlbaChunk(blockIdx) != 0) {
+		// Unable to load the table chunk.
+		return -1;
+	}
+
 	// Get the physical block index.
 	const unsigned int physBlockIdx = be16_to_cpu(d->wlba_table[blockIdx]);
 	if (physBlockIdx == 0) {
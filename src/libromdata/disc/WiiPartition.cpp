@@ -17,17 +17,24 @@
 #ifdef ENABLE_DECRYPTION
 #  include "librpbase/crypto/IAesCipher.hpp"
 #  include "librpbase/crypto/AesCipherFactory.hpp"
+#  include "librpbase/crypto/Hash.hpp"
 #endif /* ENABLE_DECRYPTION */
 using namespace LibRpBase;
 
+// librpthreads
+#include "librpthreads/ThreadPool.hpp"
+
 // WiiTicket for title key decryption
 #include "../Console/WiiTicket.hpp"
 #include "librpfile/MemFile.hpp"
 using namespace LibRpFile;
 
 // C++ STL classes
+#include <atomic>
+#include <thread>
 using std::array;
 using std::unique_ptr;
+using std::vector;
 
 #include "GcnPartition_p.hpp"
 namespace LibRomData {
@@ -36,6 +43,10 @@ namespace LibRomData {
 #define SECTOR_SIZE_DECRYPTED 0x7C00
 #define SECTOR_SIZE_DECRYPTED_OFFSET 0x400
 
+// Hash tree constants.
+#define SECTORS_PER_HASH_GROUP 64	// One H3 entry covers 64 sectors. (2 MB encrypted)
+#define H3_TABLE_SIZE 0x18000
+
 class WiiPartitionPrivate final : public GcnPartitionPrivate
 {
 public:
@@ -107,6 +118,45 @@ public:
 	 */
 	int readSector(uint32_t sector_num);
 
+	// Encrypted sector batch buffers for readSectors().
+	// Double-buffered: the next batch is read from the disc image
+	// while the current batch is being decrypted.
+	static constexpr uint32_t SECTORS_PER_BATCH = 32;	// 1 MB encrypted
+	array<rp::uvector<uint8_t>, 2> secBatch;
+
+	/**
+	 * Read and decrypt multiple consecutive sectors.
+	 *
+	 * The encrypted sectors are read in batches, and the next batch
+	 * is read on a worker thread while the current one is decrypted,
+	 * overlapping file I/O with AES-CBC work. Only the decrypted data
+	 * area (0x7C00 bytes) of each sector is written to the buffer.
+	 *
+	 * @param sector_num	[in] Starting sector number. (address / 0x7C00)
+	 * @param count		[in] Number of sectors to read.
+	 * @param ptr		[out] Output data buffer. (Must be at least count * 0x7C00 bytes.)
+	 * @return Number of sectors read and decrypted. (< count on error)
+	 */
+	uint32_t readSectors(uint32_t sector_num, uint32_t count, uint8_t *ptr);
+
+#ifdef ENABLE_DECRYPTION
+	/**
+	 * Decrypt and verify one hash group. (worker thread)
+	 *
+	 * Checks each sector's H0 hashes against its data chunks, the H0
+	 * table against the H1 table, the H1 table against the H2 table,
+	 * and the group's H2 table against its H3 table entry.
+	 *
+	 * @param pSectors	[in/out] Encrypted sectors. (decrypted in place)
+	 * @param count		[in] Number of sectors in this group. (up to 64)
+	 * @param pH3Entry	[in] H3 table entry for this group. (20 bytes)
+	 * @param cipher	[in,opt] AES cipher with the title key, or nullptr if not encrypted.
+	 * @return Number of sectors that failed verification.
+	 */
+	static unsigned int verifyHashGroup(EncSector_t *pSectors, unsigned int count,
+		const uint8_t *pH3Entry, IAesCipher *cipher);
+#endif /* ENABLE_DECRYPTION */
+
 public:
 	/**
 	 * Initialize decryption.
@@ -348,6 +398,224 @@ int WiiPartitionPrivate::readSector(uint32_t sector_num)
 	return 0;
 }
 
+/**
+ * Read and decrypt multiple consecutive sectors.
+ *
+ * The encrypted sectors are read in batches, and the next batch
+ * is read on a worker thread while the current one is decrypted,
+ * overlapping file I/O with AES-CBC work. Only the decrypted data
+ * area (0x7C00 bytes) of each sector is written to the buffer.
+ *
+ * @param sector_num	[in] Starting sector number. (address / 0x7C00)
+ * @param count		[in] Number of sectors to read.
+ * @param ptr		[out] Output data buffer. (Must be at least count * 0x7C00 bytes.)
+ * @return Number of sectors read and decrypted. (< count on error)
+ */
+uint32_t WiiPartitionPrivate::readSectors(uint32_t sector_num, uint32_t count, uint8_t *ptr)
+{
+	RP_Q(WiiPartition);
+	const bool isCrypted = ((cryptoMethod & WiiPartition::CM_MASK_ENCRYPTED) == WiiPartition::CM_ENCRYPTED);
+#ifndef ENABLE_DECRYPTION
+	if (isCrypted) {
+		// Decryption is disabled.
+		q->m_lastError = EIO;
+		return 0;
+	}
+#endif /* !ENABLE_DECRYPTION */
+
+	if (count == 1) {
+		// Single sector: use the sector cache.
+		if (readSector(sector_num) != 0) {
+			return 0;
+		}
+		memcpy(ptr, sector_buf.data, SECTOR_SIZE_DECRYPTED);
+		return 1;
+	}
+
+	// Read a batch of encrypted sectors into the specified buffer.
+	// NOTE: m_file is only accessed by one thread at a time:
+	// either the main thread (first batch) or the prefetch thread.
+	auto loadBatch = [this, q](uint32_t startSector, uint32_t numSectors, rp::uvector<uint8_t> &buf) -> bool {
+		buf.resize(numSectors * SECTOR_SIZE_ENCRYPTED);
+		off64_t batch_addr = partition_offset + data_offset;
+		batch_addr += (static_cast<off64_t>(startSector) * SECTOR_SIZE_ENCRYPTED);
+		const size_t sz = q->m_file->seekAndRead(batch_addr, buf.data(), buf.size());
+		return (sz == buf.size());
+	};
+
+	unsigned int cur = 0;
+	uint32_t sectorsDone = 0;
+
+	// Read the first batch synchronously.
+	bool batchOK = loadBatch(sector_num, std::min(count, SECTORS_PER_BATCH), secBatch[cur]);
+	while (sectorsDone < count) {
+		if (!batchOK) {
+			// Read error in the current batch.
+			break;
+		}
+		const uint32_t inBatch = std::min(count - sectorsDone, SECTORS_PER_BATCH);
+
+		// Prefetch the next batch while this one is decrypted.
+		std::thread prefetchThread;
+		bool nextOK = false;
+		const uint32_t nextStart = sector_num + sectorsDone + inBatch;
+		const uint32_t nextCount = std::min(count - sectorsDone - inBatch, SECTORS_PER_BATCH);
+		if (nextCount > 0) {
+			prefetchThread = std::thread(
+				[this, &loadBatch, &nextOK, nextStart, nextCount, cur]() {
+					nextOK = loadBatch(nextStart, nextCount, secBatch[cur ^ 1]);
+				});
+		}
+
+		// Decrypt the current batch.
+		// NOTE: The Wii AES-CBC IV is stored per-sector (last 16 bytes
+		// of the H2 table), so each sector gets its own descriptor,
+		// but the entire batch is decrypted in a single call.
+		uint8_t *const batch = secBatch[cur].data();
+		uint32_t decDone = 0;
+#ifdef ENABLE_DECRYPTION
+		if (isCrypted) {
+			array<IAesCipher::DecryptBlock, SECTORS_PER_BATCH> blocks;
+			for (uint32_t i = 0; i < inBatch; i++) {
+				EncSector_t *const sector = reinterpret_cast<EncSector_t*>(&batch[i * SECTOR_SIZE_ENCRYPTED]);
+				blocks[i].pData = sector->data;
+				blocks[i].size = sizeof(sector->data);
+				blocks[i].pIV = &sector->hashes.H2[7][4];
+			}
+			if (aes_title->decryptBatch(blocks.data(), inBatch) ==
+			    static_cast<size_t>(inBatch) * SECTOR_SIZE_DECRYPTED)
+			{
+				decDone = inBatch;
+			}
+		} else
+#endif /* ENABLE_DECRYPTION */
+		{
+			// Not encrypted.
+			decDone = inBatch;
+		}
+
+		// Copy out the decrypted data areas.
+		for (uint32_t i = 0; i < decDone; i++) {
+			const EncSector_t *const sector = reinterpret_cast<const EncSector_t*>(&batch[i * SECTOR_SIZE_ENCRYPTED]);
+			memcpy(ptr, sector->data, SECTOR_SIZE_DECRYPTED);
+			ptr += SECTOR_SIZE_DECRYPTED;
+		}
+
+		if (prefetchThread.joinable()) {
+			prefetchThread.join();
+		}
+
+		sectorsDone += decDone;
+		if (decDone != inBatch) {
+			// Decryption error in the current batch.
+			break;
+		}
+		batchOK = nextOK;
+		cur ^= 1;
+	}
+
+	if (sectorsDone != count) {
+		q->m_lastError = EIO;
+	}
+	return sectorsDone;
+}
+
+#ifdef ENABLE_DECRYPTION
+/**
+ * Decrypt and verify one hash group. (worker thread)
+ *
+ * Checks each sector's H0 hashes against its data chunks, the H0
+ * table against the H1 table, the H1 table against the H2 table,
+ * and the group's H2 table against its H3 table entry.
+ *
+ * @param pSectors	[in/out] Encrypted sectors. (decrypted in place)
+ * @param count		[in] Number of sectors in this group. (up to 64)
+ * @param pH3Entry	[in] H3 table entry for this group. (20 bytes)
+ * @param cipher	[in,opt] AES cipher with the title key, or nullptr if not encrypted.
+ * @return Number of sectors that failed verification.
+ */
+unsigned int WiiPartitionPrivate::verifyHashGroup(EncSector_t *pSectors, unsigned int count,
+	const uint8_t *pH3Entry, IAesCipher *cipher)
+{
+	assert(count > 0);
+	assert(count <= SECTORS_PER_HASH_GROUP);
+	if (count == 0 || count > SECTORS_PER_HASH_GROUP) {
+		return 0;
+	}
+
+	if (cipher) {
+		// Save the data area IVs. The data IV is stored in the
+		// *encrypted* hash block, so it has to be saved before
+		// the hash blocks are decrypted. (IV for hashes is zero.)
+		static const uint8_t zero_iv[16] = { };
+		uint8_t ivs[SECTORS_PER_HASH_GROUP][16];
+		array<IAesCipher::DecryptBlock, SECTORS_PER_HASH_GROUP * 2> blocks;
+		for (unsigned int i = 0; i < count; i++) {
+			memcpy(ivs[i], &pSectors[i].hashes.H2[7][4], sizeof(ivs[i]));
+			blocks[i*2+0].pData = pSectors[i].fulldata;
+			blocks[i*2+0].size = SECTOR_SIZE_DECRYPTED_OFFSET;
+			blocks[i*2+0].pIV = zero_iv;
+			blocks[i*2+1].pData = pSectors[i].data;
+			blocks[i*2+1].size = SECTOR_SIZE_DECRYPTED;
+			blocks[i*2+1].pIV = ivs[i];
+		}
+		if (cipher->decryptBatch(blocks.data(), count * 2) !=
+		    static_cast<size_t>(count) * SECTOR_SIZE_ENCRYPTED)
+		{
+			// Decryption failed. Nothing can be verified.
+			return count;
+		}
+	}
+
+	Hash sha1(Hash::Algorithm::SHA1);
+	if (!sha1.isUsable()) {
+		// SHA-1 is not available.
+		return count;
+	}
+
+	uint8_t digest[20];
+	auto check = [&sha1, &digest](const void *pData, size_t len, const uint8_t *pExpected) -> bool {
+		sha1.reset();
+		sha1.process(pData, len);
+		sha1.getHash(digest, sizeof(digest));
+		return (memcmp(digest, pExpected, sizeof(digest)) == 0);
+	};
+
+	unsigned int bad = 0;
+	for (unsigned int i = 0; i < count; i++) {
+		const EncSector_t &sector = pSectors[i];
+
+		// H0: One hash per 1 KB data chunk.
+		bool ok = true;
+		for (unsigned int c = 0; c < 31 && ok; c++) {
+			ok = check(&sector.data[c * 0x400], 0x400, sector.hashes.H0[c]);
+		}
+
+		// H1: Hash of this sector's H0 table.
+		if (ok) {
+			ok = check(sector.hashes.H0, sizeof(sector.hashes.H0), sector.hashes.H1[i % 8]);
+		}
+
+		// H2: Hash of this subgroup's H1 table.
+		if (ok) {
+			ok = check(sector.hashes.H1, sizeof(sector.hashes.H1), sector.hashes.H2[i / 8]);
+		}
+
+		if (!ok) {
+			bad++;
+		}
+	}
+
+	// H3: Hash of the group's H2 table.
+	// All sectors in the group share the same H2 table.
+	if (!check(pSectors[0].hashes.H2, sizeof(pSectors[0].hashes.H2), pH3Entry)) {
+		bad++;
+	}
+
+	return bad;
+}
+#endif /* ENABLE_DECRYPTION */
+
 /** WiiPartition **/
 
 /**
@@ -579,18 +847,24 @@ size_t WiiPartition::read(void *ptr, size_t size)
 		}
 
 		// Read entire blocks.
-		for (; size >= SECTOR_SIZE_DECRYPTED;
-		size -= SECTOR_SIZE_DECRYPTED, ptr8 += SECTOR_SIZE_DECRYPTED,
-		ret += SECTOR_SIZE_DECRYPTED, d->pos_7C00 += SECTOR_SIZE_DECRYPTED)
-		{
+		if (size >= SECTOR_SIZE_DECRYPTED) {
 			assert(d->pos_7C00 % SECTOR_SIZE_DECRYPTED == 0);
 
-			// Read and decrypt the sector.
+			// Read and decrypt the sectors in batches.
 			const uint32_t blockStart = static_cast<uint32_t>(d->pos_7C00 / SECTOR_SIZE_DECRYPTED);
-			d->readSector(blockStart);
-
-			// Copy data from the sector.
-			memcpy(ptr8, d->sector_buf.data, SECTOR_SIZE_DECRYPTED);
+			const uint32_t blockCount = static_cast<uint32_t>(size / SECTOR_SIZE_DECRYPTED);
+			const uint32_t blocksRead = d->readSectors(blockStart, blockCount, ptr8);
+
+			const size_t bytesRead = static_cast<size_t>(blocksRead) * SECTOR_SIZE_DECRYPTED;
+			size -= bytesRead;
+			ptr8 += bytesRead;
+			ret += bytesRead;
+			d->pos_7C00 += bytesRead;
+
+			if (blocksRead != blockCount) {
+				// Short read.
+				return ret;
+			}
 		}
 
 		// Check if we still have data left. (not a full block)
@@ -763,4 +1037,136 @@ Nintendo_TitleID_BE_t WiiPartition::titleID(void) const
 	return d->partitionHeader.ticket.title_id;
 }
 
+/**
+ * Verify the partition's SHA-1 hash tree. (H0/H1/H2/H3)
+ *
+ * This reads and decrypts the entire data area, so it's an
+ * expensive operation. Hash groups (64 sectors; 2 MB) are
+ * verified in parallel on the process-wide ThreadPool, with
+ * file I/O staying on the calling thread.
+ *
+ * @param pBadSectors	[out,opt] Number of sectors that failed verification.
+ * @return 0 if all hashes verified; 1 if mismatches were found; negative POSIX error code on error.
+ */
+int WiiPartition::verifyHashes(size_t *pBadSectors)
+{
+	RP_D(WiiPartition);
+	if (pBadSectors) {
+		*pBadSectors = 0;
+	}
+
+	if (!m_file || !m_file->isOpen()) {
+		m_lastError = EBADF;
+		return -EBADF;
+	}
+
+	if ((d->cryptoMethod & CM_MASK_SECTOR) != CM_1K_31K) {
+		// 32k sectors don't have a hash tree. (RVT-H)
+		m_lastError = ENOTSUP;
+		return -ENOTSUP;
+	}
+
+#ifdef ENABLE_DECRYPTION
+	const bool isCrypted = ((d->cryptoMethod & CM_MASK_ENCRYPTED) == CM_ENCRYPTED);
+	uint8_t title_key[16];
+	if (isCrypted) {
+		if (d->initDecryption() != KeyManager::VerifyResult::OK) {
+			m_lastError = EIO;
+			return -EIO;
+		}
+
+		// Each worker thread needs its own cipher, so get the
+		// title key for the workers to initialize theirs with.
+		if (!d->wiiTicket ||
+		    d->wiiTicket->decryptTitleKey(title_key, sizeof(title_key)) != 0)
+		{
+			m_lastError = EIO;
+			return -EIO;
+		}
+	}
+
+	// Read the H3 table.
+	const unique_ptr<uint8_t[]> h3_table(new uint8_t[H3_TABLE_SIZE]);
+	const off64_t h3_addr = d->partition_offset + d->partitionHeader.h3_table_offset.geto_be();
+	size_t sz = m_file->seekAndRead(h3_addr, h3_table.get(), H3_TABLE_SIZE);
+	if (sz != H3_TABLE_SIZE) {
+		m_lastError = EIO;
+		return -EIO;
+	}
+
+	const uint32_t numSectors = static_cast<uint32_t>(d->data_size / SECTOR_SIZE_ENCRYPTED);
+	const uint32_t numGroups = (numSectors + SECTORS_PER_HASH_GROUP - 1) / SECTORS_PER_HASH_GROUP;
+	assert(numSectors > 0);
+	assert(numGroups <= H3_TABLE_SIZE / 20);
+	if (numSectors == 0 || numGroups > H3_TABLE_SIZE / 20) {
+		// No data, or more groups than the H3 table can cover.
+		m_lastError = EIO;
+		return -EIO;
+	}
+
+	// Hash groups are verified in parallel, in waves of one group
+	// per worker thread. The disc image is only read on this thread.
+	LibRpThreads::ThreadPool &pool = LibRpThreads::ThreadPool::instance();
+	const unsigned int nWorkers = std::min<uint32_t>(pool.maxThreads(), numGroups);
+	vector<rp::uvector<uint8_t> > groupBuf(nWorkers);
+	std::atomic<unsigned int> badSectors{0};
+	std::atomic<int> err{0};
+
+	for (uint32_t group = 0; group < numGroups && err == 0; ) {
+		LibRpThreads::TaskSet tasks;
+		for (unsigned int w = 0; w < nWorkers && group < numGroups; w++, group++) {
+			const uint32_t firstSector = group * SECTORS_PER_HASH_GROUP;
+			const unsigned int count = std::min<uint32_t>(
+				SECTORS_PER_HASH_GROUP, numSectors - firstSector);
+
+			auto &buf = groupBuf[w];
+			buf.resize(static_cast<size_t>(count) * SECTOR_SIZE_ENCRYPTED);
+			off64_t addr = d->partition_offset + d->data_offset;
+			addr += (static_cast<off64_t>(firstSector) * SECTOR_SIZE_ENCRYPTED);
+			sz = m_file->seekAndRead(addr, buf.data(), buf.size());
+			if (sz != buf.size()) {
+				err = -EIO;
+				break;
+			}
+
+			WiiPartitionPrivate::EncSector_t *const pSectors =
+				reinterpret_cast<WiiPartitionPrivate::EncSector_t*>(buf.data());
+			const uint8_t *const pH3Entry = &h3_table[group * 20];
+			tasks.submit([pSectors, count, pH3Entry, isCrypted, &title_key, &badSectors, &err]() {
+				unique_ptr<IAesCipher> cipher;
+				if (isCrypted) {
+					cipher.reset(AesCipherFactory::create());
+					if (!cipher || !cipher->isInit() ||
+					    cipher->setKey(title_key, sizeof(title_key)) != 0 ||
+					    cipher->setChainingMode(IAesCipher::ChainingMode::CBC) != 0)
+					{
+						err = -EIO;
+						return;
+					}
+				}
+				badSectors += WiiPartitionPrivate::verifyHashGroup(
+					pSectors, count, pH3Entry, cipher.get());
+			});
+		}
+
+		// Wait for this wave to finish before reusing the buffers.
+		tasks.wait();
+	}
+
+	if (pBadSectors) {
+		*pBadSectors = badSectors;
+	}
+	const int err_val = err;
+	if (err_val != 0) {
+		m_lastError = -err_val;
+		return err_val;
+	}
+	return (badSectors == 0) ? 0 : 1;
+#else /* !ENABLE_DECRYPTION */
+	// Hash verification requires SHA-1 from the crypto backend.
+	m_lastError = ENOTSUP;
+	return -ENOTSUP;
+#endif /* ENABLE_DECRYPTION */
+}
+
 }
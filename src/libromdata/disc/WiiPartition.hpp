@@ -136,6 +136,19 @@ public:
 	 * @return Title ID. (0-0 if unavailable)
 	 */
 	Nintendo_TitleID_BE_t titleID(void) const;
+
+	/**
+	 * Verify the partition's SHA-1 hash tree. (H0/H1/H2/H3)
+	 *
+	 * This reads and decrypts the entire data area, so it's an
+	 * expensive operation. Hash groups (64 sectors; 2 MB) are
+	 * verified in parallel on the process-wide ThreadPool, with
+	 * file I/O staying on the calling thread.
+	 *
+	 * @param pBadSectors	[out,opt] Number of sectors that failed verification.
+	 * @return 0 if all hashes verified; 1 if mismatches were found; negative POSIX error code on error.
+	 */
+	int verifyHashes(size_t *pBadSectors = nullptr);
 };
 
 typedef std::shared_ptr<WiiPartition> WiiPartitionPtr;
@@ -6,8 +6,6 @@
  * SPDX-License-Identifier: GPL-2.0-or-later                               *
  ***************************************************************************/
 
-// TODO: Hash validation?
-
 #include "stdafx.h"
 #include "config.librpbase.h"
 
@@ -18,12 +16,19 @@
 #ifdef ENABLE_DECRYPTION
 #  include "librpbase/crypto/IAesCipher.hpp"
 #  include "librpbase/crypto/AesCipherFactory.hpp"
+#  include "librpbase/crypto/Hash.hpp"
 #endif /* ENABLE_DECRYPTION */
 using namespace LibRpBase;
 using namespace LibRpFile;
 
+// librpthreads
+#include "librpthreads/ThreadPool.hpp"
+
 // C++ STL classes
+#include <atomic>
+using std::array;
 using std::unique_ptr;
+using std::vector;
 
 namespace LibRomData {
 
@@ -61,6 +66,28 @@ public:
 public:
 	// AES cipher for this content file's encryption key
 	IAesCipher *cipher;
+
+	// Encryption key, saved for verifyHashes()'s worker ciphers.
+	uint8_t key[16];
+
+	// Sectors per 1 MB superblock. (shared H0 table)
+	static constexpr unsigned int SECTORS_PER_SUPERBLOCK = 16;
+
+	/**
+	 * Decrypt and verify one 1 MB superblock. (worker thread)
+	 *
+	 * Checks each sector's H0 hash against its data area, the H0
+	 * table against the H1 table, and the H1 table against the
+	 * H2 table.
+	 *
+	 * @param pSectors	[in/out] Encrypted sectors. (decrypted in place)
+	 * @param count		[in] Number of sectors in this superblock. (up to 16)
+	 * @param firstSector	[in] Absolute sector number of pSectors[0].
+	 * @param cipher	[in] AES cipher with the content key.
+	 * @return Number of sectors that failed verification.
+	 */
+	static unsigned int verifyHashBlock(WUP_H3_Content_Block *pSectors, unsigned int count,
+		uint32_t firstSector, IAesCipher *cipher);
 #endif
 };
 
@@ -107,6 +134,8 @@ WiiUH3ReaderPrivate::WiiUH3ReaderPrivate(WiiUH3Reader *q, const uint8_t *pKey, s
 	}
 
 	// Key is loaded.
+	// Save it for verifyHashes()'s worker ciphers.
+	memcpy(this->key, pKey, sizeof(this->key));
 #else /* !ENABLE_DECRYPTION */
 	// FIXME: Some sort of error?
 	q->m_lastError = ENOTSUP;
@@ -185,6 +214,100 @@ int WiiUH3ReaderPrivate::readSector(uint32_t sector_num)
 	return 0;
 }
 
+#ifdef ENABLE_DECRYPTION
+/**
+ * Decrypt and verify one 1 MB superblock. (worker thread)
+ *
+ * Checks each sector's H0 hash against its data area, the H0
+ * table against the H1 table, and the H1 table against the
+ * H2 table.
+ *
+ * @param pSectors	[in/out] Encrypted sectors. (decrypted in place)
+ * @param count		[in] Number of sectors in this superblock. (up to 16)
+ * @param firstSector	[in] Absolute sector number of pSectors[0].
+ * @param cipher	[in] AES cipher with the content key.
+ * @return Number of sectors that failed verification.
+ */
+unsigned int WiiUH3ReaderPrivate::verifyHashBlock(WUP_H3_Content_Block *pSectors, unsigned int count,
+	uint32_t firstSector, IAesCipher *cipher)
+{
+	assert(count > 0);
+	assert(count <= SECTORS_PER_SUPERBLOCK);
+	if (count == 0 || count > SECTORS_PER_SUPERBLOCK) {
+		return 0;
+	}
+
+	// Decrypt the hash blocks first. (IV is zero)
+	// The data IV is hashes.h0[sector % 16], which is only
+	// available after the hash block has been decrypted.
+	static const uint8_t zero_iv[16] = { };
+	array<IAesCipher::DecryptBlock, SECTORS_PER_SUPERBLOCK> blocks;
+	for (unsigned int i = 0; i < count; i++) {
+		blocks[i].pData = reinterpret_cast<uint8_t*>(&pSectors[i].hashes);
+		blocks[i].size = sizeof(pSectors[i].hashes);
+		blocks[i].pIV = zero_iv;
+	}
+	if (cipher->decryptBatch(blocks.data(), count) !=
+	    static_cast<size_t>(count) * sizeof(pSectors[0].hashes))
+	{
+		// Decryption failed. Nothing can be verified.
+		return count;
+	}
+
+	// Decrypt the data areas.
+	for (unsigned int i = 0; i < count; i++) {
+		blocks[i].pData = pSectors[i].data;
+		blocks[i].size = sizeof(pSectors[i].data);
+		blocks[i].pIV = pSectors[i].hashes.h0[(firstSector + i) % SECTORS_PER_SUPERBLOCK];
+	}
+	if (cipher->decryptBatch(blocks.data(), count) !=
+	    static_cast<size_t>(count) * WUP_H3_SECTOR_SIZE_DECRYPTED)
+	{
+		// Decryption failed. Nothing can be verified.
+		return count;
+	}
+
+	Hash sha1(Hash::Algorithm::SHA1);
+	if (!sha1.isUsable()) {
+		// SHA-1 is not available.
+		return count;
+	}
+
+	uint8_t digest[20];
+	auto check = [&sha1, &digest](const void *pData, size_t len, const uint8_t *pExpected) -> bool {
+		sha1.reset();
+		sha1.process(pData, len);
+		sha1.getHash(digest, sizeof(digest));
+		return (memcmp(digest, pExpected, sizeof(digest)) == 0);
+	};
+
+	unsigned int bad = 0;
+	for (unsigned int i = 0; i < count; i++) {
+		const WUP_H3_Content_Block &sector = pSectors[i];
+		const uint32_t n = firstSector + i;
+
+		// H0: Hash of this sector's data area.
+		bool ok = check(sector.data, sizeof(sector.data), sector.hashes.h0[n % 16]);
+
+		// H1: Hash of this superblock's H0 table.
+		if (ok) {
+			ok = check(sector.hashes.h0, sizeof(sector.hashes.h0), sector.hashes.h1[(n / 16) % 16]);
+		}
+
+		// H2: Hash of this 16 MB block's H1 table.
+		if (ok) {
+			ok = check(sector.hashes.h1, sizeof(sector.hashes.h1), sector.hashes.h2[(n / 256) % 16]);
+		}
+
+		if (!ok) {
+			bad++;
+		}
+	}
+
+	return bad;
+}
+#endif /* ENABLE_DECRYPTION */
+
 /** WiiUH3Reader **/
 
 /**
@@ -395,4 +518,105 @@ off64_t WiiUH3Reader::partition_size_used(void) const
 	return d->partition_size;
 }
 
+/** WiiUH3Reader **/
+
+/**
+ * Verify the content's SHA-1 hash tree. (H0/H1/H2)
+ *
+ * This reads and decrypts the entire content file, so it's an
+ * expensive operation. 1 MB superblocks (16 sectors) are
+ * verified in parallel on the process-wide ThreadPool, with
+ * file I/O staying on the calling thread.
+ *
+ * NOTE: The H3 table is stored in a separate ".h3" file, which
+ * isn't available here, so the H2 tables are not verified
+ * against their root hashes.
+ *
+ * @param pBadSectors	[out,opt] Number of sectors that failed verification.
+ * @return 0 if all hashes verified; 1 if mismatches were found; negative POSIX error code on error.
+ */
+int WiiUH3Reader::verifyHashes(size_t *pBadSectors)
+{
+	if (pBadSectors) {
+		*pBadSectors = 0;
+	}
+
+	if (!m_file || !m_file->isOpen()) {
+		m_lastError = EBADF;
+		return -EBADF;
+	}
+
+#ifdef ENABLE_DECRYPTION
+	RP_D(WiiUH3Reader);
+	const uint32_t numSectors = static_cast<uint32_t>(
+		d->partition_size / WUP_H3_SECTOR_SIZE_ENCRYPTED);
+	const uint32_t numBlocks = (numSectors + WiiUH3ReaderPrivate::SECTORS_PER_SUPERBLOCK - 1) /
+		WiiUH3ReaderPrivate::SECTORS_PER_SUPERBLOCK;
+	assert(numSectors > 0);
+	if (numSectors == 0) {
+		m_lastError = EIO;
+		return -EIO;
+	}
+
+	// Superblocks are verified in parallel, in waves of one block
+	// per worker thread. The content file is only read on this thread.
+	LibRpThreads::ThreadPool &pool = LibRpThreads::ThreadPool::instance();
+	const unsigned int nWorkers = std::min<uint32_t>(pool.maxThreads(), numBlocks);
+	vector<rp::uvector<uint8_t> > blockBuf(nWorkers);
+	std::atomic<unsigned int> badSectors{0};
+	std::atomic<int> err{0};
+
+	for (uint32_t block = 0; block < numBlocks && err == 0; ) {
+		LibRpThreads::TaskSet tasks;
+		for (unsigned int w = 0; w < nWorkers && block < numBlocks; w++, block++) {
+			const uint32_t firstSector = block * WiiUH3ReaderPrivate::SECTORS_PER_SUPERBLOCK;
+			const unsigned int count = std::min<uint32_t>(
+				WiiUH3ReaderPrivate::SECTORS_PER_SUPERBLOCK, numSectors - firstSector);
+
+			auto &buf = blockBuf[w];
+			buf.resize(static_cast<size_t>(count) * WUP_H3_SECTOR_SIZE_ENCRYPTED);
+			const off64_t addr = static_cast<off64_t>(firstSector) * WUP_H3_SECTOR_SIZE_ENCRYPTED;
+			const size_t sz = m_file->seekAndRead(addr, buf.data(), buf.size());
+			if (sz != buf.size()) {
+				err = -EIO;
+				break;
+			}
+
+			WUP_H3_Content_Block *const pSectors =
+				reinterpret_cast<WUP_H3_Content_Block*>(buf.data());
+			tasks.submit([d, pSectors, count, firstSector, &badSectors, &err]() {
+				// Each worker thread needs its own cipher.
+				unique_ptr<IAesCipher> cipher(AesCipherFactory::create());
+				if (!cipher || !cipher->isInit() ||
+				    cipher->setKey(d->key, sizeof(d->key)) != 0 ||
+				    cipher->setChainingMode(IAesCipher::ChainingMode::CBC) != 0)
+				{
+					err = -EIO;
+					return;
+				}
+				badSectors += WiiUH3ReaderPrivate::verifyHashBlock(
+					pSectors, count, firstSector, cipher.get());
+			});
+		}
+
+		// Wait for this wave to finish before reusing the buffers.
+		tasks.wait();
+	}
+
+	if (pBadSectors) {
+		*pBadSectors = badSectors;
+	}
+	const int err_val = err;
+	if (err_val != 0) {
+		m_lastError = -err_val;
+		return err_val;
+	}
+	return (badSectors == 0) ? 0 : 1;
+#else /* !ENABLE_DECRYPTION */
+	// Hash verification requires AES and SHA-1 from the crypto backend.
+	m_lastError = ENOTSUP;
+	return -ENOTSUP;
+#endif /* ENABLE_DECRYPTION */
+}
+
 }
@@ -84,6 +84,26 @@ public:
 	 * @return Used partition size, or -1 on error.
 	 */
 	off64_t partition_size_used(void) const override;
+
+public:
+	/** WiiUH3Reader **/
+
+	/**
+	 * Verify the content's SHA-1 hash tree. (H0/H1/H2)
+	 *
+	 * This reads and decrypts the entire content file, so it's an
+	 * expensive operation. 1 MB superblocks (16 sectors) are
+	 * verified in parallel on the process-wide ThreadPool, with
+	 * file I/O staying on the calling thread.
+	 *
+	 * NOTE: The H3 table is stored in a separate ".h3" file, which
+	 * isn't available here, so the H2 tables are not verified
+	 * against their root hashes.
+	 *
+	 * @param pBadSectors	[out,opt] Number of sectors that failed verification.
+	 * @return 0 if all hashes verified; 1 if mismatches were found; negative POSIX error code on error.
+	 */
+	int verifyHashes(size_t *pBadSectors = nullptr);
 };
 
 typedef std::shared_ptr<WiiUH3Reader> WiiUH3ReaderPtr;
@@ -49,6 +49,16 @@ public:
 	// is a byte array, not an ISO_DirEntry array.
 	unordered_map<std::string, rp::uvector<uint8_t> > dirTables;
 
+	// Path index, built incrementally by getDirEntry().
+	// - Key: Filename, uppercased. (XDVDFS is case-insensitive.) [cp1252]
+	// - Value: Directory entry. (points into dirTables; dirTables
+	//   entries are never freed while the partition is open)
+	// Probing opens the same well-known paths several times, so
+	// repeated lookups skip the AVL tree walk entirely.
+	// NOTE: Keys don't include a directory component, since only
+	// the root directory is currently supported.
+	unordered_map<std::string, const XDVDFS_DirEntry*> path_index;
+
 	/**
 	 * Get an entry within a specified directory table.
 	 * @param dirTable Directory table.
@@ -177,6 +187,21 @@ const XDVDFS_DirEntry *XDVDFSPartitionPrivate::getDirEntry(const rp::uvector<uin
 	// Convert the filename portion to cp1252 before searching.
 	const string s_filename = utf8_to_cp1252(filename, -1);
 
+	// Check the path index first.
+	// NOTE: Uppercasing the key, since XDVDFS filenames
+	// are case-insensitive.
+	string s_key(s_filename);
+	for (char &c : s_key) {
+		if (c >= 'a' && c <= 'z') {
+			c &= ~0x20;
+		}
+	}
+	auto idx_iter = path_index.find(s_key);
+	if (idx_iter != path_index.end()) {
+		// Path has already been looked up.
+		return idx_iter->second;
+	}
+
 	// Find the file in the specified directory.
 	// NOTE: Filenames are case-insensitive.
 	const XDVDFS_DirEntry *dirEntry_found = nullptr;
@@ -236,6 +261,12 @@ const XDVDFS_DirEntry *XDVDFSPartitionPrivate::getDirEntry(const rp::uvector<uin
 		return nullptr;
 	}
 
+	// Save the entry in the path index.
+	// NOTE: The entry points into dirTables, which is never
+	// freed while the partition is open, so the pointer
+	// remains valid.
+	path_index.emplace(std::move(s_key), dirEntry_found);
+
 	// Return the directory entry.
 	return dirEntry_found;
 }
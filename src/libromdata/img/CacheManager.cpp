@@ -11,25 +11,154 @@
 #include "CacheManager.hpp"
 
 // Other rom-properties libraries
+#include "librpbase/img/RpPng.hpp"
 #include "librpfile/RpFile.hpp"
 #include "librpfile/FileSystem.hpp"
 #include "librpthreads/Semaphore.hpp"
 using namespace LibRpBase;
 using namespace LibRpFile;
+using LibRpTexture::rp_image;
+using LibRpTexture::rp_image_const_ptr;
 using LibRpThreads::Semaphore;
 using LibRpThreads::SemaphoreLocker;
 
 // libcachecommon
 #include "libcachecommon/CacheKeys.hpp"
+#include "libcachecommon/CacheManifest.hpp"
 
 // C includes (C++ namespace)
 #include <ctime>
 
 // C++ STL classes
+#include <algorithm>
+#include <list>
+#include <mutex>
+#include <unordered_map>
 using std::string;
 
 namespace LibRomData {
 
+namespace {
+
+/**
+ * In-process sharded LRU over cache keys, in front of the disk cache.
+ *
+ * RomDataView re-requests the same cache key several times per view,
+ * and negative lookups ("no such cover art") repeat for obscure titles,
+ * so both outcomes are kept briefly in memory to skip the per-lookup
+ * path construction and stat() round trips.
+ *
+ * Entries expire after a TTL: positive entries because the disk cache
+ * can be cleared externally, negative entries so a download by another
+ * process is picked up.
+ */
+class CacheKeyLru
+{
+	public:
+		CacheKeyLru() = default;
+
+	private:
+		RP_DISABLE_COPY(CacheKeyLru)
+
+	private:
+		// Entry: resolved cache filename.
+		// An empty filename is a negative entry.
+		// ("not cached, and not on the server")
+		struct Entry {
+			string cache_key;
+			string filename;
+			time_t expires;
+		};
+		typedef std::list<Entry> EntryList;
+
+		static constexpr unsigned int SHARD_COUNT = 8;
+		static constexpr size_t SHARD_CAPACITY = 64;	// keys per shard
+		static constexpr time_t POSITIVE_TTL = 5*60;	// seconds
+		static constexpr time_t NEGATIVE_TTL = 30;	// seconds
+
+		// Keys are distributed over shards by hash, so concurrent
+		// lookups from different views mostly take different locks.
+		struct Shard {
+			std::mutex mutex;
+			EntryList lru;	// Most recently used first.
+			std::unordered_map<string, EntryList::iterator> map;
+		};
+		Shard m_shards[SHARD_COUNT];
+
+		inline Shard &shardForKey(const string &cache_key)
+		{
+			return m_shards[std::hash<string>()(cache_key) % SHARD_COUNT];
+		}
+
+	public:
+		/**
+		 * Look up a cache key.
+		 * @param cache_key	[in] Cache key.
+		 * @param pFilename	[out] Cached filename; empty for a negative entry.
+		 * @return True if a fresh entry was found; false on miss or expired entry.
+		 */
+		bool lookup(const string &cache_key, string *pFilename)
+		{
+			Shard &shard = shardForKey(cache_key);
+			std::lock_guard<std::mutex> lock(shard.mutex);
+
+			auto iter = shard.map.find(cache_key);
+			if (iter == shard.map.end()) {
+				// Not in the cache.
+				return false;
+			}
+
+			if (time(nullptr) >= iter->second->expires) {
+				// Expired. Drop the entry.
+				shard.lru.erase(iter->second);
+				shard.map.erase(iter);
+				return false;
+			}
+
+			// Move the entry to the front of the LRU list.
+			shard.lru.splice(shard.lru.begin(), shard.lru, iter->second);
+			*pFilename = iter->second->filename;
+			return true;
+		}
+
+		/**
+		 * Store a lookup result.
+		 * @param cache_key	[in] Cache key.
+		 * @param filename	[in] Cached filename; empty for a negative entry.
+		 */
+		void store(const string &cache_key, const string &filename)
+		{
+			const time_t expires = time(nullptr) +
+				(filename.empty() ? NEGATIVE_TTL : POSITIVE_TTL);
+
+			Shard &shard = shardForKey(cache_key);
+			std::lock_guard<std::mutex> lock(shard.mutex);
+
+			auto iter = shard.map.find(cache_key);
+			if (iter != shard.map.end()) {
+				// Update the existing entry.
+				iter->second->filename = filename;
+				iter->second->expires = expires;
+				shard.lru.splice(shard.lru.begin(), shard.lru, iter->second);
+				return;
+			}
+
+			// Evict the least recently used entry if the shard is full.
+			if (shard.map.size() >= SHARD_CAPACITY) {
+				shard.map.erase(shard.lru.back().cache_key);
+				shard.lru.pop_back();
+			}
+
+			shard.lru.emplace_front(Entry{cache_key, filename, expires});
+			shard.map.emplace(cache_key, shard.lru.begin());
+		}
+};
+
+// Process-wide cache key LRU.
+CacheKeyLru g_cacheKeyLru;
+
+}
+
 // Semaphore used to limit the number of simultaneous downloads.
 // TODO: Determine the best number of simultaneous downloads.
 // TODO: Test this on XP with IEIFLAG_ASYNC.
@@ -84,6 +213,22 @@ string CacheManager::download(const char *cache_key)
 	// - getCacheFilename() filters it
 	// - We call filterCacheKey() before passing it to rp-download.
 
+	// If the cache key begins with "sys/", then we have to
+	// attempt to download the file, since it may be updated
+	// with e.g. new version information.
+	const bool check_newer = (!strncmp(cache_key, "sys/", 4));
+
+	// Check the in-process LRU first.
+	// (Not for "sys/" keys, since those are always rechecked.)
+	if (!check_newer) {
+		string lru_filename;
+		if (g_cacheKeyLru.lookup(cache_key, &lru_filename)) {
+			// Positive entries return the resolved filename;
+			// negative entries ("not on the server") return {}.
+			return lru_filename;
+		}
+	}
+
 	// Check the main cache key.
 	string cache_filename = LibCacheCommon::getCacheFilename(cache_key);
 	if (cache_filename.empty()) {
@@ -91,20 +236,29 @@ string CacheManager::download(const char *cache_key)
 		return {};
 	}
 
-	// If the cache key begins with "sys/", then we have to
-	// attempt to download the file, since it may be updated
-	// with e.g. new version information.
-	const bool check_newer = (!strncmp(cache_key, "sys/", 4));
-
 	// Lock the semaphore to make sure we don't
 	// download too many files at once.
 	SemaphoreLocker locker(m_dlsem);
 
 	if (!check_newer) {
 		// Check if the file already exists.
+		// The cache manifest is checked first, so a manifest hit
+		// doesn't touch the filesystem. (NFS home directories)
 		off64_t filesize = 0;
 		time_t filemtime = 0;
-		int ret = FileSystem::get_file_size_and_mtime(cache_filename, &filesize, &filemtime);
+		int ret;
+		int64_t manifest_size = 0;
+		const bool from_manifest =
+			(LibCacheCommon::manifestLookup(cache_key, &manifest_size, &filemtime) == 0);
+		if (from_manifest) {
+			filesize = static_cast<off64_t>(manifest_size);
+			ret = 0;
+		} else {
+			ret = FileSystem::get_file_size_and_mtime(cache_filename, &filesize, &filemtime);
+			if (ret == 0) {
+				LibCacheCommon::manifestUpdate(cache_key, filesize, filemtime);
+			}
+		}
 		if (ret == 0) {
 			// Check if the file is 0 bytes.
 			// TODO: How should we handle errors?
@@ -116,6 +270,7 @@ string CacheManager::download(const char *cache_key)
 				const time_t systime = time(nullptr);
 				if ((systime - filemtime) < (86400*7)) {
 					// Less than a week old.
+					g_cacheKeyLru.store(cache_key, {});
 					return {};
 				}
 
@@ -123,17 +278,39 @@ string CacheManager::download(const char *cache_key)
 				// Delete the cache file and try to download it again.
 				if (FileSystem::delete_file(cache_filename) != 0) {
 					// Unable to delete the cache file.
+					// Drop the manifest entry so the next attempt
+					// checks the filesystem. (The entry may be stale.)
+					LibCacheCommon::manifestRemove(cache_key);
 					return {};
 				}
+				LibCacheCommon::manifestRemove(cache_key);
 			} else if (filesize > 0) {
 				// File is larger than 0 bytes, which indicates
 				// it was cached successfully.
+				g_cacheKeyLru.store(cache_key, cache_filename);
 				return cache_filename;
 			}
 		} else if (ret != -ENOENT) {
 			// Some error other than "file not found" occurred.
 			return {};
 		}
+	} else {
+		// "Newer" cache keys are normally redownloaded on every
+		// request. Apply a short TTL so multiple requests in quick
+		// succession (e.g. reopening rp-config) reuse the last
+		// result instead of hitting the network again.
+		off64_t filesize = 0;
+		time_t filemtime = 0;
+		if (FileSystem::get_file_size_and_mtime(cache_filename, &filesize, &filemtime) == 0 &&
+		    filesize > 0)
+		{
+			// TODO: Configurable time.
+			const time_t systime = time(nullptr);
+			if ((systime - filemtime) < (60*60)) {
+				// Less than an hour old. Use the cached copy.
+				return cache_filename;
+			}
+		}
 	}
 
 	// TODO: Add an option for "offline only".
@@ -149,12 +326,32 @@ string CacheManager::download(const char *cache_key)
 	// results in slashes being changed to backslashes on Windows.
 	// rp-download will filter the key itself.
 	int ret = execRpDownload(cache_key);
+
+	// Record the result in the cache manifest.
+	// NOTE: On failure, rp-download may have left a 0-byte file
+	// to indicate the file isn't on the server.
+	off64_t dl_filesize = 0;
+	time_t dl_filemtime = 0;
+	if (FileSystem::get_file_size_and_mtime(cache_filename, &dl_filesize, &dl_filemtime) == 0) {
+		LibCacheCommon::manifestUpdate(cache_key, dl_filesize, dl_filemtime);
+	}
+
 	if (ret != 0) {
 		// rp-download failed for some reason.
+		if (!check_newer) {
+			g_cacheKeyLru.store(cache_key, {});
+		} else if (dl_filesize > 0) {
+			// A stale copy of a "newer" key is better than nothing,
+			// e.g. if the update check is run while offline.
+			return cache_filename;
+		}
 		return {};
 	}
 
 	// rp-download has successfully downloaded the file.
+	if (!check_newer) {
+		g_cacheKeyLru.store(cache_key, cache_filename);
+	}
 	return cache_filename;
 }
 
@@ -165,6 +362,12 @@ string CacheManager::download(const char *cache_key)
  */
 string CacheManager::findInCache(const char *cache_key)
 {
+	// Check the in-process LRU first.
+	string lru_filename;
+	if (g_cacheKeyLru.lookup(cache_key, &lru_filename)) {
+		return lru_filename;
+	}
+
 	// Get the cache key filename.
 	string cache_filename = LibCacheCommon::getCacheFilename(cache_key);
 	if (cache_filename.empty()) {
@@ -172,12 +375,162 @@ string CacheManager::findInCache(const char *cache_key)
 		return {};
 	}
 
-	// Return the filename if the file exists.
-	if (FileSystem::access(cache_filename.c_str(), R_OK) != 0) {
-		// Unable to read the cache file.
-		cache_filename.clear();
+	// Check the cache manifest, so a manifest hit doesn't
+	// touch the filesystem. (NFS home directories)
+	int64_t manifest_size = 0;
+	time_t manifest_mtime = 0;
+	if (LibCacheCommon::manifestLookup(cache_key, &manifest_size, &manifest_mtime) != 0) {
+		// Not in the manifest. Check the filesystem.
+		// NOTE: Using get_file_size_and_mtime() instead of access()
+		// so the result can be recorded in the manifest.
+		off64_t filesize = 0;
+		time_t filemtime = 0;
+		if (FileSystem::get_file_size_and_mtime(cache_filename, &filesize, &filemtime) == 0) {
+			LibCacheCommon::manifestUpdate(cache_key, filesize, filemtime);
+		} else {
+			// Cache file doesn't exist.
+			cache_filename.clear();
+		}
 	}
+	g_cacheKeyLru.store(cache_key, cache_filename);
 	return cache_filename;
 }
 
+/**
+ * Get the variant size bucket for a requested image size.
+ * @param reqSize Requested image size.
+ * @return Variant size bucket, or 0 if no bucket applies.
+ */
+static inline int variantSizeBucket(int reqSize)
+{
+	if (reqSize <= 0 || reqSize > 512) {
+		// Out of range. Use the original file.
+		return 0;
+	} else if (reqSize <= 128) {
+		return 128;
+	} else if (reqSize <= 256) {
+		return 256;
+	}
+	return 512;
+}
+
+/**
+ * Get the filename for a pre-scaled variant of a cached file.
+ * @param cache_filename Cached original file.
+ * @param bucket Variant size bucket.
+ * @return Variant filename.
+ */
+static inline string variantFilename(const string &cache_filename, int bucket)
+{
+	string vfilename;
+	vfilename.reserve(cache_filename.size() + 10);
+	vfilename = cache_filename;
+	vfilename += ".v";
+	char buf[16];
+	snprintf(buf, sizeof(buf), "%d", bucket);
+	vfilename += buf;
+	vfilename += ".png";
+	return vfilename;
+}
+
+/**
+ * Find a pre-scaled variant of a cached file.
+ *
+ * Variants are stored alongside the original in size buckets
+ * (128/256/512 px) and are generated on first access by
+ * saveVariant(). Loading a variant is a small-file read
+ * instead of a full-size decode and rescale.
+ *
+ * @param cache_filename Cached original file. (from download() or findInCache())
+ * @param reqSize Requested image size.
+ * @return Absolute path to the variant file, or empty string if no usable variant exists.
+ */
+string CacheManager::findVariant(const string &cache_filename, int reqSize)
+{
+	const int bucket = variantSizeBucket(reqSize);
+	if (bucket == 0 || cache_filename.empty()) {
+		// No variant bucket for this size.
+		return {};
+	}
+
+	string vfilename = variantFilename(cache_filename, bucket);
+	off64_t vsize = 0;
+	time_t vmtime = 0;
+	if (FileSystem::get_file_size_and_mtime(vfilename, &vsize, &vmtime) != 0 || vsize <= 0) {
+		// No variant file.
+		return {};
+	}
+
+	// If the original is newer than the variant, e.g. because it
+	// was redownloaded, the variant is stale and must be regenerated.
+	off64_t osize = 0;
+	time_t omtime = 0;
+	if (FileSystem::get_file_size_and_mtime(cache_filename, &osize, &omtime) == 0 &&
+	    omtime > vmtime)
+	{
+		// Variant is stale.
+		return {};
+	}
+
+	return vfilename;
+}
+
+/**
+ * Save a pre-scaled variant of a cached file.
+ *
+ * The image is scaled down to the variant size bucket for
+ * reqSize and saved as PNG alongside the original. If the
+ * original already fits within the bucket, no variant is
+ * saved, since loading the original is just as cheap.
+ *
+ * @param cache_filename Cached original file. (from download() or findInCache())
+ * @param reqSize Requested image size.
+ * @param img Decoded original image. (must be ARGB32)
+ * @return Absolute path to the variant file, or empty string if no variant was saved.
+ */
+string CacheManager::saveVariant(const string &cache_filename, int reqSize,
+	const rp_image_const_ptr &img)
+{
+	const int bucket = variantSizeBucket(reqSize);
+	if (bucket == 0 || cache_filename.empty() ||
+	    !img || !img->isValid() ||
+	    img->format() != rp_image::Format::ARGB32)
+	{
+		// Can't save a variant.
+		return {};
+	}
+
+	const int width = img->width();
+	const int height = img->height();
+	if (width <= bucket && height <= bucket) {
+		// The original already fits within the bucket.
+		// Loading it directly is just as cheap.
+		return {};
+	}
+
+	// Scale down to the bucket, maintaining the aspect ratio.
+	int new_width, new_height;
+	if (width >= height) {
+		new_width = bucket;
+		new_height = std::max(1, (height * bucket) / width);
+	} else {
+		new_height = bucket;
+		new_width = std::max(1, (width * bucket) / height);
+	}
+	const rp_image_const_ptr scaled_img = img->scaled_down(new_width, new_height);
+	if (!scaled_img || !scaled_img->isValid()) {
+		// Scaling failed.
+		return {};
+	}
+
+	// Save the variant. (best-effort)
+	string vfilename = variantFilename(cache_filename, bucket);
+	if (RpPng::save(vfilename.c_str(), scaled_img) != 0) {
+		// Error saving the variant.
+		return {};
+	}
+
+	return vfilename;
+}
+
 }
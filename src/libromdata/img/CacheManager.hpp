@@ -15,6 +15,9 @@ namespace LibRpThreads {
 	class Semaphore;
 }
 
+// librptexture
+#include "librptexture/img/rp_image.hpp"
+
 // C++ includes.
 #include <string>
 
@@ -115,6 +118,38 @@ public:
 		return findInCache(cache_key.c_str());
 	}
 
+	/**
+	 * Find a pre-scaled variant of a cached file.
+	 *
+	 * Variants are stored alongside the original in size buckets
+	 * (128/256/512 px) and are generated on first access by
+	 * saveVariant(). Loading a variant is a small-file read
+	 * instead of a full-size decode and rescale.
+	 *
+	 * @param cache_filename Cached original file. (from download() or findInCache())
+	 * @param reqSize Requested image size.
+	 * @return Absolute path to the variant file, or empty string if no usable variant exists.
+	 */
+	RP_LIBROMDATA_PUBLIC
+	std::string findVariant(const std::string &cache_filename, int reqSize);
+
+	/**
+	 * Save a pre-scaled variant of a cached file.
+	 *
+	 * The image is scaled down to the variant size bucket for
+	 * reqSize and saved as PNG alongside the original. If the
+	 * original already fits within the bucket, no variant is
+	 * saved, since loading the original is just as cheap.
+	 *
+	 * @param cache_filename Cached original file. (from download() or findInCache())
+	 * @param reqSize Requested image size.
+	 * @param img Decoded original image. (must be ARGB32)
+	 * @return Absolute path to the variant file, or empty string if no variant was saved.
+	 */
+	RP_LIBROMDATA_PUBLIC
+	std::string saveVariant(const std::string &cache_filename, int reqSize,
+		const LibRpTexture::rp_image_const_ptr &img);
+
 protected:
 	/**
 	 * Execute rp-download.
@@ -11,7 +11,9 @@
 #include "CacheManager.hpp"
 
 // OS-specific includes.
+#include <poll.h>
 #include <signal.h>
+#include <sys/socket.h>
 #include <sys/types.h>
 #include <sys/wait.h>
 #include <unistd.h>
@@ -20,35 +22,29 @@
 #endif /* HAVE_POSIX_SPAWN */
 
 // C++ includes.
+#include <mutex>
 #include <string>
 using std::string;
 
 namespace LibRomData {
 
+// rp-download executable path.
+// TODO: Mac OS X path. (bundle?)
+static constexpr char rp_download_exe[] = DIR_INSTALL_LIBEXEC "/rp-download";
+
 /**
- * Execute rp-download. (POSIX version)
- * @param filteredCacheKey Filtered cache key.
- * @return 0 on success; negative POSIX error code on error.
+ * Build a minimal environment for rp-download.
+ * This will include http_proxy and https_proxy if the proxy URL is set.
+ * TODO: Separate proxies for http and https?
+ * @param proxyUrl	[in] Proxy URL, or empty string to use the environment.
+ * @param s_env		[out] Backing storage for the environment strings.
+ * @param envp		[out] envp array. (5 entries, NULL-terminated)
  */
-int CacheManager::execRpDownload(const string &filteredCacheKey)
+static void buildRpDownloadEnvp(const string &proxyUrl, string &s_env, const char *envp[5])
 {
-	// TODO: Mac OS X path. (bundle?)
- 	static constexpr char rp_download_exe[] = DIR_INSTALL_LIBEXEC "/rp-download";
-
-	// Parameters.
-	const char *const argv[3] = {
-		rp_download_exe,
-		filteredCacheKey.c_str(),
-		nullptr
-	};
-
-	// Define a minimal environment for cURL.
-	// This will include http_proxy and https_proxy if the proxy URL is set.
-	// TODO: Separate proxies for http and https?
-	// TODO: Only build this once?
 	int pos[5] = {-1, -1, -1, -1, -1};
 	int count = 0;
-	std::string s_env;
+	s_env.clear();
 	s_env.reserve(1024);
 
 	// We want the HOME and USER variables.
@@ -68,7 +64,7 @@ int CacheManager::execRpDownload(const string &filteredCacheKey)
 		s_env += envtmp;
 		s_env += '\0';
 	}
-	if (m_proxyUrl.empty()) {
+	if (proxyUrl.empty()) {
 		// Proxy URL is empty. Get the URLs from the environment.
 		envtmp = getenv("http_proxy");
 		if (envtmp && envtmp[0] != '\0') {
@@ -87,19 +83,256 @@ int CacheManager::execRpDownload(const string &filteredCacheKey)
 	} else {
 		// Proxy URL is set. Use it.
 		pos[count++] = static_cast<int>(s_env.size());
-		s_env += "http_proxy=" + m_proxyUrl;
+		s_env += "http_proxy=" + proxyUrl;
 		pos[count++] = static_cast<int>(s_env.size());
-		s_env += "https_proxy=" + m_proxyUrl;
+		s_env += "https_proxy=" + proxyUrl;
 	}
 
 	// Build envp.
-	const char *envp[5] = {nullptr, nullptr, nullptr, nullptr, nullptr};
+	envp[0] = envp[1] = envp[2] = envp[3] = envp[4] = nullptr;
 	unsigned int envp_idx = 0;
 	for (unsigned int i = 0; i < 5; i++) {
 		if (pos[i] >= 0) {
 			envp[envp_idx++] = &s_env[pos[i]];
 		}
 	}
+}
+
+namespace {
+
+/**
+ * Persistent rp-download daemon.
+ *
+ * Keeps a single sandboxed rp-download instance alive and sends it
+ * cache keys over a socketpair, one per line. The daemon answers with
+ * one status line per key ("ok <key>" or "err <key>"). This amortizes
+ * process spawn, library init, and TLS session setup across downloads
+ * while preserving the privilege separation of the one-shot design:
+ * the daemon is the same sandboxed executable.
+ *
+ * Opt-in via RP_DOWNLOAD_DAEMON=1. Any protocol failure shuts the
+ * daemon down, and the caller falls back to a one-shot process.
+ */
+class RpDownloadDaemon
+{
+public:
+	RpDownloadDaemon()
+		: m_pid(-1)
+		, m_fd(-1)
+	{}
+
+	~RpDownloadDaemon()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		stop();
+	}
+
+private:
+	RP_DISABLE_COPY(RpDownloadDaemon)
+
+public:
+	/**
+	 * Download a cache key using the daemon.
+	 * Starts the daemon if it isn't running yet.
+	 * @param filteredCacheKey	[in] Filtered cache key.
+	 * @param proxyUrl		[in] Proxy URL, or empty string to use the environment.
+	 * @return 0 on success; negative POSIX error code on error.
+	 */
+	int request(const string &filteredCacheKey, const string &proxyUrl)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_pid < 0) {
+			const int ret = start(proxyUrl);
+			if (ret != 0) {
+				return ret;
+			}
+		}
+
+		// Send the request line.
+		string line = filteredCacheKey;
+		line += '\n';
+		ssize_t sret = send(m_fd, line.data(), line.size(), MSG_NOSIGNAL);
+		if (sret != static_cast<ssize_t>(line.size())) {
+			// Daemon is gone. (or a partial write; treat it the same)
+			stop();
+			return -EPIPE;
+		}
+
+		// Read the response line.
+		// The protocol is lock-step, so everything up to the next
+		// newline is the response for this request.
+		string response;
+		response.reserve(filteredCacheKey.size() + 8);
+		while (true) {
+			struct pollfd pfd;
+			pfd.fd = m_fd;
+			pfd.events = POLLIN;
+			// Allow 30 seconds per request. The daemon's own
+			// download timeout is shorter, so a timeout here
+			// means the daemon is stuck.
+			const int pret = poll(&pfd, 1, 30*1000);
+			if (pret <= 0) {
+				// Timeout or error. Assume the daemon is stuck.
+				stop();
+				return -ETIMEDOUT;
+			}
+
+			char buf[64];
+			sret = recv(m_fd, buf, sizeof(buf), 0);
+			if (sret <= 0) {
+				// Daemon has exited.
+				stop();
+				return -EPIPE;
+			}
+
+			const char *const nl = static_cast<const char*>(memchr(buf, '\n', sret));
+			if (nl) {
+				response.append(buf, nl - buf);
+				break;
+			}
+			response.append(buf, sret);
+		}
+
+		// "ok <key>" indicates success.
+		if (response.size() >= 3 && !memcmp(response.data(), "ok ", 3)) {
+			return 0;
+		}
+		return -EIO;
+	}
+
+private:
+	/**
+	 * Start the daemon process.
+	 * m_mutex must be held by the caller.
+	 * @param proxyUrl	[in] Proxy URL, or empty string to use the environment.
+	 * @return 0 on success; negative POSIX error code on error.
+	 */
+	int start(const string &proxyUrl)
+	{
+		// Parameters.
+		const char *const argv[3] = {
+			rp_download_exe,
+			"-d",
+			nullptr
+		};
+
+		// Build the environment.
+		string s_env;
+		const char *envp[5];
+		buildRpDownloadEnvp(proxyUrl, s_env, envp);
+
+		// Create the socketpair for the daemon's stdin/stdout.
+		int sv[2];
+		errno = 0;
+		if (socketpair(AF_UNIX, SOCK_STREAM, 0, sv) != 0) {
+			const int err = errno;
+			return (err != 0 ? -err : -EIO);
+		}
+
+		// NOTE: Using fork()/execve() instead of posix_spawn(),
+		// since we need dup2() file actions for the socketpair.
+		errno = 0;
+		const pid_t pid = fork();
+		if (pid == 0) {
+			// Child process.
+			dup2(sv[1], STDIN_FILENO);
+			dup2(sv[1], STDOUT_FILENO);
+			close(sv[0]);
+			close(sv[1]);
+			execve(rp_download_exe, (char *const *)argv, (char *const *)envp);
+			// execve() failed.
+			_exit(EXIT_FAILURE);
+		} else if (pid == -1) {
+			// fork() failed.
+			const int err = errno;
+			close(sv[0]);
+			close(sv[1]);
+			return (err != 0 ? -err : -EIO);
+		}
+
+		// Parent process.
+		close(sv[1]);
+		m_pid = pid;
+		m_fd = sv[0];
+		return 0;
+	}
+
+	/**
+	 * Stop the daemon process.
+	 * m_mutex must be held by the caller.
+	 */
+	void stop(void)
+	{
+		if (m_fd >= 0) {
+			// Closing our end of the socketpair causes the
+			// daemon to exit cleanly on EOF.
+			close(m_fd);
+			m_fd = -1;
+		}
+		if (m_pid >= 0) {
+			// Wait briefly for the daemon to exit.
+			int wstatus = 0;
+			bool waited = false;
+			for (unsigned int i = 2*4; i > 0; i--) {
+				if (waitpid(m_pid, &wstatus, WNOHANG) == m_pid) {
+					waited = true;
+					break;
+				}
+				usleep(250*1000);
+			}
+			if (!waited) {
+				// Daemon is stuck. Kill it.
+				kill(m_pid, SIGTERM);
+				waitpid(m_pid, &wstatus, 0);
+			}
+			m_pid = -1;
+		}
+	}
+
+private:
+	pid_t m_pid;		// Daemon process ID (-1 if not running)
+	int m_fd;		// Our end of the socketpair (-1 if not running)
+	std::mutex m_mutex;
+};
+
+// Daemon instance.
+RpDownloadDaemon g_rpDownloadDaemon;
+
+} //namespace (anonymous)
+
+/**
+ * Execute rp-download. (POSIX version)
+ * @param filteredCacheKey Filtered cache key.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int CacheManager::execRpDownload(const string &filteredCacheKey)
+{
+	// Optional daemon mode: keep one sandboxed rp-download instance
+	// alive and send it cache keys over a socketpair. This amortizes
+	// process spawn and TLS session setup across downloads.
+	// Opt-in, since a long-lived child changes the process lifetime
+	// model for frontends.
+	const char *const daemon_env = getenv("RP_DOWNLOAD_DAEMON");
+	if (daemon_env && daemon_env[0] == '1') {
+		const int ret = g_rpDownloadDaemon.request(filteredCacheKey, m_proxyUrl);
+		if (ret == 0) {
+			return 0;
+		}
+		// Daemon failed. Fall back to a one-shot process.
+	}
+
+	// Parameters.
+	const char *const argv[3] = {
+		rp_download_exe,
+		filteredCacheKey.c_str(),
+		nullptr
+	};
+
+	// Build the environment.
+	// TODO: Only build this once?
+	string s_env;
+	const char *envp[5];
+	buildRpDownloadEnvp(m_proxyUrl, s_env, envp);
 
 	// TODO: Maybe we should close file handles...
 #ifdef HAVE_POSIX_SPAWN
@@ -46,6 +46,7 @@ namespace LibRomData {
  * Get an internal image.
  * @param romData	[in] RomData object
  * @param imageType	[in] Image type
+ * @param reqSize	[in] Requested image size. [0 for largest]
  * @param pOutSize	[out,opt] Pointer to ImgSize to store the image's size
  * @param sBIT		[out,opt] sBIT metadata
  * @return Internal image, or null ImgClass on error.
@@ -54,7 +55,7 @@ template<typename ImgClass>
 ImgClass TCreateThumbnail<ImgClass>::getInternalImage(
 	const RomDataPtr &romData,
 	RomData::ImageType imageType,
-	ImgSize *pOutSize,
+	int reqSize, ImgSize *pOutSize,
 	rp_image::sBIT_t *sBIT)
 {
 	assert(imageType >= RomData::IMG_INT_MIN && imageType <= RomData::IMG_INT_MAX);
@@ -66,7 +67,9 @@ ImgClass TCreateThumbnail<ImgClass>::getInternalImage(
 		return getNullImgClass();
 	}
 
-	const rp_image_const_ptr image = romData->image(imageType);
+	// NOTE: The size hint lets the subclass select a smaller source
+	// image, e.g. a texture mipmap, instead of the full-size image.
+	const rp_image_const_ptr image = romData->image(imageType, reqSize);
 	if (!image) {
 		// No image.
 		if (sBIT) {
@@ -75,8 +78,6 @@ ImgClass TCreateThumbnail<ImgClass>::getInternalImage(
 		return getNullImgClass();
 	}
 
-	// TODO: Multiple internal image sizes. [add reqSize]
-
 	// Convert the rp_image to ImgClass.
 	ImgClass ret_img = rpImageToImgClass(image);
 	if (isImgClassValid(ret_img)) {
@@ -174,13 +175,48 @@ ImgClass TCreateThumbnail<ImgClass>::getExternalImage(
 		if (cache_filename.empty())
 			continue;
 
+		// Check for a pre-scaled variant first. Steady-state icon
+		// display is then a small-file read instead of a full-size
+		// decode and rescale.
+		std::string load_filename = cache.findVariant(cache_filename, reqSize);
+		const bool from_variant = !load_filename.empty();
+		if (!from_variant) {
+			load_filename = cache_filename;
+		}
+
 		// Attempt to load the image.
-		shared_ptr<RpFile> file = std::make_shared<RpFile>(cache_filename, RpFile::FM_OPEN_READ);
+		shared_ptr<RpFile> file = std::make_shared<RpFile>(load_filename, RpFile::FM_OPEN_READ);
 		if (file->isOpen()) {
-			const rp_image_const_ptr dl_img = RpImageLoader::load(file);
+			// Pass the requested size as a decode hint so large
+			// JPEG scans can be decoded at a reduced IDCT scale.
+			rp_image_const_ptr dl_img = RpImageLoader::load(file, reqSize);
 			if (dl_img && dl_img->isValid()) {
 				// Image loaded successfully.
 				file->close();
+
+				if (!from_variant) {
+					// Save a pre-scaled variant for next time. (best-effort)
+					cache.saveVariant(cache_filename, reqSize, dl_img);
+				}
+
+				// If the image is larger than the requested size,
+				// downscale it here using rp_image's box filter.
+				// This is faster than the toolkit's scaler and
+				// produces the same output on all platforms.
+				if (reqSize > 0 && dl_img->format() == rp_image::Format::ARGB32 &&
+				    dl_img->width() > reqSize && dl_img->height() > reqSize)
+				{
+					ImgSize scale_sz = {dl_img->width(), dl_img->height()};
+					const ImgSize target_sz = {reqSize, reqSize};
+					rescale_aspect(scale_sz, target_sz);
+					if (scale_sz.width > 0 && scale_sz.height > 0) {
+						const rp_image_const_ptr scaled_img = dl_img->scaled_down(scale_sz.width, scale_sz.height);
+						if (scaled_img && scaled_img->isValid()) {
+							dl_img = scaled_img;
+						}
+					}
+				}
+
 				ImgClass ret_img = rpImageToImgClass(dl_img);
 				if (isImgClassValid(ret_img)) {
 					// Image converted successfully.
@@ -293,7 +329,7 @@ int TCreateThumbnail<ImgClass>::getThumbnail(const RomDataPtr &romData, int reqS
 		// Check for an icon first.
 		// TODO: Define "small sizes" somewhere. (DPI independence?)
 		if (imgbf & RomData::IMGBF_INT_ICON) {
-			pOutParams->retImg = getInternalImage(romData, RomData::IMG_INT_ICON, &pOutParams->fullSize, &pOutParams->sBIT);
+			pOutParams->retImg = getInternalImage(romData, RomData::IMG_INT_ICON, reqSize, &pOutParams->fullSize, &pOutParams->sBIT);
 			imgpf = romData->imgpf(RomData::IMG_INT_ICON);
 			imgbf &= ~RomData::IMGBF_INT_ICON;
 
@@ -325,7 +361,7 @@ int TCreateThumbnail<ImgClass>::getThumbnail(const RomDataPtr &romData, int reqS
 		// This image may be present.
 		if (imgType <= RomData::IMG_INT_MAX) {
 			// Internal image.
-			pOutParams->retImg = getInternalImage(romData, imgType, &pOutParams->fullSize, &pOutParams->sBIT);
+			pOutParams->retImg = getInternalImage(romData, imgType, reqSize, &pOutParams->fullSize, &pOutParams->sBIT);
 			imgpf = romData->imgpf(imgType);
 		} else {
 			// External image.
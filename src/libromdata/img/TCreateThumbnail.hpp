@@ -41,8 +41,9 @@ typedef enum {
  */
 typedef enum {
 	RPCT_FLAG_NO_XDG_THUMBNAIL_METADATA	= (1U << 0),	/*< Don't add XDG thumbnail metadata */
+	RPCT_FLAG_USE_BUFFER_POOL		= (1U << 1),	/*< Pool image buffers (batch thumbnailing) */
 
-	RPCT_FLAG_VALID_MASK			= 0x00000001,
+	RPCT_FLAG_VALID_MASK			= 0x00000003,
 } RpCreateThumbnailFlags;
 
 /**
@@ -123,13 +124,14 @@ public:
 	 * Get an internal image.
 	 * @param romData	[in] RomData object
 	 * @param imageType	[in] Image type
+	 * @param reqSize	[in] Requested image size. [0 for largest]
 	 * @param pOutSize	[out,opt] Pointer to ImgSize to store the image's size
 	 * @param sBIT		[out,opt] sBIT metadata
 	 * @return Internal image, or null ImgClass on error.
 	 */
 	ImgClass getInternalImage(const LibRpBase::RomDataPtr &romData,
 		LibRpBase::RomData::ImageType imageType,
-		ImgSize *pOutSize = nullptr,
+		int reqSize = 0, ImgSize *pOutSize = nullptr,
 		LibRpTexture::rp_image::sBIT_t *sBIT = nullptr);
 
 	/**
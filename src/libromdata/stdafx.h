@@ -70,6 +70,9 @@
 // Uninitialized vector class
 #include "uvector.h"
 
+// Per-thread aligned scratch arena
+#include "aligned_arena.h"
+
 // librpbase DiscReader
 #include "librpbase/disc/IDiscReader.hpp"
 #include "librpbase/disc/DiscReader.hpp"
@@ -91,5 +94,6 @@
 
 // librptext C++ headers
 #include "librptext/conversion.hpp"
+#include "librptext/int_format.hpp"
 #include "librptext/printf.hpp"
 #endif /* !__cplusplus */
@@ -0,0 +1,319 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata/tests)                 *
+ * BenchRomData.cpp: RomData parse-throughput benchmark.                   *
+ *                                                                         *
+ * Copyright (c) 2016-2024 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+// Not a test: runs RomDataFactory::create() + fields() + metaData()
+// over a user-supplied corpus directory and reports files/sec,
+// bytes/sec, and per-class latency statistics. Use --json to write
+// machine-readable output for trending in CI.
+
+#include "libromdata/RomDataFactory.hpp"
+#include "librpbase/RomData.hpp"
+using LibRpBase::RomDataPtr;
+namespace RomDataFactory = LibRomData::RomDataFactory;
+
+// C includes
+#include <stdlib.h>
+#include <sys/stat.h>
+
+// C includes (C++ namespace)
+#include <cstdio>
+#include <cstring>
+
+// C++ includes
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+using std::map;
+using std::string;
+using std::vector;
+
+#ifdef _WIN32
+#  include "libwin32common/RpWin32_sdk.h"
+#else /* !_WIN32 */
+#  include <dirent.h>
+#endif /* _WIN32 */
+
+// librpsecure
+#include "librpsecure/os-secure.h"
+
+// Number of log2 histogram buckets. (latency in microseconds)
+static const unsigned int HISTO_BUCKETS = 32;
+
+/**
+ * Per-class benchmark statistics.
+ */
+struct ClassStats {
+	vector<uint64_t> latencies_us;	// one sample per file
+	uint64_t bytes;			// total file bytes
+
+	ClassStats() : bytes(0) { }
+};
+
+/**
+ * Recursively collect regular files under a directory.
+ * @param path	[in] Directory to scan.
+ * @param files	[out] Collected filenames. (appended)
+ */
+static void scanDir(const string &path, vector<string> &files)
+{
+#ifdef _WIN32
+	WIN32_FIND_DATAA ffd;
+	const string spec = path + "\\*";
+	HANDLE hFind = FindFirstFileA(spec.c_str(), &ffd);
+	if (hFind == INVALID_HANDLE_VALUE) {
+		return;
+	}
+	do {
+		if (!strcmp(ffd.cFileName, ".") || !strcmp(ffd.cFileName, "..")) {
+			continue;
+		}
+		const string fullpath = path + '\\' + ffd.cFileName;
+		if (ffd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+			scanDir(fullpath, files);
+		} else {
+			files.push_back(fullpath);
+		}
+	} while (FindNextFileA(hFind, &ffd));
+	FindClose(hFind);
+#else /* !_WIN32 */
+	DIR *const dir = opendir(path.c_str());
+	if (!dir) {
+		return;
+	}
+	const struct dirent *dirent;
+	while ((dirent = readdir(dir)) != nullptr) {
+		if (!strcmp(dirent->d_name, ".") || !strcmp(dirent->d_name, "..")) {
+			continue;
+		}
+		const string fullpath = path + '/' + dirent->d_name;
+
+		// NOTE: Not all filesystems support d_type,
+		// so use stat() to determine the file type.
+		struct stat sb;
+		if (stat(fullpath.c_str(), &sb) != 0) {
+			continue;
+		}
+		if (S_ISDIR(sb.st_mode)) {
+			scanDir(fullpath, files);
+		} else if (S_ISREG(sb.st_mode)) {
+			files.push_back(fullpath);
+		}
+	}
+	closedir(dir);
+#endif /* _WIN32 */
+}
+
+/**
+ * Get a percentile from a sorted sample vector.
+ * @param sorted Sorted samples.
+ * @param pct Percentile. [0, 100]
+ * @return Sample value.
+ */
+static uint64_t percentile(const vector<uint64_t> &sorted, unsigned int pct)
+{
+	if (sorted.empty()) {
+		return 0;
+	}
+	const size_t idx = (static_cast<size_t>(pct) * (sorted.size() - 1)) / 100;
+	return sorted[idx];
+}
+
+/**
+ * Print usage information.
+ * @param argv0 Program name.
+ */
+static void usage(const char *argv0)
+{
+	fprintf(stderr, "Usage: %s [-r RUNS] [--json FILE] CORPUS_DIR\n"
+		"\n"
+		"Runs RomDataFactory::create() + fields() + metaData() over every\n"
+		"file under CORPUS_DIR and reports parse throughput.\n"
+		"\n"
+		"  -r RUNS      Number of passes over the corpus. (default: 1)\n"
+		"  --json FILE  Also write machine-readable results to FILE.\n",
+		argv0);
+}
+
+int RP_C_API main(int argc, char *argv[])
+{
+	// Set OS-specific security options.
+#ifdef _WIN32
+	rp_secure_param_t param;
+	param.bHighSec = FALSE;
+	rp_secure_enable(param);
+#endif /* _WIN32 */
+
+	const char *corpus_dir = nullptr;
+	const char *json_filename = nullptr;
+	unsigned int runs = 1;
+
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "-r") && (i + 1) < argc) {
+			runs = static_cast<unsigned int>(strtoul(argv[++i], nullptr, 10));
+			if (runs == 0) {
+				runs = 1;
+			}
+		} else if (!strcmp(argv[i], "--json") && (i + 1) < argc) {
+			json_filename = argv[++i];
+		} else if (!strcmp(argv[i], "-h") || !strcmp(argv[i], "--help")) {
+			usage(argv[0]);
+			return EXIT_SUCCESS;
+		} else if (!corpus_dir) {
+			corpus_dir = argv[i];
+		} else {
+			usage(argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+	if (!corpus_dir) {
+		usage(argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	// Collect the corpus.
+	vector<string> files;
+	scanDir(corpus_dir, files);
+	if (files.empty()) {
+		fprintf(stderr, "*** ERROR: no files found under '%s'\n", corpus_dir);
+		return EXIT_FAILURE;
+	}
+	// Sort for a deterministic processing order.
+	std::sort(files.begin(), files.end());
+
+	// Run the benchmark.
+	map<string, ClassStats> classStats;
+	uint64_t total_bytes = 0, supported_bytes = 0;
+	uint64_t total_files = 0, supported_files = 0;
+
+	const auto bench_start = std::chrono::steady_clock::now();
+	for (unsigned int run = 0; run < runs; run++) {
+		for (const string &filename : files) {
+			struct stat sb;
+			uint64_t fileSize = 0;
+			if (stat(filename.c_str(), &sb) == 0) {
+				fileSize = static_cast<uint64_t>(sb.st_size);
+			}
+			total_files++;
+			total_bytes += fileSize;
+
+			const auto t0 = std::chrono::steady_clock::now();
+			const RomDataPtr romData = RomDataFactory::create(filename.c_str());
+			if (!romData) {
+				// Not a supported file.
+				continue;
+			}
+			romData->fields();
+			romData->metaData();
+			const auto t1 = std::chrono::steady_clock::now();
+
+			const uint64_t us = static_cast<uint64_t>(
+				std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count());
+			ClassStats &stats = classStats[romData->className()];
+			stats.latencies_us.push_back(us);
+			stats.bytes += fileSize;
+			supported_files++;
+			supported_bytes += fileSize;
+		}
+	}
+	const auto bench_end = std::chrono::steady_clock::now();
+	const uint64_t elapsed_us = static_cast<uint64_t>(
+		std::chrono::duration_cast<std::chrono::microseconds>(bench_end - bench_start).count());
+	const double elapsed_sec = (elapsed_us > 0) ? (static_cast<double>(elapsed_us) / 1e6) : 1e-6;
+
+	// Text report.
+	printf("Corpus: %s (%zu files, %u run(s))\n", corpus_dir, files.size(), runs);
+	printf("Total:     %llu files, %llu bytes in %0.3f s\n",
+		static_cast<unsigned long long>(total_files),
+		static_cast<unsigned long long>(total_bytes), elapsed_sec);
+	printf("Supported: %llu files, %llu bytes\n",
+		static_cast<unsigned long long>(supported_files),
+		static_cast<unsigned long long>(supported_bytes));
+	printf("Throughput: %0.1f files/sec, %0.1f MiB/sec\n\n",
+		static_cast<double>(total_files) / elapsed_sec,
+		static_cast<double>(total_bytes) / elapsed_sec / (1024.0*1024.0));
+
+	printf("%-24s %8s %10s %8s %8s %8s %8s\n",
+		"Class", "Files", "Bytes", "p50(us)", "p90(us)", "p99(us)", "max(us)");
+	for (auto &pair : classStats) {
+		ClassStats &stats = pair.second;
+		std::sort(stats.latencies_us.begin(), stats.latencies_us.end());
+		printf("%-24s %8zu %10llu %8llu %8llu %8llu %8llu\n",
+			pair.first.c_str(), stats.latencies_us.size(),
+			static_cast<unsigned long long>(stats.bytes),
+			static_cast<unsigned long long>(percentile(stats.latencies_us, 50)),
+			static_cast<unsigned long long>(percentile(stats.latencies_us, 90)),
+			static_cast<unsigned long long>(percentile(stats.latencies_us, 99)),
+			static_cast<unsigned long long>(stats.latencies_us.back()));
+	}
+
+	// JSON report.
+	if (json_filename) {
+		FILE *const f = fopen(json_filename, "w");
+		if (!f) {
+			fprintf(stderr, "*** ERROR: could not open '%s' for writing\n", json_filename);
+			return EXIT_FAILURE;
+		}
+
+		fprintf(f, "{\"runs\":%u,\"total\":{\"files\":%llu,\"bytes\":%llu,"
+			"\"supported_files\":%llu,\"supported_bytes\":%llu,"
+			"\"elapsed_us\":%llu,\"files_per_sec\":%0.1f,\"bytes_per_sec\":%0.1f},"
+			"\"classes\":{", runs,
+			static_cast<unsigned long long>(total_files),
+			static_cast<unsigned long long>(total_bytes),
+			static_cast<unsigned long long>(supported_files),
+			static_cast<unsigned long long>(supported_bytes),
+			static_cast<unsigned long long>(elapsed_us),
+			static_cast<double>(total_files) / elapsed_sec,
+			static_cast<double>(total_bytes) / elapsed_sec);
+
+		bool first_class = true;
+		for (const auto &pair : classStats) {
+			const ClassStats &stats = pair.second;	// already sorted
+
+			// log2 latency histogram: bucket i counts samples in [2^i, 2^(i+1)) us.
+			unsigned int histo[HISTO_BUCKETS] = {0};
+			uint64_t sum = 0;
+			for (const uint64_t us : stats.latencies_us) {
+				unsigned int bucket = 0;
+				for (uint64_t v = us; v > 1 && bucket < HISTO_BUCKETS-1; v >>= 1) {
+					bucket++;
+				}
+				histo[bucket]++;
+				sum += us;
+			}
+			unsigned int last_bucket = HISTO_BUCKETS;
+			while (last_bucket > 1 && histo[last_bucket-1] == 0) {
+				last_bucket--;
+			}
+
+			fprintf(f, "%s\"%s\":{\"files\":%zu,\"bytes\":%llu,"
+				"\"us\":{\"mean\":%llu,\"min\":%llu,\"p50\":%llu,\"p90\":%llu,\"p99\":%llu,\"max\":%llu},"
+				"\"histogram_log2_us\":[",
+				(first_class ? "" : ","), pair.first.c_str(),
+				stats.latencies_us.size(),
+				static_cast<unsigned long long>(stats.bytes),
+				static_cast<unsigned long long>(sum / stats.latencies_us.size()),
+				static_cast<unsigned long long>(stats.latencies_us.front()),
+				static_cast<unsigned long long>(percentile(stats.latencies_us, 50)),
+				static_cast<unsigned long long>(percentile(stats.latencies_us, 90)),
+				static_cast<unsigned long long>(percentile(stats.latencies_us, 99)),
+				static_cast<unsigned long long>(stats.latencies_us.back()));
+			for (unsigned int i = 0; i < last_bucket; i++) {
+				fprintf(f, "%s%u", (i == 0 ? "" : ","), histo[i]);
+			}
+			fputs("]}", f);
+			first_class = false;
+		}
+		fputs("}}\n", f);
+		fclose(f);
+	}
+
+	return EXIT_SUCCESS;
+}
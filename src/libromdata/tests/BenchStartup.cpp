@@ -0,0 +1,117 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata/tests)                 *
+ * BenchStartup.cpp: Startup-cost micro-benchmark.                         *
+ *                                                                         *
+ * Copyright (c) 2016-2024 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+// Measures time-to-first-create: the cost of all lazy factory table
+// construction paid by the first thumbnail after process start.
+// Needs no corpus, so it's registered as a regular test; the numbers
+// are printed so CI logs track them over time.
+
+#include "libromdata/RomDataFactory.hpp"
+#include "librpbase/RomData.hpp"
+#include "librpfile/MemFile.hpp"
+using LibRpBase::RomDataPtr;
+using LibRpFile::MemFile;
+namespace RomDataFactory = LibRomData::RomDataFactory;
+
+// C includes
+#include <stdlib.h>
+
+// C includes (C++ namespace)
+#include <cstdio>
+#include <cstring>
+
+// C++ includes
+#include <chrono>
+#include <memory>
+
+// librpsecure
+#include "librpsecure/os-secure.h"
+
+/**
+ * Measure one phase and print its latency.
+ * @param name Phase name.
+ * @param fn Phase function.
+ * @return Latency, in microseconds.
+ */
+template<typename Fn>
+static uint64_t measure(const char *name, Fn fn)
+{
+	const auto t0 = std::chrono::steady_clock::now();
+	fn();
+	const auto t1 = std::chrono::steady_clock::now();
+	const uint64_t us = static_cast<uint64_t>(
+		std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count());
+	printf("%-40s %8llu us\n", name, static_cast<unsigned long long>(us));
+	return us;
+}
+
+int RP_C_API main(int argc, char *argv[])
+{
+	RP_UNUSED(argc);
+	RP_UNUSED(argv);
+
+	// Set OS-specific security options.
+#ifdef _WIN32
+	rp_secure_param_t param;
+	param.bHighSec = FALSE;
+	rp_secure_enable(param);
+#endif /* _WIN32 */
+
+	// Probe buffer: large enough for every magic/header check,
+	// but matches no RomData subclass, so create() pays the full
+	// rejection path (all lazy table construction included).
+	static const size_t PROBE_SIZE = 1U*1024*1024;
+	void *const probe_buf = calloc(1, PROBE_SIZE);
+	if (!probe_buf) {
+		fputs("*** ERROR: calloc() failed\n", stderr);
+		return EXIT_FAILURE;
+	}
+
+	printf("%-40s %11s\n", "Phase", "Latency");
+
+	// Time-to-first-create: includes all lazy factory init.
+	uint64_t first_create_us;
+	{
+		const auto file = std::make_shared<MemFile>(probe_buf, PROBE_SIZE);
+		first_create_us = measure("RomDataFactory::create() (cold)", [&file]() {
+			const RomDataPtr romData = RomDataFactory::create(file);
+			// NOTE: Expected to be nullptr. (unsupported buffer)
+		});
+	}
+
+	// Warm create: tables are built; this is the steady-state cost.
+	{
+		const auto file = std::make_shared<MemFile>(probe_buf, PROBE_SIZE);
+		measure("RomDataFactory::create() (warm)", [&file]() {
+			const RomDataPtr romData = RomDataFactory::create(file);
+		});
+	}
+
+	// First-call cost of the registration/aggregation tables.
+	// These also pull in FileFormatFactory's tables.
+#ifdef ROMDATAFACTORY_USE_FILE_EXTENSIONS
+	measure("RomDataFactory::supportedFileExtensions()", []() {
+		RomDataFactory::supportedFileExtensions();
+	});
+#endif /* ROMDATAFACTORY_USE_FILE_EXTENSIONS */
+#ifdef ROMDATAFACTORY_USE_MIME_TYPES
+	measure("RomDataFactory::supportedMimeTypes()", []() {
+		RomDataFactory::supportedMimeTypes();
+	});
+#endif /* ROMDATAFACTORY_USE_MIME_TYPES */
+
+	free(probe_buf);
+
+	// Sanity limit: first create should never take a full second.
+	// (This is a smoke test, not a strict performance gate.)
+	if (first_create_us > 1000000) {
+		fputs("*** ERROR: time-to-first-create exceeded 1 second\n", stderr);
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
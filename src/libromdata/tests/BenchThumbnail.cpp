@@ -0,0 +1,551 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata/tests)                 *
+ * BenchThumbnail.cpp: End-to-end thumbnail pipeline benchmark.            *
+ *                                                                         *
+ * Copyright (c) 2016-2024 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+// Not a test: drives the shared TCreateThumbnail template headlessly
+// over a user-supplied corpus directory and reports per-stage times:
+// create (open + factory + parse), thumbnail (image load + scale),
+// and encode (PNG). Use --json to write machine-readable output, and
+// --baseline to compare against a previous --json run so CI can flag
+// thumbnail-latency regressions.
+
+#include "common.h"
+#include "dll-macros.h"	// for RP_C_API
+
+// TCreateThumbnail is a templated class,
+// so we have to #include the .cpp file here.
+#include "libromdata/img/TCreateThumbnail.cpp"
+using LibRomData::TCreateThumbnail;
+namespace RomDataFactory = LibRomData::RomDataFactory;
+
+// librpbase, librpfile, librptexture
+#include "librpbase/img/RpPngWriter.hpp"
+#include "librpfile/VectorFile.hpp"
+using LibRpBase::RomDataPtr;
+using LibRpBase::RpPngWriter;
+using LibRpFile::VectorFile;
+using LibRpTexture::rp_image;
+using LibRpTexture::rp_image_ptr;
+using LibRpTexture::rp_image_const_ptr;
+
+// C includes
+#include <stdlib.h>
+#include <sys/stat.h>
+
+// C includes (C++ namespace)
+#include <cstdio>
+#include <cstring>
+
+// C++ includes
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+using std::string;
+using std::vector;
+
+#ifdef _WIN32
+#  include "libwin32common/RpWin32_sdk.h"
+#else /* !_WIN32 */
+#  include <dirent.h>
+#endif /* _WIN32 */
+
+// librpsecure
+#include "librpsecure/os-secure.h"
+
+/**
+ * Headless TCreateThumbnail implementation.
+ * ImgClass is rp_image itself, so no toolkit is needed.
+ */
+class BenchThumbnailer final : public TCreateThumbnail<rp_image_const_ptr>
+{
+public:
+	BenchThumbnailer() = default;
+private:
+	typedef TCreateThumbnail<rp_image_const_ptr> super;
+	RP_DISABLE_COPY(BenchThumbnailer)
+
+public:
+	/** TCreateThumbnail functions **/
+
+	inline rp_image_const_ptr rpImageToImgClass(const rp_image_const_ptr &img) const final
+	{
+		return img;
+	}
+
+	inline bool isImgClassValid(const rp_image_const_ptr &imgClass) const final
+	{
+		return (imgClass && imgClass->isValid());
+	}
+
+	inline rp_image_const_ptr getNullImgClass(void) const final
+	{
+		return nullptr;
+	}
+
+	inline void freeImgClass(rp_image_const_ptr &imgClass) const final
+	{
+		imgClass.reset();
+	}
+
+	rp_image_const_ptr rescaleImgClass(const rp_image_const_ptr &imgClass, ImgSize sz, ScalingMethod method) const final;
+
+	inline int getImgClassSize(const rp_image_const_ptr &imgClass, ImgSize *pOutSize) const final
+	{
+		pOutSize->width = imgClass->width();
+		pOutSize->height = imgClass->height();
+		return 0;
+	}
+
+	inline std::string proxyForUrl(const char *url) const final
+	{
+		// No proxy in the benchmark.
+		RP_UNUSED(url);
+		return {};
+	}
+};
+
+/**
+ * Rescale an ImgClass using the specified scaling method.
+ * @param imgClass ImgClass object.
+ * @param sz New size.
+ * @param method Scaling method.
+ * @return Rescaled ImgClass.
+ */
+rp_image_const_ptr BenchThumbnailer::rescaleImgClass(const rp_image_const_ptr &imgClass, ImgSize sz, ScalingMethod method) const
+{
+	assert(sz.width > 0);
+	assert(sz.height > 0);
+	if (sz.width <= 0 || sz.height <= 0) {
+		return nullptr;
+	}
+
+	// Downscales use rp_image's box filter, same as the frontends.
+	if (method == ScalingMethod::Bilinear &&
+	    imgClass->format() == rp_image::Format::ARGB32 &&
+	    sz.width <= imgClass->width() && sz.height <= imgClass->height())
+	{
+		return imgClass->scaled_down(sz.width, sz.height);
+	}
+
+	// Nearest-neighbor resampling, since there's no toolkit scaler here.
+	const int src_w = imgClass->width();
+	const int src_h = imgClass->height();
+	rp_image_ptr img = std::make_shared<rp_image>(sz.width, sz.height, imgClass->format());
+	if (!img->isValid()) {
+		return nullptr;
+	}
+
+	switch (imgClass->format()) {
+		case rp_image::Format::CI8: {
+			// Copy the palette.
+			const unsigned int entries = std::min(img->palette_len(), imgClass->palette_len());
+			memcpy(img->palette(), imgClass->palette(), entries * sizeof(uint32_t));
+
+			for (int y = 0; y < sz.height; y++) {
+				const uint8_t *const src = static_cast<const uint8_t*>(
+					imgClass->scanLine((y * src_h) / sz.height));
+				uint8_t *const dest = static_cast<uint8_t*>(img->scanLine(y));
+				for (int x = 0; x < sz.width; x++) {
+					dest[x] = src[(x * src_w) / sz.width];
+				}
+			}
+			break;
+		}
+
+		case rp_image::Format::ARGB32: {
+			for (int y = 0; y < sz.height; y++) {
+				const uint32_t *const src = static_cast<const uint32_t*>(
+					imgClass->scanLine((y * src_h) / sz.height));
+				uint32_t *const dest = static_cast<uint32_t*>(img->scanLine(y));
+				for (int x = 0; x < sz.width; x++) {
+					dest[x] = src[(x * src_w) / sz.width];
+				}
+			}
+			break;
+		}
+
+		default:
+			assert(!"Unsupported rp_image::Format.");
+			return nullptr;
+	}
+
+	// Copy sBIT if it's set.
+	rp_image::sBIT_t sBIT;
+	if (imgClass->get_sBIT(&sBIT) == 0) {
+		img->set_sBIT(&sBIT);
+	}
+	return img;
+}
+
+/** Benchmark driver **/
+
+/**
+ * Per-stage latency samples.
+ */
+struct StageStats {
+	const char *name;
+	vector<uint64_t> us;	// one sample per thumbnailed file
+};
+
+/**
+ * Recursively collect regular files under a directory.
+ * @param path	[in] Directory to scan.
+ * @param files	[out] Collected filenames. (appended)
+ */
+static void scanDir(const string &path, vector<string> &files)
+{
+#ifdef _WIN32
+	WIN32_FIND_DATAA ffd;
+	const string spec = path + "\\*";
+	HANDLE hFind = FindFirstFileA(spec.c_str(), &ffd);
+	if (hFind == INVALID_HANDLE_VALUE) {
+		return;
+	}
+	do {
+		if (!strcmp(ffd.cFileName, ".") || !strcmp(ffd.cFileName, "..")) {
+			continue;
+		}
+		const string fullpath = path + '\\' + ffd.cFileName;
+		if (ffd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+			scanDir(fullpath, files);
+		} else {
+			files.push_back(fullpath);
+		}
+	} while (FindNextFileA(hFind, &ffd));
+	FindClose(hFind);
+#else /* !_WIN32 */
+	DIR *const dir = opendir(path.c_str());
+	if (!dir) {
+		return;
+	}
+	const struct dirent *dirent;
+	while ((dirent = readdir(dir)) != nullptr) {
+		if (!strcmp(dirent->d_name, ".") || !strcmp(dirent->d_name, "..")) {
+			continue;
+		}
+		const string fullpath = path + '/' + dirent->d_name;
+
+		// NOTE: Not all filesystems support d_type,
+		// so use stat() to determine the file type.
+		struct stat sb;
+		if (stat(fullpath.c_str(), &sb) != 0) {
+			continue;
+		}
+		if (S_ISDIR(sb.st_mode)) {
+			scanDir(fullpath, files);
+		} else if (S_ISREG(sb.st_mode)) {
+			files.push_back(fullpath);
+		}
+	}
+	closedir(dir);
+#endif /* _WIN32 */
+}
+
+/**
+ * Get a percentile from a sorted sample vector.
+ * @param sorted Sorted samples.
+ * @param pct Percentile. [0, 100]
+ * @return Sample value.
+ */
+static uint64_t percentile(const vector<uint64_t> &sorted, unsigned int pct)
+{
+	if (sorted.empty()) {
+		return 0;
+	}
+	const size_t idx = (static_cast<size_t>(pct) * (sorted.size() - 1)) / 100;
+	return sorted[idx];
+}
+
+/**
+ * Extract a stage's p50 value from a baseline JSON file written by --json.
+ * NOTE: Minimal extraction, not a general JSON parser; it only has to
+ * read files this tool wrote itself.
+ * @param json	[in] Baseline JSON contents.
+ * @param stage	[in] Stage name.
+ * @return p50 value, or 0 if not found.
+ */
+static uint64_t baseline_p50(const string &json, const char *stage)
+{
+	string key = "\"";
+	key += stage;
+	key += "\":{";
+	const size_t stage_pos = json.find(key);
+	if (stage_pos == string::npos) {
+		return 0;
+	}
+	const size_t p50_pos = json.find("\"p50\":", stage_pos);
+	if (p50_pos == string::npos) {
+		return 0;
+	}
+	return strtoull(json.c_str() + p50_pos + 6, nullptr, 10);
+}
+
+/**
+ * Print usage information.
+ * @param argv0 Program name.
+ */
+static void usage(const char *argv0)
+{
+	fprintf(stderr, "Usage: %s [-s SIZE] [-r RUNS] [--json FILE] [--baseline FILE] [--tolerance PCT] CORPUS_DIR\n"
+		"\n"
+		"Drives the shared thumbnail pipeline (factory -> parse -> image load ->\n"
+		"scale -> PNG encode) over every file under CORPUS_DIR, headlessly, and\n"
+		"reports per-stage latencies.\n"
+		"\n"
+		"  -s SIZE          Requested thumbnail size. (default: 256)\n"
+		"  -r RUNS          Number of passes over the corpus. (default: 1)\n"
+		"  --json FILE      Also write machine-readable results to FILE.\n"
+		"  --baseline FILE  Compare stage p50s against a previous --json run.\n"
+		"  --tolerance PCT  Regression tolerance for --baseline. (default: 25)\n"
+		"\n"
+		"NOTE: External image sources follow the user's download configuration.\n"
+		"For reproducible numbers, use a corpus with internal images only.\n",
+		argv0);
+}
+
+int RP_C_API main(int argc, char *argv[])
+{
+	// Set OS-specific security options.
+#ifdef _WIN32
+	rp_secure_param_t param;
+	param.bHighSec = FALSE;
+	rp_secure_enable(param);
+#endif /* _WIN32 */
+
+	const char *corpus_dir = nullptr;
+	const char *json_filename = nullptr;
+	const char *baseline_filename = nullptr;
+	unsigned int runs = 1;
+	unsigned int tolerance = 25;
+	int reqSize = 256;
+
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "-s") && (i + 1) < argc) {
+			reqSize = static_cast<int>(strtol(argv[++i], nullptr, 10));
+			if (reqSize <= 0) {
+				reqSize = 256;
+			}
+		} else if (!strcmp(argv[i], "-r") && (i + 1) < argc) {
+			runs = static_cast<unsigned int>(strtoul(argv[++i], nullptr, 10));
+			if (runs == 0) {
+				runs = 1;
+			}
+		} else if (!strcmp(argv[i], "--json") && (i + 1) < argc) {
+			json_filename = argv[++i];
+		} else if (!strcmp(argv[i], "--baseline") && (i + 1) < argc) {
+			baseline_filename = argv[++i];
+		} else if (!strcmp(argv[i], "--tolerance") && (i + 1) < argc) {
+			tolerance = static_cast<unsigned int>(strtoul(argv[++i], nullptr, 10));
+		} else if (!strcmp(argv[i], "-h") || !strcmp(argv[i], "--help")) {
+			usage(argv[0]);
+			return EXIT_SUCCESS;
+		} else if (!corpus_dir) {
+			corpus_dir = argv[i];
+		} else {
+			usage(argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+	if (!corpus_dir) {
+		usage(argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	// Collect the corpus.
+	vector<string> files;
+	scanDir(corpus_dir, files);
+	if (files.empty()) {
+		fprintf(stderr, "*** ERROR: no files found under '%s'\n", corpus_dir);
+		return EXIT_FAILURE;
+	}
+	// Sort for a deterministic processing order.
+	std::sort(files.begin(), files.end());
+
+	// Pool image buffers, as the batch thumbnailing paths do.
+	rp_image::setBufferPoolEnabled(true);
+
+	// Stage samples. (indexes match the stage loop below)
+	StageStats stages[4] = {
+		{"create", {}},		// open + factory + parse
+		{"thumbnail", {}},	// image load + scale
+		{"encode", {}},		// PNG encode
+		{"total", {}},
+	};
+
+	BenchThumbnailer thumbnailer;
+	uint64_t total_files = 0, thumbnailed_files = 0;
+	uint64_t png_bytes = 0;
+
+	const auto bench_start = std::chrono::steady_clock::now();
+	for (unsigned int run = 0; run < runs; run++) {
+		for (const string &filename : files) {
+			total_files++;
+
+			// Stage 1: open + factory + parse.
+			const auto t0 = std::chrono::steady_clock::now();
+			const RomDataPtr romData = RomDataFactory::create(
+				filename.c_str(), RomDataFactory::RDA_HAS_THUMBNAIL);
+			const auto t1 = std::chrono::steady_clock::now();
+			if (!romData) {
+				// Not a supported file.
+				continue;
+			}
+
+			// Stage 2: image load + scale.
+			BenchThumbnailer::GetThumbnailOutParams_t outParams;
+			const int ret = thumbnailer.getThumbnail(romData, reqSize, &outParams);
+			const auto t2 = std::chrono::steady_clock::now();
+			if (ret != 0) {
+				// No image.
+				continue;
+			}
+
+			// Stage 3: PNG encode. (in-memory; no output file I/O)
+			const auto pngFile = std::make_shared<VectorFile>();
+			{
+				RpPngWriter pngWriter(pngFile, outParams.retImg);
+				if (!pngWriter.isOpen()) {
+					continue;
+				}
+				// Thumbnails don't need maximum compression.
+				pngWriter.setCompressionProfile(RpPngWriter::CompressionProfile::Speed);
+				// NOTE: sBIT is taken from the rp_image itself.
+				if (pngWriter.write_IHDR() != 0 ||
+				    pngWriter.write_IDAT() != 0)
+				{
+					continue;
+				}
+			}
+			const auto t3 = std::chrono::steady_clock::now();
+			png_bytes += pngFile->size();
+
+			// Record the stage latencies.
+			const uint64_t us[4] = {
+				static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count()),
+				static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count()),
+				static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(t3 - t2).count()),
+				static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(t3 - t0).count()),
+			};
+			for (unsigned int s = 0; s < 4; s++) {
+				stages[s].us.push_back(us[s]);
+			}
+			thumbnailed_files++;
+		}
+	}
+	const auto bench_end = std::chrono::steady_clock::now();
+	const uint64_t elapsed_us = static_cast<uint64_t>(
+		std::chrono::duration_cast<std::chrono::microseconds>(bench_end - bench_start).count());
+	const double elapsed_sec = (elapsed_us > 0) ? (static_cast<double>(elapsed_us) / 1e6) : 1e-6;
+
+	if (thumbnailed_files == 0) {
+		fprintf(stderr, "*** ERROR: no thumbnails were created from '%s'\n", corpus_dir);
+		return EXIT_FAILURE;
+	}
+
+	// Sort the samples for percentiles.
+	for (StageStats &stage : stages) {
+		std::sort(stage.us.begin(), stage.us.end());
+	}
+
+	// Text report.
+	printf("Corpus: %s (%zu files, %u run(s), reqSize %d)\n",
+		corpus_dir, files.size(), runs, reqSize);
+	printf("Thumbnailed: %llu of %llu files in %0.3f s (%0.1f thumbnails/sec, %llu PNG bytes)\n\n",
+		static_cast<unsigned long long>(thumbnailed_files),
+		static_cast<unsigned long long>(total_files), elapsed_sec,
+		static_cast<double>(thumbnailed_files) / elapsed_sec,
+		static_cast<unsigned long long>(png_bytes));
+
+	printf("%-12s %8s %8s %8s %8s\n",
+		"Stage", "p50(us)", "p90(us)", "p99(us)", "max(us)");
+	for (const StageStats &stage : stages) {
+		printf("%-12s %8llu %8llu %8llu %8llu\n",
+			stage.name,
+			static_cast<unsigned long long>(percentile(stage.us, 50)),
+			static_cast<unsigned long long>(percentile(stage.us, 90)),
+			static_cast<unsigned long long>(percentile(stage.us, 99)),
+			static_cast<unsigned long long>(stage.us.back()));
+	}
+
+	// JSON report.
+	if (json_filename) {
+		FILE *const f = fopen(json_filename, "w");
+		if (!f) {
+			fprintf(stderr, "*** ERROR: could not open '%s' for writing\n", json_filename);
+			return EXIT_FAILURE;
+		}
+
+		fprintf(f, "{\"reqSize\":%d,\"runs\":%u,\"files\":%llu,\"thumbnailed\":%llu,"
+			"\"elapsed_us\":%llu,\"png_bytes\":%llu,\"stages\":{",
+			reqSize, runs,
+			static_cast<unsigned long long>(total_files),
+			static_cast<unsigned long long>(thumbnailed_files),
+			static_cast<unsigned long long>(elapsed_us),
+			static_cast<unsigned long long>(png_bytes));
+		for (unsigned int s = 0; s < 4; s++) {
+			const StageStats &stage = stages[s];
+			uint64_t sum = 0;
+			for (const uint64_t v : stage.us) {
+				sum += v;
+			}
+			fprintf(f, "%s\"%s\":{\"mean\":%llu,\"min\":%llu,\"p50\":%llu,"
+				"\"p90\":%llu,\"p99\":%llu,\"max\":%llu}",
+				(s == 0 ? "" : ","), stage.name,
+				static_cast<unsigned long long>(sum / stage.us.size()),
+				static_cast<unsigned long long>(stage.us.front()),
+				static_cast<unsigned long long>(percentile(stage.us, 50)),
+				static_cast<unsigned long long>(percentile(stage.us, 90)),
+				static_cast<unsigned long long>(percentile(stage.us, 99)),
+				static_cast<unsigned long long>(stage.us.back()));
+		}
+		fputs("}}\n", f);
+		fclose(f);
+	}
+
+	// Baseline comparison.
+	if (baseline_filename) {
+		FILE *const f = fopen(baseline_filename, "r");
+		if (!f) {
+			fprintf(stderr, "*** ERROR: could not open baseline '%s'\n", baseline_filename);
+			return EXIT_FAILURE;
+		}
+		string json;
+		char buf[4096];
+		size_t sz;
+		while ((sz = fread(buf, 1, sizeof(buf), f)) > 0) {
+			json.append(buf, sz);
+		}
+		fclose(f);
+
+		bool regressed = false;
+		printf("\nBaseline: %s (tolerance %u%%)\n", baseline_filename, tolerance);
+		for (const StageStats &stage : stages) {
+			const uint64_t base_p50 = baseline_p50(json, stage.name);
+			if (base_p50 == 0) {
+				printf("%-12s (no baseline data)\n", stage.name);
+				continue;
+			}
+			const uint64_t cur_p50 = percentile(stage.us, 50);
+			const uint64_t limit = base_p50 + ((base_p50 * tolerance) / 100);
+			const bool bad = (cur_p50 > limit);
+			printf("%-12s p50 %8llu -> %8llu us (%+0.1f%%)%s\n",
+				stage.name,
+				static_cast<unsigned long long>(base_p50),
+				static_cast<unsigned long long>(cur_p50),
+				(static_cast<double>(cur_p50) - static_cast<double>(base_p50)) * 100.0 / static_cast<double>(base_p50),
+				(bad ? "  *** REGRESSION ***" : ""));
+			regressed |= bad;
+		}
+		if (regressed) {
+			fputs("*** ERROR: thumbnail latency regression detected\n", stderr);
+			return EXIT_FAILURE;
+		}
+	}
+
+	return EXIT_SUCCESS;
+}
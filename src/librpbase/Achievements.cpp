@@ -109,17 +109,69 @@ public:
 	// Achievements filename and magic number.
 #if defined(NDEBUG) || defined(FORCE_OBFUSCATE)
 	// Release version is obfuscated.
-	#define ACH_BIN_MAGIC    "RPACH10R"
+	#define ACH_BIN_MAGIC    "RPACH20R"
+	#define ACH_BIN_MAGIC_V1 "RPACH10R"
 	#define ACH_BIN_FILENAME "ach.bin"
 #else /* !NDEBUG && !FORCE_OBFUSCATE */
 	// Debug version is not obfuscated.
-	#define ACH_BIN_MAGIC    "RPACH10D"
+	#define ACH_BIN_MAGIC    "RPACH20D"
+	#define ACH_BIN_MAGIC_V1 "RPACH10D"
 	#define ACH_BIN_FILENAME "achd.bin"
 #endif /* NDEBUG || FORCE_OBFUSCATE*/
 
-	// Serialized achievement header.
+	// Serialized achievement header. (version 2)
 	// All fields are in little-endian.
+	// NOTE: The header is always plaintext; only records are obfuscated.
 	struct AchBinHeader {
+		char magic[8];		// [0x000] "RPACH20R" or "RPACH20D"
+		uint32_t count;		// [0x008] Number of achievement records.
+		uint16_t iv;		// [0x00C] Obfuscation IV. (0 if not obfuscated)
+		uint16_t iv_inv;	// [0x00E] 0xFFFF - iv.
+	};
+
+	// Fixed-layout achievement record. (version 2; little-endian)
+	// Records have a fixed size and offset, and are obfuscated
+	// individually, so loading is a cast per record and a single
+	// record can be rewritten in place without touching the rest
+	// of the file.
+	struct AchBinRecord {
+		uint16_t id;		// [0x000] Achievement ID
+		uint8_t type;		// [0x002] Achievement type
+		uint8_t reserved;	// [0x003]
+		uint32_t crc32;		// [0x004] CRC32 of the timestamp and data fields. (plaintext)
+		int64_t timestamp;	// [0x008] Timestamp the achievement was last updated
+		uint64_t data;		// [0x010] Count (AT_COUNT) or bitfield (AT_BITFIELD)
+	};
+	static_assert(sizeof(AchBinRecord) == 24, "AchBinRecord is the wrong size");
+
+	/**
+	 * Get the obfuscation IV for a specific record.
+	 * @param iv File IV from the header. (0 if not obfuscated)
+	 * @param idx Record index.
+	 * @return Record IV. (0 if not obfuscated)
+	 */
+	static inline uint16_t recordIV(uint16_t iv, uint32_t idx)
+	{
+		return (iv != 0) ? (iv ^ static_cast<uint16_t>((idx + 1) * 0x9E37)) : 0;
+	}
+
+	/**
+	 * Build a serialized record for an achievement.
+	 * The record is obfuscated if iv is non-zero.
+	 * @param rec	[out] Destination record
+	 * @param id	[in] Achievement ID
+	 * @param data	[in] Achievement data
+	 * @param iv	[in] File IV (0 if not obfuscated)
+	 * @param idx	[in] Record index within the file
+	 * @return 0 on success; negative POSIX error code on error.
+	 */
+	static int buildRecord(AchBinRecord &rec, Achievements::ID id, const AchData_t &data, uint16_t iv, uint32_t idx);
+
+	// Serialized achievement header. (version 1)
+	// All fields are in little-endian.
+	// Retained for loading files written by older versions;
+	// the file is rewritten in version 2 format on next save.
+	struct AchBinHeaderV1 {
 		char magic[8];		// [0x000] "RPACH10R" or "RPACH10D"
 		uint32_t length;	// [0x008] Length of remainder of file, in bytes. [excludes CRC32; includes count]
 		uint32_t crc32;		// [0x00C] CRC32 of remainder of file. [includes count]
@@ -191,11 +243,30 @@ public:
 	 */
 	int save(void) const;
 
+	/**
+	 * Update a single achievement record in place.
+	 *
+	 * If the file is not in the current fixed-layout format, or the
+	 * record isn't present yet and can't be appended, this falls back
+	 * to a full save().
+	 *
+	 * @param id Achievement ID.
+	 * @return 0 on success; negative POSIX error code on error.
+	 */
+	int saveOne(Achievements::ID id) const;
+
 	/**
 	 * Load the achievements data.
 	 * @return 0 on success; negative POSIX error code on error.
 	 */
 	int load(void);
+
+	/**
+	 * Load achievements data in the version 1 (varlenint) format.
+	 * @param buf File data, as read from disk.
+	 * @return 0 on success; negative POSIX error code on error.
+	 */
+	int loadV1(rp::uvector<uint8_t> &buf);
 };
 
 /** AchievementsPrivate **/
@@ -340,110 +411,43 @@ void AchievementsPrivate::doObfuscate(uint16_t iv, uint8_t *buf, size_t size)
  */
 int AchievementsPrivate::save(void) const
 {
-	Hash crc32Hash(Hash::Algorithm::CRC32);
-	if (!crc32Hash.isUsable()) {
-		// zlib could not be initialized.
-		// Can't calculate the CRC32.
-		return -ENOTSUP;
+	// Choose an IV for record obfuscation.
+	uint16_t iv = 0;
+#if defined(NDEBUG) || defined(FORCE_OBFUSCATE)
+	iv = (getpid() ^ time(nullptr)) & 0xFFFF;
+	if (iv == 0) {
+		// IV of 0 means "not obfuscated".
+		iv = 0x5A5A;
 	}
+#endif /* NDEBUG || FORCE_OBFUSCATE */
 
 	// Create the achievements file in memory.
 	rp::uvector<uint8_t> buf;
-	buf.reserve(sizeof(AchBinHeader) + ((int)Achievements::ID::Max * 12));
-	buf.resize(sizeof(AchBinHeader));
-
-	// Header
-	AchBinHeader *header = reinterpret_cast<AchBinHeader*>(buf.data());
-	memcpy(header->magic, ACH_BIN_MAGIC, sizeof(header->magic));
-	header->length = 0;
-	header->crc32 = 0;
-	header->count = cpu_to_le32(static_cast<uint32_t>(mapAchData.size()));
+	buf.resize(sizeof(AchBinHeader) + (mapAchData.size() * sizeof(AchBinRecord)));
 
-	// Process all achievements in order of ID.
+	// Serialize all achievements in order of ID.
 	static_assert(achInfo.size() == static_cast<size_t>(Achievements::ID::Max), "achInfo[] is the wrong size");
+	AchBinRecord *const recs = reinterpret_cast<AchBinRecord*>(&buf.data()[sizeof(AchBinHeader)]);
+	uint32_t rec_count = 0;
 	for (unsigned int i = 0; i < (int)Achievements::ID::Max; i++) {
 		auto iter = mapAchData.find((Achievements::ID)i);
 		if (iter == mapAchData.end())
 			continue;
 
-		switch (achInfo[i].type) {
-			case AT_COUNT: {
-				buf.reserve(buf.size()+3+8+1);
-				buf.resize(buf.size()+3);
-				uint8_t *const p = &buf.data()[buf.size()-3];
-				// uint16_t: Achievement ID
-				p[0] = (i & 0xFF);
-				p[1] = (i >> 8) & 0xFF;
-				// uint8_t: Achievement type
-				p[2] = AT_COUNT;
-				// varlenint: Timestamp
-				appendVarlenInt(buf, iter->second.timestamp);
-				// uint8_t: Count
-				buf.push_back(iter->second.count);
-				break;
-			}
-
-			case AT_BITFIELD: {
-				// TODO: NEEDS TESTING!!!
-				buf.reserve(buf.size()+3+8+8);
-				buf.resize(buf.size()+3);
-				uint8_t *p = &buf.data()[buf.size()-3];
-				// uint16_t: Achievement ID
-				p[0] = (i & 0xFF);
-				p[1] = (i >> 8) & 0xFF;
-				// uint8_t: Achievement type
-				p[2] = AT_BITFIELD;
-				// varlenint: Timestamp
-				appendVarlenInt(buf, iter->second.timestamp);
-				// varlenint: Bitfield
-				appendVarlenInt(buf, iter->second.bitfield);
-				break;
-			}
-
-			default:
-				assert(!"Unsupported achievement.");
-				break;
+		int ret = buildRecord(recs[rec_count], (Achievements::ID)i, iter->second, iv, rec_count);
+		if (ret != 0) {
+			return ret;
 		}
+		rec_count++;
 	}
+	buf.resize(sizeof(AchBinHeader) + (rec_count * sizeof(AchBinRecord)));
 
-	// NOTE: buf may have been reallocated, so we need to
-	// get the header pointer again.
-	header = reinterpret_cast<AchBinHeader*>(buf.data());
-
-	static constexpr size_t HeaderSizeMinusCount = sizeof(AchBinHeader) - sizeof(header->count);
-
-	// Length of achievement data.
-	// Includes count, but not crc32.
-	header->length = static_cast<uint32_t>(buf.size() - HeaderSizeMinusCount);
-
-	// CRC32 of achievement data.
-	// Includes count.
-	if (buf.size() > HeaderSizeMinusCount) {
-		crc32Hash.process(&buf.data()[HeaderSizeMinusCount], buf.size() - HeaderSizeMinusCount);
-		header->crc32 = cpu_to_le32(crc32Hash.getHash32());
-	}
-
-#if defined(NDEBUG) || defined(FORCE_OBFUSCATE)
-	// Obfuscate the data.
-	if (buf.size() % 2 != 0) {
-		buf.push_back(0);
-	};
-	union {
-		uint16_t u16[2];
-		uint8_t u8[4];
-	} iv;
-	iv.u16[0] = (getpid() ^ time(nullptr)) & 0xFFFF;
-	iv.u16[1] = 0xFFFF - iv.u16[0];
-#if SYS_BYTEORDER != SYS_LIL_ENDIAN
-	iv.u16[0] = cpu_to_le16(iv.u16[0]);
-	iv.u16[1] = cpu_to_le16(iv.u16[1]);
-#endif /* SYS_BYTEORDER != SYS_LIL_ENDIAN */
-	const size_t ivpos = buf.size();
-	buf.resize(ivpos+4);
-	memcpy(&buf.data()[ivpos], iv.u8, sizeof(iv.u8));
-
-	doObfuscate(iv.u16[0], buf.data(), ivpos);
-#endif /* NDEBUG || FORCE_OBFUSCATE */
+	// Header (always plaintext)
+	AchBinHeader *const header = reinterpret_cast<AchBinHeader*>(buf.data());
+	memcpy(header->magic, ACH_BIN_MAGIC, sizeof(header->magic));
+	header->count = cpu_to_le32(rec_count);
+	header->iv = cpu_to_le16(iv);
+	header->iv_inv = cpu_to_le16(0xFFFF - iv);
 
 	// Write the achievements file.
 	const string filename = getFilename();
@@ -477,18 +481,152 @@ int AchievementsPrivate::save(void) const
 }
 
 /**
- * Load the achievements data.
+ * Build a serialized record for an achievement.
+ * The record is obfuscated if iv is non-zero.
+ * @param rec	[out] Destination record
+ * @param id	[in] Achievement ID
+ * @param data	[in] Achievement data
+ * @param iv	[in] File IV (0 if not obfuscated)
+ * @param idx	[in] Record index within the file
  * @return 0 on success; negative POSIX error code on error.
  */
-int AchievementsPrivate::load(void)
+int AchievementsPrivate::buildRecord(AchBinRecord &rec, Achievements::ID id, const AchData_t &data, uint16_t iv, uint32_t idx)
 {
+	const unsigned int i = static_cast<unsigned int>(id);
+	assert(i < achInfo.size());
+	if (i >= achInfo.size())
+		return -EINVAL;
+
+	rec.id = cpu_to_le16(static_cast<uint16_t>(i));
+	rec.type = achInfo[i].type;
+	rec.reserved = 0;
+	rec.timestamp = cpu_to_le64(static_cast<int64_t>(data.timestamp));
+	switch (achInfo[i].type) {
+		case AT_COUNT:
+			rec.data = cpu_to_le64(data.count);
+			break;
+		case AT_BITFIELD:
+			rec.data = cpu_to_le64(data.bitfield);
+			break;
+		default:
+			assert(!"Unsupported achievement.");
+			return -EINVAL;
+	}
+
+	// CRC32 of the timestamp and data fields. (plaintext)
 	Hash crc32Hash(Hash::Algorithm::CRC32);
 	if (!crc32Hash.isUsable()) {
 		// zlib could not be initialized.
 		// Can't calculate the CRC32.
 		return -ENOTSUP;
 	}
+	crc32Hash.process(&rec.timestamp, sizeof(rec.timestamp));
+	crc32Hash.process(&rec.data, sizeof(rec.data));
+	rec.crc32 = cpu_to_le32(crc32Hash.getHash32());
+
+	// Obfuscate the record.
+	const uint16_t rec_iv = recordIV(iv, idx);
+	if (rec_iv != 0) {
+		doObfuscate(rec_iv, reinterpret_cast<uint8_t*>(&rec), sizeof(rec));
+	}
+	return 0;
+}
+
+/**
+ * Update a single achievement record in place.
+ *
+ * If the file is not in the current fixed-layout format, or the
+ * record isn't present yet and can't be appended, this falls back
+ * to a full save().
+ *
+ * @param id Achievement ID.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int AchievementsPrivate::saveOne(Achievements::ID id) const
+{
+	auto iter = mapAchData.find(id);
+	assert(iter != mapAchData.end());
+	if (iter == mapAchData.end())
+		return -ENOENT;
+
+	const string filename = getFilename();
+	if (filename.empty()) {
+		// Unable to get the filename.
+		return -EIO;
+	}
+
+	unique_ptr<RpFile> file(new RpFile(filename, RpFile::FM_OPEN_WRITE));
+	if (!file->isOpen()) {
+		// No usable file yet. Write the whole file.
+		return save();
+	}
+
+	// Verify the header.
+	AchBinHeader header;
+	size_t size = file->read(&header, sizeof(header));
+	if (size != sizeof(header) ||
+	    memcmp(header.magic, ACH_BIN_MAGIC, sizeof(header.magic)) != 0)
+	{
+		// Old or invalid format. Rewrite the whole file.
+		file.reset(nullptr);
+		return save();
+	}
+	const uint16_t iv = le16_to_cpu(header.iv);
+	const uint32_t count = le32_to_cpu(header.count);
+	if (le16_to_cpu(header.iv_inv) != (0xFFFF - iv) || count > 1024) {
+		// Corrupted header. Rewrite the whole file.
+		file.reset(nullptr);
+		return save();
+	}
 
+	// Locate the record for this achievement ID.
+	for (uint32_t idx = 0; idx < count; idx++) {
+		AchBinRecord rec;
+		const off64_t rec_addr = sizeof(header) + (idx * sizeof(rec));
+		size = file->seekAndRead(rec_addr, &rec, sizeof(rec));
+		if (size != sizeof(rec))
+			break;
+
+		const uint16_t rec_iv = recordIV(iv, idx);
+		if (rec_iv != 0) {
+			doObfuscate(rec_iv, reinterpret_cast<uint8_t*>(&rec), sizeof(rec));
+		}
+		if (le16_to_cpu(rec.id) != static_cast<uint16_t>(id))
+			continue;
+
+		// Found it. Rewrite this record in place.
+		int ret = buildRecord(rec, id, iter->second, iv, idx);
+		if (ret != 0)
+			return ret;
+		if (file->seek(rec_addr) != 0)
+			return -EIO;
+		size = file->write(&rec, sizeof(rec));
+		return (size == sizeof(rec)) ? 0 : -EIO;
+	}
+
+	// Record not found: append it, then update the header count.
+	AchBinRecord rec;
+	int ret = buildRecord(rec, id, iter->second, iv, count);
+	if (ret != 0)
+		return ret;
+	if (file->seek(sizeof(header) + (count * sizeof(rec))) != 0)
+		return -EIO;
+	size = file->write(&rec, sizeof(rec));
+	if (size != sizeof(rec))
+		return -EIO;
+	header.count = cpu_to_le32(count + 1);
+	if (file->seek(0) != 0)
+		return -EIO;
+	size = file->write(&header, sizeof(header));
+	return (size == sizeof(header)) ? 0 : -EIO;
+}
+
+/**
+ * Load the achievements data.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int AchievementsPrivate::load(void)
+{
 	// Clear loaded achievements.
 	loaded = false;
 	mapAchData.clear();
@@ -527,6 +665,129 @@ int AchievementsPrivate::load(void)
 	}
 	file.reset(nullptr);
 
+	// Check for a version 2 header. (plaintext)
+	if (buf.size() < sizeof(AchBinHeader) ||
+	    memcmp(buf.data(), ACH_BIN_MAGIC, 8) != 0)
+	{
+		// Not version 2. Try the version 1 format.
+		return loadV1(buf);
+	}
+
+	const AchBinHeader *const header = reinterpret_cast<const AchBinHeader*>(buf.data());
+	const uint16_t iv = le16_to_cpu(header->iv);
+	if (le16_to_cpu(header->iv_inv) != (0xFFFF - iv)) {
+		// Incorrect iv_inv.
+		return -EBADF;
+	}
+
+	const uint32_t rec_count = le32_to_cpu(header->count);
+	if (rec_count > 1024 ||
+	    sizeof(AchBinHeader) + (rec_count * sizeof(AchBinRecord)) > buf.size())
+	{
+		// Incorrect count.
+		return -EBADF;
+	}
+
+	Hash crc32Hash(Hash::Algorithm::CRC32);
+	if (!crc32Hash.isUsable()) {
+		// zlib could not be initialized.
+		// Can't verify the CRC32s.
+		return -ENOTSUP;
+	}
+
+	// Process all achievements.
+	// NOTE: Records have a fixed layout, so this is a cast per record.
+	bool ok = true;
+	const AchBinRecord *const recs = reinterpret_cast<const AchBinRecord*>(&buf.data()[sizeof(AchBinHeader)]);
+	for (uint32_t idx = 0; ok && idx < rec_count; idx++) {
+		AchBinRecord rec = recs[idx];
+		const uint16_t rec_iv = recordIV(iv, idx);
+		if (rec_iv != 0) {
+			doObfuscate(rec_iv, reinterpret_cast<uint8_t*>(&rec), sizeof(rec));
+		}
+
+		// Verify the CRC32 of the timestamp and data fields.
+		crc32Hash.reset();
+		crc32Hash.process(&rec.timestamp, sizeof(rec.timestamp));
+		crc32Hash.process(&rec.data, sizeof(rec.data));
+		if (crc32Hash.getHash32() != le32_to_cpu(rec.crc32)) {
+			// Incorrect CRC32.
+			ok = false;
+			break;
+		}
+
+		const uint16_t id = le16_to_cpu(rec.id);
+		if (id >= (int)Achievements::ID::Max) {
+			// Invalid ID.
+			// NOTE: Allowing this in case the user is downgrading
+			// from a newer version that has more achievements.
+			// NOTE: We can't validate the type if the achievement ID is out of range.
+			assert(!"Achievement ID is out of range.");
+			continue;
+		}
+
+		// Make sure the type is correct.
+		if (achInfo[id].type != rec.type) {
+			// Incorrect type.
+			assert(!"Achievement type is incorrect for specified ID.");
+			ok = false;
+			break;
+		}
+
+		// Check for duplicates.
+		auto iter = mapAchData.find((Achievements::ID)id);
+		if (iter != mapAchData.end()) {
+			// Found a duplicate.
+			assert(!"Duplicate achievement found!");
+			ok = false;
+			break;
+		}
+
+		AchData_t &achData = mapAchData[(Achievements::ID)id];
+		achData.timestamp = static_cast<time_t>(le64_to_cpu(rec.timestamp));
+		switch (rec.type) {
+			case AT_COUNT:
+				achData.count = static_cast<uint8_t>(le64_to_cpu(rec.data));
+				break;
+			case AT_BITFIELD:
+				achData.bitfield = le64_to_cpu(rec.data);
+				break;
+			default:
+				// Unhandled achievement type.
+				// This is an error!
+				assert(!"Unhandled achievement type.");
+				ok = false;
+				break;
+		}
+	}
+
+	if (!ok) {
+		// An error occurred while loading achievements.
+		loaded = false;
+		mapAchData.clear();
+		return -EIO;
+	}
+
+	// Achievements loaded.
+	loaded = true;
+	return 0;
+}
+
+/**
+ * Load the achievements data from a version 1 file.
+ * The file will be rewritten in version 2 format on next save.
+ * @param buf Raw file data. (may be modified for deobfuscation)
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int AchievementsPrivate::loadV1(rp::uvector<uint8_t> &buf)
+{
+	Hash crc32Hash(Hash::Algorithm::CRC32);
+	if (!crc32Hash.isUsable()) {
+		// zlib could not be initialized.
+		// Can't calculate the CRC32.
+		return -ENOTSUP;
+	}
+
 #if defined(NDEBUG) || defined(FORCE_OBFUSCATE)
 	// Deobfuscate the data.
 	if (buf.size() < 4) {
@@ -557,14 +818,14 @@ int AchievementsPrivate::load(void)
 #endif /* NDEBUG || FORCE_OBFUSCATE */
 
 	// Check the header.
-	const AchBinHeader *header = reinterpret_cast<const AchBinHeader*>(buf.data());
-	if (memcmp(header->magic, ACH_BIN_MAGIC, sizeof(header->magic)) != 0) {
+	const AchBinHeaderV1 *header = reinterpret_cast<const AchBinHeaderV1*>(buf.data());
+	if (memcmp(header->magic, ACH_BIN_MAGIC_V1, sizeof(header->magic)) != 0) {
 		// Incorrect header.
 		return -EBADF;
 	}
 
 	// Length should be >= HeaderSizeMinusCount, and less than 1 MB.
-	static constexpr size_t HeaderSizeMinusCount = sizeof(AchBinHeader) - sizeof(header->count);
+	static constexpr size_t HeaderSizeMinusCount = sizeof(AchBinHeaderV1) - sizeof(header->count);
 	const uint32_t data_len = le32_to_cpu(header->length);
 	if (data_len < sizeof(header->count) ||
 	    data_len >= ((1*1024*1024)-HeaderSizeMinusCount) ||
@@ -579,7 +840,7 @@ int AchievementsPrivate::load(void)
 
 	// NOTE: buf may have been reallocated, so we need to
 	// get the header pointer again.
-	header = reinterpret_cast<const AchBinHeader*>(buf.data());
+	header = reinterpret_cast<const AchBinHeaderV1*>(buf.data());
 
 	// Verify the CRC32.
 	crc32Hash.process(&buf.data()[HeaderSizeMinusCount], data_len);
@@ -591,7 +852,7 @@ int AchievementsPrivate::load(void)
 
 	// Process all achievements.
 	bool ok = true;
-	const uint8_t *p = &buf.data()[sizeof(AchBinHeader)];
+	const uint8_t *p = &buf.data()[sizeof(AchBinHeaderV1)];
 	const uint8_t *const p_end = &buf.data()[buf.size()];
 	uint32_t ach_count = le32_to_cpu(header->count);
 	for (; ok && p < p_end-3 && ach_count > 0; ach_count--) {
@@ -853,7 +1114,7 @@ int Achievements::unlock(ID id, int bit)
 	}
 
 	// Save the achievement data.
-	d->save();
+	d->saveOne(id);
 
 	if (unlocked) {
 		// Achievement unlocked!
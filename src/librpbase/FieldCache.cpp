@@ -0,0 +1,963 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase)                        *
+ * FieldCache.cpp: Persistent parsed-metadata cache.                       *
+ *                                                                         *
+ * Copyright (c) 2016-2024 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "FieldCache.hpp"
+
+#include "RomFields.hpp"
+#include "RomMetaData.hpp"
+#include "config/AboutTabText.hpp"
+
+// Other rom-properties libraries
+#include "libcachecommon/CacheDir.hpp"
+#include "librpfile/FileSystem.hpp"
+#include "librpfile/MmapFile.hpp"
+using namespace LibRpFile;
+
+// C includes
+#include <sys/stat.h>
+
+// C includes (C++ namespace)
+#include <clocale>
+#include <cstdio>
+
+#ifndef DIR_SEP_CHR
+#  ifdef _WIN32
+#    define DIR_SEP_CHR '\\'
+#  else /* !_WIN32 */
+#    define DIR_SEP_CHR '/'
+#  endif /* _WIN32 */
+#endif /* DIR_SEP_CHR */
+
+// C++ STL classes
+using std::string;
+using std::unique_ptr;
+using std::vector;
+
+namespace LibRpBase { namespace FieldCache {
+
+// Cache file format:
+// - Header (see below; all integers are little-endian)
+// - Tab names
+// - Field records
+// - Metadata records
+//
+// Strings are serialized as a uint32_t length plus the string data,
+// with length 0xFFFFFFFF indicating a nullptr string.
+//
+// Bump SERIAL_VERSION whenever the serialization changes; old cache
+// files are then treated as misses and rewritten.
+static const uint32_t SERIAL_VERSION = 2;
+static const uint32_t STR_IS_NULL = 0xFFFFFFFFU;
+
+// Header: "RPMC", version, then the environment and source file identity.
+//
+// The serialized text is post-gettext: field names and many values go
+// through C_() at parse time, so an entry written under one UI locale
+// must not be served under another. Likewise, a program upgrade may
+// improve a subclass parser, so entries from other program versions
+// are rejected even though the source file itself is unchanged.
+// (def_lc is the ROM's own language, not the UI locale; it doesn't
+// cover either case.)
+struct CacheHeader {
+	char magic[4];		// "RPMC"
+	uint32_t version;	// SERIAL_VERSION
+	uint64_t prog_version;	// AboutTabText::getProgramVersion()
+	uint64_t locale_hash;	// FNV-1a hash of the LC_MESSAGES locale name (0 if unknown)
+	uint64_t dev;		// st_dev (0 if not available)
+	uint64_t ino;		// st_ino (0 if not available)
+	uint64_t path_hash;	// FNV-1a hash of the source path
+	int64_t mtime;		// source mtime
+	int64_t fsize;		// source size
+	uint32_t tab_count;
+	uint32_t field_count;
+	uint32_t meta_count;
+	uint32_t def_lc;	// RomFields::defaultLanguageCode()
+};
+ASSERT_STRUCT(CacheHeader, 80);
+
+/** Serialization helpers **/
+
+static inline void put_u8(vector<uint8_t> &buf, uint8_t v)
+{
+	buf.push_back(v);
+}
+
+static void put_u16(vector<uint8_t> &buf, uint16_t v)
+{
+	v = cpu_to_le16(v);
+	const uint8_t *const p = reinterpret_cast<const uint8_t*>(&v);
+	buf.insert(buf.end(), p, p + sizeof(v));
+}
+
+static void put_u32(vector<uint8_t> &buf, uint32_t v)
+{
+	v = cpu_to_le32(v);
+	const uint8_t *const p = reinterpret_cast<const uint8_t*>(&v);
+	buf.insert(buf.end(), p, p + sizeof(v));
+}
+
+static void put_u64(vector<uint8_t> &buf, uint64_t v)
+{
+	v = cpu_to_le64(v);
+	const uint8_t *const p = reinterpret_cast<const uint8_t*>(&v);
+	buf.insert(buf.end(), p, p + sizeof(v));
+}
+
+static inline void put_i64(vector<uint8_t> &buf, int64_t v)
+{
+	put_u64(buf, static_cast<uint64_t>(v));
+}
+
+static void put_str(vector<uint8_t> &buf, const char *str)
+{
+	if (!str) {
+		put_u32(buf, STR_IS_NULL);
+		return;
+	}
+	const size_t len = strlen(str);
+	put_u32(buf, static_cast<uint32_t>(len));
+	buf.insert(buf.end(),
+		reinterpret_cast<const uint8_t*>(str),
+		reinterpret_cast<const uint8_t*>(str) + len);
+}
+
+static void put_str(vector<uint8_t> &buf, const string &str)
+{
+	put_u32(buf, static_cast<uint32_t>(str.size()));
+	buf.insert(buf.end(),
+		reinterpret_cast<const uint8_t*>(str.data()),
+		reinterpret_cast<const uint8_t*>(str.data()) + str.size());
+}
+
+/**
+ * Bounds-checked read cursor over an mmap'd cache file.
+ * Once any read fails, all subsequent reads fail.
+ */
+class Cursor
+{
+public:
+	Cursor(const uint8_t *p, size_t size)
+		: p(p), p_end(p + size), err(false)
+	{ }
+
+	bool ok(void) const
+	{
+		return !err;
+	}
+
+	bool get(void *dst, size_t size)
+	{
+		// NOTE: Checking with subtraction to avoid integer overflow.
+		if (err || static_cast<size_t>(p_end - p) < size) {
+			err = true;
+			return false;
+		}
+		memcpy(dst, p, size);
+		p += size;
+		return true;
+	}
+
+	uint8_t get_u8(void)
+	{
+		uint8_t v = 0;
+		get(&v, sizeof(v));
+		return v;
+	}
+
+	uint16_t get_u16(void)
+	{
+		uint16_t v = 0;
+		get(&v, sizeof(v));
+		return le16_to_cpu(v);
+	}
+
+	uint32_t get_u32(void)
+	{
+		uint32_t v = 0;
+		get(&v, sizeof(v));
+		return le32_to_cpu(v);
+	}
+
+	uint64_t get_u64(void)
+	{
+		uint64_t v = 0;
+		get(&v, sizeof(v));
+		return le64_to_cpu(v);
+	}
+
+	int64_t get_i64(void)
+	{
+		return static_cast<int64_t>(get_u64());
+	}
+
+	/**
+	 * Read a string.
+	 * @param str	[out] Destination string.
+	 * @return True if a string was present; false if it was a nullptr marker.
+	 */
+	bool get_str(string &str)
+	{
+		str.clear();
+		const uint32_t len = get_u32();
+		if (err || len == STR_IS_NULL) {
+			return false;
+		}
+		if (static_cast<size_t>(p_end - p) < len) {
+			err = true;
+			return false;
+		}
+		str.assign(reinterpret_cast<const char*>(p), len);
+		p += len;
+		return true;
+	}
+
+private:
+	const uint8_t *p;
+	const uint8_t *const p_end;
+	bool err;
+};
+
+/**
+ * FNV-1a hash of a NULL-terminated string.
+ * @param str String.
+ * @return 64-bit hash.
+ */
+static uint64_t fnv1a_64(const char *str)
+{
+	uint64_t hash = 0xCBF29CE484222325ULL;
+	for (; *str != '\0'; str++) {
+		hash ^= static_cast<uint8_t>(*str);
+		hash *= 0x100000001B3ULL;
+	}
+	return hash;
+}
+
+/**
+ * Get the source file identity: device, inode, size, mtime.
+ * @param filename	[in] Source filename. (UTF-8)
+ * @param hdr		[out] Header to fill in. (dev, ino, path_hash, mtime, fsize)
+ * @return True on success; false if the file can't be stat()'d.
+ */
+static bool getFileIdentity(const char *filename, CacheHeader &hdr)
+{
+	off64_t fileSize = 0;
+	time_t mtime = 0;
+	if (FileSystem::get_file_size_and_mtime(filename, &fileSize, &mtime) != 0) {
+		return false;
+	}
+	hdr.mtime = static_cast<int64_t>(mtime);
+	hdr.fsize = static_cast<int64_t>(fileSize);
+	hdr.path_hash = fnv1a_64(filename);
+
+#ifdef _WIN32
+	// No usable inode numbers here; the path hash plus
+	// size and mtime serve as the identity.
+	hdr.dev = 0;
+	hdr.ino = 0;
+#else /* !_WIN32 */
+	struct stat sb;
+	if (stat(filename, &sb) == 0) {
+		hdr.dev = static_cast<uint64_t>(sb.st_dev);
+		hdr.ino = static_cast<uint64_t>(sb.st_ino);
+	} else {
+		hdr.dev = 0;
+		hdr.ino = 0;
+	}
+#endif /* _WIN32 */
+	return true;
+}
+
+/**
+ * Get the environment identity: program version and UI locale.
+ * @param hdr	[out] Header to fill in. (prog_version, locale_hash)
+ */
+static void getEnvironmentIdentity(CacheHeader &hdr)
+{
+	hdr.prog_version = AboutTabText::getProgramVersion();
+
+#ifdef LC_MESSAGES
+	const char *const locale = setlocale(LC_MESSAGES, nullptr);
+#else /* !LC_MESSAGES */
+	// MSVCRT doesn't have LC_MESSAGES.
+	const char *const locale = setlocale(LC_ALL, nullptr);
+#endif /* LC_MESSAGES */
+	hdr.locale_hash = (locale ? fnv1a_64(locale) : 0);
+}
+
+/**
+ * Get the cache filename for a source file.
+ * @param hdr Header with the source file identity filled in.
+ * @return Cache filename, or empty string if the cache directory is unusable.
+ */
+static string getCacheFilename(const CacheHeader &hdr)
+{
+	const string &cacheDir = LibCacheCommon::getCacheDirectory();
+	if (cacheDir.empty()) {
+		return string();
+	}
+
+	char fnbuf[64];
+	snprintf(fnbuf, sizeof(fnbuf), "%016llx-%llx-%llx.rpmc",
+		static_cast<unsigned long long>(hdr.path_hash),
+		static_cast<unsigned long long>(hdr.dev),
+		static_cast<unsigned long long>(hdr.ino));
+
+	string cacheFilename = cacheDir;
+	cacheFilename += DIR_SEP_CHR;
+	cacheFilename += "metacache";
+	cacheFilename += DIR_SEP_CHR;
+	cacheFilename += fnbuf;
+	return cacheFilename;
+}
+
+/** store() **/
+
+/**
+ * Serialize a ListData_t.
+ * @param buf Destination buffer.
+ * @param list_data List data.
+ */
+static void putListData(vector<uint8_t> &buf, const RomFields::ListData_t &list_data)
+{
+	put_u32(buf, static_cast<uint32_t>(list_data.size()));
+	for (const vector<string> &row : list_data) {
+		put_u32(buf, static_cast<uint32_t>(row.size()));
+		for (const string &cell : row) {
+			put_str(buf, cell);
+		}
+	}
+}
+
+/**
+ * Serialize a single field.
+ * @param buf Destination buffer.
+ * @param field Field.
+ * @return True on success; false if the field can't be serialized.
+ */
+static bool putField(vector<uint8_t> &buf, const RomFields::Field &field)
+{
+	put_u8(buf, static_cast<uint8_t>(field.type));
+	put_u8(buf, field.tabIdx);
+	put_u32(buf, static_cast<uint32_t>(field.flags));
+	put_str(buf, field.name);
+
+	switch (field.type) {
+		default:
+			// Unknown field type.
+			return false;
+
+		case RomFields::RFT_STRING:
+			put_str(buf, field.data.str);
+			break;
+
+		case RomFields::RFT_BITFIELD: {
+			const vector<string> *const names = field.desc.bitfield.names;
+			if (!names) {
+				return false;
+			}
+			put_u32(buf, static_cast<uint32_t>(names->size()));
+			for (const string &name : *names) {
+				put_str(buf, name);
+			}
+			put_u32(buf, static_cast<uint32_t>(field.desc.bitfield.elemsPerRow));
+			put_u32(buf, field.data.bitfield);
+			break;
+		}
+
+		case RomFields::RFT_LISTDATA: {
+			if (field.flags & RomFields::RFT_LISTDATA_ICONS) {
+				// Icons are rp_images; not cacheable.
+				return false;
+			}
+
+			// Headers
+			const vector<string> *const headers = field.desc.list_data.names;
+			if (headers) {
+				put_u32(buf, static_cast<uint32_t>(headers->size()));
+				for (const string &name : *headers) {
+					put_str(buf, name);
+				}
+			} else {
+				put_u32(buf, STR_IS_NULL);
+			}
+			put_u32(buf, static_cast<uint32_t>(field.desc.list_data.rows_visible));
+
+			// Per-column attributes
+			const RomFields::ListDataColAttrs_t &col_attrs = field.desc.list_data.col_attrs;
+			put_u16(buf, col_attrs.align_headers);
+			put_u16(buf, col_attrs.align_data);
+			put_u16(buf, col_attrs.sizing);
+			put_u16(buf, col_attrs.sorting);
+			put_u8(buf, static_cast<uint8_t>(col_attrs.sort_col));
+			put_u8(buf, static_cast<uint8_t>(col_attrs.sort_dir));
+			put_u8(buf, col_attrs.is_timestamp);
+			put_u8(buf, static_cast<uint8_t>(col_attrs.dtflags));
+
+			// Data
+			if (field.flags & RomFields::RFT_LISTDATA_MULTI) {
+				const RomFields::ListDataMultiMap_t *const multi = field.data.list_data.data.multi;
+				if (!multi) {
+					return false;
+				}
+				put_u32(buf, static_cast<uint32_t>(multi->size()));
+				for (const auto &pair : *multi) {
+					put_u32(buf, pair.first);
+					putListData(buf, pair.second);
+				}
+			} else {
+				const RomFields::ListData_t *const single = field.data.list_data.data.single;
+				if (!single) {
+					return false;
+				}
+				putListData(buf, *single);
+			}
+
+			if (field.flags & RomFields::RFT_LISTDATA_CHECKBOXES) {
+				put_u32(buf, field.data.list_data.mxd.checkboxes);
+			}
+			break;
+		}
+
+		case RomFields::RFT_DATETIME:
+			put_i64(buf, static_cast<int64_t>(field.data.date_time));
+			break;
+
+		case RomFields::RFT_AGE_RATINGS: {
+			const RomFields::age_ratings_t *const age_ratings = field.data.age_ratings;
+			if (!age_ratings) {
+				return false;
+			}
+			for (const uint16_t rating : *age_ratings) {
+				put_u16(buf, rating);
+			}
+			break;
+		}
+
+		case RomFields::RFT_DIMENSIONS:
+			put_u32(buf, static_cast<uint32_t>(field.data.dimensions[0]));
+			put_u32(buf, static_cast<uint32_t>(field.data.dimensions[1]));
+			put_u32(buf, static_cast<uint32_t>(field.data.dimensions[2]));
+			break;
+
+		case RomFields::RFT_STRING_MULTI: {
+			const RomFields::StringMultiMap_t *const str_multi = field.data.str_multi;
+			if (!str_multi) {
+				return false;
+			}
+			put_u32(buf, static_cast<uint32_t>(str_multi->size()));
+			for (const auto &pair : *str_multi) {
+				put_u32(buf, pair.first);
+				put_str(buf, pair.second);
+			}
+			break;
+		}
+	}
+
+	return true;
+}
+
+bool store(const char *filename, const RomFields *fields, const RomMetaData *metaData)
+{
+	assert(filename != nullptr);
+	assert(fields != nullptr);
+	if (!filename || !fields) {
+		return false;
+	}
+
+	CacheHeader hdr;
+	memcpy(hdr.magic, "RPMC", 4);
+	hdr.version = SERIAL_VERSION;
+	getEnvironmentIdentity(hdr);
+	if (!getFileIdentity(filename, hdr)) {
+		return false;
+	}
+
+	const string cacheFilename = getCacheFilename(hdr);
+	if (cacheFilename.empty()) {
+		return false;
+	}
+
+	// Serialize the tab names and fields.
+	vector<uint8_t> buf;
+	buf.reserve(4096);
+
+	const int tabCount = fields->tabCount();
+	for (int i = 0; i < tabCount; i++) {
+		put_str(buf, fields->tabName(i));
+	}
+
+	uint32_t field_count = 0;
+	const auto iter_end = fields->cend();
+	for (auto iter = fields->cbegin(); iter != iter_end; ++iter) {
+		if (iter->type == RomFields::RFT_INVALID) {
+			// Skipped field.
+			continue;
+		}
+		if (!putField(buf, *iter)) {
+			// Not cacheable.
+			return false;
+		}
+		field_count++;
+	}
+
+	// Serialize the metadata properties.
+	uint32_t meta_count = 0;
+	if (metaData) {
+		const auto meta_end = metaData->cend();
+		for (auto iter = metaData->cbegin(); iter != meta_end; ++iter) {
+			put_u32(buf, static_cast<uint32_t>(iter->name));
+			put_u8(buf, static_cast<uint8_t>(iter->type));
+			switch (iter->type) {
+				default:
+					// Unknown property type.
+					return false;
+				case PropertyType::Integer:
+					put_u32(buf, static_cast<uint32_t>(iter->data.ivalue));
+					break;
+				case PropertyType::UnsignedInteger:
+					put_u32(buf, iter->data.uvalue);
+					break;
+				case PropertyType::String:
+					if (iter->data.str) {
+						put_str(buf, *(iter->data.str));
+					} else {
+						put_u32(buf, STR_IS_NULL);
+					}
+					break;
+				case PropertyType::Timestamp:
+					put_i64(buf, static_cast<int64_t>(iter->data.timestamp));
+					break;
+				case PropertyType::Double: {
+					uint64_t dbits;
+					memcpy(&dbits, &iter->data.dvalue, sizeof(dbits));
+					put_u64(buf, dbits);
+					break;
+				}
+			}
+			meta_count++;
+		}
+	}
+
+	hdr.tab_count = static_cast<uint32_t>(tabCount);
+	hdr.field_count = field_count;
+	hdr.meta_count = meta_count;
+	hdr.def_lc = fields->defaultLanguageCode();
+
+	// Serialize the header.
+	vector<uint8_t> hdrbuf;
+	hdrbuf.reserve(sizeof(CacheHeader));
+	hdrbuf.insert(hdrbuf.end(),
+		reinterpret_cast<const uint8_t*>(hdr.magic),
+		reinterpret_cast<const uint8_t*>(hdr.magic) + 4);
+	put_u32(hdrbuf, hdr.version);
+	put_u64(hdrbuf, hdr.prog_version);
+	put_u64(hdrbuf, hdr.locale_hash);
+	put_u64(hdrbuf, hdr.dev);
+	put_u64(hdrbuf, hdr.ino);
+	put_u64(hdrbuf, hdr.path_hash);
+	put_i64(hdrbuf, hdr.mtime);
+	put_i64(hdrbuf, hdr.fsize);
+	put_u32(hdrbuf, hdr.tab_count);
+	put_u32(hdrbuf, hdr.field_count);
+	put_u32(hdrbuf, hdr.meta_count);
+	put_u32(hdrbuf, hdr.def_lc);
+	assert(hdrbuf.size() == sizeof(CacheHeader));
+
+	// Write to a temporary file, then rename it into place so
+	// readers never see a partial file.
+	if (FileSystem::rmkdir(cacheFilename) != 0) {
+		return false;
+	}
+	const string tmpFilename = cacheFilename + ".tmp";
+	FILE *const f = fopen(tmpFilename.c_str(), "wb");
+	if (!f) {
+		return false;
+	}
+	bool ok = (fwrite(hdrbuf.data(), 1, hdrbuf.size(), f) == hdrbuf.size());
+	ok = ok && (fwrite(buf.data(), 1, buf.size(), f) == buf.size());
+	ok = (fclose(f) == 0) && ok;
+	if (!ok) {
+		remove(tmpFilename.c_str());
+		return false;
+	}
+
+#ifdef _WIN32
+	// rename() does not overwrite on Windows.
+	remove(cacheFilename.c_str());
+#endif /* _WIN32 */
+	if (rename(tmpFilename.c_str(), cacheFilename.c_str()) != 0) {
+		remove(tmpFilename.c_str());
+		return false;
+	}
+	return true;
+}
+
+/** load() **/
+
+/**
+ * Deserialize a ListData_t.
+ * @param cur Read cursor.
+ * @param list_data Destination list data.
+ * @return True on success; false on parse error.
+ */
+static bool getListData(Cursor &cur, RomFields::ListData_t &list_data)
+{
+	const uint32_t rows = cur.get_u32();
+	if (!cur.ok() || rows > 1048576) {
+		return false;
+	}
+	list_data.resize(rows);
+	for (uint32_t i = 0; i < rows; i++) {
+		const uint32_t cols = cur.get_u32();
+		if (!cur.ok() || cols > 256) {
+			return false;
+		}
+		list_data[i].resize(cols);
+		for (uint32_t j = 0; j < cols; j++) {
+			cur.get_str(list_data[i][j]);
+		}
+	}
+	return cur.ok();
+}
+
+/**
+ * Deserialize a single field and add it to a RomFields object.
+ * @param cur Read cursor.
+ * @param fields Destination RomFields.
+ * @param def_lc Default language code from the header.
+ * @return True on success; false on parse error.
+ */
+static bool getField(Cursor &cur, RomFields *fields, uint32_t def_lc)
+{
+	const uint8_t type = cur.get_u8();
+	const uint8_t tabIdx = cur.get_u8();
+	const unsigned int flags = cur.get_u32();
+	string name;
+	const bool hasName = cur.get_str(name);
+	if (!cur.ok()) {
+		return false;
+	}
+	const char *const name_c = (hasName ? name.c_str() : nullptr);
+	fields->setTabIndex(tabIdx);
+
+	switch (type) {
+		default:
+			// Unknown field type.
+			return false;
+
+		case RomFields::RFT_STRING: {
+			string str;
+			const bool hasStr = cur.get_str(str);
+			if (!cur.ok()) {
+				return false;
+			}
+			fields->addField_string(name_c, (hasStr ? str.c_str() : nullptr), flags);
+			break;
+		}
+
+		case RomFields::RFT_BITFIELD: {
+			const uint32_t count = cur.get_u32();
+			if (!cur.ok() || count > 64) {
+				return false;
+			}
+			unique_ptr<vector<string> > names(new vector<string>(count));
+			for (uint32_t i = 0; i < count; i++) {
+				cur.get_str((*names)[i]);
+			}
+			const int elemsPerRow = static_cast<int>(cur.get_u32());
+			const uint32_t bitfield = cur.get_u32();
+			if (!cur.ok()) {
+				return false;
+			}
+			fields->addField_bitfield(name_c, names.release(), elemsPerRow, bitfield);
+			break;
+		}
+
+		case RomFields::RFT_LISTDATA: {
+			RomFields::AFLD_PARAMS params(flags, 0);
+			params.def_lc = def_lc;
+
+			// Headers
+			unique_ptr<vector<string> > headers;
+			const uint32_t hdr_count = cur.get_u32();
+			if (!cur.ok()) {
+				return false;
+			}
+			if (hdr_count != STR_IS_NULL) {
+				if (hdr_count > 256) {
+					return false;
+				}
+				headers.reset(new vector<string>(hdr_count));
+				for (uint32_t i = 0; i < hdr_count; i++) {
+					cur.get_str((*headers)[i]);
+				}
+			}
+			params.rows_visible = static_cast<int>(cur.get_u32());
+
+			// Per-column attributes
+			params.col_attrs.align_headers = cur.get_u16();
+			params.col_attrs.align_data = cur.get_u16();
+			params.col_attrs.sizing = cur.get_u16();
+			params.col_attrs.sorting = cur.get_u16();
+			params.col_attrs.sort_col = static_cast<int8_t>(cur.get_u8());
+			params.col_attrs.sort_dir = static_cast<RomFields::ColSortOrder>(cur.get_u8());
+			params.col_attrs.is_timestamp = cur.get_u8();
+			params.col_attrs.dtflags = static_cast<RomFields::DateTimeFlags>(cur.get_u8());
+			if (!cur.ok()) {
+				return false;
+			}
+
+			// Data
+			unique_ptr<RomFields::ListData_t> single;
+			unique_ptr<RomFields::ListDataMultiMap_t> multi;
+			if (flags & RomFields::RFT_LISTDATA_MULTI) {
+				const uint32_t map_count = cur.get_u32();
+				if (!cur.ok() || map_count > 256) {
+					return false;
+				}
+				multi.reset(new RomFields::ListDataMultiMap_t());
+				for (uint32_t i = 0; i < map_count; i++) {
+					const uint32_t lc = cur.get_u32();
+					if (!getListData(cur, (*multi)[lc])) {
+						return false;
+					}
+				}
+			} else {
+				single.reset(new RomFields::ListData_t());
+				if (!getListData(cur, *single)) {
+					return false;
+				}
+			}
+
+			if (flags & RomFields::RFT_LISTDATA_CHECKBOXES) {
+				params.mxd.checkboxes = cur.get_u32();
+			}
+			if (!cur.ok()) {
+				return false;
+			}
+
+			params.headers = headers.release();
+			if (multi) {
+				params.data.multi = multi.release();
+			} else {
+				params.data.single = single.release();
+			}
+			fields->addField_listData(name_c, &params);
+			break;
+		}
+
+		case RomFields::RFT_DATETIME: {
+			const int64_t date_time = cur.get_i64();
+			if (!cur.ok()) {
+				return false;
+			}
+			fields->addField_dateTime(name_c, static_cast<time_t>(date_time), flags);
+			break;
+		}
+
+		case RomFields::RFT_AGE_RATINGS: {
+			RomFields::age_ratings_t age_ratings;
+			for (uint16_t &rating : age_ratings) {
+				rating = cur.get_u16();
+			}
+			if (!cur.ok()) {
+				return false;
+			}
+			fields->addField_ageRatings(name_c, age_ratings);
+			break;
+		}
+
+		case RomFields::RFT_DIMENSIONS: {
+			const int dimX = static_cast<int>(cur.get_u32());
+			const int dimY = static_cast<int>(cur.get_u32());
+			const int dimZ = static_cast<int>(cur.get_u32());
+			if (!cur.ok()) {
+				return false;
+			}
+			fields->addField_dimensions(name_c, dimX, dimY, dimZ);
+			break;
+		}
+
+		case RomFields::RFT_STRING_MULTI: {
+			const uint32_t map_count = cur.get_u32();
+			if (!cur.ok() || map_count > 256) {
+				return false;
+			}
+			unique_ptr<RomFields::StringMultiMap_t> str_multi(new RomFields::StringMultiMap_t());
+			for (uint32_t i = 0; i < map_count; i++) {
+				const uint32_t lc = cur.get_u32();
+				cur.get_str((*str_multi)[lc]);
+			}
+			if (!cur.ok()) {
+				return false;
+			}
+			fields->addField_string_multi(name_c, str_multi.release(), def_lc, flags);
+			break;
+		}
+	}
+
+	return cur.ok();
+}
+
+bool load(const char *filename, RomFields *fields, RomMetaData *metaData)
+{
+	assert(filename != nullptr);
+	assert(fields != nullptr);
+	if (!filename || !fields) {
+		return false;
+	}
+
+	// Get the current environment and source file identity.
+	CacheHeader expected;
+	getEnvironmentIdentity(expected);
+	if (!getFileIdentity(filename, expected)) {
+		return false;
+	}
+	const string cacheFilename = getCacheFilename(expected);
+	if (cacheFilename.empty()) {
+		return false;
+	}
+
+	// mmap the cache file.
+	MmapFile mmapFile(cacheFilename.c_str());
+	if (!mmapFile.isOpen()) {
+		return false;
+	}
+	const uint8_t *const data = static_cast<const uint8_t*>(mmapFile.buffer());
+	const size_t data_size = static_cast<size_t>(mmapFile.size());
+	if (!data || data_size < sizeof(CacheHeader)) {
+		return false;
+	}
+
+	// Validate the header.
+	Cursor cur(data, data_size);
+	char magic[4];
+	cur.get(magic, sizeof(magic));
+	if (!cur.ok() || memcmp(magic, "RPMC", 4) != 0) {
+		return false;
+	}
+	if (cur.get_u32() != SERIAL_VERSION) {
+		return false;
+	}
+	if (cur.get_u64() != expected.prog_version ||
+	    cur.get_u64() != expected.locale_hash)
+	{
+		// Cache entry was written by a different program
+		// version or under a different UI locale.
+		return false;
+	}
+	const uint64_t dev = cur.get_u64();
+	const uint64_t ino = cur.get_u64();
+	const uint64_t path_hash = cur.get_u64();
+	const int64_t mtime = cur.get_i64();
+	const int64_t fsize = cur.get_i64();
+	if (dev != expected.dev || ino != expected.ino ||
+	    path_hash != expected.path_hash ||
+	    mtime != expected.mtime || fsize != expected.fsize)
+	{
+		// Source file has changed; cache is stale.
+		return false;
+	}
+	const uint32_t tab_count = cur.get_u32();
+	const uint32_t field_count = cur.get_u32();
+	const uint32_t meta_count = cur.get_u32();
+	const uint32_t def_lc = cur.get_u32();
+	if (!cur.ok() || tab_count > 256 || field_count > 65536 || meta_count > 65536) {
+		return false;
+	}
+
+	// NOTE: Deserialization builds directly into the output objects.
+	// If parsing fails partway through, the contents are undefined,
+	// so callers should pass freshly-constructed objects and discard
+	// them if load() returns false.
+	vector<std::pair<bool, string> > tabNames(tab_count);
+	for (uint32_t i = 0; i < tab_count; i++) {
+		tabNames[i].first = cur.get_str(tabNames[i].second);
+	}
+	if (!cur.ok()) {
+		return false;
+	}
+	// NOTE: A single unnamed tab is the default RomFields state;
+	// don't allocate tabs for it.
+	if (tab_count > 1 || (tab_count == 1 && tabNames[0].first)) {
+		fields->reserveTabs(static_cast<int>(tab_count));
+		for (const auto &tabName : tabNames) {
+			fields->addTab(tabName.first ? tabName.second.c_str() : "");
+		}
+	}
+
+	fields->reserve(static_cast<int>(field_count));
+	for (uint32_t i = 0; i < field_count; i++) {
+		if (!getField(cur, fields, def_lc)) {
+			return false;
+		}
+	}
+
+	for (uint32_t i = 0; i < meta_count; i++) {
+		const Property prop = static_cast<Property>(cur.get_u32());
+		const PropertyType type = static_cast<PropertyType>(cur.get_u8());
+		if (!cur.ok()) {
+			return false;
+		}
+		switch (type) {
+			default:
+				// Unknown property type.
+				return false;
+			case PropertyType::Integer:
+				if (metaData) {
+					metaData->addMetaData_integer(prop, static_cast<int>(cur.get_u32()));
+				} else {
+					cur.get_u32();
+				}
+				break;
+			case PropertyType::UnsignedInteger:
+				if (metaData) {
+					metaData->addMetaData_uint(prop, cur.get_u32());
+				} else {
+					cur.get_u32();
+				}
+				break;
+			case PropertyType::String: {
+				string str;
+				cur.get_str(str);
+				if (!cur.ok()) {
+					return false;
+				}
+				if (metaData) {
+					metaData->addMetaData_string(prop, str);
+				}
+				break;
+			}
+			case PropertyType::Timestamp:
+				if (metaData) {
+					metaData->addMetaData_timestamp(prop, static_cast<time_t>(cur.get_i64()));
+				} else {
+					cur.get_i64();
+				}
+				break;
+			case PropertyType::Double: {
+				const uint64_t dbits = cur.get_u64();
+				if (metaData) {
+					double dvalue;
+					memcpy(&dvalue, &dbits, sizeof(dvalue));
+					metaData->addMetaData_double(prop, dvalue);
+				}
+				break;
+			}
+		}
+		if (!cur.ok()) {
+			return false;
+		}
+	}
+
+	// Everything parsed.
+	return true;
+}
+
+} }
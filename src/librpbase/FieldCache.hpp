@@ -0,0 +1,66 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase)                        *
+ * FieldCache.hpp: Persistent parsed-metadata cache.                       *
+ *                                                                         *
+ * Copyright (c) 2016-2024 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#pragma once
+
+#include "dll-macros.h"	// for RP_LIBROMDATA_PUBLIC
+
+namespace LibRpBase {
+
+class RomFields;
+class RomMetaData;
+
+namespace FieldCache {
+
+/**
+ * Persistent cache of parsed RomFields + RomMetaData.
+ *
+ * Cache files live in the rom-properties cache directory under
+ * "metacache/", keyed by the source file's identity (device, inode,
+ * path hash) and validated against its size and mtime. The payload
+ * is a compact tag-length-value serialization of the fields, read
+ * back via mmap, so a warm hit skips the full parse (and for
+ * encrypted formats, the decryption).
+ *
+ * The cache is strictly optional: consumers that want it call
+ * load() before parsing and store() after. Fields that can't be
+ * round-tripped (RFT_LISTDATA with icons) make the file
+ * uncacheable, and store() will return false.
+ */
+
+/**
+ * Load cached fields and metadata for a file.
+ *
+ * Validation is cheap: one stat() of the source file plus an
+ * mmap of the cache file. On any mismatch (size, mtime, identity,
+ * serialization version), the cache file is ignored.
+ *
+ * @param filename	[in] Source filename. (UTF-8)
+ * @param fields	[out] RomFields to append the cached fields to.
+ * @param metaData	[out,opt] RomMetaData to append the cached properties to.
+ * @return True if cached data was loaded; false on miss or error.
+ */
+RP_LIBROMDATA_PUBLIC
+bool load(const char *filename, RomFields *fields, RomMetaData *metaData);
+
+/**
+ * Store parsed fields and metadata for a file.
+ *
+ * The cache file is written to a temporary file and renamed into
+ * place, so readers never see a partial file.
+ *
+ * @param filename	[in] Source filename. (UTF-8)
+ * @param fields	[in] Parsed RomFields.
+ * @param metaData	[in,opt] Parsed RomMetaData.
+ * @return True if the cache file was written; false if the fields
+ * aren't cacheable or on I/O error.
+ */
+RP_LIBROMDATA_PUBLIC
+bool store(const char *filename, const RomFields *fields, const RomMetaData *metaData);
+
+} }
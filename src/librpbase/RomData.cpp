@@ -13,6 +13,13 @@
 // Other rom-properties libraries
 #include "libi18n/i18n.h"
 #include "libcachecommon/CacheKeys.hpp"
+
+// Persistent parsed-metadata cache
+#include "FieldCache.hpp"
+#include "config/Config.hpp"
+
+// Tracing instrumentation
+#include "rp_trace.h"
 using namespace LibRpFile;
 using namespace LibRpText;
 using namespace LibRpTexture;
@@ -782,6 +789,26 @@ int RomData::loadInternalMipmap(int mipmapLevel, LibRpTexture::rp_image_const_pt
 	return -ENOENT;
 }
 
+/**
+ * Load an internal image, with a size hint.
+ * Called by RomData::image() if a size hint was specified.
+ *
+ * The default implementation ignores the size hint and calls
+ * loadInternalImage(). Subclasses that can select a smaller
+ * source image (e.g. texture mipmaps) should override this.
+ *
+ * @param imageType	[in] Image type to load.
+ * @param reqSize	[in] Requested image size. (single dimension; 0 for largest)
+ * @param pImage	[out] Reference to rp_image_const_ptr to store the image in.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int RomData::loadInternalImageForSize(ImageType imageType, int reqSize, rp_image_const_ptr &pImage)
+{
+	// Size hint is ignored by the base class.
+	RP_UNUSED(reqSize);
+	return loadInternalImage(imageType, pImage);
+}
+
 /**
  * Load metadata properties.
  * Called by RomData::metaData() if the metadata hasn't been loaded yet.
@@ -797,15 +824,61 @@ int RomData::loadMetaData(void)
  * Get the ROM Fields object.
  * @return ROM Fields object.
  */
+/**
+ * Is the persistent parsed-metadata cache enabled?
+ * @return True if enabled; false if not.
+ */
+static inline bool isFieldCacheEnabled(void)
+{
+	return Config::instance()->getBoolConfigOption(Config::BoolConfig::Options_EnableMetadataCache);
+}
+
 const RomFields *RomData::fields(void) const
 {
 	RP_D(const RomData);
 	if (d->fields.empty()) {
+		RomData *const ncthis = const_cast<RomData*>(this);
+		RomDataPrivate *const ncd = ncthis->d_ptr;
+
+		// Check the persistent field cache first. A warm hit costs
+		// one stat() plus an mmap and skips the subclass parse
+		// (and for encrypted formats, the decryption) entirely.
+		// NOTE: On a miss, load() leaves d->fields untouched: the
+		// header (version + file identity) is validated before any
+		// deserialization, and cache files are written atomically.
+		if (isFieldCacheEnabled() && d->filename && !d->metaData) {
+			RomMetaData *const cachedMetaData = new RomMetaData();
+			if (FieldCache::load(d->filename, &ncd->fields, cachedMetaData) &&
+			    !d->fields.empty())
+			{
+				// Cache hit. Cached metadata properties ride along.
+				// NOTE: An empty metadata object could mean the
+				// entry was stored before the metadata was loaded,
+				// so keep d->metaData nullptr in that case and let
+				// loadMetaData() do the real parse if requested.
+				if (!cachedMetaData->empty()) {
+					ncd->metaData = cachedMetaData;
+				} else {
+					delete cachedMetaData;
+				}
+				return &d->fields;
+			}
+			delete cachedMetaData;
+		}
+
 		// Data has not been loaded.
 		// Load it now.
-		int ret = const_cast<RomData*>(this)->loadFieldData();
+		RP_TRACE_SCOPE2("RomData::loadFieldData", d->pRomDataInfo->className);
+		int ret = ncthis->loadFieldData();
 		if (ret < 0)
 			return nullptr;
+
+		// Store the parsed fields (and metadata, if it's already
+		// loaded) for the next consumer. Failures (uncacheable
+		// fields, no cache directory) are not fatal.
+		if (isFieldCacheEnabled() && d->filename) {
+			FieldCache::store(d->filename, &d->fields, d->metaData);
+		}
 	}
 	return &d->fields;
 }
@@ -823,6 +896,12 @@ const RomMetaData *RomData::metaData(void) const
 		int ret = const_cast<RomData*>(this)->loadMetaData();
 		if (ret < 0)
 			return nullptr;
+
+		// If the fields have already been parsed, refresh the
+		// cache entry so it includes the metadata properties.
+		if (isFieldCacheEnabled() && d->filename && !d->fields.empty()) {
+			FieldCache::store(d->filename, &d->fields, d->metaData);
+		}
 	}
 	return d->metaData;
 }
@@ -842,6 +921,8 @@ rp_image_const_ptr RomData::image(ImageType imageType) const
 	// TODO: Check supportedImageTypes()?
 
 	// Load the internal image.
+	RP_D(const RomData);
+	RP_TRACE_SCOPE2("RomData::loadInternalImage", d->pRomDataInfo->className);
 	rp_image_const_ptr img;
 	int ret = const_cast<RomData*>(this)->loadInternalImage(imageType, img);
 
@@ -853,6 +934,43 @@ rp_image_const_ptr RomData::image(ImageType imageType) const
 	return (ret == 0) ? img : nullptr;
 }
 
+/**
+ * Get an internal image from the ROM, with a size hint.
+ *
+ * If the subclass can select a smaller source image for the
+ * requested size (e.g. texture mipmaps), it will do so here.
+ * The returned image may still be any size; the caller is
+ * responsible for the final rescale.
+ *
+ * @param imageType Image type to load.
+ * @param reqSize Requested image size. (single dimension; 0 for largest)
+ * @return Internal image, or nullptr if the ROM doesn't have one.
+ */
+rp_image_const_ptr RomData::image(ImageType imageType, int reqSize) const
+{
+	assert(imageType >= IMG_INT_MIN && imageType <= IMG_INT_MAX);
+	if (imageType < IMG_INT_MIN || imageType > IMG_INT_MAX) {
+		// ImageType is out of range.
+		return nullptr;
+	}
+
+	if (reqSize <= 0) {
+		// No size hint. Use the regular image loader.
+		return image(imageType);
+	}
+
+	// Load the internal image with the size hint.
+	rp_image_const_ptr img;
+	int ret = const_cast<RomData*>(this)->loadInternalImageForSize(imageType, reqSize, img);
+
+	// SANITY CHECK: If loadInternalImageForSize() returns 0,
+	// img *must* be valid. Otherwise, it must be nullptr.
+	assert((ret == 0 && (bool)img) ||
+	       (ret != 0 && !img));
+
+	return (ret == 0) ? img : nullptr;
+}
+
 /**
  * Get an internal image mipmap from the texture.
  *
@@ -981,6 +1099,25 @@ IconAnimDataConstPtr RomData::iconAnimData(void) const
 	return nullptr;
 }
 
+/**
+ * Get a content identifier for this ROM image.
+ *
+ * The content ID identifies the *content*, not the file, so two
+ * dumps of the same title in different formats (e.g. ISO, WBFS,
+ * GCZ, and RVZ of one GameCube disc) return the same string.
+ * It's typically built from the title ID or disc ID in the
+ * ROM header. The returned string is suitable for use as a
+ * cache key component. (see LibCacheCommon::getContentIdCacheKey())
+ *
+ * @return Content ID, or empty string if the subclass doesn't
+ * have a stable content identifier.
+ */
+std::string RomData::contentId(void) const
+{
+	// No content identifier by default.
+	return {};
+}
+
 /**
  * Does this ROM image have "dangerous" permissions?
  *
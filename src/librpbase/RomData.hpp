@@ -437,6 +437,24 @@ public:
 	 */
 	virtual int loadInternalMipmap(int mipmapLevel, LibRpTexture::rp_image_const_ptr &pImage);
 
+public:
+	// NOTE: This function needs to be public because it might be
+	// called by RomData subclasses that own other RomData subclasses.
+	/**
+	 * Load an internal image, with a size hint.
+	 * Called by RomData::image() if a size hint was specified.
+	 *
+	 * The default implementation ignores the size hint and calls
+	 * loadInternalImage(). Subclasses that can select a smaller
+	 * source image (e.g. texture mipmaps) should override this.
+	 *
+	 * @param imageType	[in] Image type to load.
+	 * @param reqSize	[in] Requested image size. (single dimension; 0 for largest)
+	 * @param pImage	[out] Reference to rp_image_const_ptr to store the image in.
+	 * @return 0 on success; negative POSIX error code on error.
+	 */
+	virtual int loadInternalImageForSize(ImageType imageType, int reqSize, LibRpTexture::rp_image_const_ptr &pImage);
+
 public:
 	/**
 	 * Get the ROM Fields object.
@@ -461,6 +479,21 @@ public:
 	RP_LIBROMDATA_PUBLIC
 	LibRpTexture::rp_image_const_ptr image(ImageType imageType) const;
 
+	/**
+	 * Get an internal image from the ROM, with a size hint.
+	 *
+	 * If the subclass can select a smaller source image for the
+	 * requested size (e.g. texture mipmaps), it will do so here.
+	 * The returned image may still be any size; the caller is
+	 * responsible for the final rescale.
+	 *
+	 * @param imageType Image type to load.
+	 * @param reqSize Requested image size. (single dimension; 0 for largest)
+	 * @return Internal image, or nullptr if the ROM doesn't have one.
+	 */
+	RP_LIBROMDATA_PUBLIC
+	LibRpTexture::rp_image_const_ptr image(ImageType imageType, int reqSize) const;
+
 	/**
 	 * Get an internal image mipmap from the texture.
 	 *
@@ -548,6 +581,22 @@ public:
 	 */
 	virtual IconAnimDataConstPtr iconAnimData(void) const;
 
+public:
+	/**
+	 * Get a content identifier for this ROM image.
+	 *
+	 * The content ID identifies the *content*, not the file, so two
+	 * dumps of the same title in different formats (e.g. ISO, WBFS,
+	 * GCZ, and RVZ of one GameCube disc) return the same string.
+	 * It's typically built from the title ID or disc ID in the
+	 * ROM header. The returned string is suitable for use as a
+	 * cache key component. (see LibCacheCommon::getContentIdCacheKey())
+	 *
+	 * @return Content ID, or empty string if the subclass doesn't
+	 * have a stable content identifier.
+	 */
+	virtual std::string contentId(void) const;
+
 public:
 	/**
 	 * Does this ROM image have "dangerous" permissions?
@@ -179,6 +179,24 @@ public: \
 	 */ \
 	int loadInternalMipmap(int mipmapLevel, LibRpTexture::rp_image_const_ptr &pImage) final;
 
+/**
+ * RomData subclass function declaration for loading internal images with a size hint.
+ *
+ * NOTE: This function needs to be public because it might be
+ * called by RomData subclasses that own other RomData subclasses.
+ */
+#define ROMDATA_DECL_IMGINTFORSIZE() \
+public: \
+	/** \
+	 * Load an internal image, with a size hint. \
+	 * Called by RomData::image() if a size hint was specified. \
+	 * @param imageType	[in] Image type to load. \
+	 * @param reqSize	[in] Requested image size. (single dimension; 0 for largest) \
+	 * @param pImage	[out] Reference to rp_image_const_ptr to store the image in. \
+	 * @return 0 on success; negative POSIX error code on error. \
+	 */ \
+	int loadInternalImageForSize(ImageType imageType, int reqSize, LibRpTexture::rp_image_const_ptr &pImage) final;
+
 /**
  * RomData subclass function declaration for obtaining URLs for external images.
  */
@@ -216,6 +234,21 @@ public: \
 	 */ \
 	LibRpBase::IconAnimDataConstPtr iconAnimData(void) const final;
 
+/**
+ * RomData subclass function declaration for a content identifier.
+ */
+#define ROMDATA_DECL_CONTENTID() \
+public: \
+	/** \
+	 * Get a content identifier for this ROM image. \
+	 * \
+	 * The content ID identifies the *content*, not the file, so two \
+	 * dumps of the same title in different formats return the same string. \
+	 * \
+	 * @return Content ID, or empty string if not available. \
+	 */ \
+	std::string contentId(void) const final;
+
 /**
  * RomData subclass function declaration for indicating "dangerous" permissions.
  */
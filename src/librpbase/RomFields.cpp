@@ -11,6 +11,9 @@
 
 #include "libi18n/i18n.h"
 
+// librptext
+#include "librptext/utf8_strlen.hpp"
+
 // C++ STL classes
 using std::string;
 using std::unique_ptr;
@@ -20,6 +23,70 @@ using namespace LibRpText;
 
 namespace LibRpBase {
 
+// RomFields::Field::arena flag bits
+enum ArenaFlag : uint8_t {
+	ARENA_NAME	= (1U << 0),	// Field::name is arena-backed
+	ARENA_STR	= (1U << 1),	// Field::data.str is arena-backed
+};
+
+/**
+ * String arena for field names and RFT_STRING values.
+ *
+ * Strings are bump-allocated out of fixed-size chunks and freed
+ * wholesale when the owning RomFields object is destroyed, so
+ * field construction doesn't hit the heap allocator per string.
+ */
+class StringArena
+{
+	public:
+		StringArena()
+			: cur(nullptr)
+			, remaining(0)
+		{ }
+
+	private:
+		RP_DISABLE_COPY(StringArena)
+
+	public:
+		/**
+		 * Duplicate a string into the arena.
+		 * @param str Source string
+		 * @return Arena-backed copy, or nullptr if str is nullptr.
+		 */
+		char *dup(const char *str)
+		{
+			if (!str)
+				return nullptr;
+
+			const size_t len = strlen(str) + 1;
+			char *p;
+			if (len >= chunk_size) {
+				// Oversized string: Give it a dedicated allocation.
+				// (Doesn't touch the current bump chunk.)
+				chunks.emplace_back(new char[len]);
+				p = chunks.rbegin()->get();
+			} else {
+				if (len > remaining) {
+					// Not enough space left in the current chunk.
+					chunks.emplace_back(new char[chunk_size]);
+					cur = chunks.rbegin()->get();
+					remaining = chunk_size;
+				}
+				p = cur;
+				cur += len;
+				remaining -= len;
+			}
+			memcpy(p, str, len);
+			return p;
+		}
+
+	private:
+		static constexpr size_t chunk_size = 4096;
+		std::vector<unique_ptr<char[]> > chunks;
+		char *cur;		// Bump pointer within the current chunk.
+		size_t remaining;	// Bytes remaining in the current chunk.
+};
+
 class RomFieldsPrivate
 {
 	public:
@@ -29,9 +96,33 @@ class RomFieldsPrivate
 		RP_DISABLE_COPY(RomFieldsPrivate)
 
 	public:
+		// String arena backing field names and RFT_STRING values.
+		// NOTE: Must outlive the fields vector.
+		StringArena arena;
+
 		// ROM field structs.
 		vector<RomFields::Field> fields;
 
+		/**
+		 * Add a field with an arena-backed name.
+		 * desc and data must be set by the caller.
+		 * @param name Field name
+		 * @param type Field type
+		 * @param flags Field flags
+		 * @return Reference to the new field.
+		 */
+		RomFields::Field &addField(const char *name, RomFields::RomFieldType type, unsigned int flags)
+		{
+			fields.emplace_back();
+			RomFields::Field &field = *(fields.rbegin());
+			field.name = arena.dup(name);
+			field.type = type;
+			field.tabIdx = tabIdx;
+			field.arena = ARENA_NAME;
+			field.flags = flags;
+			return field;
+		}
+
 		// Tab names.
 		vector<string> tabNames;
 
@@ -55,7 +146,11 @@ RomFieldsPrivate::RomFieldsPrivate()
 
 RomFields::Field::~Field()
 {
-	free(const_cast<char*>(name));
+	// Arena-backed strings are freed wholesale by the
+	// owning RomFields object; don't free them here.
+	if (!(arena & ARENA_NAME)) {
+		free(const_cast<char*>(name));
+	}
 
 	switch (type) {
 		case RomFields::RFT_INVALID:
@@ -70,7 +165,9 @@ RomFields::Field::~Field()
 			break;
 
 		case RomFields::RFT_STRING:
-			free(const_cast<char*>(data.str));
+			if (!(arena & ARENA_STR)) {
+				free(const_cast<char*>(data.str));
+			}
 			break;
 		case RomFields::RFT_BITFIELD:
 			delete const_cast<vector<string>*>(desc.bitfield.names);
@@ -85,6 +182,7 @@ RomFields::Field::~Field()
 			if (flags & RomFields::RFT_LISTDATA_ICONS) {
 				delete const_cast<RomFields::ListDataIcons_t*>(data.list_data.mxd.icons);
 			}
+			delete[] const_cast<uint16_t*>(desc.list_data.col_disp_widths);
 			break;
 		case RomFields::RFT_AGE_RATINGS:
 			delete const_cast<RomFields::age_ratings_t*>(data.age_ratings);
@@ -107,6 +205,7 @@ RomFields::Field::Field(const Field &other)
 	: name(other.name ? strdup(other.name) : nullptr)
 	, type(other.type)
 	, tabIdx(other.tabIdx)
+	, arena(0)	// Copies are always heap-owned.
 	, flags(other.flags)
 {
 	assert(other.name != nullptr);
@@ -151,6 +250,27 @@ RomFields::Field::Field(const Field &other)
 				// No icons. Copy checkboxes.
 				this->data.list_data.mxd.checkboxes = other.data.list_data.mxd.checkboxes;
 			}
+			if (other.desc.list_data.col_disp_widths) {
+				// Precomputed column widths: one entry per column.
+				size_t col_count = 0;
+				if (this->desc.list_data.names) {
+					col_count = this->desc.list_data.names->size();
+				} else if (this->data.list_data.data.single &&
+				           !this->data.list_data.data.single->empty())
+				{
+					col_count = this->data.list_data.data.single->at(0).size();
+				}
+				if (col_count > 0) {
+					uint16_t *const widths = new uint16_t[col_count];
+					memcpy(widths, other.desc.list_data.col_disp_widths,
+						col_count * sizeof(uint16_t));
+					this->desc.list_data.col_disp_widths = widths;
+				} else {
+					this->desc.list_data.col_disp_widths = nullptr;
+				}
+			} else {
+				this->desc.list_data.col_disp_widths = nullptr;
+			}
 			break;
 		case RFT_DATETIME:
 			this->data.date_time = other.data.date_time;
@@ -203,6 +323,10 @@ RomFields::Field& RomFields::Field::operator=(Field other)
 	memcpy(&this->desc, &other.desc, sizeof(this->desc));
 	memcpy(&this->data, &other.data, sizeof(this->data));
 
+	// `other` is a by-value copy, so its strings are heap-owned.
+	// Our name is untouched; our old data.str was just replaced.
+	this->arena &= ARENA_NAME;
+
 	// Reset the other object.
 	other.name = nullptr;
 	other.type = RFT_INVALID;
@@ -221,6 +345,7 @@ RomFields::Field::Field(Field &&other) noexcept
 	: name(other.name)
 	, type(other.type)
 	, tabIdx(other.tabIdx)
+	, arena(other.arena)
 	, flags(other.flags)
 {
 	// NOTE: The previous implementation used copy-on-swap, which worked
@@ -239,6 +364,7 @@ RomFields::Field::Field(Field &&other) noexcept
 	// Reset the other object.
 	other.name = nullptr;
 	other.type = RFT_INVALID;
+	other.arena = 0;
 }
 
 /**
@@ -261,6 +387,7 @@ RomFields::Field& RomFields::Field::operator=(Field &&other) noexcept
 	this->name = other.name;
 	this->type = other.type;
 	this->tabIdx = other.tabIdx;
+	this->arena = other.arena;
 	this->flags = other.flags;
 
 	assert(other.type != RFT_INVALID);
@@ -271,6 +398,7 @@ RomFields::Field& RomFields::Field::operator=(Field &&other) noexcept
 	// TODO: Is this needed for move assignment?
 	other.name = nullptr;
 	other.type = RFT_INVALID;
+	other.arena = 0;
 	return *this;
 }
 
@@ -928,8 +1056,7 @@ int RomFields::addField_string(const char *name, const char *str, unsigned int f
 
 	// RFT_STRING
 	RP_D(RomFields);
-	d->fields.emplace_back(name, RFT_STRING, d->tabIdx, flags);
-	Field &field = *(d->fields.rbegin());
+	Field &field = d->addField(name, RFT_STRING, flags);
 
 	char *const nstr = (str ? strdup(str) : nullptr);
 	field.data.str = nstr;
@@ -941,6 +1068,42 @@ int RomFields::addField_string(const char *name, const char *str, unsigned int f
 	return static_cast<int>(d->fields.size() - 1);
 }
 
+/**
+ * Add string field data.
+ * NOTE: The string's length is used directly, so this avoids
+ * the strlen() that the const char* overload would need.
+ * @param name Field name.
+ * @param str String.
+ * @param flags Formatting flags.
+ * @return Field index.
+ */
+int RomFields::addField_string(const char *name, const std::string &str, unsigned int flags)
+{
+	assert(name != nullptr);
+	if (!name)
+		return -1;
+
+	// RFT_STRING
+	RP_D(RomFields);
+	Field &field = d->addField(name, RFT_STRING, flags);
+
+	// Copy the string using the known length.
+	// NOTE: The field still stores a NULL-terminated C string, so
+	// anything after an embedded NULL is not visible, same as the
+	// const char* overload.
+	char *const nstr = static_cast<char*>(malloc(str.size() + 1));
+	field.data.str = nstr;
+	if (nstr) {
+		memcpy(nstr, str.c_str(), str.size() + 1);
+
+		// Handle string trimming flags.
+		if (flags & STRF_TRIM_END) {
+			trimEnd(nstr);
+		}
+	}
+	return static_cast<int>(d->fields.size() - 1);
+}
+
 /**
  * Add string field data using a numeric value.
  * @param name Field name.
@@ -956,23 +1119,26 @@ int RomFields::addField_string_numeric(const char *name, uint32_t val, Base base
 	if (!name)
 		return -1;
 
-	const char *fmtstr;
+	// Format the value directly. (no printf format parsing)
+	string str;
 	switch (base) {
 		case Base::Dec:
 		default:
-			fmtstr = "%0*u";
+			str = fmt_dec_pad(val, digits);
 			break;
 		case Base::Hex:
-			fmtstr = (!(flags & STRF_HEX_LOWER)) ? "0x%0*X" : "0x%0*x";
+			str = "0x";
+			str += fmt_hex_pad(val, digits, !!(flags & STRF_HEX_LOWER));
 			break;
-		case Base::Oct:
-			fmtstr = "0%0*o";
+		case Base::Oct: {
+			// Octal is rare enough that snprintf() is fine here.
+			char buf[64];
+			snprintf(buf, sizeof(buf), "0%0*o", digits, val);
+			str.assign(buf);
 			break;
+		}
 	}
-
-	char buf[64];
-	snprintf(buf, sizeof(buf), fmtstr, digits, val);
-	return addField_string(name, buf, flags);
+	return addField_string(name, str, flags);
 }
 
 /**
@@ -1090,8 +1256,7 @@ int RomFields::addField_bitfield(const char *name,
 
 	// RFT_BITFIELD
 	RP_D(RomFields);
-	d->fields.emplace_back(name, RFT_BITFIELD, d->tabIdx, 0);
-	Field &field = *(d->fields.rbegin());
+	Field &field = d->addField(name, RFT_BITFIELD, 0);
 
 	field.desc.bitfield.names = bit_names;
 	field.desc.bitfield.elemsPerRow = elemsPerRow;
@@ -1133,8 +1298,7 @@ int RomFields::addField_listData(const char *name, const AFLD_PARAMS *params)
 
 	// RFT_LISTDATA
 	RP_D(RomFields);
-	d->fields.emplace_back(name, RFT_LISTDATA, d->tabIdx, params->flags);
-	Field &field = *(d->fields.rbegin());
+	Field &field = d->addField(name, RFT_LISTDATA, params->flags);
 
 	assert(params->rows_visible >= 0);
 	if (params->rows_visible >= 0) {
@@ -1167,6 +1331,77 @@ int RomFields::addField_listData(const char *name, const AFLD_PARAMS *params)
 			field.flags &= ~RFT_LISTDATA_ICONS;
 		}
 	}
+
+	// Precompute per-column display widths for single-language lists.
+	// Text-based consumers can use these for column sizing instead of
+	// re-measuring every cell. (Pixel-based consumers can still use
+	// them as relative sizing hints.)
+	// NOTE: Not possible for RFT_LISTDATA_MULTI, since the widths
+	// depend on the selected language.
+	field.desc.list_data.col_disp_widths = nullptr;
+	if (!(flags & RFT_LISTDATA_MULTI)) {
+		size_t col_count = 0;
+		if (params->headers) {
+			col_count = params->headers->size();
+		} else if (params->data.single && !params->data.single->empty()) {
+			col_count = params->data.single->at(0).size();
+		}
+		if (col_count > 0) {
+			uint16_t *const widths = new uint16_t[col_count]();
+			// Measure the widest line of a cell. (Cells may be multi-line.)
+			auto measure = [](const string &str) -> size_t {
+				if (str.find('\n') == string::npos) {
+					return utf8_disp_strlen(str);
+				}
+				size_t max_sz = 0;
+				size_t prev = 0;
+				do {
+					const size_t pos = str.find('\n', prev);
+					const size_t len = ((pos != string::npos) ? pos : str.size()) - prev;
+					const size_t sz = utf8_disp_strlen(&str[prev], len);
+					if (sz > max_sz) {
+						max_sz = sz;
+					}
+					prev = (pos != string::npos) ? (pos + 1) : string::npos;
+				} while (prev != string::npos);
+				return max_sz;
+			};
+			auto update = [widths, &measure](size_t col, const string &str) {
+				size_t sz = measure(str);
+				if (sz > 0xFFFFU) {
+					sz = 0xFFFFU;
+				}
+				if (sz > widths[col]) {
+					widths[col] = static_cast<uint16_t>(sz);
+				}
+			};
+
+			if (params->headers) {
+				size_t col = 0;
+				for (const string &header : *(params->headers)) {
+					update(col++, header);
+				}
+			}
+			if (params->data.single) {
+				const uint32_t is_timestamp = params->col_attrs.is_timestamp;
+				for (const vector<string> &row : *(params->data.single)) {
+					size_t col = 0;
+					for (const string &cell : row) {
+						if (col >= col_count)
+							break;
+						// Skip timestamp columns: the cells contain
+						// binary time_t values, not display strings.
+						if (col >= 32 || !(is_timestamp & (1U << col))) {
+							update(col, cell);
+						}
+						col++;
+					}
+				}
+			}
+			field.desc.list_data.col_disp_widths = widths;
+		}
+	}
+
 	field.tabIdx = d->tabIdx;
 	return static_cast<int>(d->fields.size() - 1);
 }
@@ -1186,8 +1421,7 @@ int RomFields::addField_dateTime(const char *name, time_t date_time, unsigned in
 
 	// RFT_DATETIME
 	RP_D(RomFields);
-	d->fields.emplace_back(name, RFT_DATETIME, d->tabIdx, flags);
-	Field &field = *(d->fields.rbegin());
+	Field &field = d->addField(name, RFT_DATETIME, flags);
 
 	field.data.date_time = date_time;
 	return static_cast<int>(d->fields.size() - 1);
@@ -1208,8 +1442,7 @@ int RomFields::addField_ageRatings(const char *name, const age_ratings_t &age_ra
 
 	// RFT_AGE_RATINGS
 	RP_D(RomFields);
-	d->fields.emplace_back(name, RFT_AGE_RATINGS, d->tabIdx, 0);
-	Field &field = *(d->fields.rbegin());
+	Field &field = d->addField(name, RFT_AGE_RATINGS, 0);
 
 	field.data.age_ratings = new age_ratings_t(age_ratings);
 	field.tabIdx = d->tabIdx;
@@ -1232,8 +1465,7 @@ int RomFields::addField_dimensions(const char *name, int dimX, int dimY, int dim
 
 	// RFT_DIMENSIONS
 	RP_D(RomFields);
-	d->fields.emplace_back(name, RFT_DIMENSIONS, d->tabIdx, 0);
-	Field &field = *(d->fields.rbegin());
+	Field &field = d->addField(name, RFT_DIMENSIONS, 0);
 
 	field.data.dimensions[0] = dimX;
 	field.data.dimensions[1] = dimY;
@@ -1258,8 +1490,7 @@ int RomFields::addField_string_multi(const char *name, const StringMultiMap_t *s
 
 	// RFT_STRING_MULTI
 	RP_D(RomFields);
-	d->fields.emplace_back(name, RFT_STRING_MULTI, d->tabIdx, flags);
-	Field &field = *(d->fields.rbegin());
+	Field &field = d->addField(name, RFT_STRING_MULTI, flags);
 
 	if (d->def_lc == 0) {
 		d->def_lc = def_lc;
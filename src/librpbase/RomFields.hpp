@@ -270,6 +270,7 @@ class RomFields
 				: name(nullptr)
 				, type(RFT_INVALID)
 				, tabIdx(0)
+				, arena(0)
 				, flags(0)
 			{
 				// NOTE: desc/data are not zeroed here.
@@ -290,6 +291,7 @@ class RomFields
 				: name(name ? strdup(name) : nullptr)
 				, type(type)
 				, tabIdx(tabIdx)
+				, arena(0)
 				, flags(flags)
 			{
 				// NOTE: desc/data are not zeroed here.
@@ -315,6 +317,7 @@ class RomFields
 			const char *name;	// Field name
 			RomFieldType type;	// ROM field type
 			uint8_t tabIdx;		// Tab index (0 for default)
+			uint8_t arena;		// Arena-backed pointer flags (RomFields internal)
 			unsigned int flags;	// Flags (type-specific)
 
 			inline bool isValid(void) const
@@ -344,6 +347,16 @@ class RomFields
 
 					// Per-column attributes
 					ListDataColAttrs_t col_attrs;
+
+					// Precomputed per-column display widths, in
+					// monospace cells. (see LibRpText::utf8_disp_strlen)
+					// Filled in by addField_listData() for
+					// single-language lists; nullptr for
+					// RFT_LISTDATA_MULTI. Timestamp columns only
+					// count the header, since the cells contain
+					// binary time_t values that are formatted by
+					// the consumer.
+					const uint16_t *col_disp_widths;
 				} list_data;
 			} desc;
 
@@ -619,15 +632,14 @@ class RomFields
 
 		/**
 		 * Add string field data.
+		 * NOTE: The string's length is used directly, so this avoids
+		 * the strlen() that the const char* overload would need.
 		 * @param name Field name.
 		 * @param str String.
 		 * @param flags Formatting flags.
 		 * @return Field index.
 		 */
-		int addField_string(const char *name, const std::string &str, unsigned int flags = 0)
-		{
-			return addField_string(name, str.c_str(), flags);
-		}
+		int addField_string(const char *name, const std::string &str, unsigned int flags = 0);
 
 		enum class Base {
 			Dec,	// Decimal (Base 10)
@@ -12,6 +12,7 @@
 
 #include "stdafx.h"
 #include "RomMetaData.hpp"
+#include "StringInternPool.hpp"
 
 // Other rom-properties libraries
 using namespace LibRpText;
@@ -186,9 +187,13 @@ RomMetaData::MetaData *RomMetaDataPrivate::addProperty(Property name)
 		// Already added. Overwrite it.
 		pMetaData = &metaData[(int)map_metaData[(int)name]];
 		// If a string is present, delete it.
+		// (Interned strings are owned by StringInternPool.)
 		if (pMetaData->type == PropertyType::String) {
-			delete pMetaData->data.str;
+			if (!pMetaData->interned) {
+				delete pMetaData->data.str;
+			}
 			pMetaData->data.str = nullptr;
+			pMetaData->interned = false;
 		}
 	} else {
 		// Not added yet. Create a new one.
@@ -216,6 +221,7 @@ RomMetaData::MetaData *RomMetaDataPrivate::addProperty(Property name)
 RomMetaData::MetaData::MetaData()
 	: name(Property::Invalid)
 	, type(PropertyType::Invalid)
+	, interned(false)
 {
 	data.iptrvalue = 0;
 }
@@ -229,6 +235,7 @@ RomMetaData::MetaData::MetaData()
 RomMetaData::MetaData::MetaData(Property name, PropertyType type)
 	: name(name)
 	, type(type)
+	, interned(false)
 {
 	data.iptrvalue = 0;
 }
@@ -256,7 +263,10 @@ RomMetaData::MetaData::~MetaData()
 			break;
 
 		case PropertyType::String:
-			delete const_cast<string*>(this->data.str);
+			// Interned strings are owned by StringInternPool.
+			if (!this->interned) {
+				delete const_cast<string*>(this->data.str);
+			}
 			break;
 	}
 }
@@ -274,6 +284,7 @@ RomMetaData::MetaData::MetaData(const MetaData &other)
 	assert(other.name != Property::Invalid);
 	this->name = other.name;
 	this->type = other.type;
+	this->interned = other.interned;
 
 	switch (other.type) {
 		default:
@@ -296,9 +307,14 @@ RomMetaData::MetaData::MetaData(const MetaData &other)
 			break;
 
 		case PropertyType::String:
-			this->data.str = (other.data.str)
-				? new string(*other.data.str)
-				: nullptr;
+			if (other.interned) {
+				// Interned strings are shared, not copied.
+				this->data.str = other.data.str;
+			} else {
+				this->data.str = (other.data.str)
+					? new string(*other.data.str)
+					: nullptr;
+			}
 			break;
 	}
 }
@@ -316,9 +332,11 @@ RomMetaData::MetaData& RomMetaData::MetaData::operator=(MetaData other)
 	// Copy data, then reset the other MetaData object.
 	this->name = other.name;
 	this->type = other.type;
+	this->interned = other.interned;
 	memcpy(&this->data, &other.data, sizeof(this->data));
 	other.name = Property::Invalid;
 	other.type = PropertyType::Invalid;
+	other.interned = false;
 	return *this;
 }
 
@@ -333,11 +351,13 @@ RomMetaData::MetaData& RomMetaData::MetaData::operator=(MetaData other)
 RomMetaData::MetaData::MetaData(MetaData &&other) noexcept
 	: name(other.name)
 	, type(other.type)
+	, interned(other.interned)
 {
 	// Copy data, then reset the other MetaData object.
 	memcpy(&this->data, &other.data, sizeof(this->data));
 	other.name = Property::Invalid;
 	other.type = PropertyType::Invalid;
+	other.interned = false;
 }
 
 /**
@@ -353,9 +373,11 @@ RomMetaData::MetaData& RomMetaData::MetaData::operator=(MetaData &&other) noexce
 	// Copy data, then reset the other MetaData object.
 	this->name = other.name;
 	this->type = other.type;
+	this->interned = other.interned;
 	memcpy(&this->data, &other.data, sizeof(this->data));
 	other.name = Property::Invalid;
 	other.type = PropertyType::Invalid;
+	other.interned = false;
 	return *this;
 }
 
@@ -377,6 +399,131 @@ RomMetaData::~RomMetaData()
 
 /** Metadata accessors. **/
 
+/**
+ * Get the name of a metadata property.
+ * The name matches the Property enum identifier, e.g. "Title".
+ * @param name Property
+ * @return Property name, or nullptr if the property is invalid.
+ */
+const char *RomMetaData::getPropertyName(Property name)
+{
+	// Property names.
+	// NOTE: Matches the Property enum.
+	static const array<const char*, (int)Property::PropertyCount> PropertyNameMap = {{
+		nullptr,	// Empty
+
+		// Audio
+		"BitRate",
+		"Channels",
+		"Duration",
+		"Genre",
+		"SampleRate",
+		"TrackNumber",
+		"ReleaseYear",
+		"Comment",
+		"Artist",
+		"Album",
+		"AlbumArtist",
+		"Composer",
+		"Lyricist",
+
+		// Document
+		"Author",
+		"Title",
+		"Subject",
+		"Generator",
+		"PageCount",
+		"WordCount",
+		"LineCount",
+		"Language",
+		"Copyright",
+		"Publisher",
+		"CreationDate",
+		"Keywords",
+
+		// Media
+		"Width",
+		"Height",
+		"AspectRatio",
+		"FrameRate",
+
+		// Images
+		"Manufacturer",
+		"Model",
+		"ImageDateTime",
+		"ImageOrientation",
+		"PhotoFlash",
+		"PhotoPixelXDimension",
+		"PhotoPixelYDimension",
+		"PhotoDateTimeOriginal",
+		"PhotoFocalLength",
+		"PhotoFocalLengthIn35mmFilm",
+		"PhotoExposureTime",
+		"PhotoFNumber",
+		"PhotoApertureValue",
+		"PhotoExposureBiasValue",
+		"PhotoWhiteBalance",
+		"PhotoMeteringMode",
+		"PhotoISOSpeedRatings",
+		"PhotoSaturation",
+		"PhotoSharpness",
+		"PhotoGpsLatitude",
+		"PhotoGpsLongitude",
+		"PhotoGpsAltitude",
+
+		// Translations
+		"TranslationUnitsTotal",
+		"TranslationUnitsWithTranslation",
+		"TranslationUnitsWithDraftTranslation",
+		"TranslationLastAuthor",
+		"TranslationLastUpDate",
+		"TranslationTemplateDate",
+
+		// Origin
+		"OriginUrl",
+		"OriginEmailSubject",
+		"OriginEmailSender",
+		"OriginEmailMessageId",
+
+		// Audio
+		"DiscNumber",
+		"Location",
+		"Performer",
+		"Ensemble",
+		"Arranger",
+		"Conductor",
+		"Opus",
+
+		// Other
+		"Label",
+		"Compilation",
+		"License",
+
+		// Added in KF5 5.48
+		"Rating",
+		"Lyrics",
+
+		// Replay gain (KF5 5.51)
+		"ReplayGainAlbumPeak",
+		"ReplayGainAlbumGain",
+		"ReplayGainTrackPeak",
+		"ReplayGainTrackGain",
+
+		// Added in KF5 5.53
+		"Description",
+	}};
+	static_assert(PropertyNameMap.size() == (size_t)Property::PropertyCount,
+		      "PropertyNameMap needs to be updated!");
+
+	assert(name > Property::Empty);
+	assert(name < Property::PropertyCount);
+	if (name <= Property::Empty || name >= Property::PropertyCount) {
+		return nullptr;
+	}
+
+	return PropertyNameMap[static_cast<int>(name)];
+}
+
 /**
  * Get the number of metadata properties.
  * @return Number of metadata properties.
@@ -499,7 +646,13 @@ int RomMetaData::addMetaData_metaData(const RomMetaData *other)
 			case PropertyType::String:
 				// TODO: Don't add a property if the string value is nullptr?
 				assert(pSrc.data.str != nullptr);
-				pDest->data.str = (pSrc.data.str ? new string(*pSrc.data.str) : nullptr);
+				if (pSrc.interned) {
+					// Interned strings are shared, not copied.
+					pDest->data.str = pSrc.data.str;
+					pDest->interned = true;
+				} else {
+					pDest->data.str = (pSrc.data.str ? new string(*pSrc.data.str) : nullptr);
+				}
 				break;
 			case PropertyType::Timestamp:
 				pDest->data.timestamp = pSrc.data.timestamp;
@@ -596,35 +749,34 @@ int RomMetaData::addMetaData_string(Property name, const char *str, unsigned int
 		return -1;
 	}
 
-	string *const nstr = new string(str);
+	string nstr(str);
 	// Trim the string if requested.
-	if (nstr && (flags & STRF_TRIM_END)) {
-		trimEnd(*nstr);
+	if (flags & STRF_TRIM_END) {
+		trimEnd(nstr);
 	}
-	if (nstr->empty()) {
+	if (nstr.empty()) {
 		// String is now empty. Ignore it.
-		delete nstr;
 		return -1;
 	}
 
 	RP_D(RomMetaData);
 	MetaData *const pMetaData = d->addProperty(name);
 	assert(pMetaData != nullptr);
-	if (!pMetaData) {
-		delete nstr;
+	if (!pMetaData)
 		return -1;
-	}
 
 	// Make sure this is a string property.
 	assert(pMetaData->type == PropertyType::String);
 	if (pMetaData->type != PropertyType::String) {
 		// TODO: Delete the property in this case?
 		pMetaData->data.iptrvalue = 0;
-		delete nstr;
 		return -1;
 	}
 
-	pMetaData->data.str = nstr;
+	// Intern the string: the same publisher/genre/system values
+	// recur across thousands of files in an indexing run.
+	pMetaData->data.str = StringInternPool::intern(nstr);
+	pMetaData->interned = true;
 	return static_cast<int>(d->map_metaData[(int)name]);
 }
 
@@ -646,35 +798,34 @@ int RomMetaData::addMetaData_string(Property name, const string &str, unsigned i
 		return -1;
 	}
 
-	string *const nstr = new string(str);
+	string nstr(str);
 	// Trim the string if requested.
-	if (nstr && (flags & STRF_TRIM_END)) {
-		trimEnd(*nstr);
+	if (flags & STRF_TRIM_END) {
+		trimEnd(nstr);
 	}
-	if (nstr->empty()) {
+	if (nstr.empty()) {
 		// String is now empty. Ignore it.
-		delete nstr;
 		return -1;
 	}
 
 	RP_D(RomMetaData);
 	MetaData *const pMetaData = d->addProperty(name);
 	assert(pMetaData != nullptr);
-	if (!pMetaData) {
-		delete nstr;
+	if (!pMetaData)
 		return -1;
-	}
 
 	// Make sure this is a string property.
 	assert(pMetaData->type == PropertyType::String);
 	if (pMetaData->type != PropertyType::String) {
 		// TODO: Delete the property in this case?
 		pMetaData->data.iptrvalue = 0;
-		delete nstr;
 		return -1;
 	}
 
-	pMetaData->data.str = nstr;
+	// Intern the string: the same publisher/genre/system values
+	// recur across thousands of files in an indexing run.
+	pMetaData->data.str = StringInternPool::intern(nstr);
+	pMetaData->interned = true;
 	return static_cast<int>(d->map_metaData[(int)name]);
 }
 
@@ -168,6 +168,7 @@ class RomMetaData
 		struct MetaData {
 			Property name;		// Property name.
 			PropertyType type;	// Property type.
+			bool interned;		// String value is owned by StringInternPool.
 
 			/**
 			 * Initialize a RomMetaData::MetaData object.
@@ -235,6 +236,15 @@ class RomMetaData
 	public:
 		/** Metadata accessors. **/
 
+		/**
+		 * Get the name of a metadata property.
+		 * The name matches the Property enum identifier, e.g. "Title".
+		 * @param name Property
+		 * @return Property name, or nullptr if the property is invalid.
+		 */
+		RP_LIBROMDATA_PUBLIC
+		static const char *getPropertyName(Property name);
+
 		/**
 		 * Get the number of metadata properties.
 		 * @return Number of metadata properties.
@@ -0,0 +1,89 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase)                        *
+ * StringInternPool.cpp: Process-wide string intern pool.                  *
+ *                                                                         *
+ * Copyright (c) 2016-2024 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "StringInternPool.hpp"
+
+// librpthreads
+#include "librpthreads/SharedMutex.hpp"
+using LibRpThreads::ReadLocker;
+using LibRpThreads::SharedMutex;
+using LibRpThreads::WriteLocker;
+
+// C++ STL classes
+using std::string;
+using std::unordered_set;
+
+namespace LibRpBase { namespace StringInternPool {
+
+// The pool itself.
+// unordered_set guarantees pointer stability for its elements,
+// so returned pointers stay valid as the pool grows.
+static unordered_set<string> set_pool;
+static SharedMutex smtx_pool;
+
+/**
+ * Intern a string into the process-wide pool.
+ *
+ * The same text always returns the same std::string instance,
+ * so recurring values (publishers, genres, system names) are
+ * stored once per process instead of once per file.
+ *
+ * NOTE: Interned strings are never freed; only intern values
+ * that recur across many files, not arbitrary file contents.
+ *
+ * @param str Source string
+ * @return Pooled string instance, or nullptr if str is nullptr.
+ */
+const string *intern(const char *str)
+{
+	if (!str)
+		return nullptr;
+
+	// Fast path: Most strings are already in the pool,
+	// so check with a shared lock first.
+	{
+		ReadLocker readLocker(smtx_pool);
+		auto iter = set_pool.find(str);
+		if (iter != set_pool.end()) {
+			return &(*iter);
+		}
+	}
+
+	// Not in the pool. Take the exclusive lock and insert it.
+	// NOTE: emplace() handles the race where another thread
+	// inserted the same string in between.
+	WriteLocker writeLocker(smtx_pool);
+	return &(*(set_pool.emplace(str).first));
+}
+
+/**
+ * Intern a string into the process-wide pool.
+ * @param str Source string
+ * @return Pooled string instance.
+ */
+const string *intern(const string &str)
+{
+	// Fast path: Most strings are already in the pool,
+	// so check with a shared lock first.
+	{
+		ReadLocker readLocker(smtx_pool);
+		auto iter = set_pool.find(str);
+		if (iter != set_pool.end()) {
+			return &(*iter);
+		}
+	}
+
+	// Not in the pool. Take the exclusive lock and insert it.
+	// NOTE: emplace() handles the race where another thread
+	// inserted the same string in between.
+	WriteLocker writeLocker(smtx_pool);
+	return &(*(set_pool.emplace(str).first));
+}
+
+} }
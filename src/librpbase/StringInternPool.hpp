@@ -0,0 +1,43 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase)                        *
+ * StringInternPool.hpp: Process-wide string intern pool.                  *
+ *                                                                         *
+ * Copyright (c) 2016-2024 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#pragma once
+
+#include "common.h"
+#include "dll-macros.h"	// for RP_LIBROMDATA_PUBLIC
+
+// C++ includes
+#include <string>
+
+namespace LibRpBase { namespace StringInternPool {
+
+/**
+ * Intern a string into the process-wide pool.
+ *
+ * The same text always returns the same std::string instance,
+ * so recurring values (publishers, genres, system names) are
+ * stored once per process instead of once per file.
+ *
+ * NOTE: Interned strings are never freed; only intern values
+ * that recur across many files, not arbitrary file contents.
+ *
+ * @param str Source string
+ * @return Pooled string instance, or nullptr if str is nullptr.
+ */
+RP_LIBROMDATA_PUBLIC
+const std::string *intern(const char *str);
+
+/**
+ * Intern a string into the process-wide pool.
+ * @param str Source string
+ * @return Pooled string instance.
+ */
+RP_LIBROMDATA_PUBLIC
+const std::string *intern(const std::string &str);
+
+} }
@@ -11,7 +11,7 @@
 #include "ctypex.h"
 
 // librpthreads
-#include "librpthreads/pthread_once.h"
+#include "librpthreads/rp_once.h"
 
 // C includes (C++ namespace)
 #include <clocale>
@@ -37,8 +37,8 @@ namespace LibRpBase { namespace SystemRegion {
 static uint32_t cc = 0;
 static uint32_t lc = 0;
 
-// pthread_once() control variable.
-static pthread_once_t system_region_once_control = PTHREAD_ONCE_INIT;
+// rp_once() control variable.
+static rp_once_t system_region_once_control = RP_ONCE_INIT;
 
 struct LanguageOffTbl_t {
 	uint32_t lc;
@@ -220,7 +220,7 @@ static int getSystemRegion_LC_MESSAGES(const char *locale)
 #ifdef _WIN32
 /**
  * Get the system region information.
- * Called by pthread_once().
+ * Called by rp_once().
  * (Windows version)
  *
  * Country code will be stored in 'cc'.
@@ -310,7 +310,7 @@ static void getSystemRegion(void)
 
 /**
  * Get the system region information.
- * Called by pthread_once().
+ * Called by rp_once().
  * (Unix/Linux version)
  *
  * Country code will be stored in 'cc'.
@@ -336,7 +336,7 @@ static inline void getSystemRegion(void)
  */
 uint32_t getCountryCode(void)
 {
-	pthread_once(&system_region_once_control, getSystemRegion);
+	rp_once(&system_region_once_control, getSystemRegion);
 	return cc;
 }
 
@@ -352,7 +352,7 @@ uint32_t getCountryCode(void)
  */
 uint32_t getLanguageCode(void)
 {
-	pthread_once(&system_region_once_control, getSystemRegion);
+	rp_once(&system_region_once_control, getSystemRegion);
 	return lc;
 }
 
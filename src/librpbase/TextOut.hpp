@@ -24,6 +24,11 @@ enum OutputFlags {
 	OF_SkipInternalImages		= (1U << 0),
 	OF_SkipListDataMoreThan10	= (1U << 1),	// ROMOutput only
 	OF_JSON_NoPrettyPrint		= (1U << 2),	// JSONROMOutput only
+
+	// Metadata-only fast path: output the system name and metadata
+	// properties only. Fields, internal images, and external image
+	// URLs are skipped, so loadFieldData() is never triggered.
+	OF_MetadataOnly			= (1U << 3),
 };
 
 /**
@@ -58,6 +63,19 @@ public:
 	RP_LIBROMDATA_PUBLIC
 	friend std::ostream& operator<<(std::ostream& os, const JSONROMOutput& fo);
 
+	/**
+	 * Serialize as a single NDJSON line into a caller-provided buffer.
+	 *
+	 * The JSON is written in minimal (non-pretty) form, followed by a
+	 * single '\n'. The line is appended to the buffer, so a batch caller
+	 * can reuse one buffer across files and flush it per file without
+	 * paying ostream formatting overhead per value.
+	 *
+	 * @param buf	[in,out] Destination buffer (appended to)
+	 */
+	RP_LIBROMDATA_PUBLIC
+	void writeNdjsonLine(std::string &buf) const;
+
 	inline bool crlf(void) const {
 		return crlf_;
 	}
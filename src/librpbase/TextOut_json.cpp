@@ -21,6 +21,7 @@ using std::vector;
 // librpbase
 #include "RomData.hpp"
 #include "RomFields.hpp"
+#include "RomMetaData.hpp"
 #include "img/IconAnimData.hpp"
 
 // librptexture
@@ -31,6 +32,7 @@ using LibRpTexture::rp_image;
 #include "rapidjson/document.h"
 #include "rapidjson/ostreamwrapper.h"
 #include "rapidjson/prettywriter.h"
+#include "rapidjson/stringbuffer.h"
 using namespace rapidjson;
 
 // TextOut_json isn't used by libromdata directly,
@@ -352,9 +354,14 @@ JSONROMOutput::JSONROMOutput(const RomData *romdata, uint32_t lc, unsigned int f
 	, lc(lc)
 	, flags(flags)
 	, crlf_(false) { }
-RP_LIBROMDATA_PUBLIC
-std::ostream& operator<<(std::ostream& os, const JSONROMOutput& fo) {
-	auto romdata = fo.romdata;
+/**
+ * Build the JSON document for a RomData object.
+ * Shared by the ostream and buffer-based serialization paths.
+ * @param document	[out] Destination document
+ * @param romdata	[in] RomData object
+ * @param flags		[in] OutputFlags
+ */
+static void buildJSONDocument(Document &document, const RomData *romdata, unsigned int flags) {
 	assert(romdata && romdata->isValid());
 
 	const char *const systemName = romdata->systemName(RomData::SYSNAME_TYPE_LONG | RomData::SYSNAME_REGION_ROM_LOCAL);
@@ -362,12 +369,59 @@ std::ostream& operator<<(std::ostream& os, const JSONROMOutput& fo) {
 	assert(systemName != nullptr);
 	assert(fileType != nullptr);
 
-	Document document;
 	document.SetObject();	// document should be an object, not an array
 	Document::AllocatorType& allocator = document.GetAllocator();
 	document.AddMember("system", StringRef(systemName ? systemName : "unknown"), allocator);
 	document.AddMember("filetype", StringRef(fileType ? fileType : "unknown"), allocator);
 
+	if (flags & OF_MetadataOnly) {
+		// Metadata-only fast path: output the metadata properties
+		// and skip fields and images entirely, so loadFieldData()
+		// is never triggered.
+		const RomMetaData *const metaData = romdata->metaData();
+		if (metaData && !metaData->empty()) {
+			Value metadata_obj(kObjectType);	// metadata
+			const auto metaData_cend = metaData->cend();
+			for (auto iter = metaData->cbegin(); iter != metaData_cend; ++iter) {
+				const auto &prop = *iter;
+				const char *const name = RomMetaData::getPropertyName(prop.name);
+				assert(name != nullptr);
+				if (!name)
+					continue;
+
+				switch (prop.type) {
+					case PropertyType::Integer:
+						metadata_obj.AddMember(StringRef(name), prop.data.ivalue, allocator);
+						break;
+					case PropertyType::UnsignedInteger:
+						metadata_obj.AddMember(StringRef(name), prop.data.uvalue, allocator);
+						break;
+					case PropertyType::String:
+						if (prop.data.str) {
+							Value str_val;
+							str_val.SetString(*(prop.data.str), allocator);
+							metadata_obj.AddMember(StringRef(name), str_val, allocator);
+						}
+						break;
+					case PropertyType::Timestamp:
+						metadata_obj.AddMember(StringRef(name),
+							static_cast<int64_t>(prop.data.timestamp), allocator);
+						break;
+					case PropertyType::Double:
+						metadata_obj.AddMember(StringRef(name), prop.data.dvalue, allocator);
+						break;
+					default:
+						assert(!"Unknown PropertyType");
+						break;
+				}
+			}
+			if (!metadata_obj.ObjectEmpty()) {
+				document.AddMember("metadata", metadata_obj, allocator);
+			}
+		}
+		return;
+	}
+
 	// Fields
 	const RomFields *const fields = romdata->fields();
 	assert(fields != nullptr);
@@ -381,7 +435,7 @@ std::ostream& operator<<(std::ostream& os, const JSONROMOutput& fo) {
 
 	const uint32_t imgbf = romdata->supportedImageTypes();
 	if (imgbf != 0) {
-		if (!(fo.flags & OF_SkipInternalImages)) {
+		if (!(flags & OF_SkipInternalImages)) {
 			// Internal images
 			Value imgint_array(kArrayType);	// imgint
 
@@ -473,6 +527,13 @@ std::ostream& operator<<(std::ostream& os, const JSONROMOutput& fo) {
 		}
 	}
 
+}
+
+RP_LIBROMDATA_PUBLIC
+std::ostream& operator<<(std::ostream& os, const JSONROMOutput& fo) {
+	Document document;
+	buildJSONDocument(document, fo.romdata, fo.flags);
+
 	OStreamWrapper oswr(os);
 	if (fo.flags & OF_JSON_NoPrettyPrint) {
 		// Don't use pretty-printing. (minimal JSON)
@@ -489,4 +550,29 @@ std::ostream& operator<<(std::ostream& os, const JSONROMOutput& fo) {
 	return os;
 }
 
+/**
+ * Serialize as a single NDJSON line into a caller-provided buffer.
+ *
+ * The JSON is written in minimal (non-pretty) form, followed by a
+ * single '\n'. The line is appended to the buffer, so a batch caller
+ * can reuse one buffer across files and flush it per file without
+ * paying ostream formatting overhead per value.
+ *
+ * @param buf	[in,out] Destination buffer (appended to)
+ */
+void JSONROMOutput::writeNdjsonLine(std::string &buf) const {
+	Document document;
+	buildJSONDocument(document, romdata, flags);
+
+	// Reuse one StringBuffer per thread to avoid reallocating
+	// the serialization buffer for every file in a batch.
+	static thread_local StringBuffer sbuf;
+	sbuf.Clear();
+	Writer<StringBuffer> writer(sbuf);
+	document.Accept(writer);
+
+	buf.append(sbuf.GetString(), sbuf.GetSize());
+	buf += '\n';
+}
+
 }
@@ -27,6 +27,7 @@ using std::vector;
 // librpbase
 #include "RomData.hpp"
 #include "RomFields.hpp"
+#include "RomMetaData.hpp"
 #include "SystemRegion.hpp"
 
 // librptext
@@ -441,16 +442,45 @@ public:
 			return os << C_("TextOut", "[ERROR: No list data.]");
 		}
 
+		// Memoized display-width lookups for this table layout.
+		// Cell values frequently repeat across rows (e.g. "Yes"/"No",
+		// region names), and the header names are measured in both
+		// the sizing and printing passes.
+		std::unordered_map<string, size_t> dispWidthCache;
+		auto dispWidth = [&dispWidthCache](const string &str) -> size_t {
+			auto iter = dispWidthCache.find(str);
+			if (iter != dispWidthCache.end()) {
+				return iter->second;
+			}
+			const size_t sz = utf8_disp_strlen(str);
+			dispWidthCache.emplace(str, sz);
+			return sz;
+		};
+
 		/** Calculate the column widths. **/
 
 		// Column names
 		unique_ptr<size_t[]> colSize(new size_t[col_count]());
 		size_t totalWidth = col_count + 1;
+
+		// Use the precomputed column widths, if available.
+		// addField_listData() fills these in for single-language
+		// lists, covering both the headers and the cell data.
+		// Timestamp columns still need the dummy-format pass below.
+		const uint16_t *const pre_widths = listDataDesc.col_disp_widths;
+		if (pre_widths) {
+			for (unsigned int i = 0; i < col_count; i++) {
+				colSize[i] = pre_widths[i];
+			}
+		}
+
 		if (listDataDesc.names) {
 			unsigned int i = 0;
 			unsigned int is_timestamp = listDataDesc.col_attrs.is_timestamp;
 			for (const string &name : *(listDataDesc.names)) {
-				colSize[i] = utf8_disp_strlen(name);
+				if (!pre_widths) {
+					colSize[i] = dispWidth(name);
+				}
 
 				if (unlikely(is_timestamp & 1)) {
 					// This is a timestamp column.
@@ -481,7 +511,7 @@ public:
 						listDataDesc.col_attrs.dtflags);
 					if (likely(ret == 0)) {
 						// Got the column width.
-						colSize[i] = utf8_disp_strlen(buf);
+						colSize[i] = std::max(colSize[i], utf8_disp_strlen(buf));
 					}
 				}
 			}
@@ -489,6 +519,13 @@ public:
 
 		// Row data
 		// FIXME: Handle control characters (U+0000-U+001F) as fullwidth.
+		// Per-cell display widths, recorded here so single-line cells
+		// don't have to be measured a second time when printing.
+		// ~0 means "measure at print time". (timestamps, which are
+		// formatted later, and multi-line cells)
+		static constexpr size_t CELL_WIDTH_UNKNOWN = ~(size_t)0;
+		unique_ptr<size_t[]> cellWidth(new size_t[pListData->size() * col_count]);
+		std::fill_n(cellWidth.get(), pListData->size() * col_count, CELL_WIDTH_UNKNOWN);
 		unique_ptr<unsigned int[]> nl_count(new unsigned int[pListData->size()]());
 		unsigned int row = 0;
 		const auto pListData_cend = pListData->cend();
@@ -508,9 +545,9 @@ public:
 				const size_t str_sz = jt->size();
 				size_t prev_pos = 0;
 				size_t cur_pos;
+				size_t col_sz = 0;	// in UTF-8 characters
 				do {
 					size_t cur_sz;	// in bytes
-					size_t col_sz;	// in UTF-8 characters
 					cur_pos = jt->find('\n', prev_pos);
 					if (cur_pos == string::npos) {
 						// End of string.
@@ -523,9 +560,19 @@ public:
 						prev_pos = cur_pos + 1;
 						nl_row++;
 					}
-					colSize[col] = max(col_sz, colSize[col]);
+					if (!pre_widths) {
+						colSize[col] = max(col_sz, colSize[col]);
+					}
 				} while (cur_pos != string::npos && prev_pos < str_sz);
 
+				if (nl_row == 0 && col < col_count) {
+					// Single-line cell. Record the width.
+					// NOTE: An empty cell is printed as '' by
+					// SafeString(), so it has a display width of 2.
+					cellWidth[(row * col_count) + col] =
+						(likely(!jt->empty()) ? col_sz : 2);
+				}
+
 				// Update the newline count for this row.
 				nl_count[row] = max(nl_count[row], nl_row);
 			}
@@ -541,10 +588,20 @@ public:
 		/** Print the list data. **/
 		StreamStateSaver state(os);
 
+		// Assemble the table into a single buffer and write it out
+		// in one ostream call. Padding is appended in bulk instead
+		// of one space at a time.
+		size_t est_row_width = field.width + col_count + 2;
+		for (unsigned int i = 0; i < col_count; i++) {
+			est_row_width += colSize[i];
+		}
+		string outbuf;
+		outbuf.reserve(est_row_width * (pListData->size() + 2));
+
 		// Print the list on a separate row from the field name?
 		const bool separateRow = !!(romField.flags & RomFields::RFT_LISTDATA_SEPARATE_ROW);
 		if (separateRow) {
-			os << '\n';
+			outbuf += '\n';
 		}
 
 		bool skipFirstNL = true;
@@ -556,51 +613,44 @@ public:
 			for (auto it = listDataDesc.names->cbegin(); it != names_cend; ++it, ++col, align >>= 2) {
 				// FIXME: What was this used for?
 				totalWidth += colSize[col]; // this could be in a separate loop, but whatever
-				os << '|';
-				const size_t str_sz = utf8_disp_strlen(*it);
+				outbuf += '|';
+				const size_t str_sz = dispWidth(*it);
+				const size_t spc = (str_sz < colSize[col] ? colSize[col] - str_sz : 0);
 				switch (align & 3) {
 					case TXA_L:
 						// Left alignment
-						os << *it;
-						for (size_t x = str_sz; x < colSize[col]; x++) {
-							os << ' ';
-						}
+						outbuf += *it;
+						outbuf.append(spc, ' ');
 						break;
 					default:
 					case TXA_D:
-					case TXA_C: {
+					case TXA_C:
 						// Center alignment (default)
 						// For odd sizes, the extra space
 						// will be on the right.
-						const size_t spc = colSize[col] - str_sz;
-						for (size_t x = spc/2; x > 0; x--) {
-							os << ' ';
-						}
-						os << *it;
-						for (size_t x = (spc/2) + (spc%2); x > 0; x--) {
-							os << ' ';
-						}
+						outbuf.append(spc/2, ' ');
+						outbuf += *it;
+						outbuf.append((spc/2) + (spc%2), ' ');
 						break;
-					}
 					case TXA_R:
 						// Right alignment
-						for (size_t x = str_sz; x < colSize[col]; x++) {
-							os << ' ';
-						}
-						os << *it;
+						outbuf.append(spc, ' ');
+						outbuf += *it;
 						break;
 				}
 			}
-			os << '|' << '\n';
+			outbuf += '|';
+			outbuf += '\n';
 
 			// Separator between the headers and the data.
 			if (!separateRow) {
-				os << Pad(field.width);
+				outbuf.append(field.width, ' ');
 			}
 			for (col = 0; col < col_count; col++) {
-				os << '|' << string(colSize[col], '-');
+				outbuf += '|';
+				outbuf.append(colSize[col], '-');
 			}
-			os << '|';
+			outbuf += '|';
 
 			// Don't skip the first newline, since we're
 			// printing headers.
@@ -629,16 +679,18 @@ public:
 			// NOTE: nl_count[row] is 0 for single-line items.
 			for (int line = nl_count[row]; line >= 0; line--) {
 				if (!skipFirstNL) {
-					os << '\n';
+					outbuf += '\n';
 					if (!separateRow) {
-						os << Pad(field.width);
+						outbuf.append(field.width, ' ');
 					}
 				} else {
 					skipFirstNL = false;
 				}
-				os << '|';
+				outbuf += '|';
 				if (romField.flags & RomFields::RFT_LISTDATA_CHECKBOXES) {
-					os << '[' << ((checkboxes & 1) ? 'x' : ' ') << "] ";
+					outbuf += '[';
+					outbuf += ((checkboxes & 1) ? 'x' : ' ');
+					outbuf += "] ";
 					checkboxes >>= 1;
 				}
 				unsigned int col = 0;
@@ -688,43 +740,40 @@ public:
 					}
 
 					// Align the data.
-					size_t str_sz = utf8_disp_strlen(str);
+					// Use the width recorded in the sizing pass
+					// if this was a single-line cell.
+					size_t str_sz = cellWidth[(row * col_count) + col];
+					if (str_sz == CELL_WIDTH_UNKNOWN) {
+						str_sz = dispWidth(str);
+					}
+					const size_t spc = (str_sz < colSize[col] ? colSize[col] - str_sz : 0);
 					switch (align & 3) {
 						default:
 						case TXA_D:
 						case TXA_L:
 							// Left alignment (default)
-							os << str;
-							for (size_t x = str_sz; x < colSize[col]; x++) {
-								os << ' ';
-							}
+							outbuf += str;
+							outbuf.append(spc, ' ');
 							break;
-						case TXA_C: {
+						case TXA_C:
 							// Center alignment
 							// For odd sizes, the extra space
 							// will be on the right.
-							const size_t spc = colSize[col] - str_sz;
-							for (size_t x = spc/2; x > 0; x--) {
-								os << ' ';
-							}
-							os << str;
-							for (size_t x = (spc/2) + (spc%2); x > 0; x--) {
-								os << ' ';
-							}
+							outbuf.append(spc/2, ' ');
+							outbuf += str;
+							outbuf.append((spc/2) + (spc%2), ' ');
 							break;
-						}
 						case TXA_R:
 							// Right alignment
-							for (size_t x = str_sz; x < colSize[col]; x++) {
-								os << ' ';
-							}
-							os << str;
+							outbuf.append(spc, ' ');
+							outbuf += str;
 							break;
 					}
-					os << '|';
+					outbuf += '|';
 				}
 			}
 		}
+		os.write(outbuf.data(), outbuf.size());
 		return os;
 	}
 };
@@ -929,6 +978,76 @@ public:
 };
 
 
+class MetaDataOutput {
+	const RomMetaData &metaData;
+public:
+	explicit MetaDataOutput(const RomMetaData &metaData)
+		: metaData(metaData) { }
+	friend std::ostream& operator<<(std::ostream& os, const MetaDataOutput& mo) {
+		size_t maxWidth = 0;
+		std::for_each(mo.metaData.cbegin(), mo.metaData.cend(),
+			[&maxWidth](const RomMetaData::MetaData &prop) {
+				const char *const name = RomMetaData::getPropertyName(prop.name);
+				if (name) {
+					maxWidth = max(maxWidth, strlen(name));
+				}
+			}
+		);
+		maxWidth += 2;
+
+		bool printed_first = false;
+		const auto metaData_cend = mo.metaData.cend();
+		for (auto iter = mo.metaData.cbegin(); iter != metaData_cend; ++iter) {
+			const auto &prop = *iter;
+			const char *const name = RomMetaData::getPropertyName(prop.name);
+			assert(name != nullptr);
+			if (!name)
+				continue;
+
+			if (printed_first)
+				os << '\n';
+
+			os << ColonPad(maxWidth, name);
+			switch (prop.type) {
+				case PropertyType::Integer:
+					os << prop.data.ivalue;
+					break;
+				case PropertyType::UnsignedInteger:
+					os << prop.data.uvalue;
+					break;
+				case PropertyType::String:
+					if (prop.data.str) {
+						os << *(prop.data.str);
+					}
+					break;
+				case PropertyType::Timestamp: {
+					char str[128];
+					str[0] = '\0';
+					int ret = formatDateTime(str, sizeof(str), prop.data.timestamp,
+						static_cast<RomFields::DateTimeFlags>(
+							RomFields::RFT_DATETIME_HAS_DATE | RomFields::RFT_DATETIME_HAS_TIME));
+					if (likely(ret == 0)) {
+						os << str;
+					} else {
+						os << C_("RomData", "Unknown");
+					}
+					break;
+				}
+				case PropertyType::Double:
+					os << prop.data.dvalue;
+					break;
+				default:
+					assert(!"Unknown PropertyType");
+					os << "NYI";
+					break;
+			}
+
+			printed_first = true;
+		}
+		return os;
+	}
+};
+
 ROMOutput::ROMOutput(const RomData *romdata, uint32_t lc, unsigned int flags)
 	: romdata(romdata)
 	, lc(lc)
@@ -951,6 +1070,18 @@ std::ostream& operator<<(std::ostream& os, const ROMOutput& fo) {
 		os << "-- " << detectMsg << '\n';
 	}
 
+	if (fo.flags & OF_MetadataOnly) {
+		// Metadata-only fast path: output the metadata properties
+		// and skip fields and images entirely, so loadFieldData()
+		// is never triggered.
+		const RomMetaData *const metaData = romdata->metaData();
+		if (metaData && !metaData->empty()) {
+			os << MetaDataOutput(*metaData) << '\n';
+		}
+		os.flush();
+		return os;
+	}
+
 	// Fields
 	const RomFields *const fields = romdata->fields();
 	assert(fields != nullptr);
@@ -47,6 +47,35 @@ int ConfReaderPrivate::processConfigLine_static(void *user, const char *section,
 	return static_cast<ConfReaderPrivate*>(user)->processConfigLine(section, name, value);
 }
 
+/**
+ * Load a compiled version of the configuration, if one is available.
+ * Called by ConfReader::load() before parsing the INI file.
+ *
+ * The default implementation does not support compiled
+ * configurations, so the INI file is always parsed.
+ *
+ * @param mtime Current mtime of the configuration file.
+ * @return 0 on success; negative POSIX error code if the INI file must be parsed.
+ */
+int ConfReaderPrivate::loadCompiled(time_t mtime)
+{
+	RP_UNUSED(mtime);
+	return -ENOTSUP;
+}
+
+/**
+ * Save a compiled version of the configuration.
+ * Called by ConfReader::load() after the INI file has been parsed.
+ *
+ * The default implementation does nothing.
+ *
+ * @param mtime Current mtime of the configuration file.
+ */
+void ConfReaderPrivate::saveCompiled(time_t mtime)
+{
+	RP_UNUSED(mtime);
+}
+
 /** ConfReader **/
 
 /**
@@ -76,7 +105,7 @@ ConfReader::~ConfReader()
 bool ConfReader::isLoaded(void) const
 {
 	RP_D(const ConfReader);
-	return d->conf_was_found;
+	return d->conf_was_found.load(std::memory_order_acquire);
 }
 
 /**
@@ -93,15 +122,23 @@ int ConfReader::load(bool force)
 {
 	RP_D(ConfReader);
 
-	if (!force && d->conf_was_found) {
+	if (!force && d->conf_was_found.load(std::memory_order_acquire)) {
 		// Have we checked the timestamp recently?
 		// TODO: Define the threshold somewhere.
 		const time_t now = time(nullptr);
-		if (llabs(now - d->conf_last_checked) < 2) {
+		time_t last = d->conf_last_checked.load(std::memory_order_relaxed);
+		if (llabs(now - last) < 2) {
 			// We checked it recently. Assume it's up to date.
 			return 0;
 		}
-		d->conf_last_checked = now;
+
+		// Claim the timestamp check. If another thread claimed it
+		// first, let that thread handle the stat() and keep using
+		// the current configuration. This keeps the common path
+		// lock-free for concurrent readers.
+		if (!d->conf_last_checked.compare_exchange_strong(last, now)) {
+			return 0;
+		}
 
 		// Check if the keys.conf timestamp has changed.
 		// Initial check. (fast path)
@@ -135,7 +172,7 @@ int ConfReader::load(bool force)
 			}
 			d->conf_filename += d->conf_rel_filename;
 		}
-	} else if (!force && d->conf_was_found) {
+	} else if (!force && d->conf_was_found.load(std::memory_order_relaxed)) {
 		// Check if the keys.conf timestamp has changed.
 		// NOTE: Second check once the mutex is locked.
 		time_t mtime;
@@ -156,51 +193,59 @@ int ConfReader::load(bool force)
 	// Reset the configuration to the default values.
 	d->reset();
 
-	// Parse the configuration file.
-	// NOTE: We're using the filename directly, since it's always
-	// on the local file system, and it's easier to let inih
-	// manage the file itself.
-#ifdef _WIN32
-	// Win32: Open the file using _tfopen(),
-	// then parse it using ini_parse_file().
-	int ret = 0;
-	errno = 0;
-	FILE *f_ini = _tfopen(U82T_s(d->conf_filename), _T("rb"));
-	if (f_ini) {
-		// Parse the INI file.
-		ret = ini_parse_file(f_ini, ConfReaderPrivate::processConfigLine_static, d);
-		fclose(f_ini);
-	} else {
-		// Error opening the INI file.
-		ret = errno;
+	// Get the current mtime of the configuration file.
+	// Needed to validate a compiled version, and saved after loading.
+	time_t mtime;
+	if (FileSystem::get_mtime(d->conf_filename, &mtime) != 0) {
+		// mtime error...
+		// TODO: What do we do here?
+		mtime = 0;
 	}
+
+	// Check for a compiled version of the configuration first.
+	int ret = d->loadCompiled(mtime);
+	if (ret != 0) {
+		// No usable compiled version.
+		// Parse the configuration file.
+		// NOTE: We're using the filename directly, since it's always
+		// on the local file system, and it's easier to let inih
+		// manage the file itself.
+#ifdef _WIN32
+		// Win32: Open the file using _tfopen(),
+		// then parse it using ini_parse_file().
+		ret = 0;
+		errno = 0;
+		FILE *f_ini = _tfopen(U82T_s(d->conf_filename), _T("rb"));
+		if (f_ini) {
+			// Parse the INI file.
+			ret = ini_parse_file(f_ini, ConfReaderPrivate::processConfigLine_static, d);
+			fclose(f_ini);
+		} else {
+			// Error opening the INI file.
+			ret = errno;
+		}
 #else /* !_WIN32 */
-	// Linux or other systems: Use ini_parse().
-	int ret = ini_parse(d->conf_filename.c_str(),
-		ConfReaderPrivate::processConfigLine_static, d);
+		// Linux or other systems: Use ini_parse().
+		ret = ini_parse(d->conf_filename.c_str(),
+			ConfReaderPrivate::processConfigLine_static, d);
 #endif /* _WIN32 */
-	if (ret != 0) {
-		// Error parsing the INI file.
-		d->reset();
-		if (ret == -2)
-			return -ENOMEM;
-		return -EIO;
-	}
+		if (ret != 0) {
+			// Error parsing the INI file.
+			d->reset();
+			if (ret == -2)
+				return -ENOMEM;
+			return -EIO;
+		}
 
-	// Save the mtime from the keys.conf file.
-	// TODO: Combine with earlier check?
-	time_t mtime;
-	ret = FileSystem::get_mtime(d->conf_filename, &mtime);
-	if (ret == 0) {
-		d->conf_mtime = mtime;
-	} else {
-		// mtime error...
-		// TODO: What do we do here?
-		d->conf_mtime = 0;
+		// Save a compiled version for subsequent processes.
+		d->saveCompiled(mtime);
 	}
 
+	// Save the mtime from the configuration file.
+	d->conf_mtime = mtime;
+
 	// Keys loaded.
-	d->conf_was_found = true;
+	d->conf_was_found.store(true, std::memory_order_release);
 	return 0;
 }
 
@@ -18,6 +18,7 @@
 #include "ini.h"
 
 // C++ includes.
+#include <atomic>
 #include <string>
 
 namespace LibRpBase {
@@ -45,9 +46,14 @@ public:
 	std::string conf_filename;		// alloc()'d in load()
 
 	// rom-properties.conf status.
+	// NOTE: conf_last_checked and conf_was_found are atomic so the
+	// load() fast path doesn't need to take mtxLoad. RomDataView
+	// queries configuration options per-field, potentially from
+	// multiple threads at once, so the common "already loaded and
+	// checked recently" case must be contention-free.
 	time_t conf_mtime;
-	time_t conf_last_checked;
-	bool conf_was_found;
+	std::atomic<time_t> conf_last_checked;
+	std::atomic<bool> conf_was_found;
 
 public:
 	/**
@@ -79,6 +85,28 @@ public:
 	 */
 	virtual int processConfigLine(const char *section,
 		const char *name, const char *value) = 0;
+
+	/**
+	 * Load a compiled version of the configuration, if one is available.
+	 * Called by ConfReader::load() before parsing the INI file.
+	 *
+	 * The default implementation does not support compiled
+	 * configurations, so the INI file is always parsed.
+	 *
+	 * @param mtime Current mtime of the configuration file.
+	 * @return 0 on success; negative POSIX error code if the INI file must be parsed.
+	 */
+	virtual int loadCompiled(time_t mtime);
+
+	/**
+	 * Save a compiled version of the configuration.
+	 * Called by ConfReader::load() after the INI file has been parsed.
+	 *
+	 * The default implementation does nothing.
+	 *
+	 * @param mtime Current mtime of the configuration file.
+	 */
+	virtual void saveCompiled(time_t mtime);
 };
 
 }
@@ -106,6 +106,7 @@ public:
 	bool enableThumbnailOnNetworkFS;
 	bool showXAttrView;
 	bool thumbnailDirectoryPackages;
+	bool enableMetadataCache;
 
 public:
 	/** Default values **/
@@ -128,6 +129,7 @@ public:
 	static constexpr bool enableThumbnailOnNetworkFS_default = false;
 	static constexpr bool showXAttrView_default = true;
 	static constexpr bool thumbnailDirectoryPackages_default = true;
+	static constexpr bool enableMetadataCache_default = true;
 };
 
 /** ConfigPrivate **/
@@ -188,6 +190,7 @@ ConfigPrivate::ConfigPrivate()
 	, showXAttrView(showXAttrView_default)
 	// Thumbnail directory packages (e.g. Wii U)
 	, thumbnailDirectoryPackages(thumbnailDirectoryPackages_default)
+	, enableMetadataCache(enableMetadataCache_default)
 {
 	// NOTE: Configuration is also initialized in the reset() function.
 	dmgTSMode = dmgTSMode_default;
@@ -232,6 +235,8 @@ void ConfigPrivate::reset(void)
 	showXAttrView = showXAttrView_default;
 	// Thumbnail directory packages (e.g. Wii U)
 	thumbnailDirectoryPackages = thumbnailDirectoryPackages_default;
+	// Persistent parsed-metadata cache
+	enableMetadataCache = enableMetadataCache_default;
 }
 
 /**
@@ -358,6 +363,8 @@ int ConfigPrivate::processConfigLine(const char *section, const char *name, cons
 			bParam = &showXAttrView;
 		} else if (!strcasecmp(name, "ThumbnailDirectoryPackages")) {
 			bParam = &thumbnailDirectoryPackages;
+		} else if (!strcasecmp(name, "EnableMetadataCache")) {
+			bParam = &enableMetadataCache;
 		} else {
 			// Invalid option.
 			return 1;
@@ -731,6 +738,8 @@ bool Config::getBoolConfigOption(BoolConfig option) const
 			return d->showXAttrView;
 		case BoolConfig::Options_ThumbnailDirectoryPackages:
 			return d->thumbnailDirectoryPackages;
+		case BoolConfig::Options_EnableMetadataCache:
+			return d->enableMetadataCache;
 	}
 }
 
@@ -788,6 +797,8 @@ bool Config::getBoolConfigOption_default(BoolConfig option)
 			return ConfigPrivate::showXAttrView_default;
 		case BoolConfig::Options_ThumbnailDirectoryPackages:
 			return ConfigPrivate::thumbnailDirectoryPackages_default;
+		case BoolConfig::Options_EnableMetadataCache:
+			return ConfigPrivate::enableMetadataCache_default;
 	}
 }
 
@@ -147,6 +147,7 @@ public:
 		Options_EnableThumbnailOnNetworkFS,
 		Options_ShowXAttrView,
 		Options_ThumbnailDirectoryPackages,
+		Options_EnableMetadataCache,
 
 		Max
 	};
@@ -9,6 +9,9 @@
 #include "stdafx.h"
 #include "AesCAPI_NG.hpp"
 
+// Tracing instrumentation
+#include "rp_trace.h"
+
 // libwin32common
 #include "libwin32common/RpWin32_sdk.h"
 #include "tcharx.h"
@@ -475,6 +478,8 @@ int AesCAPI_NG::setIV(const uint8_t *RESTRICT pIV, size_t size)
  */
 size_t AesCAPI_NG::decrypt(uint8_t *RESTRICT pData, size_t size)
 {
+	RP_TRACE_SCOPE("AesCAPI_NG::decrypt");
+
 	RP_D(AesCAPI_NG);
 	if (!d->hBcryptDll || !d->hAesAlg || !d->hKey) {
 		// Algorithm is not available,
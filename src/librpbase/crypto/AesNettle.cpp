@@ -11,6 +11,9 @@
 
 #include "AesNettle.hpp"
 
+// Tracing instrumentation
+#include "rp_trace.h"
+
 // Nettle AES functions.
 #include <nettle/nettle-types.h>
 #include <nettle/aes.h>
@@ -226,6 +229,8 @@ int AesNettle::setIV(const uint8_t *RESTRICT pIV, size_t size)
  */
 size_t AesNettle::decrypt(uint8_t *RESTRICT pData, size_t size)
 {
+	RP_TRACE_SCOPE("AesNettle::decrypt");
+
 	if (!pData || size == 0 || (size % AES_BLOCK_SIZE != 0)) {
 		// Invalid parameters.
 		return 0;
@@ -311,6 +316,103 @@ size_t AesNettle::decrypt(uint8_t *RESTRICT pData, size_t size)
 	return size;
 }
 
+/**
+ * Decrypt multiple blocks of data, each with its own IV.
+ * Key must be set before calling this function.
+ *
+ * The key schedule is verified once for the entire batch,
+ * and the per-block IVs are loaded directly, avoiding the
+ * setIV()/decrypt() round trip per block.
+ *
+ * @param pBlocks	[in/out] Block descriptors.
+ * @param block_count	[in] Number of block descriptors.
+ * @return Total number of bytes decrypted on success; 0 on error.
+ */
+size_t AesNettle::decryptBatch(DecryptBlock *pBlocks, size_t block_count)
+{
+	assert(pBlocks != nullptr);
+	assert(block_count != 0);
+	if (!pBlocks || block_count == 0) {
+		// Invalid parameters.
+		return 0;
+	}
+
+	RP_D(AesNettle);
+
+	// Update the key schedule once for the entire batch.
+	if (d->key_changed) {
+#ifdef HAVE_NETTLE_3
+		if (!d->decrypt_fn) {
+			// No decryption function set...
+			return 0;
+		}
+		if (d->chainingMode == ChainingMode::CTR) {
+			d->setkey_enc_fn(&d->ctx, d->key);
+		} else {
+			d->setkey_dec_fn(&d->ctx, d->key);
+		}
+#else /* !HAVE_NETTLE_3 */
+		if (d->chainingMode == ChainingMode::CTR) {
+			aes_set_encrypt_key(&d->ctx, d->key_len, d->key);
+		} else {
+			aes_set_decrypt_key(&d->ctx, d->key_len, d->key);
+		}
+#endif /* HAVE_NETTLE_3 */
+		d->key_changed = false;
+	}
+
+	size_t total = 0;
+	for (; block_count > 0; block_count--, pBlocks++) {
+		if (!pBlocks->pData || pBlocks->size == 0 ||
+		    (pBlocks->size % AES_BLOCK_SIZE != 0))
+		{
+			// Invalid block.
+			return 0;
+		}
+
+		if (pBlocks->pIV) {
+			memcpy(d->iv, pBlocks->pIV, AES_BLOCK_SIZE);
+		}
+
+		switch (d->chainingMode) {
+			case ChainingMode::ECB:
+#ifdef HAVE_NETTLE_3
+				d->decrypt_fn(&d->ctx, pBlocks->size, pBlocks->pData, pBlocks->pData);
+#else /* !HAVE_NETTLE_3 */
+				aes_decrypt(&d->ctx, pBlocks->size, pBlocks->pData, pBlocks->pData);
+#endif /* HAVE_NETTLE_3 */
+				break;
+
+			case ChainingMode::CBC:
+#ifdef HAVE_NETTLE_3
+				cbc_decrypt(&d->ctx, d->decrypt_fn, AES_BLOCK_SIZE,
+					    d->iv, pBlocks->size, pBlocks->pData, pBlocks->pData);
+#else /* !HAVE_NETTLE_3 */
+				cbc_decrypt(&d->ctx, (nettle_crypt_func*)aes_decrypt, AES_BLOCK_SIZE,
+					    d->iv, pBlocks->size, pBlocks->pData, pBlocks->pData);
+#endif /* HAVE_NETTLE_3 */
+				break;
+
+			case ChainingMode::CTR:
+#ifdef HAVE_NETTLE_3
+				ctr_crypt(&d->ctx, d->encrypt_fn, AES_BLOCK_SIZE,
+					  d->iv, pBlocks->size, pBlocks->pData, pBlocks->pData);
+#else /* !HAVE_NETTLE_3 */
+				ctr_crypt(&d->ctx, (nettle_crypt_func*)aes_encrypt, AES_BLOCK_SIZE,
+					  d->iv, pBlocks->size, pBlocks->pData, pBlocks->pData);
+#endif /* HAVE_NETTLE_3 */
+				break;
+
+			default:
+				return 0;
+		}
+
+		total += pBlocks->size;
+	}
+
+	return total;
+}
+
 /**
  * Get the nettle compile-time version.
  * @param pMajor	[out] Pointer to store major version.
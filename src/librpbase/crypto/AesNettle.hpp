@@ -79,6 +79,20 @@ class AesNettle final : public IAesCipher
 		ATTR_ACCESS_SIZE(read_write, 2, 3)
 		size_t decrypt(uint8_t *RESTRICT pData, size_t size) final;
 
+		/**
+		 * Decrypt multiple blocks of data, each with its own IV.
+		 * Key must be set before calling this function.
+		 *
+		 * The key schedule is verified once for the entire batch,
+		 * and the per-block IVs are loaded directly, avoiding the
+		 * setIV()/decrypt() round trip per block.
+		 *
+		 * @param pBlocks	[in/out] Block descriptors.
+		 * @param block_count	[in] Number of block descriptors.
+		 * @return Total number of bytes decrypted on success; 0 on error.
+		 */
+		size_t decryptBatch(DecryptBlock *pBlocks, size_t block_count) final;
+
 	public:
 		/**
 		 * Get the nettle compile-time version.
@@ -10,6 +10,7 @@
 #include "config.librpbase.h"
 
 #include "Hash.hpp"
+#include "Hash_crc32_p.hpp"
 
 // libwin32common
 #include "libwin32common/RpWin32_sdk.h"
@@ -265,6 +266,15 @@ int Hash::process(const void *pData, size_t len)
 			return -EIO;	// TODO: Better error code?
 		}
 #endif /* CHECK_DELAYLOAD */
+#ifdef HASH_CRC32_HAS_PCLMUL
+		// Use PCLMULQDQ folding for larger buffers if available.
+		// NOTE: zlib-ng dispatches to a PCLMULQDQ implementation
+		// internally, but classic zlib only has table lookups.
+		if (len >= 64 && RP_CPU_HasPCLMUL() && RP_CPU_HasSSE41()) {
+			d->ctx.crc32 = rp_crc32_pclmul(d->ctx.crc32, static_cast<const uint8_t*>(pData), len);
+			return 0;
+		}
+#endif /* HASH_CRC32_HAS_PCLMUL */
 		d->ctx.crc32 = crc32(d->ctx.crc32, static_cast<const uint8_t*>(pData), len);
 		return 0;
 	}
@@ -8,6 +8,7 @@
 
 #include "stdafx.h"
 #include "Hash.hpp"
+#include "Hash_crc32_p.hpp"
 
 // zlib for crc32()
 #include <zlib.h>
@@ -140,6 +141,15 @@ int Hash::process(const void *pData, size_t len)
 			assert(!"Invalid hash algorithm specified.");
 			return -ENOTSUP;
 		case Algorithm::CRC32:
+#ifdef HASH_CRC32_HAS_PCLMUL
+			// Use PCLMULQDQ folding for larger buffers if available.
+			// NOTE: zlib-ng dispatches to a PCLMULQDQ implementation
+			// internally, but classic zlib only has table lookups.
+			if (len >= 64 && RP_CPU_HasPCLMUL() && RP_CPU_HasSSE41()) {
+				d->ctx.crc32 = rp_crc32_pclmul(d->ctx.crc32, static_cast<const uint8_t*>(pData), len);
+				break;
+			}
+#endif /* HASH_CRC32_HAS_PCLMUL */
 			d->ctx.crc32 = crc32(d->ctx.crc32, static_cast<const uint8_t*>(pData), len);
 			break;
 #ifdef ENABLE_DECRYPTION
@@ -0,0 +1,43 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase)                        *
+ * Hash_crc32_p.hpp: Hash class: CRC32 kernels. (PRIVATE HEADER)           *
+ *                                                                         *
+ * Copyright (c) 2016-2024 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#pragma once
+
+#include "common.h"	// for ATTR_ACCESS_SIZE()
+
+// C includes
+#include <stddef.h>	/* size_t */
+#include <stdint.h>
+
+#include "librpcpuid/cpu_dispatch.h"
+#if defined(RP_CPU_I386) || defined(RP_CPU_AMD64)
+#  include "librpcpuid/cpuflags_x86.h"
+#  define HASH_CRC32_HAS_PCLMUL 1
+#endif
+
+namespace LibRpBase {
+
+#ifdef HASH_CRC32_HAS_PCLMUL
+/**
+ * Calculate a zlib-compatible CRC32 using PCLMULQDQ folding.
+ * Requires a CPU with PCLMULQDQ and SSE4.1 support.
+ *
+ * NOTE: Trailing bytes that don't fill a 16-byte block are
+ * handled using zlib's crc32(), so this is a drop-in
+ * replacement for any buffer length.
+ *
+ * @param crc	[in] Previous CRC32. (0 for a new stream)
+ * @param pData	[in] Input data
+ * @param len	[in] Data length
+ * @return Updated CRC32.
+ */
+ATTR_ACCESS_SIZE(read_only, 2, 3)
+uint32_t rp_crc32_pclmul(uint32_t crc, const uint8_t *pData, size_t len);
+#endif /* HASH_CRC32_HAS_PCLMUL */
+
+}
@@ -11,6 +11,7 @@
 #include "common.h"
 
 // C includes.
+#include <assert.h>
 #include <stddef.h>	/* size_t */
 #include <stdint.h>
 
@@ -108,6 +109,46 @@ class NOVTABLE IAesCipher
 			}
 			return decrypt(pData, size);
 		}
+
+		// Descriptor for decryptBatch().
+		struct DecryptBlock {
+			uint8_t *pData;		// [in/out] Data block. (decrypted in place)
+			size_t size;		// [in] Length of data block. (Must be a multiple of 16.)
+			const uint8_t *pIV;	// [in] 16-byte IV/counter, or nullptr to continue chaining.
+		};
+
+		/**
+		 * Decrypt multiple blocks of data, each with its own IV.
+		 * Key must be set before calling this function.
+		 *
+		 * This is intended for sector-based formats that store a
+		 * separate IV per sector, e.g. Wii partitions. Subclasses
+		 * can override it to amortize per-call overhead; the
+		 * default implementation simply loops over decrypt().
+		 *
+		 * @param pBlocks	[in/out] Block descriptors.
+		 * @param block_count	[in] Number of block descriptors.
+		 * @return Total number of bytes decrypted on success; 0 on error.
+		 */
+		virtual size_t decryptBatch(DecryptBlock *pBlocks, size_t block_count)
+		{
+			assert(pBlocks != nullptr);
+			assert(block_count != 0);
+			size_t total = 0;
+			for (; block_count > 0; block_count--, pBlocks++) {
+				if (pBlocks->pIV) {
+					if (setIV(pBlocks->pIV, 16) != 0) {
+						return 0;
+					}
+				}
+				const size_t sz = decrypt(pBlocks->pData, pBlocks->size);
+				if (sz != pBlocks->size) {
+					return 0;
+				}
+				total += sz;
+			}
+			return total;
+		}
 };
 
 /**
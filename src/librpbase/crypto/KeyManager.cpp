@@ -18,10 +18,20 @@ using std::array;
 using std::string;
 using std::unique_ptr;
 using std::unordered_map;
+using std::vector;
 
 #include "IAesCipher.hpp"
 #include "AesCipherFactory.hpp"
 
+// OS-specific includes
+#ifdef _WIN32
+// for U82T_s()
+#  include "librptext/wchar.hpp"
+#else /* !_WIN32 */
+// for fchmod()
+#  include <sys/stat.h>
+#endif /* _WIN32 */
+
 namespace LibRpBase {
 
 class KeyManagerPrivate : public ConfReaderPrivate
@@ -60,6 +70,21 @@ class KeyManagerPrivate : public ConfReaderPrivate
 		int processConfigLine(const char *section,
 			const char *name, const char *value) final;
 
+#ifdef ENABLE_DECRYPTION
+		/**
+		 * Load the compiled key store, if it is up to date.
+		 * @param mtime Current mtime of keys.conf.
+		 * @return 0 on success; negative POSIX error code if keys.conf must be parsed.
+		 */
+		int loadCompiled(time_t mtime) final;
+
+		/**
+		 * Save the compiled key store.
+		 * @param mtime Current mtime of keys.conf.
+		 */
+		void saveCompiled(time_t mtime) final;
+#endif /* ENABLE_DECRYPTION */
+
 	public:
 #ifdef ENABLE_DECRYPTION
 		// Encryption key data.
@@ -86,6 +111,41 @@ class KeyManagerPrivate : public ConfReaderPrivate
 #endif /* ENABLE_DECRYPTION */
 };
 
+#ifdef ENABLE_DECRYPTION
+/** Compiled key store **/
+
+// The compiled key store ("keys.conf.bin") caches the parsed contents
+// of keys.conf so subsequent processes can load the keys with a few
+// reads instead of re-parsing the INI file and hex-decoding every key.
+// It's a machine-local cache, so values are stored in native endianness,
+// and it's regenerated whenever keys.conf is modified.
+
+#define COMPILED_KEYS_MAGIC	"RPKC"
+#define COMPILED_KEYS_VERSION	1U
+
+// Limits for validation. keys.conf values are limited to 255 hex
+// characters each, so anything bigger than this is corruption.
+#define COMPILED_KEYS_MAX_COUNT		4096U
+#define COMPILED_KEYS_MAX_BLOB_LEN	(1U*1024*1024)
+
+typedef struct _CompiledKeysHeader {
+	char magic[4];		// "RPKC"
+	uint32_t version;	// Format version (COMPILED_KEYS_VERSION)
+	int64_t conf_mtime;	// keys.conf mtime when the store was written
+	uint32_t key_count;	// Number of key entries
+	uint32_t names_len;	// Length of the key name blob, in bytes
+	uint32_t vkeys_len;	// Length of the key data blob, in bytes
+	uint32_t reserved;	// Reserved (padding; must be 0)
+} CompiledKeysHeader;
+ASSERT_STRUCT(CompiledKeysHeader, 32);
+
+typedef struct _CompiledKeyEntry {
+	uint32_t name_offset;	// Offset of the key name in the name blob
+	uint32_t keyIdx;	// vKeys information (same format as mapKeyNames)
+} CompiledKeyEntry;
+ASSERT_STRUCT(CompiledKeyEntry, 8);
+#endif /* ENABLE_DECRYPTION */
+
 /** KeyManagerPrivate **/
 
 #ifdef ENABLE_DECRYPTION
@@ -218,6 +278,160 @@ int KeyManagerPrivate::processConfigLine(const char *section, const char *name,
 #endif /* ENABLE_DECRYPTION */
 }
 
+#ifdef ENABLE_DECRYPTION
+/**
+ * Load the compiled key store, if it is up to date.
+ * @param mtime Current mtime of keys.conf.
+ * @return 0 on success; negative POSIX error code if keys.conf must be parsed.
+ */
+int KeyManagerPrivate::loadCompiled(time_t mtime)
+{
+	if (mtime == 0 || conf_filename.empty()) {
+		// No valid keys.conf mtime to validate against.
+		return -ENOENT;
+	}
+
+	const string bin_filename = conf_filename + ".bin";
+#ifdef _WIN32
+	FILE *f_bin = _tfopen(U82T_s(bin_filename), _T("rb"));
+#else /* !_WIN32 */
+	FILE *f_bin = fopen(bin_filename.c_str(), "rb");
+#endif /* _WIN32 */
+	if (!f_bin) {
+		// No compiled key store.
+		return -ENOENT;
+	}
+
+	// Read and validate the header.
+	CompiledKeysHeader header;
+	size_t size = fread(&header, 1, sizeof(header), f_bin);
+	if (size != sizeof(header) ||
+	    memcmp(header.magic, COMPILED_KEYS_MAGIC, sizeof(header.magic)) != 0 ||
+	    header.version != COMPILED_KEYS_VERSION ||
+	    header.conf_mtime != static_cast<int64_t>(mtime) ||
+	    header.key_count == 0 || header.key_count > COMPILED_KEYS_MAX_COUNT ||
+	    header.names_len == 0 || header.names_len > COMPILED_KEYS_MAX_BLOB_LEN ||
+	    header.vkeys_len > COMPILED_KEYS_MAX_BLOB_LEN)
+	{
+		// Stale or corrupted key store.
+		fclose(f_bin);
+		return -EIO;
+	}
+
+	// Read the key entries, the name blob, and the key data.
+	vector<CompiledKeyEntry> entries(header.key_count);
+	vector<char> names(header.names_len);
+	vKeys.resize(header.vkeys_len);
+	bool ok = (fread(entries.data(), sizeof(CompiledKeyEntry), entries.size(), f_bin) == entries.size());
+	ok = ok && (fread(names.data(), 1, names.size(), f_bin) == names.size());
+	ok = ok && (header.vkeys_len == 0 ||
+	            fread(vKeys.data(), 1, vKeys.size(), f_bin) == vKeys.size());
+	// Make sure there's no trailing data.
+	// This catches truncated or partial writes.
+	ok = ok && (fgetc(f_bin) == EOF);
+	fclose(f_bin);
+
+	// The name blob must be NUL-terminated.
+	ok = ok && (names[names.size()-1] == '\0');
+	if (ok) {
+		for (const CompiledKeyEntry &entry : entries) {
+			const uint32_t idx = (entry.keyIdx & 0xFFFFFF);
+			const uint8_t len = ((entry.keyIdx >> 24) & 0xFF);
+			if (entry.name_offset >= header.names_len ||
+			    idx + len > header.vkeys_len)
+			{
+				// Entry is out of bounds.
+				ok = false;
+				break;
+			}
+			mapKeyNames.emplace(&names[entry.name_offset], entry.keyIdx);
+		}
+	}
+
+	if (!ok) {
+		// Corrupted key store. Fall back to parsing keys.conf.
+		reset();
+		return -EIO;
+	}
+
+	// Keys loaded from the compiled key store.
+	return 0;
+}
+
+/**
+ * Save the compiled key store.
+ * @param mtime Current mtime of keys.conf.
+ */
+void KeyManagerPrivate::saveCompiled(time_t mtime)
+{
+	if (mtime == 0 || conf_filename.empty() || mapKeyNames.empty()) {
+		// Nothing to save, or no mtime to validate against.
+		return;
+	}
+
+	// Build the key entries and the name blob.
+	vector<CompiledKeyEntry> entries;
+	entries.reserve(mapKeyNames.size());
+	string names;
+	names.reserve(mapKeyNames.size() * 32);
+	for (const auto &pair : mapKeyNames) {
+		const CompiledKeyEntry entry = {static_cast<uint32_t>(names.size()), pair.second};
+		entries.push_back(entry);
+		names.append(pair.first);
+		names += '\0';
+	}
+
+	CompiledKeysHeader header;
+	memcpy(header.magic, COMPILED_KEYS_MAGIC, sizeof(header.magic));
+	header.version = COMPILED_KEYS_VERSION;
+	header.conf_mtime = static_cast<int64_t>(mtime);
+	header.key_count = static_cast<uint32_t>(entries.size());
+	header.names_len = static_cast<uint32_t>(names.size());
+	header.vkeys_len = static_cast<uint32_t>(vKeys.size());
+	header.reserved = 0;
+
+	// NOTE: If two processes write the key store at the same time,
+	// they're writing identical data from the same keys.conf, and a
+	// torn write fails validation in loadCompiled() and gets
+	// regenerated on the next load.
+	const string bin_filename = conf_filename + ".bin";
+#ifdef _WIN32
+	FILE *f_bin = _tfopen(U82T_s(bin_filename), _T("wb"));
+#else /* !_WIN32 */
+	FILE *f_bin = fopen(bin_filename.c_str(), "wb");
+#endif /* _WIN32 */
+	if (!f_bin) {
+		// Unable to write the key store. Not a fatal error.
+		return;
+	}
+
+#ifndef _WIN32
+	// The key store contains the same key material as keys.conf,
+	// so restrict it to the current user.
+	fchmod(fileno(f_bin), 0600);
+#endif /* !_WIN32 */
+
+	bool ok = (fwrite(&header, 1, sizeof(header), f_bin) == sizeof(header));
+	ok = ok && (fwrite(entries.data(), sizeof(CompiledKeyEntry), entries.size(), f_bin) == entries.size());
+	ok = ok && (fwrite(names.data(), 1, names.size(), f_bin) == names.size());
+	ok = ok && (vKeys.empty() ||
+	            fwrite(vKeys.data(), 1, vKeys.size(), f_bin) == vKeys.size());
+	if (fclose(f_bin) != 0) {
+		ok = false;
+	}
+
+	if (!ok) {
+		// Incomplete write. Remove the file; it would fail
+		// validation anyway.
+#ifdef _WIN32
+		_tremove(U82T_s(bin_filename));
+#else /* !_WIN32 */
+		remove(bin_filename.c_str());
+#endif /* _WIN32 */
+	}
+}
+#endif /* ENABLE_DECRYPTION */
+
 /** KeyManager **/
 
 KeyManager::KeyManager()
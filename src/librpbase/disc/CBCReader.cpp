@@ -399,4 +399,28 @@ off64_t CBCReader::size(void)
 	return d->length;
 }
 
+/**
+ * Get this file's linear mapping onto an underlying file.
+ * CBCReader is only trivially linear in passthru mode,
+ * i.e. if no encryption key was specified.
+ * @param pOffset	[out] Offset to add to file positions in the underlying file.
+ * @return Underlying file, or nullptr if encrypted or no file is open.
+ */
+IRpFilePtr CBCReader::getLinearMapping(off64_t *pOffset)
+{
+	RP_D(CBCReader);
+	if (!m_file) {
+		return nullptr;
+	}
+#ifdef ENABLE_DECRYPTION
+	if (d->cipher) {
+		// Encrypted. Reads are transformed, so this isn't linear.
+		return nullptr;
+	}
+#endif /* ENABLE_DECRYPTION */
+
+	*pOffset = d->offset;
+	return m_file;
+}
+
 }
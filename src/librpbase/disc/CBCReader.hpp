@@ -87,6 +87,15 @@ public:
 	 * @return Data size, or -1 on error.
 	 */
 	off64_t size(void) final;
+
+	/**
+	 * Get this file's linear mapping onto an underlying file.
+	 * CBCReader is only trivially linear in passthru mode,
+	 * i.e. if no encryption key was specified.
+	 * @param pOffset	[out] Offset to add to file positions in the underlying file.
+	 * @return Underlying file, or nullptr if encrypted or no file is open.
+	 */
+	LibRpFile::IRpFilePtr getLinearMapping(off64_t *pOffset) final;
 };
 
 typedef std::shared_ptr<CBCReader> CBCReaderPtr;
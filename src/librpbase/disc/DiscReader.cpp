@@ -179,4 +179,69 @@ off64_t DiscReader::size(void)
 	return m_length;
 }
 
+/**
+ * Advise the file of an upcoming read.
+ * The hint is forwarded to the underlying file,
+ * adjusted for the starting offset.
+ *
+ * @param offset	[in] Start of the range that will be read.
+ * @param size		[in] Length of the range, in bytes.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int DiscReader::advise(off64_t offset, size_t size)
+{
+	assert(m_file != nullptr);
+	if (!m_file) {
+		m_lastError = EBADF;
+		return -EBADF;
+	}
+
+	return m_file->advise(offset + m_offset, size);
+}
+
+/**
+ * Read data from multiple scattered disc image offsets.
+ *
+ * Entries are translated to the underlying file's offsets and
+ * forwarded as a single vector, so the file's optimized
+ * implementation (if any) is used.
+ *
+ * NOTE: The file position after this call is unspecified.
+ *
+ * @param vec	[in/out] Array of read vector entries.
+ * @param count	[in] Number of entries in vec.
+ * @return Number of entries that were fully read.
+ */
+size_t DiscReader::readVec(ReadVecEntry *vec, size_t count)
+{
+	assert(m_file != nullptr);
+	if (!m_file) {
+		m_lastError = EBADF;
+		return 0;
+	}
+
+	// Translate the offsets to the underlying file.
+	std::vector<ReadVecEntry> fileVec(vec, vec + count);
+	for (ReadVecEntry &entry : fileVec) {
+		entry.offset += m_offset;
+	}
+	return m_file->readVec(fileVec.data(), fileVec.size());
+}
+
+/**
+ * Get this file's linear mapping onto an underlying file.
+ * DiscReader is a pass-through, so it's always trivially linear.
+ * @param pOffset	[out] Offset to add to file positions in the underlying file.
+ * @return Underlying file, or nullptr if no file is open.
+ */
+IRpFilePtr DiscReader::getLinearMapping(off64_t *pOffset)
+{
+	if (!m_file) {
+		return nullptr;
+	}
+
+	*pOffset = m_offset;
+	return m_file;
+}
+
 }
@@ -89,6 +89,40 @@ class DiscReader final : public IDiscReader
 		 */
 		off64_t size(void) override;
 
+		/**
+		 * Advise the file of an upcoming read.
+		 * The hint is forwarded to the underlying file,
+		 * adjusted for the starting offset.
+		 *
+		 * @param offset	[in] Start of the range that will be read.
+		 * @param size		[in] Length of the range, in bytes.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int advise(off64_t offset, size_t size) final;
+
+		/**
+		 * Read data from multiple scattered disc image offsets.
+		 *
+		 * Entries are translated to the underlying file's offsets and
+		 * forwarded as a single vector, so the file's optimized
+		 * implementation (if any) is used.
+		 *
+		 * NOTE: The file position after this call is unspecified.
+		 *
+		 * @param vec	[in/out] Array of read vector entries.
+		 * @param count	[in] Number of entries in vec.
+		 * @return Number of entries that were fully read.
+		 */
+		size_t readVec(ReadVecEntry *vec, size_t count) final;
+
+		/**
+		 * Get this file's linear mapping onto an underlying file.
+		 * DiscReader is a pass-through, so it's always trivially linear.
+		 * @param pOffset	[out] Offset to add to file positions in the underlying file.
+		 * @return Underlying file, or nullptr if no file is open.
+		 */
+		LibRpFile::IRpFilePtr getLinearMapping(off64_t *pOffset) final;
+
 	protected:
 		// Offset/length. Useful for e.g. GameCube TGC.
 		off64_t m_offset;
@@ -81,6 +81,22 @@ class NOVTABLE IDiscReader : public LibRpFile::IRpFile, public std::enable_share
 			return 0;
 		}
 
+		/**
+		 * Set the expected access pattern for this file.
+		 * The hint is forwarded to the underlying file.
+		 * @param intent	[in] Access intent.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int setAccessIntent(AccessIntent intent) override
+		{
+			if (!m_file) {
+				m_lastError = EBADF;
+				return -EBADF;
+			}
+
+			return m_file->setAccessIntent(intent);
+		}
+
 	protected:
 		// The underlying file for this IDiscReader.
 		// May also be another IDiscReader for layering.
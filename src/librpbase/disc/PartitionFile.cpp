@@ -28,9 +28,21 @@ PartitionFile::PartitionFile(IDiscReaderPtr partition, off64_t offset, off64_t s
 	, m_offset(offset)
 	, m_size(size)
 	, m_pos(0)
+	, m_flatFile(partition)
+	, m_flatOffset(0)
 {
 	if (!m_partition) {
 		m_lastError = EBADF;
+		return;
+	}
+
+	// Flatten trivially-linear layers of the partition chain,
+	// so a read through a nested stack is one virtual call,
+	// not one per layer.
+	off64_t baseOffset;
+	for (LibRpFile::IRpFilePtr base; (base = m_flatFile->getLinearMapping(&baseOffset)); ) {
+		m_flatOffset += baseOffset;
+		m_flatFile = base;
 	}
 }
 
@@ -50,6 +62,8 @@ bool PartitionFile::isOpen(void) const
 void PartitionFile::close(void)
 {
 	m_partition = nullptr;
+	m_flatFile = nullptr;
+	m_flatOffset = 0;
 }
 
 /**
@@ -77,20 +91,12 @@ size_t PartitionFile::read(void *ptr, size_t size)
 		}
 	}
 
-	m_partition->clearError();
-	int iRet = m_partition->seek(m_offset + m_pos);
-	if (iRet != 0) {
-		m_lastError = m_partition->lastError();
-		return 0;
-	}
-
-	size_t ret = 0;
-	if (size > 0) {
-		m_partition->clearError();
-		ret = m_partition->read(ptr, size);
-		m_pos += ret;
-		m_lastError = m_partition->lastError();
-	}
+	// NOTE: Reading through the flattened target, which skips
+	// any trivially-linear layers of the partition chain.
+	m_flatFile->clearError();
+	size_t ret = m_flatFile->seekAndRead(m_flatOffset + m_offset + m_pos, ptr, size);
+	m_pos += ret;
+	m_lastError = m_flatFile->lastError();
 
 	return ret;
 }
@@ -148,6 +154,51 @@ off64_t PartitionFile::tell(void)
 	return m_pos;
 }
 
+/**
+ * Advise the file of an upcoming read.
+ * The hint is forwarded to the underlying IPartition,
+ * adjusted for the file's starting offset.
+ *
+ * @param offset	[in] Start of the range that will be read.
+ * @param size		[in] Length of the range, in bytes.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int PartitionFile::advise(off64_t offset, size_t size)
+{
+	if (!m_partition) {
+		m_lastError = EBADF;
+		return -EBADF;
+	}
+
+	if (offset < 0 || offset >= m_size || size == 0) {
+		// Out of range, or nothing to advise.
+		return 0;
+	}
+	if (offset + static_cast<off64_t>(size) > m_size) {
+		size = static_cast<size_t>(m_size - offset);
+	}
+
+	return m_flatFile->advise(m_flatOffset + m_offset + offset, size);
+}
+
+/**
+ * Get this file's linear mapping onto an underlying file.
+ * PartitionFile is a fixed offset into the partition chain, so
+ * it's trivially linear onto the deepest layer already flattened
+ * at construction time.
+ * @param pOffset	[out] Offset to add to file positions in the underlying file.
+ * @return Underlying file, or nullptr if no file is open.
+ */
+LibRpFile::IRpFilePtr PartitionFile::getLinearMapping(off64_t *pOffset)
+{
+	if (!m_flatFile) {
+		return nullptr;
+	}
+
+	*pOffset = m_flatOffset + m_offset;
+	return m_flatFile;
+}
+
 /** File properties. **/
 
 /**
@@ -77,6 +77,27 @@ class PartitionFile final : public LibRpFile::IRpFile
 		 */
 		off64_t tell(void) final;
 
+		/**
+		 * Advise the file of an upcoming read.
+		 * The hint is forwarded to the underlying IPartition,
+		 * adjusted for the file's starting offset.
+		 *
+		 * @param offset	[in] Start of the range that will be read.
+		 * @param size		[in] Length of the range, in bytes.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int advise(off64_t offset, size_t size) final;
+
+		/**
+		 * Get this file's linear mapping onto an underlying file.
+		 * PartitionFile is a fixed offset into the partition chain, so
+		 * it's trivially linear onto the deepest layer already flattened
+		 * at construction time.
+		 * @param pOffset	[out] Offset to add to file positions in the underlying file.
+		 * @return Underlying file, or nullptr if no file is open.
+		 */
+		LibRpFile::IRpFilePtr getLinearMapping(off64_t *pOffset) final;
+
 	public:
 		/** File properties. **/
 
@@ -91,6 +112,12 @@ class PartitionFile final : public LibRpFile::IRpFile
 		off64_t m_offset;	// File starting offset.
 		off64_t m_size;		// File size.
 		off64_t m_pos;		// Current position.
+
+		// Flattened read target: the deepest trivially-linear layer
+		// of the partition chain, plus the accumulated offset.
+		// If the chain isn't linear, this is m_partition with offset 0.
+		LibRpFile::IRpFilePtr m_flatFile;
+		off64_t m_flatOffset;
 };
 
 typedef std::shared_ptr<PartitionFile> PartitionFilePtr;
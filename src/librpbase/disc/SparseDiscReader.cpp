@@ -23,6 +23,8 @@ SparseDiscReaderPrivate::SparseDiscReaderPrivate(SparseDiscReader *q)
 	, disc_size(0)
 	, pos(-1)
 	, block_size(0)
+	, blockCacheTick(0)
+	, blockCacheMax(~0U)
 {
 	// NOTE: Can't check q->m_file here.
 
@@ -30,6 +32,40 @@ SparseDiscReaderPrivate::SparseDiscReaderPrivate(SparseDiscReader *q)
 	// set by the subclass.
 }
 
+/**
+ * Find the extent run containing the specified virtual offset.
+ * Runs must be sorted by virtual start offset.
+ *
+ * NOTE: Static so classes that can't derive from
+ * SparseDiscReaderPrivate (e.g. DpfReaderPrivate) can
+ * use it with their own extent maps.
+ *
+ * @param map		[in] Extent map.
+ * @param virt_offset	[in] Virtual offset.
+ * @return Extent run, or nullptr if the offset isn't covered by a run.
+ */
+const SparseDiscReaderPrivate::ExtentRun *SparseDiscReaderPrivate::lookupExtent(
+	const std::vector<ExtentRun> &map, off64_t virt_offset)
+{
+	// Find the first run starting *after* virt_offset,
+	// then step back to the run that could contain it.
+	auto iter = std::upper_bound(map.begin(), map.end(), virt_offset,
+		[](off64_t virt_offset, const ExtentRun &run) {
+			return (virt_offset < run.virt_start);
+		});
+	if (iter == map.begin()) {
+		// Offset is before the first run.
+		return nullptr;
+	}
+	--iter;
+
+	if (virt_offset >= iter->virt_start + iter->size) {
+		// Offset is in a gap between runs.
+		return nullptr;
+	}
+	return &(*iter);
+}
+
 /** SparseDiscReader **/
 
 SparseDiscReader::SparseDiscReader(SparseDiscReaderPrivate *d, const IRpFilePtr &file)
@@ -90,7 +126,7 @@ size_t SparseDiscReader::read(void *ptr, size_t size)
 		}
 
 		const unsigned int blockIdx = static_cast<unsigned int>(d->pos / block_size);
-		int rd = this->readBlock(blockIdx, blockStartOffset, ptr8, read_sz);
+		int rd = this->readBlockCached(blockIdx, blockStartOffset, ptr8, read_sz);
 		if (rd < 0 || rd != static_cast<int>(read_sz)) {
 			// Error reading the data.
 			return (rd > 0 ? rd : 0);
@@ -104,16 +140,24 @@ size_t SparseDiscReader::read(void *ptr, size_t size)
 	}
 
 	// Read entire blocks.
-	for (; size >= block_size;
-	    size -= block_size, ptr8 += block_size,
-	    ret += block_size, d->pos += block_size)
-	{
+	// NOTE: Multi-block reads go through readBlocks(), which
+	// subclasses can override to decode blocks in parallel.
+	if (size >= block_size) {
 		assert(d->pos % block_size == 0);
-		const unsigned int blockIdx = static_cast<unsigned int>(d->pos / block_size);
-		int rd = this->readBlock(blockIdx, 0, ptr8, block_size);
-		if (rd < 0 || rd != static_cast<int>(block_size)) {
+		const uint32_t blockCount = static_cast<uint32_t>(size / block_size);
+		const uint32_t blockIdx = static_cast<uint32_t>(d->pos / block_size);
+		int blocksRead = this->readBlocks(blockIdx, blockCount, ptr8);
+		if (blocksRead < 0) {
+			blocksRead = 0;
+		}
+		const size_t bytesRead = static_cast<size_t>(blocksRead) * block_size;
+		size -= bytesRead;
+		ptr8 += bytesRead;
+		ret += bytesRead;
+		d->pos += bytesRead;
+		if (blocksRead != static_cast<int>(blockCount)) {
 			// Error reading the data.
-			return ret + (rd > 0 ? rd : 0);
+			return ret;
 		}
 	}
 
@@ -124,7 +168,7 @@ size_t SparseDiscReader::read(void *ptr, size_t size)
 
 		// Read the start of the block.
 		const unsigned int blockIdx = static_cast<unsigned int>(d->pos / block_size);
-		int rd = this->readBlock(blockIdx, 0, ptr8, size);
+		int rd = this->readBlockCached(blockIdx, 0, ptr8, size);
 		if (rd < 0 || rd != static_cast<int>(size)) {
 			// Error reading the data.
 			return ret + (rd > 0 ? rd : 0);
@@ -138,6 +182,181 @@ size_t SparseDiscReader::read(void *ptr, size_t size)
 	return ret;
 }
 
+/**
+ * Read the specified block, using the decoded block cache.
+ *
+ * On a cache hit, the data is copied out of the cache without
+ * calling readBlock(). On a miss, the full block is read into
+ * the least-recently-used cache entry first.
+ *
+ * @param blockIdx	[in] Block index.
+ * @param pos		[in] Starting position. (Must be >= 0 and <= the block size!)
+ * @param ptr		[out] Output data buffer.
+ * @param size		[in] Amount of data to read, in bytes. (Must be <= the block size!)
+ * @return Number of bytes read, or -1 if the block index is invalid.
+ */
+int SparseDiscReader::readBlockCached(uint32_t blockIdx, int pos, void *ptr, size_t size)
+{
+	RP_D(SparseDiscReader);
+	if (d->blockCacheMax == 0) {
+		// Caching is disabled.
+		return this->readBlock(blockIdx, pos, ptr, size);
+	}
+	if (d->blockCacheMax == ~0U) {
+		// Determine the cache size on first use.
+		// Limit the cache to ~4 MB, and to 16 blocks.
+		// Subclasses with large blocks, e.g. WBFS, get fewer entries.
+		unsigned int max_blocks = static_cast<unsigned int>((4U*1024*1024) / d->block_size);
+		if (max_blocks > 16) {
+			max_blocks = 16;
+		} else if (max_blocks == 0) {
+			max_blocks = 1;
+		}
+		d->blockCacheMax = max_blocks;
+	}
+
+	// Check if the block is already cached.
+	SparseDiscReaderPrivate::CachedBlock *pLRU = nullptr;
+	for (auto &cb : d->blockCache) {
+		if (cb.blockIdx == blockIdx) {
+			// Cache hit.
+			cb.lruTick = ++d->blockCacheTick;
+			memcpy(ptr, &cb.data[pos], size);
+			return static_cast<int>(size);
+		}
+		if (!pLRU || cb.lruTick < pLRU->lruTick) {
+			pLRU = &cb;
+		}
+	}
+
+	// Cache miss. Select a cache entry to (re)use.
+	if (d->blockCache.size() < d->blockCacheMax) {
+		d->blockCache.resize(d->blockCache.size() + 1);
+		pLRU = &d->blockCache[d->blockCache.size() - 1];
+		pLRU->data.resize(d->block_size);
+	}
+	assert(pLRU != nullptr);
+
+	// Read the full block into the cache entry.
+	pLRU->blockIdx = ~0U;
+	int rd = this->readBlock(blockIdx, 0, pLRU->data.data(), d->block_size);
+	if (rd != static_cast<int>(d->block_size)) {
+		// Short read. This can happen for the last block of an
+		// image whose size isn't a multiple of the block size.
+		// Don't cache it; read the requested range directly.
+		return this->readBlock(blockIdx, pos, ptr, size);
+	}
+
+	pLRU->blockIdx = blockIdx;
+	pLRU->lruTick = ++d->blockCacheTick;
+	memcpy(ptr, &pLRU->data[pos], size);
+	return static_cast<int>(size);
+}
+
+/**
+ * Read multiple consecutive full blocks.
+ *
+ * The default implementation reads each block through the decoded
+ * block cache. Subclasses can override this to decode independent
+ * blocks in parallel for bulk reads.
+ *
+ * @param blockIdx	[in] Starting block index.
+ * @param blockCount	[in] Number of blocks to read.
+ * @param ptr		[out] Output data buffer. (Must be at least blockCount * block_size bytes.)
+ * @return Number of full blocks read. (< blockCount on error or short read)
+ */
+int SparseDiscReader::readBlocks(uint32_t blockIdx, uint32_t blockCount, void *ptr)
+{
+	RP_D(SparseDiscReader);
+	uint8_t *ptr8 = static_cast<uint8_t*>(ptr);
+	for (uint32_t i = 0; i < blockCount; i++, ptr8 += d->block_size) {
+		int rd = this->readBlockCached(blockIdx + i, 0, ptr8, d->block_size);
+		if (rd != static_cast<int>(d->block_size)) {
+			// Error reading the data.
+			return static_cast<int>(i);
+		}
+	}
+	return static_cast<int>(blockCount);
+}
+
+/**
+ * Set the decoded block cache size.
+ * @param blocks Maximum number of cached blocks. (0 to disable caching)
+ */
+void SparseDiscReader::setBlockCacheSize(unsigned int blocks)
+{
+	RP_D(SparseDiscReader);
+	d->blockCacheMax = blocks;
+	if (d->blockCache.size() > blocks) {
+		d->blockCache.resize(blocks);
+	}
+}
+
+/**
+ * Advise the disc image of an upcoming read.
+ *
+ * The logical extent is translated into physical block
+ * extents, which are forwarded to the underlying file so
+ * it can start readahead. Contiguous physical runs are
+ * coalesced into a single hint.
+ *
+ * @param offset	[in] Start of the range that will be read.
+ * @param size		[in] Length of the range, in bytes.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int SparseDiscReader::advise(off64_t offset, size_t size)
+{
+	RP_D(SparseDiscReader);
+	if (!m_file || d->disc_size <= 0 || d->block_size == 0) {
+		// Disc image wasn't initialized properly.
+		m_lastError = EBADF;
+		return -EBADF;
+	}
+
+	if (offset < 0 || offset >= d->disc_size || size == 0) {
+		// Out of range, or nothing to advise.
+		return 0;
+	}
+	if (offset + static_cast<off64_t>(size) > d->disc_size) {
+		size = static_cast<size_t>(d->disc_size - offset);
+	}
+
+	const uint32_t blockStart = static_cast<uint32_t>(offset / d->block_size);
+	const uint32_t blockEnd = static_cast<uint32_t>((offset + size - 1) / d->block_size);
+
+	// Forward the physical extents, coalescing contiguous runs.
+	// NOTE: The physical block size isn't known in the base class for
+	// compressed formats, so the logical block size is used as an
+	// approximation. This is only a hint, so that's good enough.
+	off64_t runStart = -1;
+	off64_t runEnd = 0;
+	for (uint32_t blockIdx = blockStart; blockIdx <= blockEnd; blockIdx++) {
+		const off64_t physBlockAddr = this->getPhysBlockAddr(blockIdx);
+		if (physBlockAddr <= 0) {
+			// Empty or invalid block.
+			continue;
+		}
+
+		if (runStart >= 0 && physBlockAddr == runEnd) {
+			// Contiguous with the current run.
+			runEnd += d->block_size;
+			continue;
+		}
+
+		// Not contiguous. Flush the current run.
+		if (runStart >= 0) {
+			m_file->advise(runStart, static_cast<size_t>(runEnd - runStart));
+		}
+		runStart = physBlockAddr;
+		runEnd = physBlockAddr + d->block_size;
+	}
+
+	if (runStart >= 0) {
+		m_file->advise(runStart, static_cast<size_t>(runEnd - runStart));
+	}
+	return 0;
+}
+
 /**
  * Set the disc image position.
  * @param pos disc image position.
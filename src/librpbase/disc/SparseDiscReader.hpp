@@ -59,6 +59,30 @@ class NOVTABLE SparseDiscReader : public IDiscReader
 		 */
 		off64_t size(void) final;
 
+		/**
+		 * Set the decoded block cache size.
+		 *
+		 * The default is determined on first read: up to 16 blocks,
+		 * limited to a total of ~4 MB for large block sizes.
+		 *
+		 * @param blocks Maximum number of cached blocks. (0 to disable caching)
+		 */
+		void setBlockCacheSize(unsigned int blocks);
+
+		/**
+		 * Advise the disc image of an upcoming read.
+		 *
+		 * The logical extent is translated into physical block
+		 * extents, which are forwarded to the underlying file so
+		 * it can start readahead. Contiguous physical runs are
+		 * coalesced into a single hint.
+		 *
+		 * @param offset	[in] Start of the range that will be read.
+		 * @param size		[in] Length of the range, in bytes.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int advise(off64_t offset, size_t size) override;
+
 	protected:
 		/** Virtual functions for SparseDiscReader subclasses. **/
 
@@ -93,6 +117,37 @@ class NOVTABLE SparseDiscReader : public IDiscReader
 		 */
 		ATTR_ACCESS_SIZE(write_only, 4, 5)
 		virtual int readBlock(uint32_t blockIdx, int pos, void *ptr, size_t size);
+
+		/**
+		 * Read multiple consecutive full blocks.
+		 *
+		 * The default implementation reads each block through the
+		 * decoded block cache. Subclasses can override this to
+		 * decode independent blocks in parallel for bulk reads.
+		 *
+		 * @param blockIdx	[in] Starting block index.
+		 * @param blockCount	[in] Number of blocks to read.
+		 * @param ptr		[out] Output data buffer. (Must be at least blockCount * block_size bytes.)
+		 * @return Number of full blocks read. (< blockCount on error or short read)
+		 */
+		virtual int readBlocks(uint32_t blockIdx, uint32_t blockCount, void *ptr);
+
+	private:
+		/**
+		 * Read the specified block, using the decoded block cache.
+		 *
+		 * On a cache hit, the data is copied out of the cache
+		 * without calling readBlock(). On a miss, the full block
+		 * is read into the least-recently-used cache entry first.
+		 *
+		 * @param blockIdx	[in] Block index.
+		 * @param pos		[in] Starting position. (Must be >= 0 and <= the block size!)
+		 * @param ptr		[out] Output data buffer.
+		 * @param size		[in] Amount of data to read, in bytes. (Must be <= the block size!)
+		 * @return Number of bytes read, or -1 if the block index is invalid.
+		 */
+		ATTR_ACCESS_SIZE(write_only, 4, 5)
+		int readBlockCached(uint32_t blockIdx, int pos, void *ptr, size_t size);
 };
 
 }
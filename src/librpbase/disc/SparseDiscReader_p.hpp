@@ -13,6 +13,12 @@
 #include <stdint.h>
 #include "common.h"
 
+// Uninitialized vector class
+#include "uvector.h"
+
+// C++ includes
+#include <vector>
+
 namespace LibRpBase {
 
 class SparseDiscReader;
@@ -33,6 +39,46 @@ class SparseDiscReaderPrivate
 		off64_t disc_size;		// Virtual disc image size.
 		off64_t pos;			// Read position.
 		unsigned int block_size;	// Block size.
+
+	public:
+		// Decoded block LRU cache.
+		// Shared by all SparseDiscReader subclasses so blocks that
+		// are revisited by header+banner+FST reads are only
+		// decompressed/remapped once.
+		struct CachedBlock {
+			uint32_t blockIdx;		// Block index. (~0U if invalid)
+			uint64_t lruTick;		// Last access tick for LRU eviction.
+			rp::uvector<uint8_t> data;	// Decoded block data.
+		};
+		std::vector<CachedBlock> blockCache;
+		uint64_t blockCacheTick;	// Monotonic access counter.
+		unsigned int blockCacheMax;	// Maximum cached blocks. (~0U == not initialized yet)
+
+	public:
+		// Compact logical→physical extent map.
+		// Coalesced runs instead of per-block tables: formats with
+		// fine-grained mappings (NASOS, DPF/RPF) collapse to a few
+		// runs, shrinking memory and making translation O(log runs).
+		struct ExtentRun {
+			off64_t virt_start;	// Virtual (logical) start offset.
+			off64_t phys_start;	// Physical start offset. (-1 == empty/zero run)
+			off64_t size;		// Run length, in bytes.
+		};
+		std::vector<ExtentRun> extentMap;	// Sorted by virt_start.
+
+		/**
+		 * Find the extent run containing the specified virtual offset.
+		 * Runs must be sorted by virtual start offset.
+		 *
+		 * NOTE: Static so classes that can't derive from
+		 * SparseDiscReaderPrivate (e.g. DpfReaderPrivate) can
+		 * use it with their own extent maps.
+		 *
+		 * @param map		[in] Extent map.
+		 * @param virt_offset	[in] Virtual offset.
+		 * @return Extent run, or nullptr if the offset isn't covered by a run.
+		 */
+		static const ExtentRun *lookupExtent(const std::vector<ExtentRun> &map, off64_t virt_offset);
 };
 
 }
@@ -11,6 +11,7 @@
 
 #include "RpImageLoader.hpp"
 #include "librpfile/IRpFile.hpp"
+#include "librpfile/MemFile.hpp"
 
 // Other rom-properties libraries
 using namespace LibRpFile;
@@ -31,6 +32,7 @@ extern "C" {
 
 // C++ STL classes
 using std::array;
+using std::unique_ptr;
 
 namespace LibRpBase { namespace RpImageLoader {
 
@@ -41,25 +43,34 @@ static constexpr array<uint8_t, 4> jpeg_magic = {{'J','F','I','F'}};
 static constexpr array<uint8_t, 4> exif_magic = {{'E','x','i','f'}};
 #endif /* HAVE_JPEG */
 
-/** RpImageLoader **/
+// Maximum file size to buffer in memory for decoding.
+// Files up to this size are read with a single sequential read and
+// decoded from memory, which avoids the decoder's many small reads
+// and seeks. (painful on KIO/gvfs-backed files)
+static constexpr off64_t MAX_BUFFER_SIZE = 16U*1024*1024;
+
+// Detected image format
+enum class ImageFormat {
+	Unknown = 0,
+	PNG,
+#ifdef HAVE_JPEG
+	JPEG,
+#endif /* HAVE_JPEG */
+};
 
 /**
- * Load an image from an IRpFile.
- * @param file IRpFile to load from.
- * @return rp_image*, or nullptr on error.
+ * Detect the image format from the file header.
+ * @param buf Header data
+ * @param sz Size of buf
+ * @return Detected image format
  */
-rp_image_ptr load(const IRpFilePtr &file)
+static ImageFormat detectImageFormat(const uint8_t *buf, size_t sz)
 {
-	file->rewind();
-
-	// Check the file header to see what kind of image this is.
-	uint8_t buf[256];
-	size_t sz = file->read(buf, sizeof(buf));
 	if (sz >= sizeof(png_magic)) {
 		// Check for PNG.
 		if (!memcmp(buf, png_magic.data(), png_magic.size())) {
 			// Found a PNG image.
-			return RpPng::load(file);
+			return ImageFormat::PNG;
 		}
 #ifdef HAVE_JPEG
 		else if (buf[0] == 0xFF && buf[1] != 0xFF && buf[2] == 0xFF) {
@@ -69,14 +80,116 @@ rp_image_ptr load(const IRpFilePtr &file)
 			    !memcmp(&buf[6], exif_magic.data(), exif_magic.size()))
 			{
 				// Found a JPEG image.
-				return RpJpeg::load(file);
+				return ImageFormat::JPEG;
 			}
 		}
 #endif /* HAVE_JPEG */
 	}
 
+	// Unsupported image format.
+	return ImageFormat::Unknown;
+}
+
+/**
+ * Decode an image from an IRpFile using the specified format's decoder.
+ * @param fmt Image format
+ * @param file IRpFile to load from
+ * @param req_size [in,opt] Requested minimum size, or 0 for full size
+ * @return rp_image*, or nullptr on error.
+ */
+static rp_image_ptr decode(ImageFormat fmt, const IRpFilePtr &file, int req_size)
+{
+	switch (fmt) {
+		case ImageFormat::PNG:
+			// NOTE: PNG doesn't support scaled decoding,
+			// so req_size is only used for JPEG.
+			return RpPng::load(file);
+#ifdef HAVE_JPEG
+		case ImageFormat::JPEG:
+			return RpJpeg::load(file, req_size);
+#endif /* HAVE_JPEG */
+		default:
+			break;
+	}
+
 	// Unsupported image format.
 	return nullptr;
 }
 
+/** RpImageLoader **/
+
+/**
+ * Load an image from an IRpFile.
+ *
+ * req_size is a decode hint: formats that support scaled decoding
+ * (currently JPEG) may decode at a reduced scale, as long as the
+ * smaller dimension stays at or above req_size.
+ *
+ * @param file IRpFile to load from.
+ * @param req_size [in,opt] Requested minimum size, or 0 for full size.
+ * @return rp_image*, or nullptr on error.
+ */
+rp_image_ptr load(const IRpFilePtr &file, int req_size)
+{
+	file->rewind();
+
+	// Check the file header to see what kind of image this is.
+	// NOTE: The sniff buffer is also the start of the decode buffer,
+	// so the header is only transferred once.
+	uint8_t buf[256];
+	const size_t sz = file->read(buf, sizeof(buf));
+	const ImageFormat fmt = detectImageFormat(buf, sz);
+	if (fmt == ImageFormat::Unknown) {
+		// Unsupported image format.
+		return nullptr;
+	}
+
+	const off64_t fileSize = file->size();
+	if (fileSize > 0 && fileSize <= static_cast<off64_t>(sizeof(buf)) &&
+	    sz >= static_cast<size_t>(fileSize))
+	{
+		// The sniff buffer already contains the entire file.
+		// Decode it directly from the buffer.
+		const IRpFilePtr memFile = std::make_shared<MemFile>(buf, static_cast<size_t>(fileSize));
+		return decode(fmt, memFile, req_size);
+	} else if (fileSize > static_cast<off64_t>(sizeof(buf)) && fileSize <= MAX_BUFFER_SIZE) {
+		// Read the rest of the file with a single sequential read
+		// and decode it from memory.
+		unique_ptr<uint8_t[]> fullbuf(new uint8_t[static_cast<size_t>(fileSize)]);
+		memcpy(fullbuf.get(), buf, sz);
+		const size_t remaining = static_cast<size_t>(fileSize) - sz;
+		if (file->read(&fullbuf[sz], remaining) == remaining) {
+			const IRpFilePtr memFile = std::make_shared<MemFile>(fullbuf.get(), static_cast<size_t>(fileSize));
+			return decode(fmt, memFile, req_size);
+		}
+		// Short read; fall back to decoding from the file directly.
+	}
+
+	// File is too big to buffer (or the buffered read failed).
+	// Decode it from the file directly.
+	file->rewind();
+	return decode(fmt, file, req_size);
+}
+
+/**
+ * Load an image from an IRpFile, asynchronously.
+ *
+ * The image is decoded on a separate thread, so the caller can
+ * do other work (e.g. field population) while waiting on the
+ * returned future.
+ *
+ * NOTE: The IRpFile is used by the decode thread. The caller must
+ * not access the file until the future is ready.
+ *
+ * @param file IRpFile to load from.
+ * @param req_size [in,opt] Requested minimum size, or 0 for full size.
+ * @return std::future for the decoded rp_image. (nullptr on error)
+ */
+std::future<rp_image_ptr> loadAsync(const IRpFilePtr &file, int req_size)
+{
+	return std::async(std::launch::async, [file, req_size]() -> rp_image_ptr {
+		return load(file, req_size);
+	});
+}
+
 } }
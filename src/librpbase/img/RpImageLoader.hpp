@@ -14,14 +14,40 @@
 #include "librpfile/IRpFile.hpp"
 #include "librptexture/img/rp_image.hpp"
 
+// C++ includes
+#include <future>
+
 namespace LibRpBase { namespace RpImageLoader {
 
 /**
  * Load an image from an IRpFile.
+ *
+ * req_size is a decode hint: formats that support scaled decoding
+ * (currently JPEG) may decode at a reduced scale, as long as the
+ * smaller dimension stays at or above req_size.
+ *
  * @param file IRpFile to load from.
+ * @param req_size [in,opt] Requested minimum size, or 0 for full size.
  * @return rp_image*, or nullptr on error.
  */
 RP_LIBROMDATA_PUBLIC
-LibRpTexture::rp_image_ptr load(const LibRpFile::IRpFilePtr &file);
+LibRpTexture::rp_image_ptr load(const LibRpFile::IRpFilePtr &file, int req_size = 0);
+
+/**
+ * Load an image from an IRpFile, asynchronously.
+ *
+ * The image is decoded on a separate thread, so the caller can
+ * do other work (e.g. field population) while waiting on the
+ * returned future.
+ *
+ * NOTE: The IRpFile is used by the decode thread. The caller must
+ * not access the file until the future is ready.
+ *
+ * @param file IRpFile to load from.
+ * @param req_size [in,opt] Requested minimum size, or 0 for full size.
+ * @return std::future for the decoded rp_image. (nullptr on error)
+ */
+RP_LIBROMDATA_PUBLIC
+std::future<LibRpTexture::rp_image_ptr> loadAsync(const LibRpFile::IRpFilePtr &file, int req_size = 0);
 
 } }
@@ -28,10 +28,17 @@ class RpJpeg
 	public:
 		/**
 		 * Load a JPEG image from an IRpFile.
+		 *
+		 * If a target size is specified, the image may be decoded at a
+		 * reduced scale (1/2, 1/4, 1/8) using libjpeg's scaled IDCT,
+		 * as long as the smaller dimension stays at or above req_size.
+		 * This is significantly faster for thumbnailing large scans.
+		 *
 		 * @param file IRpFile to load from.
+		 * @param req_size [in,opt] Requested minimum size, or 0 for full size.
 		 * @return rp_image*, or nullptr on error.
 		 */
-		static LibRpTexture::rp_image_ptr load(const LibRpFile::IRpFilePtr &file);
+		static LibRpTexture::rp_image_ptr load(const LibRpFile::IRpFilePtr &file, int req_size = 0);
 };
 
 }
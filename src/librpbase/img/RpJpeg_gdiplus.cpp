@@ -34,11 +34,18 @@ namespace LibRpBase {
 
 /**
  * Load a JPEG image from an IRpFile.
+ *
+ * NOTE: The GDI+ decoder always decodes at full size.
+ * req_size is accepted for interface compatibility only.
+ *
  * @param file IRpFile to load from.
+ * @param req_size [in,opt] Requested minimum size, or 0 for full size.
  * @return rp_image*, or nullptr on error.
  */
-rp_image_ptr RpJpeg::load(const IRpFilePtr &file)
+rp_image_ptr RpJpeg::load(const IRpFilePtr &file, int req_size)
 {
+	RP_UNUSED(req_size);
+
 	if (!file)
 		return nullptr;
 
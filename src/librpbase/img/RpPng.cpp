@@ -434,6 +434,11 @@ static rp_image_ptr loadPng(png_structp png_ptr, png_infop info_ptr)
 	}
 
 	// Initialize the row pointers array.
+	// NOTE: The row pointers point directly into the rp_image
+	// backend, so libpng decodes straight into the final buffer
+	// with no intermediate copy. Pixel format differences are
+	// handled by libpng transforms set above (BGR ordering,
+	// alpha filler/swap), so no post-read swizzle is needed.
 	const png_byte *pb = static_cast<const png_byte*>(img->bits());
 	const int stride = img->stride();
 	for (png_uint_32 y = 0; y < height; y++, pb += stride) {
@@ -110,18 +110,21 @@ class RpPngWriterPrivate
 		RpPngWriterPrivate(const IRpFilePtr &file, int width, int height, rp_image::Format format)
 			: lastError(0), file(file), imageTag(ImageTag::Invalid)
 			, png_ptr(nullptr), info_ptr(nullptr), IHDR_written(false)
+			, profile(RpPngWriter::CompressionProfile::Default)
 		{
 			init(width, height, format);
 		}
 		RpPngWriterPrivate(const IRpFilePtr &file, const rp_image_const_ptr &img)
 			: lastError(0), file(file), imageTag(ImageTag::Invalid)
 			, png_ptr(nullptr), info_ptr(nullptr), IHDR_written(false)
+			, profile(RpPngWriter::CompressionProfile::Default)
 		{
 			init(img);
 		}
 		RpPngWriterPrivate(const IRpFilePtr &file, const IconAnimDataConstPtr &iconAnimData)
 			: lastError(0), file(file), imageTag(ImageTag::Invalid)
 			, png_ptr(nullptr), info_ptr(nullptr), IHDR_written(false)
+			, profile(RpPngWriter::CompressionProfile::Default)
 		{
 			init(iconAnimData);
 		}
@@ -129,6 +132,7 @@ class RpPngWriterPrivate
 		RpPngWriterPrivate(const char *filename, int width, int height, rp_image::Format format)
 			: lastError(0), imageTag(ImageTag::Invalid)
 			, png_ptr(nullptr), info_ptr(nullptr), IHDR_written(false)
+			, profile(RpPngWriter::CompressionProfile::Default)
 		{
 			file.reset(filename ? new RpFile(filename, RpFile::FM_CREATE_WRITE) : nullptr);
 			init(width, height, format);
@@ -136,6 +140,7 @@ class RpPngWriterPrivate
 		RpPngWriterPrivate(const char *filename, const rp_image_const_ptr &img)
 			: lastError(0), imageTag(ImageTag::Invalid)
 			, png_ptr(nullptr), info_ptr(nullptr), IHDR_written(false)
+			, profile(RpPngWriter::CompressionProfile::Default)
 		{
 			file.reset(filename ? new RpFile(filename, RpFile::FM_CREATE_WRITE) : nullptr);
 			init(img);
@@ -143,6 +148,7 @@ class RpPngWriterPrivate
 		RpPngWriterPrivate(const char *filename, const IconAnimDataConstPtr &iconAnimData)
 			: lastError(0), imageTag(ImageTag::Invalid)
 			, png_ptr(nullptr), info_ptr(nullptr), IHDR_written(false)
+			, profile(RpPngWriter::CompressionProfile::Default)
 		{
 			file.reset(filename ? new RpFile(filename, RpFile::FM_CREATE_WRITE) : nullptr);
 			init(iconAnimData);
@@ -152,6 +158,7 @@ class RpPngWriterPrivate
 		RpPngWriterPrivate(const wchar_t *filename, int width, int height, rp_image::Format format)
 			: lastError(0), imageTag(ImageTag::Invalid)
 			, png_ptr(nullptr), info_ptr(nullptr), IHDR_written(false)
+			, profile(RpPngWriter::CompressionProfile::Default)
 		{
 			file.reset(filename ? new RpFile(filename, RpFile::FM_CREATE_WRITE) : nullptr);
 			init(width, height, format);
@@ -159,6 +166,7 @@ class RpPngWriterPrivate
 		RpPngWriterPrivate(const wchar_t *filename, const rp_image_const_ptr &img)
 			: lastError(0), imageTag(ImageTag::Invalid)
 			, png_ptr(nullptr), info_ptr(nullptr), IHDR_written(false)
+			, profile(RpPngWriter::CompressionProfile::Default)
 		{
 			file.reset(filename ? new RpFile(filename, RpFile::FM_CREATE_WRITE) : nullptr);
 			init(img);
@@ -166,6 +174,7 @@ class RpPngWriterPrivate
 		RpPngWriterPrivate(const wchar_t *filename, const IconAnimDataConstPtr &iconAnimData)
 			: lastError(0), imageTag(ImageTag::Invalid)
 			, png_ptr(nullptr), info_ptr(nullptr), IHDR_written(false)
+			, profile(RpPngWriter::CompressionProfile::Default)
 		{
 			file.reset(filename ? new RpFile(filename, RpFile::FM_CREATE_WRITE) : nullptr);
 			init(iconAnimData);
@@ -201,6 +210,23 @@ class RpPngWriterPrivate
 		rp_image_const_ptr img;
 		IconAnimDataConstPtr iconAnimData;
 
+		// APNG frame write plan.
+		// Consecutive sequence entries that reference the same frame
+		// are merged into a single APNG frame with a combined delay,
+		// so duplicated frames are only compressed and written once.
+		struct apng_frame_t {
+			int frame;	// Frame index in iconAnimData->frames[]
+			uint16_t numer;	// Delay numerator
+			uint16_t denom;	// Delay denominator
+		};
+		std::vector<apng_frame_t> apngFrames;
+
+		/**
+		 * Build the APNG frame write plan from iconAnimData.
+		 * Called by init() for animated images.
+		 */
+		void buildAPNGFramePlan(void);
+
 		// Cached width, height, and image format.
 		struct cache_t {
 			int width;
@@ -287,6 +313,10 @@ class RpPngWriterPrivate
 		// Current state.
 		bool IHDR_written;
 
+		// Compression profile.
+		// Applied when writing IHDR.
+		RpPngWriter::CompressionProfile profile;
+
 	public:
 		/**
 		 * Initialize the PNG write structs.
@@ -564,6 +594,7 @@ void RpPngWriterPrivate::init(const IconAnimDataConstPtr &iconAnimData)
 			imageTag = ImageTag::Invalid;
 		}
 		cache.setFrom(img0);
+		buildAPNGFramePlan();
 	} else {
 		this->img = iconAnimData->frames[iconAnimData->seq_index[0]];
 		cache.setFrom(this->img);
@@ -578,6 +609,40 @@ void RpPngWriterPrivate::init(const IconAnimDataConstPtr &iconAnimData)
 	}
 }
 
+/**
+ * Build the APNG frame write plan from iconAnimData.
+ * Called by init() for animated images.
+ */
+void RpPngWriterPrivate::buildAPNGFramePlan(void)
+{
+	assert(iconAnimData != nullptr);
+	if (!iconAnimData)
+		return;
+
+	apngFrames.clear();
+	apngFrames.reserve(iconAnimData->seq_count);
+	for (int i = 0; i < iconAnimData->seq_count; i++) {
+		const int frame = iconAnimData->seq_index[i];
+		const IconAnimData::delay_t &delay = iconAnimData->delays[i];
+
+		if (!apngFrames.empty()) {
+			// Check if this entry can be merged into the previous one.
+			// NOTE: Only merging if the denominators match and the
+			// combined numerator fits in 16 bits. (fcTL uses uint16_t.)
+			apng_frame_t &prev = apngFrames.back();
+			if (prev.frame == frame && prev.denom == delay.denom &&
+			    (static_cast<unsigned int>(prev.numer) + delay.numer) <= 0xFFFFU)
+			{
+				// Same frame: extend the previous entry's delay.
+				prev.numer += delay.numer;
+				continue;
+			}
+		}
+
+		apngFrames.push_back({frame, delay.numer, delay.denom});
+	}
+}
+
 RpPngWriterPrivate::~RpPngWriterPrivate()
 {
 	this->close();
@@ -913,8 +978,10 @@ int RpPngWriterPrivate::write_IDAT_APNG(void)
 	}
 
 	// Write the images.
-	for (int i = 0; i < iconAnimData->seq_count; i++) {
-		const rp_image_const_ptr &img = iconAnimData->frames[iconAnimData->seq_index[i]];
+	// NOTE: Iterating over the merged frame plan, so consecutive
+	// duplicate frames are only compressed and written once.
+	for (const apng_frame_t &apngFrame : apngFrames) {
+		const rp_image_const_ptr &img = iconAnimData->frames[apngFrame.frame];
 		if (!img)
 			break;
 
@@ -926,8 +993,7 @@ int RpPngWriterPrivate::write_IDAT_APNG(void)
 		// Frame header.
 		png_write_frame_head(png_ptr, info_ptr, (png_bytepp)row_pointers,
 				cache.width, cache.height, 0, 0,	// width, height, x offset, y offset
-				iconAnimData->delays[i].numer,
-				iconAnimData->delays[i].denom,
+				apngFrame.numer, apngFrame.denom,
 				PNG_DISPOSE_OP_NONE,
 				PNG_BLEND_OP_SOURCE);
 
@@ -1188,6 +1254,26 @@ void RpPngWriter::close(void)
 	d->close();
 }
 
+/**
+ * Set the PNG compression profile.
+ * This must be called before write_IHDR().
+ * @param profile Compression profile.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int RpPngWriter::setCompressionProfile(CompressionProfile profile)
+{
+	RP_D(RpPngWriter);
+	assert(!d->IHDR_written);
+	if (d->IHDR_written) {
+		// IHDR has already been written.
+		d->lastError = EEXIST;
+		return -EEXIST;
+	}
+
+	d->profile = profile;
+	return 0;
+}
+
 /**
  * Write the PNG IHDR.
  * This must be called before writing any other image data.
@@ -1230,9 +1316,34 @@ int RpPngWriter::write_IHDR(void)
 #endif /* PNG_SETJMP_SUPPORTED */
 
 	// Initialize compression parameters.
-	// TODO: Customizable?
-	png_set_filter(d->png_ptr, 0, PNG_FILTER_NONE);
-	png_set_compression_level(d->png_ptr, PNG_Z_DEFAULT_COMPRESSION);
+	switch (d->profile) {
+		default:
+		case CompressionProfile::Default:
+			png_set_filter(d->png_ptr, 0, PNG_FILTER_NONE);
+			png_set_compression_level(d->png_ptr, PNG_Z_DEFAULT_COMPRESSION);
+			break;
+
+		case CompressionProfile::Speed:
+			// Fast encode profile for batch thumbnailing:
+			// fastest zlib level with the RLE strategy, which only
+			// searches for run-length matches. Filtering stays
+			// NONE-only; trying additional filters per row would
+			// cost more than the deflate savings here.
+			png_set_filter(d->png_ptr, 0, PNG_FILTER_NONE);
+			png_set_compression_level(d->png_ptr, Z_BEST_SPEED);
+			png_set_compression_strategy(d->png_ptr, Z_RLE);
+			break;
+
+		case CompressionProfile::Store:
+			// Store-only profile: zlib level 0 emits stored
+			// (uncompressed) deflate blocks, so IDAT is a plain
+			// memcpy. The output is still a valid PNG. Useful for
+			// write-once caches where encode time matters more
+			// than file size.
+			png_set_filter(d->png_ptr, 0, PNG_FILTER_NONE);
+			png_set_compression_level(d->png_ptr, Z_NO_COMPRESSION);
+			break;
+	}
 
 	// Write the PNG header.
 	switch (d->cache.format) {
@@ -1283,7 +1394,10 @@ int RpPngWriter::write_IHDR(void)
 
 	if (d->imageTag == RpPngWriterPrivate::ImageTag::IconAnimData) {
 		// Write an acTL chunk to indicate that this is an APNG image.
-		png_set_acTL(d->png_ptr, d->info_ptr, d->iconAnimData->seq_count, 0);
+		// NOTE: Using the merged frame plan's count, since consecutive
+		// duplicate frames are written as a single frame.
+		png_set_acTL(d->png_ptr, d->info_ptr,
+			static_cast<png_uint_32>(d->apngFrames.size()), 0);
 	}
 
 #ifdef PNG_sBIT_SUPPORTED
@@ -238,6 +238,23 @@ public:
 	 */
 	void close(void);
 
+	/**
+	 * PNG compression profile.
+	 */
+	enum class CompressionProfile : uint8_t {
+		Default = 0,	// zlib default compression level
+		Speed,		// Z_BEST_SPEED + Z_RLE (fast encode for thumbnailing)
+		Store,		// Z_NO_COMPRESSION (stored deflate blocks; write-once caches)
+	};
+
+	/**
+	 * Set the PNG compression profile.
+	 * This must be called before write_IHDR().
+	 * @param profile Compression profile.
+	 * @return 0 on success; negative POSIX error code on error.
+	 */
+	int setCompressionProfile(CompressionProfile profile);
+
 	/**
 	 * Write the PNG IHDR.
 	 * This must be called before writing any other image data.
@@ -75,12 +75,16 @@
 #ifdef __cplusplus
 // librpbase C++ headers
 #include "librptext/conversion.hpp"
+#include "librptext/int_format.hpp"
 #include "librptext/printf.hpp"
 
 // Uninitialized vector class.
 // Reference: http://andreoffringa.org/?q=uvector
 #include "uvector.h"
 
+// Per-thread aligned scratch arena.
+#include "aligned_arena.h"
+
 // librpfile C++ headers
 #include "librpfile/RpFile.hpp"
 #endif /* !__cplusplus */
@@ -0,0 +1,261 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase/tests)                  *
+ * FieldCacheTest.cpp: FieldCache serialization test.                      *
+ *                                                                         *
+ * Copyright (c) 2016-2024 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+// Google Test
+#include "gtest/gtest.h"
+#include "tcharx.h"
+
+// FieldCache
+#include "librpbase/FieldCache.hpp"
+#include "librpbase/RomFields.hpp"
+#include "librpbase/RomMetaData.hpp"
+
+// C includes (C++ namespace)
+#include <cstdio>
+#include <cstdlib>
+
+// C++ STL classes
+#include <string>
+#include <vector>
+using std::string;
+using std::vector;
+
+namespace LibRpBase { namespace Tests {
+
+class FieldCacheTest : public ::testing::Test
+{
+	protected:
+		FieldCacheTest() = default;
+
+		void SetUp(void) final
+		{
+#ifndef _WIN32
+			// Redirect the cache directory to a temporary directory
+			// so the test doesn't touch the user's real cache.
+			// NOTE: Only effective before the first getCacheDirectory()
+			// call in this process.
+			const char *tmpdir = getenv("TMPDIR");
+			if (!tmpdir || tmpdir[0] == '\0') {
+				tmpdir = "/tmp";
+			}
+			string cache_home(tmpdir);
+			cache_home += "/FieldCacheTest.cache";
+			setenv("XDG_CACHE_HOME", cache_home.c_str(), 1);
+#endif /* !_WIN32 */
+
+			// Create the source file.
+			// NOTE: One file per test, so a cache file written by
+			// one test can't satisfy a lookup in another.
+			m_srcFilename = "FieldCacheTest.";
+			m_srcFilename += ::testing::UnitTest::GetInstance()->current_test_info()->name();
+			m_srcFilename += ".bin";
+			FILE *const f = fopen(m_srcFilename.c_str(), "wb");
+			ASSERT_TRUE(f != nullptr);
+			static const char data[] = "FieldCacheTest source file";
+			ASSERT_EQ(sizeof(data), fwrite(data, 1, sizeof(data), f));
+			fclose(f);
+		}
+
+		void TearDown(void) final
+		{
+			remove(m_srcFilename.c_str());
+		}
+
+		/**
+		 * Build a representative RomFields object.
+		 * @param fields RomFields.
+		 */
+		static void buildFields(RomFields &fields)
+		{
+			fields.setTabName(0, "Tab0");
+			fields.addField_string("String", "value", RomFields::STRF_MONOSPACE);
+			fields.addField_bitfield("Bitfield",
+				RomFields::strArrayToVector(bitfield_names, ARRAY_SIZE(bitfield_names)),
+				3, 0x5U);
+			fields.addField_dateTime("DateTime", 1234567890,
+				RomFields::RFT_DATETIME_HAS_DATE | RomFields::RFT_DATETIME_HAS_TIME);
+			fields.addField_dimensions("Dimensions", 256, 128, 0);
+
+			RomFields::age_ratings_t age_ratings;
+			age_ratings.fill(0);
+			age_ratings[static_cast<int>(RomFields::AgeRatingsCountry::USA)] =
+				RomFields::AGEBF_ACTIVE | 13;
+			fields.addField_ageRatings("Age Ratings", age_ratings);
+
+			fields.addTab("Tab1");
+			auto *const list_data = new RomFields::ListData_t(2);
+			(*list_data)[0].push_back("r0c0");
+			(*list_data)[0].push_back("r0c1");
+			(*list_data)[1].push_back("r1c0");
+			(*list_data)[1].push_back("r1c1");
+			RomFields::AFLD_PARAMS params(RomFields::RFT_LISTDATA_CHECKBOXES, 4);
+			params.headers = RomFields::strArrayToVector(listdata_headers, ARRAY_SIZE(listdata_headers));
+			params.data.single = list_data;
+			params.mxd.checkboxes = 0x2U;
+			fields.addField_listData("ListData", &params);
+
+			auto *const str_multi = new RomFields::StringMultiMap_t();
+			(*str_multi)['en'] = "English";
+			(*str_multi)['fr'] = "French";
+			fields.addField_string_multi("StringMulti", str_multi, 'en');
+		}
+
+		/**
+		 * Build a representative RomMetaData object.
+		 * @param metaData RomMetaData.
+		 */
+		static void buildMetaData(RomMetaData &metaData)
+		{
+			metaData.addMetaData_string(Property::Title, "Some Title");
+			metaData.addMetaData_integer(Property::Channels, 2);
+			metaData.addMetaData_uint(Property::Duration, 12345U);
+			metaData.addMetaData_timestamp(Property::CreationDate, 1234567890);
+		}
+
+		string m_srcFilename;
+		static const char *const bitfield_names[3];
+		static const char *const listdata_headers[2];
+};
+
+const char *const FieldCacheTest::bitfield_names[3] = {"bit0", "bit1", "bit2"};
+const char *const FieldCacheTest::listdata_headers[2] = {"Col0", "Col1"};
+
+/**
+ * Round-trip: store fields and metadata, then load and verify.
+ */
+TEST_F(FieldCacheTest, roundTrip)
+{
+	RomFields fields;
+	buildFields(fields);
+	RomMetaData metaData;
+	buildMetaData(metaData);
+
+	ASSERT_TRUE(FieldCache::store(m_srcFilename.c_str(), &fields, &metaData));
+
+	RomFields loaded;
+	RomMetaData loadedMeta;
+	ASSERT_TRUE(FieldCache::load(m_srcFilename.c_str(), &loaded, &loadedMeta));
+
+	// Verify the fields.
+	ASSERT_EQ(fields.count(), loaded.count());
+	ASSERT_EQ(fields.tabCount(), loaded.tabCount());
+	for (int i = 0; i < fields.tabCount(); i++) {
+		EXPECT_STREQ(fields.tabName(i), loaded.tabName(i)) << "tab " << i;
+	}
+	for (int i = 0; i < fields.count(); i++) {
+		const RomFields::Field *const orig = fields.at(i);
+		const RomFields::Field *const copy = loaded.at(i);
+		ASSERT_TRUE(orig != nullptr);
+		ASSERT_TRUE(copy != nullptr);
+		EXPECT_STREQ(orig->name, copy->name) << "field " << i;
+		EXPECT_EQ(orig->type, copy->type) << "field " << i;
+		EXPECT_EQ(orig->tabIdx, copy->tabIdx) << "field " << i;
+		EXPECT_EQ(orig->flags, copy->flags) << "field " << i;
+
+		switch (orig->type) {
+			default:
+				break;
+			case RomFields::RFT_STRING:
+				EXPECT_STREQ(orig->data.str, copy->data.str) << "field " << i;
+				break;
+			case RomFields::RFT_BITFIELD:
+				EXPECT_EQ(orig->data.bitfield, copy->data.bitfield) << "field " << i;
+				EXPECT_EQ(*(orig->desc.bitfield.names), *(copy->desc.bitfield.names)) << "field " << i;
+				break;
+			case RomFields::RFT_LISTDATA:
+				EXPECT_EQ(*(orig->data.list_data.data.single), *(copy->data.list_data.data.single)) << "field " << i;
+				EXPECT_EQ(orig->data.list_data.mxd.checkboxes, copy->data.list_data.mxd.checkboxes) << "field " << i;
+				EXPECT_EQ(*(orig->desc.list_data.names), *(copy->desc.list_data.names)) << "field " << i;
+				EXPECT_EQ(orig->desc.list_data.rows_visible, copy->desc.list_data.rows_visible) << "field " << i;
+				break;
+			case RomFields::RFT_DATETIME:
+				EXPECT_EQ(orig->data.date_time, copy->data.date_time) << "field " << i;
+				break;
+			case RomFields::RFT_AGE_RATINGS:
+				EXPECT_EQ(*(orig->data.age_ratings), *(copy->data.age_ratings)) << "field " << i;
+				break;
+			case RomFields::RFT_DIMENSIONS:
+				EXPECT_EQ(orig->data.dimensions[0], copy->data.dimensions[0]) << "field " << i;
+				EXPECT_EQ(orig->data.dimensions[1], copy->data.dimensions[1]) << "field " << i;
+				EXPECT_EQ(orig->data.dimensions[2], copy->data.dimensions[2]) << "field " << i;
+				break;
+			case RomFields::RFT_STRING_MULTI:
+				EXPECT_EQ(*(orig->data.str_multi), *(copy->data.str_multi)) << "field " << i;
+				break;
+		}
+	}
+
+	// Verify the metadata.
+	ASSERT_EQ(metaData.count(), loadedMeta.count());
+	auto origIter = metaData.cbegin();
+	auto copyIter = loadedMeta.cbegin();
+	for (; origIter != metaData.cend(); ++origIter, ++copyIter) {
+		EXPECT_EQ(origIter->name, copyIter->name);
+		EXPECT_EQ(origIter->type, copyIter->type);
+		switch (origIter->type) {
+			default:
+				break;
+			case PropertyType::Integer:
+				EXPECT_EQ(origIter->data.ivalue, copyIter->data.ivalue);
+				break;
+			case PropertyType::UnsignedInteger:
+				EXPECT_EQ(origIter->data.uvalue, copyIter->data.uvalue);
+				break;
+			case PropertyType::String:
+				EXPECT_EQ(*(origIter->data.str), *(copyIter->data.str));
+				break;
+			case PropertyType::Timestamp:
+				EXPECT_EQ(origIter->data.timestamp, copyIter->data.timestamp);
+				break;
+		}
+	}
+}
+
+/**
+ * Modifying the source file must invalidate the cache.
+ */
+TEST_F(FieldCacheTest, staleOnModify)
+{
+	RomFields fields;
+	buildFields(fields);
+	ASSERT_TRUE(FieldCache::store(m_srcFilename.c_str(), &fields, nullptr));
+
+	// Append a byte to the source file. (size change)
+	FILE *const f = fopen(m_srcFilename.c_str(), "ab");
+	ASSERT_TRUE(f != nullptr);
+	fputc('X', f);
+	fclose(f);
+
+	RomFields loaded;
+	EXPECT_FALSE(FieldCache::load(m_srcFilename.c_str(), &loaded, nullptr));
+	EXPECT_TRUE(loaded.empty());
+}
+
+/**
+ * A missing cache file is a miss, not an error.
+ */
+TEST_F(FieldCacheTest, missOnUncached)
+{
+	RomFields loaded;
+	EXPECT_FALSE(FieldCache::load(m_srcFilename.c_str(), &loaded, nullptr));
+}
+
+} }
+
+/**
+ * Test suite main function.
+ */
+extern "C" int gtest_main(int argc, TCHAR *argv[])
+{
+	fputs("LibRpBase test suite: FieldCache tests.\n\n", stderr);
+	fflush(nullptr);
+
+	// coverity[fun_call_w_exception]: uncaught exceptions cause nonzero exit anyway, so don't warn.
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,158 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase/tests)                  *
+ * SuVectorTest.cpp: rp::suvector test.                                    *
+ *                                                                         *
+ * Copyright (c) 2016-2024 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+// Google Test
+#include "gtest/gtest.h"
+#include "tcharx.h"
+
+// rp::suvector
+#include "uvector.h"
+
+// C++ STL classes
+#include <utility>
+
+namespace LibRpBase { namespace Tests {
+
+TEST(SuVectorTest, emptyTest)
+{
+	rp::suvector<uint8_t, 16> vec;
+	EXPECT_TRUE(vec.empty());
+	EXPECT_EQ(0U, vec.size());
+	EXPECT_EQ(16U, vec.capacity());
+	EXPECT_EQ(vec.begin(), vec.end());
+}
+
+TEST(SuVectorTest, inlineStorageTest)
+{
+	// Sizes up to N must not allocate, i.e. data() stays
+	// inside the object itself.
+	rp::suvector<uint8_t, 16> vec;
+	vec.resize(16);
+	EXPECT_EQ(16U, vec.size());
+	EXPECT_EQ(16U, vec.capacity());
+
+	const uint8_t *const obj_start = reinterpret_cast<const uint8_t*>(&vec);
+	const uint8_t *const obj_end = obj_start + sizeof(vec);
+	EXPECT_GE(vec.data(), obj_start);
+	EXPECT_LT(vec.data(), obj_end);
+}
+
+TEST(SuVectorTest, heapSpillTest)
+{
+	// Growing past N must preserve the existing elements.
+	rp::suvector<uint8_t, 16> vec;
+	vec.resize(16);
+	for (unsigned int i = 0; i < 16; i++) {
+		vec[i] = static_cast<uint8_t>(i);
+	}
+
+	vec.resize(64);
+	EXPECT_EQ(64U, vec.size());
+	EXPECT_GE(vec.capacity(), 64U);
+
+	// data() must now point outside of the object.
+	const uint8_t *const obj_start = reinterpret_cast<const uint8_t*>(&vec);
+	const uint8_t *const obj_end = obj_start + sizeof(vec);
+	EXPECT_TRUE(vec.data() < obj_start || vec.data() >= obj_end);
+
+	for (unsigned int i = 0; i < 16; i++) {
+		EXPECT_EQ(static_cast<uint8_t>(i), vec[i]);
+	}
+}
+
+TEST(SuVectorTest, pushBackGrowthTest)
+{
+	rp::suvector<uint32_t, 4> vec;
+	for (uint32_t i = 0; i < 1000; i++) {
+		vec.push_back(i * 7U);
+	}
+	ASSERT_EQ(1000U, vec.size());
+	for (uint32_t i = 0; i < 1000; i++) {
+		EXPECT_EQ(i * 7U, vec[i]);
+	}
+}
+
+TEST(SuVectorTest, sizedCtorTest)
+{
+	rp::suvector<uint8_t, 16> small_vec(8);
+	EXPECT_EQ(8U, small_vec.size());
+
+	rp::suvector<uint8_t, 16> big_vec(4096);
+	EXPECT_EQ(4096U, big_vec.size());
+	EXPECT_GE(big_vec.capacity(), 4096U);
+}
+
+TEST(SuVectorTest, clearKeepsCapacityTest)
+{
+	rp::suvector<uint8_t, 16> vec(256);
+	const size_t cap = vec.capacity();
+	vec.clear();
+	EXPECT_TRUE(vec.empty());
+	EXPECT_EQ(cap, vec.capacity());
+}
+
+TEST(SuVectorTest, copyTest)
+{
+	// Copy while inline.
+	rp::suvector<uint16_t, 8> src;
+	for (uint16_t i = 0; i < 8; i++) {
+		src.push_back(i);
+	}
+	rp::suvector<uint16_t, 8> dst(src);
+	ASSERT_EQ(src.size(), dst.size());
+	EXPECT_EQ(0, memcmp(src.data(), dst.data(), src.size() * sizeof(uint16_t)));
+
+	// Copy while on the heap.
+	for (uint16_t i = 8; i < 100; i++) {
+		src.push_back(i);
+	}
+	dst = src;
+	ASSERT_EQ(src.size(), dst.size());
+	EXPECT_EQ(0, memcmp(src.data(), dst.data(), src.size() * sizeof(uint16_t)));
+}
+
+TEST(SuVectorTest, moveTest)
+{
+	// Move while inline: elements are copied.
+	rp::suvector<uint16_t, 8> inl;
+	for (uint16_t i = 0; i < 8; i++) {
+		inl.push_back(i);
+	}
+	rp::suvector<uint16_t, 8> inl_moved(std::move(inl));
+	ASSERT_EQ(8U, inl_moved.size());
+	for (uint16_t i = 0; i < 8; i++) {
+		EXPECT_EQ(i, inl_moved[i]);
+	}
+	EXPECT_TRUE(inl.empty());
+
+	// Move while on the heap: the buffer is stolen.
+	rp::suvector<uint16_t, 8> heap;
+	for (uint16_t i = 0; i < 100; i++) {
+		heap.push_back(i);
+	}
+	const uint16_t *const heap_data = heap.data();
+	rp::suvector<uint16_t, 8> heap_moved(std::move(heap));
+	ASSERT_EQ(100U, heap_moved.size());
+	EXPECT_EQ(heap_data, heap_moved.data());
+	EXPECT_TRUE(heap.empty());
+}
+
+} }
+
+/**
+ * Test suite main function.
+ */
+extern "C" int gtest_main(int argc, TCHAR *argv[])
+{
+	fputs("LibRpBase test suite: rp::suvector tests.\n\n", stderr);
+	fflush(nullptr);
+
+	// coverity[fun_call_w_exception]: uncaught exceptions cause nonzero exit anyway, so don't warn.
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
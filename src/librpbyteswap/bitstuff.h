@@ -17,6 +17,11 @@
 
 #include "stdboolx.h"
 
+#include "librpcpuid/cpu_dispatch.h"
+#if defined(RP_CPU_I386) || defined(RP_CPU_AMD64)
+#  include "librpcpuid/cpuflags_x86.h"
+#endif /* RP_CPU_I386 || RP_CPU_AMD64 */
+
 // constexpr is not valid in C.
 #ifndef __cplusplus
 #  ifndef constexpr
@@ -24,6 +29,16 @@
 #  endif /* !constexpr */
 #endif /* !__cplusplus */
 
+// constexpr, but only where the implementation uses compiler
+// built-ins that are valid in constant expressions. (gcc/clang)
+// MSVC's bit-scan intrinsics are not constexpr; use the
+// *_constexpr() versions in constant expressions instead.
+#ifdef __GNUC__
+#  define BITSTUFF_CONSTEXPR constexpr
+#else /* !__GNUC__ */
+#  define BITSTUFF_CONSTEXPR
+#endif /* __GNUC__ */
+
 // const: Function does not have any effects except on the return value,
 // and it only depends on the input parameters. (similar to constexpr)
 #ifndef ATTR_CONST
@@ -40,7 +55,7 @@
  * @return uilog2(n)
  */
 ATTR_CONST
-static inline unsigned int uilog2(unsigned int n)
+static inline BITSTUFF_CONSTEXPR unsigned int uilog2(unsigned int n)
 {
 #if defined(__GNUC__)
 	// NOTE: XOR is needed to return the bit index
@@ -77,15 +92,91 @@ unsigned int popcount_c(unsigned int x);
  * @return Population count
  */
 ATTR_CONST
-static inline unsigned int popcount(unsigned int x)
+static inline BITSTUFF_CONSTEXPR unsigned int popcount(unsigned int x)
 {
 #if defined(__GNUC__)
+	// NOTE: gcc/clang emit the POPCNT instruction directly
+	// if the target allows it, e.g. -mpopcnt or -march=x86-64-v2.
 	return __builtin_popcount(x);
+#elif defined(_MSC_VER) && (defined(RP_CPU_I386) || defined(RP_CPU_AMD64))
+	// MSVC's __popcnt() requires POPCNT support on the CPU,
+	// so check at runtime and fall back to the C version.
+	if (RP_CPU_HasPOPCNT()) {
+		return __popcnt(x);
+	}
+	return popcount_c(x);
 #else
 	return popcount_c(x);
 #endif
 }
 
+/**
+ * Count trailing zero bits. (TZCNT/BSF)
+ * @param n Value
+ * @return Number of trailing zero bits, or 0 if n is 0.
+ */
+ATTR_CONST
+static inline BITSTUFF_CONSTEXPR unsigned int uictz(unsigned int n)
+{
+#if defined(__GNUC__)
+	return (n == 0 ? 0 : (unsigned int)__builtin_ctz(n));
+#elif defined(_MSC_VER)
+	unsigned long index;
+	unsigned char x = _BitScanForward(&index, n);
+	return (x ? index : 0);
+#else
+	if (n == 0)
+		return 0;
+	unsigned int ret = 0;
+	while (!(n & 1)) {
+		n >>= 1;
+		ret++;
+	}
+	return ret;
+#endif
+}
+
+#ifdef __cplusplus
+/**
+ * Population count function. (guaranteed-constexpr version)
+ *
+ * Unlike popcount(), this is usable in constant expressions on
+ * all compilers, e.g. for template arguments and static_assert()
+ * in the template-specialized decoder loops. Use popcount() in
+ * runtime code; it's faster on CPUs with POPCNT.
+ *
+ * @param x Value
+ * @return Population count
+ */
+ATTR_CONST
+static inline constexpr unsigned int popcount_constexpr(unsigned int x)
+{
+	// Classic bit-twiddling implementation.
+	x = x - ((x >> 1) & 0x55555555U);
+	x = (x & 0x33333333U) + ((x >> 2) & 0x33333333U);
+	x = (x + (x >> 4)) & 0x0F0F0F0FU;
+	return (x * 0x01010101U) >> 24;
+}
+
+/**
+ * Unsigned integer log2(n). (guaranteed-constexpr version)
+ *
+ * Unlike uilog2(), this is usable in constant expressions on
+ * all compilers. Use uilog2() in runtime code.
+ *
+ * @param n Value
+ * @return uilog2(n)
+ */
+ATTR_CONST
+static inline constexpr unsigned int uilog2_constexpr(unsigned int n)
+{
+	unsigned int ret = 0;
+	while (n >>= 1)
+		ret++;
+	return ret;
+}
+#endif /* __cplusplus */
+
 /**
  * Check if a value is a power of 2. (also must be non-zero)
  * @tparam t Type
@@ -112,8 +203,9 @@ static inline bool isPow2(unsigned int x)
  * @param x Value
  * @return Next power of 2.
  */
-static inline unsigned int nextPow2(unsigned int x)
+static inline BITSTUFF_CONSTEXPR unsigned int nextPow2(unsigned int x)
 {
-	// FIXME: _BitScanReverse() [in uilog2()] is not constexpr on MSVC 2022.
+	// FIXME: _BitScanReverse() [in uilog2()] is not constexpr on MSVC 2022,
+	// so this is only constexpr on gcc/clang.
 	return (1U << (uilog2(x) + 1));
 }
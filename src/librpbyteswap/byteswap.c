@@ -91,3 +91,63 @@ void RP_C_API rp_byte_swap_32_array_c(uint32_t *ptr, size_t n)
 		*ptr = __swab32(*ptr);
 	}
 }
+
+/**
+ * 16-bit byteswap + copy function.
+ * Standard version using regular C code.
+ * @param dst Destination array. (MUST be 16-bit aligned!)
+ * @param src Source array to swap. (MUST be 16-bit aligned!)
+ * @param n Number of bytes to swap. (Must be divisible by 2; an extra odd byte will be ignored.)
+ */
+void RP_C_API rp_byte_swap_16_array_copy_c(uint16_t *RESTRICT dst, const uint16_t *RESTRICT src, size_t n)
+{
+	// Verify the blocks are 16-bit aligned
+	// and the length is a multiple of 2 bytes.
+	assert(((uintptr_t)dst & 1) == 0);
+	assert(((uintptr_t)src & 1) == 0);
+	assert((n & 1) == 0);
+	n &= ~1;
+
+	// Process 4 WORDs per iteration.
+	for (; n >= 8; n -= 8, dst += 4, src += 4) {
+		dst[0] = __swab16(src[0]);
+		dst[1] = __swab16(src[1]);
+		dst[2] = __swab16(src[2]);
+		dst[3] = __swab16(src[3]);
+	}
+
+	// Process remaining WORDs.
+	for (; n > 0; n -= 2, dst++, src++) {
+		*dst = __swab16(*src);
+	}
+}
+
+/**
+ * 32-bit byteswap + copy function.
+ * Standard version using regular C code.
+ * @param dst Destination array. (MUST be 32-bit aligned!)
+ * @param src Source array to swap. (MUST be 32-bit aligned!)
+ * @param n Number of bytes to swap. (Must be divisible by 4; extra bytes will be ignored.)
+ */
+void RP_C_API rp_byte_swap_32_array_copy_c(uint32_t *RESTRICT dst, const uint32_t *RESTRICT src, size_t n)
+{
+	// Verify the blocks are 32-bit aligned
+	// and the length is a multiple of 4 bytes.
+	assert(((uintptr_t)dst & 3) == 0);
+	assert(((uintptr_t)src & 3) == 0);
+	assert((n & 3) == 0);
+	n &= ~3;
+
+	// Process 4 DWORDs per iteration.
+	for (; n >= 16; n -= 16, dst += 4, src += 4) {
+		dst[0] = __swab32(src[0]);
+		dst[1] = __swab32(src[1]);
+		dst[2] = __swab32(src[2]);
+		dst[3] = __swab32(src[3]);
+	}
+
+	// Process remaining DWORDs.
+	for (; n > 0; n -= 4, dst++, src++) {
+		*dst = __swab32(*src);
+	}
+}
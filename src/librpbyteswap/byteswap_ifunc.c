@@ -24,6 +24,11 @@
  */
 __typeof__(&rp_byte_swap_16_array_c) rp_byte_swap_16_array_resolve(void)
 {
+#ifdef BYTESWAP_HAS_AVX2
+	if (RP_CPU_HasAVX2()) {
+		return &rp_byte_swap_16_array_avx2;
+	} else
+#endif /* BYTESWAP_HAS_AVX2 */
 #ifdef BYTESWAP_HAS_SSSE3
 	if (RP_CPU_HasSSSE3()) {
 		return &rp_byte_swap_16_array_ssse3;
@@ -56,6 +61,11 @@ __typeof__(&rp_byte_swap_16_array_c) rp_byte_swap_16_array_resolve(void)
  */
 __typeof__(&rp_byte_swap_32_array_c) rp_byte_swap_32_array_resolve(void)
 {
+#ifdef BYTESWAP_HAS_AVX2
+	if (RP_CPU_HasAVX2()) {
+		return &rp_byte_swap_32_array_avx2;
+	} else
+#endif /* BYTESWAP_HAS_AVX2 */
 #ifdef BYTESWAP_HAS_SSSE3
 	if (RP_CPU_HasSSSE3()) {
 		return &rp_byte_swap_32_array_ssse3;
@@ -84,9 +94,55 @@ __typeof__(&rp_byte_swap_32_array_c) rp_byte_swap_32_array_resolve(void)
 #endif /* !BYTESWAP_ALWAYS_HAS_SSE2 */
 }
 
+/**
+ * IFUNC resolver function for rp_byte_swap_16_array_copy().
+ * @return Function pointer.
+ */
+__typeof__(&rp_byte_swap_16_array_copy_c) rp_byte_swap_16_array_copy_resolve(void)
+{
+#ifdef BYTESWAP_HAS_AVX2
+	if (RP_CPU_HasAVX2()) {
+		return &rp_byte_swap_16_array_copy_avx2;
+	} else
+#endif /* BYTESWAP_HAS_AVX2 */
+#ifdef BYTESWAP_HAS_SSSE3
+	if (RP_CPU_HasSSSE3()) {
+		return &rp_byte_swap_16_array_copy_ssse3;
+	} else
+#endif /* BYTESWAP_HAS_SSSE3 */
+	{
+		return &rp_byte_swap_16_array_copy_c;
+	}
+}
+
+/**
+ * IFUNC resolver function for rp_byte_swap_32_array_copy().
+ * @return Function pointer.
+ */
+__typeof__(&rp_byte_swap_32_array_copy_c) rp_byte_swap_32_array_copy_resolve(void)
+{
+#ifdef BYTESWAP_HAS_AVX2
+	if (RP_CPU_HasAVX2()) {
+		return &rp_byte_swap_32_array_copy_avx2;
+	} else
+#endif /* BYTESWAP_HAS_AVX2 */
+#ifdef BYTESWAP_HAS_SSSE3
+	if (RP_CPU_HasSSSE3()) {
+		return &rp_byte_swap_32_array_copy_ssse3;
+	} else
+#endif /* BYTESWAP_HAS_SSSE3 */
+	{
+		return &rp_byte_swap_32_array_copy_c;
+	}
+}
+
 void RP_C_API rp_byte_swap_16_array(uint16_t *ptr, size_t n)
 	IFUNC_ATTR(rp_byte_swap_16_array_resolve);
 void RP_C_API rp_byte_swap_32_array(uint32_t *ptr, size_t n)
 	IFUNC_ATTR(rp_byte_swap_32_array_resolve);
+void RP_C_API rp_byte_swap_16_array_copy(uint16_t *RESTRICT dst, const uint16_t *RESTRICT src, size_t n)
+	IFUNC_ATTR(rp_byte_swap_16_array_copy_resolve);
+void RP_C_API rp_byte_swap_32_array_copy(uint32_t *RESTRICT dst, const uint32_t *RESTRICT src, size_t n)
+	IFUNC_ATTR(rp_byte_swap_32_array_copy_resolve);
 
 #endif /* HAVE_IFUNC */
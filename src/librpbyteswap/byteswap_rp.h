@@ -16,6 +16,7 @@
 
 #include "librpbyteswap/config.byteswap.h"
 #include "librpbyteswap/byteorder.h"
+#include "common.h"
 #include "dll-macros.h"
 #include "force_inline.h"
 
@@ -31,6 +32,7 @@
 #  endif
 #  define BYTESWAP_HAS_SSE2 1
 #  define BYTESWAP_HAS_SSSE3 1
+#  define BYTESWAP_HAS_AVX2 1
 #endif
 #ifdef RP_CPU_AMD64
 #  define BYTESWAP_ALWAYS_HAS_SSE2 1
@@ -163,6 +165,26 @@ void RP_C_API rp_byte_swap_16_array_c(uint16_t *ptr, size_t n);
 RP_LIBROMDATA_PUBLIC
 void RP_C_API rp_byte_swap_32_array_c(uint32_t *ptr, size_t n);
 
+/**
+ * 16-bit byteswap + copy function.
+ * Standard version using regular C code.
+ * @param dst Destination array. (MUST be 16-bit aligned!)
+ * @param src Source array to swap. (MUST be 16-bit aligned!)
+ * @param n Number of bytes to swap. (Must be divisible by 2; an extra odd byte will be ignored.)
+ */
+RP_LIBROMDATA_PUBLIC
+void RP_C_API rp_byte_swap_16_array_copy_c(uint16_t *RESTRICT dst, const uint16_t *RESTRICT src, size_t n);
+
+/**
+ * 32-bit byteswap + copy function.
+ * Standard version using regular C code.
+ * @param dst Destination array. (MUST be 32-bit aligned!)
+ * @param src Source array to swap. (MUST be 32-bit aligned!)
+ * @param n Number of bytes to swap. (Must be divisible by 4; extra bytes will be ignored.)
+ */
+RP_LIBROMDATA_PUBLIC
+void RP_C_API rp_byte_swap_32_array_copy_c(uint32_t *RESTRICT dst, const uint32_t *RESTRICT src, size_t n);
+
 #ifdef BYTESWAP_HAS_MMX
 /**
  * 16-bit byteswap function.
@@ -221,8 +243,68 @@ void RP_C_API rp_byte_swap_16_array_ssse3(uint16_t *ptr, size_t n);
  */
 RP_LIBROMDATA_PUBLIC
 void RP_C_API rp_byte_swap_32_array_ssse3(uint32_t *ptr, size_t n);
+
+/**
+ * 16-bit byteswap + copy function.
+ * SSSE3-optimized version.
+ * @param dst Destination array. (MUST be 16-bit aligned!)
+ * @param src Source array to swap. (MUST be 16-bit aligned!)
+ * @param n Number of bytes to swap. (Must be divisible by 2; an extra odd byte will be ignored.)
+ */
+RP_LIBROMDATA_PUBLIC
+void RP_C_API rp_byte_swap_16_array_copy_ssse3(uint16_t *RESTRICT dst, const uint16_t *RESTRICT src, size_t n);
+
+/**
+ * 32-bit byteswap + copy function.
+ * SSSE3-optimized version.
+ * @param dst Destination array. (MUST be 32-bit aligned!)
+ * @param src Source array to swap. (MUST be 32-bit aligned!)
+ * @param n Number of bytes to swap. (Must be divisible by 4; extra bytes will be ignored.)
+ */
+RP_LIBROMDATA_PUBLIC
+void RP_C_API rp_byte_swap_32_array_copy_ssse3(uint32_t *RESTRICT dst, const uint32_t *RESTRICT src, size_t n);
 #endif /* BYTESWAP_HAS_SSSE3 */
 
+#ifdef BYTESWAP_HAS_AVX2
+/**
+ * 16-bit byteswap function.
+ * AVX2-optimized version.
+ * @param ptr Pointer to array to swap. (MUST be 16-bit aligned!)
+ * @param n Number of bytes to swap. (Must be divisible by 2; an extra odd byte will be ignored.)
+ */
+RP_LIBROMDATA_PUBLIC
+void RP_C_API rp_byte_swap_16_array_avx2(uint16_t *ptr, size_t n);
+
+/**
+ * 32-bit byteswap function.
+ * AVX2-optimized version.
+ * @param ptr Pointer to array to swap. (MUST be 32-bit aligned!)
+ * @param n Number of bytes to swap. (Must be divisible by 4; extra bytes will be ignored.)
+ */
+RP_LIBROMDATA_PUBLIC
+void RP_C_API rp_byte_swap_32_array_avx2(uint32_t *ptr, size_t n);
+
+/**
+ * 16-bit byteswap + copy function.
+ * AVX2-optimized version.
+ * @param dst Destination array. (MUST be 16-bit aligned!)
+ * @param src Source array to swap. (MUST be 16-bit aligned!)
+ * @param n Number of bytes to swap. (Must be divisible by 2; an extra odd byte will be ignored.)
+ */
+RP_LIBROMDATA_PUBLIC
+void RP_C_API rp_byte_swap_16_array_copy_avx2(uint16_t *RESTRICT dst, const uint16_t *RESTRICT src, size_t n);
+
+/**
+ * 32-bit byteswap + copy function.
+ * AVX2-optimized version.
+ * @param dst Destination array. (MUST be 32-bit aligned!)
+ * @param src Source array to swap. (MUST be 32-bit aligned!)
+ * @param n Number of bytes to swap. (Must be divisible by 4; extra bytes will be ignored.)
+ */
+RP_LIBROMDATA_PUBLIC
+void RP_C_API rp_byte_swap_32_array_copy_avx2(uint32_t *RESTRICT dst, const uint32_t *RESTRICT src, size_t n);
+#endif /* BYTESWAP_HAS_AVX2 */
+
 #if defined(HAVE_IFUNC) && (defined(RP_CPU_I386) || defined(RP_CPU_AMD64))
 /* System has IFUNC. Use it for dispatching. */
 
@@ -242,6 +324,24 @@ void RP_C_API rp_byte_swap_16_array(uint16_t *ptr, size_t n);
 RP_LIBROMDATA_PUBLIC
 void RP_C_API rp_byte_swap_32_array(uint32_t *ptr, size_t n);
 
+/**
+ * 16-bit byteswap + copy function.
+ * @param dst Destination array. (MUST be 16-bit aligned!)
+ * @param src Source array to swap. (MUST be 16-bit aligned!)
+ * @param n Number of bytes to swap. (Must be divisible by 2; an extra odd byte will be ignored.)
+ */
+RP_LIBROMDATA_PUBLIC
+void RP_C_API rp_byte_swap_16_array_copy(uint16_t *RESTRICT dst, const uint16_t *RESTRICT src, size_t n);
+
+/**
+ * 32-bit byteswap + copy function.
+ * @param dst Destination array. (MUST be 32-bit aligned!)
+ * @param src Source array to swap. (MUST be 32-bit aligned!)
+ * @param n Number of bytes to swap. (Must be divisible by 4; extra bytes will be ignored.)
+ */
+RP_LIBROMDATA_PUBLIC
+void RP_C_API rp_byte_swap_32_array_copy(uint32_t *RESTRICT dst, const uint32_t *RESTRICT src, size_t n);
+
 #else /* !HAVE_IFUNC && !(defined(RP_CPU_I386) || defined(RP_CPU_AMD64)) */
 /* System does not have IFUNC. Use inline dispatch functions. */
 
@@ -252,6 +352,11 @@ void RP_C_API rp_byte_swap_32_array(uint32_t *ptr, size_t n);
  */
 static FORCEINLINE void rp_byte_swap_16_array(uint16_t *ptr, size_t n)
 {
+#  ifdef BYTESWAP_HAS_AVX2
+	if (RP_CPU_HasAVX2()) {
+		rp_byte_swap_16_array_avx2(ptr, n);
+	} else
+#  endif /* BYTESWAP_HAS_AVX2 */
 #  ifdef BYTESWAP_HAS_SSSE3
 	if (RP_CPU_HasSSSE3()) {
 		rp_byte_swap_16_array_ssse3(ptr, n);
@@ -286,6 +391,11 @@ static FORCEINLINE void rp_byte_swap_16_array(uint16_t *ptr, size_t n)
  */
 static FORCEINLINE void rp_byte_swap_32_array(uint32_t *ptr, size_t n)
 {
+#  ifdef BYTESWAP_HAS_AVX2
+	if (RP_CPU_HasAVX2()) {
+		rp_byte_swap_32_array_avx2(ptr, n);
+	} else
+#  endif /* BYTESWAP_HAS_AVX2 */
 #  ifdef BYTESWAP_HAS_SSSE3
 	if (RP_CPU_HasSSSE3()) {
 		rp_byte_swap_32_array_ssse3(ptr, n);
@@ -314,6 +424,52 @@ static FORCEINLINE void rp_byte_swap_32_array(uint32_t *ptr, size_t n)
 #  endif /* !BYTESWAP_ALWAYS_HAS_SSE2 */
 }
 
+/**
+ * 16-bit byteswap + copy function.
+ * @param dst Destination array. (MUST be 16-bit aligned!)
+ * @param src Source array to swap. (MUST be 16-bit aligned!)
+ * @param n Number of bytes to swap. (Must be divisible by 2; an extra odd byte will be ignored.)
+ */
+static FORCEINLINE void rp_byte_swap_16_array_copy(uint16_t *RESTRICT dst, const uint16_t *RESTRICT src, size_t n)
+{
+#  ifdef BYTESWAP_HAS_AVX2
+	if (RP_CPU_HasAVX2()) {
+		rp_byte_swap_16_array_copy_avx2(dst, src, n);
+	} else
+#  endif /* BYTESWAP_HAS_AVX2 */
+#  ifdef BYTESWAP_HAS_SSSE3
+	if (RP_CPU_HasSSSE3()) {
+		rp_byte_swap_16_array_copy_ssse3(dst, src, n);
+	} else
+#  endif /* BYTESWAP_HAS_SSSE3 */
+	{
+		rp_byte_swap_16_array_copy_c(dst, src, n);
+	}
+}
+
+/**
+ * 32-bit byteswap + copy function.
+ * @param dst Destination array. (MUST be 32-bit aligned!)
+ * @param src Source array to swap. (MUST be 32-bit aligned!)
+ * @param n Number of bytes to swap. (Must be divisible by 4; extra bytes will be ignored.)
+ */
+static FORCEINLINE void rp_byte_swap_32_array_copy(uint32_t *RESTRICT dst, const uint32_t *RESTRICT src, size_t n)
+{
+#  ifdef BYTESWAP_HAS_AVX2
+	if (RP_CPU_HasAVX2()) {
+		rp_byte_swap_32_array_copy_avx2(dst, src, n);
+	} else
+#  endif /* BYTESWAP_HAS_AVX2 */
+#  ifdef BYTESWAP_HAS_SSSE3
+	if (RP_CPU_HasSSSE3()) {
+		rp_byte_swap_32_array_copy_ssse3(dst, src, n);
+	} else
+#  endif /* BYTESWAP_HAS_SSSE3 */
+	{
+		rp_byte_swap_32_array_copy_c(dst, src, n);
+	}
+}
+
 #endif /* HAVE_IFUNC && (defined(RP_CPU_I386) || defined(RP_CPU_AMD64)) */
 
 #ifdef __cplusplus
@@ -97,3 +97,91 @@ void RP_C_API rp_byte_swap_32_array_ssse3(uint32_t *ptr, size_t n)
 		*ptr = __swab32(*ptr);
 	}
 }
+
+/**
+ * 16-bit byteswap + copy function.
+ * SSSE3-optimized version.
+ * @param dst Destination array. (MUST be 16-bit aligned!)
+ * @param src Source array to swap. (MUST be 16-bit aligned!)
+ * @param n Number of bytes to swap. (Must be divisible by 2; an extra odd byte will be ignored.)
+ */
+void RP_C_API rp_byte_swap_16_array_copy_ssse3(uint16_t *RESTRICT dst, const uint16_t *RESTRICT src, size_t n)
+{
+	const __m128i shuf_mask = _mm_setr_epi8(1,0, 3,2, 5,4, 7,6, 9,8, 11,10, 13,12, 15,14);
+
+	// Verify the blocks are 16-bit aligned
+	// and the length is a multiple of 2 bytes.
+	assert(((uintptr_t)dst & 1) == 0);
+	assert(((uintptr_t)src & 1) == 0);
+	assert((n & 1) == 0);
+	n &= ~1;
+
+	// If dst isn't 16-byte aligned, swap WORDs
+	// manually until we get to 16-byte alignment.
+	// NOTE: Aligning to dst, since unaligned stores are
+	// more expensive than unaligned loads.
+	for (; ((uintptr_t)dst % 16 != 0) && n > 0; n -= 2, dst++, src++) {
+		*dst = __swab16(*src);
+	}
+
+	// Process 16 WORDs per iteration using SSSE3.
+	for (; n >= 32; n -= 32, dst += 16, src += 16) {
+		const __m128i *xmm_src = (const __m128i*)src;
+		__m128i *xmm_dst = (__m128i*)dst;
+
+		__m128i xmm0 = _mm_loadu_si128(&xmm_src[0]);
+		__m128i xmm1 = _mm_loadu_si128(&xmm_src[1]);
+
+		_mm_store_si128(&xmm_dst[0], _mm_shuffle_epi8(xmm0, shuf_mask));
+		_mm_store_si128(&xmm_dst[1], _mm_shuffle_epi8(xmm1, shuf_mask));
+	}
+
+	// Process the remaining data, one WORD at a time.
+	for (; n > 0; n -= 2, dst++, src++) {
+		*dst = __swab16(*src);
+	}
+}
+
+/**
+ * 32-bit byteswap + copy function.
+ * SSSE3-optimized version.
+ * @param dst Destination array. (MUST be 32-bit aligned!)
+ * @param src Source array to swap. (MUST be 32-bit aligned!)
+ * @param n Number of bytes to swap. (Must be divisible by 4; extra bytes will be ignored.)
+ */
+void RP_C_API rp_byte_swap_32_array_copy_ssse3(uint32_t *RESTRICT dst, const uint32_t *RESTRICT src, size_t n)
+{
+	const __m128i shuf_mask = _mm_setr_epi8(3,2,1,0, 7,6,5,4, 11,10,9,8, 15,14,13,12);
+
+	// Verify the blocks are 32-bit aligned
+	// and the length is a multiple of 4 bytes.
+	assert(((uintptr_t)dst & 3) == 0);
+	assert(((uintptr_t)src & 3) == 0);
+	assert((n & 3) == 0);
+	n &= ~3;
+
+	// If dst isn't 16-byte aligned, swap DWORDs
+	// manually until we get to 16-byte alignment.
+	// NOTE: Aligning to dst, since unaligned stores are
+	// more expensive than unaligned loads.
+	for (; ((uintptr_t)dst % 16 != 0) && n > 0; n -= 4, dst++, src++) {
+		*dst = __swab32(*src);
+	}
+
+	// Process 8 DWORDs per iteration using SSSE3.
+	for (; n >= 32; n -= 32, dst += 8, src += 8) {
+		const __m128i *xmm_src = (const __m128i*)src;
+		__m128i *xmm_dst = (__m128i*)dst;
+
+		__m128i xmm0 = _mm_loadu_si128(&xmm_src[0]);
+		__m128i xmm1 = _mm_loadu_si128(&xmm_src[1]);
+
+		_mm_store_si128(&xmm_dst[0], _mm_shuffle_epi8(xmm0, shuf_mask));
+		_mm_store_si128(&xmm_dst[1], _mm_shuffle_epi8(xmm1, shuf_mask));
+	}
+
+	// Process the remaining data, one DWORD at a time.
+	for (; n > 0; n -= 4, dst++, src++) {
+		*dst = __swab32(*src);
+	}
+}
@@ -229,6 +229,62 @@ TEST_F(BitstuffTest, nextPow2)
 	}
 }
 
+/**
+ * Test uictz()
+ */
+TEST_F(BitstuffTest, uictz)
+{
+	// Test bits 0 through 31.
+	for (unsigned int i = 0; i < 32; i++) {
+		EXPECT_EQ(i, uictz(1U << i));
+	}
+
+	// Set bits above the lowest bit should be ignored.
+	for (unsigned int i = 0; i < 31; i++) {
+		const unsigned int test_val = ~0U << i;
+		EXPECT_EQ(i, uictz(test_val));
+	}
+
+	// 0 is technically undefined for TZCNT/BSF;
+	// uictz() returns 0 in that case.
+	EXPECT_EQ(0U, uictz(0));
+}
+
+/**
+ * Test popcount_constexpr()
+ */
+TEST_F(BitstuffTest, popcount_constexpr)
+{
+	// Must be usable in constant expressions on all compilers.
+	static_assert(popcount_constexpr(0U) == 0, "popcount_constexpr(0) is wrong");
+	static_assert(popcount_constexpr(~0U) == 32, "popcount_constexpr(~0) is wrong");
+	static_assert(popcount_constexpr(0x55555555U) == 16, "popcount_constexpr(0x55555555) is wrong");
+
+	// Must match the runtime version.
+	for (unsigned int i = 0; i < 1000; i++) {
+		const unsigned int test_val = static_cast<unsigned int>(rand()) ^
+			(static_cast<unsigned int>(rand()) << 16);
+		EXPECT_EQ(popcount(test_val), popcount_constexpr(test_val));
+	}
+}
+
+/**
+ * Test uilog2_constexpr()
+ */
+TEST_F(BitstuffTest, uilog2_constexpr)
+{
+	// Must be usable in constant expressions on all compilers.
+	static_assert(uilog2_constexpr(1U) == 0, "uilog2_constexpr(1) is wrong");
+	static_assert(uilog2_constexpr(1U << 16) == 16, "uilog2_constexpr(1 << 16) is wrong");
+	static_assert(uilog2_constexpr(~0U) == 31, "uilog2_constexpr(~0) is wrong");
+
+	// Must match the runtime version.
+	for (unsigned int i = 0; i < 32; i++) {
+		EXPECT_EQ(uilog2(1U << i), uilog2_constexpr(1U << i));
+	}
+	EXPECT_EQ(uilog2(0), uilog2_constexpr(0));
+}
+
 } }
 
 /**
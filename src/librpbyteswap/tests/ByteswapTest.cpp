@@ -158,10 +158,12 @@ TEST_F(ByteswapTest, nonHostEndianMacroTest)
 
 #define rp_byte_swap_16_array_dispatch(ptr, n) rp_byte_swap_16_array(ptr, n)
 #define rp_byte_swap_32_array_dispatch(ptr, n) rp_byte_swap_32_array(ptr, n)
+#define rp_byte_swap_16_array_copy_dispatch(dst, src, n) rp_byte_swap_16_array_copy(dst, src, n)
+#define rp_byte_swap_32_array_copy_dispatch(dst, src, n) rp_byte_swap_32_array_copy(dst, src, n)
 
 /**
  * Macro for testing a 16-bit byteswap function.
- * @param opt		Byteswap function optimization. (c, mmx, sse2, ssse3; dispatch for the dispatch function)
+ * @param opt		Byteswap function optimization. (c, mmx, sse2, ssse3, avx2; dispatch for the dispatch function)
  * @param unalign	Number of bytes for unaligned testing.
  * @param expr		Expression to check if this optimization can be used. (Use `true` for c.)
  * @param errmsg	Error message to display if the optimization cannot be used.
@@ -183,7 +185,7 @@ TEST_F(ByteswapTest, rp_byte_swap_16_array_##opt##_unalign##unalign##_test) \
 
 /**
  * Macro for benchmarking a 16-bit byteswap function.
- * @param opt		Byteswap function optimization. (c, mmx, sse2, ssse3; dispatch for the dispatch function)
+ * @param opt		Byteswap function optimization. (c, mmx, sse2, ssse3, avx2; dispatch for the dispatch function)
  * @param unalign	Number of bytes for unaligned testing.
  * @param expr		Expression to check if this optimization can be used. (Use `true` for c.)
  * @param errmsg	Error message to display if the optimization cannot be used.
@@ -206,7 +208,7 @@ TEST_F(ByteswapTest, rp_byte_swap_16_array_##opt##_unalign##unalign##_benchmark)
  * This version has data that is 16-bit aligned, but not 32-bit aligned,
  * and the block has an odd number of WORDs at the end.
  *
- * @param opt		Byteswap function optimization. (c, mmx, sse2, ssse3; dispatch for the dispatch function)
+ * @param opt		Byteswap function optimization. (c, mmx, sse2, ssse3, avx2; dispatch for the dispatch function)
  * @param unalign	Number of bytes for unaligned testing.
  * @param expr		Expression to check if this optimization can be used. (Use `true` for c.)
  * @param errmsg	Error message to display if the optimization cannot be used.
@@ -232,7 +234,7 @@ TEST_F(ByteswapTest, rp_byte_swap_16_array_unDWORD_##opt##_test) \
  * This version has data that is 16-bit aligned, but not 32-bit aligned,
  * and the block has an odd number of WORDs at the end.
  *
- * @param opt		Byteswap function optimization. (c, mmx, sse2, ssse3; dispatch for the dispatch function)
+ * @param opt		Byteswap function optimization. (c, mmx, sse2, ssse3, avx2; dispatch for the dispatch function)
  * @param unalign	Number of bytes for unaligned testing.
  * @param expr		Expression to check if this optimization can be used. (Use `true` for c.)
  * @param errmsg	Error message to display if the optimization cannot be used.
@@ -251,7 +253,7 @@ TEST_F(ByteswapTest, rp_byte_swap_16_array_unDWORD_##opt##_benchmark) \
 
 /**
  * Macro for testing a 32-bit byteswap function.
- * @param opt		Byteswap function optimization. (c, mmx, sse2, ssse3; dispatch for the dispatch function)
+ * @param opt		Byteswap function optimization. (c, mmx, sse2, ssse3, avx2; dispatch for the dispatch function)
  * @param unalign	Number of bytes for unaligned testing.
  * @param expr		Expression to check if this optimization can be used. (Use `true` for c.)
  * @param errmsg	Error message to display if the optimization cannot be used.
@@ -273,7 +275,7 @@ TEST_F(ByteswapTest, rp_byte_swap_32_array_##opt##_unalign##unalign##_test) \
 
 /**
  * Macro for benchmarking a 32-bit byteswap function.
- * @param opt		Byteswap function optimization. (c, mmx, sse2, ssse3; dispatch for the dispatch function)
+ * @param opt		Byteswap function optimization. (c, mmx, sse2, ssse3, avx2; dispatch for the dispatch function)
  * @param unalign	Number of bytes for unaligned testing.
  * @param expr		Expression to check if this optimization can be used. (Use `true` for c.)
  * @param errmsg	Error message to display if the optimization cannot be used.
@@ -296,7 +298,7 @@ TEST_F(ByteswapTest, rp_byte_swap_32_array_##opt##_unalign##unalign##_benchmark)
  * This version has data that is 32-bit aligned, but not 64-bit aligned,
  * and the block has an odd number of DWORDs at the end.
  *
- * @param opt		Byteswap function optimization. (c, mmx, sse2, ssse3; dispatch for the dispatch function)
+ * @param opt		Byteswap function optimization. (c, mmx, sse2, ssse3, avx2; dispatch for the dispatch function)
  * @param unalign	Number of bytes for unaligned testing.
  * @param expr		Expression to check if this optimization can be used. (Use `true` for c.)
  * @param errmsg	Error message to display if the optimization cannot be used.
@@ -322,7 +324,7 @@ TEST_F(ByteswapTest, rp_byte_swap_32_array_unQWORD_##opt##_test) \
  * This version has data that is 32-bit aligned, but not 64-bit aligned,
  * and the block has an odd number of DWORDs at the end.
  *
- * @param opt		Byteswap function optimization. (c, mmx, sse2, ssse3; dispatch for the dispatch function)
+ * @param opt		Byteswap function optimization. (c, mmx, sse2, ssse3, avx2; dispatch for the dispatch function)
  * @param unalign	Number of bytes for unaligned testing.
  * @param expr		Expression to check if this optimization can be used. (Use `true` for c.)
  * @param errmsg	Error message to display if the optimization cannot be used.
@@ -339,6 +341,122 @@ TEST_F(ByteswapTest, rp_byte_swap_32_array_unQWORD_##opt##_benchmark) \
 	} \
 }
 
+/**
+ * Macro for testing a 16-bit byteswap + copy function.
+ * @param opt		Byteswap function optimization. (c, ssse3, avx2; dispatch for the dispatch function)
+ * @param unalign	Number of bytes for unaligned testing.
+ * @param expr		Expression to check if this optimization can be used. (Use `true` for c.)
+ * @param errmsg	Error message to display if the optimization cannot be used.
+ */
+#define DO_ARRAY_16_COPY_TEST(opt, unalign, expr, errmsg) \
+TEST_F(ByteswapTest, rp_byte_swap_16_array_copy_##opt##_unalign##unalign##_test) \
+{ \
+	if (!(expr)) { \
+		fputs(errmsg, stderr); \
+		return; \
+	} \
+	UNIQUE_PTR_ALIGNED(uint8_t) dst_buf = aligned_uptr<uint8_t>(16, ALIGN_BUF_SIZE); \
+	ASSERT_TRUE(dst_buf != nullptr); \
+	memset(dst_buf.get(), 0xCC, ALIGN_BUF_SIZE); \
+	rp_byte_swap_16_array_copy_##opt( \
+		reinterpret_cast<uint16_t*>(dst_buf.get() + (unalign)), \
+		reinterpret_cast<const uint16_t*>(align_buf.get() + (unalign)), \
+		ALIGN_BUF_SIZE - (unalign)); \
+	const uint8_t *ptr = dst_buf.get(); \
+	for (unsigned int i = ALIGN_BUF_SIZE / TEST_ARRAY_SIZE; i > 0; i--) { \
+		EXPECT_EQ(0, memcmp(ptr + (unalign), bswap_16b.data() + (unalign), TEST_ARRAY_SIZE - (unalign))); \
+		ptr += TEST_ARRAY_SIZE; \
+	} \
+	/* The source buffer must not be modified. */ \
+	ptr = align_buf.get(); \
+	for (unsigned int i = ALIGN_BUF_SIZE / TEST_ARRAY_SIZE; i > 0; i--) { \
+		EXPECT_EQ(0, memcmp(ptr, bswap_orig.data(), TEST_ARRAY_SIZE)); \
+		ptr += TEST_ARRAY_SIZE; \
+	} \
+}
+
+/**
+ * Macro for benchmarking a 16-bit byteswap + copy function.
+ * @param opt		Byteswap function optimization. (c, ssse3, avx2; dispatch for the dispatch function)
+ * @param unalign	Number of bytes for unaligned testing.
+ * @param expr		Expression to check if this optimization can be used. (Use `true` for c.)
+ * @param errmsg	Error message to display if the optimization cannot be used.
+ */
+#define DO_ARRAY_16_COPY_BENCHMARK(opt, unalign, expr, errmsg) \
+TEST_F(ByteswapTest, rp_byte_swap_16_array_copy_##opt##_unalign##unalign##_benchmark) \
+{ \
+	if (!(expr)) { \
+		fputs(errmsg, stderr); \
+		return; \
+	} \
+	UNIQUE_PTR_ALIGNED(uint8_t) dst_buf = aligned_uptr<uint8_t>(16, ALIGN_BUF_SIZE); \
+	ASSERT_TRUE(dst_buf != nullptr); \
+	for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) { \
+		rp_byte_swap_16_array_copy_##opt( \
+			reinterpret_cast<uint16_t*>(dst_buf.get() + (unalign)), \
+			reinterpret_cast<const uint16_t*>(align_buf.get() + (unalign)), \
+			ALIGN_BUF_SIZE - (unalign)); \
+	} \
+}
+
+/**
+ * Macro for testing a 32-bit byteswap + copy function.
+ * @param opt		Byteswap function optimization. (c, ssse3, avx2; dispatch for the dispatch function)
+ * @param unalign	Number of bytes for unaligned testing.
+ * @param expr		Expression to check if this optimization can be used. (Use `true` for c.)
+ * @param errmsg	Error message to display if the optimization cannot be used.
+ */
+#define DO_ARRAY_32_COPY_TEST(opt, unalign, expr, errmsg) \
+TEST_F(ByteswapTest, rp_byte_swap_32_array_copy_##opt##_unalign##unalign##_test) \
+{ \
+	if (!(expr)) { \
+		fputs(errmsg, stderr); \
+		return; \
+	} \
+	UNIQUE_PTR_ALIGNED(uint8_t) dst_buf = aligned_uptr<uint8_t>(16, ALIGN_BUF_SIZE); \
+	ASSERT_TRUE(dst_buf != nullptr); \
+	memset(dst_buf.get(), 0xCC, ALIGN_BUF_SIZE); \
+	rp_byte_swap_32_array_copy_##opt( \
+		reinterpret_cast<uint32_t*>(dst_buf.get() + (unalign)), \
+		reinterpret_cast<const uint32_t*>(align_buf.get() + (unalign)), \
+		ALIGN_BUF_SIZE - (unalign)); \
+	const uint8_t *ptr = dst_buf.get(); \
+	for (unsigned int i = ALIGN_BUF_SIZE / TEST_ARRAY_SIZE; i > 0; i--) { \
+		EXPECT_EQ(0, memcmp(ptr + (unalign), bswap_32b.data() + (unalign), TEST_ARRAY_SIZE - (unalign))); \
+		ptr += TEST_ARRAY_SIZE; \
+	} \
+	/* The source buffer must not be modified. */ \
+	ptr = align_buf.get(); \
+	for (unsigned int i = ALIGN_BUF_SIZE / TEST_ARRAY_SIZE; i > 0; i--) { \
+		EXPECT_EQ(0, memcmp(ptr, bswap_orig.data(), TEST_ARRAY_SIZE)); \
+		ptr += TEST_ARRAY_SIZE; \
+	} \
+}
+
+/**
+ * Macro for benchmarking a 32-bit byteswap + copy function.
+ * @param opt		Byteswap function optimization. (c, ssse3, avx2; dispatch for the dispatch function)
+ * @param unalign	Number of bytes for unaligned testing.
+ * @param expr		Expression to check if this optimization can be used. (Use `true` for c.)
+ * @param errmsg	Error message to display if the optimization cannot be used.
+ */
+#define DO_ARRAY_32_COPY_BENCHMARK(opt, unalign, expr, errmsg) \
+TEST_F(ByteswapTest, rp_byte_swap_32_array_copy_##opt##_unalign##unalign##_benchmark) \
+{ \
+	if (!(expr)) { \
+		fputs(errmsg, stderr); \
+		return; \
+	} \
+	UNIQUE_PTR_ALIGNED(uint8_t) dst_buf = aligned_uptr<uint8_t>(16, ALIGN_BUF_SIZE); \
+	ASSERT_TRUE(dst_buf != nullptr); \
+	for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) { \
+		rp_byte_swap_32_array_copy_##opt( \
+			reinterpret_cast<uint32_t*>(dst_buf.get() + (unalign)), \
+			reinterpret_cast<const uint32_t*>(align_buf.get() + (unalign)), \
+			ALIGN_BUF_SIZE - (unalign)); \
+	} \
+}
+
 // Standard tests
 DO_ARRAY_16_TEST		(c, 0, true, "")
 DO_ARRAY_16_BENCHMARK		(c, 0, true, "")
@@ -354,6 +472,15 @@ DO_ARRAY_16_BENCHMARK		(c, 2, true, "")
 //DO_ARRAY_32_TEST		(c, 4, true, "")
 //DO_ARRAY_32_BENCHMARK		(c, 4, true, "")
 
+DO_ARRAY_16_COPY_TEST		(c, 0, true, "")
+DO_ARRAY_16_COPY_BENCHMARK	(c, 0, true, "")
+DO_ARRAY_32_COPY_TEST		(c, 0, true, "")
+DO_ARRAY_32_COPY_BENCHMARK	(c, 0, true, "")
+DO_ARRAY_16_COPY_TEST		(c, 2, true, "")
+DO_ARRAY_16_COPY_BENCHMARK	(c, 2, true, "")
+DO_ARRAY_32_COPY_TEST		(c, 4, true, "")
+DO_ARRAY_32_COPY_BENCHMARK	(c, 4, true, "")
+
 #ifdef BYTESWAP_HAS_MMX
 // MMX-optimized tests
 DO_ARRAY_16_TEST		(mmx, 0, RP_CPU_HasMMX(), "*** MMX is not supported on this CPU. Skipping test.\n")
@@ -403,10 +530,45 @@ DO_ARRAY_16_TEST		(ssse3, 2, RP_CPU_HasSSSE3(), "*** SSSE3 is not supported on t
 DO_ARRAY_16_BENCHMARK		(ssse3, 2, RP_CPU_HasSSSE3(), "*** SSSE3 is not supported on this CPU. Skipping test.\n")
 DO_ARRAY_32_TEST		(ssse3, 4, RP_CPU_HasSSSE3(), "*** SSSE3 is not supported on this CPU. Skipping test.\n")
 DO_ARRAY_32_BENCHMARK		(ssse3, 4, RP_CPU_HasSSSE3(), "*** SSSE3 is not supported on this CPU. Skipping test.\n")
+
+DO_ARRAY_16_COPY_TEST		(ssse3, 0, RP_CPU_HasSSSE3(), "*** SSSE3 is not supported on this CPU. Skipping test.\n")
+DO_ARRAY_16_COPY_BENCHMARK	(ssse3, 0, RP_CPU_HasSSSE3(), "*** SSSE3 is not supported on this CPU. Skipping test.\n")
+DO_ARRAY_32_COPY_TEST		(ssse3, 0, RP_CPU_HasSSSE3(), "*** SSSE3 is not supported on this CPU. Skipping test.\n")
+DO_ARRAY_32_COPY_BENCHMARK	(ssse3, 0, RP_CPU_HasSSSE3(), "*** SSSE3 is not supported on this CPU. Skipping test.\n")
+DO_ARRAY_16_COPY_TEST		(ssse3, 2, RP_CPU_HasSSSE3(), "*** SSSE3 is not supported on this CPU. Skipping test.\n")
+DO_ARRAY_16_COPY_BENCHMARK	(ssse3, 2, RP_CPU_HasSSSE3(), "*** SSSE3 is not supported on this CPU. Skipping test.\n")
+DO_ARRAY_32_COPY_TEST		(ssse3, 4, RP_CPU_HasSSSE3(), "*** SSSE3 is not supported on this CPU. Skipping test.\n")
+DO_ARRAY_32_COPY_BENCHMARK	(ssse3, 4, RP_CPU_HasSSSE3(), "*** SSSE3 is not supported on this CPU. Skipping test.\n")
 #endif /* BYTESWAP_HAS_SSSE3 */
 
+#ifdef BYTESWAP_HAS_AVX2
+// AVX2-optimized tests
+DO_ARRAY_16_TEST		(avx2, 0, RP_CPU_HasAVX2(), "*** AVX2 is not supported on this CPU. Skipping test.\n")
+DO_ARRAY_16_BENCHMARK		(avx2, 0, RP_CPU_HasAVX2(), "*** AVX2 is not supported on this CPU. Skipping test.\n")
+DO_ARRAY_16_unDWORD_TEST	(avx2, RP_CPU_HasAVX2(), "*** AVX2 is not supported on this CPU. Skipping test.\n")
+DO_ARRAY_16_unDWORD_BENCHMARK	(avx2, RP_CPU_HasAVX2(), "*** AVX2 is not supported on this CPU. Skipping test.\n")
+DO_ARRAY_32_TEST		(avx2, 0, RP_CPU_HasAVX2(), "*** AVX2 is not supported on this CPU. Skipping test.\n")
+DO_ARRAY_32_BENCHMARK		(avx2, 0, RP_CPU_HasAVX2(), "*** AVX2 is not supported on this CPU. Skipping test.\n")
+DO_ARRAY_32_unQWORD_TEST	(avx2, RP_CPU_HasAVX2(), "*** AVX2 is not supported on this CPU. Skipping test.\n")
+DO_ARRAY_32_unQWORD_BENCHMARK	(avx2, RP_CPU_HasAVX2(), "*** AVX2 is not supported on this CPU. Skipping test.\n")
+
+DO_ARRAY_16_TEST		(avx2, 2, RP_CPU_HasAVX2(), "*** AVX2 is not supported on this CPU. Skipping test.\n")
+DO_ARRAY_16_BENCHMARK		(avx2, 2, RP_CPU_HasAVX2(), "*** AVX2 is not supported on this CPU. Skipping test.\n")
+DO_ARRAY_32_TEST		(avx2, 4, RP_CPU_HasAVX2(), "*** AVX2 is not supported on this CPU. Skipping test.\n")
+DO_ARRAY_32_BENCHMARK		(avx2, 4, RP_CPU_HasAVX2(), "*** AVX2 is not supported on this CPU. Skipping test.\n")
+
+DO_ARRAY_16_COPY_TEST		(avx2, 0, RP_CPU_HasAVX2(), "*** AVX2 is not supported on this CPU. Skipping test.\n")
+DO_ARRAY_16_COPY_BENCHMARK	(avx2, 0, RP_CPU_HasAVX2(), "*** AVX2 is not supported on this CPU. Skipping test.\n")
+DO_ARRAY_32_COPY_TEST		(avx2, 0, RP_CPU_HasAVX2(), "*** AVX2 is not supported on this CPU. Skipping test.\n")
+DO_ARRAY_32_COPY_BENCHMARK	(avx2, 0, RP_CPU_HasAVX2(), "*** AVX2 is not supported on this CPU. Skipping test.\n")
+DO_ARRAY_16_COPY_TEST		(avx2, 2, RP_CPU_HasAVX2(), "*** AVX2 is not supported on this CPU. Skipping test.\n")
+DO_ARRAY_16_COPY_BENCHMARK	(avx2, 2, RP_CPU_HasAVX2(), "*** AVX2 is not supported on this CPU. Skipping test.\n")
+DO_ARRAY_32_COPY_TEST		(avx2, 4, RP_CPU_HasAVX2(), "*** AVX2 is not supported on this CPU. Skipping test.\n")
+DO_ARRAY_32_COPY_BENCHMARK	(avx2, 4, RP_CPU_HasAVX2(), "*** AVX2 is not supported on this CPU. Skipping test.\n")
+#endif /* BYTESWAP_HAS_AVX2 */
+
 // NOTE: Add more instruction sets to the #ifdef if other optimizations are added.
-#if defined(BYTESWAP_HAS_MMX) || defined(BYTESWAP_HAS_SSE2) || defined(BYTESWAP_HAS_SSSE3)
+#if defined(BYTESWAP_HAS_MMX) || defined(BYTESWAP_HAS_SSE2) || defined(BYTESWAP_HAS_SSSE3) || defined(BYTESWAP_HAS_AVX2)
 // Dispatch functions
 DO_ARRAY_16_TEST		(dispatch, 0, true, "")
 DO_ARRAY_16_BENCHMARK		(dispatch, 0, true, "")
@@ -421,7 +583,16 @@ DO_ARRAY_16_TEST		(dispatch, 2, true, "")
 DO_ARRAY_16_BENCHMARK		(dispatch, 2, true, "")
 DO_ARRAY_32_TEST		(dispatch, 4, true, "")
 DO_ARRAY_32_BENCHMARK		(dispatch, 4, true, "")
-#endif /* BYTESWAP_HAS_MMX || BYTESWAP_HAS_SSE2 || BYTESWAP_HAS_SSSE3 */
+
+DO_ARRAY_16_COPY_TEST		(dispatch, 0, true, "")
+DO_ARRAY_16_COPY_BENCHMARK	(dispatch, 0, true, "")
+DO_ARRAY_32_COPY_TEST		(dispatch, 0, true, "")
+DO_ARRAY_32_COPY_BENCHMARK	(dispatch, 0, true, "")
+DO_ARRAY_16_COPY_TEST		(dispatch, 2, true, "")
+DO_ARRAY_16_COPY_BENCHMARK	(dispatch, 2, true, "")
+DO_ARRAY_32_COPY_TEST		(dispatch, 4, true, "")
+DO_ARRAY_32_COPY_BENCHMARK	(dispatch, 4, true, "")
+#endif /* BYTESWAP_HAS_MMX || BYTESWAP_HAS_SSE2 || BYTESWAP_HAS_SSSE3 || BYTESWAP_HAS_AVX2 */
 
 } }
 
@@ -0,0 +1,215 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpcpuid)                       *
+ * cpuflags_arm.c: ARM CPU flags detection.                                *
+ *                                                                         *
+ * Copyright (c) 2017-2024 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "cpuflags_arm.h"
+#if !defined(RP_CPU_ARM) && !defined(RP_CPU_ARM64)
+#  error Do not compile cpuflags_arm.c on non-ARM CPUs!
+#endif
+
+// librpthreads
+// FIXME: Cannot use librpthreads at the moment due to static linkage.
+//#include "librpthreads/pthread_once.h"
+
+#if defined(__linux__) && defined(HAVE_GETAUXVAL)
+#  include <sys/auxv.h>
+// <asm/hwcap.h> has the HWCAP bits, but fallback definitions
+// are provided below in case the header isn't available.
+#  if defined(__has_include)
+#    if __has_include(<asm/hwcap.h>)
+#      include <asm/hwcap.h>
+#    endif
+#  else
+#    include <asm/hwcap.h>
+#  endif
+#elif defined(__APPLE__)
+#  include <sys/types.h>
+#  include <sys/sysctl.h>
+#elif defined(_WIN32)
+#  include <windows.h>
+#endif
+
+#if defined(__linux__) && defined(HAVE_GETAUXVAL)
+// HWCAP bits that might be missing from older kernel headers.
+#  ifdef RP_CPU_ARM64
+#    ifndef HWCAP_ASIMD
+#      define HWCAP_ASIMD	(1UL << 1)
+#    endif
+#    ifndef HWCAP_AES
+#      define HWCAP_AES		(1UL << 3)
+#    endif
+#    ifndef HWCAP_PMULL
+#      define HWCAP_PMULL	(1UL << 4)
+#    endif
+#    ifndef HWCAP_SHA1
+#      define HWCAP_SHA1	(1UL << 5)
+#    endif
+#    ifndef HWCAP_SHA2
+#      define HWCAP_SHA2	(1UL << 6)
+#    endif
+#    ifndef HWCAP_CRC32
+#      define HWCAP_CRC32	(1UL << 7)
+#    endif
+#    ifndef HWCAP_SVE
+#      define HWCAP_SVE		(1UL << 22)
+#    endif
+#    ifndef HWCAP2_SVE2
+#      define HWCAP2_SVE2	(1UL << 1)
+#    endif
+#  else /* RP_CPU_ARM */
+#    ifndef HWCAP_NEON
+#      define HWCAP_NEON	(1UL << 12)
+#    endif
+#    ifndef HWCAP2_AES
+#      define HWCAP2_AES	(1UL << 0)
+#    endif
+#    ifndef HWCAP2_PMULL
+#      define HWCAP2_PMULL	(1UL << 1)
+#    endif
+#    ifndef HWCAP2_SHA1
+#      define HWCAP2_SHA1	(1UL << 2)
+#    endif
+#    ifndef HWCAP2_SHA2
+#      define HWCAP2_SHA2	(1UL << 3)
+#    endif
+#    ifndef HWCAP2_CRC32
+#      define HWCAP2_CRC32	(1UL << 4)
+#    endif
+#  endif /* RP_CPU_ARM64 */
+#endif /* __linux__ && HAVE_GETAUXVAL */
+
+uint32_t RP_CPU_Flags = 0;
+int RP_CPU_Flags_Init = 0;	// 1 if RP_CPU_Flags has been initialized.
+
+#ifdef __APPLE__
+/**
+ * Check an hw.optional.* sysctl value.
+ * @param name sysctl name
+ * @return 1 if present and non-zero; 0 otherwise.
+ */
+static int sysctl_feature_check(const char *name)
+{
+	int value = 0;
+	size_t len = sizeof(value);
+	if (sysctlbyname(name, &value, &len, NULL, 0) != 0) {
+		return 0;
+	}
+	return (value != 0);
+}
+#endif /* __APPLE__ */
+
+/**
+ * Initialize RP_CPU_Flags. (internal function)
+ * Called by pthread_once().
+ */
+static void RP_CPU_InitCPUFlags_int(void)
+{
+	// Make sure the CPU flags variable is empty.
+	RP_CPU_Flags = 0;
+
+#ifdef RP_CPU_ARM64
+	// AArch64 always has NEON (ASIMD).
+	RP_CPU_Flags |= RP_CPUFLAG_ARM_NEON;
+#endif /* RP_CPU_ARM64 */
+
+#if defined(__linux__) && defined(HAVE_GETAUXVAL)
+	// Linux: Get the CPU feature bits from the ELF auxiliary vector.
+	{
+		const unsigned long hwcap = getauxval(AT_HWCAP);
+		const unsigned long hwcap2 = getauxval(AT_HWCAP2);
+
+#  ifdef RP_CPU_ARM64
+		if (hwcap & HWCAP_ASIMD)
+			RP_CPU_Flags |= RP_CPUFLAG_ARM_NEON;
+		if (hwcap & HWCAP_AES)
+			RP_CPU_Flags |= RP_CPUFLAG_ARM_AES;
+		if (hwcap & HWCAP_PMULL)
+			RP_CPU_Flags |= RP_CPUFLAG_ARM_PMULL;
+		if (hwcap & HWCAP_SHA1)
+			RP_CPU_Flags |= RP_CPUFLAG_ARM_SHA1;
+		if (hwcap & HWCAP_SHA2)
+			RP_CPU_Flags |= RP_CPUFLAG_ARM_SHA2;
+		if (hwcap & HWCAP_CRC32)
+			RP_CPU_Flags |= RP_CPUFLAG_ARM_CRC32;
+		if (hwcap & HWCAP_SVE) {
+			RP_CPU_Flags |= RP_CPUFLAG_ARM_SVE;
+			if (hwcap2 & HWCAP2_SVE2)
+				RP_CPU_Flags |= RP_CPUFLAG_ARM_SVE2;
+		}
+#  else /* RP_CPU_ARM */
+		if (hwcap & HWCAP_NEON)
+			RP_CPU_Flags |= RP_CPUFLAG_ARM_NEON;
+		if (hwcap2 & HWCAP2_AES)
+			RP_CPU_Flags |= RP_CPUFLAG_ARM_AES;
+		if (hwcap2 & HWCAP2_PMULL)
+			RP_CPU_Flags |= RP_CPUFLAG_ARM_PMULL;
+		if (hwcap2 & HWCAP2_SHA1)
+			RP_CPU_Flags |= RP_CPUFLAG_ARM_SHA1;
+		if (hwcap2 & HWCAP2_SHA2)
+			RP_CPU_Flags |= RP_CPUFLAG_ARM_SHA2;
+		if (hwcap2 & HWCAP2_CRC32)
+			RP_CPU_Flags |= RP_CPUFLAG_ARM_CRC32;
+#  endif /* RP_CPU_ARM64 */
+	}
+#elif defined(__APPLE__)
+	// macOS/iOS: Check the hw.optional.* sysctls.
+	// NOTE: Apple Silicon does not support SVE.
+	if (sysctl_feature_check("hw.optional.arm.FEAT_AES"))
+		RP_CPU_Flags |= RP_CPUFLAG_ARM_AES;
+	if (sysctl_feature_check("hw.optional.arm.FEAT_PMULL"))
+		RP_CPU_Flags |= RP_CPUFLAG_ARM_PMULL;
+	if (sysctl_feature_check("hw.optional.arm.FEAT_SHA1"))
+		RP_CPU_Flags |= RP_CPUFLAG_ARM_SHA1;
+	if (sysctl_feature_check("hw.optional.arm.FEAT_SHA256"))
+		RP_CPU_Flags |= RP_CPUFLAG_ARM_SHA2;
+	if (sysctl_feature_check("hw.optional.armv8_crc32"))
+		RP_CPU_Flags |= RP_CPUFLAG_ARM_CRC32;
+#elif defined(_WIN32)
+	// Windows on ARM: Use IsProcessorFeaturePresent().
+	// NOTE: No SVE detection is available here.
+#  ifndef PF_ARM_V8_CRYPTO_INSTRUCTIONS_AVAILABLE
+#    define PF_ARM_V8_CRYPTO_INSTRUCTIONS_AVAILABLE 30
+#  endif
+#  ifndef PF_ARM_V8_CRC32_INSTRUCTIONS_AVAILABLE
+#    define PF_ARM_V8_CRC32_INSTRUCTIONS_AVAILABLE 31
+#  endif
+#  ifndef RP_CPU_ARM64
+#    ifndef PF_ARM_NEON_INSTRUCTIONS_AVAILABLE
+#      define PF_ARM_NEON_INSTRUCTIONS_AVAILABLE 19
+#    endif
+	if (IsProcessorFeaturePresent(PF_ARM_NEON_INSTRUCTIONS_AVAILABLE))
+		RP_CPU_Flags |= RP_CPUFLAG_ARM_NEON;
+#  endif /* !RP_CPU_ARM64 */
+	if (IsProcessorFeaturePresent(PF_ARM_V8_CRYPTO_INSTRUCTIONS_AVAILABLE)) {
+		RP_CPU_Flags |= (RP_CPUFLAG_ARM_AES | RP_CPUFLAG_ARM_PMULL |
+		                 RP_CPUFLAG_ARM_SHA1 | RP_CPUFLAG_ARM_SHA2);
+	}
+	if (IsProcessorFeaturePresent(PF_ARM_V8_CRC32_INSTRUCTIONS_AVAILABLE))
+		RP_CPU_Flags |= RP_CPUFLAG_ARM_CRC32;
+#else
+	// No OS-specific feature detection is available.
+	// Only the baseline flags will be set.
+#endif
+
+	// CPU flags initialized.
+	RP_CPU_Flags_Init = 1;
+}
+
+/**
+ * Initialize RP_CPU_Flags.
+ */
+void RP_C_API RP_CPU_InitCPUFlags(void)
+{
+	// FIXME: Cannot use librpthreads at the moment due to static linkage.
+	//static pthread_once_t cpu_once_control = PTHREAD_ONCE_INIT;
+	//pthread_once(&cpu_once_control, RP_CPU_InitCPUFlags_int);
+	static uint8_t cpu_once_control = 0;
+	if (cpu_once_control == 0) {
+		RP_CPU_InitCPUFlags_int();
+		cpu_once_control = 1;
+	}
+}
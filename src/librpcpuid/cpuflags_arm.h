@@ -0,0 +1,82 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpcpuid)                       *
+ * cpuflags_arm.h: ARM CPU flags detection.                                *
+ *                                                                         *
+ * Copyright (c) 2017-2024 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+#include "common.h"
+#include "dll-macros.h"	// for RP_C_API
+
+// RP_CPU_* macros
+#include "cpu_dispatch.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* CPU flags (ARM/ARM64) */
+#if defined(RP_CPU_ARM) || defined(RP_CPU_ARM64)
+
+// Set of CPU flags we check for right now.
+// More flags will be added if needed.
+#define RP_CPUFLAG_ARM_NEON		((uint32_t)(1U <<  0))
+#define RP_CPUFLAG_ARM_SVE		((uint32_t)(1U <<  1))
+#define RP_CPUFLAG_ARM_SVE2		((uint32_t)(1U <<  2))
+#define RP_CPUFLAG_ARM_AES		((uint32_t)(1U <<  3))
+#define RP_CPUFLAG_ARM_PMULL		((uint32_t)(1U <<  4))
+#define RP_CPUFLAG_ARM_SHA1		((uint32_t)(1U <<  5))
+#define RP_CPUFLAG_ARM_SHA2		((uint32_t)(1U <<  6))
+#define RP_CPUFLAG_ARM_CRC32		((uint32_t)(1U <<  7))
+
+#endif /* RP_CPU_ARM || RP_CPU_ARM64 */
+
+// Don't modify these!
+extern uint32_t RP_CPU_Flags;
+extern int RP_CPU_Flags_Init;	// 1 if RP_CPU_Flags has been initialized.
+
+/**
+ * Initialize RP_CPU_Flags.
+ */
+void RP_C_API RP_CPU_InitCPUFlags(void);
+
+// Convenience macros to determine if the CPU supports a certain flag.
+
+// Macro for flags that need to be tested on both 32-bit and 64-bit ARM CPUs.
+#define CPU_FLAG_ARM_CHECK(flag) \
+static FORCEINLINE int RP_CPU_Has##flag(void) \
+{ \
+	if (unlikely(!RP_CPU_Flags_Init)) { \
+		RP_CPU_InitCPUFlags(); \
+	} \
+	return (int)(RP_CPU_Flags & RP_CPUFLAG_ARM_##flag); \
+}
+
+// Macro for flags that always exist on ARM64 (AArch64) and
+// only need to be tested on 32-bit ARM.
+#ifdef RP_CPU_ARM64
+#  define CPU_FLAG_ARM_CHECK_arm32only(flag) \
+static FORCEINLINE int RP_CPU_Has##flag(void) \
+{ \
+	return 1; \
+}
+#else /* !RP_CPU_ARM64 */
+#  define CPU_FLAG_ARM_CHECK_arm32only(flag) CPU_FLAG_ARM_CHECK(flag)
+#endif /* RP_CPU_ARM64 */
+
+CPU_FLAG_ARM_CHECK_arm32only(NEON)
+CPU_FLAG_ARM_CHECK(SVE)
+CPU_FLAG_ARM_CHECK(SVE2)
+CPU_FLAG_ARM_CHECK(AES)
+CPU_FLAG_ARM_CHECK(PMULL)
+CPU_FLAG_ARM_CHECK(SHA1)
+CPU_FLAG_ARM_CHECK(SHA2)
+CPU_FLAG_ARM_CHECK(CRC32)
+
+#ifdef __cplusplus
+}
+#endif
@@ -135,12 +135,19 @@ static void RP_CPU_InitCPUFlags_int(void)
 			RP_CPU_Flags |= RP_CPUFLAG_X86_SSE41;
 		if (regs[REG_ECX] & CPUFLAG_IA32_ECX_SSE42)
 			RP_CPU_Flags |= RP_CPUFLAG_X86_SSE42;
+		if (regs[REG_ECX] & CPUFLAG_IA32_ECX_PCLMULQDQ)
+			RP_CPU_Flags |= RP_CPUFLAG_X86_PCLMUL;
 		if (regs[REG_ECX] & CPUFLAG_IA32_ECX_F16C)
 			RP_CPU_Flags |= RP_CPUFLAG_X86_F16C;
 		if (regs[REG_ECX] & CPUFLAG_IA32_ECX_FMA3)
 			RP_CPU_Flags |= RP_CPUFLAG_X86_FMA3;
 	}
 
+	// POPCNT is an integer instruction, so it doesn't depend on
+	// FXSAVE or any other OS-level FPU state support.
+	if (regs[REG_ECX] & CPUFLAG_IA32_ECX_POPCNT)
+		RP_CPU_Flags |= RP_CPUFLAG_X86_POPCNT;
+
 	// Check for XSAVE and OSXSAVE.
 	// Required for AVX and AVX2.
 	can_XSAVE = (regs[REG_ECX] & (CPUFLAG_IA32_ECX_XSAVE | CPUFLAG_IA32_ECX_OSXSAVE)) ==
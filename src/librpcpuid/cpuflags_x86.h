@@ -35,6 +35,8 @@ extern "C" {
 #define RP_CPUFLAG_X86_AVX2		((uint32_t)(1U <<  8))
 #define RP_CPUFLAG_X86_F16C		((uint32_t)(1U <<  9))
 #define RP_CPUFLAG_X86_FMA3		((uint32_t)(1U << 10))
+#define RP_CPUFLAG_X86_PCLMUL		((uint32_t)(1U << 11))
+#define RP_CPUFLAG_X86_POPCNT		((uint32_t)(1U << 12))
 
 #endif /* RP_CPU_I386 || RP_CPU_AMD64 */
 
@@ -81,6 +83,8 @@ CPU_FLAG_X86_CHECK(AVX)
 CPU_FLAG_X86_CHECK(AVX2)
 CPU_FLAG_X86_CHECK(F16C)
 CPU_FLAG_X86_CHECK(FMA3)
+CPU_FLAG_X86_CHECK(PCLMUL)
+CPU_FLAG_X86_CHECK(POPCNT)
 
 #ifdef __cplusplus
 }
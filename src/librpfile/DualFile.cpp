@@ -10,6 +10,7 @@
 #include "DualFile.hpp"
 
 // C++ STL classes
+#include <vector>
 using std::string;
 
 namespace LibRpFile {
@@ -195,6 +196,57 @@ off64_t DualFile::tell(void)
 	return m_pos;
 }
 
+/**
+ * Read data from multiple scattered file offsets.
+ *
+ * Entries that fall entirely within one of the underlying
+ * files are batched and forwarded to that file's readVec(),
+ * so its optimized implementation (if any) is used. Entries
+ * spanning the file boundary use the default seek+read.
+ *
+ * NOTE: The file position after this call is unspecified.
+ *
+ * @param vec	[in/out] Array of read vector entries.
+ * @param count	[in] Number of entries in vec.
+ * @return Number of entries that were fully read.
+ */
+size_t DualFile::readVec(ReadVecEntry *vec, size_t count)
+{
+	if (!m_file[0] || !m_file[1]) {
+		m_lastError = EBADF;
+		return 0;
+	}
+
+	assert(vec != nullptr || count == 0);
+	std::vector<ReadVecEntry> vec0, vec1;
+	size_t entries_read = 0;
+	for (; count > 0; count--, vec++) {
+		if (vec->offset + static_cast<off64_t>(vec->size) <= m_size[0]) {
+			// Fully within the first file.
+			vec0.push_back(*vec);
+		} else if (vec->offset >= m_size[0]) {
+			// Fully within the second file.
+			ReadVecEntry entry = *vec;
+			entry.offset -= m_size[0];
+			vec1.push_back(entry);
+		} else {
+			// Spans the file boundary.
+			// Use the default seek+read implementation.
+			if (this->seekAndRead(vec->offset, vec->dest, vec->size) == vec->size) {
+				entries_read++;
+			}
+		}
+	}
+
+	if (!vec0.empty()) {
+		entries_read += m_file[0]->readVec(vec0.data(), vec0.size());
+	}
+	if (!vec1.empty()) {
+		entries_read += m_file[1]->readVec(vec1.data(), vec1.size());
+	}
+	return entries_read;
+}
+
 /** File properties **/
 
 /**
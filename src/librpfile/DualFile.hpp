@@ -84,6 +84,22 @@ class DualFile final : public IRpFile
 		 */
 		off64_t tell(void) final;
 
+		/**
+		 * Read data from multiple scattered file offsets.
+		 *
+		 * Entries that fall entirely within one of the underlying
+		 * files are batched and forwarded to that file's readVec(),
+		 * so its optimized implementation (if any) is used. Entries
+		 * spanning the file boundary use the default seek+read.
+		 *
+		 * NOTE: The file position after this call is unspecified.
+		 *
+		 * @param vec	[in/out] Array of read vector entries.
+		 * @param count	[in] Number of entries in vec.
+		 * @return Number of entries that were fully read.
+		 */
+		size_t readVec(ReadVecEntry *vec, size_t count) final;
+
 	public:
 		/** File properties **/
 
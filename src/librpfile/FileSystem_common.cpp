@@ -19,7 +19,7 @@
 #endif
 
 // librpthreads
-#include "librpthreads/pthread_once.h"
+#include "librpthreads/rp_once.h"
 
 // libcachecommon
 #include "libcachecommon/CacheDir.hpp"
@@ -30,14 +30,14 @@ using std::string;
 namespace LibRpFile { namespace FileSystem {
 
 /** Configuration directories. **/
-// pthread_once() control variable.
-static pthread_once_t cfgdir_once_control = PTHREAD_ONCE_INIT;
+// rp_once() control variable.
+static rp_once_t cfgdir_once_control = RP_ONCE_INIT;
 // User's configuration directory.
 static string config_dir;
 
 /**
  * Initialize the configuration directory paths.
- * Called by pthread_once().
+ * Called by rp_once().
  */
 static void initConfigDirectories(void)
 {
@@ -82,7 +82,7 @@ const string &getCacheDirectory(void)
 const string &getConfigDirectory(void)
 {
 	// TODO: Handle errors.
-	pthread_once(&cfgdir_once_control, initConfigDirectories);
+	rp_once(&cfgdir_once_control, initConfigDirectories);
 	return config_dir;
 }
 
@@ -0,0 +1,300 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpfile)                        *
+ * HeaderCache.cpp: Cross-process shared-memory header cache.              *
+ *                                                                         *
+ * Copyright (c) 2016-2024 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "config.librpfile.h"
+#include "HeaderCache.hpp"
+
+// C includes (C++ namespace)
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// C++ STL classes
+#include <atomic>
+
+#ifndef _WIN32
+// POSIX shared memory
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif /* !_WIN32 */
+
+namespace LibRpFile { namespace HeaderCache {
+
+// Number of direct-mapped cache entries.
+// 64 entries * (16 KiB + key) is a ~1 MiB segment, which is
+// enough to cover a screenful of thumbnails being generated by
+// several processes at once.
+static constexpr unsigned int NUM_ENTRIES = 64;
+
+/**
+ * A single cache entry.
+ *
+ * seq is a seqlock: an odd value means a write is in progress.
+ * Writers acquire the entry by CASing seq from even to odd, update
+ * the entry, then store seq+2. Readers copy the entry, then verify
+ * that seq didn't change. (The non-atomic field accesses during a
+ * concurrent write are a benign race by design; torn data is
+ * always discarded by the seq recheck.)
+ */
+struct CacheEntry {
+	std::atomic<uint32_t> seq;
+	uint32_t len;		// Number of valid bytes in data[].
+	Key key;
+	uint8_t data[DATA_SIZE];
+};
+
+/**
+ * Get the shared-memory cache entries, mapping the segment on first call.
+ * @return Entry array, or nullptr if the cache is disabled or unavailable.
+ */
+static CacheEntry *getShm(void)
+{
+	// NOTE: The segment is mapped (and on Windows, the mapping handle
+	// is held) for the lifetime of the process.
+	static CacheEntry *const p_entries = []() -> CacheEntry* {
+		// RP_HEADER_CACHE=0 disables the cache.
+		const char *const env = getenv("RP_HEADER_CACHE");
+		if (env && env[0] == '0' && env[1] == '\0') {
+			return nullptr;
+		}
+
+		const size_t shm_size = sizeof(CacheEntry) * NUM_ENTRIES;
+		// NOTE: The layout version is part of the segment name.
+		// Bump it if CacheEntry or NUM_ENTRIES changes.
+#ifdef _WIN32
+		// Named file mapping backed by the page file.
+		// "Local\\" scopes it to the current session.
+		HANDLE hMap = CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr,
+			PAGE_READWRITE, 0, static_cast<DWORD>(shm_size),
+			L"Local\\rom-properties.hdrcache1");
+		if (!hMap) {
+			return nullptr;
+		}
+		void *const p = MapViewOfFile(hMap, FILE_MAP_ALL_ACCESS, 0, 0, shm_size);
+		if (!p) {
+			CloseHandle(hMap);
+			return nullptr;
+		}
+		return static_cast<CacheEntry*>(p);
+#else /* !_WIN32 */
+		// POSIX shared memory.
+		// The segment name includes the effective UID, and the mode
+		// is 0600, so users can't read each other's file headers.
+		char shm_name[64];
+		snprintf(shm_name, sizeof(shm_name), "/rom-properties.hdrcache1.%u",
+			static_cast<unsigned int>(geteuid()));
+		const int fd = shm_open(shm_name, O_RDWR | O_CREAT, 0600);
+		if (fd < 0) {
+			return nullptr;
+		}
+
+		// Make sure we own the segment. Another user could have
+		// pre-created a world-writable segment with our name.
+		struct stat sb;
+		if (fstat(fd, &sb) != 0 || sb.st_uid != geteuid()) {
+			close(fd);
+			return nullptr;
+		}
+
+		// NOTE: No-op if the segment is already at the right size.
+		// The new pages are zero-filled, which reads as empty entries.
+		if (ftruncate(fd, static_cast<off_t>(shm_size)) != 0) {
+			close(fd);
+			return nullptr;
+		}
+
+		void *const p = mmap(nullptr, shm_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		close(fd);
+		if (p == MAP_FAILED) {
+			return nullptr;
+		}
+		return static_cast<CacheEntry*>(p);
+#endif /* _WIN32 */
+	}();
+	return p_entries;
+}
+
+/**
+ * Map a key to its direct-mapped entry slot.
+ * @param key File identity key.
+ * @return Slot index.
+ */
+static inline unsigned int keySlot(const Key &key)
+{
+	// Mix the key fields. (SplitMix64-style finalizer)
+	uint64_t h = key.dev ^ (key.ino * 0x9E3779B97F4A7C15ULL) ^
+	             key.fsize ^ static_cast<uint64_t>(key.mtime);
+	h ^= (h >> 30);
+	h *= 0xBF58476D1CE4E5B9ULL;
+	h ^= (h >> 27);
+	return static_cast<unsigned int>(h % NUM_ENTRIES);
+}
+
+/**
+ * Is the header cache available?
+ * This maps the shared-memory segment on first call.
+ * @return True if available; false if disabled or unavailable.
+ */
+bool isEnabled(void)
+{
+	return (getShm() != nullptr);
+}
+
+#ifdef _WIN32
+/**
+ * Get the cache key for an open file.
+ * @param hFile	[in] File handle.
+ * @param pKey	[out] Key.
+ * @return True on success; false if the file isn't a cacheable regular file.
+ */
+bool getKey(HANDLE hFile, Key *pKey)
+{
+	assert(pKey != nullptr);
+	BY_HANDLE_FILE_INFORMATION bhfi;
+	if (!GetFileInformationByHandle(hFile, &bhfi)) {
+		return false;
+	}
+	if (bhfi.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+		return false;
+	}
+
+	pKey->dev = bhfi.dwVolumeSerialNumber;
+	pKey->ino = (static_cast<uint64_t>(bhfi.nFileIndexHigh) << 32) | bhfi.nFileIndexLow;
+	pKey->fsize = (static_cast<uint64_t>(bhfi.nFileSizeHigh) << 32) | bhfi.nFileSizeLow;
+	pKey->mtime = (static_cast<int64_t>(bhfi.ftLastWriteTime.dwHighDateTime) << 32) |
+	              bhfi.ftLastWriteTime.dwLowDateTime;
+	return true;
+}
+#else /* !_WIN32 */
+/**
+ * Get the cache key for an open file.
+ * @param fd	[in] File descriptor.
+ * @param pKey	[out] Key.
+ * @return True on success; false if the file isn't a cacheable regular file.
+ */
+bool getKey(int fd, Key *pKey)
+{
+	assert(pKey != nullptr);
+	struct stat sb;
+	if (fstat(fd, &sb) != 0) {
+		return false;
+	}
+	if (!S_ISREG(sb.st_mode)) {
+		// Not a regular file.
+		return false;
+	}
+
+	pKey->dev = sb.st_dev;
+	pKey->ino = sb.st_ino;
+	pKey->fsize = static_cast<uint64_t>(sb.st_size);
+	pKey->mtime = sb.st_mtime;
+	return true;
+}
+#endif /* _WIN32 */
+
+/**
+ * Look up a file's header in the cache.
+ * @param key	[in] File identity key.
+ * @param buf	[out] Output buffer.
+ * @param size	[in] Maximum number of bytes to copy.
+ * @return Number of bytes copied, or 0 on cache miss.
+ */
+size_t lookup(const Key &key, void *buf, size_t size)
+{
+	assert(buf != nullptr);
+	CacheEntry *const entries = getShm();
+	if (!entries || size == 0) {
+		return 0;
+	}
+	CacheEntry *const entry = &entries[keySlot(key)];
+
+	// Seqlock read: retry a few times if a writer is active.
+	for (unsigned int tries = 4; tries > 0; tries--) {
+		const uint32_t seq1 = entry->seq.load(std::memory_order_acquire);
+		if (seq1 & 1) {
+			// Write in progress.
+			continue;
+		}
+
+		// Validate the key first to avoid copying data on a miss.
+		const Key ekey = entry->key;
+		uint32_t len = entry->len;
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (entry->seq.load(std::memory_order_relaxed) != seq1) {
+			// Torn read.
+			continue;
+		}
+		if (ekey.dev != key.dev || ekey.ino != key.ino ||
+		    ekey.fsize != key.fsize || ekey.mtime != key.mtime ||
+		    len == 0)
+		{
+			// Different file (or empty entry). Cache miss.
+			return 0;
+		}
+
+		if (len > DATA_SIZE) {
+			len = DATA_SIZE;
+		}
+		const size_t copy_len = (len < size) ? len : size;
+		memcpy(buf, entry->data, copy_len);
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (entry->seq.load(std::memory_order_relaxed) != seq1) {
+			// Entry was overwritten while copying.
+			continue;
+		}
+		return copy_len;
+	}
+
+	// Couldn't get a stable read.
+	return 0;
+}
+
+/**
+ * Store a file's header in the cache.
+ * Best-effort: silently does nothing if another writer holds the entry.
+ * @param key	[in] File identity key.
+ * @param data	[in] Header data.
+ * @param size	[in] Number of bytes. (clamped to DATA_SIZE)
+ */
+void store(const Key &key, const void *data, size_t size)
+{
+	assert(data != nullptr);
+	CacheEntry *const entries = getShm();
+	if (!entries || size == 0) {
+		return;
+	}
+	if (size > DATA_SIZE) {
+		size = DATA_SIZE;
+	}
+	CacheEntry *const entry = &entries[keySlot(key)];
+
+	// Acquire the entry's seqlock.
+	// NOTE: If seq is odd, another writer holds the entry (or a
+	// process died mid-write). Don't wait; the cache is best-effort.
+	uint32_t seq = entry->seq.load(std::memory_order_relaxed);
+	if (seq & 1) {
+		return;
+	}
+	if (!entry->seq.compare_exchange_strong(seq, seq + 1,
+		std::memory_order_acquire, std::memory_order_relaxed))
+	{
+		return;
+	}
+
+	entry->key = key;
+	entry->len = static_cast<uint32_t>(size);
+	memcpy(entry->data, data, size);
+
+	// Publish the entry.
+	entry->seq.store(seq + 2, std::memory_order_release);
+}
+
+} }
@@ -0,0 +1,99 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpfile)                        *
+ * HeaderCache.hpp: Cross-process shared-memory header cache.              *
+ *                                                                         *
+ * Copyright (c) 2016-2024 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#pragma once
+
+// C includes (C++ namespace)
+#include <cstddef>
+#include <stdint.h>
+
+#ifdef _WIN32
+// Windows SDK
+#  include <windows.h>
+#endif /* _WIN32 */
+
+namespace LibRpFile { namespace HeaderCache {
+
+/**
+ * Cross-process shared-memory cache of file header pages.
+ *
+ * Shell extension hosts (icon handler, property store, overlay) each
+ * open the same files and read the same first few KiB within seconds
+ * of each other. This cache keeps (file identity -> header bytes) in
+ * a small shared-memory segment so only the first process issues the
+ * actual I/O; subsequent processes get a memory copy. This matters
+ * most for network file systems, where every redundant read is a
+ * round trip.
+ *
+ * Entries are direct-mapped and seqlock-protected: readers retry if
+ * a concurrent writer is detected, and writers that lose the race to
+ * lock an entry simply skip the store. The cache is strictly
+ * best-effort; a miss just means the caller does its own read.
+ *
+ * Set the environment variable RP_HEADER_CACHE=0 to disable.
+ */
+
+// Maximum number of bytes cached from the beginning of a file.
+static constexpr size_t DATA_SIZE = 16U*1024;
+
+/**
+ * File identity key.
+ * A cached entry is only valid if all four fields match, so a
+ * modified file (size or mtime change) is never served stale data.
+ */
+struct Key {
+	uint64_t dev;	// Device ID (volume serial number on Windows)
+	uint64_t ino;	// Inode number (file index on Windows)
+	uint64_t fsize;	// File size, in bytes
+	int64_t mtime;	// Modification time
+};
+
+/**
+ * Is the header cache available?
+ * This maps the shared-memory segment on first call.
+ * @return True if available; false if disabled or unavailable.
+ */
+bool isEnabled(void);
+
+#ifdef _WIN32
+/**
+ * Get the cache key for an open file.
+ * @param hFile	[in] File handle.
+ * @param pKey	[out] Key.
+ * @return True on success; false if the file isn't a cacheable regular file.
+ */
+bool getKey(HANDLE hFile, Key *pKey);
+#else /* !_WIN32 */
+/**
+ * Get the cache key for an open file.
+ * @param fd	[in] File descriptor.
+ * @param pKey	[out] Key.
+ * @return True on success; false if the file isn't a cacheable regular file.
+ */
+bool getKey(int fd, Key *pKey);
+#endif /* _WIN32 */
+
+/**
+ * Look up a file's header in the cache.
+ * @param key	[in] File identity key.
+ * @param buf	[out] Output buffer.
+ * @param size	[in] Maximum number of bytes to copy.
+ * @return Number of bytes copied, or 0 on cache miss.
+ */
+size_t lookup(const Key &key, void *buf, size_t size);
+
+/**
+ * Store a file's header in the cache.
+ * Best-effort: silently does nothing if another writer holds the entry.
+ * @param key	[in] File identity key.
+ * @param data	[in] Header data.
+ * @param size	[in] Number of bytes. (clamped to DATA_SIZE)
+ */
+void store(const Key &key, const void *data, size_t size);
+
+} }
@@ -8,6 +8,7 @@
 
 #include "stdafx.h"
 #include "IRpFile.hpp"
+#include "ReadAhead.hpp"
 
 namespace LibRpFile {
 
@@ -54,6 +55,52 @@ int IRpFile::ungetc(int c)
 	return this->seek(pos-1);
 }
 
+/**
+ * Read data from multiple scattered file offsets.
+ *
+ * The default implementation issues one seek+read pair per
+ * entry. Subclasses may override this to satisfy the entire
+ * vector with fewer syscalls, e.g. pread() per entry for
+ * local files, or plain memcpy() for memory-backed files.
+ *
+ * NOTE: The file position after this call is unspecified.
+ *
+ * @param vec	[in/out] Array of read vector entries.
+ * @param count	[in] Number of entries in vec.
+ * @return Number of entries that were fully read.
+ */
+size_t IRpFile::readVec(ReadVecEntry *vec, size_t count)
+{
+	assert(vec != nullptr || count == 0);
+	size_t entries_read = 0;
+	for (; count > 0; count--, vec++) {
+		if (this->seekAndRead(vec->offset, vec->dest, vec->size) == vec->size) {
+			entries_read++;
+		}
+	}
+	return entries_read;
+}
+
+/**
+ * Get this file's linear mapping onto an underlying file, if any.
+ *
+ * Trivially-linear layers (a fixed offset into a single
+ * underlying file, with no data transformation) return the
+ * underlying file and the offset to add. This allows nested
+ * reader stacks to be flattened at construction time, so a
+ * read through several layers is one virtual call instead
+ * of one per layer.
+ *
+ * @param pOffset	[out] Offset to add to file positions in the underlying file.
+ * @return Underlying file, or nullptr if this layer isn't trivially linear.
+ */
+std::shared_ptr<IRpFile> IRpFile::getLinearMapping(off64_t *pOffset)
+{
+	// Not a linear layer by default.
+	RP_UNUSED(pOffset);
+	return nullptr;
+}
+
 /**
  * Copy data from this IRpFile to another IRpFile.
  * Read/write positions must be set before calling this function.
@@ -79,10 +126,20 @@ int IRpFile::copyTo(IRpFile *pDestFile, off64_t size,
 #define COPYTO_BUFFER_SIZE (64*1024)
 	uint8_t *buf = static_cast<uint8_t*>(malloc(COPYTO_BUFFER_SIZE));
 
+	// Keep a readahead window ahead of the copy.
+	// Layered readers translate the hint to physical ranges,
+	// e.g. for compressed disc images.
+	SequentialReadAhead readAhead(this);
+	off64_t readPos = this->tell();
+
 	// Copy the data.
 	for (; size > 0; size -= COPYTO_BUFFER_SIZE) {
 		const size_t cbRead = this->read(buf, COPYTO_BUFFER_SIZE);
 		cbReadTotal += cbRead;
+		if (readPos >= 0 && cbRead > 0) {
+			readAhead.onRead(readPos, cbRead);
+			readPos += cbRead;
+		}
 		if (cbRead != COPYTO_BUFFER_SIZE &&
 		    (size < COPYTO_BUFFER_SIZE && cbRead != (size_t)size))
 		{
@@ -169,6 +169,100 @@ class RP_LIBROMDATA_PUBLIC NOVTABLE IRpFile
 			return -ENOTSUP;
 		}
 
+		/**
+		 * Advise the file of an upcoming read.
+		 *
+		 * This is a best-effort hint for predictable access patterns:
+		 * implementations may start readahead for the specified range,
+		 * or ignore the hint entirely.
+		 *
+		 * @param offset	[in] Start of the range that will be read.
+		 * @param size		[in] Length of the range, in bytes.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		virtual int advise(off64_t offset, size_t size)
+		{
+			// Ignored by default.
+			RP_UNUSED(offset);
+			RP_UNUSED(size);
+			return 0;
+		}
+
+		/**
+		 * Access intent for the file's remaining lifetime.
+		 */
+		enum class AccessIntent : uint8_t {
+			Normal = 0,	// No particular access pattern.
+			Sequential,	// Will be read sequentially, start to end.
+			Random,		// Will be read in small scattered chunks.
+			HeaderOnly,	// No further reads are expected;
+					// cached pages may be dropped.
+		};
+
+		/**
+		 * Set the expected access pattern for this file.
+		 *
+		 * This is a best-effort hint, mapped to posix_fadvise() or
+		 * madvise() where available: it adjusts kernel readahead for
+		 * the expected pattern, and HeaderOnly lets the kernel drop
+		 * pages cached during bulk probing runs. Implementations may
+		 * ignore the hint entirely.
+		 *
+		 * @param intent	[in] Access intent.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		virtual int setAccessIntent(AccessIntent intent)
+		{
+			// Ignored by default.
+			RP_UNUSED(intent);
+			return 0;
+		}
+
+		/**
+		 * Vectored read entry: one scattered read request.
+		 */
+		struct ReadVecEntry {
+			off64_t offset;	// File offset to read from
+			void *dest;	// Destination buffer
+			size_t size;	// Number of bytes to read
+		};
+
+		/**
+		 * Read data from multiple scattered file offsets.
+		 *
+		 * The default implementation issues one seek+read pair per
+		 * entry. Subclasses may override this to satisfy the entire
+		 * vector with fewer syscalls, e.g. pread() per entry for
+		 * local files, or plain memcpy() for memory-backed files.
+		 *
+		 * NOTE: The file position after this call is unspecified.
+		 *
+		 * @param vec	[in/out] Array of read vector entries.
+		 * @param count	[in] Number of entries in vec.
+		 * @return Number of entries that were fully read.
+		 */
+		virtual size_t readVec(ReadVecEntry *vec, size_t count);
+
+		/**
+		 * Get this file's linear mapping onto an underlying file, if any.
+		 *
+		 * Trivially-linear layers (a fixed offset into a single
+		 * underlying file, with no data transformation) return the
+		 * underlying file and the offset to add. This allows nested
+		 * reader stacks to be flattened at construction time, so a
+		 * read through several layers is one virtual call instead
+		 * of one per layer.
+		 *
+		 * NOTE: Length bounds of collapsed layers are not enforced;
+		 * the caller is responsible for length checks. (Same semantics
+		 * as SubFile.)
+		 *
+		 * @param pOffset	[out] Offset to add to file positions in the underlying file.
+		 * @return Underlying file, or nullptr if this layer isn't trivially linear.
+		 */
+		ATTR_ACCESS(write_only, 2)
+		virtual std::shared_ptr<IRpFile> getLinearMapping(off64_t *pOffset);
+
 	public:
 		/** File properties **/
 
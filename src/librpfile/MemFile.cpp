@@ -29,6 +29,7 @@ MemFile::MemFile(const void *buf, size_t size)
 	, m_buf(buf)
 	, m_size(static_cast<off64_t>(size))
 	, m_pos(0)
+	, m_pOwnedVector(nullptr)
 	, m_filename(nullptr)
 {
 	assert(buf != nullptr);
@@ -39,6 +40,35 @@ MemFile::MemFile(const void *buf, size_t size)
 	}
 }
 
+/**
+ * Open an IRpFile backed by memory, taking ownership
+ * of an std::vector. The resulting IRpFile is read-only.
+ *
+ * NOTE: The vector is moved, not copied, so multi-megabyte
+ * payloads (e.g. decompressed data written to a VectorFile)
+ * can be handed off without a copy.
+ *
+ * @param vec Memory buffer. (moved)
+ */
+MemFile::MemFile(std::vector<uint8_t> &&vec)
+	: super()
+	, m_buf(nullptr)
+	, m_size(0)
+	, m_pos(0)
+	, m_pOwnedVector(new std::vector<uint8_t>(std::move(vec)))
+	, m_filename(nullptr)
+{
+	assert(!m_pOwnedVector->empty());
+	if (m_pOwnedVector->empty()) {
+		// No data specified.
+		m_lastError = EBADF;
+		return;
+	}
+
+	m_buf = m_pOwnedVector->data();
+	m_size = m_pOwnedVector->size();
+}
+
 /**
  * Internal constructor for use by subclasses.
  * This initializes everything to nullptr.
@@ -48,11 +78,13 @@ MemFile::MemFile()
 	, m_buf(nullptr)
 	, m_size(0)
 	, m_pos(0)
+	, m_pOwnedVector(nullptr)
 	, m_filename(nullptr)
 { }
 
 MemFile::~MemFile()
 {
+	delete m_pOwnedVector;
 	free(m_filename);
 }
 
@@ -64,6 +96,9 @@ void MemFile::close(void)
 	m_buf = nullptr;
 	m_size = 0;
 	m_pos = 0;
+
+	delete m_pOwnedVector;
+	m_pOwnedVector = nullptr;
 }
 
 /**
@@ -140,6 +175,41 @@ int MemFile::seek(off64_t pos)
 	return 0;
 }
 
+/**
+ * Read data from multiple scattered file offsets.
+ *
+ * All entries are satisfied with memcpy() from the memory
+ * buffer. The current file position is not modified.
+ *
+ * @param vec	[in/out] Array of read vector entries.
+ * @param count	[in] Number of entries in vec.
+ * @return Number of entries that were fully read.
+ */
+size_t MemFile::readVec(ReadVecEntry *vec, size_t count)
+{
+	if (!m_buf) {
+		m_lastError = EBADF;
+		return 0;
+	}
+
+	assert(vec != nullptr || count == 0);
+	const uint8_t *const buf = static_cast<const uint8_t*>(m_buf);
+	size_t entries_read = 0;
+	for (; count > 0; count--, vec++) {
+		// Check if the entry is fully within the buffer.
+		if (vec->offset < 0 || vec->size > m_size ||
+		    static_cast<size_t>(vec->offset) > (m_size - vec->size))
+		{
+			// Out of bounds.
+			continue;
+		}
+
+		memcpy(vec->dest, &buf[vec->offset], vec->size);
+		entries_read++;
+	}
+	return entries_read;
+}
+
 /**
  * Get the file position.
  * @return File position, or -1 on error.
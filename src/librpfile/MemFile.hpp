@@ -10,6 +10,9 @@
 
 #include "IRpFile.hpp"
 
+// C++ includes
+#include <vector>
+
 namespace LibRpFile {
 
 class RP_LIBROMDATA_PUBLIC MemFile : public IRpFile
@@ -27,6 +30,18 @@ class RP_LIBROMDATA_PUBLIC MemFile : public IRpFile
 		 */
 		ATTR_ACCESS_SIZE(read_only, 2, 3)
 		MemFile(const void *buf, size_t size);
+
+		/**
+		 * Open an IRpFile backed by memory, taking ownership
+		 * of an std::vector. The resulting IRpFile is read-only.
+		 *
+		 * NOTE: The vector is moved, not copied, so multi-megabyte
+		 * payloads (e.g. decompressed data written to a VectorFile)
+		 * can be handed off without a copy.
+		 *
+		 * @param vec Memory buffer. (moved)
+		 */
+		explicit MemFile(std::vector<uint8_t> &&vec);
 	protected:
 		/**
 		 * Internal constructor for use by subclasses.
@@ -88,6 +103,18 @@ class RP_LIBROMDATA_PUBLIC MemFile : public IRpFile
 		 */
 		off64_t tell(void) final;
 
+		/**
+		 * Read data from multiple scattered file offsets.
+		 *
+		 * All entries are satisfied with memcpy() from the memory
+		 * buffer. The current file position is not modified.
+		 *
+		 * @param vec	[in/out] Array of read vector entries.
+		 * @param count	[in] Number of entries in vec.
+		 * @return Number of entries that were fully read.
+		 */
+		size_t readVec(ReadVecEntry *vec, size_t count) final;
+
 	public:
 		/** File properties **/
 
@@ -117,6 +144,17 @@ class RP_LIBROMDATA_PUBLIC MemFile : public IRpFile
 	public:
 		/** MemFile functions **/
 
+		/**
+		 * Get a direct pointer to the memory buffer.
+		 * NOTE: The pointer is owned by the MemFile and is
+		 * only valid until the file is closed.
+		 * @return Memory buffer, or nullptr if the file is closed.
+		 */
+		inline const void *buffer(void) const
+		{
+			return m_buf;
+		}
+
 		/**
 		 * Set the filename.
 		 * @param filename Filename
@@ -134,6 +172,11 @@ class RP_LIBROMDATA_PUBLIC MemFile : public IRpFile
 		size_t m_size;		// Size of memory buffer
 		size_t m_pos;		// Current position
 
+		// Owned buffer, if constructed from an rvalue std::vector.
+		// m_buf points into this vector in that case.
+		// NOTE: Needs to be ptr to prevent DLL linkage issues.
+		std::vector<uint8_t> *m_pOwnedVector;
+
 		char *m_filename;	// Dummy filename
 };
 
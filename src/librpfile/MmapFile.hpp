@@ -0,0 +1,70 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpfile)                        *
+ * MmapFile.hpp: IRpFile implementation using a memory-mapped file.        *
+ *                                                                         *
+ * Copyright (c) 2016-2024 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#pragma once
+
+#include "MemFile.hpp"
+
+namespace LibRpFile {
+
+class RP_LIBROMDATA_PUBLIC MmapFile : public MemFile
+{
+	public:
+		/**
+		 * Open a local file as a read-only memory mapping.
+		 *
+		 * Only regular files can be mapped. For pipes, devices,
+		 * and other special files, isOpen() will return false;
+		 * the caller should fall back to RpFile.
+		 *
+		 * @param filename Filename (UTF-8)
+		 */
+		explicit MmapFile(const char *filename);
+#ifdef _WIN32
+		/**
+		 * Open a local file as a read-only memory mapping.
+		 *
+		 * Only regular files can be mapped. For pipes, devices,
+		 * and other special files, isOpen() will return false;
+		 * the caller should fall back to RpFile.
+		 *
+		 * @param filename Filename (UTF-16)
+		 */
+		explicit MmapFile(const wchar_t *filename);
+#endif /* _WIN32 */
+	public:
+		~MmapFile() override;
+
+	private:
+		typedef MemFile super;
+		RP_DISABLE_COPY(MmapFile)
+
+	public:
+		/**
+		 * Close the file.
+		 * This unmaps the file from memory.
+		 */
+		void close(void) final;
+
+		/**
+		 * Set the expected access pattern for this file.
+		 *
+		 * This is a best-effort hint: on POSIX systems, it's mapped
+		 * to madvise() (SEQUENTIAL/RANDOM/DONTNEED). HeaderOnly drops
+		 * the mapping's resident pages; they're faulted back in from
+		 * the file if they're read again.
+		 *
+		 * @param intent	[in] Access intent.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int setAccessIntent(AccessIntent intent) final;
+};
+
+typedef std::shared_ptr<MmapFile> MmapFilePtr;
+
+}
@@ -0,0 +1,145 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpfile)                        *
+ * MmapFile_posix.cpp: IRpFile implementation using a memory-mapped file.  *
+ * (POSIX mmap() implementation)                                           *
+ *                                                                         *
+ * Copyright (c) 2016-2024 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "MmapFile.hpp"
+
+// C includes
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// C++ STL classes
+#include <limits>
+
+namespace LibRpFile {
+
+/**
+ * Open a local file as a read-only memory mapping.
+ *
+ * Only regular files can be mapped. For pipes, devices,
+ * and other special files, isOpen() will return false;
+ * the caller should fall back to RpFile.
+ *
+ * @param filename Filename (UTF-8)
+ */
+MmapFile::MmapFile(const char *filename)
+	: super()
+{
+	assert(filename != nullptr);
+	assert(filename[0] != '\0');
+	if (!filename || filename[0] == '\0') {
+		m_lastError = EINVAL;
+		return;
+	}
+
+	const int fd = open(filename, O_RDONLY | O_CLOEXEC);
+	if (fd < 0) {
+		m_lastError = errno;
+		if (m_lastError == 0) {
+			m_lastError = EIO;
+		}
+		return;
+	}
+
+	// Only regular, non-empty files can be mapped.
+	// (mmap() of an empty file fails with EINVAL.)
+	struct stat sb;
+	if (fstat(fd, &sb) != 0 || !S_ISREG(sb.st_mode) || sb.st_size <= 0 ||
+	    static_cast<uint64_t>(sb.st_size) > std::numeric_limits<size_t>::max())
+	{
+		// Not a mappable file.
+		m_lastError = ENOTSUP;
+		::close(fd);
+		return;
+	}
+
+	void *const map = mmap(nullptr, static_cast<size_t>(sb.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	// The mapping stays valid without the file descriptor.
+	::close(fd);
+	if (map == MAP_FAILED) {
+		m_lastError = errno;
+		if (m_lastError == 0) {
+			m_lastError = EIO;
+		}
+		return;
+	}
+
+	m_buf = map;
+	m_size = static_cast<size_t>(sb.st_size);
+	m_pos = 0;
+	setFilename(filename);
+}
+
+MmapFile::~MmapFile()
+{
+	if (m_buf) {
+		munmap(const_cast<void*>(m_buf), m_size);
+	}
+}
+
+/**
+ * Close the file.
+ * This unmaps the file from memory.
+ */
+void MmapFile::close(void)
+{
+	if (m_buf) {
+		munmap(const_cast<void*>(m_buf), m_size);
+	}
+	super::close();
+}
+
+/**
+ * Set the expected access pattern for this file.
+ *
+ * This is a best-effort hint: on POSIX systems, it's mapped
+ * to madvise() (SEQUENTIAL/RANDOM/DONTNEED). HeaderOnly drops
+ * the mapping's resident pages; they're faulted back in from
+ * the file if they're read again.
+ *
+ * @param intent	[in] Access intent.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int MmapFile::setAccessIntent(AccessIntent intent)
+{
+	if (!m_buf) {
+		m_lastError = EBADF;
+		return -EBADF;
+	}
+
+	int advice;
+	switch (intent) {
+		case AccessIntent::Normal:
+		default:
+			advice = MADV_NORMAL;
+			break;
+		case AccessIntent::Sequential:
+			advice = MADV_SEQUENTIAL;
+			break;
+		case AccessIntent::Random:
+			advice = MADV_RANDOM;
+			break;
+		case AccessIntent::HeaderOnly:
+			// No more reads are expected. Drop the resident pages;
+			// the mapping is MAP_PRIVATE and unmodified, so they'd
+			// be faulted back in from the file if read again.
+			advice = MADV_DONTNEED;
+			break;
+	}
+
+	if (madvise(const_cast<void*>(m_buf), m_size, advice) != 0) {
+		m_lastError = errno;
+		return -m_lastError;
+	}
+	return 0;
+}
+
+}
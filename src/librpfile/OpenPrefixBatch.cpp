@@ -0,0 +1,376 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpfile)                        *
+ * OpenPrefixBatch.cpp: Batched asynchronous open+read-prefix.             *
+ *                                                                         *
+ * Copyright (c) 2016-2024 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "config.librpfile.h"
+
+#include "OpenPrefixBatch.hpp"
+#include "RpFile.hpp"
+
+#if defined(__linux__) && defined(HAVE_IORING_OP_OPENAT)
+// io_uring (raw syscalls; no liburing dependency)
+#  include <fcntl.h>
+#  include <linux/io_uring.h>
+#  include <sys/mman.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#endif /* __linux__ && HAVE_IORING_OP_OPENAT */
+
+// C++ STL classes
+#include <atomic>
+#include <thread>
+using std::string;
+using std::vector;
+
+namespace LibRpFile {
+
+#if defined(__linux__) && defined(HAVE_IORING_OP_OPENAT)
+/**
+ * Open multiple files and read a prefix of each one using io_uring.
+ *
+ * Opens and reads are submitted in ring-sized batches, so the kernel
+ * can issue them concurrently instead of paying each file's open+read
+ * latency serially.
+ *
+ * @param filenames	[in] Filenames to open. (UTF-8)
+ * @param prefixSize	[in] Number of bytes to read from the start of each file.
+ * @param pResults	[out,opt] Per-file results, in filename order. (nullptr to discard)
+ * @param maxInFlight	[in] Maximum number of requests in flight. (0 for automatic)
+ * @return 0 on success; negative POSIX error code if io_uring is unavailable.
+ */
+static int openPrefixBatch_io_uring(const vector<string> &filenames,
+	size_t prefixSize, vector<OpenPrefixResult> *pResults, unsigned int maxInFlight)
+{
+	// Set up the ring. The kernel rounds the entry count
+	// up to a power of two.
+	struct io_uring_params params;
+	memset(&params, 0, sizeof(params));
+	unsigned int entries = (maxInFlight != 0 && maxInFlight < 64U) ? maxInFlight : 64U;
+	if (filenames.size() < entries) {
+		entries = static_cast<unsigned int>(filenames.size());
+	}
+	const int ring_fd = static_cast<int>(syscall(SYS_io_uring_setup, entries, &params));
+	if (ring_fd < 0) {
+		// io_uring isn't available. (old kernel, or seccomp)
+		return -errno;
+	}
+
+	// Map the submission and completion queue rings.
+	size_t sq_ring_sz = params.sq_off.array + (params.sq_entries * sizeof(__u32));
+	size_t cq_ring_sz = params.cq_off.cqes + (params.cq_entries * sizeof(struct io_uring_cqe));
+	if (params.features & IORING_FEAT_SINGLE_MMAP) {
+		if (cq_ring_sz > sq_ring_sz) {
+			sq_ring_sz = cq_ring_sz;
+		}
+	}
+	uint8_t *const sq_ptr = static_cast<uint8_t*>(mmap(nullptr, sq_ring_sz,
+		PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+		ring_fd, IORING_OFF_SQ_RING));
+	if (sq_ptr == MAP_FAILED) {
+		close(ring_fd);
+		return -ENOMEM;
+	}
+	uint8_t *cq_ptr;
+	if (params.features & IORING_FEAT_SINGLE_MMAP) {
+		cq_ptr = sq_ptr;
+	} else {
+		cq_ptr = static_cast<uint8_t*>(mmap(nullptr, cq_ring_sz,
+			PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+			ring_fd, IORING_OFF_CQ_RING));
+		if (cq_ptr == MAP_FAILED) {
+			munmap(sq_ptr, sq_ring_sz);
+			close(ring_fd);
+			return -ENOMEM;
+		}
+	}
+	const size_t sqes_sz = params.sq_entries * sizeof(struct io_uring_sqe);
+	struct io_uring_sqe *const sqes = static_cast<struct io_uring_sqe*>(mmap(
+		nullptr, sqes_sz, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+		ring_fd, IORING_OFF_SQES));
+	if (sqes == MAP_FAILED) {
+		if (cq_ptr != sq_ptr) {
+			munmap(cq_ptr, cq_ring_sz);
+		}
+		munmap(sq_ptr, sq_ring_sz);
+		close(ring_fd);
+		return -ENOMEM;
+	}
+
+	// Ring pointers.
+	__u32 *const sq_tail = reinterpret_cast<__u32*>(sq_ptr + params.sq_off.tail);
+	const __u32 sq_mask = *reinterpret_cast<__u32*>(sq_ptr + params.sq_off.ring_mask);
+	__u32 *const sq_array = reinterpret_cast<__u32*>(sq_ptr + params.sq_off.array);
+	__u32 *const cq_head = reinterpret_cast<__u32*>(cq_ptr + params.cq_off.head);
+	__u32 *const cq_tail = reinterpret_cast<__u32*>(cq_ptr + params.cq_off.tail);
+	const __u32 cq_mask = *reinterpret_cast<__u32*>(cq_ptr + params.cq_off.ring_mask);
+	const struct io_uring_cqe *const cqes =
+		reinterpret_cast<struct io_uring_cqe*>(cq_ptr + params.cq_off.cqes);
+
+	/**
+	 * Submit a batch of SQEs and reap all of their completions.
+	 * @param count		[in] Number of SQEs to submit. (filled in by fill)
+	 * @param fill		[in] Fills SQE i of the batch; returns user_data.
+	 * @param complete	[in] Called with (user_data, res) per completion.
+	 * @return 0 on success; negative POSIX error code on error.
+	 */
+	auto submitAndReap = [&](unsigned int count, auto fill, auto complete) -> int {
+		__u32 tail = *sq_tail;
+		for (unsigned int i = 0; i < count; i++) {
+			const __u32 sqidx = tail & sq_mask;
+			struct io_uring_sqe *const sqe = &sqes[sqidx];
+			memset(sqe, 0, sizeof(*sqe));
+			sqe->user_data = fill(i, sqe);
+			sq_array[sqidx] = sqidx;
+			tail++;
+		}
+		// Publish the new SQ tail.
+		__atomic_store_n(sq_tail, tail, __ATOMIC_RELEASE);
+
+		// Submit the batch and wait for all of its completions.
+		const int eret = static_cast<int>(syscall(SYS_io_uring_enter,
+			ring_fd, count, count, IORING_ENTER_GETEVENTS, nullptr, 0));
+		if (eret < 0) {
+			return -errno;
+		}
+
+		// Reap the completions.
+		__u32 head = *cq_head;
+		const __u32 tail_now = __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE);
+		for (; head != tail_now; head++) {
+			const struct io_uring_cqe *const cqe = &cqes[head & cq_mask];
+			complete(static_cast<size_t>(cqe->user_data), cqe->res);
+		}
+		__atomic_store_n(cq_head, head, __ATOMIC_RELEASE);
+		return 0;
+	};
+
+	// Open file descriptors, indexed by filename.
+	vector<int> fds(filenames.size(), -1);
+	// Scratch buffers for discard mode. (one per ring entry)
+	vector<vector<uint8_t> > scratch;
+	if (!pResults && prefixSize > 0) {
+		scratch.resize(params.sq_entries);
+		for (vector<uint8_t> &buf : scratch) {
+			buf.resize(prefixSize);
+		}
+	}
+
+	int ret = 0;
+	size_t submitted = 0;
+	while (submitted < filenames.size()) {
+		const size_t remain = filenames.size() - submitted;
+		const unsigned int batch = (remain < params.sq_entries)
+			? static_cast<unsigned int>(remain)
+			: params.sq_entries;
+
+		// Phase 1: Open the batch's files.
+		ret = submitAndReap(batch,
+			[&](unsigned int i, struct io_uring_sqe *sqe) -> size_t {
+				const size_t idx = submitted + i;
+				sqe->opcode = IORING_OP_OPENAT;
+				sqe->fd = AT_FDCWD;
+				sqe->addr = reinterpret_cast<uintptr_t>(filenames[idx].c_str());
+				sqe->open_flags = O_RDONLY | O_CLOEXEC;
+				return idx;
+			},
+			[&](size_t idx, int res) {
+				if (res >= 0) {
+					fds[idx] = res;
+				} else if (pResults) {
+					(*pResults)[idx].err = -res;
+				}
+			});
+		if (ret != 0)
+			break;
+
+		// Phase 2: Read each opened file's prefix.
+		if (prefixSize > 0) {
+			// Map batch slots to opened files.
+			vector<size_t> rd_idxs;
+			rd_idxs.reserve(batch);
+			for (unsigned int i = 0; i < batch; i++) {
+				const size_t idx = submitted + i;
+				if (fds[idx] >= 0) {
+					if (pResults) {
+						(*pResults)[idx].data.resize(prefixSize);
+					}
+					rd_idxs.push_back(idx);
+				}
+			}
+
+			ret = submitAndReap(static_cast<unsigned int>(rd_idxs.size()),
+				[&](unsigned int i, struct io_uring_sqe *sqe) -> size_t {
+					const size_t idx = rd_idxs[i];
+					sqe->opcode = IORING_OP_READ;
+					sqe->fd = fds[idx];
+					sqe->addr = reinterpret_cast<uintptr_t>(pResults
+						? (*pResults)[idx].data.data()
+						: scratch[i].data());
+					sqe->len = static_cast<__u32>(prefixSize);
+					return idx;
+				},
+				[&](size_t idx, int res) {
+					if (!pResults)
+						return;
+					OpenPrefixResult &result = (*pResults)[idx];
+					if (res >= 0) {
+						result.data.resize(res);
+					} else {
+						result.err = -res;
+						result.data.clear();
+					}
+				});
+			if (ret != 0)
+				break;
+		}
+
+		// Phase 3: Close the batch's files.
+		// NOTE: Synchronous; close() doesn't block on I/O here.
+		for (unsigned int i = 0; i < batch; i++) {
+			const size_t idx = submitted + i;
+			if (fds[idx] >= 0) {
+				close(fds[idx]);
+				fds[idx] = -1;
+			}
+		}
+
+		submitted += batch;
+	}
+
+	// Close any file descriptors left open by an error path.
+	for (const int fd : fds) {
+		if (fd >= 0) {
+			close(fd);
+		}
+	}
+
+	munmap(sqes, sqes_sz);
+	if (cq_ptr != sq_ptr) {
+		munmap(cq_ptr, cq_ring_sz);
+	}
+	munmap(sq_ptr, sq_ring_sz);
+	close(ring_fd);
+	return ret;
+}
+#endif /* __linux__ && HAVE_IORING_OP_OPENAT */
+
+/**
+ * Open multiple files and read a prefix of each one.
+ *
+ * Requests are kept in flight concurrently (io_uring on Linux;
+ * a worker pool elsewhere), so a batch of header probes on
+ * cold-cache or high-latency storage overlaps the per-file
+ * open+read latency instead of paying for it serially.
+ *
+ * If pResults is nullptr, the data is discarded after reading.
+ * This is useful as a cache-warming pass before probing the
+ * files through the regular synchronous interfaces.
+ *
+ * @param filenames	[in] Filenames to open. (UTF-8)
+ * @param prefixSize	[in] Number of bytes to read from the start of each file.
+ * @param pResults	[out,opt] Per-file results, in filename order. (nullptr to discard)
+ * @param maxInFlight	[in] Maximum number of requests in flight. (0 for automatic)
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int openPrefixBatch(const vector<string> &filenames, size_t prefixSize,
+	vector<OpenPrefixResult> *pResults, unsigned int maxInFlight)
+{
+	if (pResults) {
+		pResults->clear();
+		pResults->resize(filenames.size());
+	}
+	if (filenames.empty()) {
+		return 0;
+	}
+
+#if defined(__linux__) && defined(HAVE_IORING_OP_OPENAT)
+	if (openPrefixBatch_io_uring(filenames, prefixSize, pResults, maxInFlight) == 0) {
+		return 0;
+	}
+	// io_uring isn't available. Fall back to the worker pool.
+	if (pResults) {
+		// Reset any partial results.
+		pResults->clear();
+		pResults->resize(filenames.size());
+	}
+#endif /* __linux__ && HAVE_IORING_OP_OPENAT */
+
+	// Worker pool fallback: Each worker opens and reads the next
+	// un-probed file, so the opens overlap up to the thread count.
+	unsigned int threadCount = maxInFlight;
+	if (threadCount == 0) {
+		threadCount = std::thread::hardware_concurrency();
+		if (threadCount == 0) {
+			// Unable to determine the CPU core count.
+			threadCount = 1;
+		} else if (threadCount > 16) {
+			// Cap the automatic thread count.
+			threadCount = 16;
+		}
+	}
+	if (static_cast<size_t>(threadCount) > filenames.size()) {
+		threadCount = static_cast<unsigned int>(filenames.size());
+	}
+
+	std::atomic<size_t> nextIdx(0);
+	auto workerFn = [&filenames, prefixSize, pResults, &nextIdx]() {
+		vector<uint8_t> scratch;
+		if (!pResults && prefixSize > 0) {
+			scratch.resize(prefixSize);
+		}
+
+		while (true) {
+			const size_t i = nextIdx.fetch_add(1);
+			if (i >= filenames.size()) {
+				break;
+			}
+
+			RpFile file(filenames[i].c_str(), RpFile::FM_OPEN_READ);
+			if (!file.isOpen()) {
+				if (pResults) {
+					(*pResults)[i].err = file.lastError();
+				}
+				continue;
+			}
+
+			if (prefixSize == 0) {
+				continue;
+			}
+			if (pResults) {
+				OpenPrefixResult &result = (*pResults)[i];
+				result.data.resize(prefixSize);
+				const size_t sz_read = file.read(result.data.data(), prefixSize);
+				result.data.resize(sz_read);
+				if (sz_read == 0 && file.lastError() != 0) {
+					result.err = file.lastError();
+				}
+			} else {
+				file.read(scratch.data(), prefixSize);
+			}
+		}
+	};
+
+	if (threadCount == 1) {
+		// Single-threaded: Run the worker directly.
+		workerFn();
+		return 0;
+	}
+
+	vector<std::thread> workers;
+	workers.reserve(threadCount);
+	for (unsigned int i = 0; i < threadCount; i++) {
+		workers.emplace_back(workerFn);
+	}
+	for (std::thread &worker : workers) {
+		worker.join();
+	}
+
+	return 0;
+}
+
+}
@@ -0,0 +1,49 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpfile)                        *
+ * OpenPrefixBatch.hpp: Batched asynchronous open+read-prefix.             *
+ *                                                                         *
+ * Copyright (c) 2016-2024 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#pragma once
+
+#include "dll-macros.h"	// for RP_LIBROMDATA_PUBLIC
+
+// C++ STL classes
+#include <string>
+#include <vector>
+
+namespace LibRpFile {
+
+/**
+ * Result of a single open+read-prefix operation.
+ */
+struct OpenPrefixResult {
+	int err;			// 0 on success; positive POSIX error code on error.
+	std::vector<uint8_t> data;	// Prefix data. (may be shorter than requested)
+};
+
+/**
+ * Open multiple files and read a prefix of each one.
+ *
+ * Requests are kept in flight concurrently (io_uring on Linux;
+ * a worker pool elsewhere), so a batch of header probes on
+ * cold-cache or high-latency storage overlaps the per-file
+ * open+read latency instead of paying for it serially.
+ *
+ * If pResults is nullptr, the data is discarded after reading.
+ * This is useful as a cache-warming pass before probing the
+ * files through the regular synchronous interfaces.
+ *
+ * @param filenames	[in] Filenames to open. (UTF-8)
+ * @param prefixSize	[in] Number of bytes to read from the start of each file.
+ * @param pResults	[out,opt] Per-file results, in filename order. (nullptr to discard)
+ * @param maxInFlight	[in] Maximum number of requests in flight. (0 for automatic)
+ * @return 0 on success; negative POSIX error code on error.
+ */
+RP_LIBROMDATA_PUBLIC
+int openPrefixBatch(const std::vector<std::string> &filenames, size_t prefixSize,
+	std::vector<OpenPrefixResult> *pResults, unsigned int maxInFlight = 0);
+
+}
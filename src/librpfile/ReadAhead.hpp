@@ -0,0 +1,108 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpfile)                        *
+ * ReadAhead.hpp: Sequential readahead coordinator.                        *
+ *                                                                         *
+ * Copyright (c) 2016-2024 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#pragma once
+
+#include "IRpFile.hpp"
+
+// C includes (C++ namespace)
+#include <cstdlib>
+
+// C++ includes
+#include <algorithm>
+
+namespace LibRpFile {
+
+/**
+ * Sequential readahead coordinator.
+ *
+ * Tracks a sequential read stream and keeps a window of upcoming
+ * data advised via IRpFile::advise(), so bulk operations (extraction,
+ * verification) overlap storage latency with processing instead of
+ * round-tripping on every read. Layered readers translate the hint
+ * themselves, e.g. SparseDiscReader::advise() maps logical ranges to
+ * the physical blocks of a compressed image.
+ *
+ * The hint is issued half a window at a time once the stream has
+ * consumed into the advised region. Non-sequential reads restart
+ * the window at the new position.
+ *
+ * Set RP_READAHEAD=0 in the environment to disable.
+ */
+class SequentialReadAhead
+{
+	public:
+		// Readahead window size, in bytes.
+		static constexpr size_t WINDOW_SIZE = 8U*1024*1024;
+
+		/**
+		 * Initialize the readahead coordinator.
+		 * @param file	[in] File being read sequentially. (not owned)
+		 */
+		explicit SequentialReadAhead(IRpFile *file)
+			: m_file(file)
+			, m_fileSize(file ? file->size() : -1)
+			, m_expected(-1)
+			, m_advised_end(0)
+			, m_enabled(false)
+		{
+			if (!file || m_fileSize <= 0) {
+				return;
+			}
+			const char *const env = getenv("RP_READAHEAD");
+			m_enabled = (!env || env[0] != '0');
+		}
+
+	private:
+		RP_DISABLE_COPY(SequentialReadAhead)
+
+	public:
+		/**
+		 * Record a completed read and advise upcoming data if needed.
+		 * @param offset	[in] Offset the read started at.
+		 * @param size		[in] Number of bytes read.
+		 */
+		void onRead(off64_t offset, size_t size)
+		{
+			if (!m_enabled) {
+				return;
+			}
+
+			const off64_t end = offset + static_cast<off64_t>(size);
+			if (offset != m_expected) {
+				// Non-sequential read.
+				// Restart the window at the new position.
+				m_advised_end = end;
+			}
+			m_expected = end;
+
+			// Keep [end, end+WINDOW_SIZE) advised, issuing
+			// half a window at a time.
+			if (m_advised_end >= end + static_cast<off64_t>(WINDOW_SIZE / 2)) {
+				// Still have at least half a window advised.
+				return;
+			}
+
+			const off64_t adv_start = std::max(m_advised_end, end);
+			const off64_t adv_end = std::min(
+				end + static_cast<off64_t>(WINDOW_SIZE), m_fileSize);
+			if (adv_end > adv_start) {
+				m_file->advise(adv_start, static_cast<size_t>(adv_end - adv_start));
+				m_advised_end = adv_end;
+			}
+		}
+
+	private:
+		IRpFile *m_file;	// File being read (not owned)
+		off64_t m_fileSize;	// Cached file size
+		off64_t m_expected;	// Expected offset of the next sequential read
+		off64_t m_advised_end;	// End of the advised region
+		bool m_enabled;		// Is readahead enabled?
+};
+
+}
@@ -31,4 +31,36 @@ namespace LibRpFile {
 RP_LIBROMDATA_PUBLIC
 int recursiveScan(const TCHAR *path, std::forward_list<std::pair<std::tstring, uint8_t> > &rlist);
 
+/**
+ * Callback function for recursiveScanParallel().
+ *
+ * NOTE: May be invoked from worker threads.
+ * Invocations are serialized by the scanner.
+ *
+ * @param path		[in] Full path of the file or directory.
+ * @param d_type	[in] File type. (d_type)
+ * @param userdata	[in] User data pointer.
+ */
+typedef void (*RecursiveScanCallback)(const TCHAR *path, uint8_t d_type, void *userdata);
+
+/**
+ * Recursively scan a directory for cache files to delete.
+ * This finds *.png, *.jpg, *.jxl, and "version.txt".
+ *
+ * Parallel version: Independent directories are listed by a bounded
+ * worker pool, overlapping per-directory latency on high-latency
+ * filesystems (e.g. NAS mounts). Results are streamed via the
+ * callback as they're found. A directory is only reported after
+ * all of its contents have been reported, so entries can be
+ * deleted in callback order.
+ *
+ * @param path		[in] Path to scan.
+ * @param callback	[in] Callback function for found files and directories.
+ * @param userdata	[in] User data pointer passed to the callback.
+ * @param maxThreads	[in] Maximum number of worker threads. (0 for automatic)
+ * @return 0 on success; non-zero on error.
+ */
+RP_LIBROMDATA_PUBLIC
+int recursiveScanParallel(const TCHAR *path, RecursiveScanCallback callback, void *userdata, unsigned int maxThreads = 0);
+
 }
@@ -18,6 +18,14 @@
 #include <sys/types.h>
 #include <dirent.h>
 
+// C++ includes
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
 // C++ STL classes
 using std::forward_list;
 using std::pair;
@@ -32,6 +40,110 @@ extern "C" {
 
 namespace LibRpFile {
 
+/**
+ * Resolve the d_type of a directory entry, dereferencing symlinks.
+ * @param fullpath	[in] Full path of the entry.
+ * @param d_type	[in/out] d_type from readdir(); resolved d_type on return.
+ * @return 0 if the entry is a supported type; -EIO if not.
+ */
+static int resolve_d_type(const char *fullpath, uint8_t &d_type)
+{
+	switch (d_type) {
+		default:
+			// Not supported.
+			return -EIO;
+
+		case DT_REG:
+		case DT_DIR:
+			// Supported.
+			return 0;
+
+		case DT_LNK:
+			// Symbolic link. Dereference it and check again.
+			d_type = FileSystem::get_file_d_type(fullpath, true);
+			switch (d_type) {
+				default:
+					// Not supported.
+					return -EIO;
+
+				case DT_REG:
+				case DT_DIR:
+					// Supported.
+					return 0;
+
+				case DT_UNKNOWN:
+					// This is probably a dangling symlink.
+					// Delete it anyway.
+					return 0;
+			}
+
+		case DT_UNKNOWN:
+			// Unknown. Use stat().
+			d_type = FileSystem::get_file_d_type(fullpath, false);
+			switch (d_type) {
+				default:
+					// Not supported.
+					return -EIO;
+
+				case DT_REG:
+				case DT_DIR:
+					// Supported.
+					return 0;
+
+				case DT_LNK:
+					// Symbolic link. Dereference it and check again.
+					d_type = FileSystem::get_file_d_type(fullpath, true);
+					switch (d_type) {
+						default:
+							// Not supported.
+							return -EIO;
+
+						case DT_REG:
+						case DT_DIR:
+							// Supported.
+							return 0;
+
+						case DT_UNKNOWN:
+							// This is probably a dangling symlink.
+							// Delete it anyway.
+							return 0;
+					}
+			}
+	}
+}
+
+/**
+ * Check if a file is a cache file we're allowed to delete.
+ * @param d_name	[in] Filename. (not the full path)
+ * @return 0 if the file can be deleted; -EIO if not.
+ */
+static int check_cache_filename(const char *d_name)
+{
+	// Thumbs.db files can be deleted.
+	if (!strcasecmp(d_name, "Thumbs.db"))
+		return 0;
+
+	// Check the extension.
+	const size_t len = strlen(d_name);
+	if (len <= 4) {
+		// Filename is too short. This is bad.
+		return -EIO;
+	}
+
+	const char *pExt = &d_name[len-4];
+	if (strcasecmp(pExt, ".png") != 0 &&
+	    strcasecmp(pExt, ".jpg") != 0 &&
+	    strcasecmp(pExt, ".jxl") != 0 &&
+	    strcasecmp(d_name, "version.txt") != 0)
+	{
+		// Extension is not valid.
+		return -EIO;
+	}
+
+	// All checks pass.
+	return 0;
+}
+
 /**
  * Recursively scan a directory for cache files to delete.
  * This finds *.png, *.jpg, *.jxl, and "version.txt".
@@ -67,109 +179,18 @@ int recursiveScan(const TCHAR *path, forward_list<pair<tstring, uint8_t> > &rlis
 
 		// Check if this is a regular file.
 		uint8_t d_type = dirent->d_type;
-		switch (d_type) {
-			default:
-				// Not supported.
-				// TODO: Better error message.
-				closedir(pdir);
-				return -EIO;
-
-			case DT_REG:
-			case DT_DIR:
-				// Supported.
-				break;
-
-			case DT_LNK:
-				// Symbolic link. Dereference it and check again.
-				d_type = FileSystem::get_file_d_type(fullpath.c_str(), true);
-				switch (d_type) {
-					default:
-						// Not supported.
-						// TODO: Better error message.
-						closedir(pdir);
-						return -EIO;
-
-					case DT_REG:
-					case DT_DIR:
-						// Supported.
-						break;
-
-					case DT_UNKNOWN:
-						// This is probably a dangling symlink.
-						// Delete it anyway.
-						break;
-				}
-				break;
-
-			case DT_UNKNOWN:
-				// Unknown. Use stat().
-				d_type = FileSystem::get_file_d_type(fullpath.c_str(), false);
-				switch (d_type) {
-					default:
-						// Not supported.
-						// TODO: Better error message.
-						closedir(pdir);
-						return -EIO;
-
-					case DT_REG:
-					case DT_DIR:
-						// Supported.
-						break;
-
-					case DT_LNK:
-						// Symbolic link. Dereference it and check again.
-						d_type = FileSystem::get_file_d_type(fullpath.c_str(), true);
-						switch (d_type) {
-							default:
-								// Not supported.
-								// TODO: Better error message.
-								closedir(pdir);
-								return -EIO;
-
-							case DT_REG:
-							case DT_DIR:
-								// Supported.
-								break;
-
-							case DT_UNKNOWN:
-								// This is probably a dangling symlink.
-								// Delete it anyway.
-								break;
-						}
-						break;
-				}
-				break;
+		int ret = resolve_d_type(fullpath.c_str(), d_type);
+		if (ret == 0 && (d_type == DT_REG || d_type == DT_UNKNOWN)) {
+			// Check the filename to see if we should delete it.
+			ret = check_cache_filename(dirent->d_name);
 		}
-
-		// Check the filename to see if we should delete it.
-		if (d_type == DT_REG || d_type == DT_UNKNOWN) {
-			// Thumbs.db files can be deleted.
-			if (!strcasecmp(dirent->d_name, "Thumbs.db"))
-				goto isok;
-
-			// Check the extension.
-			const size_t len = strlen(dirent->d_name);
-			if (len <= 4) {
-				// Filename is too short. This is bad.
-				closedir(pdir);
-				return -EIO;
-			}
-
-			const char *pExt = &dirent->d_name[len-4];
-			if (strcasecmp(pExt, ".png") != 0 &&
-			    strcasecmp(pExt, ".jpg") != 0 &&
-			    strcasecmp(pExt, ".jxl") != 0 &&
-			    strcasecmp(dirent->d_name, "version.txt") != 0)
-			{
-				// Extension is not valid.
-				closedir(pdir);
-				return -EIO;
-			}
-
-			// All checks pass.
+		if (ret != 0) {
+			// Not supported, or not a deletable cache file.
+			// TODO: Better error message.
+			closedir(pdir);
+			return ret;
 		}
 
-	isok:
 		// Add the filename and file type.
 		rlist.emplace_front(fullpath, d_type);
 
@@ -186,4 +207,297 @@ int recursiveScan(const TCHAR *path, forward_list<pair<tstring, uint8_t> > &rlis
 	return 0;
 }
 
+/** Parallel scanner **/
+
+namespace {
+
+/**
+ * Per-directory work item for ParallelScanner.
+ *
+ * pending counts subdirectories that haven't finished yet,
+ * plus one for this directory's own listing. When it reaches
+ * zero, the directory is reported and the parent is notified.
+ */
+struct DirWorkItem {
+	std::string path;
+	DirWorkItem *parent;
+	std::atomic<unsigned int> pending;
+
+	DirWorkItem(std::string &&path, DirWorkItem *parent)
+		: path(std::move(path))
+		, parent(parent)
+		, pending(1)
+	{}
+};
+
+/**
+ * Bounded worker pool for recursiveScanParallel().
+ *
+ * Each directory is a work item. Workers list directories
+ * from a shared queue, report files immediately, and enqueue
+ * subdirectories as new work items, so the latency of
+ * independent readdir() calls overlaps.
+ */
+class ParallelScanner
+{
+	public:
+		ParallelScanner(RecursiveScanCallback callback, void *userdata)
+			: m_callback(callback)
+			, m_userdata(userdata)
+			, m_err(0)
+			, m_itemsOutstanding(0)
+			, m_done(false)
+		{}
+
+	private:
+		RP_DISABLE_COPY(ParallelScanner)
+
+	public:
+		/**
+		 * Scan a directory tree.
+		 * @param path		[in] Path to scan.
+		 * @param maxThreads	[in] Maximum number of worker threads. (0 for automatic)
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int scan(const char *path, unsigned int maxThreads)
+		{
+			unsigned int nThreads = maxThreads;
+			if (nThreads == 0) {
+				// Automatic: Use the hardware thread count.
+				nThreads = std::thread::hardware_concurrency();
+			}
+			if (nThreads < 1) {
+				nThreads = 1;
+			} else if (nThreads > 16) {
+				nThreads = 16;
+			}
+
+			// Enqueue the root directory.
+			// NOTE: The root directory itself is not reported,
+			// matching recursiveScan().
+			m_itemsOutstanding = 1;
+			enqueue(new DirWorkItem(std::string(path), nullptr));
+
+			// Start the workers and wait for them to finish.
+			std::vector<std::thread> workers;
+			workers.reserve(nThreads);
+			for (unsigned int i = 0; i < nThreads; i++) {
+				workers.emplace_back(&ParallelScanner::workerMain, this);
+			}
+			for (std::thread &worker : workers) {
+				worker.join();
+			}
+
+			return m_err.load(std::memory_order_relaxed);
+		}
+
+	private:
+		/**
+		 * Add a work item to the queue.
+		 * @param item Work item.
+		 */
+		void enqueue(DirWorkItem *item)
+		{
+			std::lock_guard<std::mutex> lock(m_queueMutex);
+			m_workQueue.push(item);
+			m_queueCond.notify_one();
+		}
+
+		/**
+		 * Record the first error encountered.
+		 * Workers stop listing new directories once an error is set.
+		 * @param err Negative POSIX error code.
+		 */
+		void setError(int err)
+		{
+			int expected = 0;
+			m_err.compare_exchange_strong(expected, err);
+		}
+
+		/**
+		 * Report a file or directory to the callback.
+		 * Invocations are serialized. Nothing is reported
+		 * after an error has been set.
+		 * @param path Full path.
+		 * @param d_type File type. (d_type)
+		 */
+		void report(const std::string &path, uint8_t d_type)
+		{
+			std::lock_guard<std::mutex> lock(m_cbMutex);
+			if (m_err.load(std::memory_order_relaxed) == 0) {
+				m_callback(path.c_str(), d_type, m_userdata);
+			}
+		}
+
+		/**
+		 * Mark a directory's own listing (or a subdirectory) as finished.
+		 *
+		 * When the last reference to a directory is dropped, the
+		 * directory is reported (all of its contents have been
+		 * reported by now) and its parent is notified in turn.
+		 *
+		 * @param item Work item.
+		 */
+		void finishDir(DirWorkItem *item)
+		{
+			while (item) {
+				if (--item->pending != 0) {
+					break;
+				}
+
+				DirWorkItem *const parent = item->parent;
+				if (parent) {
+					// All of this directory's contents have been
+					// reported. Report the directory itself.
+					report(item->path, DT_DIR);
+				}
+				delete item;
+
+				// If this was the last outstanding item, we're done.
+				if (--m_itemsOutstanding == 0) {
+					std::lock_guard<std::mutex> lock(m_queueMutex);
+					m_done = true;
+					m_queueCond.notify_all();
+				}
+
+				item = parent;
+			}
+		}
+
+		/**
+		 * List a single directory.
+		 * Files are reported immediately; subdirectories are
+		 * enqueued as new work items.
+		 * @param item Work item.
+		 */
+		void processDir(DirWorkItem *item)
+		{
+			// Don't bother listing anything after an error.
+			if (m_err.load(std::memory_order_relaxed) != 0) {
+				finishDir(item);
+				return;
+			}
+
+			DIR *const pdir = opendir(item->path.c_str());
+			if (!pdir) {
+				// Error opening the directory.
+				setError(-errno);
+				finishDir(item);
+				return;
+			}
+
+			struct dirent *dirent;
+			while ((dirent = readdir(pdir)) != nullptr) {
+				// Stop if another worker hit an error.
+				if (m_err.load(std::memory_order_relaxed) != 0)
+					break;
+
+				// Skip "." and "..".
+				if (dirent->d_name[0] == '.' &&
+				    (dirent->d_name[1] == '\0' ||
+				     (dirent->d_name[1] == '.' && dirent->d_name[2] == '\0')))
+				{
+					continue;
+				}
+
+				std::string fullpath(item->path);
+				fullpath += '/';
+				fullpath += dirent->d_name;
+
+				// Check if this is a regular file.
+				uint8_t d_type = dirent->d_type;
+				int ret = resolve_d_type(fullpath.c_str(), d_type);
+				if (ret == 0 && (d_type == DT_REG || d_type == DT_UNKNOWN)) {
+					// Check the filename to see if we should delete it.
+					ret = check_cache_filename(dirent->d_name);
+				}
+				if (ret != 0) {
+					// Not supported, or not a deletable cache file.
+					setError(ret);
+					break;
+				}
+
+				if (d_type == DT_DIR) {
+					// Subdirectory: enqueue a new work item.
+					// It's reported once its contents are done.
+					item->pending++;
+					m_itemsOutstanding++;
+					enqueue(new DirWorkItem(std::move(fullpath), item));
+				} else {
+					// File: report it immediately.
+					report(fullpath, d_type);
+				}
+			}
+			closedir(pdir);
+
+			finishDir(item);
+		}
+
+		/**
+		 * Worker thread main loop.
+		 */
+		void workerMain(void)
+		{
+			while (true) {
+				DirWorkItem *item;
+				{
+					std::unique_lock<std::mutex> lock(m_queueMutex);
+					m_queueCond.wait(lock, [this] {
+						return (!m_workQueue.empty() || m_done);
+					});
+					if (m_workQueue.empty()) {
+						// No more work.
+						break;
+					}
+					item = m_workQueue.front();
+					m_workQueue.pop();
+				}
+				processDir(item);
+			}
+		}
+
+	private:
+		RecursiveScanCallback m_callback;
+		void *m_userdata;
+
+		std::queue<DirWorkItem*> m_workQueue;
+		std::mutex m_queueMutex;
+		std::condition_variable m_queueCond;
+		std::mutex m_cbMutex;
+
+		std::atomic<int> m_err;				// First error encountered.
+		std::atomic<unsigned int> m_itemsOutstanding;	// Work items not yet finished.
+		bool m_done;					// All items finished. (guarded by m_queueMutex)
+};
+
+}
+
+/**
+ * Recursively scan a directory for cache files to delete.
+ * This finds *.png, *.jpg, *.jxl, and "version.txt".
+ *
+ * Parallel version: Independent directories are listed by a bounded
+ * worker pool, overlapping per-directory latency on high-latency
+ * filesystems (e.g. NAS mounts). Results are streamed via the
+ * callback as they're found. A directory is only reported after
+ * all of its contents have been reported, so entries can be
+ * deleted in callback order.
+ *
+ * @param path		[in] Path to scan.
+ * @param callback	[in] Callback function for found files and directories.
+ * @param userdata	[in] User data pointer passed to the callback.
+ * @param maxThreads	[in] Maximum number of worker threads. (0 for automatic)
+ * @return 0 on success; non-zero on error.
+ */
+int recursiveScanParallel(const TCHAR *path, RecursiveScanCallback callback, void *userdata, unsigned int maxThreads)
+{
+	assert(callback != nullptr);
+	if (!callback) {
+		return -EINVAL;
+	}
+
+	ParallelScanner scanner(callback, userdata);
+	return scanner.scan(path, maxThreads);
+}
+
 }
@@ -42,6 +42,15 @@ class RpFile final : public IRpFile
 			// Extras.
 			FM_GZIP_DECOMPRESS = 4,	// Transparent gzip decompression. (read-only!)
 			FM_OPEN_READ_GZ = FM_READ | FM_GZIP_DECOMPRESS,
+
+			// Access pattern hints. These don't change the file mode;
+			// they adjust buffering and kernel readahead where supported.
+			// Only one hint should be specified. (probing takes precedence)
+			FM_HINT_PROBE = 8,	// A few small reads at scattered offsets:
+						// unbuffered stdio, no kernel readahead.
+			FM_HINT_SEQUENTIAL = 16,	// Front-to-back scan:
+							// aggressive kernel readahead.
+			FM_HINT_MASK = 24,	// Hint mask.
 		};
 
 		/**
@@ -142,6 +151,49 @@ class RpFile final : public IRpFile
 		 */
 		int flush(void) final;
 
+		/**
+		 * Advise the file of an upcoming read.
+		 *
+		 * This is a best-effort hint for predictable access patterns:
+		 * on POSIX systems, this starts kernel readahead for the
+		 * specified range via posix_fadvise().
+		 *
+		 * @param offset	[in] Start of the range that will be read.
+		 * @param size		[in] Length of the range, in bytes.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int advise(off64_t offset, size_t size) final;
+
+		/**
+		 * Set the expected access pattern for this file.
+		 *
+		 * This is a best-effort hint: on POSIX systems, it's mapped
+		 * to posix_fadvise() (SEQUENTIAL/RANDOM/DONTNEED). On Windows,
+		 * access hints can only be specified when the file is opened,
+		 * so this is ignored; use the FM_HINT_* file mode flags instead.
+		 *
+		 * @param intent	[in] Access intent.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int setAccessIntent(AccessIntent intent) final;
+
+		/**
+		 * Read data from multiple scattered file offsets.
+		 *
+		 * For uncompressed regular files, each entry is satisfied
+		 * with a single positioned read (pread() on POSIX; ReadFile()
+		 * with an OVERLAPPED offset on Windows), so no seek syscalls
+		 * are issued. Compressed and device-backed files fall back to
+		 * the default seek+read implementation.
+		 *
+		 * NOTE: The file position after this call is unspecified.
+		 *
+		 * @param vec	[in/out] Array of read vector entries.
+		 * @param count	[in] Number of entries in vec.
+		 * @return Number of entries that were fully read.
+		 */
+		size_t readVec(ReadVecEntry *vec, size_t count) final;
+
 	public:
 		/** File properties **/
 
@@ -10,6 +10,7 @@
 
 #include "config.librpfile.h"
 #include "RpFile.hpp"
+#include "HeaderCache.hpp"
 
 // C includes. (C++ namespace)
 #include <cassert>
@@ -157,6 +158,27 @@ class RpFilePrivate
 
 		DeviceInfo *devInfo;
 
+	public:
+		/** Cross-process header cache (see HeaderCache.hpp) **/
+
+		enum class HdrCacheState : uint8_t {
+			Unchecked = 0,	// Not checked yet.
+			Active,		// hdrCacheBuf holds the file's header.
+			Disabled,	// Not usable for this file.
+		};
+		HdrCacheState hdrCacheState;
+		std::vector<uint8_t> hdrCacheBuf;	// Cached header data.
+
+		/**
+		 * Check the cross-process header cache for this file.
+		 *
+		 * Called on the first read() of a plain file. On a hit, the
+		 * header is copied out of shared memory; on a miss, it's read
+		 * from the file once (without disturbing the file position)
+		 * and published for other processes. Sets hdrCacheState.
+		 */
+		void setupHeaderCache(void);
+
 	public:
 #ifdef _WIN32
 		/**
@@ -19,6 +19,9 @@
 // librpbyteswap
 #include "librpbyteswap/byteswap_rp.h"
 
+// Tracing instrumentation
+#include "rp_trace.h"
+
 // C includes
 #include <fcntl.h>	// AT_EMPTY_PATH
 #include <sys/stat.h>	// stat(), statx()
@@ -31,6 +34,7 @@ namespace LibRpFile {
 RpFilePrivate::RpFilePrivate(RpFile *q, const char *filename, RpFile::FileMode mode)
 	: q_ptr(q), file(INVALID_HANDLE_VALUE)
 	, mode(mode), gzfd(nullptr), gzsz(-1), devInfo(nullptr)
+	, hdrCacheState(HdrCacheState::Unchecked)
 {
 	assert(filename != nullptr);
 	this->filename = strdup(filename);
@@ -222,6 +226,58 @@ int RpFilePrivate::reOpenFile(void)
 	return 0;
 }
 
+/**
+ * Check the cross-process header cache for this file.
+ *
+ * Called on the first read() of a plain file. On a hit, the
+ * header is copied out of shared memory; on a miss, it's read
+ * from the file once (without disturbing the file position)
+ * and published for other processes. Sets hdrCacheState.
+ */
+void RpFilePrivate::setupHeaderCache(void)
+{
+	hdrCacheState = HdrCacheState::Disabled;
+	if ((mode & RpFile::FM_WRITE) || gzfd != nullptr || devInfo) {
+		// Writable, compressed, or device file. Not cacheable.
+		return;
+	}
+	if (!HeaderCache::isEnabled()) {
+		return;
+	}
+
+	HeaderCache::Key key;
+	const int fd = fileno(file);
+	if (fd < 0 || !HeaderCache::getKey(fd, &key)) {
+		return;
+	}
+
+	// Cache the entire file if it's smaller than an entry.
+	const size_t cache_len = (key.fsize < HeaderCache::DATA_SIZE)
+		? static_cast<size_t>(key.fsize)
+		: HeaderCache::DATA_SIZE;
+	if (cache_len == 0) {
+		return;
+	}
+
+	hdrCacheBuf.resize(cache_len);
+	if (HeaderCache::lookup(key, hdrCacheBuf.data(), cache_len) == cache_len) {
+		// Cache hit. Another process already read this header.
+		hdrCacheState = HdrCacheState::Active;
+		return;
+	}
+
+	// Cache miss. Read the header once and publish it.
+	// pread() doesn't disturb the stdio stream position.
+	const ssize_t sret = pread(fd, hdrCacheBuf.data(), cache_len, 0);
+	if (sret != static_cast<ssize_t>(cache_len)) {
+		// Short read?
+		hdrCacheBuf.clear();
+		return;
+	}
+	HeaderCache::store(key, hdrCacheBuf.data(), cache_len);
+	hdrCacheState = HdrCacheState::Active;
+}
+
 /** RpFile **/
 
 /**
@@ -276,7 +332,7 @@ void RpFile::init(void)
 	// Check if this is a gzipped file.
 	// If it is, use transparent decompression.
 	// Reference: https://www.forensicswiki.org/wiki/Gzip
-	const bool tryGzip = (d->mode == FM_OPEN_READ_GZ);
+	const bool tryGzip = ((d->mode & ~FM_HINT_MASK) == FM_OPEN_READ_GZ);
 	if (tryGzip) { do {
 		uint16_t gzmagic;
 		size_t size = fread(&gzmagic, 1, sizeof(gzmagic), d->file);
@@ -329,6 +385,25 @@ void RpFile::init(void)
 		::rewind(d->file);
 		::fflush(d->file);
 	}
+
+	// Apply access pattern hints for uncompressed regular files.
+	if (d->gzfd == nullptr && !d->devInfo) {
+		if (d->mode & FM_HINT_PROBE) {
+			// Probing: a few small reads at scattered offsets, then done.
+			// Drop the stdio buffer so fread() reads exactly what was
+			// requested, and tell the kernel not to bother with readahead.
+			setvbuf(d->file, nullptr, _IONBF, 0);
+#ifdef POSIX_FADV_RANDOM
+			posix_fadvise(fileno(d->file), 0, 0, POSIX_FADV_RANDOM);
+#endif /* POSIX_FADV_RANDOM */
+		} else if (d->mode & FM_HINT_SEQUENTIAL) {
+			// Sequential scan: the file will be read front to back.
+			// Ask the kernel for aggressive readahead.
+#ifdef POSIX_FADV_SEQUENTIAL
+			posix_fadvise(fileno(d->file), 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif /* POSIX_FADV_SEQUENTIAL */
+		}
+	}
 }
 
 RpFile::~RpFile()
@@ -380,6 +455,8 @@ void RpFile::close(void)
  */
 size_t RpFile::read(void *ptr, size_t size)
 {
+	RP_TRACE_SCOPE("RpFile::read");
+
 	RP_D(RpFile);
 	if (!d->file) {
 		m_lastError = EBADF;
@@ -402,6 +479,22 @@ size_t RpFile::read(void *ptr, size_t size)
 			m_lastError = errno;
 		}
 	} else {
+		// Consult the cross-process header cache first.
+		// Shell extension hosts re-read the same file headers in
+		// several processes within seconds of each other.
+		if (d->hdrCacheState == RpFilePrivate::HdrCacheState::Unchecked) {
+			d->setupHeaderCache();
+		}
+		if (d->hdrCacheState == RpFilePrivate::HdrCacheState::Active) {
+			const off64_t pos = ftello(d->file);
+			if (pos >= 0 && static_cast<uint64_t>(pos) + size <= d->hdrCacheBuf.size()) {
+				memcpy(ptr, &d->hdrCacheBuf[pos], size);
+				if (fseeko(d->file, pos + static_cast<off64_t>(size), SEEK_SET) == 0) {
+					return size;
+				}
+			}
+		}
+
 		ret = fread(ptr, 1, size, d->file);
 		if (ferror(d->file)) {
 			// An error occurred.
@@ -571,6 +664,140 @@ int RpFile::flush(void)
 	return 0;
 }
 
+/**
+ * Advise the file of an upcoming read.
+ *
+ * This is a best-effort hint for predictable access patterns:
+ * on POSIX systems, this starts kernel readahead for the
+ * specified range via posix_fadvise().
+ *
+ * @param offset	[in] Start of the range that will be read.
+ * @param size		[in] Length of the range, in bytes.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int RpFile::advise(off64_t offset, size_t size)
+{
+#ifdef POSIX_FADV_WILLNEED
+	RP_D(RpFile);
+	if (!d->file) {
+		m_lastError = EBADF;
+		return -EBADF;
+	}
+
+	// NOTE: posix_fadvise() returns the error number directly.
+	const int err = posix_fadvise(fileno(d->file), offset, size, POSIX_FADV_WILLNEED);
+	if (err != 0) {
+		m_lastError = err;
+		return -err;
+	}
+	return 0;
+#else /* !POSIX_FADV_WILLNEED */
+	// posix_fadvise() isn't available on this system. (e.g. Mac OS X)
+	// Ignore the hint.
+	RP_UNUSED(offset);
+	RP_UNUSED(size);
+	return 0;
+#endif /* POSIX_FADV_WILLNEED */
+}
+
+/**
+ * Set the expected access pattern for this file.
+ *
+ * This is a best-effort hint: on POSIX systems, it's mapped
+ * to posix_fadvise() (SEQUENTIAL/RANDOM/DONTNEED). On Windows,
+ * access hints can only be specified when the file is opened,
+ * so this is ignored; use the FM_HINT_* file mode flags instead.
+ *
+ * @param intent	[in] Access intent.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int RpFile::setAccessIntent(AccessIntent intent)
+{
+#ifdef POSIX_FADV_NORMAL
+	RP_D(RpFile);
+	if (!d->file) {
+		m_lastError = EBADF;
+		return -EBADF;
+	}
+
+	int advice;
+	switch (intent) {
+		case AccessIntent::Normal:
+		default:
+			advice = POSIX_FADV_NORMAL;
+			break;
+		case AccessIntent::Sequential:
+			advice = POSIX_FADV_SEQUENTIAL;
+			break;
+		case AccessIntent::Random:
+			advice = POSIX_FADV_RANDOM;
+			break;
+		case AccessIntent::HeaderOnly:
+			// No more reads are expected, so let the kernel
+			// drop whatever we've pulled into the page cache.
+			advice = POSIX_FADV_DONTNEED;
+			break;
+	}
+
+	// NOTE: posix_fadvise() returns the error number directly.
+	const int err = posix_fadvise(fileno(d->file), 0, 0, advice);
+	if (err != 0) {
+		m_lastError = err;
+		return -err;
+	}
+	return 0;
+#else /* !POSIX_FADV_NORMAL */
+	// posix_fadvise() isn't available on this system. (e.g. Mac OS X)
+	// Ignore the hint.
+	RP_UNUSED(intent);
+	return 0;
+#endif /* POSIX_FADV_NORMAL */
+}
+
+/**
+ * Read data from multiple scattered file offsets.
+ *
+ * For uncompressed regular files, each entry is satisfied
+ * with a single positioned read (pread() on POSIX; ReadFile()
+ * with an OVERLAPPED offset on Windows), so no seek syscalls
+ * are issued. Compressed and device-backed files fall back to
+ * the default seek+read implementation.
+ *
+ * NOTE: The file position after this call is unspecified.
+ *
+ * @param vec	[in/out] Array of read vector entries.
+ * @param count	[in] Number of entries in vec.
+ * @return Number of entries that were fully read.
+ */
+size_t RpFile::readVec(ReadVecEntry *vec, size_t count)
+{
+	RP_D(RpFile);
+	if (!d->file) {
+		m_lastError = EBADF;
+		return 0;
+	}
+
+	if (d->gzfd != nullptr || d->devInfo) {
+		// Compressed or device-backed file.
+		// Use the default seek+read implementation.
+		return super::readVec(vec, count);
+	}
+
+	// NOTE: pread() doesn't affect the stdio stream position,
+	// so regular read() calls are unaffected.
+	const int fd = fileno(d->file);
+	size_t entries_read = 0;
+	for (; count > 0; count--, vec++) {
+		const ssize_t sz_read = pread(fd, vec->dest, vec->size, vec->offset);
+		if (sz_read >= 0 && static_cast<size_t>(sz_read) == vec->size) {
+			entries_read++;
+		} else if (sz_read < 0) {
+			m_lastError = errno;
+		}
+	}
+	return entries_read;
+}
+
 /** File properties **/
 
 /**
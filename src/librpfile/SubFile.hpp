@@ -11,6 +11,9 @@
 
 #include "librpfile/IRpFile.hpp"
 
+// C++ includes
+#include <vector>
+
 namespace LibRpFile {
 
 class SubFile final : public IRpFile
@@ -24,6 +27,15 @@ class SubFile final : public IRpFile
 			, m_offset(offset)
 			, m_length(length)
 		{
+			// Flatten trivially-linear underlying layers, so a read
+			// through a nested stack is one virtual call, not one
+			// per layer.
+			off64_t baseOffset;
+			for (IRpFilePtr base; m_file && (base = m_file->getLinearMapping(&baseOffset)); ) {
+				m_offset += baseOffset;
+				m_file = base;
+			}
+
 			this->rewind();
 		}
 
@@ -119,6 +131,51 @@ class SubFile final : public IRpFile
 			return m_file->tell() - m_offset;
 		}
 
+		/**
+		 * Read data from multiple scattered file offsets.
+		 *
+		 * Entries are translated to the parent file's offsets and
+		 * forwarded as a single vector, so the parent's optimized
+		 * implementation (if any) is used.
+		 *
+		 * NOTE: The file position after this call is unspecified.
+		 *
+		 * @param vec	[in/out] Array of read vector entries.
+		 * @param count	[in] Number of entries in vec.
+		 * @return Number of entries that were fully read.
+		 */
+		size_t readVec(ReadVecEntry *vec, size_t count) final
+		{
+			if (!m_file) {
+				m_lastError = EBADF;
+				return 0;
+			}
+
+			// Translate the offsets to the parent file.
+			// NOTE: Not enforcing length bounds. (see read())
+			std::vector<ReadVecEntry> parentVec(vec, vec + count);
+			for (ReadVecEntry &entry : parentVec) {
+				entry.offset += m_offset;
+			}
+			return m_file->readVec(parentVec.data(), parentVec.size());
+		}
+
+		/**
+		 * Get this file's linear mapping onto an underlying file.
+		 * SubFile is always trivially linear.
+		 * @param pOffset	[out] Offset to add to file positions in the underlying file.
+		 * @return Underlying file, or nullptr if no file is open.
+		 */
+		IRpFilePtr getLinearMapping(off64_t *pOffset) final
+		{
+			if (!m_file) {
+				return nullptr;
+			}
+
+			*pOffset = m_offset;
+			return m_file;
+		}
+
 		/**
 		 * Flush buffers.
 		 * This operation only makes sense on writable files.
@@ -138,6 +138,24 @@ class RP_LIBROMDATA_PUBLIC VectorFile final : public IRpFile
 			return *m_pVector;
 		}
 
+		/**
+		 * Take the underlying std::vector.
+		 *
+		 * The vector is moved out, so the accumulated data is
+		 * handed off to the caller without a copy, e.g. for
+		 * constructing a MemFile. The VectorFile is left empty,
+		 * with the file position reset to 0.
+		 *
+		 * @return std::vector. (moved)
+		 */
+		std::vector<uint8_t> takeVector(void)
+		{
+			std::vector<uint8_t> ret(std::move(*m_pVector));
+			m_pVector->clear();
+			m_pos = 0;
+			return ret;
+		}
+
 	protected:
 		std::vector<uint8_t> *m_pVector;	// NOTE: Needs to be ptr to prevent DLL linkage issues.
 		size_t m_pos;				// Current position
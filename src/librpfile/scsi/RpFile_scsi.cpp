@@ -23,8 +23,120 @@
 #include "ata_protocol.h"
 #include "scsi_ata_cmds.h"
 
+// C includes
+#ifndef _WIN32
+#  include <sys/stat.h>	// fstat()
+#endif /* !_WIN32 */
+
+// C includes (C++ namespace)
+#include <ctime>
+
+// C++ includes
+#include <mutex>
+#include <unordered_map>
+
 namespace LibRpFile {
 
+/** SCSI device characteristics cache **/
+
+namespace {
+
+/**
+ * Cached SCSI device characteristics.
+ * Keyed by device ID (major:minor on POSIX).
+ *
+ * INQUIRY and READ CAPACITY round trips are tens of ms each on
+ * USB bridges, so cache the results across opens of the same
+ * device node. The TTL is short because optical media can be
+ * swapped and device nodes can be reassigned.
+ */
+struct ScsiDeviceCacheEntry {
+	time_t inquiry_time;	// When the INQUIRY data was cached. (0 if not cached)
+	time_t capacity_time;	// When the capacity was cached. (0 if not cached)
+
+	SCSI_RESP_INQUIRY_STD inquiry;
+	off64_t device_size;
+	uint32_t sector_size;
+
+	ScsiDeviceCacheEntry()
+		: inquiry_time(0)
+		, capacity_time(0)
+		, device_size(0)
+		, sector_size(0)
+	{
+		memset(&inquiry, 0, sizeof(inquiry));
+	}
+};
+
+// Cache TTL, in seconds.
+static constexpr time_t SCSI_DEVICE_CACHE_TTL = 5;
+
+static std::mutex scsi_device_cache_mutex;
+static std::unordered_map<uint64_t, ScsiDeviceCacheEntry> scsi_device_cache;
+
+/**
+ * Is a cache timestamp still valid?
+ * @param cache_time Timestamp the data was cached at. (0 if not cached)
+ * @return True if still valid; false if not cached or expired.
+ */
+static inline bool cache_time_is_valid(time_t cache_time)
+{
+	return (cache_time != 0 && (time(nullptr) - cache_time) <= SCSI_DEVICE_CACHE_TTL);
+}
+
+/**
+ * Get the device characteristics cache key for an open device.
+ * POSIX: st_rdev, i.e. major:minor.
+ * Windows: Hash of the device path. (no major:minor equivalent)
+ *
+ * @param d	[in] RpFilePrivate
+ * @param pKey	[out] Cache key.
+ * @return True if the key was obtained; false if not. (not a device?)
+ */
+static bool getDeviceCacheKey(const RpFilePrivate *d, uint64_t *pKey)
+{
+#ifdef _WIN32
+	if (!d->filename) {
+		return false;
+	}
+	*pKey = static_cast<uint64_t>(std::hash<std::string>()(std::string(d->filename)));
+	return true;
+#else /* !_WIN32 */
+	struct stat sb;
+	if (fstat(fileno(d->file), &sb) != 0) {
+		return false;
+	}
+	if (!S_ISBLK(sb.st_mode) && !S_ISCHR(sb.st_mode)) {
+		// Not a device node.
+		return false;
+	}
+	*pKey = static_cast<uint64_t>(sb.st_rdev);
+	return true;
+#endif /* _WIN32 */
+}
+
+/**
+ * Store device capacity in the characteristics cache.
+ * @param hasKey	[in] True if key is valid.
+ * @param key		[in] Cache key from getDeviceCacheKey().
+ * @param device_size	[in] Device size, in bytes.
+ * @param sector_size	[in] Sector size, in bytes.
+ */
+static void cacheStoreCapacity(bool hasKey, uint64_t key, off64_t device_size, uint32_t sector_size)
+{
+	if (!hasKey) {
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(scsi_device_cache_mutex);
+	ScsiDeviceCacheEntry &entry = scsi_device_cache[key];
+	entry.capacity_time = time(nullptr);
+	entry.device_size = device_size;
+	entry.sector_size = sector_size;
+}
+
+}
+
 /**
  * Read one sector into the sector cache.
  * @param lba LBA to read.
@@ -335,6 +447,24 @@ int RpFilePrivate::scsi_read_capacity(off64_t *pDeviceSize, uint32_t *pSectorSiz
 	}
 
 #ifdef RP_OS_SCSI_SUPPORTED
+	// Check the device characteristics cache first.
+	// NOTE: Skipped for Kreon-unlocked drives, since unlocking
+	// changes the reported capacity.
+	uint64_t cacheKey = 0;
+	const bool hasCacheKey = (!devInfo->isKreonUnlocked && getDeviceCacheKey(this, &cacheKey));
+	if (hasCacheKey) {
+		std::lock_guard<std::mutex> lock(scsi_device_cache_mutex);
+		auto iter = scsi_device_cache.find(cacheKey);
+		if (iter != scsi_device_cache.end() && cache_time_is_valid(iter->second.capacity_time)) {
+			// Cache hit. Skip the SCSI round trip.
+			*pDeviceSize = iter->second.device_size;
+			if (pSectorSize) {
+				*pSectorSize = iter->second.sector_size;
+			}
+			return 0;
+		}
+	}
+
 	// SCSI command buffers.
 	union {
 		SCSI_CDB_READ_CAPACITY_10 read10;
@@ -380,6 +510,7 @@ int RpFilePrivate::scsi_read_capacity(off64_t *pDeviceSize, uint32_t *pSectorSiz
 		}
 		*pDeviceSize = (static_cast<off64_t>(be32_to_cpu(resp.read10.LBA)) + 1) *
 				static_cast<off64_t>(sector_size);
+		cacheStoreCapacity(hasCacheKey, cacheKey, *pDeviceSize, sector_size);
 		return 0;
 	}
 
@@ -408,6 +539,7 @@ int RpFilePrivate::scsi_read_capacity(off64_t *pDeviceSize, uint32_t *pSectorSiz
 	}
 	*pDeviceSize = (static_cast<off64_t>(be64_to_cpu(resp.read16.LBA)) + 1) *
 			static_cast<off64_t>(sector_size);
+	cacheStoreCapacity(hasCacheKey, cacheKey, *pDeviceSize, sector_size);
 	return 0;
 #else /* !RP_OS_SCSI_SUPPORTED */
 	// No SCSI implementation for this OS.
@@ -526,6 +658,21 @@ int RpFile::rereadDeviceSizeScsi(off64_t *pDeviceSize, uint32_t *pSectorSize)
  */
 int RpFile::scsi_inquiry(SCSI_RESP_INQUIRY_STD *pResp)
 {
+	RP_D(RpFile);
+
+	// Check the device characteristics cache first.
+	uint64_t cacheKey = 0;
+	const bool hasCacheKey = getDeviceCacheKey(d, &cacheKey);
+	if (hasCacheKey) {
+		std::lock_guard<std::mutex> lock(scsi_device_cache_mutex);
+		auto iter = scsi_device_cache.find(cacheKey);
+		if (iter != scsi_device_cache.end() && cache_time_is_valid(iter->second.inquiry_time)) {
+			// Cache hit. Skip the SCSI round trip.
+			memcpy(pResp, &iter->second.inquiry, sizeof(*pResp));
+			return 0;
+		}
+	}
+
 	SCSI_CDB_INQUIRY cdb;
 	ASSERT_STRUCT(SCSI_CDB_INQUIRY, 6);
 	cdb.OpCode = SCSI_OP_INQUIRY;
@@ -534,8 +681,15 @@ int RpFile::scsi_inquiry(SCSI_RESP_INQUIRY_STD *pResp)
 	cdb.AllocLen = cpu_to_be16(sizeof(SCSI_RESP_INQUIRY_STD));
 	cdb.Control = 0;
 
-	RP_D(RpFile);
-	return d->scsi_send_cdb(&cdb, sizeof(cdb), pResp, sizeof(*pResp), RpFilePrivate::ScsiDirection::In);
+	int ret = d->scsi_send_cdb(&cdb, sizeof(cdb), pResp, sizeof(*pResp), RpFilePrivate::ScsiDirection::In);
+	if (ret == 0 && hasCacheKey) {
+		// Cache the INQUIRY data.
+		std::lock_guard<std::mutex> lock(scsi_device_cache_mutex);
+		ScsiDeviceCacheEntry &entry = scsi_device_cache[cacheKey];
+		entry.inquiry_time = time(nullptr);
+		memcpy(&entry.inquiry, pResp, sizeof(entry.inquiry));
+	}
+	return ret;
 }
 
 /**
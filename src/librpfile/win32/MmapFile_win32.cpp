@@ -0,0 +1,207 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpfile)                        *
+ * MmapFile_win32.cpp: IRpFile implementation using a memory-mapped file.  *
+ * (Win32 CreateFileMapping() implementation)                              *
+ *                                                                         *
+ * Copyright (c) 2016-2024 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "../MmapFile.hpp"
+
+// librptext
+#include "librptext/conversion.hpp"
+#include "librptext/wchar.hpp"
+
+// libwin32common
+#include "libwin32common/RpWin32_sdk.h"
+#include "libwin32common/w32err.hpp"
+
+// C++ STL classes
+#include <limits>
+using std::wstring;
+
+namespace LibRpFile {
+
+/**
+ * Map an opened file handle into memory. (internal helper)
+ *
+ * The file handle is closed in all cases; the mapping (if any)
+ * stays valid without it.
+ *
+ * @param hFile		[in] File handle (closed on return)
+ * @param pBuf		[out] Mapped view
+ * @param pSize		[out] Mapped size
+ * @return 0 on success; Windows error code on error.
+ */
+static int mapFileHandle(HANDLE hFile, const void **pBuf, size_t *pSize)
+{
+	// Only regular, non-empty files can be mapped.
+	if (GetFileType(hFile) != FILE_TYPE_DISK) {
+		CloseHandle(hFile);
+		return ERROR_NOT_SUPPORTED;
+	}
+
+	LARGE_INTEGER liFileSize;
+	if (!GetFileSizeEx(hFile, &liFileSize) || liFileSize.QuadPart <= 0 ||
+	    static_cast<ULONGLONG>(liFileSize.QuadPart) > std::numeric_limits<size_t>::max())
+	{
+		CloseHandle(hFile);
+		return ERROR_NOT_SUPPORTED;
+	}
+
+	HANDLE hMapping = CreateFileMapping(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!hMapping) {
+		const DWORD dwErr = GetLastError();
+		CloseHandle(hFile);
+		return (dwErr != 0) ? static_cast<int>(dwErr) : ERROR_GEN_FAILURE;
+	}
+
+	void *const map = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+	const DWORD dwErr = GetLastError();
+	// The view stays valid without the mapping or file handles.
+	CloseHandle(hMapping);
+	CloseHandle(hFile);
+	if (!map) {
+		return (dwErr != 0) ? static_cast<int>(dwErr) : ERROR_GEN_FAILURE;
+	}
+
+	*pBuf = map;
+	*pSize = static_cast<size_t>(liFileSize.QuadPart);
+	return 0;
+}
+
+/**
+ * Open a local file as a read-only memory mapping.
+ *
+ * Only regular files can be mapped. For pipes, devices,
+ * and other special files, isOpen() will return false;
+ * the caller should fall back to RpFile.
+ *
+ * @param filename Filename (UTF-8)
+ */
+MmapFile::MmapFile(const char *filename)
+	: super()
+{
+	assert(filename != nullptr);
+	assert(filename[0] != '\0');
+	if (!filename || filename[0] == '\0') {
+		m_lastError = EINVAL;
+		return;
+	}
+
+	HANDLE hFile = CreateFileW(U82W_c(filename),
+		GENERIC_READ, FILE_SHARE_READ, nullptr,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (hFile == INVALID_HANDLE_VALUE) {
+		m_lastError = w32err_to_posix(GetLastError());
+		return;
+	}
+
+	const int w32err = mapFileHandle(hFile, &m_buf, &m_size);
+	if (w32err != 0) {
+		m_lastError = w32err_to_posix(w32err);
+		return;
+	}
+
+	m_pos = 0;
+	setFilename(filename);
+}
+
+/**
+ * Open a local file as a read-only memory mapping.
+ *
+ * Only regular files can be mapped. For pipes, devices,
+ * and other special files, isOpen() will return false;
+ * the caller should fall back to RpFile.
+ *
+ * @param filename Filename (UTF-16)
+ */
+MmapFile::MmapFile(const wchar_t *filename)
+	: super()
+{
+	assert(filename != nullptr);
+	assert(filename[0] != L'\0');
+	if (!filename || filename[0] == L'\0') {
+		m_lastError = EINVAL;
+		return;
+	}
+
+	HANDLE hFile = CreateFileW(filename,
+		GENERIC_READ, FILE_SHARE_READ, nullptr,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (hFile == INVALID_HANDLE_VALUE) {
+		m_lastError = w32err_to_posix(GetLastError());
+		return;
+	}
+
+	const int w32err = mapFileHandle(hFile, &m_buf, &m_size);
+	if (w32err != 0) {
+		m_lastError = w32err_to_posix(w32err);
+		return;
+	}
+
+	m_pos = 0;
+	setFilename(W2U8(filename).c_str());
+}
+
+MmapFile::~MmapFile()
+{
+	if (m_buf) {
+		UnmapViewOfFile(const_cast<void*>(m_buf));
+	}
+}
+
+/**
+ * Close the file.
+ * This unmaps the file from memory.
+ */
+void MmapFile::close(void)
+{
+	if (m_buf) {
+		UnmapViewOfFile(const_cast<void*>(m_buf));
+	}
+	super::close();
+}
+
+/**
+ * Set the expected access pattern for this file.
+ *
+ * This is a best-effort hint: on POSIX systems, it's mapped
+ * to madvise() (SEQUENTIAL/RANDOM/DONTNEED). HeaderOnly drops
+ * the mapping's resident pages; they're faulted back in from
+ * the file if they're read again.
+ *
+ * @param intent	[in] Access intent.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int MmapFile::setAccessIntent(AccessIntent intent)
+{
+	if (!m_buf) {
+		m_lastError = EBADF;
+		return -EBADF;
+	}
+
+	if (intent == AccessIntent::HeaderOnly) {
+		// No more reads are expected. Drop the resident pages;
+		// they'd be faulted back in from the file if read again.
+		if (!VirtualUnlock(const_cast<void*>(m_buf), m_size)) {
+			// VirtualUnlock() on unlocked pages "fails" with
+			// ERROR_NOT_LOCKED after moving them to standby,
+			// which is exactly what we want here.
+			const DWORD w32err = GetLastError();
+			if (w32err != ERROR_NOT_LOCKED) {
+				m_lastError = w32err_to_posix(w32err);
+				return -m_lastError;
+			}
+		}
+		return 0;
+	}
+
+	// No Win32 equivalent of madvise() for readahead hints
+	// on file mappings. Ignore the hint.
+	return 0;
+}
+
+}
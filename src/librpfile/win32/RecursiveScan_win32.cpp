@@ -108,4 +108,39 @@ int recursiveScan(const TCHAR *path, forward_list<pair<tstring, uint8_t> > &rlis
 	return 0;
 }
 
+/**
+ * Recursively scan a directory for cache files to delete.
+ * This finds *.png, *.jpg, *.jxl, and "version.txt".
+ *
+ * Win32 implementation: FindFirstFile() already batches directory
+ * listings, so this currently runs the serial scan and replays the
+ * results through the callback. The list enumerates in
+ * children-before-parent order, matching the parallel version.
+ *
+ * @param path		[in] Path to scan.
+ * @param callback	[in] Callback function for found files and directories.
+ * @param userdata	[in] User data pointer passed to the callback.
+ * @param maxThreads	[in] Maximum number of worker threads. (ignored)
+ * @return 0 on success; non-zero on error.
+ */
+int recursiveScanParallel(const TCHAR *path, RecursiveScanCallback callback, void *userdata, unsigned int maxThreads)
+{
+	assert(callback != nullptr);
+	if (!callback) {
+		return -EINVAL;
+	}
+	RP_UNUSED(maxThreads);
+
+	forward_list<pair<tstring, uint8_t> > rlist;
+	int ret = recursiveScan(path, rlist);
+	if (ret != 0) {
+		return ret;
+	}
+
+	for (const auto &entry : rlist) {
+		callback(entry.first.c_str(), entry.second, userdata);
+	}
+	return 0;
+}
+
 }
@@ -21,11 +21,16 @@
 // librpbyteswap
 #include "librpbyteswap/byteswap_rp.h"
 
+// Tracing instrumentation
+#include "rp_trace.h"
+
 // C includes
 #include <fcntl.h>
 
 // C++ STL classes
+#include <vector>
 using std::string;
+using std::vector;
 using std::wstring;
 
 #ifdef _MSC_VER
@@ -53,6 +58,7 @@ DELAYLOAD_TEST_FUNCTION_IMPL0(get_crc_table);
 RpFilePrivate::RpFilePrivate(RpFile *q, const wchar_t *filenameW, RpFile::FileMode mode)
 	: q_ptr(q), file(INVALID_HANDLE_VALUE), filename(nullptr)
 	, mode(mode), gzfd(nullptr), gzsz(-1), devInfo(nullptr)
+	, hdrCacheState(HdrCacheState::Unchecked)
 {
 	assert(filenameW != nullptr);
 	this->filenameW = wcsdup(filenameW);
@@ -248,13 +254,22 @@ int RpFilePrivate::reOpenFile(void)
 	if (file && file != INVALID_HANDLE_VALUE) {
 		CloseHandle(file);
 	}
+	// Apply access pattern hints.
+	// These adjust the Windows cache manager's readahead behavior.
+	DWORD dwFlagsAndAttributes = FILE_ATTRIBUTE_NORMAL;
+	if (mode & RpFile::FM_HINT_PROBE) {
+		dwFlagsAndAttributes |= FILE_FLAG_RANDOM_ACCESS;
+	} else if (mode & RpFile::FM_HINT_SEQUENTIAL) {
+		dwFlagsAndAttributes |= FILE_FLAG_SEQUENTIAL_SCAN;
+	}
+
 	file = CreateFile(
 		tfilename.c_str(),	// lpFileName
 		dwDesiredAccess,	// dwDesiredAccess
 		dwShareMode,		// dwShareMode
 		nullptr,		// lpSecurityAttributes
 		dwCreationDisposition,	// dwCreationDisposition
-		FILE_ATTRIBUTE_NORMAL,	// dwFlagsAndAttributes
+		dwFlagsAndAttributes,	// dwFlagsAndAttributes
 		nullptr);		// hTemplateFile
 	if (q->m_fileType == DT_BLK) {
 		if (!file || file == INVALID_HANDLE_VALUE) {
@@ -294,6 +309,71 @@ int RpFilePrivate::reOpenFile(void)
 	return (!file || file == INVALID_HANDLE_VALUE);
 }
 
+/**
+ * Check the cross-process header cache for this file.
+ *
+ * Called on the first read() of a plain file. On a hit, the
+ * header is copied out of shared memory; on a miss, it's read
+ * from the file once (without disturbing the file position)
+ * and published for other processes. Sets hdrCacheState.
+ */
+void RpFilePrivate::setupHeaderCache(void)
+{
+	hdrCacheState = HdrCacheState::Disabled;
+	if ((mode & RpFile::FM_WRITE) || gzfd != nullptr || devInfo) {
+		// Writable, compressed, or device file. Not cacheable.
+		return;
+	}
+	if (!HeaderCache::isEnabled()) {
+		return;
+	}
+
+	HeaderCache::Key key;
+	if (!HeaderCache::getKey(file, &key)) {
+		return;
+	}
+
+	// Cache the entire file if it's smaller than an entry.
+	const size_t cache_len = (key.fsize < HeaderCache::DATA_SIZE)
+		? static_cast<size_t>(key.fsize)
+		: HeaderCache::DATA_SIZE;
+	if (cache_len == 0) {
+		return;
+	}
+
+	hdrCacheBuf.resize(cache_len);
+	if (HeaderCache::lookup(key, hdrCacheBuf.data(), cache_len) == cache_len) {
+		// Cache hit. Another process already read this header.
+		hdrCacheState = HdrCacheState::Active;
+		return;
+	}
+
+	// Cache miss. Read the header once and publish it.
+	// Save and restore the file pointer so the caller's
+	// position isn't disturbed.
+	LARGE_INTEGER liZero, liSaved;
+	liZero.QuadPart = 0;
+	if (!SetFilePointerEx(file, liZero, &liSaved, FILE_CURRENT) ||
+	    !SetFilePointerEx(file, liZero, nullptr, FILE_BEGIN))
+	{
+		hdrCacheBuf.clear();
+		return;
+	}
+
+	DWORD bytesRead = 0;
+	const BOOL bRet = ReadFile(file, hdrCacheBuf.data(),
+		static_cast<DWORD>(cache_len), &bytesRead, nullptr);
+	SetFilePointerEx(file, liSaved, nullptr, FILE_BEGIN);
+	if (!bRet || bytesRead != cache_len) {
+		// Short read?
+		hdrCacheBuf.clear();
+		return;
+	}
+
+	HeaderCache::store(key, hdrCacheBuf.data(), cache_len);
+	hdrCacheState = HdrCacheState::Active;
+}
+
 /** RpFile **/
 
 /**
@@ -374,7 +454,7 @@ void RpFile::init(void)
 	// Check if this is a gzipped file.
 	// If it is, use transparent decompression.
 	// Reference: https://www.forensicswiki.org/wiki/Gzip
-	const bool tryGzip = (!d->devInfo && d->mode == FM_OPEN_READ_GZ);
+	const bool tryGzip = (!d->devInfo && (d->mode & ~FM_HINT_MASK) == FM_OPEN_READ_GZ);
 	if (tryGzip) { do {
 #if defined(_MSC_VER) && defined(ZLIB_IS_DLL)
 		// Delay load verification.
@@ -515,6 +595,8 @@ void RpFile::close(void)
  */
 size_t RpFile::read(void *ptr, size_t size)
 {
+	RP_TRACE_SCOPE("RpFile::read");
+
 	RP_D(RpFile);
 	if (!d->file || d->file == INVALID_HANDLE_VALUE) {
 		m_lastError = EBADF;
@@ -540,6 +622,27 @@ size_t RpFile::read(void *ptr, size_t size)
 			m_lastError = errno;
 		}
 	} else {
+		// Consult the cross-process header cache first.
+		// Shell extension hosts re-read the same file headers in
+		// several processes within seconds of each other.
+		if (d->hdrCacheState == RpFilePrivate::HdrCacheState::Unchecked) {
+			d->setupHeaderCache();
+		}
+		if (d->hdrCacheState == RpFilePrivate::HdrCacheState::Active) {
+			LARGE_INTEGER liZero, liPos;
+			liZero.QuadPart = 0;
+			if (SetFilePointerEx(d->file, liZero, &liPos, FILE_CURRENT) &&
+			    static_cast<uint64_t>(liPos.QuadPart) + size <= d->hdrCacheBuf.size())
+			{
+				memcpy(ptr, &d->hdrCacheBuf[static_cast<size_t>(liPos.QuadPart)], size);
+				LARGE_INTEGER liNew;
+				liNew.QuadPart = liPos.QuadPart + static_cast<LONGLONG>(size);
+				if (SetFilePointerEx(d->file, liNew, nullptr, FILE_BEGIN)) {
+					return size;
+				}
+			}
+		}
+
 		BOOL bRet = ReadFile(d->file, ptr, static_cast<DWORD>(size), &bytesRead, nullptr);
 		if (!bRet) {
 			// An error occurred.
@@ -749,6 +852,163 @@ int RpFile::flush(void)
 	return 0;
 }
 
+/**
+ * Advise the file of an upcoming read.
+ *
+ * This is a best-effort hint for predictable access patterns:
+ * on POSIX systems, this starts kernel readahead for the
+ * specified range via posix_fadvise().
+ *
+ * @param offset	[in] Start of the range that will be read.
+ * @param size		[in] Length of the range, in bytes.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int RpFile::advise(off64_t offset, size_t size)
+{
+	// No Win32 equivalent of posix_fadvise() for buffered
+	// file handles. Ignore the hint.
+	RP_UNUSED(offset);
+	RP_UNUSED(size);
+	return 0;
+}
+
+/**
+ * Set the expected access pattern for this file.
+ *
+ * This is a best-effort hint: on POSIX systems, it's mapped
+ * to posix_fadvise() (SEQUENTIAL/RANDOM/DONTNEED). On Windows,
+ * access hints can only be specified when the file is opened,
+ * so this is ignored; use the FM_HINT_* file mode flags instead.
+ *
+ * @param intent	[in] Access intent.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int RpFile::setAccessIntent(AccessIntent intent)
+{
+	// FILE_FLAG_SEQUENTIAL_SCAN and FILE_FLAG_RANDOM_ACCESS can
+	// only be specified in CreateFile(). Ignore the hint.
+	RP_UNUSED(intent);
+	return 0;
+}
+
+/**
+ * Read data from multiple scattered file offsets.
+ *
+ * For uncompressed regular files, each entry is satisfied
+ * with a single positioned read (pread() on POSIX; ReadFile()
+ * with an OVERLAPPED offset on Windows), so no seek syscalls
+ * are issued. Compressed and device-backed files fall back to
+ * the default seek+read implementation.
+ *
+ * NOTE: The file position after this call is unspecified.
+ *
+ * @param vec	[in/out] Array of read vector entries.
+ * @param count	[in] Number of entries in vec.
+ * @return Number of entries that were fully read.
+ */
+size_t RpFile::readVec(ReadVecEntry *vec, size_t count)
+{
+	RP_D(RpFile);
+	if (!d->file || d->file == INVALID_HANDLE_VALUE) {
+		m_lastError = EBADF;
+		return 0;
+	}
+
+	if (d->gzfd || d->devInfo) {
+		// Compressed or device-backed file.
+		// Use the default seek+read implementation.
+		return super::readVec(vec, count);
+	}
+
+	// For multiple entries, issue all reads on an overlapped handle
+	// so the round trips are pipelined instead of serialized.
+	// This matters on network file systems, where header probing
+	// is dominated by per-read latency.
+	// NOTE: ReadFileScatter() requires page-aligned, sector-sized
+	// buffers on unbuffered handles, so it isn't usable here.
+	if (count > 1) {
+		HANDLE hOvl = ReOpenFile(d->file, GENERIC_READ,
+			FILE_SHARE_READ | FILE_SHARE_WRITE, FILE_FLAG_OVERLAPPED);
+		if (hOvl && hOvl != INVALID_HANDLE_VALUE) {
+			size_t entries_read = 0;
+			// NOTE: vector value-initialization zeroes the OVERLAPPEDs.
+			vector<OVERLAPPED> ovl(count);
+
+			// Issue all of the reads.
+			// NOTE: pending[i] is also true if the read completed
+			// synchronously; GetOverlappedResult() still works.
+			vector<uint8_t> pending(count, false);
+			for (size_t i = 0; i < count; i++) {
+				ovl[i].Offset = static_cast<DWORD>(vec[i].offset & 0xFFFFFFFFU);
+				ovl[i].OffsetHigh = static_cast<DWORD>(vec[i].offset >> 32);
+				ovl[i].hEvent = CreateEvent(nullptr, TRUE, FALSE, nullptr);
+				if (!ovl[i].hEvent) {
+					// Could not create the event.
+					// This entry counts as failed.
+					m_lastError = w32err_to_posix(GetLastError());
+					continue;
+				}
+
+				DWORD bytesRead = 0;
+				if (ReadFile(hOvl, vec[i].dest, static_cast<DWORD>(vec[i].size), &bytesRead, &ovl[i])) {
+					pending[i] = true;
+				} else {
+					const DWORD dwErr = GetLastError();
+					if (dwErr == ERROR_IO_PENDING) {
+						pending[i] = true;
+					} else {
+						m_lastError = w32err_to_posix(dwErr);
+					}
+				}
+			}
+
+			// Wait for the reads to finish.
+			for (size_t i = 0; i < count; i++) {
+				if (!ovl[i].hEvent) {
+					continue;
+				}
+				if (pending[i]) {
+					DWORD bytesRead = 0;
+					if (GetOverlappedResult(hOvl, &ovl[i], &bytesRead, TRUE) &&
+					    bytesRead == vec[i].size)
+					{
+						entries_read++;
+					} else {
+						m_lastError = w32err_to_posix(GetLastError());
+					}
+				}
+				CloseHandle(ovl[i].hEvent);
+			}
+
+			CloseHandle(hOvl);
+			return entries_read;
+		}
+		// ReOpenFile() failed (e.g. file system doesn't support it).
+		// Fall back to synchronous positioned reads.
+	}
+
+	// Single entry, or no overlapped handle available.
+	// ReadFile() with an OVERLAPPED offset on a synchronous handle
+	// is the Win32 equivalent of pread().
+	// NOTE: This *does* update the file position on synchronous
+	// handles, hence the position being unspecified afterwards.
+	size_t entries_read = 0;
+	for (; count > 0; count--, vec++) {
+		OVERLAPPED overlapped = { };
+		overlapped.Offset = static_cast<DWORD>(vec->offset & 0xFFFFFFFFU);
+		overlapped.OffsetHigh = static_cast<DWORD>(vec->offset >> 32);
+
+		DWORD bytesRead = 0;
+		const BOOL bRet = ReadFile(d->file, vec->dest, static_cast<DWORD>(vec->size), &bytesRead, &overlapped);
+		if (bRet && bytesRead == vec->size) {
+			entries_read++;
+		} else if (!bRet) {
+			m_lastError = w32err_to_posix(GetLastError());
+		}
+	}
+	return entries_read;
+}
+
 /** File properties **/
 
 /**
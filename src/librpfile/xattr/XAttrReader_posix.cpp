@@ -68,12 +68,23 @@ struct fsxattr {
 #  define O_LARGEFILE 0
 #endif /* !O_LARGEFILE */
 
+#if defined(__linux__) && defined(HAVE_IORING_OP_FGETXATTR)
+// io_uring: used for parallel xattr value retrieval.
+#  include <linux/io_uring.h>
+#  include <sys/mman.h>
+#  include <sys/syscall.h>
+#endif /* __linux__ && HAVE_IORING_OP_FGETXATTR */
+
 // Uninitialized vector class
 #include "uvector.h"
 
+// C++ includes
+#include <vector>
+
 // C++ STL classes
 using std::array;
 using std::string;
+using std::vector;
 
 // XAttrReader isn't used by libromdata directly,
 // so use some linker hax to force linkage.
@@ -337,6 +348,165 @@ int XAttrReaderPrivate::loadDosAttrs(void)
 #endif /* __linux__ */
 }
 
+// Initial value buffer size for xattr retrieval.
+// Most attribute values fit, so the size-probe round trip is skipped.
+static constexpr size_t XATTR_INITIAL_VALUE_SIZE = 256;
+
+#if defined(__linux__) && defined(HAVE_IORING_OP_FGETXATTR)
+/**
+ * Fetch multiple xattr values in parallel using io_uring.
+ *
+ * All fgetxattr requests are submitted in one batch, so the kernel
+ * can issue them concurrently. On network filesystems (CIFS/NFS),
+ * this overlaps the per-attribute round trips instead of paying
+ * for them serially.
+ *
+ * Entries that fail (including -ERANGE for values larger than the
+ * initial buffer) are left at -1 in valuelens for the caller's
+ * serial fallback.
+ *
+ * @param fd		[in] File descriptor.
+ * @param names		[in] Attribute names.
+ * @param values	[out] Value buffers, one per attribute.
+ * @param valuelens	[out] Value lengths; -1 for entries that were not fetched.
+ * @return 0 on success; negative POSIX error code if io_uring is unavailable.
+ */
+static int fgetxattr_io_uring(int fd, const vector<const char*> &names,
+	vector<rp::uvector<char> > &values, vector<ssize_t> &valuelens)
+{
+	if (names.empty()) {
+		return 0;
+	}
+
+	// Set up the ring. The kernel rounds the entry count
+	// up to a power of two.
+	struct io_uring_params params;
+	memset(&params, 0, sizeof(params));
+	const unsigned int entries = (names.size() < 64U)
+		? static_cast<unsigned int>(names.size())
+		: 64U;
+	const int ring_fd = static_cast<int>(syscall(SYS_io_uring_setup, entries, &params));
+	if (ring_fd < 0) {
+		// io_uring isn't available. (pre-5.19 kernel, or seccomp)
+		return -errno;
+	}
+
+	// Map the submission and completion queue rings.
+	size_t sq_ring_sz = params.sq_off.array + (params.sq_entries * sizeof(__u32));
+	size_t cq_ring_sz = params.cq_off.cqes + (params.cq_entries * sizeof(struct io_uring_cqe));
+	if (params.features & IORING_FEAT_SINGLE_MMAP) {
+		if (cq_ring_sz > sq_ring_sz) {
+			sq_ring_sz = cq_ring_sz;
+		}
+	}
+	uint8_t *const sq_ptr = static_cast<uint8_t*>(mmap(nullptr, sq_ring_sz,
+		PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+		ring_fd, IORING_OFF_SQ_RING));
+	if (sq_ptr == MAP_FAILED) {
+		close(ring_fd);
+		return -ENOMEM;
+	}
+	uint8_t *cq_ptr;
+	if (params.features & IORING_FEAT_SINGLE_MMAP) {
+		cq_ptr = sq_ptr;
+	} else {
+		cq_ptr = static_cast<uint8_t*>(mmap(nullptr, cq_ring_sz,
+			PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+			ring_fd, IORING_OFF_CQ_RING));
+		if (cq_ptr == MAP_FAILED) {
+			munmap(sq_ptr, sq_ring_sz);
+			close(ring_fd);
+			return -ENOMEM;
+		}
+	}
+	const size_t sqes_sz = params.sq_entries * sizeof(struct io_uring_sqe);
+	struct io_uring_sqe *const sqes = static_cast<struct io_uring_sqe*>(mmap(
+		nullptr, sqes_sz, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+		ring_fd, IORING_OFF_SQES));
+	if (sqes == MAP_FAILED) {
+		if (cq_ptr != sq_ptr) {
+			munmap(cq_ptr, cq_ring_sz);
+		}
+		munmap(sq_ptr, sq_ring_sz);
+		close(ring_fd);
+		return -ENOMEM;
+	}
+
+	// Ring pointers.
+	__u32 *const sq_tail = reinterpret_cast<__u32*>(sq_ptr + params.sq_off.tail);
+	const __u32 sq_mask = *reinterpret_cast<__u32*>(sq_ptr + params.sq_off.ring_mask);
+	__u32 *const sq_array = reinterpret_cast<__u32*>(sq_ptr + params.sq_off.array);
+	__u32 *const cq_head = reinterpret_cast<__u32*>(cq_ptr + params.cq_off.head);
+	__u32 *const cq_tail = reinterpret_cast<__u32*>(cq_ptr + params.cq_off.tail);
+	const __u32 cq_mask = *reinterpret_cast<__u32*>(cq_ptr + params.cq_off.ring_mask);
+	const struct io_uring_cqe *const cqes =
+		reinterpret_cast<struct io_uring_cqe*>(cq_ptr + params.cq_off.cqes);
+
+	int ret = 0;
+	size_t submitted = 0;
+	while (submitted < names.size()) {
+		// Submit up to a full ring's worth of fgetxattr requests.
+		const size_t remain = names.size() - submitted;
+		const unsigned int batch = (remain < params.sq_entries)
+			? static_cast<unsigned int>(remain)
+			: params.sq_entries;
+
+		__u32 tail = *sq_tail;
+		for (unsigned int i = 0; i < batch; i++) {
+			const size_t idx = submitted + i;
+			values[idx].resize(XATTR_INITIAL_VALUE_SIZE);
+
+			const __u32 sqidx = tail & sq_mask;
+			struct io_uring_sqe *const sqe = &sqes[sqidx];
+			memset(sqe, 0, sizeof(*sqe));
+			sqe->opcode = IORING_OP_FGETXATTR;
+			sqe->fd = fd;
+			sqe->addr = reinterpret_cast<uintptr_t>(names[idx]);
+			sqe->len = static_cast<__u32>(values[idx].size());
+			sqe->off = reinterpret_cast<uintptr_t>(values[idx].data());
+			sqe->user_data = idx;
+			sq_array[sqidx] = sqidx;
+			tail++;
+		}
+		// Publish the new SQ tail.
+		__atomic_store_n(sq_tail, tail, __ATOMIC_RELEASE);
+
+		// Submit the batch and wait for all of its completions.
+		const int eret = static_cast<int>(syscall(SYS_io_uring_enter,
+			ring_fd, batch, batch, IORING_ENTER_GETEVENTS, nullptr, 0));
+		if (eret < 0) {
+			ret = -errno;
+			break;
+		}
+
+		// Reap the completions.
+		__u32 head = *cq_head;
+		const __u32 tail_now = __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE);
+		for (; head != tail_now; head++) {
+			const struct io_uring_cqe *const cqe = &cqes[head & cq_mask];
+			const size_t idx = static_cast<size_t>(cqe->user_data);
+			if (idx < valuelens.size() && cqe->res >= 0) {
+				valuelens[idx] = cqe->res;
+			}
+			// NOTE: Negative res, e.g. -ERANGE for values larger
+			// than the initial buffer, is left for the serial
+			// fallback to handle.
+		}
+		__atomic_store_n(cq_head, head, __ATOMIC_RELEASE);
+
+		submitted += batch;
+	}
+
+	munmap(sqes, sqes_sz);
+	if (cq_ptr != sq_ptr) {
+		munmap(cq_ptr, cq_ring_sz);
+	}
+	munmap(sq_ptr, sq_ring_sz);
+	close(ring_fd);
+	return ret;
+}
+#endif /* __linux__ && HAVE_IORING_OP_FGETXATTR */
+
 /**
  * Load generic xattrs, if available.
  * (POSIX xattr on Linux; ADS on Windows)
@@ -371,8 +541,7 @@ int XAttrReaderPrivate::loadGenericXattrs(void)
 	// Partially based on KIO's FileProtocol::copyXattrs().
 	// Reference: https://invent.kde.org/frameworks/kio/-/blob/584a81fd453858db432a573c011a1433bc6947e1/src/kioworkers/file/file_unix.cpp#L521
 	ssize_t listlen = 0;
-	rp::uvector<char> keylist;
-	keylist.reserve(256);
+	rp::suvector<char, 256> keylist;
 	while (true) {
 		keylist.resize(listlen);
 #if defined(HAVE_SYS_XATTR_H) && !defined(__stub_getxattr) && !defined(__APPLE__)
@@ -415,13 +584,15 @@ int XAttrReaderPrivate::loadGenericXattrs(void)
 	}
 #endif /* HAVE_SYS_XATTR_H */
 
-	// Value buffer
-	rp::uvector<char> value;
-	value.reserve(256);
-
+	// Parse the attribute names from the list.
 	// Linux, macOS: List contains NULL-terminated strings.
 	// FreeBSD: List contains counted (but not NULL-terminated) strings.
 	// Process strings until we reach list_buf + list_size.
+#if defined(HAVE_SYS_XATTR_H)
+	vector<const char*> names;	// pointers into keylist
+#elif defined(HAVE_SYS_EXTATTR_H)
+	vector<string> names;
+#endif
 	const char *const keylist_end = keylist.data() + keylist.size();
 	const char *p = keylist.data();
 	while (p < keylist_end) {
@@ -437,6 +608,8 @@ int XAttrReaderPrivate::loadGenericXattrs(void)
 		p += strlen(name) + 1;
 		if (p > keylist_end)
 			break;
+
+		names.push_back(name);
 #elif defined(HAVE_SYS_EXTATTR_H)
 		uint8_t len = *p;
 
@@ -447,17 +620,45 @@ int XAttrReaderPrivate::loadGenericXattrs(void)
 			break;
 		}
 
-		string name(p+1, len);
+		names.emplace_back(p+1, len);
 		p += 1 + len;
 #endif
+	}
 
-		ssize_t valuelen = 0;
+	// Value buffers, one per attribute.
+	// NOTE: valuelen does *not* include a NULL-terminator.
+	// Negative valuelen indicates the attribute wasn't fetched.
+	vector<rp::uvector<char> > values(names.size());
+	vector<ssize_t> valuelens(names.size(), -1);
+
+#if defined(__linux__) && defined(HAVE_IORING_OP_FGETXATTR)
+	// Fetch all of the values in one parallel batch if possible.
+	// Falls through to the serial loop for anything not fetched.
+	fgetxattr_io_uring(fd, names, values, valuelens);
+#endif /* __linux__ && HAVE_IORING_OP_FGETXATTR */
+
+	// Fetch any remaining values serially.
+	for (size_t i = 0; i < names.size(); i++) {
+		if (valuelens[i] >= 0) {
+			// Already fetched.
+			continue;
+		}
+#if defined(HAVE_SYS_XATTR_H)
+		const char *const name = names[i];
+#elif defined(HAVE_SYS_EXTATTR_H)
+		const string &name = names[i];
+#endif
+		rp::uvector<char> &value = values[i];
+
+		// Start with a small buffer to avoid a separate size-probe
+		// round trip for typical attribute values. (each fgetxattr()
+		// is a network round trip on CIFS/NFS)
+		ssize_t valuelen = XATTR_INITIAL_VALUE_SIZE;
 		do {
 			// Get the value for this attribute.
-			// NOTE: valuelen does *not* include a NULL-terminator.
 			value.resize(valuelen);
 #if defined(HAVE_SYS_XATTR_H) && !defined(__stub_getxattr) && !defined(__APPLE__)
-			valuelen = fgetxattr(fd, name, value.data(), valuelen);
+			valuelen = fgetxattr(fd, name, value.data(), value.size());
 #elif defined(__APPLE__)
 			valuelen = fgetxattr(fd, name, nullptr, value.data(), 0);
 #elif defined(HAVE_SYS_EXTATTR_H)
@@ -469,15 +670,21 @@ int XAttrReaderPrivate::loadGenericXattrs(void)
 			} else if (valuelen > 0 && value.size() > 0) {
 				break;
 			} else if (valuelen == -1 && errno == ERANGE) {
+				// Buffer is too small. Probe for the required size.
 				valuelen = 0;
 				continue;
-			} else if (valuelen == 0) {
-				// attr value is an empty string
+			} else {
+				// Empty value, or an unexpected error.
 				break;
 			}
 		} while (true);
 
-		if (valuelen < 0) {
+		valuelens[i] = valuelen;
+	}
+
+	// Build the attribute map.
+	for (size_t i = 0; i < names.size(); i++) {
+		if (valuelens[i] < 0) {
 			// Not valid. Go to the next attribute.
 			continue;
 		}
@@ -485,13 +692,13 @@ int XAttrReaderPrivate::loadGenericXattrs(void)
 		// We have the attribute.
 		// NOTE: Not checking for duplicates, since there
 		// shouldn't be duplicate attribute names.
-		string s_value(value.data(), valuelen);
+		string s_value(values[i].data(), valuelens[i]);
 #if HAVE_SYS_EXTATTR_H
 		string s_name_prefixed(s_namespace);
-		s_name_prefixed.append(name);
+		s_name_prefixed.append(names[i]);
 		genericXAttrs.emplace(std::move(s_name_prefixed), std::move(s_value));
 #else /* !HAVE_SYS_EXTATTR_H */
-		genericXAttrs.emplace(name, std::move(s_value));
+		genericXAttrs.emplace(names[i], std::move(s_value));
 #endif /* HAVE_SYS_EXTATTR_H */
 	}
 
@@ -8,6 +8,9 @@
 
 #pragma once
 
+// C includes (C++ namespace)
+#include <cstdint>
+
 // C++ includes
 #include <array>
 
@@ -231,12 +234,57 @@ static constexpr std::array<char16_t, 256> petscii_shifted_lkup = {{
 	0xFFFD, 0x258E, 0x2713, 0x2596, 0x259D, 0x2518, 0x2598, 0x259A,
 }};
 
-// Lookup tables in RP_CP_* ordering.
-static const std::array<const std::array<char16_t, 256>*, 4> lkup_tbls = {{
-	&atariST_lkup,		// CP_RP_ATARIST
-	&atascii_lkup,		// CP_RP_ATASCII
-	&petscii_unshifted_lkup,	// CP_RP_PETSCII_Unshifted
-	&petscii_shifted_lkup,	// CP_RP_PETSCII_Shifted
+/** UTF-8 expansion tables **/
+
+// Precomputed UTF-8 encodings of the lookup table codepoints.
+// - entries[i][0..2]: UTF-8 encoding of codepoint i. (BMP: 1-3 bytes)
+// - entries[i][3]: Length of the encoding, in bytes.
+// The fixed 4-byte stride lets the converter do one unconditional
+// 4-byte store per input byte instead of branching on the length.
+struct utf8_exp_tbl_t {
+	uint8_t entries[256][4];
+};
+
+/**
+ * Generate a UTF-8 expansion table from a UTF-16 lookup table.
+ * (Evaluated at compile time.)
+ * @param lkup	[in] 256-element UTF-16 lookup table
+ * @return UTF-8 expansion table.
+ */
+static constexpr utf8_exp_tbl_t make_utf8_exp_tbl(const std::array<char16_t, 256> &lkup)
+{
+	utf8_exp_tbl_t tbl = {};
+	for (unsigned int i = 0; i < 256; i++) {
+		const char16_t ch16 = lkup[i];
+		uint8_t *const p = tbl.entries[i];
+		if (ch16 < 0x0080) {
+			p[0] = static_cast<uint8_t>(ch16);
+			p[3] = 1;
+		} else if (ch16 < 0x0800) {
+			p[0] = static_cast<uint8_t>(0xC0 | (ch16 >> 6));
+			p[1] = static_cast<uint8_t>(0x80 | (ch16 & 0x3F));
+			p[3] = 2;
+		} else /*if (ch16 < 0x10000)*/ {
+			p[0] = static_cast<uint8_t>(0xE0 | (ch16 >> 12));
+			p[1] = static_cast<uint8_t>(0x80 | ((ch16 >> 6) & 0x3F));
+			p[2] = static_cast<uint8_t>(0x80 | (ch16 & 0x3F));
+			p[3] = 3;
+		}
+	}
+	return tbl;
+}
+
+static constexpr utf8_exp_tbl_t atariST_utf8_exp = make_utf8_exp_tbl(atariST_lkup);
+static constexpr utf8_exp_tbl_t atascii_utf8_exp = make_utf8_exp_tbl(atascii_lkup);
+static constexpr utf8_exp_tbl_t petscii_unshifted_utf8_exp = make_utf8_exp_tbl(petscii_unshifted_lkup);
+static constexpr utf8_exp_tbl_t petscii_shifted_utf8_exp = make_utf8_exp_tbl(petscii_shifted_lkup);
+
+// UTF-8 expansion tables in RP_CP_* ordering.
+static const std::array<const utf8_exp_tbl_t*, 4> utf8_exp_tbls = {{
+	&atariST_utf8_exp,	// CP_RP_ATARIST
+	&atascii_utf8_exp,	// CP_RP_ATASCII
+	&petscii_unshifted_utf8_exp,	// CP_RP_PETSCII_Unshifted
+	&petscii_shifted_utf8_exp,	// CP_RP_PETSCII_Shifted
 }};
 
 } }
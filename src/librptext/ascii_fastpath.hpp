@@ -0,0 +1,135 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librptext)                        *
+ * ascii_fastpath.hpp: ASCII fast path checks for text conversion         *
+ *                                                                         *
+ * Copyright (c) 2009-2024 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#pragma once
+
+#include "config.librptext.h"
+#include "common.h"
+
+// C includes (C++ namespace)
+#include <cstdint>
+#include <cstring>
+
+// C++ STL classes
+#include <string>
+
+// SSE2 is the baseline on amd64, and can be enabled on i386.
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define RP_TEXT_HAS_SSE2 1
+#  include <emmintrin.h>
+#endif
+
+namespace LibRpText {
+
+/**
+ * Check if 8-bit text is entirely ASCII. (all bytes < 0x80)
+ *
+ * If it is, conversion to or from UTF-8 is an identity mapping for
+ * every code page we use, so the converter can be skipped entirely.
+ * Vectorized using SSE2 where available; otherwise, eight bytes are
+ * checked at a time using a 64-bit mask.
+ *
+ * @param str	[in] 8-bit text
+ * @param len	[in] Length of str, in bytes
+ * @return True if the text is entirely ASCII; false if not.
+ */
+static inline bool is_ascii(const char *str, size_t len)
+{
+	const uint8_t *p = reinterpret_cast<const uint8_t*>(str);
+
+#ifdef RP_TEXT_HAS_SSE2
+	for (; len >= 16; p += 16, len -= 16) {
+		const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+		if (_mm_movemask_epi8(chunk) != 0) {
+			return false;
+		}
+	}
+#endif /* RP_TEXT_HAS_SSE2 */
+
+	for (; len >= 8; p += 8, len -= 8) {
+		uint64_t v;
+		memcpy(&v, p, sizeof(v));
+		if (v & 0x8080808080808080ULL) {
+			return false;
+		}
+	}
+
+	for (; len > 0; p++, len--) {
+		if (*p & 0x80) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * Check if UTF-16 text consists entirely of ASCII code units.
+ *
+ * The mask selects the bits that must be zero in each code unit:
+ * - Host-endian text: 0xFF80 (value < 0x80)
+ * - Byte-swapped text: 0x80FF (value is an ASCII character shifted left by 8)
+ *
+ * @param wcs	[in] UTF-16 text
+ * @param len	[in] Length of wcs, in characters
+ * @param mask	[in] Bits that must be zero in each code unit
+ * @return True if all code units are ASCII; false if not.
+ */
+static inline bool is_ascii_utf16(const char16_t *wcs, size_t len, uint16_t mask)
+{
+#ifdef RP_TEXT_HAS_SSE2
+	const __m128i vmask = _mm_set1_epi16(static_cast<int16_t>(mask));
+	const __m128i vzero = _mm_setzero_si128();
+	for (; len >= 8; wcs += 8, len -= 8) {
+		const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(wcs));
+		const __m128i cmp = _mm_cmpeq_epi16(_mm_and_si128(chunk, vmask), vzero);
+		if (_mm_movemask_epi8(cmp) != 0xFFFF) {
+			return false;
+		}
+	}
+#endif /* RP_TEXT_HAS_SSE2 */
+
+	const uint64_t mask64 = 0x0001000100010001ULL * mask;
+	for (; len >= 4; wcs += 4, len -= 4) {
+		uint64_t v;
+		memcpy(&v, wcs, sizeof(v));
+		if (v & mask64) {
+			return false;
+		}
+	}
+
+	for (; len > 0; wcs++, len--) {
+		if (static_cast<uint16_t>(*wcs) & mask) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// is_ascii_utf16() masks
+static constexpr uint16_t ASCII_UTF16_HOST_MASK = 0xFF80;
+static constexpr uint16_t ASCII_UTF16_SWAP_MASK = 0x80FF;
+
+/**
+ * Convert UTF-16 text that passed is_ascii_utf16() to UTF-8.
+ * @param wcs	[in] UTF-16 text
+ * @param len	[in] Length of wcs, in characters
+ * @param shift	[in] 0 for host-endian text; 8 for byte-swapped text
+ * @return UTF-8 (ASCII) string
+ */
+static inline std::string ascii_utf16_to_utf8(const char16_t *wcs, size_t len, unsigned int shift)
+{
+	std::string ret;
+	ret.reserve(len);
+	for (; len > 0; wcs++, len--) {
+		ret += static_cast<char>(static_cast<uint16_t>(*wcs) >> shift);
+	}
+	return ret;
+}
+
+}
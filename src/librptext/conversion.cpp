@@ -13,7 +13,7 @@
 // Other rom-properties libraries
 #include "libi18n/i18n.h"
 #include "librpbyteswap/byteswap_rp.h"
-#include "librpthreads/pthread_once.h"
+#include "librpthreads/rp_once.h"
 
 // C includes
 #ifdef HAVE_NL_LANGINFO
@@ -44,7 +44,7 @@ namespace LibRpText {
 /** OS-independent text conversion functions. **/
 
 // Localized decimal point
-static pthread_once_t lc_decimal_once_control = PTHREAD_ONCE_INIT;
+static rp_once_t lc_decimal_once_control = RP_ONCE_INIT;
 static bool is_C_locale;
 static char lc_decimal[8];
 
@@ -242,7 +242,7 @@ static inline int calc_frac_part_decimal(T val, T divisor)
 
 /**
  * Initialize the localized decimal point.
- * Called by pthread_once().
+ * Called by rp_once().
  */
 static void initLocalizedDecimalPoint(void)
 {
@@ -443,7 +443,7 @@ string formatFileSize(off64_t size, BinaryUnitDialect dialect)
 		}
 
 		// Ensure the localized decimal point is initialized.
-		pthread_once(&lc_decimal_once_control, initLocalizedDecimalPoint);
+		rp_once(&lc_decimal_once_control, initLocalizedDecimalPoint);
 
 		// Append the fractional part using the required number of digits.
 		s_value << lc_decimal;
@@ -550,7 +550,7 @@ std::string formatFrequency(uint32_t frequency)
 		const int frac_digits = 3;
 
 		// Ensure the localized decimal point is initialized.
-		pthread_once(&lc_decimal_once_control, initLocalizedDecimalPoint);
+		rp_once(&lc_decimal_once_control, initLocalizedDecimalPoint);
 
 		// Append the fractional part using the required number of digits.
 		s_value << lc_decimal;
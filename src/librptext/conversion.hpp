@@ -208,6 +208,24 @@ typedef enum {
 RP_LIBROMDATA_PUBLIC
 std::string cpN_to_utf8(unsigned int cp, const char *str, int len, unsigned int flags = 0);
 
+/**
+ * Convert 8-bit text to UTF-8, reusing a caller-provided string.
+ * Trailing NULL bytes will be removed.
+ *
+ * The specified code page number will be used.
+ * The previous contents of the output string are replaced, but its
+ * allocated capacity is reused, so repeated conversions into the same
+ * string (e.g. per directory entry) don't reallocate.
+ *
+ * @param cp	[in] Code page number.
+ * @param str	[in] 8-bit text.
+ * @param len	[in] Length of str, in bytes. (-1 for NULL-terminated string)
+ * @param out	[out] Output UTF-8 string. (cleared on error)
+ * @param flags	[in] Flags. (See TextConv_Flags_e.)
+ */
+RP_LIBROMDATA_PUBLIC
+void cpN_to_utf8(unsigned int cp, const char *str, int len, std::string &out, unsigned int flags = 0);
+
 /**
  * Convert 8-bit text to UTF-8 using an RP-custom code page.
  * Code page number must be CP_RP_*.
@@ -219,6 +237,18 @@ std::string cpN_to_utf8(unsigned int cp, const char *str, int len, unsigned int
  */
 std::string cpRP_to_utf8(unsigned int cp, const char *str, int len);
 
+/**
+ * Convert 8-bit text to UTF-8 using an RP-custom code page,
+ * reusing a caller-provided string.
+ * Code page number must be CP_RP_*.
+ *
+ * @param cp	[in] Code page number.
+ * @param str	[in] 8-bit text.
+ * @param len	[in] Length of str, in bytes. (-1 for NULL-terminated string)
+ * @param out	[out] Output UTF-8 string. (cleared on error)
+ */
+void cpRP_to_utf8(unsigned int cp, const char *str, int len, std::string &out);
+
 /**
  * Convert 8-bit text to UTF-16.
  * Trailing NULL bytes will be removed.
@@ -446,6 +476,21 @@ static inline std::string latin1_to_utf8(const std::string &str)
 	return cpN_to_utf8(1252, str.data(), static_cast<int>(str.size()));
 }
 
+/**
+ * Convert Latin-1 (ISO-8859-1) text to UTF-8, reusing a caller-provided string.
+ * Trailing NULL bytes will be removed.
+ * @param str	[in] Latin-1 text.
+ * @param len	[in] Length of str, in bytes. (-1 for NULL-terminated string)
+ * @param out	[out] Output UTF-8 string. (cleared on error)
+ */
+static inline void latin1_to_utf8(const char *str, int len, std::string &out)
+{
+	// NOTE: Using cp1252 here, since this ends up passing
+	// various C0/C1 control characters through for some ROMs,
+	// which causes terminal output to stop.
+	cpN_to_utf8(1252, str, len, out);
+}
+
 /**
  * Convert Latin-1 (ISO-8859-1) text to UTF-16.
  * Trailing NULL bytes will be removed.
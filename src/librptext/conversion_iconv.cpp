@@ -9,6 +9,7 @@
 #include "config.librptext.h"
 #include "conversion.hpp"
 #include "NULL-check.hpp"
+#include "ascii_fastpath.hpp"
 
 #if defined(_WIN32)
 #  error conversion_iconv.cpp is not supported on Windows.
@@ -41,6 +42,7 @@
 #include <cassert>
 
 // C++ STL classes
+#include <vector>
 using std::string;
 using std::u16string;
 
@@ -48,6 +50,69 @@ namespace LibRpText {
 
 /** OS-specific text conversion functions. **/
 
+/**
+ * Cached iconv descriptors, one set per thread.
+ *
+ * glibc's iconv_open() does dynamic module loading and allocation on
+ * every call, which dominates the cost of converting the short strings
+ * we typically handle. The number of distinct conversions is small, so
+ * a linear search is sufficient.
+ */
+class IconvCache
+{
+public:
+	IconvCache() = default;
+	~IconvCache()
+	{
+		for (const Entry &entry : entries) {
+			iconv_close(entry.cd);
+		}
+	}
+
+private:
+	RP_DISABLE_COPY(IconvCache)
+
+public:
+	/**
+	 * Get a cached iconv descriptor for the specified conversion.
+	 * The descriptor's conversion state is reset before reuse.
+	 *
+	 * NOTE: The returned descriptor is owned by the cache.
+	 * Do NOT call iconv_close() on it.
+	 *
+	 * @param src_charset	[in] Source character set
+	 * @param dest_charset	[in] Destination character set
+	 * @return iconv descriptor, or (iconv_t)(-1) on error.
+	 */
+	iconv_t get(const char *src_charset, const char *dest_charset)
+	{
+		for (const Entry &entry : entries) {
+			if (entry.src == src_charset && entry.dest == dest_charset) {
+				// Reset the conversion state before reuse.
+				iconv(entry.cd, nullptr, nullptr, nullptr, nullptr);
+				return entry.cd;
+			}
+		}
+
+		// Not cached yet. Open a new descriptor.
+		iconv_t cd = iconv_open(dest_charset, src_charset);
+		if (cd != (iconv_t)(-1)) {
+			entries.push_back({src_charset, dest_charset, cd});
+		}
+		return cd;
+	}
+
+private:
+	struct Entry {
+		string src;
+		string dest;
+		iconv_t cd;
+	};
+	std::vector<Entry> entries;
+};
+
+static thread_local IconvCache iconv_cache;
+
 /**
  * Convert a string from one character set to another.
  * @param src 		[in] Source string.
@@ -77,7 +142,9 @@ static char *rp_iconv(const char *src, int len,
 	// * http://www.delorie.com/gnu/docs/glibc/libc_101.html
 	// * http://www.codase.com/search/call?name=iconv
 
-	// Open an iconv descriptor.
+	// Get a cached iconv descriptor.
+	// NOTE: The descriptor is owned by the per-thread cache,
+	// so it must not be closed here.
 	iconv_t cd;
 #if defined(__linux__) || defined(HAVE_ICONV_LIBICONV)
 	// glibc/libiconv: Append "//IGNORE" to the source character set
@@ -86,13 +153,13 @@ static char *rp_iconv(const char *src, int len,
 	if (ignoreErr) {
 		char tmpsrc[32];
 		snprintf(tmpsrc, sizeof(tmpsrc), "%s//IGNORE", src_charset);
-		cd = iconv_open(dest_charset, tmpsrc);
+		cd = iconv_cache.get(tmpsrc, dest_charset);
 	} else {
 		// Not ignoring errors.
-		cd = iconv_open(dest_charset, src_charset);
+		cd = iconv_cache.get(src_charset, dest_charset);
 	}
 #else
-	cd = iconv_open(dest_charset, src_charset);
+	cd = iconv_cache.get(src_charset, dest_charset);
 #endif
 
 	if (cd == (iconv_t)(-1)) {
@@ -139,8 +206,8 @@ static char *rp_iconv(const char *src, int len,
 		}
 	}
 
-	// Close the iconv descriptor.
-	iconv_close(cd);
+	// NOTE: The iconv descriptor stays open in the per-thread cache.
+	// Its conversion state is reset on the next get().
 
 	if (success) {
 		// The string was converted successfully.
@@ -202,14 +269,45 @@ static inline void codePageToEncName(char *enc_name, size_t len, unsigned int cp
  * @return UTF-8 string.
  */
 string cpN_to_utf8(unsigned int cp, const char *str, int len, unsigned int flags)
+{
+	string ret;
+	cpN_to_utf8(cp, str, len, ret, flags);
+	return ret;
+}
+
+/**
+ * Convert 8-bit text to UTF-8, reusing a caller-provided string.
+ * Trailing NULL bytes will be removed.
+ *
+ * The specified code page number will be used.
+ * The previous contents of the output string are replaced, but its
+ * allocated capacity is reused, so repeated conversions into the same
+ * string (e.g. per directory entry) don't reallocate.
+ *
+ * @param cp	[in] Code page number.
+ * @param str	[in] 8-bit text.
+ * @param len	[in] Length of str, in bytes. (-1 for NULL-terminated string)
+ * @param out	[out] Output UTF-8 string. (cleared on error)
+ * @param flags	[in] Flags. (See TextConv_Flags_e.)
+ */
+void cpN_to_utf8(unsigned int cp, const char *str, int len, string &out, unsigned int flags)
 {
 	if (cp & CP_RP_BASE) {
 		// RP-custom code page.
-		return cpRP_to_utf8(cp, str, len);
+		cpRP_to_utf8(cp, str, len, out);
+		return;
 	}
 
 	len = check_NULL_terminator(str, len);
 
+	// FAST PATH: If the text is entirely ASCII, every code page we
+	// use maps it to UTF-8 unchanged, so skip iconv entirely.
+	// (The RP-custom code pages were already handled above.)
+	if (is_ascii(str, len)) {
+		out.assign(str, static_cast<size_t>(len));
+		return;
+	}
+
 	// Get the encoding name for the primary code page.
 	char cp_name[20];
 	codePageToEncName(cp_name, sizeof(cp_name), cp);
@@ -221,7 +319,7 @@ string cpN_to_utf8(unsigned int cp, const char *str, int len, unsigned int flags
 	// Attempt to convert the text to UTF-8.
 	// NOTE: "//IGNORE" sometimes doesn't work, so we won't
 	// check for TEXTCONV_FLAG_CP1252_FALLBACK here.
-	string ret;
+	out.clear();
 	char *mbs = reinterpret_cast<char*>(rp_iconv((char*)str, len*sizeof(*str), cp_name, "UTF-8", ignoreErr));
 	if (!mbs /*&& (flags & TEXTCONV_FLAG_CP1252_FALLBACK)*/) {
 		// Try cp1252 fallback.
@@ -238,15 +336,15 @@ string cpN_to_utf8(unsigned int cp, const char *str, int len, unsigned int flags
 	}
 
 	if (mbs) {
-		ret.assign(mbs);
+		out.assign(mbs);
 		free(mbs);
 
 #ifdef HAVE_ICONV_LIBICONV
 		if (cp == CP_SJIS) {
 			// libiconv's cp932 maps Shift-JIS 8160 to U+301C. This is expected
 			// behavior for Shift-JIS, but cp932 should map it to U+FF5E.
-			const auto ret_end = ret.end();
-			for (auto p = ret.begin(); p != ret_end; ++p) {
+			const auto out_end = out.end();
+			for (auto p = out.begin(); p != out_end; ++p) {
 				if ((uint8_t)p[0] == 0xE3 && (uint8_t)p[1] == 0x80 && (uint8_t)p[2] == 0x9C) {
 					// Found a wave dash.
 					p[0] = (uint8_t)0xEF;
@@ -258,7 +356,6 @@ string cpN_to_utf8(unsigned int cp, const char *str, int len, unsigned int flags
 		}
 #endif /* HAVE_ICONV_LIBICONV */
 	}
-	return ret;
 }
 
 /**
@@ -277,6 +374,16 @@ u16string cpN_to_utf16(unsigned int cp, const char *str, int len, unsigned int f
 {
 	len = check_NULL_terminator(str, len);
 
+	// FAST PATH: ASCII text widens to UTF-16 directly.
+	if (is_ascii(str, len)) {
+		u16string ret;
+		ret.reserve(len);
+		for (int i = 0; i < len; i++) {
+			ret += static_cast<char16_t>(static_cast<uint8_t>(str[i]));
+		}
+		return ret;
+	}
+
 	// Get the encoding name for the primary code page.
 	char cp_name[20];
 	codePageToEncName(cp_name, sizeof(cp_name), cp);
@@ -336,6 +443,11 @@ string utf8_to_cpN(unsigned int cp, const char *str, int len)
 {
 	len = check_NULL_terminator(str, len);
 
+	// FAST PATH: ASCII text is valid in every code page we use.
+	if (is_ascii(str, len)) {
+		return {str, static_cast<size_t>(len)};
+	}
+
 	// Get the encoding name for the primary code page.
 	char cp_name[20];
 	codePageToEncName(cp_name, sizeof(cp_name), cp);
@@ -366,6 +478,12 @@ string utf16_to_cpN(unsigned int cp, const char16_t *wcs, int len)
 {
 	len = check_NULL_terminator(wcs, len);
 
+	// FAST PATH: ASCII text narrows to any of our code pages directly.
+	// (wcs is host-endian here.)
+	if (is_ascii_utf16(wcs, len, ASCII_UTF16_HOST_MASK)) {
+		return ascii_utf16_to_utf8(wcs, len, 0);
+	}
+
 	// Get the encoding name for the primary code page.
 	char cp_name[20];
 	codePageToEncName(cp_name, sizeof(cp_name), cp);
@@ -396,6 +514,17 @@ string utf16le_to_utf8(const char16_t *wcs, int len)
 {
 	len = check_NULL_terminator(wcs, len);
 
+	// FAST PATH: ASCII text narrows to UTF-8 directly.
+#if SYS_BYTEORDER == SYS_BIG_ENDIAN
+	if (is_ascii_utf16(wcs, len, ASCII_UTF16_SWAP_MASK)) {
+		return ascii_utf16_to_utf8(wcs, len, 8);
+	}
+#else /* SYS_BYTEORDER == SYS_LIL_ENDIAN */
+	if (is_ascii_utf16(wcs, len, ASCII_UTF16_HOST_MASK)) {
+		return ascii_utf16_to_utf8(wcs, len, 0);
+	}
+#endif
+
 	// Attempt to convert the text from UTF-16LE to UTF-8.
 	string ret;
 	char *mbs = reinterpret_cast<char*>(rp_iconv((char*)wcs, len*sizeof(*wcs), "UTF-16LE", "UTF-8"));
@@ -417,6 +546,17 @@ string utf16be_to_utf8(const char16_t *wcs, int len)
 {
 	len = check_NULL_terminator(wcs, len);
 
+	// FAST PATH: ASCII text narrows to UTF-8 directly.
+#if SYS_BYTEORDER == SYS_BIG_ENDIAN
+	if (is_ascii_utf16(wcs, len, ASCII_UTF16_HOST_MASK)) {
+		return ascii_utf16_to_utf8(wcs, len, 0);
+	}
+#else /* SYS_BYTEORDER == SYS_LIL_ENDIAN */
+	if (is_ascii_utf16(wcs, len, ASCII_UTF16_SWAP_MASK)) {
+		return ascii_utf16_to_utf8(wcs, len, 8);
+	}
+#endif
+
 	// Attempt to convert the text from UTF-16BE to UTF-8.
 	string ret;
 	char *mbs = reinterpret_cast<char*>(rp_iconv((char*)wcs, len*sizeof(*wcs), "UTF-16BE", "UTF-8"));
@@ -9,6 +9,7 @@
 #include "config.librptext.h"
 #include "conversion.hpp"
 #include "NULL-check.hpp"
+#include "ascii_fastpath.hpp"
 
 #ifndef _WIN32
 #  error conversion_win32.cpp is for Windows only.
@@ -102,6 +103,14 @@ string cpN_to_utf8(unsigned int cp, const char *str, int len, unsigned int flags
 	}
 
 	len = check_NULL_terminator(str, len);
+
+	// FAST PATH: If the text is entirely ASCII, every code page we
+	// use maps it to UTF-8 unchanged, so skip the converter entirely.
+	// (The RP-custom code pages were already handled above.)
+	if (is_ascii(str, len)) {
+		return {str, static_cast<size_t>(len)};
+	}
+
 	DWORD dwFlags = 0;
 	if (flags & TEXTCONV_FLAG_CP1252_FALLBACK) {
 		// Fallback is enabled.
@@ -138,6 +147,38 @@ string cpN_to_utf8(unsigned int cp, const char *str, int len, unsigned int flags
 	return s_mbs;
 }
 
+/**
+ * Convert 8-bit text to UTF-8, reusing a caller-provided string.
+ * Trailing NULL bytes will be removed.
+ *
+ * The specified code page number will be used.
+ * The previous contents of the output string are replaced, but its
+ * allocated capacity is reused, so repeated conversions into the same
+ * string (e.g. per directory entry) don't reallocate.
+ *
+ * @param cp	[in] Code page number.
+ * @param str	[in] ANSI text.
+ * @param len	[in] Length of str, in bytes. (-1 for NULL-terminated string)
+ * @param out	[out] Output UTF-8 string. (cleared on error)
+ * @param flags	[in] Flags. (See TextConv_Flags_e.)
+ */
+void cpN_to_utf8(unsigned int cp, const char *str, int len, string &out, unsigned int flags)
+{
+	if (!(cp & CP_RP_BASE)) {
+		// FAST PATH: ASCII text can be assigned in-place,
+		// reusing the output string's capacity.
+		len = check_NULL_terminator(str, len);
+		if (is_ascii(str, len)) {
+			out.assign(str, static_cast<size_t>(len));
+			return;
+		}
+	}
+
+	// Non-ASCII text: Convert normally and move-assign the result.
+	// (MultiByteToWideChar() needs its own output buffer anyway.)
+	out = cpN_to_utf8(cp, str, len, flags);
+}
+
 /**
  * Convert 8-bit text to UTF-16.
  * Trailing NULL bytes will be removed.
@@ -153,6 +194,17 @@ string cpN_to_utf8(unsigned int cp, const char *str, int len, unsigned int flags
 u16string cpN_to_utf16(unsigned int cp, const char *str, int len, unsigned int flags)
 {
 	len = check_NULL_terminator(str, len);
+
+	// FAST PATH: ASCII text widens to UTF-16 directly.
+	if (is_ascii(str, len)) {
+		u16string ret;
+		ret.reserve(len);
+		for (int i = 0; i < len; i++) {
+			ret += static_cast<char16_t>(static_cast<uint8_t>(str[i]));
+		}
+		return ret;
+	}
+
 	DWORD dwFlags = 0;
 	if (flags & TEXTCONV_FLAG_CP1252_FALLBACK) {
 		// Fallback is enabled.
@@ -195,6 +247,11 @@ string utf8_to_cpN(unsigned int cp, const char *str, int len)
 {
 	len = check_NULL_terminator(str, len);
 
+	// FAST PATH: ASCII text is valid in every code page we use.
+	if (is_ascii(str, len)) {
+		return {str, static_cast<size_t>(len)};
+	}
+
 	// Convert from UTF-8 to UTF-16.
 	string s_mbs;
 	u16string s_wcs;
@@ -233,6 +290,12 @@ string utf16_to_cpN(unsigned int cp, const char16_t *wcs, int len)
 {
 	len = check_NULL_terminator(wcs, len);
 
+	// FAST PATH: ASCII text narrows to any of our code pages directly.
+	// (wcs is host-endian here; Windows is little-endian only.)
+	if (is_ascii_utf16(wcs, len, ASCII_UTF16_HOST_MASK)) {
+		return ascii_utf16_to_utf8(wcs, len, 0);
+	}
+
 	// Convert from UTF-16 to `cp`.
 	string s_mbs;
 	if (!W32U_UTF16_to_mbs(s_mbs, wcs, len, cp)) {
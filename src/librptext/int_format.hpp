@@ -0,0 +1,153 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librptext)                        *
+ * int_format.hpp: Direct integer-to-string formatting                     *
+ *                                                                         *
+ * Copyright (c) 2009-2024 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#pragma once
+
+#include "common.h"
+
+// C includes (C++ namespace)
+#include <cstdint>
+
+// C++ includes
+#include <string>
+#include <type_traits>
+
+namespace LibRpText {
+
+// The most common rp_sprintf() formats in field construction are
+// plain numbers ("%u", "%d") and fixed-width hexadecimal ("%08X",
+// "0x%08X"). These helpers generate the digits directly, with the
+// field width resolved at compile time where it's a template
+// parameter, so the hot paths skip printf format parsing and the
+// associated vsnprintf() buffer sizing pass entirely.
+
+// Hexadecimal lookup tables
+static constexpr char hexdig_upper[16] = {
+	'0','1','2','3','4','5','6','7',
+	'8','9','A','B','C','D','E','F',
+};
+static constexpr char hexdig_lower[16] = {
+	'0','1','2','3','4','5','6','7',
+	'8','9','a','b','c','d','e','f',
+};
+
+/**
+ * Format an unsigned integer as decimal, with zero-padding.
+ * Equivalent to rp_sprintf("%0*u", digits, val).
+ * @param val	[in] Value
+ * @param digits [in] Minimum number of digits (0 for no padding)
+ * @return Formatted string
+ */
+static inline std::string fmt_dec_pad(uint64_t val, unsigned int digits = 0)
+{
+	char buf[20];	// max uint64_t: 18446744073709551615
+	char *p = &buf[sizeof(buf)];
+	do {
+		*--p = '0' + static_cast<char>(val % 10);
+		val /= 10;
+	} while (val != 0);
+	while (digits > static_cast<unsigned int>(&buf[sizeof(buf)] - p) &&
+	       p != buf)
+	{
+		*--p = '0';
+	}
+	return {p, static_cast<size_t>(&buf[sizeof(buf)] - p)};
+}
+
+/**
+ * Format an unsigned integer as decimal.
+ * Equivalent to rp_sprintf("%u", val).
+ * @param val	[in] Value
+ * @return Formatted string
+ */
+template<typename T>
+static inline typename std::enable_if<std::is_unsigned<T>::value, std::string>::type
+fmt_dec(T val)
+{
+	return fmt_dec_pad(static_cast<uint64_t>(val), 0);
+}
+
+/**
+ * Format a signed integer as decimal.
+ * Equivalent to rp_sprintf("%d", val).
+ * @param val	[in] Value
+ * @return Formatted string
+ */
+template<typename T>
+static inline typename std::enable_if<std::is_signed<T>::value && std::is_integral<T>::value, std::string>::type
+fmt_dec(T val)
+{
+	if (val < 0) {
+		// NOTE: 0 - (uint64_t)val avoids signed overflow for INT64_MIN.
+		std::string ret(1, '-');
+		ret += fmt_dec_pad(0 - static_cast<uint64_t>(val), 0);
+		return ret;
+	}
+	return fmt_dec_pad(static_cast<uint64_t>(val), 0);
+}
+
+/**
+ * Format an unsigned integer as fixed-width hexadecimal.
+ * Equivalent to rp_sprintf("%0*X", digits, val).
+ * (More digits are printed if the value needs them.)
+ * @param val	[in] Value
+ * @param digits [in] Minimum number of digits (0 for no padding)
+ * @param lower	[in] If true, use lowercase hex digits
+ * @return Formatted string
+ */
+static inline std::string fmt_hex_pad(uint64_t val, unsigned int digits = 0, bool lower = false)
+{
+	const char *const tbl = (lower ? hexdig_lower : hexdig_upper);
+	char buf[16];	// max uint64_t: 16 hex digits
+	char *p = &buf[sizeof(buf)];
+	do {
+		*--p = tbl[val & 0x0F];
+		val >>= 4;
+	} while (val != 0);
+	while (digits > static_cast<unsigned int>(&buf[sizeof(buf)] - p) &&
+	       p != buf)
+	{
+		*--p = '0';
+	}
+	return {p, static_cast<size_t>(&buf[sizeof(buf)] - p)};
+}
+
+/**
+ * Format an unsigned integer as fixed-width hexadecimal,
+ * with the digit count as a template parameter.
+ * Equivalent to rp_sprintf("%08X", val) and variants.
+ * @tparam Digits Minimum number of digits
+ * @tparam Lower If true, use lowercase hex digits
+ * @param val	[in] Value
+ * @return Formatted string
+ */
+template<unsigned int Digits, bool Lower = false, typename T>
+static inline std::string fmt_hex(T val)
+{
+	static_assert(Digits <= 16, "fmt_hex() supports up to 16 digits.");
+	static_assert(std::is_unsigned<T>::value, "fmt_hex() requires an unsigned value.");
+	return fmt_hex_pad(static_cast<uint64_t>(val), Digits, Lower);
+}
+
+/**
+ * Format an unsigned integer as "0x"-prefixed fixed-width hexadecimal.
+ * Equivalent to rp_sprintf("0x%08X", val) and variants.
+ * @tparam Digits Minimum number of digits
+ * @tparam Lower If true, use lowercase hex digits
+ * @param val	[in] Value
+ * @return Formatted string
+ */
+template<unsigned int Digits, bool Lower = false, typename T>
+static inline std::string fmt_hex_0x(T val)
+{
+	std::string ret("0x");
+	ret += fmt_hex<Digits, Lower>(val);
+	return ret;
+}
+
+}
@@ -15,6 +15,7 @@
 
 // C includes (C++ namespace)
 #include <cassert>
+#include <cstring>
 
 // C++ STL classes
 using std::array;
@@ -23,17 +24,17 @@ using std::string;
 namespace LibRpText {
 
 /**
- * Convert 8-bit text to UTF-8 using a lookup table.
+ * Convert 8-bit text to UTF-8 using a precomputed UTF-8 expansion table.
  * Used by cpN_to_utf8 for RP-custom code pages.
  *
- * @param tbl	[in] 256-element decoding table (Only supports Unicode BMP)
+ * @param tbl	[in] UTF-8 expansion table (Only supports Unicode BMP)
  * @param str	[in] 8-bit text
  * @param len	[in] Length of str, in bytes (-1 for NULL-terminated string)
- * @return UTF-8 string.
+ * @param s_utf8	[out] Output UTF-8 string (contents are replaced)
  */
-static string str8_to_utf8(const array<char16_t, 256>& tbl, const char *str, int len)
+static void str8_to_utf8(const CodePageTables::utf8_exp_tbl_t &tbl, const char *str, int len, string &s_utf8)
 {
-	string s_utf8;
+	s_utf8.clear();
 
 	// NOTE: We can't use check_NULL_terminator here because
 	// 0x00 may be a valid character in some cases.
@@ -42,7 +43,7 @@ static string str8_to_utf8(const array<char16_t, 256>& tbl, const char *str, int
 		len = static_cast<int>(strlen(str));
 	} else if (unlikely(len == 0)) {
 		// Shouldn't happen...
-		return s_utf8;
+		return;
 	} else {
 		// Explicit length.
 		// Search for NULLs starting at the end of the string.
@@ -58,29 +59,25 @@ static string str8_to_utf8(const array<char16_t, 256>& tbl, const char *str, int
 
 	if (len <= 0) {
 		// Nothing to do...
-		return s_utf8;
+		return;
 	}
 
-	s_utf8.reserve(len + 8);
+	// Pre-size the buffer for the worst case. (3 bytes per input byte)
+	// Each input byte is converted with a single unconditional 4-byte
+	// store of its precomputed UTF-8 expansion; the write pointer only
+	// advances by the encoded length, so the extra bytes are
+	// overwritten by the next character (or trimmed at the end).
+	s_utf8.resize(static_cast<size_t>(len) * 3);
+	char *dest = &s_utf8[0];
 	for (; len > 0; str++, len--) {
 		// NOTE: The (uint8_t) cast is required.
 		// Otherwise, *str is interpreted as a signed char,
 		// which causes all sorts of shenanigans.
-		const char16_t ch16 = tbl[(uint8_t)*str];
-		// NOTE: Masks for the first byte might not be needed...
-		if (ch16 < 0x0080) {
-			s_utf8 += (char)(ch16 & 0x7F);
-		} else if (ch16 < 0x0800) {
-			s_utf8 += (char)(0xC0 | ((ch16 >>  6) & 0x1F));
-			s_utf8 += (char)(0x80 | ((ch16 >>  0) & 0x3F));
-		} else /*if (ch16 < 0x10000)*/ {
-			s_utf8 += (char)(0xE0 | ((ch16 >> 12) & 0x0F));
-			s_utf8 += (char)(0x80 | ((ch16 >>  6) & 0x3F));
-			s_utf8 += (char)(0x80 | ((ch16 >>  0) & 0x3F));
-		}
+		const uint8_t *const entry = tbl.entries[(uint8_t)*str];
+		memcpy(dest, entry, 3);
+		dest += entry[3];
 	}
-
-	return s_utf8;
+	s_utf8.resize(dest - s_utf8.data());
 }
 
 /**
@@ -93,17 +90,38 @@ static string str8_to_utf8(const array<char16_t, 256>& tbl, const char *str, int
  * @return UTF-8 string.
  */
 std::string cpRP_to_utf8(unsigned int cp, const char *str, int len)
+{
+	string ret;
+	cpRP_to_utf8(cp, str, len, ret);
+	return ret;
+}
+
+/**
+ * Convert 8-bit text to UTF-8 using an RP-custom code page,
+ * reusing a caller-provided string.
+ * Code page number must be CP_RP_*.
+ *
+ * @param cp	[in] Code page number.
+ * @param str	[in] 8-bit text.
+ * @param len	[in] Length of str, in bytes. (-1 for NULL-terminated string)
+ * @param out	[out] Output UTF-8 string. (cleared on error)
+ */
+void cpRP_to_utf8(unsigned int cp, const char *str, int len, string &out)
 {
 	assert(cp & CP_RP_BASE);
-	if (!(cp & CP_RP_BASE))
-		return {};
+	if (!(cp & CP_RP_BASE)) {
+		out.clear();
+		return;
+	}
 
 	cp &= ~CP_RP_BASE;
-	assert(cp < CodePageTables::lkup_tbls.size());
-	if (cp >= CodePageTables::lkup_tbls.size())
-		return {};
+	assert(cp < CodePageTables::utf8_exp_tbls.size());
+	if (cp >= CodePageTables::utf8_exp_tbls.size()) {
+		out.clear();
+		return;
+	}
 
-	return str8_to_utf8(*(CodePageTables::lkup_tbls[cp]), str, len);
+	str8_to_utf8(*(CodePageTables::utf8_exp_tbls[cp]), str, len, out);
 }
 
 }
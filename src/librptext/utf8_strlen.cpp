@@ -8,6 +8,7 @@
 
 #include "config.librptext.h"
 #include "utf8_strlen.hpp"
+#include "ascii_fastpath.hpp"
 #include "common.h"
 
 // C includes
@@ -24,6 +25,47 @@
 
 namespace LibRpText {
 
+/**
+ * Count the length of the leading run of non-NUL ASCII bytes.
+ * Vectorized using SSE2 where available; otherwise, eight bytes
+ * are checked at a time using 64-bit masks. On a mismatch, the
+ * scan stops early and the scalar tail finds the exact boundary.
+ * @param str		[in] UTF-8 string
+ * @param max_len	[in] Maximum length to check
+ * @return Length of the leading ASCII run, in bytes.
+ */
+static inline size_t ascii_run_len(const uint8_t *str, size_t max_len)
+{
+	const uint8_t *p = str;
+
+#ifdef RP_TEXT_HAS_SSE2
+	const __m128i vzero = _mm_setzero_si128();
+	for (; max_len >= 16; p += 16, max_len -= 16) {
+		const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+		if ((_mm_movemask_epi8(chunk) |
+		     _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, vzero))) != 0)
+		{
+			// Found a non-ASCII or NUL byte in this chunk.
+			break;
+		}
+	}
+#endif /* RP_TEXT_HAS_SSE2 */
+
+	for (; max_len >= 8; p += 8, max_len -= 8) {
+		uint64_t v;
+		memcpy(&v, p, sizeof(v));
+		if ((v & 0x8080808080808080ULL) != 0 ||
+		    (((v - 0x0101010101010101ULL) & ~v) & 0x8080808080808080ULL) != 0)
+		{
+			// Found a non-ASCII or NUL byte in this chunk.
+			break;
+		}
+	}
+
+	for (; max_len > 0 && *p != 0 && !(*p & 0x80); p++, max_len--) { }
+	return static_cast<size_t>(p - str);
+}
+
 /**
  * Determine the display length of a UTF-8 string.
  * This is used for monospaced console/text output only.
@@ -40,7 +82,16 @@ size_t utf8_disp_strlen(const char *str, size_t max_len)
 	     *u8str != 0 && max_len > 0; u8str++, max_len--) {
 		if (!(u8str[0] & 0x80)) {
 			// 1-byte UTF-8 sequence
-			uchr = u8str[0];
+			// Count the entire ASCII run at once. Every ASCII byte
+			// has a display width of 1 here: wcwidth() returns 1 for
+			// printable ASCII, and control characters get -1, which
+			// the fallback below also counts as 1.
+			const size_t run = ascii_run_len(u8str, max_len);
+			len += run;
+			// The loop increment handles the last byte of the run.
+			u8str += (run - 1);
+			max_len -= (run - 1);
+			continue;
 		} else if ((u8str[0] & 0xE0) == 0xC0) {
 			// 2-byte UTF-8 sequence
 			if ((u8str[1] & 0xC0) == 0x80) {
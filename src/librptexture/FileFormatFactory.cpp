@@ -19,10 +19,12 @@ using namespace LibRpBase;
 using namespace LibRpFile;
 
 // librpthreads
-#include "librpthreads/pthread_once.h"
+#include "librpthreads/rp_once.h"
 
 // C++ STL classes
+#include <unordered_map>
 using std::string;
+using std::unordered_map;
 using std::unordered_set;
 using std::vector;
 
@@ -88,72 +90,123 @@ class FileFormatFactoryPrivate
 
 		// FileFormat subclasses that use a header at 0 and
 		// definitely have a 32-bit magic number at address 0.
-		static const FileFormatFns FileFormatFns_magic[];
+		// NOTE: constexpr, so the table is resolved at compile time
+		// and doesn't require any initialization at load time.
+		// TODO: Add support for multiple magic numbers per class.
+		static constexpr FileFormatFns FileFormatFns_magic[] = {
+			GetFileFormatFns(ASTC, 0x13ABA15C),	// Needs to be in multi-char constant format.
+			GetFileFormatFns(DirectDrawSurface, 'DDS '),
+			GetFileFormatFns(GodotSTEX, 'GDST'),
+			GetFileFormatFns(GodotSTEX, 'GST2'),
+			GetFileFormatFns(PowerVR3, 'PVR\x03'),
+			GetFileFormatFns(PowerVR3, '\x03RVP'),
+			GetFileFormatFns(SegaPVR, 'PVRT'),
+			GetFileFormatFns(SegaPVR, 'GVRT'),
+			GetFileFormatFns(SegaPVR, 'PVRX'),
+			GetFileFormatFns(SegaPVR, 'GBIX'),
+			GetFileFormatFns(SegaPVR, 'GCIX'),
+			GetFileFormatFns(ValveVTF, 'VTF\0'),
+			GetFileFormatFns(ValveVTF3, 'VTF3'),
+			GetFileFormatFns(XboxXPR, 'XPR0'),
+
+			// Less common formats.
+			GetFileFormatFns(DidjTex, (uint32_t)0x03000000),
+
+			{nullptr, nullptr, 0}
+		};
 
 		// FileFormat subclasses that have special checks.
 		// This array is for file extensions and MIME types only.
-		static const FileFormatFns FileFormatFns_mime[];
+		static constexpr FileFormatFns FileFormatFns_mime[] = {
+			GetFileFormatFns(KhronosKTX, 0),
+			GetFileFormatFns(KhronosKTX2, 0),
+			GetFileFormatFns(TGA, 0),
+
+			{nullptr, nullptr, 0}
+		};
+
+		/** Magic number lookup map **/
+		// Maps the 32-bit magic number (host-endian) to its
+		// FileFormatFns_magic[] entry, so create() does a hash
+		// lookup instead of a linear scan over every format.
+		// NOTE: Cached, using rp_once().
+		static unordered_map<uint32_t, const FileFormatFns*> map_magic;
+		static rp_once_t once_magic;
+
+		/**
+		 * Initialize the magic number lookup map.
+		 *
+		 * Internal function; must be called using rp_once().
+		 */
+		static void init_magicMap(void);
 
 #ifdef FILEFORMATFACTORY_USE_FILE_EXTENSIONS
 		/** Supported file extensions **/
-		// NOTE: Cached, using pthread_once().
+		// NOTE: Cached, using rp_once().
 		static vector<const char*> vec_exts;
-		static pthread_once_t once_exts;
+		static rp_once_t once_exts;
 #endif /* FILEFORMATFACTORY_USE_FILE_EXTENSIONS */
 
+#ifdef FILEFORMATFACTORY_USE_MIME_TYPES
+		/** Supported MIME types **/
+		// NOTE: Cached, using rp_once().
+		static vector<const char*> vec_mimeTypes;
+		static rp_once_t once_mimeTypes;
+#endif /* FILEFORMATFACTORY_USE_MIME_TYPES */
+
 		/**
 		 * Initialize the vector of supported file extensions.
 		 * Used for Win32 COM registration.
 		 *
-		 * Internal function; must be called using pthread_once().
+		 * Internal function; must be called using rp_once().
 		 *
 		 * NOTE: The return value is a struct that includes a flag
 		 * indicating if the file type handler supports thumbnails.
 		 */
 		static void init_supportedFileExtensions(void);
+
+#ifdef FILEFORMATFACTORY_USE_MIME_TYPES
+		/**
+		 * Initialize the vector of supported MIME types.
+		 * Used for KFileMetaData.
+		 *
+		 * Internal function; must be called using rp_once().
+		 */
+		static void init_supportedMimeTypes(void);
+#endif /* FILEFORMATFACTORY_USE_MIME_TYPES */
 };
 
 /** FileFormatFactoryPrivate **/
 
+unordered_map<uint32_t, const FileFormatFactoryPrivate::FileFormatFns*> FileFormatFactoryPrivate::map_magic;
+rp_once_t FileFormatFactoryPrivate::once_magic = RP_ONCE_INIT;
+
 #ifdef FILEFORMATFACTORY_USE_FILE_EXTENSIONS
 vector<const char*> FileFormatFactoryPrivate::vec_exts;
-pthread_once_t FileFormatFactoryPrivate::once_exts = PTHREAD_ONCE_INIT;
+rp_once_t FileFormatFactoryPrivate::once_exts = RP_ONCE_INIT;
 #endif /* FILEFORMATFACTORY_USE_FILE_EXTENSIONS */
 
-// FileFormat subclasses that use a header at 0 and
-// definitely have a 32-bit magic number at address 0.
-// TODO: Add support for multiple magic numbers per class.
-const FileFormatFactoryPrivate::FileFormatFns FileFormatFactoryPrivate::FileFormatFns_magic[] = {
-	GetFileFormatFns(ASTC, 0x13ABA15C),	// Needs to be in multi-char constant format.
-	GetFileFormatFns(DirectDrawSurface, 'DDS '),
-	GetFileFormatFns(GodotSTEX, 'GDST'),
-	GetFileFormatFns(GodotSTEX, 'GST2'),
-	GetFileFormatFns(PowerVR3, 'PVR\x03'),
-	GetFileFormatFns(PowerVR3, '\x03RVP'),
-	GetFileFormatFns(SegaPVR, 'PVRT'),
-	GetFileFormatFns(SegaPVR, 'GVRT'),
-	GetFileFormatFns(SegaPVR, 'PVRX'),
-	GetFileFormatFns(SegaPVR, 'GBIX'),
-	GetFileFormatFns(SegaPVR, 'GCIX'),
-	GetFileFormatFns(ValveVTF, 'VTF\0'),
-	GetFileFormatFns(ValveVTF3, 'VTF3'),
-	GetFileFormatFns(XboxXPR, 'XPR0'),
-
-	// Less common formats.
-	GetFileFormatFns(DidjTex, (uint32_t)0x03000000),
-
-	{nullptr, nullptr, 0}
-};
+#ifdef FILEFORMATFACTORY_USE_MIME_TYPES
+vector<const char*> FileFormatFactoryPrivate::vec_mimeTypes;
+rp_once_t FileFormatFactoryPrivate::once_mimeTypes = RP_ONCE_INIT;
+#endif /* FILEFORMATFACTORY_USE_MIME_TYPES */
 
-// FileFormat subclasses that have special checks.
-// This array is for file extensions and MIME types only.
-const FileFormatFactoryPrivate::FileFormatFns FileFormatFactoryPrivate::FileFormatFns_mime[] = {
-	GetFileFormatFns(KhronosKTX, 0),
-	GetFileFormatFns(KhronosKTX2, 0),
-	GetFileFormatFns(TGA, 0),
+/**
+ * Initialize the magic number lookup map.
+ *
+ * Internal function; must be called using rp_once().
+ */
+void FileFormatFactoryPrivate::init_magicMap(void)
+{
+	// All magic numbers in FileFormatFns_magic[] are unique,
+	// so a plain unordered_map works here.
+	map_magic.reserve(ARRAY_SIZE(FileFormatFns_magic) - 1);
 
-	{nullptr, nullptr, 0}
-};
+	const FileFormatFns *fns = &FileFormatFns_magic[0];
+	for (; fns->textureInfo != nullptr; fns++) {
+		map_magic.emplace(fns->magic, fns);
+	}
+}
 
 /** FileFormatFactory **/
 
@@ -284,19 +337,19 @@ FileFormatPtr FileFormatFactory::create(const IRpFilePtr &file)
 
 	// Check FileFormat subclasses that take a header at 0
 	// and definitely have a 32-bit magic number at address 0.
-	const FileFormatFactoryPrivate::FileFormatFns *fns =
-		&FileFormatFactoryPrivate::FileFormatFns_magic[0];
-	for (; fns->textureInfo != nullptr; fns++) {
-		// Check the magic number.
-		if (magic.u32[0] == fns->magic) {
-			// Found a matching magic number.
-			// TODO: Implement fns->isTextureSupported.
-			/*if (fns->isTextureSupported(&info) >= 0)*/ {
-				FileFormatPtr fileFormat = fns->newFileFormat(file);
-				if (fileFormat->isValid()) {
-					// FileFormat subclass obtained.
-					return FileFormatPtr(fileFormat);
-				}
+	// The magic numbers are indexed in a hash map, so this is
+	// a single lookup instead of a scan over every format.
+	rp_once(&FileFormatFactoryPrivate::once_magic, FileFormatFactoryPrivate::init_magicMap);
+	auto iter = FileFormatFactoryPrivate::map_magic.find(magic.u32[0]);
+	if (iter != FileFormatFactoryPrivate::map_magic.end()) {
+		// Found a matching magic number.
+		const FileFormatFactoryPrivate::FileFormatFns *const fns = iter->second;
+		// TODO: Implement fns->isTextureSupported.
+		/*if (fns->isTextureSupported(&info) >= 0)*/ {
+			FileFormatPtr fileFormat = fns->newFileFormat(file);
+			if (fileFormat->isValid()) {
+				// FileFormat subclass obtained.
+				return FileFormatPtr(fileFormat);
 			}
 		}
 	}
@@ -310,7 +363,7 @@ FileFormatPtr FileFormatFactory::create(const IRpFilePtr &file)
  * Initialize the vector of supported file extensions.
  * Used for Win32 COM registration.
  *
- * Internal function; must be called using pthread_once().
+ * Internal function; must be called using rp_once().
  *
  * NOTE: The return value is a struct that includes a flag
  * indicating if the file type handler supports thumbnails.
@@ -371,19 +424,19 @@ void FileFormatFactoryPrivate::init_supportedFileExtensions(void)
  */
 const vector<const char*> &FileFormatFactory::supportedFileExtensions(void)
 {
-	pthread_once(&FileFormatFactoryPrivate::once_exts, FileFormatFactoryPrivate::init_supportedFileExtensions);
+	rp_once(&FileFormatFactoryPrivate::once_exts, FileFormatFactoryPrivate::init_supportedFileExtensions);
 	return FileFormatFactoryPrivate::vec_exts;
 }
 #endif /* FILEFORMATFACTORY_USE_FILE_EXTENSIONS */
 
 #ifdef FILEFORMATFACTORY_USE_MIME_TYPES
 /**
- * Get all supported MIME types.
+ * Initialize the vector of supported MIME types.
  * Used for KFileMetaData.
  *
- * @return All supported MIME types.
+ * Internal function; must be called using rp_once().
  */
-vector<const char*> FileFormatFactory::supportedMimeTypes(void)
+void FileFormatFactoryPrivate::init_supportedMimeTypes(void)
 {
 	// TODO: Add generic types, e.g. application/octet-stream?
 
@@ -391,7 +444,6 @@ vector<const char*> FileFormatFactory::supportedMimeTypes(void)
 	// that support the same MIME types, we're using
 	// an unordered_set<string>. The actual data
 	// is stored in the vector<const char*>.
-	vector<const char*> vec_mimeTypes;
 	unordered_set<string> set_mimeTypes;
 
 	static constexpr size_t reserve_size = ARRAY_SIZE(FileFormatFactoryPrivate::FileFormatFns_magic) * 2;
@@ -431,8 +483,18 @@ vector<const char*> FileFormatFactory::supportedMimeTypes(void)
 			}
 		}
 	}
+}
 
-	return vec_mimeTypes;
+/**
+ * Get all supported MIME types.
+ * Used for KFileMetaData.
+ *
+ * @return All supported MIME types.
+ */
+const vector<const char*> &FileFormatFactory::supportedMimeTypes(void)
+{
+	rp_once(&FileFormatFactoryPrivate::once_mimeTypes, FileFormatFactoryPrivate::init_supportedMimeTypes);
+	return FileFormatFactoryPrivate::vec_mimeTypes;
 }
 #endif /* FILEFORMATFACTORY_USE_MIME_TYPES */
 
@@ -74,7 +74,7 @@ public:
 	 *
 	 * @return All supported MIME types.
 	 */
-	static std::vector<const char*> supportedMimeTypes(void);
+	static const std::vector<const char*> &supportedMimeTypes(void);
 #endif /* FILEFORMATFACTORY_USE_MIME_TYPES */
 };
 
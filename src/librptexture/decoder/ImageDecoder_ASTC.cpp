@@ -102,9 +102,18 @@ rp_image_ptr fromASTC(int width, int height,
 #  else
 #    define SHARED_OMP5(x)
 #  endif
-#pragma omp parallel for default(none) shared(img_buf, bErr) SHARED_OMP5(pDestBits) firstprivate(block_x, block_y, tilesX, tilesY, bytesPerTileRow, stride_px)
+// NOTE: Using dynamic scheduling because ASTC decode time varies
+// significantly depending on the block mode and partition count.
+#pragma omp parallel for schedule(dynamic) default(none) shared(img_buf, bErr) SHARED_OMP5(pDestBits) firstprivate(block_x, block_y, tilesX, tilesY, bytesPerTileRow, stride_px)
 #endif /* _OPENMP */
 	for (int y = 0; y < tilesY; y++) {
+#ifdef _OPENMP
+		if (bErr) {
+			// A decompression error occurred in another tile row.
+			// Skip the remaining rows.
+			continue;
+		}
+#endif /* _OPENMP */
 		const uint8_t *pSrc = &img_buf[y * bytesPerTileRow];
 		for (int x = 0; x < tilesX; x++, pSrc += 16) {
 			// Temporary tile buffer
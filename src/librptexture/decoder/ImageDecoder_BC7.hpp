@@ -21,6 +21,7 @@ namespace LibRpTexture { namespace ImageDecoder {
  * @return rp_image, or nullptr on error.
  */
 ATTR_ACCESS_SIZE(read_only, 3, 4)
+RP_LIBROMDATA_PUBLIC
 rp_image_ptr fromBC7(int width, int height,
 	const uint8_t *img_buf, size_t img_siz);
 
@@ -20,7 +20,7 @@ using namespace LibRpTexture::PixelConversion;
 using std::unique_ptr;
 
 // One-time initialization.
-#include "librpthreads/pthread_once.h"
+#include "librpthreads/rp_once.h"
 
 namespace LibRpTexture { namespace ImageDecoder {
 
@@ -33,14 +33,14 @@ namespace LibRpTexture { namespace ImageDecoder {
 #define DC_TMAP_SIZE 4096
 static unique_ptr<unsigned int[]> dc_tmap;
 
-// pthread_once() control variable.
-static pthread_once_t dc_tmap_once_control = PTHREAD_ONCE_INIT;
+// rp_once() control variable.
+static rp_once_t dc_tmap_once_control = RP_ONCE_INIT;
 
 /**
  * Initialize the Dreamcast twiddle map.
  * This initializes dc_tmap[].
  *
- * This function MUST be called using pthread_once().
+ * This function MUST be called using rp_once().
  */
 static void initDreamcastTwiddleMap_int(void)
 {
@@ -61,7 +61,7 @@ static void initDreamcastTwiddleMap_int(void)
  */
 static FORCEINLINE void initDreamcastTwiddleMap(void)
 {
-	pthread_once(&dc_tmap_once_control, initDreamcastTwiddleMap_int);
+	rp_once(&dc_tmap_once_control, initDreamcastTwiddleMap_int);
 }
 
 /**
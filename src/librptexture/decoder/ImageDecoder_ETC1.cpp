@@ -522,6 +522,22 @@ static void decodeBlock_ETC_RGB(array<uint32_t, 4*4> &tileBuf, const etc1_block
 				tbl[1] = etc1_intensity[(etc1_src->control >> 2) & 0x07];
 			}
 
+			// Precompute the modified colors.
+			// Only 8 combinations are possible per block
+			// (2 subblocks * 4 pixel indexes), so adjust and
+			// clamp those once instead of once per pixel.
+			uint32_t px_color[2][4];
+			for (unsigned int sub = 0; sub < 2; sub++) {
+				for (unsigned int px_idx = 0; px_idx < 4; px_idx++) {
+					const int adj = tbl[sub][px_idx];
+					ColorRGB color = base_color[sub];
+					color.R += adj;
+					color.G += adj;
+					color.B += adj;
+					px_color[sub][px_idx] = clamp_ColorRGB(color);
+				}
+			}
+
 			// control, bit 0: flip
 			uint16_t subblock = etc1_subblock_mapping[etc1_src->control & 0x01];
 			for (unsigned int i = 0; i < 16; i++, px_msb >>= 1, px_lsb >>= 1, subblock >>= 1) {
@@ -537,16 +553,9 @@ static void decodeBlock_ETC_RGB(array<uint32_t, 4*4> &tileBuf, const etc1_block
 					}
 				}
 
-				// Select the table codeword based on the current subblock.
-				const uint8_t cur_sub = subblock & 1;
-				const int adj = tbl[cur_sub][px_idx];
-				ColorRGB color = base_color[cur_sub];
-				color.R += adj;
-				color.G += adj;
-				color.B += adj;
-
-				// Clamp the color components and save it to the tile buffer.
-				*p = clamp_ColorRGB(color);
+				// Select the precomputed color based on the
+				// current subblock and pixel index.
+				*p = px_color[subblock & 1][px_idx];
 			}
 			break;
 		}
@@ -757,24 +766,30 @@ static void T_decodeBlock_EAC(array<uint32_t, 4*4> &tileBuf, const etc2_alpha *a
 
 	// TODO: Zero out the alpha channel in the entire tile using SIMD.
 
-	// Pixel index.
-	uint64_t alpha48 = extract48(alpha);
-
-	// NOTE: EAC codeword bits are stored *backwards*.
-	// TODO: Optimize to eliminate double-shifting.
+	// Precompute the alpha values for all 8 codewords.
+	// This only needs 8 multiply+clamp operations per block
+	// instead of 16.
+	// NOTE: For EAC, this is an 11-bit value that must be truncated to 8-bit.
 	// TODO: For R11/RG11 EAC, this should result in an 11-bit value, not 8-bit.
-	for (unsigned int i = 0; i < 16; i++, alpha48 <<= 3) {
-		// Calculate the alpha value for this pixel.
-		int A = base + (tbl[(alpha48 >> 45) & 0x07] * mult);
-		// NOTE: For EAC, this is an 11-bit value that must be truncated to 8-bit.
+	uint8_t alpha_lut[8];
+	for (unsigned int i = 0; i < 8; i++) {
+		int A = base + (tbl[i] * mult);
 		if (A > 255) {
 			A = 255;
 		} else if (A < 0) {
 			A = 0;
 		}
+		alpha_lut[i] = static_cast<uint8_t>(A);
+	}
 
+	// Pixel index.
+	uint64_t alpha48 = extract48(alpha);
+
+	// NOTE: EAC codeword bits are stored *backwards*.
+	// TODO: Optimize to eliminate double-shifting.
+	for (unsigned int i = 0; i < 16; i++, alpha48 <<= 3) {
 		// Set the new alpha value.
-		pU8[(etc1_mapping[i] * sizeof(uint32_t)) + byteOffset] = static_cast<uint8_t>(A);
+		pU8[(etc1_mapping[i] * sizeof(uint32_t)) + byteOffset] = alpha_lut[(alpha48 >> 45) & 0x07];
 	}
 }
 
@@ -10,6 +10,9 @@
 #include "stdafx.h"
 #include "ImageDecoder_Linear.hpp"
 
+// Tracing instrumentation
+#include "rp_trace.h"
+
 // librptexture
 #include "ImageSizeCalc.hpp"
 #include "img/rp_image.hpp"
@@ -37,6 +40,8 @@ rp_image_ptr fromLinearCI4(PixelFormat px_format, bool msn_left,
 	const void *RESTRICT pal_buf, size_t pal_siz,
 	int stride)
 {
+	RP_TRACE_SCOPE("ImageDecoder::fromLinearCI4");
+
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(pal_buf != nullptr);
@@ -296,6 +301,8 @@ rp_image_ptr fromLinearCI8(PixelFormat px_format,
 	const void *RESTRICT pal_buf, size_t pal_siz,
 	int stride)
 {
+	RP_TRACE_SCOPE("ImageDecoder::fromLinearCI8");
+
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(pal_buf != nullptr);
@@ -618,6 +625,8 @@ rp_image_ptr fromLinear8(PixelFormat px_format,
 	int width, int height,
 	const uint8_t *RESTRICT img_buf, size_t img_siz, int stride)
 {
+	RP_TRACE_SCOPE("ImageDecoder::fromLinear8");
+
 	static constexpr int bytespp = 1;
 
 	// Verify parameters.
@@ -718,6 +727,8 @@ rp_image_ptr fromLinear16_cpp(PixelFormat px_format,
 	int width, int height,
 	const uint16_t *RESTRICT img_buf, size_t img_siz, int stride)
 {
+	RP_TRACE_SCOPE("ImageDecoder::fromLinear16");
+
 	static constexpr int bytespp = 2;
 
 	// Verify parameters.
@@ -834,6 +845,8 @@ rp_image_ptr fromLinear24_cpp(PixelFormat px_format,
 	int width, int height,
 	const uint8_t *RESTRICT img_buf, size_t img_siz, int stride)
 {
+	RP_TRACE_SCOPE("ImageDecoder::fromLinear24");
+
 	static constexpr int bytespp = 3;
 
 	// Verify parameters.
@@ -933,6 +946,8 @@ rp_image_ptr fromLinear32_cpp(PixelFormat px_format,
 	int width, int height,
 	const uint32_t *RESTRICT img_buf, size_t img_siz, int stride)
 {
+	RP_TRACE_SCOPE("ImageDecoder::fromLinear32");
+
 	static constexpr int bytespp = sizeof(uint32_t);
 
 	// Verify parameters.
@@ -38,6 +38,7 @@ rp_image_ptr fromDXT1_GCN(int width, int height,
  * @return rp_image, or nullptr on error.
  */
 ATTR_ACCESS_SIZE(read_only, 3, 4)
+RP_LIBROMDATA_PUBLIC
 rp_image_ptr fromDXT1(int width, int height,
 	const uint8_t *RESTRICT img_buf, size_t img_siz);
 
@@ -100,6 +101,7 @@ rp_image_ptr fromDXT4(int width, int height,
  * @return rp_image, or nullptr on error.
  */
 ATTR_ACCESS_SIZE(read_only, 3, 4)
+RP_LIBROMDATA_PUBLIC
 rp_image_ptr fromDXT5(int width, int height,
 	const uint8_t *RESTRICT img_buf, size_t img_siz);
 
@@ -114,6 +116,7 @@ rp_image_ptr fromDXT5(int width, int height,
  * @return rp_image, or nullptr on error.
  */
 ATTR_ACCESS_SIZE(read_only, 3, 4)
+RP_LIBROMDATA_PUBLIC
 rp_image_ptr fromBC4(int width, int height,
 	const uint8_t *RESTRICT img_buf, size_t img_siz);
 
@@ -128,6 +131,7 @@ rp_image_ptr fromBC4(int width, int height,
  * @return rp_image, or nullptr on error.
  */
 ATTR_ACCESS_SIZE(read_only, 3, 4)
+RP_LIBROMDATA_PUBLIC
 rp_image_ptr fromBC5(int width, int height,
 	const uint8_t *RESTRICT img_buf, size_t img_siz);
 
@@ -26,6 +26,7 @@
 #  include "librpcpuid/cpuflags_x86.h"
 #  define IMAGEDECODER_HAS_SSE2 1
 #  define IMAGEDECODER_HAS_SSSE3 1
+#  define IMAGEDECODER_HAS_AVX2 1
 #endif
 #ifdef RP_CPU_AMD64
 #  define IMAGEDECODER_ALWAYS_HAS_SSE2 1
@@ -318,10 +318,13 @@ static inline constexpr uint32_t ARGB8332_to_ARGB32(uint16_t px16)
 {
 	// ARGB8332: AAAAAAAA RRRGGGBB
 	// ARGB32:   AAAAAAAA RRRRRRRR GGGGGGGG BBBBBBBB
-	return (c3_lookup[(px16 >> 5) & 7] << 16) |	// Red
-	       (c3_lookup[(px16 >> 2) & 7] <<  8) |	// Green
-	       (c2_lookup[ px16       & 3]      ) |	// Blue
-	       ((px16 << 16) & 0xFF000000);		// Alpha
+	// NOTE: 3-bit components are expanded by multiplication
+	// ((v * 0x49) >> 1 == bit replication) instead of table
+	// lookups so scanline loops can be auto-vectorized.
+	return (((((px16 >> 5) & 7) * 0x49U) >> 1) << 16) |	// Red
+	       (((((px16 >> 2) & 7) * 0x49U) >> 1) <<  8) |	// Green
+	       (( (px16        & 3) * 0x55U)             ) |	// Blue
+	       ((px16 << 16) & 0xFF000000);			// Alpha
 }
 
 /**
@@ -358,31 +361,30 @@ static inline uint32_t GR88_to_ARGB32(uint16_t px16)
  */
 static inline uint32_t RGB5A3_to_ARGB32(uint16_t px16)
 {
-	// px16 high bit: if set, no alpha channel
-	uint32_t px32 = (px16 & 0x8000U)
-		? 0xFF000000U
-		: 0;
-
-	if (px16 & 0x8000) {
-		// RGB555: xRRRRRGG GGGBBBBB
-		// ARGB32: AAAAAAAA RRRRRRRR GGGGGGGG BBBBBBBB
-		px32 |= ((px16 << 3) & 0x0000F8);	// Blue
-		px32 |= ((px16 << 6) & 0x00F800);	// Green
-		px32 |= ((px16 << 9) & 0xF80000);	// Red
-		px32 |= ((px32 >> 5) & 0x070707);	// Expand from 5-bit to 8-bit
-	} else {
-		// RGB4A3: xAAARRRR GGGGBBBB
-		// ARGB32: AAAAAAAA RRRRRRRR GGGGGGGG BBBBBBBB
-		px32  =  (px16 & 0x000F);	// Blue
-		px32 |= ((px16 & 0x00F0) << 4);	// Green
-		px32 |= ((px16 & 0x0F00) << 8);	// Red
-		px32 |= (px32 << 4);		// Copy to the top nybble.
+	// NOTE: Both interpretations are computed and selected with
+	// the high bit so scanline loops can be auto-vectorized.
+	// The branchy version serialized every pixel.
 
-		// Calculate and apply the alpha channel.
-		px32 |= a3_lookup[((px16 >> 12) & 0x07)];
-	}
+	// High bit set: RGB555, no alpha channel.
+	// RGB555: xRRRRRGG GGGBBBBB
+	// ARGB32: AAAAAAAA RRRRRRRR GGGGGGGG BBBBBBBB
+	uint32_t px555 = 0xFF000000U;
+	px555 |= ((px16 << 3) & 0x0000F8);	// Blue
+	px555 |= ((px16 << 6) & 0x00F800);	// Green
+	px555 |= ((px16 << 9) & 0xF80000);	// Red
+	px555 |= ((px555 >> 5) & 0x070707);	// Expand from 5-bit to 8-bit
+
+	// High bit clear: RGB4A3, 3-bit alpha channel.
+	// RGB4A3: xAAARRRR GGGGBBBB
+	// ARGB32: AAAAAAAA RRRRRRRR GGGGGGGG BBBBBBBB
+	uint32_t px4a3 = (px16 & 0x000F);	// Blue
+	px4a3 |= ((px16 & 0x00F0) << 4);	// Green
+	px4a3 |= ((px16 & 0x0F00) << 8);	// Red
+	px4a3 |= (px4a3 << 4);			// Copy to the top nybble.
+	// Calculate and apply the alpha channel. (bit replication)
+	px4a3 |= ((((px16 >> 12) & 0x07) * 0x49U) >> 1) << 24;
 
-	return px32;
+	return (px16 & 0x8000U) ? px555 : px4a3;
 }
 
 /**
@@ -437,32 +439,30 @@ static inline uint32_t RGB565_A4_to_ARGB32(uint16_t px16, uint8_t a4)
  */
 static inline uint32_t BGR5A3_to_ARGB32(uint16_t px16)
 {
-	// px16 high bit: if set, no alpha channel
-	uint32_t px32 = (px16 & 0x8000U)
-		? 0xFF000000U
-		: 0;
-
-	if (px16 & 0x8000) {
-		// BGR555: xBBBBBGG GGGRRRRR
-		// ARGB32: AAAAAAAA RRRRRRRR GGGGGGGG BBBBBBBB
-		px32  = 0xFF000000U;	// no alpha channel
-		px32 |= ((px16 >>  7) & 0x0000F8);	// Blue
-		px32 |= ((px16 <<  6) & 0x00F800);	// Green
-		px32 |= ((px16 << 19) & 0xF80000);	// Red
-		px32 |= ((px32 >>  5) & 0x070707);	// Expand from 5-bit to 8-bit
-	} else {
-		// BGR4A3: xAAABBBB GGGGRRRR
-		// ARGB32: AAAAAAAA RRRRRRRR GGGGGGGG BBBBBBBB
-		px32  = ((px16 & 0x0F00) >>  8);	// Blue
-		px32 |= ((px16 & 0x00F0) <<  4);	// Green
-		px32 |= ((px16 & 0x000F) << 16);	// Red
-		px32 |= (px32 << 4);		// Copy to the top nybble.
+	// NOTE: Both interpretations are computed and selected with
+	// the high bit so scanline loops can be auto-vectorized.
+	// The branchy version serialized every pixel.
 
-		// Calculate and apply the alpha channel.
-		px32 |= a3_lookup[((px16 >> 12) & 0x07)];
-	}
-
-	return px32;
+	// High bit set: BGR555, no alpha channel.
+	// BGR555: xBBBBBGG GGGRRRRR
+	// ARGB32: AAAAAAAA RRRRRRRR GGGGGGGG BBBBBBBB
+	uint32_t px555 = 0xFF000000U;
+	px555 |= ((px16 >>  7) & 0x0000F8);	// Blue
+	px555 |= ((px16 <<  6) & 0x00F800);	// Green
+	px555 |= ((px16 << 19) & 0xF80000);	// Red
+	px555 |= ((px555 >>  5) & 0x070707);	// Expand from 5-bit to 8-bit
+
+	// High bit clear: BGR4A3, 3-bit alpha channel.
+	// BGR4A3: xAAABBBB GGGGRRRR
+	// ARGB32: AAAAAAAA RRRRRRRR GGGGGGGG BBBBBBBB
+	uint32_t px4a3 = ((px16 & 0x0F00) >>  8);	// Blue
+	px4a3 |= ((px16 & 0x00F0) <<  4);	// Green
+	px4a3 |= ((px16 & 0x000F) << 16);	// Red
+	px4a3 |= (px4a3 << 4);			// Copy to the top nybble.
+	// Calculate and apply the alpha channel. (bit replication)
+	px4a3 |= ((((px16 >> 12) & 0x07) * 0x49U) >> 1) << 24;
+
+	return (px16 & 0x8000U) ? px555 : px4a3;
 }
 
 /** 15-bit RGB **/
@@ -150,8 +150,9 @@ rp_image_const_ptr ASTCPrivate::loadImage(void)
 	}
 
 	// Read the texture data.
-	auto buf = aligned_uptr<uint8_t>(16, expected_size);
-	size_t size = file->read(buf.get(), expected_size);
+	AlignedArenaScope arena;
+	uint8_t *const buf = arena.alloc<uint8_t>(16, expected_size);
+	size_t size = file->read(buf, expected_size);
 	if (size != expected_size) {
 		// Read error.
 		return nullptr;
@@ -160,7 +161,7 @@ rp_image_const_ptr ASTCPrivate::loadImage(void)
 	// Decode the image.
 	img = ImageDecoder::fromASTC(
 		dimensions[0], height,
-		buf.get(), expected_size,
+		buf, expected_size,
 		astcHeader.blockdimX, astcHeader.blockdimY);
 	return img;
 }
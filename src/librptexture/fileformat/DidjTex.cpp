@@ -165,7 +165,8 @@ rp_image_const_ptr DidjTexPrivate::loadDidjTexImage(void)
 	}
 
 	// Decompress the data.
-	auto uncompr_data = aligned_uptr<uint8_t>(16, uncompr_size);
+	AlignedArenaScope arena;
+	uint8_t *const uncompr_data = arena.alloc<uint8_t>(16, uncompr_size);
 
 	// Initialize zlib.
 	z_stream strm = { };
@@ -178,7 +179,7 @@ rp_image_const_ptr DidjTexPrivate::loadDidjTexImage(void)
 	strm.avail_in = compr_size;
 	strm.next_in = compr_data.get();
 	strm.avail_out = uncompr_size;
-	strm.next_out = uncompr_data.get();
+	strm.next_out = uncompr_data;
 	do {
 		ret = inflate(&strm, Z_NO_FLUSH);
 		switch (ret) {
@@ -222,7 +223,7 @@ rp_image_const_ptr DidjTexPrivate::loadDidjTexImage(void)
 
 			imgtmp = ImageDecoder::fromLinear16(
 				ImageDecoder::PixelFormat::RGB565, width, height,
-				reinterpret_cast<const uint16_t*>(uncompr_data.get()), img_siz);
+				reinterpret_cast<const uint16_t*>(uncompr_data), img_siz);
 			break;
 		}
 
@@ -237,7 +238,7 @@ rp_image_const_ptr DidjTexPrivate::loadDidjTexImage(void)
 
 			imgtmp = ImageDecoder::fromLinear16(
 				ImageDecoder::PixelFormat::RGBA4444, width, height,
-				reinterpret_cast<const uint16_t*>(uncompr_data.get()), img_siz);
+				reinterpret_cast<const uint16_t*>(uncompr_data), img_siz);
 			break;
 		}
 
@@ -251,8 +252,8 @@ rp_image_const_ptr DidjTexPrivate::loadDidjTexImage(void)
 				return nullptr;
 			}
 
-			const uint16_t *const pal_buf = reinterpret_cast<const uint16_t*>(uncompr_data.get());
-			const uint8_t *const img_buf = &uncompr_data.get()[pal_siz];
+			const uint16_t *const pal_buf = reinterpret_cast<const uint16_t*>(uncompr_data);
+			const uint8_t *const img_buf = &uncompr_data[pal_siz];
 			imgtmp = ImageDecoder::fromLinearCI8(
 				ImageDecoder::PixelFormat::RGB565, width, height,
 				img_buf, img_siz, pal_buf, pal_siz);
@@ -269,8 +270,8 @@ rp_image_const_ptr DidjTexPrivate::loadDidjTexImage(void)
 				return nullptr;
 			}
 
-			const uint16_t *const pal_buf = reinterpret_cast<const uint16_t*>(uncompr_data.get());
-			const uint8_t *const img_buf = &uncompr_data.get()[pal_siz];
+			const uint16_t *const pal_buf = reinterpret_cast<const uint16_t*>(uncompr_data);
+			const uint8_t *const img_buf = &uncompr_data[pal_siz];
 			imgtmp = ImageDecoder::fromLinearCI8(
 				ImageDecoder::PixelFormat::RGBA4444, width, height,
 				img_buf, img_siz, pal_buf, pal_siz);
@@ -287,8 +288,8 @@ rp_image_const_ptr DidjTexPrivate::loadDidjTexImage(void)
 				return nullptr;
 			}
 
-			const uint16_t *const pal_buf = reinterpret_cast<const uint16_t*>(uncompr_data.get());
-			const uint8_t *const img_buf = &uncompr_data.get()[pal_siz];
+			const uint16_t *const pal_buf = reinterpret_cast<const uint16_t*>(uncompr_data);
+			const uint8_t *const img_buf = &uncompr_data[pal_siz];
 			imgtmp = ImageDecoder::fromLinearCI4(
 				ImageDecoder::PixelFormat::RGB565, true, width, height,
 				img_buf, img_siz, pal_buf, pal_siz);
@@ -305,8 +306,8 @@ rp_image_const_ptr DidjTexPrivate::loadDidjTexImage(void)
 				return nullptr;
 			}
 
-			const uint16_t *const pal_buf = reinterpret_cast<const uint16_t*>(uncompr_data.get());
-			const uint8_t *const img_buf = &uncompr_data.get()[pal_siz];
+			const uint16_t *const pal_buf = reinterpret_cast<const uint16_t*>(uncompr_data);
+			const uint8_t *const img_buf = &uncompr_data[pal_siz];
 			imgtmp = ImageDecoder::fromLinearCI4(
 				ImageDecoder::PixelFormat::RGBA4444, true, width, height,
 				img_buf, img_siz, pal_buf, pal_siz);
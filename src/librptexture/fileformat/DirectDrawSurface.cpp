@@ -86,6 +86,45 @@ class DirectDrawSurfacePrivate final : public FileFormatPrivate
 		 */
 		unsigned int calcExpectedSize(int width, int height, int mip, unsigned int *pStride);
 
+		/**
+		 * Decode texture data from a buffer.
+		 *
+		 * The buffer must contain `height` full rows of texture data.
+		 * For block-compressed formats, `height` should be a multiple
+		 * of the block height, except for the last row band.
+		 *
+		 * @param width		[in] Image width
+		 * @param height	[in] Image height (may be a row band of the full image)
+		 * @param buf		[in] Texture data
+		 * @param size		[in] Size of buf, in bytes
+		 * @param stride	[in] Stride, in bytes (uncompressed formats only)
+		 * @return Decoded image, or nullptr on error.
+		 */
+		rp_image_ptr decodeImageData(int width, int height, const uint8_t *buf, unsigned int size, unsigned int stride);
+
+		/**
+		 * Get the block row height for streamed (row band) decoding.
+		 * @return Rows per block, or 0 if this format must be decoded in one pass.
+		 */
+		unsigned int streamingBlockRowHeight(void) const;
+
+		// Maximum texture buffer size for a single read.
+		// Larger textures are read and decoded in row bands
+		// to bound peak memory usage. (See loadImageStreamed().)
+		static constexpr unsigned int STREAM_BUF_SIZE = 4U*1024U*1024U;
+
+		/**
+		 * Load the image in row bands to bound peak memory usage.
+		 * The file must already be seeked to the start of the texture data.
+		 * @param width		[in] Image width
+		 * @param height	[in] Image height
+		 * @param mip		[in] Mipmap number (for size calculations)
+		 * @param stride	[in] Stride, in bytes (uncompressed formats only)
+		 * @param blockRowHeight [in] Rows per block (from streamingBlockRowHeight())
+		 * @return Image, or nullptr on error.
+		 */
+		rp_image_ptr loadImageStreamed(int width, int height, int mip, unsigned int stride, unsigned int blockRowHeight);
+
 		/**
 		 * Load the image.
 		 * @param mip Mipmap number. (0 == full image)
@@ -680,119 +719,32 @@ unsigned int DirectDrawSurfacePrivate::calcExpectedSize(int width, int height, i
 }
 
 /**
- * Load the image.
- * @param mip Mipmap number. (0 == full image)
- * @return Image, or nullptr on error.
+ * Decode texture data from a buffer.
+ *
+ * The buffer must contain `height` full rows of texture data.
+ * For block-compressed formats, `height` should be a multiple
+ * of the block height, except for the last row band.
+ *
+ * @param width		[in] Image width
+ * @param height	[in] Image height (may be a row band of the full image)
+ * @param buf		[in] Texture data
+ * @param size		[in] Size of buf, in bytes
+ * @param stride	[in] Stride, in bytes (uncompressed formats only)
+ * @return Decoded image, or nullptr on error.
  */
-rp_image_const_ptr DirectDrawSurfacePrivate::loadImage(int mip)
+rp_image_ptr DirectDrawSurfacePrivate::decodeImageData(int width, int height,
+	const uint8_t *buf, unsigned int size, unsigned int stride)
 {
-	assert(mip >= 0);
-	assert(mip < static_cast<int>(mipmaps.size()));
-	if (mip < 0 || mip >= static_cast<int>(mipmaps.size())) {
-		// Invalid mipmap number.
-		return nullptr;
-	}
-
-	if (!mipmaps.empty() && mipmaps[mip] != nullptr) {
-		// Image has already been loaded.
-		return mipmaps[mip];
-	} else if (!this->isValid || !this->file) {
-		// Can't load the image.
-		return nullptr;
-	}
-
-	// Sanity check: Maximum image dimensions of 32768x32768.
-	assert(ddsHeader.dwWidth > 0);
-	assert(ddsHeader.dwWidth <= 32768);
-	assert(ddsHeader.dwHeight > 0);
-	assert(ddsHeader.dwHeight <= 32768);
-	if (ddsHeader.dwWidth == 0 || ddsHeader.dwWidth > 32768 ||
-	    ddsHeader.dwHeight == 0 || ddsHeader.dwHeight > 32768)
-	{
-		// Invalid image dimensions.
-		return nullptr;
-	}
-
-	// Texture cannot start inside of the DDS header.
-	// TODO: Also dxt10Header for DX10?
-	// TODO: ...and xb1Header for XBOX?
-	assert(texDataStartAddr >= sizeof(ddsHeader));
-	if (texDataStartAddr < sizeof(ddsHeader)) {
-		// Invalid texture data start address.
-		return nullptr;
-	}
-
-	if (file->size() > 128*1024*1024) {
-		// Sanity check: DDS files shouldn't be more than 128 MB.
-		return nullptr;
-	}
-	const uint32_t file_sz = static_cast<uint32_t>(file->size());
-
-	int width = ddsHeader.dwWidth;
-	int height = ddsHeader.dwHeight;
-
-	// If we're requesting a mipmap level higher than 0 (full image),
-	// adjust the start address, expected size, and dimensions.
-	// FIXME: Do cubemaps affect anything?
-	unsigned int stride = 0;
-	unsigned int start_addr = texDataStartAddr;
-	unsigned int expected_size = calcExpectedSize(width, height, 0, &stride);
-	assert(expected_size != 0);
-	if (expected_size == 0) {
-		// Could not calculate the expected size.
-		return nullptr;
-	}
-
-	for (int adjmip = 1; adjmip <= mip; adjmip++) {
-		width /= 2;
-		height /= 2;
-
-		assert(width > 0);
-		assert(height > 0);
-		if (width <= 0 || height <= 0) {
-			// Mipmap size calculation error...
-			return nullptr;
-		}
-
-		start_addr += expected_size;
-		expected_size = calcExpectedSize(width, height, mip, &stride);
-	}
-
-	// Seek to the start of the texture data.
-	int ret = file->seek(start_addr);
-	if (ret != 0) {
-		// Seek error.
+	assert(buf != nullptr);
+	assert(size != 0);
+	if (!buf || size == 0) {
 		return nullptr;
 	}
 
-	// TODO: Handle DX10 alpha processing.
-	// Currently, we're assuming straight alpha for formats
-	// that have an alpha channel, except for DXT2 and DXT4,
-	// which use premultiplied alpha.
-
-	// TODO: Handle sRGB.
-	// TODO: Handle signed textures.
-
-	// NOTE: Mipmaps are stored *after* the main image.
-	// Hence, no mipmap processing is necessary.
 	rp_image_ptr img;
 	if (pxf_uncomp == ImageDecoder::PixelFormat::Unknown) {
 		// Compressed RGB data.
 
-		// Verify file size.
-		if (expected_size >= file_sz + start_addr) {
-			// File is too small.
-			return nullptr;
-		}
-
-		// Read the texture data.
-		auto buf = aligned_uptr<uint8_t>(16, expected_size);
-		size_t size = file->read(buf.get(), expected_size);
-		if (size != expected_size) {
-			// Read error.
-			return nullptr;
-		}
-
 		// TODO: Handle typeless, signed, sRGB, float.
 		switch (dxgi_format) {
 			case DXGI_FORMAT_BC1_TYPELESS:
@@ -802,12 +754,12 @@ rp_image_const_ptr DirectDrawSurfacePrivate::loadImage(int mip)
 					// 1-bit alpha.
 					img = ImageDecoder::fromDXT1_A1(
 						width, height,
-						buf.get(), expected_size);
+						buf, size);
 				} else {
 					// No alpha channel.
 					img = ImageDecoder::fromDXT1(
 						width, height,
-						buf.get(), expected_size);
+						buf, size);
 				}
 				break;
 
@@ -818,12 +770,12 @@ rp_image_const_ptr DirectDrawSurfacePrivate::loadImage(int mip)
 					// Standard alpha: DXT3
 					img = ImageDecoder::fromDXT3(
 						width, height,
-						buf.get(), expected_size);
+						buf, size);
 				} else {
 					// Premultiplied alpha: DXT2
 					img = ImageDecoder::fromDXT2(
 						width, height,
-						buf.get(), expected_size);
+						buf, size);
 				}
 				break;
 
@@ -834,7 +786,7 @@ rp_image_const_ptr DirectDrawSurfacePrivate::loadImage(int mip)
 					// Standard alpha: DXT5
 					img = ImageDecoder::fromDXT5(
 						width, height,
-						buf.get(), expected_size);
+						buf, size);
 					switch (ddsHeader.ddspf.dwFourCC) {
 						default:
 							break;
@@ -854,7 +806,7 @@ rp_image_const_ptr DirectDrawSurfacePrivate::loadImage(int mip)
 					// Premultiplied alpha: DXT4
 					img = ImageDecoder::fromDXT4(
 						width, height,
-						buf.get(), expected_size);
+						buf, size);
 				}
 				break;
 
@@ -863,7 +815,7 @@ rp_image_const_ptr DirectDrawSurfacePrivate::loadImage(int mip)
 			//case DXGI_FORMAT_BC4_SNORM:
 				img = ImageDecoder::fromBC4(
 					width, height,
-					buf.get(), expected_size);
+					buf, size);
 				break;
 
 			case DXGI_FORMAT_BC5_TYPELESS:
@@ -871,7 +823,7 @@ rp_image_const_ptr DirectDrawSurfacePrivate::loadImage(int mip)
 			//case DXGI_FORMAT_BC5_SNORM:
 				img = ImageDecoder::fromBC5(
 					width, height,
-					buf.get(), expected_size);
+					buf, size);
 				break;
 
 			case DXGI_FORMAT_BC6H_TYPELESS:
@@ -885,7 +837,7 @@ rp_image_const_ptr DirectDrawSurfacePrivate::loadImage(int mip)
 			case DXGI_FORMAT_BC7_UNORM_SRGB:
 				img = ImageDecoder::fromBC7(
 					width, height,
-					buf.get(), expected_size);
+					buf, size);
 				break;
 
 #ifdef ENABLE_PVRTC
@@ -893,7 +845,7 @@ rp_image_const_ptr DirectDrawSurfacePrivate::loadImage(int mip)
 				// PVRTC, 2bpp, has alpha.
 				img = ImageDecoder::fromPVRTC(
 					width, height,
-					buf.get(), expected_size,
+					buf, size,
 					ImageDecoder::PVRTC_2BPP | ImageDecoder::PVRTC_ALPHA_YES);
 				break;
 
@@ -901,7 +853,7 @@ rp_image_const_ptr DirectDrawSurfacePrivate::loadImage(int mip)
 				// PVRTC, 4bpp, has alpha.
 				img = ImageDecoder::fromPVRTC(
 					width, height,
-					buf.get(), expected_size,
+					buf, size,
 					ImageDecoder::PVRTC_4BPP | ImageDecoder::PVRTC_ALPHA_YES);
 				break;
 #endif /* ENABLE_PVRTC */
@@ -911,8 +863,8 @@ rp_image_const_ptr DirectDrawSurfacePrivate::loadImage(int mip)
 				img = ImageDecoder::fromLinear32(
 					ImageDecoder::PixelFormat::RGB9_E5,
 					width, height,
-					reinterpret_cast<const uint32_t*>(buf.get()),
-					expected_size);
+					reinterpret_cast<const uint32_t*>(buf),
+					size);
 				break;
 
 			default:
@@ -925,7 +877,7 @@ rp_image_const_ptr DirectDrawSurfacePrivate::loadImage(int mip)
 					const unsigned int astc_idx = (dxgi_format - DXGI_FORMAT_ASTC_4X4_TYPELESS) / 4;
 					img = ImageDecoder::fromASTC(
 						width, height,
-						buf.get(), expected_size,
+						buf, size,
 						ImageDecoder::astc_lkup_tbl[astc_idx][0],
 						ImageDecoder::astc_lkup_tbl[astc_idx][1]);
 					break;
@@ -944,49 +896,35 @@ rp_image_const_ptr DirectDrawSurfacePrivate::loadImage(int mip)
 			return nullptr;
 		}
 
-		// Verify file size.
-		if (expected_size >= file_sz + start_addr) {
-			// File is too small.
-			return nullptr;
-		}
-
-		// Read the texture data.
-		auto buf = aligned_uptr<uint8_t>(16, expected_size);
-		size_t size = file->read(buf.get(), expected_size);
-		if (size != expected_size) {
-			// Read error.
-			return nullptr;
-		}
-
 		switch (bytespp) {
 			case sizeof(uint8_t):
 				// 8-bit image. (Usually luminance or alpha.)
 				img = ImageDecoder::fromLinear8(
 					pxf_uncomp, width, height,
-					buf.get(), expected_size, stride);
+					buf, size, stride);
 				break;
 
 			case sizeof(uint16_t):
 				// 16-bit RGB image.
 				img = ImageDecoder::fromLinear16(
 					pxf_uncomp, width, height,
-					reinterpret_cast<const uint16_t*>(buf.get()),
-					expected_size, stride);
+					reinterpret_cast<const uint16_t*>(buf),
+					size, stride);
 				break;
 
 			case 24/8:
 				// 24-bit RGB image.
 				img = ImageDecoder::fromLinear24(
 					pxf_uncomp, width, height,
-					buf.get(), expected_size, stride);
+					buf, size, stride);
 				break;
 
 			case sizeof(uint32_t):
 				// 32-bit RGB image.
 				img = ImageDecoder::fromLinear32(
 					pxf_uncomp, width, height,
-					reinterpret_cast<const uint32_t*>(buf.get()),
-					expected_size, stride);
+					reinterpret_cast<const uint32_t*>(buf),
+					size, stride);
 				break;
 
 			default:
@@ -996,6 +934,258 @@ rp_image_const_ptr DirectDrawSurfacePrivate::loadImage(int mip)
 		}
 	}
 
+	return img;
+}
+
+/**
+ * Get the block row height for streamed (row band) decoding.
+ * @return Rows per block, or 0 if this format must be decoded in one pass.
+ */
+unsigned int DirectDrawSurfacePrivate::streamingBlockRowHeight(void) const
+{
+	if (pxf_uncomp != ImageDecoder::PixelFormat::Unknown) {
+		// Uncompressed linear image data.
+		// NOTE: 8-bit images are decoded to CI8, which can't be
+		// assembled band-by-band into an ARGB32 image.
+		return (bytespp > 1) ? 1 : 0;
+	}
+
+	// Compressed RGB data.
+	switch (dxgi_format) {
+		case DXGI_FORMAT_BC1_TYPELESS:
+		case DXGI_FORMAT_BC1_UNORM:
+		case DXGI_FORMAT_BC1_UNORM_SRGB:
+		case DXGI_FORMAT_BC2_TYPELESS:
+		case DXGI_FORMAT_BC2_UNORM:
+		case DXGI_FORMAT_BC2_UNORM_SRGB:
+		case DXGI_FORMAT_BC3_TYPELESS:
+		case DXGI_FORMAT_BC3_UNORM:
+		case DXGI_FORMAT_BC3_UNORM_SRGB:
+		case DXGI_FORMAT_BC4_TYPELESS:
+		case DXGI_FORMAT_BC4_UNORM:
+		case DXGI_FORMAT_BC5_TYPELESS:
+		case DXGI_FORMAT_BC5_UNORM:
+		case DXGI_FORMAT_BC7_TYPELESS:
+		case DXGI_FORMAT_BC7_UNORM:
+		case DXGI_FORMAT_BC7_UNORM_SRGB:
+			// S3TC-style formats use 4x4 tiles.
+			return 4;
+
+		case DXGI_FORMAT_R9G9B9E5_SHAREDEXP:
+			// Uncompressed "special" 32bpp format.
+			return 1;
+
+		default:
+			// PVRTC isn't row-decomposable, and ASTC uses
+			// variable block sizes. Decode in one pass.
+			break;
+	}
+
+	return 0;
+}
+
+/**
+ * Load the image in row bands to bound peak memory usage.
+ * The file must already be seeked to the start of the texture data.
+ * @param width		[in] Image width
+ * @param height	[in] Image height
+ * @param mip		[in] Mipmap number (for size calculations)
+ * @param stride	[in] Stride, in bytes (uncompressed formats only)
+ * @param blockRowHeight [in] Rows per block (from streamingBlockRowHeight())
+ * @return Image, or nullptr on error.
+ */
+rp_image_ptr DirectDrawSurfacePrivate::loadImageStreamed(int width, int height,
+	int mip, unsigned int stride, unsigned int blockRowHeight)
+{
+	// Bytes needed for one row of blocks.
+	const unsigned int blockRowBytes = (pxf_uncomp != ImageDecoder::PixelFormat::Unknown)
+		? (stride * blockRowHeight)
+		: calcExpectedSize(width, static_cast<int>(blockRowHeight), mip, nullptr);
+	assert(blockRowBytes != 0);
+	if (blockRowBytes == 0) {
+		return nullptr;
+	}
+
+	// Number of rows per band. (multiple of the block height)
+	const unsigned int blockRowsPerBand = std::max(1U, STREAM_BUF_SIZE / blockRowBytes);
+	const unsigned int rows_per_band = blockRowsPerBand * blockRowHeight;
+
+	const rp_image_ptr img = std::make_shared<rp_image>(width, height, rp_image::Format::ARGB32);
+	if (!img->isValid()) {
+		// Could not allocate the image.
+		return nullptr;
+	}
+
+	AlignedArenaScope arena;
+	uint8_t *const buf = arena.alloc<uint8_t>(16, blockRowsPerBand * blockRowBytes);
+	const unsigned int row_bytes = static_cast<unsigned int>(width) * sizeof(uint32_t);
+	for (int y = 0; y < height; y += rows_per_band) {
+		const int band_height = std::min(static_cast<int>(rows_per_band), height - y);
+		const unsigned int band_size = (pxf_uncomp != ImageDecoder::PixelFormat::Unknown)
+			? (stride * static_cast<unsigned int>(band_height))
+			: calcExpectedSize(width, band_height, mip, nullptr);
+		if (band_size == 0) {
+			// Size calculation error.
+			return nullptr;
+		}
+
+		size_t sz_read = file->read(buf, band_size);
+		if (sz_read != band_size) {
+			// Read error.
+			return nullptr;
+		}
+
+		const rp_image_ptr band_img = decodeImageData(width, band_height, buf, band_size, stride);
+		if (!band_img || !band_img->isValid() ||
+		    band_img->format() != rp_image::Format::ARGB32)
+		{
+			// Unable to decode this band.
+			return nullptr;
+		}
+
+		// Copy the band into the destination image.
+		for (int by = 0; by < band_height; by++) {
+			memcpy(img->scanLine(y + by), band_img->scanLine(by), row_bytes);
+		}
+
+		if (y == 0) {
+			// Copy the sBIT metadata from the first band.
+			rp_image::sBIT_t sBIT;
+			if (band_img->get_sBIT(&sBIT) == 0) {
+				img->set_sBIT(&sBIT);
+			}
+		}
+	}
+
+	return img;
+}
+
+/**
+ * Load the image.
+ * @param mip Mipmap number. (0 == full image)
+ * @return Image, or nullptr on error.
+ */
+rp_image_const_ptr DirectDrawSurfacePrivate::loadImage(int mip)
+{
+	assert(mip >= 0);
+	assert(mip < static_cast<int>(mipmaps.size()));
+	if (mip < 0 || mip >= static_cast<int>(mipmaps.size())) {
+		// Invalid mipmap number.
+		return nullptr;
+	}
+
+	if (!mipmaps.empty() && mipmaps[mip] != nullptr) {
+		// Image has already been loaded.
+		return mipmaps[mip];
+	} else if (!this->isValid || !this->file) {
+		// Can't load the image.
+		return nullptr;
+	}
+
+	// Sanity check: Maximum image dimensions of 32768x32768.
+	assert(ddsHeader.dwWidth > 0);
+	assert(ddsHeader.dwWidth <= 32768);
+	assert(ddsHeader.dwHeight > 0);
+	assert(ddsHeader.dwHeight <= 32768);
+	if (ddsHeader.dwWidth == 0 || ddsHeader.dwWidth > 32768 ||
+	    ddsHeader.dwHeight == 0 || ddsHeader.dwHeight > 32768)
+	{
+		// Invalid image dimensions.
+		return nullptr;
+	}
+
+	// Texture cannot start inside of the DDS header.
+	// TODO: Also dxt10Header for DX10?
+	// TODO: ...and xb1Header for XBOX?
+	assert(texDataStartAddr >= sizeof(ddsHeader));
+	if (texDataStartAddr < sizeof(ddsHeader)) {
+		// Invalid texture data start address.
+		return nullptr;
+	}
+
+	if (file->size() > 1024LL*1024*1024) {
+		// Sanity check: DDS files shouldn't be more than 1 GB.
+		// NOTE: Raised from 128 MB, since large textures are now
+		// read in row bands instead of one contiguous buffer.
+		return nullptr;
+	}
+	const uint32_t file_sz = static_cast<uint32_t>(file->size());
+
+	int width = ddsHeader.dwWidth;
+	int height = ddsHeader.dwHeight;
+
+	// If we're requesting a mipmap level higher than 0 (full image),
+	// adjust the start address, expected size, and dimensions.
+	// FIXME: Do cubemaps affect anything?
+	unsigned int stride = 0;
+	unsigned int start_addr = texDataStartAddr;
+	unsigned int expected_size = calcExpectedSize(width, height, 0, &stride);
+	assert(expected_size != 0);
+	if (expected_size == 0) {
+		// Could not calculate the expected size.
+		return nullptr;
+	}
+
+	for (int adjmip = 1; adjmip <= mip; adjmip++) {
+		width /= 2;
+		height /= 2;
+
+		assert(width > 0);
+		assert(height > 0);
+		if (width <= 0 || height <= 0) {
+			// Mipmap size calculation error...
+			return nullptr;
+		}
+
+		start_addr += expected_size;
+		expected_size = calcExpectedSize(width, height, mip, &stride);
+	}
+
+	// Seek to the start of the texture data.
+	int ret = file->seek(start_addr);
+	if (ret != 0) {
+		// Seek error.
+		return nullptr;
+	}
+
+	// TODO: Handle DX10 alpha processing.
+	// Currently, we're assuming straight alpha for formats
+	// that have an alpha channel, except for DXT2 and DXT4,
+	// which use premultiplied alpha.
+
+	// TODO: Handle sRGB.
+	// TODO: Handle signed textures.
+
+	// NOTE: Mipmaps are stored *after* the main image.
+	// Hence, no mipmap processing is necessary.
+
+	// Verify the file size.
+	if (expected_size >= file_sz + start_addr) {
+		// File is too small.
+		return nullptr;
+	}
+
+	rp_image_ptr img;
+	const unsigned int blockRowHeight = streamingBlockRowHeight();
+	if (expected_size > STREAM_BUF_SIZE && blockRowHeight != 0 &&
+	    height > static_cast<int>(blockRowHeight))
+	{
+		// Large texture: read and decode in row bands
+		// to bound peak memory usage.
+		img = loadImageStreamed(width, height, mip, stride, blockRowHeight);
+	} else {
+		// Read the texture data.
+		AlignedArenaScope arena;
+		uint8_t *const buf = arena.alloc<uint8_t>(16, expected_size);
+		size_t sz_read = file->read(buf, expected_size);
+		if (sz_read != expected_size) {
+			// Read error.
+			return nullptr;
+		}
+
+		img = decodeImageData(width, height, buf, expected_size, stride);
+	}
+
 	// Check if we need to unswizzle a GIMP-DDS texture.
 	if (img && !memcmp(ddsHeader.gimp.magic, DDS_GIMP_MAGIC, sizeof(ddsHeader.gimp.magic))) {
 		// TODO: Verify that the image format is ARGB32.
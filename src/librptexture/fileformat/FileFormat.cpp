@@ -200,4 +200,54 @@ rp_image_const_ptr FileFormat::mipmap(int mip) const
 	return nullptr;
 }
 
+/**
+ * Get the smallest mipmap with both dimensions >= the specified size.
+ *
+ * Intended for thumbnailing: decoding e.g. a 256x256 mipmap of a
+ * 4K texture is significantly faster than decoding the full-size
+ * image and scaling it down.
+ *
+ * If the texture doesn't have mipmaps, or all mipmaps are smaller
+ * than the specified size, the closest available image is returned.
+ *
+ * @param size Minimum dimension, in pixels.
+ * @return Image, or nullptr on error.
+ */
+rp_image_const_ptr FileFormat::loadClosestMip(int size) const
+{
+	RP_D(const FileFormat);
+	assert(size > 0);
+	if (size <= 0) {
+		return nullptr;
+	}
+
+	if (d->mipmapCount <= 1) {
+		// No mipmaps. (or only the main image)
+		return image();
+	}
+
+	// Mipmap N has dimensions (width >> N, height >> N).
+	// Find the last mipmap that's still >= the requested size.
+	// NOTE: Using the smaller dimension so non-square textures
+	// don't lose detail along their short axis.
+	int dim = std::min(d->dimensions[0], d->dimensions[1]);
+	if (dim <= 0) {
+		// Might be a 1D texture.
+		dim = std::max(d->dimensions[0], d->dimensions[1]);
+	}
+
+	int mip = 0;
+	while (mip < (d->mipmapCount - 1) && (dim >> (mip + 1)) >= size) {
+		mip++;
+	}
+
+	// Get the mipmap.
+	// If it can't be decoded, fall back to the main image.
+	rp_image_const_ptr img = mipmap(mip);
+	if (!img && mip > 0) {
+		img = image();
+	}
+	return img;
+}
+
 }
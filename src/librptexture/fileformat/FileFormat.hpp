@@ -172,6 +172,24 @@ public:
 	 * @return Image, or nullptr on error.
 	 */
 	virtual rp_image_const_ptr mipmap(int mip) const;
+
+	/**
+	 * Get the smallest mipmap with both dimensions >= the specified size.
+	 *
+	 * Intended for thumbnailing: decoding e.g. a 256x256 mipmap of a
+	 * 4K texture is significantly faster than decoding the full-size
+	 * image and scaling it down.
+	 *
+	 * If the texture doesn't have mipmaps, or all mipmaps are smaller
+	 * than the specified size, the closest available image is returned.
+	 *
+	 * Subclasses may override this if the file format carries a
+	 * dedicated thumbnail image, e.g. Valve VTF's low-res image.
+	 *
+	 * @param size Minimum dimension, in pixels.
+	 * @return Image, or nullptr on error.
+	 */
+	virtual rp_image_const_ptr loadClosestMip(int size) const;
 };
 
 typedef std::shared_ptr<FileFormat> FileFormatPtr;
@@ -108,6 +108,20 @@ public: \
 	 */ \
 	LibRpTexture::rp_image_const_ptr mipmap(int mip) const final;
 
+/**
+ * FileFormat subclass function declaration for loadClosestMip().
+ * Only needed if the FileFormat has a dedicated thumbnail image
+ * that's preferable to decoding a mipmap of the main image.
+ */
+#define FILEFORMAT_DECL_CLOSEST_MIP() \
+public: \
+	/** \
+	 * Get the smallest mipmap with both dimensions >= the specified size. \
+	 * @param size Minimum dimension, in pixels. \
+	 * @return Image, or nullptr on error. \
+	 */ \
+	LibRpTexture::rp_image_const_ptr loadClosestMip(int size) const final;
+
 /**
  * End of FileFormat subclass declaration.
  */
@@ -584,8 +584,9 @@ rp_image_const_ptr GodotSTEXPrivate::loadImage(int mip)
 	}
 
 	// Read the texture data.
-	auto buf = aligned_uptr<uint8_t>(16, mdata.size);
-	size_t size = file->read(buf.get(), mdata.size);
+	AlignedArenaScope arena;
+	uint8_t *const buf = arena.alloc<uint8_t>(16, mdata.size);
+	size_t size = file->read(buf, mdata.size);
 	if (size != mdata.size) {
 		// Read error.
 		return nullptr;
@@ -604,14 +605,14 @@ rp_image_const_ptr GodotSTEXPrivate::loadImage(int mip)
 				img = ImageDecoder::fromLinear8(
 					ImageDecoder::PixelFormat::L8,
 					mdata.width, mdata.height,
-					buf.get(), mdata.size);
+					buf, mdata.size);
 				break;
 			case STEX_FORMAT_LA8:
 				// TODO: Verify byte-order.
 				img = ImageDecoder::fromLinear16(
 					ImageDecoder::PixelFormat::L8A8,
 					mdata.width, mdata.height,
-					reinterpret_cast<const uint16_t*>(buf.get()),
+					reinterpret_cast<const uint16_t*>(buf),
 					mdata.size);
 				break;
 
@@ -619,34 +620,34 @@ rp_image_const_ptr GodotSTEXPrivate::loadImage(int mip)
 				img = ImageDecoder::fromLinear8(
 					ImageDecoder::PixelFormat::R8,
 					mdata.width, mdata.height,
-					buf.get(), mdata.size);
+					buf, mdata.size);
 				break;
 			case STEX_FORMAT_RG8:
 				// TODO: Verify byte-order.
 				img = ImageDecoder::fromLinear16(
 					ImageDecoder::PixelFormat::GR88,
 					mdata.width, mdata.height,
-					reinterpret_cast<const uint16_t*>(buf.get()),
+					reinterpret_cast<const uint16_t*>(buf),
 					mdata.size);
 				break;
 			case STEX_FORMAT_RGB8:
 				img = ImageDecoder::fromLinear24(
 					ImageDecoder::PixelFormat::BGR888,
 					mdata.width, mdata.height,
-					buf.get(), mdata.size);
+					buf, mdata.size);
 				break;
 			case STEX_FORMAT_RGBA8:
 				img = ImageDecoder::fromLinear32(
 					ImageDecoder::PixelFormat::ABGR8888,
 					mdata.width, mdata.height,
-					reinterpret_cast<const uint32_t*>(buf.get()),
+					reinterpret_cast<const uint32_t*>(buf),
 					mdata.size);
 				break;
 			case STEX_FORMAT_RGBA4444:
 				img = ImageDecoder::fromLinear16(
 					ImageDecoder::PixelFormat::RGBA4444,
 					mdata.width, mdata.height,
-					reinterpret_cast<const uint16_t*>(buf.get()),
+					reinterpret_cast<const uint16_t*>(buf),
 					mdata.size);
 				break;
 
@@ -654,7 +655,7 @@ rp_image_const_ptr GodotSTEXPrivate::loadImage(int mip)
 				img = ImageDecoder::fromLinear32(
 					ImageDecoder::PixelFormat::RGB9_E5,
 					mdata.width, mdata.height,
-					reinterpret_cast<const uint32_t*>(buf.get()),
+					reinterpret_cast<const uint32_t*>(buf),
 					mdata.size);
 				break;
 
@@ -665,36 +666,36 @@ rp_image_const_ptr GodotSTEXPrivate::loadImage(int mip)
 			case STEX_FORMAT_DXT1:
 				img = ImageDecoder::fromDXT1(
 					mdata.width, mdata.height,
-					buf.get(), mdata.size);
+					buf, mdata.size);
 				break;
 			case STEX_FORMAT_DXT3:
 				img = ImageDecoder::fromDXT3(
 					mdata.width, mdata.height,
-					buf.get(), mdata.size);
+					buf, mdata.size);
 				break;
 			case STEX_FORMAT_DXT5:
 				img = ImageDecoder::fromDXT5(
 					mdata.width, mdata.height,
-					buf.get(), mdata.size);
+					buf, mdata.size);
 				break;
 
 			case STEX_FORMAT_RGTC_R:
 				// RGTC, one component. (BC4)
 				img = ImageDecoder::fromBC4(
 					mdata.width, mdata.height,
-					buf.get(), mdata.size);
+					buf, mdata.size);
 				break;
 			case STEX_FORMAT_RGTC_RG:
 				// RGTC, two components. (BC5)
 				img = ImageDecoder::fromBC5(
 					mdata.width, mdata.height,
-					buf.get(), mdata.size);
+					buf, mdata.size);
 				break;
 			case STEX_FORMAT_BPTC_RGBA:
 				// BPTC-compressed RGBA texture. (BC7)
 				img = ImageDecoder::fromBC7(
 					mdata.width, mdata.height,
-					buf.get(), mdata.size);
+					buf, mdata.size);
 				break;
 		}
 	} else if (stexVersion == 3) {
@@ -711,26 +712,26 @@ rp_image_const_ptr GodotSTEXPrivate::loadImage(int mip)
 			case STEX3_FORMAT_PVRTC1_2:
 				img = ImageDecoder::fromPVRTC(
 					mdata.width, mdata.height,
-					buf.get(), mdata.size,
+					buf, mdata.size,
 					ImageDecoder::PVRTC_2BPP | ImageDecoder::PVRTC_ALPHA_NONE);
 				break;
 			case STEX3_FORMAT_PVRTC1_2A:
 				img = ImageDecoder::fromPVRTC(
 					mdata.width, mdata.height,
-					buf.get(), mdata.size,
+					buf, mdata.size,
 					ImageDecoder::PVRTC_2BPP | ImageDecoder::PVRTC_ALPHA_YES);
 				break;
 
 			case STEX3_FORMAT_PVRTC1_4:
 				img = ImageDecoder::fromPVRTC(
 					mdata.width, mdata.height,
-					buf.get(), mdata.size,
+					buf, mdata.size,
 					ImageDecoder::PVRTC_4BPP | ImageDecoder::PVRTC_ALPHA_NONE);
 				break;
 			case STEX3_FORMAT_PVRTC1_4A:
 				img = ImageDecoder::fromPVRTC(
 					mdata.width, mdata.height,
-					buf.get(), mdata.size,
+					buf, mdata.size,
 					ImageDecoder::PVRTC_4BPP | ImageDecoder::PVRTC_ALPHA_YES);
 				break;
 #endif /* ENABLE_PVRTC */
@@ -739,24 +740,24 @@ rp_image_const_ptr GodotSTEXPrivate::loadImage(int mip)
 			case STEX3_FORMAT_ETC:
 				img = ImageDecoder::fromETC1(
 					mdata.width, mdata.height,
-					buf.get(), mdata.size);
+					buf, mdata.size);
 				break;
 			case STEX3_FORMAT_ETC2_RGB8:
 				// NOTE: If the ETC2 texture has mipmaps,
 				// it's stored as a Power-of-2 texture.
 				img = ImageDecoder::fromETC2_RGB(
 					mdata.width, mdata.height,
-					buf.get(), mdata.size);
+					buf, mdata.size);
 				break;
 			case STEX3_FORMAT_ETC2_RGBA8:
 				img = ImageDecoder::fromETC2_RGBA(
 					mdata.width, mdata.height,
-					buf.get(), mdata.size);
+					buf, mdata.size);
 				break;
 			case STEX3_FORMAT_ETC2_RGB8A1:
 				img = ImageDecoder::fromETC2_RGB_A1(
 					mdata.width, mdata.height,
-					buf.get(), mdata.size);
+					buf, mdata.size);
 				break;
 
 			case STEX3_FORMAT_ETC2_R11:
@@ -765,7 +766,7 @@ rp_image_const_ptr GodotSTEXPrivate::loadImage(int mip)
 				// TODO: Does the signed version get decoded differently?
 				img = ImageDecoder::fromEAC_R11(
 					mdata.width, mdata.height,
-					buf.get(), mdata.size);
+					buf, mdata.size);
 				break;
 			case STEX3_FORMAT_ETC2_RG11:
 			case STEX3_FORMAT_ETC2_RG11S:
@@ -773,7 +774,7 @@ rp_image_const_ptr GodotSTEXPrivate::loadImage(int mip)
 				// TODO: Does the signed version get decoded differently?
 				img = ImageDecoder::fromEAC_RG11(
 					mdata.width, mdata.height,
-					buf.get(), mdata.size);
+					buf, mdata.size);
 				break;
 
 #ifdef ENABLE_ASTC
@@ -781,7 +782,7 @@ rp_image_const_ptr GodotSTEXPrivate::loadImage(int mip)
 				// Sonic Colors Ultimate: ASTC 8x8
 				img = ImageDecoder::fromASTC(
 					mdata.width, mdata.height,
-					buf.get(), mdata.size, 8, 8);
+					buf, mdata.size, 8, 8);
 				break;
 #endif /* ENABLE_ASTC */
 		}
@@ -802,24 +803,24 @@ rp_image_const_ptr GodotSTEXPrivate::loadImage(int mip)
 			case STEX4_FORMAT_ETC:
 				img = ImageDecoder::fromETC1(
 					mdata.width, mdata.height,
-					buf.get(), mdata.size);
+					buf, mdata.size);
 				break;
 			case STEX4_FORMAT_ETC2_RGB8:
 				// NOTE: If the ETC2 texture has mipmaps,
 				// it's stored as a Power-of-2 texture.
 				img = ImageDecoder::fromETC2_RGB(
 					mdata.width, mdata.height,
-					buf.get(), mdata.size);
+					buf, mdata.size);
 				break;
 			case STEX4_FORMAT_ETC2_RGBA8:
 				img = ImageDecoder::fromETC2_RGBA(
 					mdata.width, mdata.height,
-					buf.get(), mdata.size);
+					buf, mdata.size);
 				break;
 			case STEX4_FORMAT_ETC2_RGB8A1:
 				img = ImageDecoder::fromETC2_RGB_A1(
 					mdata.width, mdata.height,
-					buf.get(), mdata.size);
+					buf, mdata.size);
 				break;
 
 			case STEX4_FORMAT_ETC2_R11:
@@ -828,7 +829,7 @@ rp_image_const_ptr GodotSTEXPrivate::loadImage(int mip)
 				// TODO: Does the signed version get decoded differently?
 				img = ImageDecoder::fromEAC_R11(
 					mdata.width, mdata.height,
-					buf.get(), mdata.size);
+					buf, mdata.size);
 				break;
 			case STEX4_FORMAT_ETC2_RG11:
 			case STEX4_FORMAT_ETC2_RG11S:
@@ -836,7 +837,7 @@ rp_image_const_ptr GodotSTEXPrivate::loadImage(int mip)
 				// TODO: Does the signed version get decoded differently?
 				img = ImageDecoder::fromEAC_RG11(
 					mdata.width, mdata.height,
-					buf.get(), mdata.size);
+					buf, mdata.size);
 				break;
 
 			case STEX4_FORMAT_ETC2_RA_AS_RG:
@@ -847,12 +848,12 @@ rp_image_const_ptr GodotSTEXPrivate::loadImage(int mip)
 			case STEX4_FORMAT_ASTC_4x4:
 				img = ImageDecoder::fromASTC(
 					mdata.width, mdata.height,
-					buf.get(), mdata.size, 4, 4);
+					buf, mdata.size, 4, 4);
 				break;
 			case STEX4_FORMAT_ASTC_8x8:
 				img = ImageDecoder::fromASTC(
 					mdata.width, mdata.height,
-					buf.get(), mdata.size, 8, 8);
+					buf, mdata.size, 8, 8);
 				break;
 		}
 	} else {
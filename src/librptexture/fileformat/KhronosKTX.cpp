@@ -81,6 +81,12 @@ class KhronosKTXPrivate final : public FileFormatPrivate
 		// Mipmap 0 is the full image.
 		vector<rp_image_ptr> mipmaps;
 
+		// Mipmap level offsets
+		// Address of each level's imageSize field, computed
+		// incrementally as levels are visited, so repeated
+		// mipmap loads don't re-read the preceding levels.
+		vector<uint32_t> mipOffsets;
+
 		// Invalid pixel format message
 		char invalid_pixel_format[24];
 
@@ -380,23 +386,35 @@ rp_image_const_ptr KhronosKTXPrivate::loadImage(int mip)
 	// This is stored directly before each mipmap level.
 	uint32_t imageSize = 0;
 
-	// Adjust starting address and image size for the mipmap level.
-	unsigned int mip_texDataStartAddr = texDataStartAddr;
-	for (int adjmip = mip; adjmip >= 0; adjmip--) {
-		size_t size = file->seekAndRead(mip_texDataStartAddr, &imageSize, sizeof(imageSize));
-		if (size != sizeof(imageSize)) {
+	// Compute any missing level offsets, then read the image size
+	// field for the requested level. Offsets are cached, so only
+	// levels that haven't been visited yet are walked, and each
+	// walk only touches the 4-byte imageSize fields.
+	if (mipOffsets.empty()) {
+		mipOffsets.reserve(mipmaps.size());
+		mipOffsets.push_back(texDataStartAddr);
+	}
+	for (int lvl = static_cast<int>(mipOffsets.size()) - 1; lvl < mip; lvl++) {
+		uint32_t lvlSize;
+		size_t sz_read = file->seekAndRead(mipOffsets[lvl], &lvlSize, sizeof(lvlSize));
+		if (sz_read != sizeof(lvlSize)) {
 			// Unable to read the image size field.
 			return nullptr;
 		}
 		if (isByteswapNeeded) {
-			imageSize = __swab32(imageSize);
+			lvlSize = __swab32(lvlSize);
 		}
+		mipOffsets.push_back(mipOffsets[lvl] + sizeof(lvlSize) + lvlSize);
+	}
 
-		if (adjmip > 0) {
-			// Adjust the starting address for the next mipmap level.
-			mip_texDataStartAddr += imageSize;
-			mip_texDataStartAddr += sizeof(imageSize);
-		}
+	const unsigned int mip_texDataStartAddr = mipOffsets[mip];
+	const size_t sz_read = file->seekAndRead(mip_texDataStartAddr, &imageSize, sizeof(imageSize));
+	if (sz_read != sizeof(imageSize)) {
+		// Unable to read the image size field.
+		return nullptr;
+	}
+	if (isByteswapNeeded) {
+		imageSize = __swab32(imageSize);
 	}
 
 	// Divide image size by # of layers to get the expected size.
@@ -415,8 +433,9 @@ rp_image_const_ptr KhronosKTXPrivate::loadImage(int mip)
 	}
 
 	// Read the texture data.
-	auto buf = aligned_uptr<uint8_t>(16, expected_size);
-	size_t size = file->read(buf.get(), expected_size);
+	AlignedArenaScope arena;
+	uint8_t *const buf = arena.alloc<uint8_t>(16, expected_size);
+	size_t size = file->read(buf, expected_size);
 	if (size != expected_size) {
 		// Read error.
 		return nullptr;
@@ -432,7 +451,7 @@ rp_image_const_ptr KhronosKTXPrivate::loadImage(int mip)
 			img = ImageDecoder::fromLinear24(
 				ImageDecoder::PixelFormat::BGR888,
 				width, height,
-				buf.get(), expected_size, stride);
+				buf, expected_size, stride);
 			break;
 
 		case GL_RGBA:
@@ -440,7 +459,7 @@ rp_image_const_ptr KhronosKTXPrivate::loadImage(int mip)
 			img = ImageDecoder::fromLinear32(
 				ImageDecoder::PixelFormat::ABGR8888,
 				width, height,
-				reinterpret_cast<const uint32_t*>(buf.get()), expected_size, stride);
+				reinterpret_cast<const uint32_t*>(buf), expected_size, stride);
 			break;
 
 		case GL_LUMINANCE:
@@ -448,7 +467,7 @@ rp_image_const_ptr KhronosKTXPrivate::loadImage(int mip)
 			img = ImageDecoder::fromLinear8(
 				ImageDecoder::PixelFormat::L8,
 				width, height,
-				buf.get(), expected_size, stride);
+				buf, expected_size, stride);
 			break;
 
 		case GL_RGB9_E5:
@@ -457,7 +476,7 @@ rp_image_const_ptr KhronosKTXPrivate::loadImage(int mip)
 			img = ImageDecoder::fromLinear32(
 				ImageDecoder::PixelFormat::RGB9_E5,
 				width, height,
-				reinterpret_cast<const uint32_t*>(buf.get()), expected_size, stride);
+				reinterpret_cast<const uint32_t*>(buf), expected_size, stride);
 			break;
 
 		case 0:
@@ -470,7 +489,7 @@ rp_image_const_ptr KhronosKTXPrivate::loadImage(int mip)
 					img = ImageDecoder::fromLinear24(
 						ImageDecoder::PixelFormat::BGR888,
 						width, height,
-						buf.get(), expected_size, stride);
+						buf, expected_size, stride);
 					break;
 
 				case GL_RGBA8:
@@ -478,7 +497,7 @@ rp_image_const_ptr KhronosKTXPrivate::loadImage(int mip)
 					img = ImageDecoder::fromLinear32(
 						ImageDecoder::PixelFormat::ABGR8888,
 						width, height,
-						reinterpret_cast<const uint32_t*>(buf.get()), expected_size, stride);
+						reinterpret_cast<const uint32_t*>(buf), expected_size, stride);
 					break;
 
 				case GL_R8:
@@ -486,7 +505,7 @@ rp_image_const_ptr KhronosKTXPrivate::loadImage(int mip)
 					img = ImageDecoder::fromLinear8(
 						ImageDecoder::PixelFormat::R8,
 						width, height,
-						buf.get(), expected_size, stride);
+						buf, expected_size, stride);
 					break;
 
 				case GL_RGB_S3TC:
@@ -495,21 +514,21 @@ rp_image_const_ptr KhronosKTXPrivate::loadImage(int mip)
 					// DXT1-compressed texture.
 					img = ImageDecoder::fromDXT1(
 						width, height,
-						buf.get(), expected_size);
+						buf, expected_size);
 					break;
 
 				case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
 					// DXT1-compressed texture with 1-bit alpha.
 					img = ImageDecoder::fromDXT1_A1(
 						width, height,
-						buf.get(), expected_size);
+						buf, expected_size);
 					break;
 
 				case GL_COMPRESSED_RGBA_S3TC_DXT3_EXT:
 					// DXT3-compressed texture.
 					img = ImageDecoder::fromDXT3(
 						width, height,
-						buf.get(), expected_size);
+						buf, expected_size);
 					break;
 
 				case GL_RGBA_DXT5_S3TC:
@@ -518,14 +537,14 @@ rp_image_const_ptr KhronosKTXPrivate::loadImage(int mip)
 					// DXT5-compressed texture.
 					img = ImageDecoder::fromDXT5(
 						width, height,
-						buf.get(), expected_size);
+						buf, expected_size);
 					break;
 
 				case GL_ETC1_RGB8_OES:
 					// ETC1-compressed texture.
 					img = ImageDecoder::fromETC1(
 						width, height,
-						buf.get(), expected_size);
+						buf, expected_size);
 					break;
 
 				case GL_COMPRESSED_RGB8_ETC2:
@@ -534,7 +553,7 @@ rp_image_const_ptr KhronosKTXPrivate::loadImage(int mip)
 					// TODO: Handle sRGB.
 					img = ImageDecoder::fromETC2_RGB(
 						width, height,
-						buf.get(), expected_size);
+						buf, expected_size);
 					break;
 
 				case GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2:
@@ -544,7 +563,7 @@ rp_image_const_ptr KhronosKTXPrivate::loadImage(int mip)
 					// TODO: Handle sRGB.
 					img = ImageDecoder::fromETC2_RGB_A1(
 						width, height,
-						buf.get(), expected_size);
+						buf, expected_size);
 					break;
 
 				case GL_COMPRESSED_RGBA8_ETC2_EAC:
@@ -554,7 +573,7 @@ rp_image_const_ptr KhronosKTXPrivate::loadImage(int mip)
 					// TODO: Handle sRGB.
 					img = ImageDecoder::fromETC2_RGBA(
 						width, height,
-						buf.get(), expected_size);
+						buf, expected_size);
 					break;
 
 				case GL_COMPRESSED_R11_EAC:
@@ -563,7 +582,7 @@ rp_image_const_ptr KhronosKTXPrivate::loadImage(int mip)
 					// TODO: Does the signed version get decoded differently?
 					img = ImageDecoder::fromEAC_R11(
 						width, height,
-						buf.get(), expected_size);
+						buf, expected_size);
 					break;
 
 				case GL_COMPRESSED_RG11_EAC:
@@ -572,7 +591,7 @@ rp_image_const_ptr KhronosKTXPrivate::loadImage(int mip)
 					// TODO: Does the signed version get decoded differently?
 					img = ImageDecoder::fromEAC_RG11(
 						width, height,
-						buf.get(), expected_size);
+						buf, expected_size);
 					break;
 
 				case GL_COMPRESSED_RED_RGTC1:
@@ -581,7 +600,7 @@ rp_image_const_ptr KhronosKTXPrivate::loadImage(int mip)
 					// TODO: Handle signed properly.
 					img = ImageDecoder::fromBC4(
 						width, height,
-						buf.get(), expected_size);
+						buf, expected_size);
 					break;
 
 				case GL_COMPRESSED_RG_RGTC2:
@@ -590,7 +609,7 @@ rp_image_const_ptr KhronosKTXPrivate::loadImage(int mip)
 					// TODO: Handle signed properly.
 					img = ImageDecoder::fromBC5(
 						width, height,
-						buf.get(), expected_size);
+						buf, expected_size);
 					break;
 
 				case GL_COMPRESSED_LUMINANCE_LATC1_EXT:
@@ -599,7 +618,7 @@ rp_image_const_ptr KhronosKTXPrivate::loadImage(int mip)
 					// TODO: Handle signed properly.
 					img = ImageDecoder::fromBC4(
 						width, height,
-						buf.get(), expected_size);
+						buf, expected_size);
 					// TODO: If this fails, return it anyway or return nullptr?
 					ImageDecoder::fromRed8ToL8(img);
 					break;
@@ -610,7 +629,7 @@ rp_image_const_ptr KhronosKTXPrivate::loadImage(int mip)
 					// TODO: Handle signed properly.
 					img = ImageDecoder::fromBC5(
 						width, height,
-						buf.get(), expected_size);
+						buf, expected_size);
 					// TODO: If this fails, return it anyway or return nullptr?
 					ImageDecoder::fromRG8ToLA8(img);
 					break;
@@ -620,35 +639,35 @@ rp_image_const_ptr KhronosKTXPrivate::loadImage(int mip)
 					// BPTC-compressed RGBA texture. (BC7)
 					img = ImageDecoder::fromBC7(
 						width, height,
-						buf.get(), expected_size);
+						buf, expected_size);
 					break;
 
 #ifdef ENABLE_PVRTC
 				case GL_COMPRESSED_RGB_PVRTC_2BPPV1_IMG:
 					// PVRTC, 2bpp, no alpha.
 					img = ImageDecoder::fromPVRTC(width, height,
-						buf.get(), expected_size,
+						buf, expected_size,
 						ImageDecoder::PVRTC_2BPP | ImageDecoder::PVRTC_ALPHA_NONE);
 					break;
 
 				case GL_COMPRESSED_RGBA_PVRTC_2BPPV1_IMG:
 					// PVRTC, 2bpp, has alpha.
 					img = ImageDecoder::fromPVRTC(width, height,
-						buf.get(), expected_size,
+						buf, expected_size,
 						ImageDecoder::PVRTC_2BPP | ImageDecoder::PVRTC_ALPHA_YES);
 					break;
 
 				case GL_COMPRESSED_RGB_PVRTC_4BPPV1_IMG:
 					// PVRTC, 4bpp, no alpha.
 					img = ImageDecoder::fromPVRTC(width, height,
-						buf.get(), expected_size,
+						buf, expected_size,
 						ImageDecoder::PVRTC_4BPP | ImageDecoder::PVRTC_ALPHA_NONE);
 					break;
 
 				case GL_COMPRESSED_RGBA_PVRTC_4BPPV1_IMG:
 					// PVRTC, 4bpp, has alpha.
 					img = ImageDecoder::fromPVRTC(width, height,
-						buf.get(), expected_size,
+						buf, expected_size,
 						ImageDecoder::PVRTC_4BPP | ImageDecoder::PVRTC_ALPHA_YES);
 					break;
 
@@ -656,7 +675,7 @@ rp_image_const_ptr KhronosKTXPrivate::loadImage(int mip)
 					// PVRTC-II, 2bpp.
 					// NOTE: Assuming this has alpha.
 					img = ImageDecoder::fromPVRTCII(width, height,
-						buf.get(), expected_size,
+						buf, expected_size,
 						ImageDecoder::PVRTC_2BPP | ImageDecoder::PVRTC_ALPHA_YES);
 					break;
 
@@ -664,7 +683,7 @@ rp_image_const_ptr KhronosKTXPrivate::loadImage(int mip)
 					// PVRTC-II, 4bpp.
 					// NOTE: Assuming this has alpha.
 					img = ImageDecoder::fromPVRTCII(width, height,
-						buf.get(), expected_size,
+						buf, expected_size,
 						ImageDecoder::PVRTC_4BPP | ImageDecoder::PVRTC_ALPHA_YES);
 					break;
 #endif /* ENABLE_PVRTC */
@@ -675,7 +694,7 @@ rp_image_const_ptr KhronosKTXPrivate::loadImage(int mip)
 					img = ImageDecoder::fromLinear32(
 						ImageDecoder::PixelFormat::RGB9_E5,
 						width, height,
-						reinterpret_cast<const uint32_t*>(buf.get()), expected_size);
+						reinterpret_cast<const uint32_t*>(buf), expected_size);
 					break;
 
 				default: {
@@ -702,7 +721,7 @@ rp_image_const_ptr KhronosKTXPrivate::loadImage(int mip)
 					// TODO: sRGB handling?
 					img = ImageDecoder::fromASTC(
 						width, height,
-						buf.get(), expected_size,
+						buf, expected_size,
 						ImageDecoder::astc_lkup_tbl[astc_idx][0],
 						ImageDecoder::astc_lkup_tbl[astc_idx][1]);
 #endif /* ENABLE_ASTC */
@@ -38,6 +38,11 @@ using LibRpText::rp_sprintf;
 #include "decoder/ImageDecoder_PVRTC.hpp"
 #include "decoder/ImageDecoder_ASTC.hpp"
 
+#ifdef ENABLE_ZSTD
+// Zstandard (KTX2 supercompression)
+#include <zstd.h>
+#endif /* ENABLE_ZSTD */
+
 // C++ STL classes
 using std::array;
 using std::string;
@@ -53,7 +58,11 @@ class KhronosKTX2Private final : public FileFormatPrivate
 {
 	public:
 		KhronosKTX2Private(KhronosKTX2 *q, const IRpFilePtr &file);
+#ifdef ENABLE_ZSTD
+		~KhronosKTX2Private() final;
+#else /* !ENABLE_ZSTD */
 		~KhronosKTX2Private() final = default;
+#endif /* ENABLE_ZSTD */
 
 	private:
 		typedef FileFormatPrivate super;
@@ -78,6 +87,13 @@ class KhronosKTX2Private final : public FileFormatPrivate
 		// Mipmap offsets
 		rp::uvector<KTX2_Mipmap_Index> mipmap_data;
 
+#ifdef ENABLE_ZSTD
+		// Zstd decompression context.
+		// Allocated on first use and reused for all mip levels
+		// to avoid per-level context setup costs.
+		ZSTD_DCtx *zstdDCtx;
+#endif /* ENABLE_ZSTD */
+
 		// Decoded mipmaps
 		// Mipmap 0 is the full image.
 		vector<rp_image_ptr> mipmaps;
@@ -135,6 +151,9 @@ const TextureInfo KhronosKTX2Private::textureInfo = {
 KhronosKTX2Private::KhronosKTX2Private(KhronosKTX2 *q, const IRpFilePtr &file)
 	: super(q, file, &textureInfo)
 	, flipOp(rp_image::FLIP_V)
+#ifdef ENABLE_ZSTD
+	, zstdDCtx(nullptr)
+#endif /* ENABLE_ZSTD */
 {
 	// Clear the KTX2 header struct.
 	memset(&ktx2Header, 0, sizeof(ktx2Header));
@@ -142,6 +161,14 @@ KhronosKTX2Private::KhronosKTX2Private(KhronosKTX2 *q, const IRpFilePtr &file)
 	memset(ktx_swizzle, 0, sizeof(ktx_swizzle));
 }
 
+#ifdef ENABLE_ZSTD
+KhronosKTX2Private::~KhronosKTX2Private()
+{
+	// NOTE: ZSTD_freeDCtx() accepts nullptr.
+	ZSTD_freeDCtx(zstdDCtx);
+}
+#endif /* ENABLE_ZSTD */
+
 /**
  * Load the image.
  * @param mip Mipmap number. (0 == full image)
@@ -176,10 +203,19 @@ rp_image_const_ptr KhronosKTX2Private::loadImage(int mip)
 		return nullptr;
 	}
 
-	// TODO: Support supercompression.
-	if (ktx2Header.supercompressionScheme != 0) {
+	// Supercompression: Zstd is supported if it's enabled at compile time.
+	// TODO: Support BasisU, zlib, and LZMA supercompression.
+#ifdef ENABLE_ZSTD
+	const bool isZstd = (ktx2Header.supercompressionScheme == KTX2_SUPERZ_ZSTD);
+	if (ktx2Header.supercompressionScheme != KTX2_SUPERZ_NONE && !isZstd) {
 		return nullptr;
 	}
+#else /* !ENABLE_ZSTD */
+	static constexpr bool isZstd = false;
+	if (ktx2Header.supercompressionScheme != KTX2_SUPERZ_NONE) {
+		return nullptr;
+	}
+#endif /* ENABLE_ZSTD */
 
 	// TODO: For VK_FORMAT_UNDEFINED, parse the DFD.
 	if (ktx2Header.vkFormat == VK_FORMAT_UNDEFINED) {
@@ -370,24 +406,69 @@ rp_image_const_ptr KhronosKTX2Private::loadImage(int mip)
 	}
 
 	// Verify mipmap size.
-	if (mipinfo.byteLength < expected_size) {
+	if (isZstd) {
+		// Sanity check: 128 MB limit for the uncompressed mip level.
+		if (mipinfo.uncompressedByteLength < expected_size ||
+		    mipinfo.uncompressedByteLength > 128U*1024U*1024U)
+		{
+			// Mipmap level is too small, or implausibly large.
+			return nullptr;
+		}
+	} else if (mipinfo.byteLength < expected_size) {
 		// Mipmap level is too small.
 		// TODO: Should we require the exact size?
 		return nullptr;
 	}
 
 	// Verify file size.
-	if (mipinfo.byteOffset + expected_size > file_sz) {
+	const uint64_t phys_size = (isZstd) ? mipinfo.byteLength : expected_size;
+	if (mipinfo.byteOffset + phys_size > file_sz) {
 		// File is too small.
 		return nullptr;
 	}
 
 	// Read the texture data.
-	auto buf = aligned_uptr<uint8_t>(16, expected_size);
-	size_t size = file->read(buf.get(), expected_size);
-	if (size != expected_size) {
-		// Read error.
-		return nullptr;
+	// NOTE: For Zstd-supercompressed files, the buffer needs to hold
+	// the full uncompressed mip level, which may be larger than the
+	// expected image size.
+	const size_t alloc_size = (isZstd)
+		? static_cast<size_t>(mipinfo.uncompressedByteLength)
+		: expected_size;
+	AlignedArenaScope arena;
+	uint8_t *const buf = arena.alloc<uint8_t>(16, alloc_size);
+#ifdef ENABLE_ZSTD
+	if (isZstd) {
+		// Read and decompress the mip level.
+		const size_t z_len = static_cast<size_t>(mipinfo.byteLength);
+		uint8_t *const z_buf = arena.alloc<uint8_t>(16, z_len);
+		size_t size = file->read(z_buf, z_len);
+		if (size != z_len) {
+			// Read error.
+			return nullptr;
+		}
+
+		if (!zstdDCtx) {
+			zstdDCtx = ZSTD_createDCtx();
+			assert(zstdDCtx != nullptr);
+			if (!zstdDCtx) {
+				// Could not create a decompression context.
+				return nullptr;
+			}
+		}
+		const size_t z_size = ZSTD_decompressDCtx(zstdDCtx,
+			buf, alloc_size, z_buf, z_len);
+		if (ZSTD_isError(z_size) || z_size < expected_size) {
+			// Decompression error.
+			return nullptr;
+		}
+	} else
+#endif /* ENABLE_ZSTD */
+	{
+		size_t size = file->read(buf, expected_size);
+		if (size != expected_size) {
+			// Read error.
+			return nullptr;
+		}
 	}
 
 	// TODO: Handle sRGB post-processing? (for e.g. GL_SRGB8)
@@ -399,7 +480,7 @@ rp_image_const_ptr KhronosKTX2Private::loadImage(int mip)
 			// 24-bit RGB
 			img = ImageDecoder::fromLinear24(
 				ImageDecoder::PixelFormat::BGR888, width, height,
-				buf.get(), expected_size, stride);
+				buf, expected_size, stride);
 			break;
 
 		case VK_FORMAT_B8G8R8_UNORM:
@@ -408,7 +489,7 @@ rp_image_const_ptr KhronosKTX2Private::loadImage(int mip)
 			// 24-bit RGB (R/B swapped)
 			img = ImageDecoder::fromLinear24(
 				ImageDecoder::PixelFormat::RGB888, width, height,
-				buf.get(), expected_size, stride);
+				buf, expected_size, stride);
 			break;
 
 		case VK_FORMAT_R8G8B8A8_UNORM:
@@ -417,7 +498,7 @@ rp_image_const_ptr KhronosKTX2Private::loadImage(int mip)
 			// 32-bit RGBA
 			img = ImageDecoder::fromLinear32(
 				ImageDecoder::PixelFormat::ABGR8888, width, height,
-				reinterpret_cast<const uint32_t*>(buf.get()), expected_size, stride);
+				reinterpret_cast<const uint32_t*>(buf), expected_size, stride);
 			break;
 
 		case VK_FORMAT_B8G8R8A8_UNORM:
@@ -426,7 +507,7 @@ rp_image_const_ptr KhronosKTX2Private::loadImage(int mip)
 			// 32-bit RGBA (R/B swapped)
 			img = ImageDecoder::fromLinear32(
 				ImageDecoder::PixelFormat::ARGB8888, width, height,
-				reinterpret_cast<const uint32_t*>(buf.get()), expected_size, stride);
+				reinterpret_cast<const uint32_t*>(buf), expected_size, stride);
 			break;
 
 		case VK_FORMAT_R8_UNORM:
@@ -435,7 +516,7 @@ rp_image_const_ptr KhronosKTX2Private::loadImage(int mip)
 			// 8-bit (red)
 			img = ImageDecoder::fromLinear8(
 				ImageDecoder::PixelFormat::R8, width, height,
-				buf.get(), expected_size, stride);
+				buf, expected_size, stride);
 			break;
 
 		case VK_FORMAT_R8G8_UNORM:
@@ -444,14 +525,14 @@ rp_image_const_ptr KhronosKTX2Private::loadImage(int mip)
 			// 16-bit (red/green; may also be luminance/alpha)
 			img = ImageDecoder::fromLinear16(
 				ImageDecoder::PixelFormat::GR88, width, height,
-				reinterpret_cast<const uint16_t*>(buf.get()), expected_size, stride);
+				reinterpret_cast<const uint16_t*>(buf), expected_size, stride);
 			break;
 
 		case VK_FORMAT_E5B9G9R9_UFLOAT_PACK32:
 			// Uncompressed "special" 32bpp formats.
 			img = ImageDecoder::fromLinear32(
 				ImageDecoder::PixelFormat::RGB9_E5, width, height,
-				reinterpret_cast<const uint32_t*>(buf.get()), expected_size, stride);
+				reinterpret_cast<const uint32_t*>(buf), expected_size, stride);
 			break;
 
 		// Compressed formats.
@@ -463,7 +544,7 @@ rp_image_const_ptr KhronosKTX2Private::loadImage(int mip)
 			// DXT1-compressed texture.
 			img = ImageDecoder::fromDXT1(
 				width, height,
-				buf.get(), expected_size);
+				buf, expected_size);
 			break;
 
 		case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
@@ -471,7 +552,7 @@ rp_image_const_ptr KhronosKTX2Private::loadImage(int mip)
 			// DXT1-compressed texture with 1-bit alpha.
 			img = ImageDecoder::fromDXT1_A1(
 				width, height,
-				buf.get(), expected_size);
+				buf, expected_size);
 			break;
 
 		case VK_FORMAT_BC2_UNORM_BLOCK:
@@ -479,7 +560,7 @@ rp_image_const_ptr KhronosKTX2Private::loadImage(int mip)
 			// DXT3-compressed texture.
 			img = ImageDecoder::fromDXT3(
 				width, height,
-				buf.get(), expected_size);
+				buf, expected_size);
 			break;
 
 		case VK_FORMAT_BC3_UNORM_BLOCK:
@@ -487,7 +568,7 @@ rp_image_const_ptr KhronosKTX2Private::loadImage(int mip)
 			// DXT5-compressed texture.
 			img = ImageDecoder::fromDXT5(
 				width, height,
-				buf.get(), expected_size);
+				buf, expected_size);
 			break;
 
 		case VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK:
@@ -496,7 +577,7 @@ rp_image_const_ptr KhronosKTX2Private::loadImage(int mip)
 			// TODO: Handle sRGB.
 			img = ImageDecoder::fromETC2_RGB(
 				width, height,
-				buf.get(), expected_size);
+				buf, expected_size);
 			break;
 
 		case VK_FORMAT_ETC2_R8G8B8A1_UNORM_BLOCK:
@@ -506,7 +587,7 @@ rp_image_const_ptr KhronosKTX2Private::loadImage(int mip)
 			// TODO: Handle sRGB.
 			img = ImageDecoder::fromETC2_RGB_A1(
 				width, height,
-				buf.get(), expected_size);
+				buf, expected_size);
 			break;
 
 		case VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK:
@@ -516,7 +597,7 @@ rp_image_const_ptr KhronosKTX2Private::loadImage(int mip)
 			// TODO: Handle sRGB.
 			img = ImageDecoder::fromETC2_RGBA(
 				width, height,
-				buf.get(), expected_size);
+				buf, expected_size);
 			break;
 
 		case VK_FORMAT_EAC_R11_UNORM_BLOCK:
@@ -525,7 +606,7 @@ rp_image_const_ptr KhronosKTX2Private::loadImage(int mip)
 			// TODO: Does the signed version get decoded differently?
 			img = ImageDecoder::fromEAC_R11(
 				width, height,
-				buf.get(), expected_size);
+				buf, expected_size);
 			break;
 
 		case VK_FORMAT_EAC_R11G11_UNORM_BLOCK:
@@ -534,7 +615,7 @@ rp_image_const_ptr KhronosKTX2Private::loadImage(int mip)
 			// TODO: Does the signed version get decoded differently?
 			img = ImageDecoder::fromEAC_RG11(
 				width, height,
-				buf.get(), expected_size);
+				buf, expected_size);
 			break;
 
 		case VK_FORMAT_BC7_UNORM_BLOCK:
@@ -542,7 +623,7 @@ rp_image_const_ptr KhronosKTX2Private::loadImage(int mip)
 			// BPTC-compressed RGBA texture. (BC7)
 			img = ImageDecoder::fromBC7(
 				width, height,
-				buf.get(), expected_size);
+				buf, expected_size);
 			break;
 
 #ifdef ENABLE_PVRTC
@@ -553,7 +634,7 @@ rp_image_const_ptr KhronosKTX2Private::loadImage(int mip)
 		case VK_FORMAT_PVRTC1_2BPP_SRGB_BLOCK_IMG:
 			// PVRTC, 2bpp.
 			img = ImageDecoder::fromPVRTC(width, height,
-				buf.get(), expected_size,
+				buf, expected_size,
 				ImageDecoder::PVRTC_2BPP | ImageDecoder::PVRTC_ALPHA_YES);
 			break;
 
@@ -561,7 +642,7 @@ rp_image_const_ptr KhronosKTX2Private::loadImage(int mip)
 		case VK_FORMAT_PVRTC1_4BPP_SRGB_BLOCK_IMG:
 			// PVRTC, 4bpp.
 			img = ImageDecoder::fromPVRTC(width, height,
-				buf.get(), expected_size,
+				buf, expected_size,
 				ImageDecoder::PVRTC_4BPP | ImageDecoder::PVRTC_ALPHA_YES);
 			break;
 
@@ -569,7 +650,7 @@ rp_image_const_ptr KhronosKTX2Private::loadImage(int mip)
 		case VK_FORMAT_PVRTC2_2BPP_SRGB_BLOCK_IMG:
 			// PVRTC-II, 2bpp.
 			img = ImageDecoder::fromPVRTCII(width, height,
-				buf.get(), expected_size,
+				buf, expected_size,
 				ImageDecoder::PVRTC_2BPP | ImageDecoder::PVRTC_ALPHA_YES);
 			break;
 
@@ -578,7 +659,7 @@ rp_image_const_ptr KhronosKTX2Private::loadImage(int mip)
 			// PVRTC-II, 4bpp.
 			// NOTE: Assuming this has alpha.
 			img = ImageDecoder::fromPVRTCII(width, height,
-				buf.get(), expected_size,
+				buf, expected_size,
 				ImageDecoder::PVRTC_4BPP | ImageDecoder::PVRTC_ALPHA_YES);
 			break;
 #endif /* ENABLE_PVRTC */
@@ -593,7 +674,7 @@ rp_image_const_ptr KhronosKTX2Private::loadImage(int mip)
 					ARRAY_SIZE(ImageDecoder::astc_lkup_tbl), "ASTC lookup table size is wrong!");
 				const unsigned int astc_idx = (ktx2Header.vkFormat - VK_FORMAT_ASTC_4x4_UNORM_BLOCK) / 2;
 				img = ImageDecoder::fromASTC(width, height,
-					buf.get(), expected_size,
+					buf, expected_size,
 					ImageDecoder::astc_lkup_tbl[astc_idx][0],
 					ImageDecoder::astc_lkup_tbl[astc_idx][1]);
 				break;
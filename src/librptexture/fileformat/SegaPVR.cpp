@@ -611,8 +611,9 @@ rp_image_const_ptr SegaPVRPrivate::loadPvrImage(void)
 	}
 
 	// Read the texture data.
-	auto buf = aligned_uptr<uint8_t>(16, expected_size);
-	size_t size = file->read(buf.get(), expected_size);
+	AlignedArenaScope arena;
+	uint8_t *const buf = arena.alloc<uint8_t>(16, expected_size);
+	size_t size = file->read(buf, expected_size);
 	if (size != expected_size) {
 		// Read error.
 		return nullptr;
@@ -651,7 +652,7 @@ rp_image_const_ptr SegaPVRPrivate::loadPvrImage(void)
 		case PVR_IMG_SQUARE_TWIDDLED_MIPMAP_ALT:
 			img = ImageDecoder::fromDreamcastSquareTwiddled16(px_format,
 				pvrHeader.width, pvrHeader.height,
-				reinterpret_cast<const uint16_t*>(buf.get()), expected_size);
+				reinterpret_cast<const uint16_t*>(buf), expected_size);
 			break;
 
 		case PVR_IMG_RECTANGLE:
@@ -660,11 +661,11 @@ rp_image_const_ptr SegaPVRPrivate::loadPvrImage(void)
 			if (is32bit) {
 				img = ImageDecoder::fromLinear32(px_format,
 					pvrHeader.width, pvrHeader.height,
-					reinterpret_cast<const uint32_t*>(buf.get()), expected_size);
+					reinterpret_cast<const uint32_t*>(buf), expected_size);
 			} else {
 				img = ImageDecoder::fromLinear16(px_format,
 					pvrHeader.width, pvrHeader.height,
-					reinterpret_cast<uint16_t*>(buf.get()), expected_size);
+					reinterpret_cast<uint16_t*>(buf), expected_size);
 			}
 
 			if (pvrHeader.pvr.img_data_type == SVR_IMG_RECTANGLE_SWIZZLED) {
@@ -685,8 +686,8 @@ rp_image_const_ptr SegaPVRPrivate::loadPvrImage(void)
 		case PVR_IMG_VQ: {
 			// VQ images have a 1024-entry palette.
 			static constexpr size_t pal_siz = 1024U * 2U;
-			const uint16_t *const pal_buf = reinterpret_cast<const uint16_t*>(buf.get());
-			const uint8_t *const img_buf = buf.get() + pal_siz;
+			const uint16_t *const pal_buf = reinterpret_cast<const uint16_t*>(buf);
+			const uint8_t *const img_buf = buf + pal_siz;
 			const size_t img_siz = expected_size - pal_siz;
 
 			img = ImageDecoder::fromDreamcastVQ16(px_format,
@@ -710,7 +711,7 @@ rp_image_const_ptr SegaPVRPrivate::loadPvrImage(void)
 			img = ImageDecoder::fromDreamcastVQ16(px_format,
 				false, true,
 				pvrHeader.width, pvrHeader.height,
-				buf.get(), expected_size, pal_buf.get(), pal_siz);
+				buf, expected_size, pal_buf.get(), pal_siz);
 			break;
 		}
 
@@ -718,8 +719,8 @@ rp_image_const_ptr SegaPVRPrivate::loadPvrImage(void)
 			// Small VQ images have up to 1024 palette entries based on width.
 			const size_t pal_siz =
 				ImageDecoder::calcDreamcastSmallVQPaletteEntries_NoMipmaps(pvrHeader.width) * 2;
-			const uint16_t *const pal_buf = reinterpret_cast<const uint16_t*>(buf.get());
-			const uint8_t *const img_buf = buf.get() + pal_siz;
+			const uint16_t *const pal_buf = reinterpret_cast<const uint16_t*>(buf);
+			const uint8_t *const img_buf = buf + pal_siz;
 			const size_t img_siz = expected_size - pal_siz;
 
 			img = ImageDecoder::fromDreamcastVQ16(px_format,
@@ -741,7 +742,7 @@ rp_image_const_ptr SegaPVRPrivate::loadPvrImage(void)
 			img = ImageDecoder::fromDreamcastVQ16(px_format,
 				true, true,
 				pvrHeader.width, pvrHeader.height,
-				buf.get(), expected_size,
+				buf, expected_size,
 				reinterpret_cast<const uint16_t*>(svr_pal_buf.data()), (int)svr_pal_buf.size());
 			break;
 		}
@@ -770,7 +771,7 @@ rp_image_const_ptr SegaPVRPrivate::loadPvrImage(void)
 			// Least-significant nybble is first.
 			img = ImageDecoder::fromLinearCI4(px_format, false,
 				pvrHeader.width, pvrHeader.height,
-				buf.get(), expected_size,
+				buf, expected_size,
 				svr_pal_buf.data(), (int)svr_pal_buf.size());
 
 			// Puyo Tools: Minimum swizzle size for 4-bit is 128x128.
@@ -808,7 +809,7 @@ rp_image_const_ptr SegaPVRPrivate::loadPvrImage(void)
 			// in order to maintain the original palette ordering.
 			// TODO: Expand to uint64_t and/or SSE2?
 			assert(expected_size % 4 == 0);
-			uint32_t *bits = reinterpret_cast<uint32_t*>(buf.get());
+			uint32_t *bits = reinterpret_cast<uint32_t*>(buf);
 			uint32_t *const bits_end = bits + (expected_size / sizeof(uint32_t));
 			for (; bits < bits_end; bits++) {
 				const uint32_t sw = (*bits & 0xE7E7E7E7);
@@ -820,7 +821,7 @@ rp_image_const_ptr SegaPVRPrivate::loadPvrImage(void)
 			// Least-significant nybble is first.
 			img = ImageDecoder::fromLinearCI8(px_format,
 				pvrHeader.width, pvrHeader.height,
-				buf.get(), expected_size,
+				buf, expected_size,
 				svr_pal_buf.data(), (int)svr_pal_buf.size());
 
 			// Puyo Tools: Minimum swizzle size for 8-bit is 128x64.
@@ -922,8 +923,9 @@ rp_image_const_ptr SegaPVRPrivate::loadGvrImage(void)
 	}
 
 	// Read the texture data.
-	auto buf = aligned_uptr<uint8_t>(16, expected_size);
-	size_t size = file->read(buf.get(), expected_size);
+	AlignedArenaScope arena;
+	uint8_t *const buf = arena.alloc<uint8_t>(16, expected_size);
+	size_t size = file->read(buf, expected_size);
 	if (size != expected_size) {
 		// Read error.
 		return nullptr;
@@ -934,7 +936,7 @@ rp_image_const_ptr SegaPVRPrivate::loadGvrImage(void)
 			// FIXME: Untested.
 			img = ImageDecoder::fromGcnI8(
 				pvrHeader.width, pvrHeader.height,
-				buf.get(), expected_size);
+				buf, expected_size);
 			break;
 
 		case GVR_IMG_IA8:
@@ -942,7 +944,7 @@ rp_image_const_ptr SegaPVRPrivate::loadGvrImage(void)
 			img = ImageDecoder::fromGcn16(
 				ImageDecoder::PixelFormat::IA8,
 				pvrHeader.width, pvrHeader.height,
-				reinterpret_cast<uint16_t*>(buf.get()), expected_size);
+				reinterpret_cast<uint16_t*>(buf), expected_size);
 			break;
 
 		case GVR_IMG_RGB565:
@@ -950,14 +952,14 @@ rp_image_const_ptr SegaPVRPrivate::loadGvrImage(void)
 			img = ImageDecoder::fromGcn16(
 				ImageDecoder::PixelFormat::RGB565,
 				pvrHeader.width, pvrHeader.height,
-				reinterpret_cast<uint16_t*>(buf.get()), expected_size);
+				reinterpret_cast<uint16_t*>(buf), expected_size);
 			break;
 
 		case GVR_IMG_RGB5A3:
 			img = ImageDecoder::fromGcn16(
 				ImageDecoder::PixelFormat::RGB5A3,
 				pvrHeader.width, pvrHeader.height,
-				reinterpret_cast<uint16_t*>(buf.get()), expected_size);
+				reinterpret_cast<uint16_t*>(buf), expected_size);
 			break;
 
 		case GVR_IMG_CI4: {
@@ -969,7 +971,7 @@ rp_image_const_ptr SegaPVRPrivate::loadGvrImage(void)
 			}
 			img = ImageDecoder::fromGcnCI4(
 				pvrHeader.width, pvrHeader.height,
-				buf.get(), expected_size,
+				buf, expected_size,
 				rgb5a3, sizeof(rgb5a3));
 			break;
 		}
@@ -985,7 +987,7 @@ rp_image_const_ptr SegaPVRPrivate::loadGvrImage(void)
 			// FIXME: Untested.
 			img = ImageDecoder::fromGcnCI8(
 				pvrHeader.width, pvrHeader.height,
-				buf.get(), expected_size,
+				buf, expected_size,
 				rgb5a3, sizeof(rgb5a3));
 			break;
 		}
@@ -994,7 +996,7 @@ rp_image_const_ptr SegaPVRPrivate::loadGvrImage(void)
 			// TODO: Determine if color 3 should be black or transparent.
 			img = ImageDecoder::fromDXT1_GCN(
 				pvrHeader.width, pvrHeader.height,
-				buf.get(), expected_size);
+				buf, expected_size);
 			break;
 
 		default:
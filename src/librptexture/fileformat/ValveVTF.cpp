@@ -75,6 +75,9 @@ class ValveVTFPrivate final : public FileFormatPrivate
 		};
 		vector<mipmap_data_t> mipmap_data;
 
+		// Decoded low-resolution image. (embedded thumbnail)
+		rp_image_ptr img_lowRes;
+
 		// Invalid pixel format message
 		char invalid_pixel_format[24];
 
@@ -105,6 +108,18 @@ class ValveVTFPrivate final : public FileFormatPrivate
 		 * @return Image, or nullptr on error.
 		 */
 		rp_image_const_ptr loadImage(int mip);
+
+		/**
+		 * Load the low-resolution image. (embedded thumbnail)
+		 *
+		 * VTF files carry a dedicated low-res image (usually DXT1,
+		 * max 16x16) intended for in-game material previews.
+		 * Decoding it is significantly cheaper than decoding the
+		 * full-size image for small thumbnails.
+		 *
+		 * @return Image, or nullptr on error.
+		 */
+		rp_image_const_ptr loadLowResImage(void);
 };
 
 FILEFORMAT_IMPL(ValveVTF)
@@ -416,8 +431,9 @@ rp_image_const_ptr ValveVTFPrivate::loadImage(int mip)
 	}
 
 	// Read the texture data.
-	auto buf = aligned_uptr<uint8_t>(16, mdata.size);
-	size_t size = file->seekAndRead(mdata.addr, buf.get(), mdata.size);
+	AlignedArenaScope arena;
+	uint8_t *const buf = arena.alloc<uint8_t>(16, mdata.size);
+	size_t size = file->seekAndRead(mdata.addr, buf, mdata.size);
 	if (size != mdata.size) {
 		// Read error.
 		return nullptr;
@@ -440,14 +456,14 @@ rp_image_const_ptr ValveVTFPrivate::loadImage(int mip)
 			img = ImageDecoder::fromLinear32(
 				ImageDecoder::PixelFormat::ABGR8888,
 				mdata.width, mdata.height,
-				reinterpret_cast<const uint32_t*>(buf.get()), mdata.size,
+				reinterpret_cast<const uint32_t*>(buf), mdata.size,
 				mdata.row_width * sizeof(uint32_t));
 			break;
 		case VTF_IMAGE_FORMAT_ABGR8888:
 			img = ImageDecoder::fromLinear32(
 				ImageDecoder::PixelFormat::RGBA8888,
 				mdata.width, mdata.height,
-				reinterpret_cast<const uint32_t*>(buf.get()), mdata.size,
+				reinterpret_cast<const uint32_t*>(buf), mdata.size,
 				mdata.row_width * sizeof(uint32_t));
 			break;
 		case VTF_IMAGE_FORMAT_ARGB8888:
@@ -456,21 +472,21 @@ rp_image_const_ptr ValveVTFPrivate::loadImage(int mip)
 			img = ImageDecoder::fromLinear32(
 				ImageDecoder::PixelFormat::RABG8888,
 				mdata.width, mdata.height,
-				reinterpret_cast<const uint32_t*>(buf.get()), mdata.size,
+				reinterpret_cast<const uint32_t*>(buf), mdata.size,
 				mdata.row_width * sizeof(uint32_t));
 			break;
 		case VTF_IMAGE_FORMAT_BGRA8888:
 			img = ImageDecoder::fromLinear32(
 				ImageDecoder::PixelFormat::ARGB8888,
 				mdata.width, mdata.height,
-				reinterpret_cast<const uint32_t*>(buf.get()), mdata.size,
+				reinterpret_cast<const uint32_t*>(buf), mdata.size,
 				mdata.row_width * sizeof(uint32_t));
 			break;
 		case VTF_IMAGE_FORMAT_BGRx8888:
 			img = ImageDecoder::fromLinear32(
 				ImageDecoder::PixelFormat::xRGB8888,
 				mdata.width, mdata.height,
-				reinterpret_cast<const uint32_t*>(buf.get()), mdata.size,
+				reinterpret_cast<const uint32_t*>(buf), mdata.size,
 				mdata.row_width * sizeof(uint32_t));
 			break;
 
@@ -479,21 +495,21 @@ rp_image_const_ptr ValveVTFPrivate::loadImage(int mip)
 			img = ImageDecoder::fromLinear24(
 				ImageDecoder::PixelFormat::BGR888,
 				mdata.width, mdata.height,
-				buf.get(), mdata.size,
+				buf, mdata.size,
 				mdata.row_width * 3);
 			break;
 		case VTF_IMAGE_FORMAT_BGR888:
 			img = ImageDecoder::fromLinear24(
 				ImageDecoder::PixelFormat::RGB888,
 				mdata.width, mdata.height,
-				buf.get(), mdata.size,
+				buf, mdata.size,
 				mdata.row_width * 3);
 			break;
 		case VTF_IMAGE_FORMAT_RGB888_BLUESCREEN:
 			img = ImageDecoder::fromLinear24(
 				ImageDecoder::PixelFormat::BGR888,
 				mdata.width, mdata.height,
-				buf.get(), mdata.size,
+				buf, mdata.size,
 				mdata.row_width * 3);
 			img->apply_chroma_key(0xFF0000FF);
 			break;
@@ -501,7 +517,7 @@ rp_image_const_ptr ValveVTFPrivate::loadImage(int mip)
 			img = ImageDecoder::fromLinear24(
 				ImageDecoder::PixelFormat::RGB888,
 				mdata.width, mdata.height,
-				buf.get(), mdata.size,
+				buf, mdata.size,
 				mdata.row_width * 3);
 			img->apply_chroma_key(0xFF0000FF);
 			break;
@@ -511,35 +527,35 @@ rp_image_const_ptr ValveVTFPrivate::loadImage(int mip)
 			img = ImageDecoder::fromLinear16(
 				ImageDecoder::PixelFormat::BGR565,
 				mdata.width, mdata.height,
-				reinterpret_cast<const uint16_t*>(buf.get()), mdata.size,
+				reinterpret_cast<const uint16_t*>(buf), mdata.size,
 				mdata.row_width * sizeof(uint16_t));
 			break;
 		case VTF_IMAGE_FORMAT_BGR565:
 			img = ImageDecoder::fromLinear16(
 				ImageDecoder::PixelFormat::RGB565,
 				mdata.width, mdata.height,
-				reinterpret_cast<const uint16_t*>(buf.get()), mdata.size,
+				reinterpret_cast<const uint16_t*>(buf), mdata.size,
 				mdata.row_width * sizeof(uint16_t));
 			break;
 		case VTF_IMAGE_FORMAT_BGRx5551:
 			img = ImageDecoder::fromLinear16(
 				ImageDecoder::PixelFormat::RGB555,
 				mdata.width, mdata.height,
-				reinterpret_cast<const uint16_t*>(buf.get()), mdata.size,
+				reinterpret_cast<const uint16_t*>(buf), mdata.size,
 				mdata.row_width * sizeof(uint16_t));
 			break;
 		case VTF_IMAGE_FORMAT_BGRA4444:
 			img = ImageDecoder::fromLinear16(
 				ImageDecoder::PixelFormat::ARGB4444,
 				mdata.width, mdata.height,
-				reinterpret_cast<const uint16_t*>(buf.get()), mdata.size,
+				reinterpret_cast<const uint16_t*>(buf), mdata.size,
 				mdata.row_width * sizeof(uint16_t));
 			break;
 		case VTF_IMAGE_FORMAT_BGRA5551:
 			img = ImageDecoder::fromLinear16(
 				ImageDecoder::PixelFormat::ARGB1555,
 				mdata.width, mdata.height,
-				reinterpret_cast<const uint16_t*>(buf.get()), mdata.size,
+				reinterpret_cast<const uint16_t*>(buf), mdata.size,
 				mdata.row_width * sizeof(uint16_t));
 			break;
 		case VTF_IMAGE_FORMAT_IA88:
@@ -552,7 +568,7 @@ rp_image_const_ptr ValveVTFPrivate::loadImage(int mip)
 			img = ImageDecoder::fromLinear16(
 				ImageDecoder::PixelFormat::A8L8,
 				mdata.width, mdata.height,
-				reinterpret_cast<const uint16_t*>(buf.get()), mdata.size,
+				reinterpret_cast<const uint16_t*>(buf), mdata.size,
 				mdata.row_width * sizeof(uint16_t));
 			break;
 		case VTF_IMAGE_FORMAT_UV88:
@@ -560,7 +576,7 @@ rp_image_const_ptr ValveVTFPrivate::loadImage(int mip)
 			img = ImageDecoder::fromLinear16(
 				ImageDecoder::PixelFormat::GR88,
 				mdata.width, mdata.height,
-				reinterpret_cast<const uint16_t*>(buf.get()), mdata.size,
+				reinterpret_cast<const uint16_t*>(buf), mdata.size,
 				mdata.row_width * sizeof(uint16_t));
 			break;
 
@@ -572,14 +588,14 @@ rp_image_const_ptr ValveVTFPrivate::loadImage(int mip)
 			img = ImageDecoder::fromLinear8(
 				ImageDecoder::PixelFormat::L8,
 				mdata.width, mdata.height,
-				buf.get(), mdata.size,
+				buf, mdata.size,
 				mdata.row_width);
 			break;
 		case VTF_IMAGE_FORMAT_A8:
 			img = ImageDecoder::fromLinear8(
 				ImageDecoder::PixelFormat::A8,
 				mdata.width, mdata.height,
-				buf.get(), mdata.size,
+				buf, mdata.size,
 				mdata.row_width);
 			break;
 
@@ -587,22 +603,22 @@ rp_image_const_ptr ValveVTFPrivate::loadImage(int mip)
 		case VTF_IMAGE_FORMAT_DXT1:
 			img = ImageDecoder::fromDXT1(
 				mdata.width, mdata.height,
-				buf.get(), mdata.size);
+				buf, mdata.size);
 			break;
 		case VTF_IMAGE_FORMAT_DXT1_ONEBITALPHA:
 			img = ImageDecoder::fromDXT1_A1(
 				mdata.width, mdata.height,
-				buf.get(), mdata.size);
+				buf, mdata.size);
 			break;
 		case VTF_IMAGE_FORMAT_DXT3:
 			img = ImageDecoder::fromDXT3(
 				mdata.width, mdata.height,
-				buf.get(), mdata.size);
+				buf, mdata.size);
 			break;
 		case VTF_IMAGE_FORMAT_DXT5:
 			img = ImageDecoder::fromDXT5(
 				mdata.width, mdata.height,
-				buf.get(), mdata.size);
+				buf, mdata.size);
 			break;
 
 		case VTF_IMAGE_FORMAT_P8:
@@ -617,6 +633,63 @@ rp_image_const_ptr ValveVTFPrivate::loadImage(int mip)
 	return img;
 }
 
+/**
+ * Load the low-resolution image. (embedded thumbnail)
+ *
+ * VTF files carry a dedicated low-res image (usually DXT1,
+ * max 16x16) intended for in-game material previews.
+ * Decoding it is significantly cheaper than decoding the
+ * full-size image for small thumbnails.
+ *
+ * @return Image, or nullptr on error.
+ */
+rp_image_const_ptr ValveVTFPrivate::loadLowResImage(void)
+{
+	if (img_lowRes) {
+		// Image has already been loaded.
+		return img_lowRes;
+	} else if (!this->isValid || !this->file) {
+		// Can't load the image.
+		return nullptr;
+	}
+
+	// NOTE: The low-res image is always the first texture data,
+	// immediately after the header. (getMipmapInfo() skips it.)
+	// The spec says it's always DXT1; we don't support other formats.
+	const int w = vtfHeader.lowResImageWidth;
+	const int h = (vtfHeader.lowResImageHeight > 0 ? vtfHeader.lowResImageHeight : 1);
+	if (vtfHeader.lowResImageFormat != VTF_IMAGE_FORMAT_DXT1 || w == 0) {
+		// No low-res image, or not DXT1.
+		return nullptr;
+	}
+
+	const unsigned int lowRes_size = ImageSizeCalc::calcImageSize_tbl(
+		op_tbl.data(), op_tbl.size(), vtfHeader.lowResImageFormat, w, h);
+	if (lowRes_size == 0) {
+		// Invalid image size.
+		return nullptr;
+	}
+
+	// Low-res image cannot start inside of the VTF header.
+	assert(texDataStartAddr >= sizeof(vtfHeader));
+	if (texDataStartAddr < sizeof(vtfHeader)) {
+		// Invalid texture data start address.
+		return nullptr;
+	}
+
+	// Read the low-res image data.
+	AlignedArenaScope arena;
+	uint8_t *const buf = arena.alloc<uint8_t>(16, lowRes_size);
+	size_t size = file->seekAndRead(texDataStartAddr, buf, lowRes_size);
+	if (size != lowRes_size) {
+		// Read error.
+		return nullptr;
+	}
+
+	img_lowRes = ImageDecoder::fromDXT1(w, h, buf, lowRes_size);
+	return img_lowRes;
+}
+
 /** ValveVTF **/
 
 /**
@@ -939,4 +1012,37 @@ rp_image_const_ptr ValveVTF::mipmap(int mip) const
 	return const_cast<ValveVTFPrivate*>(d)->loadImage(mip);
 }
 
+/**
+ * Get the smallest mipmap with both dimensions >= the specified size.
+ *
+ * VTF: If the embedded low-res image is big enough for the requested
+ * size, use it instead of decoding the high-res image. This skips
+ * most of the decode work for small thumbnails.
+ *
+ * @param size Minimum dimension, in pixels.
+ * @return Image, or nullptr on error.
+ */
+rp_image_const_ptr ValveVTF::loadClosestMip(int size) const
+{
+	RP_D(const ValveVTF);
+	assert(size > 0);
+	if (size <= 0) {
+		return nullptr;
+	}
+
+	if (d->isValid &&
+	    d->vtfHeader.lowResImageWidth >= size &&
+	    d->vtfHeader.lowResImageHeight >= size)
+	{
+		// The low-res image is big enough for the requested size.
+		rp_image_const_ptr img = const_cast<ValveVTFPrivate*>(d)->loadLowResImage();
+		if (img) {
+			return img;
+		}
+		// Couldn't load the low-res image; fall back to the main image.
+	}
+
+	return super::loadClosestMip(size);
+}
+
 }
@@ -14,6 +14,7 @@ namespace LibRpTexture {
 
 FILEFORMAT_DECL_BEGIN(ValveVTF)
 FILEFORMAT_DECL_MIPMAP()
+FILEFORMAT_DECL_CLOSEST_MIP()
 FILEFORMAT_DECL_END()
 
 }
@@ -168,8 +168,9 @@ rp_image_const_ptr ValveVTF3Private::loadImage(void)
 	}
 
 	// Read the texture data.
-	auto buf = aligned_uptr<uint8_t>(16, expected_size);
-	size_t size = file->read(buf.get(), expected_size);
+	AlignedArenaScope arena;
+	uint8_t *const buf = arena.alloc<uint8_t>(16, expected_size);
+	size_t size = file->read(buf, expected_size);
 	if (size != expected_size) {
 		// Read error.
 		return nullptr;
@@ -181,13 +182,13 @@ rp_image_const_ptr ValveVTF3Private::loadImage(void)
 		// Encoded using DXT5.
 		img = ImageDecoder::fromDXT5(
 			vtf3Header.width, height,
-			buf.get(), expected_size);
+			buf, expected_size);
 	} else {
 		// Image does not have an alpha channel.
 		// Encoded using DXT1.
 		img = ImageDecoder::fromDXT1(
 			vtf3Header.width, height,
-			buf.get(), expected_size);
+			buf, expected_size);
 	}
 
 	return img;
@@ -452,8 +452,9 @@ rp_image_const_ptr XboxXPRPrivate::loadXboxXPR0Image(void)
 	}
 
 	// Read the image data.
-	auto buf = aligned_uptr<uint8_t>(16, expected_size);
-	size_t size = file->seekAndRead(data_offset, buf.get(), expected_size);
+	AlignedArenaScope arena;
+	uint8_t *const buf = arena.alloc<uint8_t>(16, expected_size);
+	size_t size = file->seekAndRead(data_offset, buf, expected_size);
 	if (size != expected_size) {
 		// Seek and/or read error.
 		return nullptr;
@@ -465,15 +466,15 @@ rp_image_const_ptr XboxXPRPrivate::loadXboxXPR0Image(void)
 			case 1:
 				// NOTE: Assuming we have transparent pixels.
 				img = ImageDecoder::fromDXT1_A1(width, height,
-					buf.get(), expected_size);
+					buf, expected_size);
 				break;
 			case 2:
 				img = ImageDecoder::fromDXT2(width, height,
-					buf.get(), expected_size);
+					buf, expected_size);
 				break;
 			case 4:
 				img = ImageDecoder::fromDXT4(width, height,
-					buf.get(), expected_size);
+					buf, expected_size);
 				break;
 			default:
 				assert(!"Unsupported DXTn format.");
@@ -484,17 +485,17 @@ rp_image_const_ptr XboxXPRPrivate::loadXboxXPR0Image(void)
 			case 8:
 				img = ImageDecoder::fromLinear8(
 					mode.pxf, width, height,
-					buf.get(), expected_size);
+					buf, expected_size);
 				break;
 			case 16:
 				img = ImageDecoder::fromLinear16(
 					mode.pxf, width, height,
-					reinterpret_cast<const uint16_t*>(buf.get()), expected_size);
+					reinterpret_cast<const uint16_t*>(buf), expected_size);
 				break;
 			case 32:
 				img = ImageDecoder::fromLinear32(
 					mode.pxf, width, height,
-					reinterpret_cast<const uint32_t*>(buf.get()), expected_size);
+					reinterpret_cast<const uint32_t*>(buf), expected_size);
 				break;
 			case 0:
 			default:
@@ -9,6 +9,9 @@
 #include "stdafx.h"
 #include "GdiplusHelper.hpp"
 
+// C++ STL classes
+#include <mutex>
+
 // Gdiplus for PNG decoding.
 // NOTE: Gdiplus requires min/max.
 #include <algorithm>
@@ -28,29 +31,74 @@ extern "C" {
 
 namespace GdiplusHelper {
 
+// Process-wide shared GDI+ session.
+// GDI+ is started on the first AcquireGDIPlus() call, and is kept
+// running even when the reference count drops to zero, since
+// GdiplusStartup() is a visible chunk of first-thumbnail latency.
+// ShutdownSharedGDIPlus() tears it down at DLL unload / process exit.
+static std::mutex gdip_mutex;
+static ULONG_PTR gdip_token = 0;
+static int gdip_ref_cnt = 0;
+
 /**
- * Initialize GDI+.
+ * Acquire a reference to the process-wide shared GDI+ session.
+ * GDI+ is started on the first call.
+ * Call ReleaseGDIPlus() when done with GDI+.
  * @return GDI+ token, or 0 on failure.
  */
-ULONG_PTR InitGDIPlus(void)
+ULONG_PTR AcquireGDIPlus(void)
+{
+	std::lock_guard<std::mutex> lock(gdip_mutex);
+	if (gdip_token == 0) {
+		// GDI+ is not started yet. Start it up.
+		Gdiplus::GdiplusStartupInput gdipSI;
+		gdipSI.GdiplusVersion = 1;
+		gdipSI.DebugEventCallback = nullptr;
+		gdipSI.SuppressBackgroundThread = FALSE;
+		gdipSI.SuppressExternalCodecs = FALSE;
+		ULONG_PTR gdipToken;
+		Gdiplus::Status status = GdiplusStartup(&gdipToken, &gdipSI, nullptr);
+		if (status != Gdiplus::Status::Ok) {
+			// Failed to start GDI+.
+			return 0;
+		}
+		gdip_token = gdipToken;
+	}
+
+	gdip_ref_cnt++;
+	return gdip_token;
+}
+
+/**
+ * Release a reference to the process-wide shared GDI+ session.
+ *
+ * NOTE: The session is intentionally kept running even if the
+ * reference count drops to zero, so the next conversion doesn't
+ * pay for GdiplusStartup() again. Call ShutdownSharedGDIPlus()
+ * at DLL unload / process exit to tear it down.
+ */
+void ReleaseGDIPlus(void)
 {
-	Gdiplus::GdiplusStartupInput gdipSI;
-	gdipSI.GdiplusVersion = 1;
-	gdipSI.DebugEventCallback = nullptr;
-	gdipSI.SuppressBackgroundThread = FALSE;
-	gdipSI.SuppressExternalCodecs = FALSE;
-	ULONG_PTR gdipToken;
-	Gdiplus::Status status = GdiplusStartup(&gdipToken, &gdipSI, nullptr);
-	return (status == Gdiplus::Status::Ok ? gdipToken : 0);
+	std::lock_guard<std::mutex> lock(gdip_mutex);
+	assert(gdip_ref_cnt > 0);
+	if (gdip_ref_cnt > 0) {
+		gdip_ref_cnt--;
+	}
 }
 
 /**
- * Shut down GDI+.
- * @param gdipToken GDI+ token.
+ * Shut down the process-wide shared GDI+ session.
+ * Does nothing if references are still outstanding.
+ * This should be called at DLL unload / process exit.
  */
-void ShutdownGDIPlus(ULONG_PTR gdipToken)
+void ShutdownSharedGDIPlus(void)
 {
-	Gdiplus::GdiplusShutdown(gdipToken);
+	std::lock_guard<std::mutex> lock(gdip_mutex);
+	assert(gdip_ref_cnt == 0);
+	if (gdip_ref_cnt == 0 && gdip_token != 0) {
+		Gdiplus::GdiplusShutdown(gdip_token);
+		gdip_token = 0;
+	}
 }
 
 }
@@ -18,17 +18,31 @@
 namespace GdiplusHelper {
 
 /**
- * Initialize GDI+.
+ * Acquire a reference to the process-wide shared GDI+ session.
+ * GDI+ is started on the first call.
+ * Call ReleaseGDIPlus() when done with GDI+.
  * @return GDI+ token, or 0 on failure.
  */
 RP_LIBROMDATA_PUBLIC
-ULONG_PTR InitGDIPlus(void);
+ULONG_PTR AcquireGDIPlus(void);
 
 /**
- * Shut down GDI+.
- * @param gdipToken GDI+ token.
+ * Release a reference to the process-wide shared GDI+ session.
+ *
+ * NOTE: The session is intentionally kept running even if the
+ * reference count drops to zero, so the next conversion doesn't
+ * pay for GdiplusStartup() again. Call ShutdownSharedGDIPlus()
+ * at DLL unload / process exit to tear it down.
  */
 RP_LIBROMDATA_PUBLIC
-void ShutdownGDIPlus(ULONG_PTR gdipToken);
+void ReleaseGDIPlus(void);
+
+/**
+ * Shut down the process-wide shared GDI+ session.
+ * Does nothing if references are still outstanding.
+ * This should be called at DLL unload / process exit.
+ */
+RP_LIBROMDATA_PUBLIC
+void ShutdownSharedGDIPlus(void);
 
 }
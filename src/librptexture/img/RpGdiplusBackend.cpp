@@ -44,6 +44,10 @@ RpGdiplusBackend::RpGdiplusBackend(int width, int height, rp_image::Format forma
 {
 	memset(&m_gdipBmpData, 0, sizeof(m_gdipBmpData));
 
+	// Make sure GDI+ is running.
+	// The reference is released in the destructor.
+	GdiplusHelper::AcquireGDIPlus();
+
 	if (this->width <= 0 || this->height <= 0) {
 		// Image did not initialize successfully.
 		return;
@@ -118,6 +122,10 @@ RpGdiplusBackend::RpGdiplusBackend(Gdiplus::Bitmap *pGdipBmp)
 {
 	memset(&m_gdipBmpData, 0, sizeof(m_gdipBmpData));
 
+	// Make sure GDI+ is running.
+	// The reference is released in the destructor.
+	GdiplusHelper::AcquireGDIPlus();
+
 	assert(pGdipBmp != nullptr);
 	if (!pGdipBmp)
 		return;
@@ -216,6 +224,10 @@ RpGdiplusBackend::~RpGdiplusBackend()
 	}
 
 	aligned_free(m_pImgBuf);
+
+	// Release the GDI+ reference acquired in the constructor.
+	// NOTE: Must be done after deleting m_pGdipBmp.
+	GdiplusHelper::ReleaseGDIPlus();
 }
 
 /**
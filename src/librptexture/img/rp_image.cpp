@@ -14,11 +14,203 @@
 // librptexture
 #include "ImageSizeCalc.hpp"
 
+// librpthreads
+#include "librpthreads/Mutex.hpp"
+
+// C++ STL classes
+#include <unordered_map>
+
 // Workaround for RP_D() expecting the no-underscore, UpperCamelCase naming convention.
 #define rp_imagePrivate rp_image_private
 
 namespace LibRpTexture {
 
+/** rp_image_buffer_pool **/
+
+/**
+ * Opt-in pool of aligned image buffers, keyed by power-of-two size class.
+ *
+ * Pooling avoids mmap()/munmap() churn in the allocator when a frontend
+ * decodes many similarly-sized images in a row, e.g. batch thumbnailing.
+ * Disabled by default; see rp_image::setBufferPoolEnabled().
+ */
+class rp_image_buffer_pool
+{
+	public:
+		rp_image_buffer_pool()
+			: m_pooledBytes(0)
+			, m_enabled(false)
+		{ }
+
+		~rp_image_buffer_pool()
+		{
+			flush();
+		}
+
+	private:
+		RP_DISABLE_COPY(rp_image_buffer_pool)
+
+	public:
+		// Minimum size class. (Smaller requests are rounded up.)
+		static constexpr size_t MIN_CLASS_SIZE = 4096U;
+		// Maximum total bytes retained by the pool.
+		static constexpr size_t MAX_POOLED_BYTES = 16U*1024U*1024U;
+		// Maximum buffers retained per size class.
+		static constexpr size_t MAX_PER_CLASS = 4U;
+
+	public:
+		/**
+		 * Enable or disable the buffer pool.
+		 * Disabling the pool frees all pooled buffers.
+		 * @param enabled True to enable; false to disable.
+		 */
+		void setEnabled(bool enabled)
+		{
+			m_enabled = enabled;
+			if (!enabled) {
+				flush();
+			}
+		}
+
+		/**
+		 * Is the buffer pool enabled?
+		 * @return True if enabled; false if not.
+		 */
+		bool isEnabled(void) const
+		{
+			return m_enabled;
+		}
+
+		/**
+		 * Allocate a 16-byte aligned image buffer.
+		 * @param data_len	[in] Requested buffer size.
+		 * @param pAlloc_len	[out] Size class actually allocated, or 0 if not pooled.
+		 * @return Image buffer, or nullptr on allocation failure.
+		 */
+		void *alloc(size_t data_len, unsigned int *pAlloc_len);
+
+		/**
+		 * Release a buffer allocated by alloc().
+		 * The buffer is pooled for reuse if possible; otherwise, it's freed.
+		 * @param data		Image buffer.
+		 * @param alloc_len	Size class reported by alloc(). (0 == not pooled)
+		 */
+		void free(void *data, unsigned int alloc_len);
+
+		/**
+		 * Free all pooled buffers.
+		 */
+		void flush(void);
+
+	private:
+		/**
+		 * Round a buffer size up to its size class.
+		 * @param data_len Requested buffer size.
+		 * @return Size class. (power of two)
+		 */
+		static size_t sizeClass(size_t data_len)
+		{
+			size_t sz = MIN_CLASS_SIZE;
+			while (sz < data_len) {
+				sz <<= 1;
+			}
+			return sz;
+		}
+
+	private:
+		LibRpThreads::Mutex m_lock;
+		std::unordered_map<size_t, std::vector<void*> > m_buffers;
+		size_t m_pooledBytes;
+		bool m_enabled;
+};
+
+/**
+ * Allocate a 16-byte aligned image buffer.
+ * @param data_len	[in] Requested buffer size.
+ * @param pAlloc_len	[out] Size class actually allocated, or 0 if not pooled.
+ * @return Image buffer, or nullptr on allocation failure.
+ */
+void *rp_image_buffer_pool::alloc(size_t data_len, unsigned int *pAlloc_len)
+{
+	if (!m_enabled) {
+		// Pool is disabled.
+		*pAlloc_len = 0;
+		return aligned_malloc(16, data_len);
+	}
+
+	const size_t sz = sizeClass(data_len);
+	if (sz > MAX_POOLED_BYTES) {
+		// Buffer is too big to pool.
+		*pAlloc_len = 0;
+		return aligned_malloc(16, data_len);
+	}
+	*pAlloc_len = static_cast<unsigned int>(sz);
+
+	{
+		LibRpThreads::MutexLocker locker(m_lock);
+		auto iter = m_buffers.find(sz);
+		if (iter != m_buffers.end() && !iter->second.empty()) {
+			// Reuse a pooled buffer.
+			void *const data = iter->second.back();
+			iter->second.pop_back();
+			m_pooledBytes -= sz;
+			return data;
+		}
+	}
+
+	// No pooled buffer is available.
+	// Allocate at the size class so the buffer can be
+	// pooled when it's released.
+	return aligned_malloc(16, sz);
+}
+
+/**
+ * Release a buffer allocated by alloc().
+ * The buffer is pooled for reuse if possible; otherwise, it's freed.
+ * @param data		Image buffer.
+ * @param alloc_len	Size class reported by alloc(). (0 == not pooled)
+ */
+void rp_image_buffer_pool::free(void *data, unsigned int alloc_len)
+{
+	if (!data) {
+		return;
+	} else if (alloc_len == 0 || !m_enabled) {
+		// Buffer isn't pooled, or the pool has been disabled.
+		aligned_free(data);
+		return;
+	}
+
+	LibRpThreads::MutexLocker locker(m_lock);
+	std::vector<void*> &vec = m_buffers[alloc_len];
+	if (vec.size() >= MAX_PER_CLASS ||
+	    m_pooledBytes + alloc_len > MAX_POOLED_BYTES)
+	{
+		// Pool is full.
+		aligned_free(data);
+		return;
+	}
+	vec.push_back(data);
+	m_pooledBytes += alloc_len;
+}
+
+/**
+ * Free all pooled buffers.
+ */
+void rp_image_buffer_pool::flush(void)
+{
+	LibRpThreads::MutexLocker locker(m_lock);
+	for (auto &pair : m_buffers) {
+		for (void *data : pair.second) {
+			aligned_free(data);
+		}
+	}
+	m_buffers.clear();
+	m_pooledBytes = 0;
+}
+
+// Buffer pool singleton.
+static rp_image_buffer_pool buffer_pool;
+
 /** rp_image_backend_default **/
 
 class rp_image_backend_default final : public rp_image_backend
@@ -75,6 +267,7 @@ class rp_image_backend_default final : public rp_image_backend
 		void *m_data;
 		uint32_t *m_palette;
 		unsigned int m_data_len, m_palette_len;
+		unsigned int m_alloc_len;	// pool size class (0 == not pooled)
 };
 
 rp_image_backend_default::rp_image_backend_default(int width, int height, rp_image::Format format)
@@ -83,6 +276,7 @@ rp_image_backend_default::rp_image_backend_default(int width, int height, rp_ima
 	, m_palette(nullptr)
 	, m_data_len(0)
 	, m_palette_len(0U)
+	, m_alloc_len(0U)
 {
 	if (width == 0 || height == 0) {
 		// Error initializing the backend.
@@ -107,7 +301,7 @@ rp_image_backend_default::rp_image_backend_default(int width, int height, rp_ima
 	}
 	m_data_len = static_cast<unsigned int>(data_len);
 
-	m_data = aligned_malloc(16, data_len);
+	m_data = buffer_pool.alloc(data_len, &m_alloc_len);
 	assert(m_data != nullptr);
 	if (!m_data) {
 		// Failed to allocate memory.
@@ -124,9 +318,10 @@ rp_image_backend_default::rp_image_backend_default(int width, int height, rp_ima
 		m_palette = static_cast<uint32_t*>(aligned_malloc(16, palette_sz));
 		if (!m_palette) {
 			// Failed to allocate memory.
-			aligned_free(m_data);
+			buffer_pool.free(m_data, m_alloc_len);
 			m_data = nullptr;
 			m_data_len = 0;
+			m_alloc_len = 0;
 			clear_properties();
 			return;
 		}
@@ -139,7 +334,7 @@ rp_image_backend_default::rp_image_backend_default(int width, int height, rp_ima
 
 rp_image_backend_default::~rp_image_backend_default()
 {
-	aligned_free(m_data);
+	buffer_pool.free(m_data, m_alloc_len);
 	aligned_free(m_palette);
 }
 
@@ -281,6 +476,34 @@ rp_image::rp_image_backend_creator_fn rp_image::backendCreatorFn(void)
 	return rp_image_private::backend_fn;
 }
 
+/** Buffer pool. **/
+
+/**
+ * Enable or disable the image buffer pool. (Default is disabled.)
+ *
+ * When enabled, pixel buffers allocated by the default backend
+ * are retained after the image is deleted and reused for
+ * subsequent images of a similar size. Intended for frontends
+ * that decode many images in a row, e.g. batch thumbnailing.
+ *
+ * Disabling the pool frees all pooled buffers.
+ *
+ * @param enabled True to enable the buffer pool; false to disable it.
+ */
+void rp_image::setBufferPoolEnabled(bool enabled)
+{
+	buffer_pool.setEnabled(enabled);
+}
+
+/**
+ * Is the image buffer pool enabled?
+ * @return True if enabled; false if not.
+ */
+bool rp_image::isBufferPoolEnabled(void)
+{
+	return buffer_pool.isEnabled();
+}
+
 /**
  * Get this image's backend object.
  * @return Image backend object.
@@ -25,6 +25,7 @@
 #  define RP_IMAGE_HAS_SSE2 1
 #  define RP_IMAGE_HAS_SSSE3 1
 #  define RP_IMAGE_HAS_SSE41 1
+#  define RP_IMAGE_HAS_AVX2 1
 #endif
 #ifdef RP_CPU_AMD64
 #  define RP_IMAGE_ALWAYS_HAS_SSE2 1
@@ -109,6 +110,28 @@ class rp_image
 		 */
 		static rp_image_backend_creator_fn backendCreatorFn(void);
 
+	public:
+		/**
+		 * Enable or disable the image buffer pool. (Default is disabled.)
+		 *
+		 * When enabled, pixel buffers allocated by the default backend
+		 * are retained after the image is deleted and reused for
+		 * subsequent images of a similar size. Intended for frontends
+		 * that decode many images in a row, e.g. batch thumbnailing.
+		 *
+		 * Disabling the pool frees all pooled buffers.
+		 *
+		 * @param enabled True to enable the buffer pool; false to disable it.
+		 */
+		RP_LIBROMDATA_PUBLIC
+		static void setBufferPoolEnabled(bool enabled);
+
+		/**
+		 * Is the image buffer pool enabled?
+		 * @return True if enabled; false if not.
+		 */
+		static bool isBufferPoolEnabled(void);
+
 	public:
 		/**
 		 * Get this image's backend object.
@@ -200,6 +223,7 @@ class rp_image
 		 * @param i Line number.
 		 * @return Line of image data, or nullptr if i is out of range.
 		 */
+		RP_LIBROMDATA_PUBLIC
 		void *scanLine(int i);
 
 		/**
@@ -221,6 +245,7 @@ class rp_image
 		 * Get the image palette.
 		 * @return Pointer to image palette, or nullptr if not a paletted image.
 		 */
+		RP_LIBROMDATA_PUBLIC
 		uint32_t *palette(void);
 
 		/**
@@ -271,6 +296,7 @@ class rp_image
 		 * Set the number of significant bits per channel.
 		 * @param sBIT	[in] sBIT_t struct.
 		 */
+		RP_LIBROMDATA_PUBLIC
 		void set_sBIT(const sBIT_t *sBIT);
 
 		/**
@@ -393,6 +419,19 @@ class rp_image
 		int un_premultiply_sse41(void);
 #endif /* RP_IMAGE_HAS_SSE41 */
 
+#ifdef RP_IMAGE_HAS_AVX2
+		/**
+		 * Un-premultiply this image.
+		 * AVX2-optimized version.
+		 *
+		 * Image must be ARGB32.
+		 *
+		 * @return 0 on success; non-zero on error.
+		 */
+		RP_LIBROMDATA_PUBLIC
+		int un_premultiply_avx2(void);
+#endif /* RP_IMAGE_HAS_AVX2 */
+
 		/**
 		 * Un-premultiply this image.
 		 *
@@ -472,6 +511,36 @@ class rp_image
 
 		/**
 		 * Flip the image.
+		 * Standard version using regular C++ code.
+		 *
+		 * This function returns a *new* image and leaves the
+		 * original image unmodified.
+		 *
+		 * @param op Flip operation.
+		 * @return Flipped image, or nullptr on error.
+		 */
+		RP_LIBROMDATA_PUBLIC
+		std::shared_ptr<rp_image> flip_cpp(FlipOp op) const;
+
+#ifdef RP_IMAGE_HAS_SSE2
+		/**
+		 * Flip the image.
+		 * SSE2-optimized version.
+		 *
+		 * This function returns a *new* image and leaves the
+		 * original image unmodified.
+		 *
+		 * @param op Flip operation.
+		 * @return Flipped image, or nullptr on error.
+		 */
+		RP_LIBROMDATA_PUBLIC
+		std::shared_ptr<rp_image> flip_sse2(FlipOp op) const;
+#endif /* RP_IMAGE_HAS_SSE2 */
+
+#ifdef RP_IMAGE_HAS_SSSE3
+		/**
+		 * Flip the image.
+		 * SSSE3-optimized version.
 		 *
 		 * This function returns a *new* image and leaves the
 		 * original image unmodified.
@@ -480,7 +549,19 @@ class rp_image
 		 * @return Flipped image, or nullptr on error.
 		 */
 		RP_LIBROMDATA_PUBLIC
-		std::shared_ptr<rp_image> flip(FlipOp op) const;
+		std::shared_ptr<rp_image> flip_ssse3(FlipOp op) const;
+#endif /* RP_IMAGE_HAS_SSSE3 */
+
+		/**
+		 * Flip the image.
+		 *
+		 * This function returns a *new* image and leaves the
+		 * original image unmodified.
+		 *
+		 * @param op Flip operation.
+		 * @return Flipped image, or nullptr on error.
+		 */
+		inline std::shared_ptr<rp_image> flip(FlipOp op) const;
 
 		/**
 		 * Shrink image dimensions.
@@ -490,6 +571,59 @@ class rp_image
 		 */
 		int shrink(int width, int height);
 
+		/** scaled_down() **/
+
+		/**
+		 * Downscale the image using an area-averaging (box) filter.
+		 * Standard version using regular C++ code.
+		 *
+		 * This function returns a *new* image and leaves the
+		 * original image unmodified.
+		 *
+		 * NOTE: The image *must* be ARGB32, and the new dimensions
+		 * must be less than or equal to the current dimensions.
+		 *
+		 * @param width New width
+		 * @param height New height
+		 * @return Downscaled image, or nullptr on error.
+		 */
+		RP_LIBROMDATA_PUBLIC
+		std::shared_ptr<rp_image> scaled_down_cpp(int width, int height) const;
+
+#ifdef RP_IMAGE_HAS_SSE2
+		/**
+		 * Downscale the image using an area-averaging (box) filter.
+		 * SSE2-optimized version.
+		 *
+		 * This function returns a *new* image and leaves the
+		 * original image unmodified.
+		 *
+		 * NOTE: The image *must* be ARGB32, and the new dimensions
+		 * must be less than or equal to the current dimensions.
+		 *
+		 * @param width New width
+		 * @param height New height
+		 * @return Downscaled image, or nullptr on error.
+		 */
+		RP_LIBROMDATA_PUBLIC
+		std::shared_ptr<rp_image> scaled_down_sse2(int width, int height) const;
+#endif /* RP_IMAGE_HAS_SSE2 */
+
+		/**
+		 * Downscale the image using an area-averaging (box) filter.
+		 *
+		 * This function returns a *new* image and leaves the
+		 * original image unmodified.
+		 *
+		 * NOTE: The image *must* be ARGB32, and the new dimensions
+		 * must be less than or equal to the current dimensions.
+		 *
+		 * @param width New width
+		 * @param height New height
+		 * @return Downscaled image, or nullptr on error.
+		 */
+		inline std::shared_ptr<rp_image> scaled_down(int width, int height) const;
+
 		/** swizzle() **/
 
 		/**
@@ -552,11 +686,16 @@ typedef std::shared_ptr<const rp_image> rp_image_const_ptr;
 inline int rp_image::un_premultiply(void)
 {
 	// FIXME: Figure out how to get IFUNC working with C++ member functions.
+#ifdef RP_IMAGE_HAS_AVX2
+	if (RP_CPU_HasAVX2()) {
+		return un_premultiply_avx2();
+	} else
+#endif /* RP_IMAGE_HAS_AVX2 */
 #ifdef RP_IMAGE_HAS_SSE41
 	if (RP_CPU_HasSSE41()) {
 		return un_premultiply_sse41();
 	} else
-#endif /* RP_IMAGE_HAS_SSE2 */
+#endif /* RP_IMAGE_HAS_SSE41 */
 	{
 		return un_premultiply_cpp();
 	}
@@ -591,6 +730,71 @@ inline int rp_image::apply_chroma_key(uint32_t key)
 #endif /* RP_IMAGE_ALWAYS_HAS_SSE2 */
 }
 
+/**
+ * Flip the image.
+ *
+ * This function returns a *new* image and leaves the
+ * original image unmodified.
+ *
+ * @param op Flip operation.
+ * @return Flipped image, or nullptr on error.
+ */
+inline std::shared_ptr<rp_image> rp_image::flip(FlipOp op) const
+{
+	// FIXME: Figure out how to get IFUNC working with C++ member functions.
+#if defined(RP_IMAGE_HAS_SSSE3)
+	if (RP_CPU_HasSSSE3()) {
+		return flip_ssse3(op);
+	} else
+#endif /* RP_IMAGE_HAS_SSSE3 */
+#if defined(RP_IMAGE_ALWAYS_HAS_SSE2)
+	{
+		// amd64 always has SSE2.
+		return flip_sse2(op);
+	}
+#else
+#  if defined(RP_IMAGE_HAS_SSE2)
+	if (RP_CPU_HasSSE2()) {
+		return flip_sse2(op);
+	} else
+#  endif /* RP_IMAGE_HAS_SSE2 */
+	{
+		return flip_cpp(op);
+	}
+#endif /* RP_IMAGE_ALWAYS_HAS_SSE2 */
+}
+
+/**
+ * Downscale the image using an area-averaging (box) filter.
+ *
+ * This function returns a *new* image and leaves the
+ * original image unmodified.
+ *
+ * NOTE: The image *must* be ARGB32, and the new dimensions
+ * must be less than or equal to the current dimensions.
+ *
+ * @param width New width
+ * @param height New height
+ * @return Downscaled image, or nullptr on error.
+ */
+inline std::shared_ptr<rp_image> rp_image::scaled_down(int width, int height) const
+{
+	// FIXME: Figure out how to get IFUNC working with C++ member functions.
+#if defined(RP_IMAGE_ALWAYS_HAS_SSE2)
+	// amd64 always has SSE2.
+	return scaled_down_sse2(width, height);
+#else
+#  if defined(RP_IMAGE_HAS_SSE2)
+	if (RP_CPU_HasSSE2()) {
+		return scaled_down_sse2(width, height);
+	} else
+#  endif /* RP_IMAGE_HAS_SSE2 */
+	{
+		return scaled_down_cpp(width, height);
+	}
+#endif /* RP_IMAGE_ALWAYS_HAS_SSE2 */
+}
+
 /**
  * Swizzle the image channels.
  *
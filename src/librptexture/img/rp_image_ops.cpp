@@ -560,6 +560,7 @@ int rp_image::apply_chroma_key_cpp(uint32_t key)
 
 /**
  * Flip the image.
+ * Standard version using regular C++ code.
  *
  * This function returns a *new* image and leaves the
  * original image unmodified.
@@ -567,7 +568,7 @@ int rp_image::apply_chroma_key_cpp(uint32_t key)
  * @param op Flip operation.
  * @return Flipped image, or nullptr on error.
  */
-rp_image_ptr rp_image::flip(FlipOp op) const
+rp_image_ptr rp_image::flip_cpp(FlipOp op) const
 {
 	assert(op >= FLIP_V);
 	assert(op <= FLIP_VH);
@@ -700,6 +701,108 @@ int rp_image::shrink(int width, int height)
 	return d->backend->shrink(width, height);
 }
 
+/**
+ * Downscale the image using an area-averaging (box) filter.
+ * Standard version using regular C++ code.
+ *
+ * This function returns a *new* image and leaves the
+ * original image unmodified.
+ *
+ * NOTE: The image *must* be ARGB32, and the new dimensions
+ * must be less than or equal to the current dimensions.
+ *
+ * @param width New width
+ * @param height New height
+ * @return Downscaled image, or nullptr on error.
+ */
+rp_image_ptr rp_image::scaled_down_cpp(int width, int height) const
+{
+	RP_D(const rp_image);
+	const rp_image_backend *const backend = d->backend;
+
+	assert(backend->format == Format::ARGB32);
+	if (backend->format != Format::ARGB32) {
+		// ARGB32 only.
+		return nullptr;
+	}
+
+	const int orig_width = backend->width;
+	const int orig_height = backend->height;
+	assert(width > 0);
+	assert(height > 0);
+	assert(width <= orig_width);
+	assert(height <= orig_height);
+	if (width <= 0 || height <= 0 ||
+	    width > orig_width || height > orig_height)
+	{
+		// Downscale only.
+		return nullptr;
+	}
+
+	if (width == orig_width && height == orig_height) {
+		// No scaling is necessary.
+		return this->dup();
+	}
+
+	const rp_image_ptr img = std::make_shared<rp_image>(width, height, Format::ARGB32);
+	if (!img->isValid()) {
+		// Image is invalid.
+		return nullptr;
+	}
+
+	const uint8_t *const src = static_cast<const uint8_t*>(backend->data());
+	const int src_stride = backend->stride;
+	uint8_t *dest_row = static_cast<uint8_t*>(img->bits());
+	const int dest_stride = img->stride();
+
+	// Each destination pixel is the average of the source pixels in
+	// the box [sx0,sx1) x [sy0,sy1). The box edges are calculated by
+	// mapping destination pixel edges back to the source image, which
+	// covers every source pixel exactly once.
+	for (int y = 0; y < height; y++, dest_row += dest_stride) {
+		const int sy0 = static_cast<int>((static_cast<int64_t>(y) * orig_height) / height);
+		int sy1 = static_cast<int>((static_cast<int64_t>(y+1) * orig_height) / height);
+		if (sy1 <= sy0) {
+			sy1 = sy0 + 1;
+		}
+
+		uint32_t *dest = reinterpret_cast<uint32_t*>(dest_row);
+		for (int x = 0; x < width; x++) {
+			const int sx0 = static_cast<int>((static_cast<int64_t>(x) * orig_width) / width);
+			int sx1 = static_cast<int>((static_cast<int64_t>(x+1) * orig_width) / width);
+			if (sx1 <= sx0) {
+				sx1 = sx0 + 1;
+			}
+
+			uint32_t sumB = 0, sumG = 0, sumR = 0, sumA = 0;
+			const uint8_t *src_row = src + (static_cast<size_t>(sy0) * src_stride);
+			for (int sy = sy0; sy < sy1; sy++, src_row += src_stride) {
+				const uint32_t *p = reinterpret_cast<const uint32_t*>(src_row) + sx0;
+				for (int sx = sx0; sx < sx1; sx++, p++) {
+					const uint32_t px = *p;
+					sumB +=  px        & 0xFF;
+					sumG += (px >>  8) & 0xFF;
+					sumR += (px >> 16) & 0xFF;
+					sumA +=  px >> 24;
+				}
+			}
+
+			const uint32_t count = static_cast<uint32_t>(sx1 - sx0) * static_cast<uint32_t>(sy1 - sy0);
+			dest[x] = ((sumA / count) << 24) |
+				  ((sumR / count) << 16) |
+				  ((sumG / count) <<  8) |
+				   (sumB / count);
+		}
+	}
+
+	// Copy sBIT if it's set.
+	if (d->has_sBIT) {
+		img->set_sBIT(&d->sBIT);
+	}
+
+	return img;
+}
+
 /**
  * Swizzle the image channels.
  * Standard version using regular C++ code.
@@ -88,4 +88,206 @@ int rp_image::apply_chroma_key_sse2(uint32_t key)
 	return 0;
 }
 
+/**
+ * Downscale the image using an area-averaging (box) filter.
+ * SSE2-optimized version.
+ *
+ * This function returns a *new* image and leaves the
+ * original image unmodified.
+ *
+ * NOTE: The image *must* be ARGB32, and the new dimensions
+ * must be less than or equal to the current dimensions.
+ *
+ * @param width New width
+ * @param height New height
+ * @return Downscaled image, or nullptr on error.
+ */
+rp_image_ptr rp_image::scaled_down_sse2(int width, int height) const
+{
+	RP_D(const rp_image);
+	const rp_image_backend *const backend = d->backend;
+
+	assert(backend->format == Format::ARGB32);
+	if (backend->format != Format::ARGB32) {
+		// ARGB32 only.
+		return nullptr;
+	}
+
+	const int orig_width = backend->width;
+	const int orig_height = backend->height;
+	assert(width > 0);
+	assert(height > 0);
+	assert(width <= orig_width);
+	assert(height <= orig_height);
+	if (width <= 0 || height <= 0 ||
+	    width > orig_width || height > orig_height)
+	{
+		// Downscale only.
+		return nullptr;
+	}
+
+	if (width == orig_width && height == orig_height) {
+		// No scaling is necessary.
+		return this->dup();
+	}
+
+	const rp_image_ptr img = std::make_shared<rp_image>(width, height, Format::ARGB32);
+	if (!img->isValid()) {
+		// Image is invalid.
+		return nullptr;
+	}
+
+	const uint8_t *const src = static_cast<const uint8_t*>(backend->data());
+	const int src_stride = backend->stride;
+	uint8_t *dest_row = static_cast<uint8_t*>(img->bits());
+	const int dest_stride = img->stride();
+
+	const __m128i zero = _mm_setzero_si128();
+
+	// Each destination pixel is the average of the source pixels in
+	// the box [sx0,sx1) x [sy0,sy1). The box edges are calculated by
+	// mapping destination pixel edges back to the source image, which
+	// covers every source pixel exactly once.
+	for (int y = 0; y < height; y++, dest_row += dest_stride) {
+		const int sy0 = static_cast<int>((static_cast<int64_t>(y) * orig_height) / height);
+		int sy1 = static_cast<int>((static_cast<int64_t>(y+1) * orig_height) / height);
+		if (sy1 <= sy0) {
+			sy1 = sy0 + 1;
+		}
+
+		uint32_t *dest = reinterpret_cast<uint32_t*>(dest_row);
+		for (int x = 0; x < width; x++) {
+			const int sx0 = static_cast<int>((static_cast<int64_t>(x) * orig_width) / width);
+			int sx1 = static_cast<int>((static_cast<int64_t>(x+1) * orig_width) / width);
+			if (sx1 <= sx0) {
+				sx1 = sx0 + 1;
+			}
+
+			// Accumulate the box into four 32-bit channel sums: [B,G,R,A]
+			__m128i sum = zero;
+			const uint8_t *src_row = src + (static_cast<size_t>(sy0) * src_stride);
+			for (int sy = sy0; sy < sy1; sy++, src_row += src_stride) {
+				const uint32_t *p = reinterpret_cast<const uint32_t*>(src_row) + sx0;
+
+				// Process 2 pixels per iteration.
+				int sx = sx1 - sx0;
+				for (; sx > 1; sx -= 2, p += 2) {
+					__m128i px2 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(p));
+					px2 = _mm_unpacklo_epi8(px2, zero);
+					sum = _mm_add_epi32(sum, _mm_unpacklo_epi16(px2, zero));
+					sum = _mm_add_epi32(sum, _mm_unpackhi_epi16(px2, zero));
+				}
+				// Remaining pixel.
+				if (sx > 0) {
+					__m128i px = _mm_cvtsi32_si128(static_cast<int>(*p));
+					px = _mm_unpacklo_epi8(px, zero);
+					sum = _mm_add_epi32(sum, _mm_unpacklo_epi16(px, zero));
+				}
+			}
+
+			// Divide by the box size.
+			// NOTE: Integer division to match the C++ version exactly.
+			alignas(16) uint32_t sums[4];
+			_mm_store_si128(reinterpret_cast<__m128i*>(sums), sum);
+			const uint32_t count = static_cast<uint32_t>(sx1 - sx0) * static_cast<uint32_t>(sy1 - sy0);
+			dest[x] = ((sums[3] / count) << 24) |
+				  ((sums[2] / count) << 16) |
+				  ((sums[1] / count) <<  8) |
+				   (sums[0] / count);
+		}
+	}
+
+	// Copy sBIT if it's set.
+	if (d->has_sBIT) {
+		img->set_sBIT(&d->sBIT);
+	}
+
+	return img;
+}
+
+/**
+ * Flip the image.
+ * SSE2-optimized version.
+ *
+ * This function returns a *new* image and leaves the
+ * original image unmodified.
+ *
+ * @param op Flip operation.
+ * @return Flipped image, or nullptr on error.
+ */
+rp_image_ptr rp_image::flip_sse2(FlipOp op) const
+{
+	// Only the horizontal flip of ARGB32 images benefits from SSE2:
+	// pixel-by-pixel row reversal becomes a 4-pixel shuffle.
+	// Vertical flips are already a row-by-row memcpy(), and CI8
+	// H-flips are handled by the SSSE3 version using pshufb.
+	RP_D(const rp_image);
+	if (!(op & FLIP_H) || d->backend->format != rp_image::Format::ARGB32) {
+		return flip_cpp(op);
+	}
+
+	assert(op >= FLIP_V);
+	assert(op <= FLIP_VH);
+	if (op > FLIP_VH) {
+		// Not supported.
+		return nullptr;
+	}
+
+	rp_image_backend *const backend = d->backend;
+	const int width = backend->width;
+	const int height = backend->height;
+	assert(width > 0 && height > 0);
+	if (width <= 0 || height <= 0) {
+		return nullptr;
+	}
+
+	rp_image_ptr flipimg = std::make_shared<rp_image>(width, height, backend->format);
+	const uint32_t *src = static_cast<const uint32_t*>(backend->data());
+	uint32_t *dest;
+	if (op & FLIP_V) {
+		// Vertical flip: Destination starts at the bottom of the image.
+		dest = static_cast<uint32_t*>(flipimg->scanLine(height - 1));
+	} else {
+		// Not a vertical flip: Destination starts at the top of the image.
+		dest = static_cast<uint32_t*>(flipimg->bits());
+	}
+
+	const int src_stride = backend->stride / sizeof(uint32_t);
+	int dest_stride = flipimg->stride() / sizeof(uint32_t);
+	if (op & FLIP_V) {
+		// Vertical flip: Subtract the destination stride.
+		dest_stride = -dest_stride;
+	}
+
+	for (int y = height; y > 0; y--) {
+		// Reverse 4 pixels at a time:
+		// Load from the end of the source row, reverse the
+		// pixel order within the vector, and store forwards.
+		int x = width;
+		const __m128i *src_mm = reinterpret_cast<const __m128i*>(src + width - 4);
+		__m128i *dest_mm = reinterpret_cast<__m128i*>(dest);
+		for (; x >= 4; x -= 4, src_mm--, dest_mm++) {
+			__m128i px = _mm_loadu_si128(src_mm);
+			px = _mm_shuffle_epi32(px, _MM_SHUFFLE(0, 1, 2, 3));
+			_mm_storeu_si128(dest_mm, px);
+		}
+
+		// Remaining 1-3 pixels.
+		uint32_t *dest32 = reinterpret_cast<uint32_t*>(dest_mm);
+		for (int sx = x - 1; sx >= 0; sx--, dest32++) {
+			*dest32 = src[sx];
+		}
+
+		src += src_stride;
+		dest += dest_stride;
+	}
+
+	// Copy sBIT if it's set.
+	if (d->has_sBIT) {
+		flipimg->set_sBIT(&d->sBIT);
+	}
+
+	return flipimg;
+}
+
 }
@@ -185,4 +185,98 @@ int rp_image::swizzle_ssse3(const char *swz_spec)
 	return 0;
 }
 
+/**
+ * Flip the image.
+ * SSSE3-optimized version.
+ *
+ * This function returns a *new* image and leaves the
+ * original image unmodified.
+ *
+ * @param op Flip operation.
+ * @return Flipped image, or nullptr on error.
+ */
+rp_image_ptr rp_image::flip_ssse3(FlipOp op) const
+{
+	// SSSE3 adds pshufb, which turns CI8 horizontal flips into
+	// a 16-byte reversal. Everything else is handled by the
+	// SSE2 version. (ARGB32 H-flip, V-flip memcpy())
+	RP_D(const rp_image);
+	if (!(op & FLIP_H) || d->backend->format != rp_image::Format::CI8) {
+		return flip_sse2(op);
+	}
+
+	assert(op >= FLIP_V);
+	assert(op <= FLIP_VH);
+	if (op > FLIP_VH) {
+		// Not supported.
+		return nullptr;
+	}
+
+	rp_image_backend *const backend = d->backend;
+	const int width = backend->width;
+	const int height = backend->height;
+	assert(width > 0 && height > 0);
+	if (width <= 0 || height <= 0) {
+		return nullptr;
+	}
+
+	rp_image_ptr flipimg = std::make_shared<rp_image>(width, height, backend->format);
+	const uint8_t *src = static_cast<const uint8_t*>(backend->data());
+	uint8_t *dest;
+	if (op & FLIP_V) {
+		// Vertical flip: Destination starts at the bottom of the image.
+		dest = static_cast<uint8_t*>(flipimg->scanLine(height - 1));
+	} else {
+		// Not a vertical flip: Destination starts at the top of the image.
+		dest = static_cast<uint8_t*>(flipimg->bits());
+	}
+
+	const int src_stride = backend->stride;
+	int dest_stride = flipimg->stride();
+	if (op & FLIP_V) {
+		// Vertical flip: Subtract the destination stride.
+		dest_stride = -dest_stride;
+	}
+
+	// Byte-reversal shuffle mask.
+	const __m128i rev_mask = _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+
+	for (int y = height; y > 0; y--) {
+		// Reverse 16 pixels at a time:
+		// Load from the end of the source row, reverse the
+		// byte order within the vector, and store forwards.
+		int x = width;
+		const __m128i *src_mm = reinterpret_cast<const __m128i*>(src + width - 16);
+		__m128i *dest_mm = reinterpret_cast<__m128i*>(dest);
+		for (; x >= 16; x -= 16, src_mm--, dest_mm++) {
+			__m128i px = _mm_loadu_si128(src_mm);
+			px = _mm_shuffle_epi8(px, rev_mask);
+			_mm_storeu_si128(dest_mm, px);
+		}
+
+		// Remaining 1-15 pixels.
+		uint8_t *dest8 = reinterpret_cast<uint8_t*>(dest_mm);
+		for (int sx = x - 1; sx >= 0; sx--, dest8++) {
+			*dest8 = src[sx];
+		}
+
+		src += src_stride;
+		dest += dest_stride;
+	}
+
+	// Copy the palette.
+	const unsigned int entries = std::min(flipimg->palette_len(), backend->palette_len());
+	uint32_t *const dest_pal = flipimg->palette();
+	memcpy(dest_pal, backend->palette(), entries * sizeof(uint32_t));
+	// Palette is zero-initialized, so we don't need to
+	// zero remaining entries.
+
+	// Copy sBIT if it's set.
+	if (d->has_sBIT) {
+		flipimg->set_sBIT(&d->sBIT);
+	}
+
+	return flipimg;
+}
+
 }
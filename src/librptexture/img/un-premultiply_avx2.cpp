@@ -0,0 +1,121 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librptexture)                     *
+ * un-premultiply_avx2.cpp: Un-premultiply function.                       *
+ * AVX2-optimized version.                                                 *
+ *                                                                         *
+ * Copyright (c) 2017-2024 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "rp_image.hpp"
+#include "rp_image_p.hpp"
+#include "rp_image_backend.hpp"
+
+// AVX2 headers.
+#include <immintrin.h>
+
+// Workaround for RP_D() expecting the no-underscore, UpperCamelCase naming convention.
+#define rp_imagePrivate rp_image_private
+
+namespace LibRpTexture {
+
+/**
+ * Un-premultiply an argb32_t pixel. (SSE4.1 version)
+ * From qt-5.11.0's qdrawingprimitive_sse2_p.h.
+ * qUnpremultiply_sse4()
+ *
+ * Used for the remaining odd pixel; the AVX2 main loop
+ * processes two pixels at a time.
+ *
+ * @param px	[in/out] argb32_t pixel to un-premultiply, in place.
+ */
+static FORCEINLINE void un_premultiply_pixel_one(argb32_t &px)
+{
+	const unsigned int alpha = px.a;
+	if (alpha == 255 || alpha == 0)
+		return;
+
+	const unsigned int invAlpha = rp_image::qt_inv_premul_factor[alpha];
+	const __m128i via = _mm_set1_epi32(invAlpha);
+	const __m128i vr = _mm_set1_epi32(0x8000);
+	__m128i vl = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(px.u32));
+	vl = _mm_mullo_epi32(vl, via);
+	vl = _mm_add_epi32(vl, vr);
+	vl = _mm_srai_epi32(vl, 16);
+	vl = _mm_insert_epi32(vl, alpha, 3);
+	vl = _mm_packus_epi32(vl, vl);
+	vl = _mm_packus_epi16(vl, vl);
+	px.u32 = _mm_cvtsi128_si32(vl);
+}
+
+/**
+ * Un-premultiply two adjacent argb32_t pixels. (AVX2 version)
+ * Same math as un_premultiply_pixel_one(), widened to one
+ * pixel per 128-bit lane, so the output is identical to the
+ * SSE4.1 and C++ versions.
+ *
+ * @param px	[in/out] Pointer to two argb32_t pixels to un-premultiply, in place.
+ */
+static FORCEINLINE void un_premultiply_pixels_avx2(argb32_t *px)
+{
+	const unsigned int alpha0 = px[0].a;
+	const unsigned int alpha1 = px[1].a;
+	const bool skip0 = (alpha0 == 255 || alpha0 == 0);
+	const bool skip1 = (alpha1 == 255 || alpha1 == 0);
+	if (skip0 && skip1)
+		return;
+
+	const __m256i via = _mm256_set_m128i(
+		_mm_set1_epi32(rp_image::qt_inv_premul_factor[alpha1]),
+		_mm_set1_epi32(rp_image::qt_inv_premul_factor[alpha0]));
+	const __m256i vr = _mm256_set1_epi32(0x8000);
+	__m256i vl = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(px)));
+	vl = _mm256_mullo_epi32(vl, via);
+	vl = _mm256_add_epi32(vl, vr);
+	vl = _mm256_srai_epi32(vl, 16);
+	vl = _mm256_insert_epi32(vl, alpha0, 3);
+	vl = _mm256_insert_epi32(vl, alpha1, 7);
+	vl = _mm256_packus_epi32(vl, vl);
+	vl = _mm256_packus_epi16(vl, vl);
+	// Pixels with alpha 0 or 255 must be left as-is.
+	if (!skip0) {
+		px[0].u32 = _mm_cvtsi128_si32(_mm256_castsi256_si128(vl));
+	}
+	if (!skip1) {
+		px[1].u32 = _mm_cvtsi128_si32(_mm256_extracti128_si256(vl, 1));
+	}
+}
+
+/**
+ * Un-premultiply an ARGB32 rp_image.
+ * Image must be ARGB32.
+ * @return 0 on success; non-zero on error.
+ */
+int rp_image::un_premultiply_avx2(void)
+{
+	RP_D(const rp_image);
+	rp_image_backend *const backend = d->backend;
+	assert(backend->format == rp_image::Format::ARGB32);
+	if (backend->format != rp_image::Format::ARGB32) {
+		// Incorrect format...
+		return -1;
+	}
+
+	const int width = backend->width;
+	argb32_t *px_dest = static_cast<argb32_t*>(backend->data());
+	const int dest_stride_adj = (backend->stride / sizeof(*px_dest)) - width;
+	for (int y = backend->height; y > 0; y--, px_dest += dest_stride_adj) {
+		int x = width;
+		for (; x > 1; x -= 2, px_dest += 2) {
+			un_premultiply_pixels_avx2(px_dest);
+		}
+		if (x == 1) {
+			un_premultiply_pixel_one(*px_dest);
+			px_dest++;
+		}
+	}
+	return 0;
+}
+
+}
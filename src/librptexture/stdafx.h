@@ -42,6 +42,9 @@
 #include "common.h"
 #include "ctypex.h"
 #include "aligned_malloc.h"
+#ifdef __cplusplus
+#  include "aligned_arena.h"
+#endif
 
 // librpbyteswap
 #include "librpbyteswap/byteswap_rp.h"
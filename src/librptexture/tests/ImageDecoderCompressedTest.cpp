@@ -0,0 +1,345 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librptexture/tests)               *
+ * ImageDecoderCompressedTest.cpp: Compressed texture decoder tests.       *
+ *                                                                         *
+ * Copyright (c) 2016-2024 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "config.librptexture.h"
+
+// Google Test
+#include "gtest/gtest.h"
+#include "tcharx.h"
+#include "common.h"
+
+// librptexture
+#include "librptexture/img/rp_image.hpp"
+#include "librptexture/decoder/ImageDecoder_S3TC.hpp"
+#include "librptexture/decoder/ImageDecoder_BC7.hpp"
+#include "librptexture/decoder/ImageDecoder_ETC1.hpp"
+#ifdef ENABLE_PVRTC
+#  include "librptexture/decoder/ImageDecoder_PVRTC.hpp"
+#endif /* ENABLE_PVRTC */
+#ifdef ENABLE_ASTC
+#  include "librptexture/decoder/ImageDecoder_ASTC.hpp"
+#endif /* ENABLE_ASTC */
+#ifdef _WIN32
+// rp_image backend registration.
+#  include "librptexture/img/RpGdiplusBackend.hpp"
+#endif /* _WIN32 */
+using namespace LibRpTexture;
+
+// C includes
+#include <stdint.h>
+#include <stdlib.h>
+
+// C includes (C++ namespace)
+#include <cstring>
+
+// C++ includes
+#include <memory>
+
+// Uninitialized vector class
+#include "uvector.h"
+
+namespace LibRpTexture { namespace Tests {
+
+class ImageDecoderCompressedTest : public ::testing::Test
+{
+	protected:
+		ImageDecoderCompressedTest()
+		{
+#ifdef _WIN32
+			// Register RpGdiplusBackend.
+			// TODO: Static initializer somewhere?
+			rp_image::setBackendCreatorFn(RpGdiplusBackend::creator_fn);
+#endif /* _WIN32 */
+
+			// Fill the source buffer with pseudo-random data.
+			// Using a fixed seed for reproducible benchmarks.
+			// NOTE: All block patterns are valid for S3TC, BC4/BC5,
+			// ETC1/ETC2, and PVRTC, so random data works as a
+			// worst-case input for those decoders.
+			m_src_buf.resize(TEX_WIDTH * TEX_HEIGHT);
+			uint32_t lcg = 0xC0FFEE01;
+			for (uint8_t &p : m_src_buf) {
+				lcg = (lcg * 1103515245) + 12345;
+				p = static_cast<uint8_t>(lcg >> 16);
+			}
+
+			// BC7: The block mode is the lowest set bit of the first
+			// byte. An all-zero first byte is an invalid "mode 8"
+			// block, so force mode 0 to keep every block valid.
+			m_bc7_buf = m_src_buf;
+			for (size_t i = 0; i < m_bc7_buf.size(); i += 16) {
+				m_bc7_buf[i] |= 0x01;
+			}
+
+#ifdef ENABLE_ASTC
+			// ASTC: Random data is usually rejected as invalid,
+			// so use LDR void-extent (constant-color) blocks with
+			// randomized colors instead.
+			m_astc_buf.resize(TEX_WIDTH * TEX_HEIGHT);
+			for (size_t i = 0; i < m_astc_buf.size(); i += 16) {
+				m_astc_buf[i+0] = 0xFC;
+				m_astc_buf[i+1] = 0xFD;
+				memset(&m_astc_buf[i+2], 0xFF, 6);
+				memcpy(&m_astc_buf[i+8], &m_src_buf[i+8], 8);
+			}
+#endif /* ENABLE_ASTC */
+		}
+
+	public:
+		// Texture size.
+		static constexpr int TEX_WIDTH = 256;
+		static constexpr int TEX_HEIGHT = 256;
+
+		// Number of iterations for benchmarks.
+		static constexpr unsigned int BENCHMARK_ITERATIONS = 1000U;
+		// BC7 has fewer iterations because it's more complicated.
+		static constexpr unsigned int BENCHMARK_ITERATIONS_BC7 = 100U;
+
+		// Source buffers.
+		// Sized for 8bpp (16 bytes per 4x4 block); 4bpp and 2bpp
+		// formats use a prefix of the buffer.
+		rp::uvector<uint8_t> m_src_buf;
+		rp::uvector<uint8_t> m_bc7_buf;
+#ifdef ENABLE_ASTC
+		rp::uvector<uint8_t> m_astc_buf;
+#endif /* ENABLE_ASTC */
+};
+
+/**
+ * Validate a decoded image.
+ * @param img Decoded image
+ */
+static void validateDecodedImage(const rp_image_ptr &img)
+{
+	ASSERT_TRUE(img != nullptr);
+	ASSERT_TRUE(img->isValid());
+	EXPECT_EQ(ImageDecoderCompressedTest::TEX_WIDTH, img->width());
+	EXPECT_EQ(ImageDecoderCompressedTest::TEX_HEIGHT, img->height());
+	EXPECT_EQ(rp_image::Format::ARGB32, img->format());
+}
+
+/** Decode sanity checks **/
+
+TEST_F(ImageDecoderCompressedTest, fromDXT1_test)
+{
+	const rp_image_ptr img = ImageDecoder::fromDXT1(TEX_WIDTH, TEX_HEIGHT,
+		m_src_buf.data(), (TEX_WIDTH * TEX_HEIGHT) / 2);
+	ASSERT_NO_FATAL_FAILURE(validateDecodedImage(img));
+}
+
+TEST_F(ImageDecoderCompressedTest, fromDXT5_test)
+{
+	const rp_image_ptr img = ImageDecoder::fromDXT5(TEX_WIDTH, TEX_HEIGHT,
+		m_src_buf.data(), TEX_WIDTH * TEX_HEIGHT);
+	ASSERT_NO_FATAL_FAILURE(validateDecodedImage(img));
+}
+
+TEST_F(ImageDecoderCompressedTest, fromBC4_test)
+{
+	const rp_image_ptr img = ImageDecoder::fromBC4(TEX_WIDTH, TEX_HEIGHT,
+		m_src_buf.data(), (TEX_WIDTH * TEX_HEIGHT) / 2);
+	ASSERT_NO_FATAL_FAILURE(validateDecodedImage(img));
+}
+
+TEST_F(ImageDecoderCompressedTest, fromBC5_test)
+{
+	const rp_image_ptr img = ImageDecoder::fromBC5(TEX_WIDTH, TEX_HEIGHT,
+		m_src_buf.data(), TEX_WIDTH * TEX_HEIGHT);
+	ASSERT_NO_FATAL_FAILURE(validateDecodedImage(img));
+}
+
+TEST_F(ImageDecoderCompressedTest, fromBC7_test)
+{
+	const rp_image_ptr img = ImageDecoder::fromBC7(TEX_WIDTH, TEX_HEIGHT,
+		m_bc7_buf.data(), TEX_WIDTH * TEX_HEIGHT);
+	ASSERT_NO_FATAL_FAILURE(validateDecodedImage(img));
+}
+
+TEST_F(ImageDecoderCompressedTest, fromETC1_test)
+{
+	const rp_image_ptr img = ImageDecoder::fromETC1(TEX_WIDTH, TEX_HEIGHT,
+		m_src_buf.data(), (TEX_WIDTH * TEX_HEIGHT) / 2);
+	ASSERT_NO_FATAL_FAILURE(validateDecodedImage(img));
+}
+
+TEST_F(ImageDecoderCompressedTest, fromETC2_RGB_test)
+{
+	const rp_image_ptr img = ImageDecoder::fromETC2_RGB(TEX_WIDTH, TEX_HEIGHT,
+		m_src_buf.data(), (TEX_WIDTH * TEX_HEIGHT) / 2);
+	ASSERT_NO_FATAL_FAILURE(validateDecodedImage(img));
+}
+
+TEST_F(ImageDecoderCompressedTest, fromETC2_RGBA_test)
+{
+	const rp_image_ptr img = ImageDecoder::fromETC2_RGBA(TEX_WIDTH, TEX_HEIGHT,
+		m_src_buf.data(), TEX_WIDTH * TEX_HEIGHT);
+	ASSERT_NO_FATAL_FAILURE(validateDecodedImage(img));
+}
+
+#ifdef ENABLE_PVRTC
+TEST_F(ImageDecoderCompressedTest, fromPVRTC_4bpp_test)
+{
+	const rp_image_ptr img = ImageDecoder::fromPVRTC(TEX_WIDTH, TEX_HEIGHT,
+		m_src_buf.data(), (TEX_WIDTH * TEX_HEIGHT) / 2,
+		ImageDecoder::PVRTC_4BPP | ImageDecoder::PVRTC_ALPHA_YES);
+	ASSERT_NO_FATAL_FAILURE(validateDecodedImage(img));
+}
+
+TEST_F(ImageDecoderCompressedTest, fromPVRTC_2bpp_test)
+{
+	const rp_image_ptr img = ImageDecoder::fromPVRTC(TEX_WIDTH, TEX_HEIGHT,
+		m_src_buf.data(), (TEX_WIDTH * TEX_HEIGHT) / 4,
+		ImageDecoder::PVRTC_2BPP | ImageDecoder::PVRTC_ALPHA_YES);
+	ASSERT_NO_FATAL_FAILURE(validateDecodedImage(img));
+}
+#endif /* ENABLE_PVRTC */
+
+#ifdef ENABLE_ASTC
+TEST_F(ImageDecoderCompressedTest, fromASTC_4x4_test)
+{
+	const rp_image_ptr img = ImageDecoder::fromASTC(TEX_WIDTH, TEX_HEIGHT,
+		m_astc_buf.data(), TEX_WIDTH * TEX_HEIGHT, 4, 4);
+	ASSERT_NO_FATAL_FAILURE(validateDecodedImage(img));
+}
+
+TEST_F(ImageDecoderCompressedTest, fromASTC_8x8_test)
+{
+	const rp_image_ptr img = ImageDecoder::fromASTC(TEX_WIDTH, TEX_HEIGHT,
+		m_astc_buf.data(), (TEX_WIDTH * TEX_HEIGHT) / 4, 8, 8);
+	ASSERT_NO_FATAL_FAILURE(validateDecodedImage(img));
+}
+#endif /* ENABLE_ASTC */
+
+/** Decode benchmarks **/
+// NOTE: The compressed decoders are scalar-only, so there are no
+// per-CPU-dispatch variants here. See ImageDecoderLinearTest,
+// ByteswapTest, and UnPremultiplyTest for the SIMD-dispatched kernels.
+
+TEST_F(ImageDecoderCompressedTest, fromDXT1_benchmark)
+{
+	for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) {
+		ImageDecoder::fromDXT1(TEX_WIDTH, TEX_HEIGHT,
+			m_src_buf.data(), (TEX_WIDTH * TEX_HEIGHT) / 2);
+	}
+}
+
+TEST_F(ImageDecoderCompressedTest, fromDXT5_benchmark)
+{
+	for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) {
+		ImageDecoder::fromDXT5(TEX_WIDTH, TEX_HEIGHT,
+			m_src_buf.data(), TEX_WIDTH * TEX_HEIGHT);
+	}
+}
+
+TEST_F(ImageDecoderCompressedTest, fromBC4_benchmark)
+{
+	for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) {
+		ImageDecoder::fromBC4(TEX_WIDTH, TEX_HEIGHT,
+			m_src_buf.data(), (TEX_WIDTH * TEX_HEIGHT) / 2);
+	}
+}
+
+TEST_F(ImageDecoderCompressedTest, fromBC5_benchmark)
+{
+	for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) {
+		ImageDecoder::fromBC5(TEX_WIDTH, TEX_HEIGHT,
+			m_src_buf.data(), TEX_WIDTH * TEX_HEIGHT);
+	}
+}
+
+TEST_F(ImageDecoderCompressedTest, fromBC7_benchmark)
+{
+	for (unsigned int i = BENCHMARK_ITERATIONS_BC7; i > 0; i--) {
+		ImageDecoder::fromBC7(TEX_WIDTH, TEX_HEIGHT,
+			m_bc7_buf.data(), TEX_WIDTH * TEX_HEIGHT);
+	}
+}
+
+TEST_F(ImageDecoderCompressedTest, fromETC1_benchmark)
+{
+	for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) {
+		ImageDecoder::fromETC1(TEX_WIDTH, TEX_HEIGHT,
+			m_src_buf.data(), (TEX_WIDTH * TEX_HEIGHT) / 2);
+	}
+}
+
+TEST_F(ImageDecoderCompressedTest, fromETC2_RGB_benchmark)
+{
+	for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) {
+		ImageDecoder::fromETC2_RGB(TEX_WIDTH, TEX_HEIGHT,
+			m_src_buf.data(), (TEX_WIDTH * TEX_HEIGHT) / 2);
+	}
+}
+
+TEST_F(ImageDecoderCompressedTest, fromETC2_RGBA_benchmark)
+{
+	for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) {
+		ImageDecoder::fromETC2_RGBA(TEX_WIDTH, TEX_HEIGHT,
+			m_src_buf.data(), TEX_WIDTH * TEX_HEIGHT);
+	}
+}
+
+#ifdef ENABLE_PVRTC
+TEST_F(ImageDecoderCompressedTest, fromPVRTC_4bpp_benchmark)
+{
+	for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) {
+		ImageDecoder::fromPVRTC(TEX_WIDTH, TEX_HEIGHT,
+			m_src_buf.data(), (TEX_WIDTH * TEX_HEIGHT) / 2,
+			ImageDecoder::PVRTC_4BPP | ImageDecoder::PVRTC_ALPHA_YES);
+	}
+}
+
+TEST_F(ImageDecoderCompressedTest, fromPVRTC_2bpp_benchmark)
+{
+	for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) {
+		ImageDecoder::fromPVRTC(TEX_WIDTH, TEX_HEIGHT,
+			m_src_buf.data(), (TEX_WIDTH * TEX_HEIGHT) / 4,
+			ImageDecoder::PVRTC_2BPP | ImageDecoder::PVRTC_ALPHA_YES);
+	}
+}
+#endif /* ENABLE_PVRTC */
+
+#ifdef ENABLE_ASTC
+// NOTE: The ASTC buffers use void-extent (constant-color) blocks,
+// since random data is rejected as invalid. This exercises the full
+// tiling path but not the more expensive partition/weight decoding.
+TEST_F(ImageDecoderCompressedTest, fromASTC_4x4_benchmark)
+{
+	for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) {
+		ImageDecoder::fromASTC(TEX_WIDTH, TEX_HEIGHT,
+			m_astc_buf.data(), TEX_WIDTH * TEX_HEIGHT, 4, 4);
+	}
+}
+
+TEST_F(ImageDecoderCompressedTest, fromASTC_8x8_benchmark)
+{
+	for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) {
+		ImageDecoder::fromASTC(TEX_WIDTH, TEX_HEIGHT,
+			m_astc_buf.data(), (TEX_WIDTH * TEX_HEIGHT) / 4, 8, 8);
+	}
+}
+#endif /* ENABLE_ASTC */
+
+} }
+
+/**
+ * Test suite main function.
+ * Called by gtest_init.cpp.
+ */
+extern "C" int gtest_main(int argc, TCHAR *argv[])
+{
+	fputs("LibRpTexture test suite: Compressed texture decoder tests.\n\n", stderr);
+	fprintf(stderr, "Benchmark iterations: %u (%u for BC7)\n",
+		LibRpTexture::Tests::ImageDecoderCompressedTest::BENCHMARK_ITERATIONS,
+		LibRpTexture::Tests::ImageDecoderCompressedTest::BENCHMARK_ITERATIONS_BC7);
+	fflush(nullptr);
+
+	// coverity[fun_call_w_exception]: uncaught exceptions cause nonzero exit anyway, so don't warn.
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,92 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpthreads)                     *
+ * SharedMutex.hpp: System-specific shared mutex implementation.           *
+ *                                                                         *
+ * Copyright (c) 2016-2024 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#pragma once
+
+// NOTE: The .cpp files are #included here in order to inline the functions.
+// Do NOT compile them separately!
+
+// Each .cpp file defines the SharedMutex class itself, with required fields.
+
+#ifdef _WIN32
+#  include "SharedMutexWin32.cpp"
+#else /* !_WIN32 */
+#  include "SharedMutexPosix.cpp"
+#endif
+
+namespace LibRpThreads {
+
+/**
+ * Automatic shared (read) locker/unlocker class.
+ * Locks the shared mutex for reading when created.
+ * Unlocks the shared mutex when it goes out of scope.
+ */
+class ReadLocker
+{
+	public:
+		inline explicit ReadLocker(SharedMutex &mutex)
+			: m_mutex(mutex)
+		{
+			m_mutex.lockShared();
+		}
+
+		inline ~ReadLocker()
+		{
+			m_mutex.unlockShared();
+		}
+
+		// Disable copy/assignment constructors.
+#if __cplusplus >= 201103L
+	public:
+		ReadLocker(const ReadLocker &) = delete;
+		ReadLocker &operator=(const ReadLocker &) = delete;
+#else /* __cplusplus < 201103L */
+	private:
+		ReadLocker(const ReadLocker &);
+		ReadLocker &operator=(const ReadLocker &);
+#endif /* __cplusplus */
+
+	private:
+		SharedMutex &m_mutex;
+};
+
+/**
+ * Automatic exclusive (write) locker/unlocker class.
+ * Locks the shared mutex for writing when created.
+ * Unlocks the shared mutex when it goes out of scope.
+ */
+class WriteLocker
+{
+	public:
+		inline explicit WriteLocker(SharedMutex &mutex)
+			: m_mutex(mutex)
+		{
+			m_mutex.lock();
+		}
+
+		inline ~WriteLocker()
+		{
+			m_mutex.unlock();
+		}
+
+		// Disable copy/assignment constructors.
+#if __cplusplus >= 201103L
+	public:
+		WriteLocker(const WriteLocker &) = delete;
+		WriteLocker &operator=(const WriteLocker &) = delete;
+#else /* __cplusplus < 201103L */
+	private:
+		WriteLocker(const WriteLocker &);
+		WriteLocker &operator=(const WriteLocker &);
+#endif /* __cplusplus */
+
+	private:
+		SharedMutex &m_mutex;
+};
+
+}
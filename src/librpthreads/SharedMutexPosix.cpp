@@ -0,0 +1,157 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpthreads)                     *
+ * SharedMutexPosix.cpp: POSIX shared mutex implementation.                *
+ *                                                                         *
+ * Copyright (c) 2016-2024 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include <pthread.h>
+
+// C includes. (C++ namespace)
+#include <cassert>
+#include <cerrno>
+
+namespace LibRpThreads {
+
+class SharedMutex
+{
+	public:
+		/**
+		 * Create a shared mutex.
+		 */
+		inline explicit SharedMutex();
+
+		/**
+		 * Delete the shared mutex.
+		 * WARNING: SharedMutex MUST be unlocked!
+		 */
+		inline ~SharedMutex();
+
+		// Disable copy/assignment constructors.
+#if __cplusplus >= 201103L
+	public:
+		SharedMutex(const SharedMutex &) = delete;
+		SharedMutex &operator=(const SharedMutex &) = delete;
+#else /* __cplusplus < 201103L */
+	private:
+		SharedMutex(const SharedMutex &);
+		SharedMutex &operator=(const SharedMutex &);
+#endif /* __cplusplus */
+
+	public:
+		/**
+		 * Lock the mutex for exclusive (write) access.
+		 * Blocks until all readers and writers have unlocked it.
+		 * @return 0 on success; non-zero on error.
+		 */
+		inline int lock(void);
+
+		/**
+		 * Unlock the mutex after exclusive (write) access.
+		 * @return 0 on success; non-zero on error.
+		 */
+		inline int unlock(void);
+
+		/**
+		 * Lock the mutex for shared (read) access.
+		 * Multiple readers can hold the lock simultaneously.
+		 * Blocks if a writer holds the lock.
+		 * @return 0 on success; non-zero on error.
+		 */
+		inline int lockShared(void);
+
+		/**
+		 * Unlock the mutex after shared (read) access.
+		 * @return 0 on success; non-zero on error.
+		 */
+		inline int unlockShared(void);
+
+	private:
+		pthread_rwlock_t m_rwlock;
+		bool m_isInit;
+};
+
+/**
+ * Create a shared mutex.
+ */
+inline SharedMutex::SharedMutex()
+	: m_isInit(false)
+{
+	int ret = pthread_rwlock_init(&m_rwlock, nullptr);
+	assert(ret == 0);
+	if (ret == 0) {
+		m_isInit = true;
+	} else {
+		// FIXME: Do something if an error occurred here...
+	}
+}
+
+/**
+ * Delete the shared mutex.
+ * WARNING: SharedMutex MUST be unlocked!
+ */
+inline SharedMutex::~SharedMutex()
+{
+	if (m_isInit) {
+		// TODO: Error checking.
+		pthread_rwlock_destroy(&m_rwlock);
+	}
+}
+
+/**
+ * Lock the mutex for exclusive (write) access.
+ * Blocks until all readers and writers have unlocked it.
+ * @return 0 on success; non-zero on error.
+ */
+inline int SharedMutex::lock(void)
+{
+	if (!m_isInit)
+		return -EBADF;
+
+	// TODO: What error to return?
+	return pthread_rwlock_wrlock(&m_rwlock);
+}
+
+/**
+ * Unlock the mutex after exclusive (write) access.
+ * @return 0 on success; non-zero on error.
+ */
+inline int SharedMutex::unlock(void)
+{
+	if (!m_isInit)
+		return -EBADF;
+
+	// TODO: What error to return?
+	return pthread_rwlock_unlock(&m_rwlock);
+}
+
+/**
+ * Lock the mutex for shared (read) access.
+ * Multiple readers can hold the lock simultaneously.
+ * Blocks if a writer holds the lock.
+ * @return 0 on success; non-zero on error.
+ */
+inline int SharedMutex::lockShared(void)
+{
+	if (!m_isInit)
+		return -EBADF;
+
+	// TODO: What error to return?
+	return pthread_rwlock_rdlock(&m_rwlock);
+}
+
+/**
+ * Unlock the mutex after shared (read) access.
+ * @return 0 on success; non-zero on error.
+ */
+inline int SharedMutex::unlockShared(void)
+{
+	if (!m_isInit)
+		return -EBADF;
+
+	// TODO: What error to return?
+	return pthread_rwlock_unlock(&m_rwlock);
+}
+
+}
@@ -0,0 +1,146 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpthreads)                     *
+ * SharedMutexWin32.cpp: Win32 shared mutex implementation.                *
+ *                                                                         *
+ * Copyright (c) 2016-2024 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+// C includes. (C++ namespace)
+#include <cassert>
+#include <cerrno>
+
+#ifndef WIN32_LEAN_AND_MEAN
+# define WIN32_LEAN_AND_MEAN 1
+#endif
+#include <windows.h>
+
+// SAL 2.0 annotations not supported by Windows SDK 7.1A. (MSVC 2010)
+#ifndef _Acquires_lock_
+# define _Acquires_lock_(lock)
+#endif
+#ifndef _Releases_lock_
+# define _Releases_lock_(lock)
+#endif
+
+namespace LibRpThreads {
+
+class SharedMutex
+{
+	public:
+		/**
+		 * Create a shared mutex.
+		 */
+		inline explicit SharedMutex();
+
+		/**
+		 * Delete the shared mutex.
+		 * WARNING: SharedMutex MUST be unlocked!
+		 */
+		inline ~SharedMutex();
+
+		// Disable copy/assignment constructors.
+#if __cplusplus >= 201103L
+	public:
+		SharedMutex(const SharedMutex &) = delete;
+		SharedMutex &operator=(const SharedMutex &) = delete;
+#else /* __cplusplus < 201103L */
+	private:
+		SharedMutex(const SharedMutex &);
+		SharedMutex &operator=(const SharedMutex &);
+#endif /* __cplusplus */
+
+	public:
+		/**
+		 * Lock the mutex for exclusive (write) access.
+		 * Blocks until all readers and writers have unlocked it.
+		 * @return 0 on success; non-zero on error.
+		 */
+		inline int lock(void);
+
+		/**
+		 * Unlock the mutex after exclusive (write) access.
+		 * @return 0 on success; non-zero on error.
+		 */
+		inline int unlock(void);
+
+		/**
+		 * Lock the mutex for shared (read) access.
+		 * Multiple readers can hold the lock simultaneously.
+		 * Blocks if a writer holds the lock.
+		 * @return 0 on success; non-zero on error.
+		 */
+		inline int lockShared(void);
+
+		/**
+		 * Unlock the mutex after shared (read) access.
+		 * @return 0 on success; non-zero on error.
+		 */
+		inline int unlockShared(void);
+
+	private:
+		SRWLOCK m_srwLock;
+};
+
+/**
+ * Create a shared mutex.
+ */
+inline SharedMutex::SharedMutex()
+{
+	// NOTE: SRWLOCK initialization cannot fail.
+	InitializeSRWLock(&m_srwLock);
+}
+
+/**
+ * Delete the shared mutex.
+ * WARNING: SharedMutex MUST be unlocked!
+ */
+inline SharedMutex::~SharedMutex()
+{
+	// NOTE: SRWLOCKs are not explicitly destroyed.
+}
+
+/**
+ * Lock the mutex for exclusive (write) access.
+ * Blocks until all readers and writers have unlocked it.
+ * @return 0 on success; non-zero on error.
+ */
+inline int SharedMutex::lock(void)
+{
+	AcquireSRWLockExclusive(&m_srwLock);
+	return 0;
+}
+
+/**
+ * Unlock the mutex after exclusive (write) access.
+ * @return 0 on success; non-zero on error.
+ */
+inline int SharedMutex::unlock(void)
+{
+	ReleaseSRWLockExclusive(&m_srwLock);
+	return 0;
+}
+
+/**
+ * Lock the mutex for shared (read) access.
+ * Multiple readers can hold the lock simultaneously.
+ * Blocks if a writer holds the lock.
+ * @return 0 on success; non-zero on error.
+ */
+inline int SharedMutex::lockShared(void)
+{
+	AcquireSRWLockShared(&m_srwLock);
+	return 0;
+}
+
+/**
+ * Unlock the mutex after shared (read) access.
+ * @return 0 on success; non-zero on error.
+ */
+inline int SharedMutex::unlockShared(void)
+{
+	ReleaseSRWLockShared(&m_srwLock);
+	return 0;
+}
+
+}
@@ -0,0 +1,150 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpthreads)                     *
+ * ThreadPool.cpp: Process-wide task pool.                                 *
+ *                                                                         *
+ * Copyright (c) 2016-2024 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "ThreadPool.hpp"
+
+// C includes (C++ namespace)
+#include <cassert>
+
+// C++ includes
+#include <chrono>
+#include <thread>
+#include <utility>
+
+namespace LibRpThreads {
+
+// Idle worker threads shut down after this many seconds.
+static constexpr unsigned int IDLE_SHUTDOWN_SECS = 10U;
+
+ThreadPool::ThreadPool()
+	: m_threads(0)
+	, m_idle(0)
+{
+	// Size the pool from the core count.
+	// hardware_concurrency() can return 0 if it can't be determined.
+	const unsigned int hw_threads = std::thread::hardware_concurrency();
+	m_maxThreads = (hw_threads > 0 ? hw_threads : 1);
+}
+
+/**
+ * Get the ThreadPool instance.
+ * @return ThreadPool instance
+ */
+ThreadPool &ThreadPool::instance(void)
+{
+	// NOTE: Intentionally leaked. Worker threads are detached, so
+	// destroying the pool during static destruction could leave a
+	// worker referencing a destroyed mutex.
+	static ThreadPool *const q_threadPool = new ThreadPool();
+	return *q_threadPool;
+}
+
+/**
+ * Submit a task to the pool.
+ * A worker thread is started if none are idle and
+ * the pool isn't at its maximum thread count.
+ * @param task Task to run
+ */
+void ThreadPool::submit(std::function<void()> task)
+{
+	assert(task != nullptr);
+	if (!task) {
+		return;
+	}
+
+	bool startThread = false;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_tasks.push_back(std::move(task));
+
+		// Start a worker thread if no idle worker will
+		// pick this task up.
+		if (m_idle == 0 && m_threads < m_maxThreads) {
+			m_threads++;
+			startThread = true;
+		}
+	}
+
+	if (startThread) {
+		std::thread(&ThreadPool::workerThread, this).detach();
+	} else {
+		m_cv.notify_one();
+	}
+}
+
+/**
+ * Worker thread main loop.
+ */
+void ThreadPool::workerThread(void)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while (true) {
+		if (m_tasks.empty()) {
+			// No tasks are available.
+			// Wait for one, and shut down if still idle
+			// after the timeout.
+			m_idle++;
+			const bool hasTask = m_cv.wait_for(lock,
+				std::chrono::seconds(IDLE_SHUTDOWN_SECS),
+				[this] { return !m_tasks.empty(); });
+			m_idle--;
+			if (!hasTask) {
+				// Idle timeout. Shut down this thread.
+				m_threads--;
+				return;
+			}
+		}
+
+		std::function<void()> task = std::move(m_tasks.front());
+		m_tasks.pop_front();
+
+		lock.unlock();
+		task();
+		lock.lock();
+	}
+}
+
+/**
+ * Submit a task as part of this set.
+ * @param task Task to run
+ */
+void TaskSet::submit(std::function<void()> task)
+{
+	assert(task != nullptr);
+	if (!task) {
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_pending++;
+	}
+
+	ThreadPool::instance().submit(
+		[this, task = std::move(task)]() {
+			task();
+
+			std::lock_guard<std::mutex> lock(m_mutex);
+			assert(m_pending > 0);
+			m_pending--;
+			if (m_pending == 0) {
+				m_cv.notify_all();
+			}
+		});
+}
+
+/**
+ * Wait for all tasks in this set to finish.
+ */
+void TaskSet::wait(void)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_cv.wait(lock, [this] { return (m_pending == 0); });
+}
+
+}
@@ -0,0 +1,124 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpthreads)                     *
+ * ThreadPool.hpp: Process-wide task pool.                                 *
+ *                                                                         *
+ * Copyright (c) 2016-2024 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#pragma once
+
+// C includes (C++ namespace)
+#include <cstddef>
+
+// C++ includes
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+
+namespace LibRpThreads {
+
+/**
+ * Process-wide task pool.
+ *
+ * Worker threads are started lazily on submit() and shut themselves
+ * down after an idle timeout, so an idle process carries no threads.
+ * The pool is sized once per process from the core count.
+ *
+ * Tasks must not throw exceptions.
+ *
+ * Use TaskSet to wait for a specific group of submitted tasks.
+ */
+class ThreadPool
+{
+	protected:
+		ThreadPool();
+
+	public:
+		/**
+		 * Get the ThreadPool instance.
+		 * @return ThreadPool instance
+		 */
+		static ThreadPool &instance(void);
+
+		// Disable copy/assignment constructors.
+		ThreadPool(const ThreadPool &) = delete;
+		ThreadPool &operator=(const ThreadPool &) = delete;
+
+	public:
+		/**
+		 * Submit a task to the pool.
+		 * A worker thread is started if none are idle and
+		 * the pool isn't at its maximum thread count.
+		 * @param task Task to run
+		 */
+		void submit(std::function<void()> task);
+
+		/**
+		 * Get the maximum number of worker threads.
+		 * @return Maximum number of worker threads
+		 */
+		inline unsigned int maxThreads(void) const
+		{
+			return m_maxThreads;
+		}
+
+	private:
+		/**
+		 * Worker thread main loop.
+		 */
+		void workerThread(void);
+
+	private:
+		std::deque<std::function<void()> > m_tasks;
+		std::mutex m_mutex;
+		std::condition_variable m_cv;
+
+		unsigned int m_maxThreads;	// Maximum number of worker threads.
+		unsigned int m_threads;		// Current number of worker threads.
+		unsigned int m_idle;		// Number of idle worker threads.
+};
+
+/**
+ * A group of tasks submitted to the ThreadPool.
+ *
+ * submit() forwards tasks to ThreadPool::instance();
+ * wait() blocks until all tasks in this set have finished.
+ */
+class TaskSet
+{
+	public:
+		TaskSet()
+			: m_pending(0)
+		{}
+
+		~TaskSet()
+		{
+			// Make sure no tasks are still referencing this TaskSet.
+			wait();
+		}
+
+		// Disable copy/assignment constructors.
+		TaskSet(const TaskSet &) = delete;
+		TaskSet &operator=(const TaskSet &) = delete;
+
+	public:
+		/**
+		 * Submit a task as part of this set.
+		 * @param task Task to run
+		 */
+		void submit(std::function<void()> task);
+
+		/**
+		 * Wait for all tasks in this set to finish.
+		 */
+		void wait(void);
+
+	private:
+		std::mutex m_mutex;
+		std::condition_variable m_cv;
+		unsigned int m_pending;
+};
+
+}
@@ -0,0 +1,97 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpthreads)                     *
+ * rp_once.h: One-time initialization with an inline fast path.            *
+ *                                                                         *
+ * Copyright (c) 2016-2024 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#pragma once
+
+// pthread_once() is a function call even when initialization has long
+// since completed, and on glibc it also performs a fence on every call.
+// That adds up in per-file paths like RomDataFactory dispatch during
+// bulk scans.
+//
+// rp_once() wraps pthread_once() with an inlineable "already done"
+// check: a single acquire load and compare. Only the first call(s)
+// take the pthread_once() slow path; the steady state is ~2
+// instructions at the call site.
+//
+// Usage:
+//	static rp_once_t my_once = RP_ONCE_INIT;
+//	rp_once(&my_once, init_function);
+
+#include "pthread_once.h"
+#include "common.h"
+#include "force_inline.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct rp_once_t {
+	int done;		// 1 once init_routine has completed.
+	pthread_once_t once;	// Slow path control.
+} rp_once_t;
+
+#define RP_ONCE_INIT { 0, PTHREAD_ONCE_INIT }
+
+/**
+ * Slow path: run (or wait for) the initialization routine.
+ * Do not call this directly; use rp_once().
+ * @param once_control rp_once_t control variable.
+ * @param init_routine Initialization routine.
+ * @return 0 on success; non-zero on error.
+ */
+static inline int rp_once_slow(rp_once_t *once_control, void (*init_routine)(void))
+{
+	// pthread_once() guarantees init_routine has completed
+	// before it returns, including for concurrent callers.
+	int ret = pthread_once(&once_control->once, init_routine);
+	if (ret == 0) {
+		// Publish the fast-path flag.
+		// pthread_once() synchronized us with the initializing
+		// thread, so a release store here is sufficient for
+		// subsequent acquire loads in rp_once().
+#ifdef __GNUC__
+		__atomic_store_n(&once_control->done, 1, __ATOMIC_RELEASE);
+#else /* !__GNUC__ */
+		// MSVC: Volatile stores have release semantics on x86/x64,
+		// and with /volatile:ms on ARM.
+		*(volatile int*)&once_control->done = 1;
+#endif /* __GNUC__ */
+	}
+	return ret;
+}
+
+/**
+ * Run an initialization routine exactly once.
+ * Inline fast path: a single acquire load once initialization
+ * has completed.
+ * @param once_control rp_once_t control variable.
+ * @param init_routine Initialization routine.
+ * @return 0 on success; non-zero on error.
+ */
+static FORCEINLINE int rp_once(rp_once_t *once_control, void (*init_routine)(void))
+{
+#ifdef __GNUC__
+	if (likely(__atomic_load_n(&once_control->done, __ATOMIC_ACQUIRE) == 1)) {
+		// Already initialized.
+		return 0;
+	}
+#else /* !__GNUC__ */
+	// MSVC: Volatile loads have acquire semantics on x86/x64,
+	// and with /volatile:ms on ARM.
+	if (*(volatile int*)&once_control->done == 1) {
+		// Already initialized.
+		return 0;
+	}
+#endif /* __GNUC__ */
+
+	return rp_once_slow(once_control, init_routine);
+}
+
+#ifdef __cplusplus
+}
+#endif
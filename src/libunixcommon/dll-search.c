@@ -8,17 +8,25 @@
 
 #include "config.libunixcommon.h"
 #include "dll-search.h"
+#include "stdboolx.h"
 
 // C includes.
 #include <assert.h>
 #include <dlfcn.h>
 #include <errno.h>
+#include <limits.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/stat.h>
+#include <sys/types.h>
 #include <unistd.h>
 
+#ifndef PATH_MAX
+#  define PATH_MAX 1024
+#endif
+
 // OpenBSD 6.5 doesn't have the static_assert() macro,
 // even though it *does* use LLVM/Clang 7.0.1.
 #ifndef static_assert
@@ -87,6 +95,233 @@ static const uint8_t plugin_prio[RP_FE_MAX][RP_FE_MAX] = {
 	{RP_FE_GTK4, RP_FE_GTK3, RP_FE_GTK2, RP_FE_KF6, RP_FE_KF5, RP_FE_KDE4},	// RP_FE_GTK4
 };
 
+/** Plugin path cache **/
+
+// The resolved plugin path is cached in the XDG cache directory
+// (per-user, so effectively per-UID) and is invalidated if the mtime
+// of any candidate plugin directory changes, or if the desktop
+// environment or requested symbol differs. Steady-state invocations
+// dlopen() the right library on the first try.
+#define RP_DLL_CACHE_MAGIC "RP-STUB-DLL-CACHE-1"
+
+/**
+ * Get the mtime of a candidate plugin's directory.
+ * @param plugin_path	[in] Full plugin path (may be NULL)
+ * @return mtime, or 0 if the directory doesn't exist.
+ */
+static int64_t plugin_dir_mtime(const char *plugin_path)
+{
+	if (!plugin_path)
+		return 0;
+
+	char dirbuf[PATH_MAX];
+	const char *const slash = strrchr(plugin_path, '/');
+	if (!slash || (size_t)(slash - plugin_path) >= sizeof(dirbuf))
+		return 0;
+	memcpy(dirbuf, plugin_path, slash - plugin_path);
+	dirbuf[slash - plugin_path] = '\0';
+
+	struct stat sb;
+	if (stat(dirbuf, &sb) != 0)
+		return 0;
+	return (int64_t)sb.st_mtime;
+}
+
+/**
+ * Check if a path is one of the compiled-in candidate plugin paths.
+ * Only compiled-in paths are ever dlopen()'d, even if the cache
+ * file was modified to contain something else.
+ * @param path	[in] Plugin path
+ * @return true if it's a candidate path; false if not.
+ */
+static bool is_candidate_plugin_path(const char *path)
+{
+	for (unsigned int i = 0; i < RP_FE_MAX; i++) {
+		for (unsigned int j = 0; j < 2; j++) {
+			const char *const plugin_path = RP_Extension_Path[i][j];
+			if (plugin_path && !strcmp(path, plugin_path)) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+/**
+ * Get the plugin path cache filename:
+ * $XDG_CACHE_HOME/rom-properties/rp-stub-dll.cache
+ * ($HOME/.cache is used if $XDG_CACHE_HOME is not set.)
+ * @param buf	[out] Buffer for the filename
+ * @param len	[in] Size of buf
+ * @param mkdirs [in] If true, create the cache subdirectory.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+static int get_dll_cache_filename(char *buf, size_t len, bool mkdirs)
+{
+	int cnt;
+	const char *const xdg_cache_home = getenv("XDG_CACHE_HOME");
+	if (xdg_cache_home && xdg_cache_home[0] == '/') {
+		cnt = snprintf(buf, len, "%s/rom-properties", xdg_cache_home);
+	} else {
+		const char *const home = getenv("HOME");
+		if (!home || home[0] != '/')
+			return -ENOENT;
+		cnt = snprintf(buf, len, "%s/.cache/rom-properties", home);
+	}
+	if (cnt <= 0 || (size_t)cnt >= len - 32)
+		return -ENAMETOOLONG;
+
+	if (mkdirs) {
+		// Create the subdirectory.
+		// (The XDG cache root is assumed to exist.)
+		if (mkdir(buf, 0777) != 0 && errno != EEXIST)
+			return -errno;
+	}
+
+	snprintf(&buf[cnt], len - cnt, "/rp-stub-dll.cache");
+	return 0;
+}
+
+/**
+ * Attempt to load the plugin using the cached path.
+ * @param symname	[in] Symbol name to look up.
+ * @param cur_desktop	[in] Active desktop environment.
+ * @param ppDll		[out] Handle to opened library.
+ * @param ppfn		[out] Pointer to function.
+ * @param pfnDebug	[in,opt] Pointer to debug logging function. (may be NULL)
+ * @return 0 on success; negative POSIX error code if the cache is stale or invalid.
+ */
+static int rp_dll_try_cache(const char *symname, RP_Frontend cur_desktop,
+	void **ppDll, void **ppfn, PFN_RP_DLL_DEBUG pfnDebug)
+{
+	char cache_filename[PATH_MAX];
+	if (get_dll_cache_filename(cache_filename, sizeof(cache_filename), false) != 0)
+		return -ENOENT;
+
+	FILE *f = fopen(cache_filename, "r");
+	if (!f)
+		return -ENOENT;
+
+	// Cache file format (text):
+	// - Line 1: magic
+	// - Line 2: desktop environment and symbol name
+	// - Line 3: resolved plugin path
+	// - Line 4: mtimes of all candidate plugin directories
+	char line[PATH_MAX];
+	char plugin_path[PATH_MAX];
+	bool ok = false;
+	do {
+		if (!fgets(line, sizeof(line), f))
+			break;
+		if (strcmp(line, RP_DLL_CACHE_MAGIC "\n") != 0)
+			break;
+
+		int desktop = -1;
+		char sym[64];
+		if (!fgets(line, sizeof(line), f))
+			break;
+		if (sscanf(line, "%d %63s", &desktop, sym) != 2)
+			break;
+		if (desktop != (int)cur_desktop || strcmp(sym, symname) != 0)
+			break;
+
+		if (!fgets(plugin_path, sizeof(plugin_path), f))
+			break;
+		size_t path_len = strlen(plugin_path);
+		if (path_len > 0 && plugin_path[path_len-1] == '\n') {
+			plugin_path[--path_len] = '\0';
+		}
+		if (!is_candidate_plugin_path(plugin_path))
+			break;
+
+		if (!fgets(line, sizeof(line), f))
+			break;
+		const char *p = line;
+		bool mtimes_match = true;
+		for (unsigned int i = 0; i < RP_FE_MAX && mtimes_match; i++) {
+			for (unsigned int j = 0; j < 2; j++) {
+				char *endptr = NULL;
+				const long long mtime = strtoll(p, &endptr, 10);
+				if (endptr == p) {
+					mtimes_match = false;
+					break;
+				}
+				if (mtime != (long long)plugin_dir_mtime(RP_Extension_Path[i][j])) {
+					mtimes_match = false;
+					break;
+				}
+				p = endptr;
+			}
+		}
+		if (!mtimes_match)
+			break;
+
+		ok = true;
+	} while (0);
+	fclose(f);
+
+	if (!ok) {
+		// Cache is stale or invalid.
+		return -EINVAL;
+	}
+
+	if (pfnDebug) {
+		pfnDebug(LEVEL_DEBUG, "Using cached plugin path: %s", plugin_path);
+	}
+	*ppDll = dlopen(plugin_path, RTLD_LOCAL|RTLD_LAZY);
+	if (!*ppDll) {
+		if (pfnDebug) {
+			pfnDebug(LEVEL_DEBUG, "*** dlopen() failed: %s", dlerror());
+		}
+		return -ENOENT;
+	}
+	*ppfn = dlsym(*ppDll, symname);
+	if (!*ppfn) {
+		if (pfnDebug) {
+			pfnDebug(LEVEL_DEBUG, "*** dlsym() failed: %s", dlerror());
+		}
+		dlclose(*ppDll);
+		*ppDll = NULL;
+		return -ENOENT;
+	}
+	return 0;
+}
+
+/**
+ * Save the resolved plugin path to the cache file.
+ * Failure is non-fatal; the next invocation will do a full search again.
+ * @param symname	[in] Symbol name that was looked up.
+ * @param cur_desktop	[in] Active desktop environment.
+ * @param plugin_path	[in] Resolved plugin path.
+ * @param pfnDebug	[in,opt] Pointer to debug logging function. (may be NULL)
+ */
+static void rp_dll_save_cache(const char *symname, RP_Frontend cur_desktop,
+	const char *plugin_path, PFN_RP_DLL_DEBUG pfnDebug)
+{
+	char cache_filename[PATH_MAX];
+	if (get_dll_cache_filename(cache_filename, sizeof(cache_filename), true) != 0)
+		return;
+
+	FILE *f = fopen(cache_filename, "w");
+	if (!f) {
+		if (pfnDebug) {
+			pfnDebug(LEVEL_DEBUG, "*** Could not write plugin path cache: %s", strerror(errno));
+		}
+		return;
+	}
+
+	fputs(RP_DLL_CACHE_MAGIC "\n", f);
+	fprintf(f, "%d %s\n", (int)cur_desktop, symname);
+	fprintf(f, "%s\n", plugin_path);
+	for (unsigned int i = 0; i < RP_FE_MAX; i++) {
+		for (unsigned int j = 0; j < 2; j++) {
+			fprintf(f, "%lld ", (long long)plugin_dir_mtime(RP_Extension_Path[i][j]));
+		}
+	}
+	fputc('\n', f);
+	fclose(f);
+}
+
 /**
  * Get a process's executable name.
  * @param pid		[in] Process ID.
@@ -401,7 +636,14 @@ int rp_dll_search(const char *symname, void **ppDll, void **ppfn, PFN_RP_DLL_DEB
 		cur_desktop = RP_FE_GTK3;
 	}
 
+	// Check the plugin path cache first.
+	// If it's fresh, we'll dlopen() the right library on the first try.
+	if (rp_dll_try_cache(symname, cur_desktop, ppDll, ppfn, pfnDebug) == 0) {
+		return 0;
+	}
+
 	const uint8_t *const prio = &plugin_prio[cur_desktop][0];
+	const char *found_path = NULL;
 	*ppDll = NULL;
 	*ppfn = NULL;
 	for (unsigned int i = 0; i < RP_FE_MAX; i++) {
@@ -439,6 +681,7 @@ int rp_dll_search(const char *symname, void **ppDll, void **ppfn, PFN_RP_DLL_DEB
 		}
 
 		// Found the symbol.
+		found_path = plugin_path;
 		break;
 	} }
 
@@ -449,5 +692,7 @@ int rp_dll_search(const char *symname, void **ppDll, void **ppfn, PFN_RP_DLL_DEB
 		return -ENOENT;
 	}
 
+	// Cache the resolved path for subsequent invocations.
+	rp_dll_save_cache(symname, cur_desktop, found_path, pfnDebug);
 	return 0;
 }
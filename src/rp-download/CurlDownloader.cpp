@@ -10,6 +10,8 @@
 #include "CurlDownloader.hpp"
 
 // C++ STL classes.
+#include <algorithm>
+#include <vector>
 using std::string;
 
 // cURL for network access.
@@ -34,7 +36,7 @@ CurlDownloader::CurlDownloader(const tstring &url)
  * @param ptr Data to write.
  * @param size Element size.
  * @param nmemb Number of elements.
- * @param userdata m_data pointer.
+ * @param userdata CurlWriteContext pointer.
  * @return Number of bytes written.
  */
 size_t CurlDownloader::write_data(char *ptr, size_t size, size_t nmemb, void *userdata)
@@ -43,13 +45,13 @@ size_t CurlDownloader::write_data(char *ptr, size_t size, size_t nmemb, void *us
 	// - http://stackoverflow.com/questions/1636333/download-file-using-libcurl-in-c-c
 	// - http://stackoverflow.com/a/1636415
 	// - https://curl.haxx.se/libcurl/c/CURLOPT_WRITEFUNCTION.html
-	CurlDownloader *curlDL = static_cast<CurlDownloader*>(userdata);
-	rp::uvector<uint8_t> *vec = &curlDL->m_data;
+	CurlWriteContext *const ctx = static_cast<CurlWriteContext*>(userdata);
+	rp::uvector<uint8_t> *vec = ctx->vec;
 	const size_t len = size * nmemb;
 
-	if (curlDL->m_maxSize > 0) {
+	if (ctx->maxSize > 0) {
 		// Maximum buffer size is set.
-		if (vec->size() + len > curlDL->m_maxSize) {
+		if (vec->size() + len > ctx->maxSize) {
 			// Out of memory.
 			return 0;
 		}
@@ -74,7 +76,7 @@ size_t CurlDownloader::write_data(char *ptr, size_t size, size_t nmemb, void *us
  * @param ptr Pointer to header data. (NOT necessarily null-terminated!)
  * @param size Element size.
  * @param nitems Number of elements.
- * @param userdata m_data pointer.
+ * @param userdata CurlWriteContext pointer.
  * @return Amount of data processed, or 0 on error.
  */
 size_t CurlDownloader::parse_header(char *ptr, size_t size, size_t nitems, void *userdata)
@@ -83,13 +85,14 @@ size_t CurlDownloader::parse_header(char *ptr, size_t size, size_t nitems, void
 	// - https://curl.haxx.se/libcurl/c/CURLOPT_HEADERFUNCTION.html
 
 	// TODO: Add support for non-HTTP protocols?
-	CurlDownloader *curlDL = static_cast<CurlDownloader*>(userdata);
-	rp::uvector<uint8_t> *vec = &curlDL->m_data;
+	CurlWriteContext *const ctx = static_cast<CurlWriteContext*>(userdata);
+	rp::uvector<uint8_t> *vec = ctx->vec;
 	const size_t len = size * nitems;
 
 	// Supported headers.
 	static constexpr char http_content_length[] = "Content-Length: ";
 	static constexpr char http_last_modified[] = "Last-Modified: ";
+	static constexpr char http_etag[] = "ETag: ";
 
 	if (len >= sizeof(http_content_length) &&
 	    !strncasecmp(ptr, http_content_length, sizeof(http_content_length)-1))
@@ -116,8 +119,8 @@ size_t CurlDownloader::parse_header(char *ptr, size_t size, size_t nitems, void
 		} else if (fileSize <= 0) {
 			// Content-Length is too small.
 			return 0;
-		} else if (curlDL->m_maxSize > 0 &&
-			   fileSize > (off64_t)curlDL->m_maxSize)
+		} else if (ctx->maxSize > 0 &&
+			   fileSize > (off64_t)ctx->maxSize)
 		{
 			// Content-Length is too big.
 			return 0;
@@ -143,7 +146,21 @@ size_t CurlDownloader::parse_header(char *ptr, size_t size, size_t nitems, void
 		mtime_str[val_len] = 0;
 
 		// Parse the modification time.
-		curlDL->m_mtime = curl_getdate(mtime_str, nullptr);
+		*(ctx->pMtime) = curl_getdate(mtime_str, nullptr);
+	}
+	else if (len >= sizeof(http_etag) &&
+	         !strncasecmp(ptr, http_etag, sizeof(http_etag)-1))
+	{
+		// Found the ETag.
+		// Save it verbatim (minus trailing CR/LF) for If-None-Match.
+		const char *val = ptr + sizeof(http_etag)-1;
+		size_t val_len = len - (sizeof(http_etag)-1);
+		while (val_len > 0 && (val[val_len-1] == '\r' || val[val_len-1] == '\n')) {
+			val_len--;
+		}
+		if (ctx->pEtag) {
+			ctx->pEtag->assign(val, val_len);
+		}
 	}
 
 	// Continue processing.
@@ -151,34 +168,27 @@ size_t CurlDownloader::parse_header(char *ptr, size_t size, size_t nitems, void
 }
 
 /**
- * Download the file.
- * @return 0 on success; negative POSIX error code, positive HTTP status code on error.
+ * Set up common options on a cURL easy handle.
+ * NOTE: Handles are passed as void* to avoid pulling curl.h in here.
+ * @param curl			[in] cURL easy handle.
+ * @param url			[in] URL.
+ * @param if_modified_since	[in] If-Modified-Since timestamp. (-1 for none)
+ * @param if_none_match		[in,opt] If-None-Match ETag. (nullptr or empty for none)
+ * @param ctx			[in] Write context.
+ * @param pHeaderList		[out] Custom header list (curl_slist). Must be freed
+ *				      with curl_slist_free_all() after the transfer.
  */
-int CurlDownloader::download(void)
+void CurlDownloader::setupEasyOptions(void *vcurl, const TCHAR *url, time_t if_modified_since,
+	const TCHAR *if_none_match, CurlWriteContext *ctx, void **pHeaderList)
 {
-	// References:
-	// - http://stackoverflow.com/questions/1636333/download-file-using-libcurl-in-c-c
-	// - http://stackoverflow.com/a/1636415
-	// - https://curl.haxx.se/libcurl/c/curl_easy_setopt.html
-
-	// Clear the previous download.
-	m_data.clear();
-	m_mtime = -1;
-
-	// Initialize cURL.
-	CURL *curl = curl_easy_init();
-	if (!curl) {
-		// Could not initialize cURL.
-		return -ENOMEM;	// TODO: Better error?
-	}
+	CURL *const curl = static_cast<CURL*>(vcurl);
+	*pHeaderList = nullptr;
 
 	// Proxy settings should be set by the calling application
 	// in the http_proxy and https_proxy variables.
 
-	// TODO: Send a HEAD request first?
-
 	// Set options for curl's "easy" mode.
-	curl_easy_setopt(curl, CURLOPT_URL, m_url.c_str());
+	curl_easy_setopt(curl, CURLOPT_URL, url);
 	curl_easy_setopt(curl, CURLOPT_NOPROGRESS, true);
 	// Fail on HTTP errors. (>= 400)
 	curl_easy_setopt(curl, CURLOPT_FAILONERROR, true);
@@ -189,21 +199,32 @@ int CurlDownloader::download(void)
 	// NOTE: Probably not needed for http...
 	curl_easy_setopt(curl, CURLOPT_FILETIME, 1L);
 
-	if (m_if_modified_since >= 0) {
+	if (if_modified_since >= 0) {
 		// Add an "If-Modified-Since" header.
 #if LIBCURL_VERSION_NUM >= 0x073B00
-		curl_easy_setopt(curl, CURLOPT_TIMEVALUE_LARGE, static_cast<curl_off_t>(m_if_modified_since));
+		curl_easy_setopt(curl, CURLOPT_TIMEVALUE_LARGE, static_cast<curl_off_t>(if_modified_since));
 #else /* LIBCURL_VERSION_NUM < 0x073B00 */
-		curl_easy_setopt(curl, CURLOPT_TIMEVALUE, static_cast<long>(m_if_modified_since));
+		curl_easy_setopt(curl, CURLOPT_TIMEVALUE, static_cast<long>(if_modified_since));
 #endif /* LIBCURL_VERSION_NUM >= 0x073B00 */
 		curl_easy_setopt(curl, CURLOPT_TIMECONDITION, CURL_TIMECOND_IFMODSINCE);
 	}
 
+	if (if_none_match && if_none_match[0] != _T('\0')) {
+		// Add an "If-None-Match" header for ETag revalidation.
+		string header = "If-None-Match: ";
+		header += if_none_match;
+		struct curl_slist *list = curl_slist_append(nullptr, header.c_str());
+		if (list) {
+			curl_easy_setopt(curl, CURLOPT_HTTPHEADER, list);
+			*pHeaderList = list;
+		}
+	}
+
 	// Header and data functions.
 	curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, parse_header);
-	curl_easy_setopt(curl, CURLOPT_HEADERDATA, this);
+	curl_easy_setopt(curl, CURLOPT_HEADERDATA, ctx);
 	curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_data);
-	curl_easy_setopt(curl, CURLOPT_WRITEDATA, this);
+	curl_easy_setopt(curl, CURLOPT_WRITEDATA, ctx);
 
 	// Don't use signals. We're running as a plugin, so using
 	// signals might interfere.
@@ -218,16 +239,40 @@ int CurlDownloader::download(void)
 
 	// Set the User-Agent.
 	curl_easy_setopt(curl, CURLOPT_USERAGENT, m_userAgent.c_str());
+}
+
+/**
+ * Interpret the result of a completed cURL transfer.
+ * @param curl			[in] cURL easy handle.
+ * @param res			[in] CURLcode from the transfer.
+ * @param data			[in] Downloaded data.
+ * @param if_modified_since	[in] If-Modified-Since timestamp. (-1 for none)
+ * @return 0 on success; negative POSIX error code, positive HTTP status code on error.
+ */
+int CurlDownloader::interpretCurlResult(void *vcurl, int res, const rp::uvector<uint8_t> &data, time_t if_modified_since)
+{
+	CURL *const curl = static_cast<CURL*>(vcurl);
 
-	// Download the file.
 	int ret;
-	CURLcode res = curl_easy_perform(curl);
-	switch (res) {
+	switch (static_cast<CURLcode>(res)) {
 		case CURLE_OK:
 			// If the file is empty, check for a 304.
-			if (m_data.empty() && m_if_modified_since >= 0) {
-				long unmet = 0;
-				if (!curl_easy_getinfo(curl, CURLINFO_CONDITION_UNMET, &unmet) && unmet) {
+			if (data.empty()) {
+				if (if_modified_since >= 0) {
+					long unmet = 0;
+					if (!curl_easy_getinfo(curl, CURLINFO_CONDITION_UNMET, &unmet) && unmet) {
+						// HTTP 304 Not Modified
+						ret = 304;
+						break;
+					}
+				}
+
+				// NOTE: CURLINFO_CONDITION_UNMET only covers CURLOPT_TIMECONDITION.
+				// An If-None-Match match comes back as a plain 304 response.
+				long response_code = 0;
+				if (!curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &response_code) &&
+				    response_code == 304)
+				{
 					// HTTP 304 Not Modified
 					ret = 304;
 					break;
@@ -243,7 +288,7 @@ int CurlDownloader::download(void)
 			ret = -ETIMEDOUT;
 			break;
 
-		default:
+		default: {
 			// Some other error downloading the file.
 			// Check if we have an HTTP response code.
 			// NOTE: GameTDB sometimes returns nothing instead of 404...
@@ -256,15 +301,15 @@ int CurlDownloader::download(void)
 			}
 			ret = (int)response_code;
 			break;
+		}
 	}
 
-	curl_easy_cleanup(curl);
 	if (ret != 0) {
 		return ret;
 	}
 
 	// Check if we have data.
-	if (m_data.empty()) {
+	if (data.empty()) {
 		// No data.
 		return -EIO;	// TODO: Better error?
 	}
@@ -273,4 +318,168 @@ int CurlDownloader::download(void)
 	return 0;
 }
 
+/**
+ * Download the file.
+ * @return 0 on success; negative POSIX error code, positive HTTP status code on error.
+ */
+int CurlDownloader::download(void)
+{
+	// References:
+	// - http://stackoverflow.com/questions/1636333/download-file-using-libcurl-in-c-c
+	// - http://stackoverflow.com/a/1636415
+	// - https://curl.haxx.se/libcurl/c/curl_easy_setopt.html
+
+	// Clear the previous download.
+	m_data.clear();
+	m_mtime = -1;
+	m_etag.clear();
+
+	// Initialize cURL.
+	CURL *curl = curl_easy_init();
+	if (!curl) {
+		// Could not initialize cURL.
+		return -ENOMEM;	// TODO: Better error?
+	}
+
+	// TODO: Send a HEAD request first?
+
+	CurlWriteContext ctx = {&m_data, &m_mtime, &m_etag, m_maxSize};
+	void *headerList = nullptr;
+	setupEasyOptions(curl, m_url.c_str(), m_if_modified_since,
+		m_if_none_match.c_str(), &ctx, &headerList);
+
+	// Download the file.
+	const CURLcode res = curl_easy_perform(curl);
+	const int ret = interpretCurlResult(curl, res, m_data, m_if_modified_since);
+	curl_easy_cleanup(curl);
+	curl_slist_free_all(static_cast<struct curl_slist*>(headerList));
+	return ret;
+}
+
+/**
+ * Download multiple files in one batch.
+ *
+ * The transfers are run concurrently using curl_multi, with
+ * connection reuse and HTTP/2 multiplexing where available.
+ *
+ * Per-file status is returned in each request's result field.
+ *
+ * @param requests Batch requests.
+ * @return 0 on success; negative POSIX error code if the batch could not be run.
+ */
+int CurlDownloader::downloadBatch(std::vector<BatchRequest> &requests)
+{
+	// References:
+	// - https://curl.haxx.se/libcurl/c/libcurl-multi.html
+	// - https://curl.haxx.se/libcurl/c/CURLMOPT_PIPELINING.html
+
+	if (requests.empty()) {
+		// Nothing to download.
+		return 0;
+	}
+
+	CURLM *const multi = curl_multi_init();
+	if (!multi) {
+		// Could not initialize cURL.
+		return -ENOMEM;	// TODO: Better error?
+	}
+
+#if LIBCURL_VERSION_NUM >= 0x072B00
+	// Multiplex transfers over a single connection if the
+	// server supports HTTP/2.
+	curl_multi_setopt(multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+#endif /* LIBCURL_VERSION_NUM >= 0x072B00 */
+#if LIBCURL_VERSION_NUM >= 0x071E00
+	// Don't hammer the art servers with connections.
+	curl_multi_setopt(multi, CURLMOPT_MAX_HOST_CONNECTIONS, 6L);
+#endif /* LIBCURL_VERSION_NUM >= 0x071E00 */
+
+	// Set up one easy handle per request.
+	// NOTE: The contexts vector must not reallocate after handles
+	// are added, since the handles point into it.
+	std::vector<CurlWriteContext> ctxs(requests.size());
+	std::vector<CURL*> handles(requests.size(), nullptr);
+	std::vector<void*> headerLists(requests.size(), nullptr);
+	for (size_t i = 0; i < requests.size(); i++) {
+		BatchRequest &req = requests[i];
+		req.data.clear();
+		req.mtime = -1;
+		req.etag.clear();
+		req.result = -EIO;
+
+		CURL *const curl = curl_easy_init();
+		if (!curl) {
+			req.result = -ENOMEM;
+			continue;
+		}
+
+		ctxs[i] = CurlWriteContext{&req.data, &req.mtime, &req.etag, m_maxSize};
+		setupEasyOptions(curl, req.url.c_str(), req.if_modified_since,
+			req.if_none_match.c_str(), &ctxs[i], &headerLists[i]);
+		curl_easy_setopt(curl, CURLOPT_PRIVATE, &req);
+#if LIBCURL_VERSION_NUM >= 0x072B00
+		// Prefer multiplexing over opening a new connection.
+		curl_easy_setopt(curl, CURLOPT_PIPEWAIT, 1L);
+#endif /* LIBCURL_VERSION_NUM >= 0x072B00 */
+
+		curl_multi_add_handle(multi, curl);
+		handles[i] = curl;
+	}
+
+	// Run the transfers.
+	int still_running = 0;
+	do {
+		CURLMcode mc = curl_multi_perform(multi, &still_running);
+		if (mc != CURLM_OK) {
+			break;
+		}
+
+		// Handle completed transfers.
+		int msgs_in_queue = 0;
+		CURLMsg *msg;
+		while ((msg = curl_multi_info_read(multi, &msgs_in_queue)) != nullptr) {
+			if (msg->msg != CURLMSG_DONE) {
+				continue;
+			}
+
+			CURL *const curl = msg->easy_handle;
+			BatchRequest *req = nullptr;
+			curl_easy_getinfo(curl, CURLINFO_PRIVATE, reinterpret_cast<char**>(&req));
+			if (req) {
+				req->result = interpretCurlResult(curl,
+					msg->data.result, req->data, req->if_modified_since);
+			}
+
+			curl_multi_remove_handle(multi, curl);
+			curl_easy_cleanup(curl);
+			auto iter = std::find(handles.begin(), handles.end(), curl);
+			if (iter != handles.end()) {
+				*iter = nullptr;
+			}
+		}
+
+		if (still_running) {
+			// Wait for activity on any of the transfers.
+			curl_multi_wait(multi, nullptr, 0, 500, nullptr);
+		}
+	} while (still_running);
+
+	// Clean up any transfers that didn't complete.
+	// (Their requests keep the default error result.)
+	for (CURL *curl : handles) {
+		if (curl) {
+			curl_multi_remove_handle(multi, curl);
+			curl_easy_cleanup(curl);
+		}
+	}
+	curl_multi_cleanup(multi);
+
+	// Free the custom header lists.
+	// NOTE: Must be done after all handles are cleaned up.
+	for (void *headerList : headerLists) {
+		curl_slist_free_all(static_cast<struct curl_slist*>(headerList));
+	}
+	return 0;
+}
+
 } //namespace RpDownload
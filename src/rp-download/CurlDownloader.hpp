@@ -24,12 +24,24 @@ private:
 	RP_DISABLE_COPY(CurlDownloader)
 
 protected:
+	/**
+	 * Write context for a single cURL transfer.
+	 * Used as the userdata for write_data() and parse_header(),
+	 * so concurrent transfers can write to separate buffers.
+	 */
+	struct CurlWriteContext {
+		rp::uvector<uint8_t> *vec;	// Data buffer
+		time_t *pMtime;			// Last-Modified time
+		std::tstring *pEtag;		// ETag from the server
+		size_t maxSize;			// Maximum buffer size (0 == unlimited)
+	};
+
 	/**
 	 * Internal cURL data write function.
 	 * @param ptr Data to write.
 	 * @param size Element size.
 	 * @param nmemb Number of elements.
-	 * @param userdata m_data pointer.
+	 * @param userdata CurlWriteContext pointer.
 	 * @return Number of bytes written.
 	 */
 	static size_t write_data(char *ptr, size_t size, size_t nmemb, void *userdata);
@@ -39,17 +51,54 @@ protected:
 	 * @param ptr Pointer to header data. (NOT necessarily null-terminated!)
 	 * @param size Element size.
 	 * @param nitems Number of elements.
-	 * @param userdata m_data pointer.
+	 * @param userdata CurlWriteContext pointer.
 	 * @return Amount of data processed, or 0 on error.
 	 */
 	static size_t parse_header(char *ptr, size_t size, size_t nitems, void *userdata);
 
+	/**
+	 * Set up common options on a cURL easy handle.
+	 * NOTE: Handles are passed as void* to avoid pulling curl.h in here.
+	 * @param curl			[in] cURL easy handle.
+	 * @param url			[in] URL.
+	 * @param if_modified_since	[in] If-Modified-Since timestamp. (-1 for none)
+	 * @param if_none_match		[in,opt] If-None-Match ETag. (nullptr or empty for none)
+	 * @param ctx			[in] Write context.
+	 * @param pHeaderList		[out] Custom header list (curl_slist). Must be freed
+	 *				      with curl_slist_free_all() after the transfer.
+	 */
+	void setupEasyOptions(void *curl, const TCHAR *url, time_t if_modified_since,
+		const TCHAR *if_none_match, CurlWriteContext *ctx, void **pHeaderList);
+
+	/**
+	 * Interpret the result of a completed cURL transfer.
+	 * @param curl			[in] cURL easy handle.
+	 * @param res			[in] CURLcode from the transfer.
+	 * @param data			[in] Downloaded data.
+	 * @param if_modified_since	[in] If-Modified-Since timestamp. (-1 for none)
+	 * @return 0 on success; negative POSIX error code, positive HTTP status code on error.
+	 */
+	static int interpretCurlResult(void *curl, int res, const rp::uvector<uint8_t> &data, time_t if_modified_since);
+
 public:
 	/**
 	 * Download the file.
 	 * @return 0 on success; negative POSIX error code, positive HTTP status code on error.
 	 */
 	int download(void) final;
+
+	/**
+	 * Download multiple files in one batch.
+	 *
+	 * The transfers are run concurrently using curl_multi, with
+	 * connection reuse and HTTP/2 multiplexing where available.
+	 *
+	 * Per-file status is returned in each request's result field.
+	 *
+	 * @param requests Batch requests.
+	 * @return 0 on success; negative POSIX error code if the batch could not be run.
+	 */
+	int downloadBatch(std::vector<BatchRequest> &requests) final;
 };
 
 } //namespace RpDownload
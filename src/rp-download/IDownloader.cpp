@@ -138,6 +138,27 @@ void IDownloader::setIfModifiedSince(time_t timestamp)
 	m_if_modified_since = timestamp;
 }
 
+/**
+ * Get the If-None-Match request ETag.
+ * @return If-None-Match ETag (empty for none)
+ */
+tstring IDownloader::ifNoneMatch(void) const
+{
+	return m_if_none_match;
+}
+
+/**
+ * Set the If-None-Match request ETag.
+ * If set, a 304 response indicates the cached copy is still valid.
+ * @param etag If-None-Match ETag (empty for none)
+ */
+void IDownloader::setIfNoneMatch(const tstring &etag)
+{
+	assert(!m_inProgress);
+	// TODO: Don't set if m_inProgress?
+	m_if_none_match = etag;
+}
+
 /** Data accessors **/
 
 /**
@@ -167,6 +188,15 @@ time_t IDownloader::mtime(void) const
 	return m_mtime;
 }
 
+/**
+ * Get the ETag from the server.
+ * @return ETag, or empty string if none was set by the server.
+ */
+tstring IDownloader::etag(void) const
+{
+	return m_etag;
+}
+
 /**
  * Clear the data.
  */
@@ -177,6 +207,43 @@ void IDownloader::clear(void)
 	m_data.clear();
 }
 
+/**
+ * Download multiple files in one batch.
+ *
+ * The default implementation downloads each file sequentially.
+ * Subclasses may override this to run the transfers concurrently,
+ * e.g. with connection reuse and HTTP/2 multiplexing.
+ *
+ * Per-file status is returned in each request's result field.
+ *
+ * @param requests Batch requests.
+ * @return 0 on success; negative POSIX error code if the batch could not be run.
+ */
+int IDownloader::downloadBatch(std::vector<BatchRequest> &requests)
+{
+	// Save the single-download state.
+	const tstring orig_url = m_url;
+	const time_t orig_if_modified_since = m_if_modified_since;
+	const tstring orig_if_none_match = m_if_none_match;
+
+	for (BatchRequest &req : requests) {
+		setUrl(req.url);
+		setIfModifiedSince(req.if_modified_since);
+		setIfNoneMatch(req.if_none_match);
+		req.result = download();
+		req.mtime = m_mtime;
+		req.etag = m_etag;
+		req.data = std::move(m_data);
+		m_data.clear();
+	}
+
+	// Restore the single-download state.
+	m_url = orig_url;
+	m_if_modified_since = orig_if_modified_since;
+	m_if_none_match = orig_if_none_match;
+	return 0;
+}
+
 #ifdef __linux__
 struct inih_ctx {
 	const char *field_name;
@@ -18,6 +18,9 @@
 #include <cstddef>
 #include <ctime>
 
+// C++ includes.
+#include <vector>
+
 // Uninitialized vector class
 #include "uvector.h"
 
@@ -88,6 +91,19 @@ public:
 	 */
 	void setIfModifiedSince(time_t timestamp);
 
+	/**
+	 * Get the If-None-Match request ETag.
+	 * @return If-None-Match ETag (empty for none)
+	 */
+	std::tstring ifNoneMatch(void) const;
+
+	/**
+	 * Set the If-None-Match request ETag.
+	 * If set, a 304 response indicates the cached copy is still valid.
+	 * @param etag If-None-Match ETag (empty for none)
+	 */
+	void setIfNoneMatch(const std::tstring &etag);
+
 public:
 	/** Data accessors **/
 
@@ -109,6 +125,12 @@ public:
 	 */
 	time_t mtime(void) const;
 
+	/**
+	 * Get the ETag from the server.
+	 * @return ETag, or empty string if none was set by the server.
+	 */
+	std::tstring etag(void) const;
+
 	/**
 	 * Clear the data.
 	 */
@@ -121,6 +143,39 @@ public:
 	 */
 	virtual int download(void) = 0;
 
+public:
+	/**
+	 * Batch download request.
+	 * The URL and If-Modified-Since timestamp are inputs;
+	 * the other fields are filled in by downloadBatch().
+	 */
+	struct BatchRequest {
+		std::tstring url;		// [in] URL
+		time_t if_modified_since = -1;	// [in] If-Modified-Since timestamp (-1 for none)
+		std::tstring if_none_match;	// [in] If-None-Match ETag (empty for none)
+
+		rp::uvector<uint8_t> data;	// [out] Downloaded data
+		time_t mtime = -1;		// [out] Last-Modified time (-1 if none)
+		std::tstring etag;		// [out] ETag (empty if none)
+		// [out] 0 on success; negative POSIX error code,
+		// positive HTTP status code on error.
+		int result = -EIO;
+	};
+
+	/**
+	 * Download multiple files in one batch.
+	 *
+	 * The default implementation downloads each file sequentially.
+	 * Subclasses may override this to run the transfers concurrently,
+	 * e.g. with connection reuse and HTTP/2 multiplexing.
+	 *
+	 * Per-file status is returned in each request's result field.
+	 *
+	 * @param requests Batch requests.
+	 * @return 0 on success; negative POSIX error code if the batch could not be run.
+	 */
+	virtual int downloadBatch(std::vector<BatchRequest> &requests);
+
 private:
 	/**
 	 * Create the User-Agent value.
@@ -141,7 +196,9 @@ protected:
 	rp::uvector<uint8_t> m_data;
 
 	time_t m_mtime;			// Last-Modified response
+	std::tstring m_etag;		// ETag response
 	time_t m_if_modified_since;	// If-Modified-Since request
+	std::tstring m_if_none_match;	// If-None-Match request
 
 	size_t m_maxSize;		// Maximum buffer size. (0 == unlimited)
 	std::tstring m_userAgent;	// User-Agent
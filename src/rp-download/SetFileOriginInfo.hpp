@@ -14,6 +14,9 @@
 #include <cstdio>
 #include <ctime>
 
+// C++ includes.
+#include <string>
+
 // tcharx
 #include "tcharx.h"
 
@@ -25,10 +28,11 @@ namespace RpDownload {
  * This uses xattrs on Linux and ADS on Windows.
  * @param file Open file. (Must be writable.)
  * @param url Origin URL.
+ * @param etag HTTP ETag from the server. (nullptr or empty for none)
  * @param mtime If >= 0, this value is set as the mtime.
  * @return 0 on success; negative POSIX error code on error.
  */
-int setFileOriginInfo(FILE *file, const TCHAR *url, time_t mtime);
+int setFileOriginInfo(FILE *file, const TCHAR *url, const TCHAR *etag, time_t mtime);
 #endif /* !_WIN32 */
 
 #ifdef _WIN32
@@ -38,10 +42,19 @@ int setFileOriginInfo(FILE *file, const TCHAR *url, time_t mtime);
  * @param file Open file. (Must be writable.)
  * @param filename Filename. [FIXME: Make it so we don't need this on Windows.]
  * @param url Origin URL.
+ * @param etag HTTP ETag from the server. (nullptr or empty for none)
  * @param mtime If >= 0, this value is set as the mtime.
  * @return 0 on success; negative POSIX error code on error.
  */
-int setFileOriginInfo(FILE *file, const TCHAR *filename, const TCHAR *url, time_t mtime);
+int setFileOriginInfo(FILE *file, const TCHAR *filename, const TCHAR *url, const TCHAR *etag, time_t mtime);
 #endif /* _WIN32 */
 
+/**
+ * Get the stored HTTP ETag for a previously-downloaded file.
+ * Used for If-None-Match revalidation requests.
+ * @param filename Filename.
+ * @return ETag, or empty string if none was stored.
+ */
+std::tstring getFileEtag(const TCHAR *filename);
+
 } //namespace RpDownload
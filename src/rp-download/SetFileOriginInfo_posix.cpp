@@ -100,15 +100,19 @@ static bool getStoreFileOriginInfo(void)
 	return bValue;
 }
 
+// xattr name for the stored HTTP ETag.
+static const char ETAG_XATTR_NAME[] = "user.rp.etag";
+
 /**
  * Set the file origin info.
  * This uses xattrs on Linux and ADS on Windows.
  * @param file Open file. (Must be writable.)
  * @param url Origin URL.
+ * @param etag HTTP ETag from the server. (nullptr or empty for none)
  * @param mtime If >= 0, this value is set as the mtime.
  * @return 0 on success; negative POSIX error code on error.
  */
-int setFileOriginInfo(FILE *file, const TCHAR *url, time_t mtime)
+int setFileOriginInfo(FILE *file, const TCHAR *url, const TCHAR *etag, time_t mtime)
 {
 	const int fd = fileno(file);
 
@@ -175,6 +179,31 @@ int setFileOriginInfo(FILE *file, const TCHAR *url, time_t mtime)
 #endif /* HAVE_FSETXATTR_LINUX */
 	}
 
+	// Store the ETag for If-None-Match revalidation.
+	// NOTE: Not gated on storeFileOriginInfo, since this is cache
+	// metadata needed for revalidation, not provenance info.
+	if (etag && etag[0] != '\0') {
+#if defined(HAVE_FSETXATTR_LINUX)
+		errno = 0;
+		int sxret = fsetxattr(fd, ETAG_XATTR_NAME, etag, _tcslen(etag), 0);
+		if (sxret != 0 && err == 0) {
+			err = errno;
+			if (err == 0) {
+				err = EIO;
+			}
+		}
+#elif defined(HAVE_EXTATTR_SET_FD)
+		errno = 0;
+		ssize_t sxret = extattr_set_fd(fd, EXTATTR_NAMESPACE_USER, ETAG_XATTR_NAME, etag, _tcslen(etag));
+		if (sxret != 0 && err == 0) {
+			err = errno;
+			if (err == 0) {
+				err = EIO;
+			}
+		}
+#endif /* HAVE_FSETXATTR_LINUX */
+	}
+
 	// Set the mtime if >= 0.
 	if (mtime >= 0) {
 		struct timeval tv[2];
@@ -212,4 +241,30 @@ int setFileOriginInfo(FILE *file, const TCHAR *url, time_t mtime)
 	return -err;
 }
 
+/**
+ * Get the stored HTTP ETag for a previously-downloaded file.
+ * Used for If-None-Match revalidation requests.
+ * @param filename Filename.
+ * @return ETag, or empty string if none was stored.
+ */
+std::tstring getFileEtag(const TCHAR *filename)
+{
+	char buf[256];
+	ssize_t len = -1;
+
+#if defined(HAVE_FSETXATTR_LINUX)
+	len = getxattr(filename, ETAG_XATTR_NAME, buf, sizeof(buf));
+#elif defined(HAVE_EXTATTR_SET_FD)
+	len = extattr_get_file(filename, EXTATTR_NAMESPACE_USER, ETAG_XATTR_NAME, buf, sizeof(buf));
+#else
+	RP_UNUSED(filename);
+#endif /* HAVE_FSETXATTR_LINUX */
+
+	if (len <= 0 || static_cast<size_t>(len) > sizeof(buf)) {
+		// No ETag stored, or it's too big.
+		return {};
+	}
+	return std::tstring(buf, len);
+}
+
 } //namespace RpDownload
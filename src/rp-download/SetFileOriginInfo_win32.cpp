@@ -72,16 +72,20 @@ static bool getStoreFileOriginInfo(void)
 	return true;
 }
 
+// ADS name for the stored HTTP ETag.
+static const TCHAR ETAG_ADS_NAME[] = _T(":rp.etag");
+
 /**
  * Set the file origin info.
  * This uses xattrs on Linux and ADS on Windows.
  * @param file Open file. (Must be writable.)
  * @param filename Filename. [FIXME: Make it so we don't need this on Windows.]
  * @param url Origin URL.
+ * @param etag HTTP ETag from the server. (nullptr or empty for none)
  * @param mtime If >= 0, this value is set as the mtime.
  * @return 0 on success; negative POSIX error code on error.
  */
-int setFileOriginInfo(FILE *file, const TCHAR *filename, const TCHAR *url, time_t mtime)
+int setFileOriginInfo(FILE *file, const TCHAR *filename, const TCHAR *url, const TCHAR *etag, time_t mtime)
 {
 	// NOTE: Even if one of the xattr functions fails, we'll
 	// continue with others and setting mtime. The first error
@@ -149,6 +153,47 @@ int setFileOriginInfo(FILE *file, const TCHAR *filename, const TCHAR *url, time_
 		CloseHandle(hAds);
 	} while (0);
 
+	// Store the ETag for If-None-Match revalidation.
+	// NOTE: Not gated on storeFileOriginInfo, since this is cache
+	// metadata needed for revalidation, not provenance info.
+	if (etag && etag[0] != _T('\0')) do {
+		tstring tfilename = filename;
+		tfilename += ETAG_ADS_NAME;
+		HANDLE hAds = CreateFile(
+			tfilename.c_str(),	// lpFileName
+			GENERIC_WRITE,		// dwDesiredAccess
+			FILE_SHARE_READ,	// dwShareMode
+			nullptr,		// lpSecurityAttributes
+			CREATE_ALWAYS,		// dwCreationDisposition
+			FILE_ATTRIBUTE_NORMAL,	// dwFlagsAndAttributes
+			nullptr);		// hTemplateFile
+		if (!hAds || hAds == INVALID_HANDLE_VALUE) {
+			// Error opening the ADS.
+			if (err == 0) {
+				err = w32err_to_posix(GetLastError());
+				if (err == 0) {
+					err = EIO;
+				}
+			}
+			break;
+		}
+
+		// NOTE: Stored as UTF-8.
+		const string s_etag = T2U8(etag);
+		DWORD dwBytesWritten = 0;
+		BOOL bRet = WriteFile(hAds, s_etag.data(), static_cast<DWORD>(s_etag.size()),
+			&dwBytesWritten, nullptr);
+		if ((!bRet || dwBytesWritten != static_cast<DWORD>(s_etag.size())) && err == 0) {
+			// Some error occurred...
+			err = w32err_to_posix(GetLastError());
+			if (err == 0) {
+				err = EIO;
+			}
+		}
+
+		CloseHandle(hAds);
+	} while (0);
+
 	if (mtime >= 0) {
 		// TODO: 100ns timestamp precision for access time?
 		struct _utimbuf utimbuf;
@@ -172,4 +217,40 @@ int setFileOriginInfo(FILE *file, const TCHAR *filename, const TCHAR *url, time_
 	return -err;
 }
 
+/**
+ * Get the stored HTTP ETag for a previously-downloaded file.
+ * Used for If-None-Match revalidation requests.
+ * @param filename Filename.
+ * @return ETag, or empty string if none was stored.
+ */
+std::tstring getFileEtag(const TCHAR *filename)
+{
+	tstring tfilename = filename;
+	tfilename += ETAG_ADS_NAME;
+	HANDLE hAds = CreateFile(
+		tfilename.c_str(),	// lpFileName
+		GENERIC_READ,		// dwDesiredAccess
+		FILE_SHARE_READ,	// dwShareMode
+		nullptr,		// lpSecurityAttributes
+		OPEN_EXISTING,		// dwCreationDisposition
+		FILE_ATTRIBUTE_NORMAL,	// dwFlagsAndAttributes
+		nullptr);		// hTemplateFile
+	if (!hAds || hAds == INVALID_HANDLE_VALUE) {
+		// No ETag ADS is present.
+		return {};
+	}
+
+	// NOTE: Stored as UTF-8.
+	char buf[256];
+	DWORD dwBytesRead = 0;
+	BOOL bRet = ReadFile(hAds, buf, sizeof(buf), &dwBytesRead, nullptr);
+	CloseHandle(hAds);
+	if (!bRet || dwBytesRead == 0 || dwBytesRead >= sizeof(buf)) {
+		// No ETag stored, or it's too big.
+		return {};
+	}
+
+	return U82T_s(string(buf, dwBytesRead));
+}
+
 } //namespace RpDownload
@@ -50,6 +50,7 @@ int WinInetDownloader::download(void)
 	// Clear the previous download.
 	m_data.clear();
 	m_mtime = -1;
+	m_etag.clear();
 
 	// Open up an Internet connection.
 	// This doesn't actually connect to anything yet.
@@ -95,6 +96,14 @@ int WinInetDownloader::download(void)
 			headers += szTime;
 		}
 	}
+	if (!m_if_none_match.empty()) {
+		// Add an "If-None-Match" header for ETag revalidation.
+		if (!headers.empty()) {
+			headers += _T("\r\n");
+		}
+		headers += _T("If-None-Match: ");
+		headers += m_if_none_match;
+	}
 
 	// Request the URL.
 	HINTERNET hURL = InternetOpenUrl(
@@ -138,6 +147,19 @@ int WinInetDownloader::download(void)
 		}
 	}
 
+	// Get the ETag if it's available.
+	TCHAR szEtag[256];
+	dwBufferLength = static_cast<DWORD>(sizeof(szEtag));
+	if (HttpQueryInfo(hURL,			// hRequest
+		HTTP_QUERY_ETAG,		// dwInfoLevel
+		szEtag,				// lpBuffer
+		&dwBufferLength,		// lpdwBufferLength
+		0))				// lpdwIndex
+	{
+		// Received the ETag.
+		m_etag.assign(szEtag, dwBufferLength / sizeof(TCHAR));
+	}
+
 	// Get mtime if it's available.
 	SYSTEMTIME st_mtime;
 	dwBufferLength = static_cast<DWORD>(sizeof(st_mtime));
@@ -37,9 +37,11 @@
 
 // C++ includes.
 #include <memory>
+#include <vector>
 using std::string;
 using std::tstring;
 using std::unique_ptr;
+using std::vector;
 
 #ifdef _WIN32
 // libwin32common
@@ -83,7 +85,8 @@ static bool verbose = false;
  */
 static void show_usage(void)
 {
-	_ftprintf(stderr, _T("Syntax: %s [-v] [-f] cache_key\n"), argv0);
+	_ftprintf(stderr, _T("Syntax: %s [-v] [-f] cache_key [cache_key...]\n"), argv0);
+	_ftprintf(stderr, _T("        %s -d (daemon mode: process cache keys from stdin)\n"), argv0);
 }
 
 /**
@@ -290,192 +293,26 @@ static int rmkdir(const tstring &path, int mode)
 	return 0;
 }
 
+// Per-key download task.
+struct KeyTask {
+	const TCHAR *cache_key = nullptr;
+	tstring cache_filename;
+	tstring full_url;
+	bool check_newer = false;	// for [sys]: always check, but only download if newer
+	time_t filemtime = -1;		// existing cache file mtime (for If-Modified-Since)
+	tstring etag;			// existing cache file ETag (for If-None-Match)
+};
+
 /**
- * rp-download: Download an image from a supported online database.
- * @param cache_key Cache key, e.g. "ds/cover/US/ADAE.png"
- * @return 0 on success; non-zero on error.
- *
- * TODO:
- * - More error codes based on the error.
+ * Validate a cache key, determine its URL, and check the cached file.
+ * @param cache_key	[in] Cache key.
+ * @param force		[in] If true, download even if the cache file exists.
+ * @param task		[out] Download task.
+ * @return 0 if the file should be downloaded; 1 if the cached copy is up to date; negative POSIX error code on error.
  */
-int RP_C_API _tmain(int argc, TCHAR *argv[])
+static int prepare_cache_key(const TCHAR *cache_key, bool force, KeyTask &task)
 {
-	// Create a downloader based on OS:
-	// - Linux: CurlDownloader
-	// - Windows: WinInetDownloader
-
-	// Syntax: rp-download cache_key
-	// Example: rp-download ds/coverM/US/ADAE.png
-
-	// If http_proxy or https_proxy are set, they will be used
-	// by the downloader code if supported.
-
-	// Restrict DLL lookups.
-	rp_secure_restrict_dll_lookups();
-	// Reduce process integrity, if available.
-	rp_secure_reduce_integrity();
-
-	// Set OS-specific security options.
-	rp_secure_param_t param;
-#if defined(_WIN32)
-	param.bHighSec = FALSE;
-#elif defined(HAVE_SECCOMP)
-	static constexpr int syscall_wl[] = {
-		// Syscalls used by rp-download.
-		// TODO: Add more syscalls.
-		// FIXME: glibc-2.31 uses 64-bit time syscalls that may not be
-		// defined in earlier versions, including Ubuntu 14.04.
-		SCMP_SYS(clock_gettime),
-#if defined(__SNR_clock_gettime64) || defined(__NR_clock_gettime64)
-		SCMP_SYS(clock_gettime64),
-#endif /* __SNR_clock_gettime64 || __NR_clock_gettime64 */
-		SCMP_SYS(close),
-		SCMP_SYS(fcntl),     SCMP_SYS(fcntl64),		// gcc profiling
-		SCMP_SYS(fsetxattr),
-		SCMP_SYS(fstat),     SCMP_SYS(fstat64),		// __GI___fxstat() [printf()]
-		SCMP_SYS(fstatat64), SCMP_SYS(newfstatat),	// Ubuntu 19.10 (32-bit)
-		SCMP_SYS(futex),
-		SCMP_SYS(getdents), SCMP_SYS(getdents64),
-		SCMP_SYS(getppid),	// for bubblewrap verification
-		SCMP_SYS(getrusage),
-		SCMP_SYS(gettimeofday),	// 32-bit only?
-		SCMP_SYS(getuid),	// TODO: Only use geteuid()?
-		SCMP_SYS(lseek), SCMP_SYS(_llseek),
-		//SCMP_SYS(lstat), SCMP_SYS(lstat64),	// Not sure if used?
-		SCMP_SYS(mkdir), SCMP_SYS(mmap), SCMP_SYS(mmap2),
-		SCMP_SYS(munmap),
-		SCMP_SYS(open),		// Ubuntu 16.04
-		SCMP_SYS(openat),	// glibc-2.31
-#if defined(__SNR_openat2)
-		SCMP_SYS(openat2),	// Linux 5.6
-#elif defined(__NR_openat2)
-		__NR_openat2,		// Linux 5.6
-#endif /* __SNR_openat2 || __NR_openat2 */
-		SCMP_SYS(poll), SCMP_SYS(select),
-		SCMP_SYS(stat), SCMP_SYS(stat64),
-		SCMP_SYS(unlink),	// to delete expired cache files
-		SCMP_SYS(utimensat),
-
-#if defined(__SNR_statx) || defined(__NR_statx)
-		SCMP_SYS(getcwd),	// called by glibc's statx()
-		SCMP_SYS(statx),
-#endif /* __SNR_statx || __NR_statx */
-
-		// glibc ncsd
-		// TODO: Restrict connect() to AF_UNIX.
-		SCMP_SYS(connect), SCMP_SYS(recvmsg), SCMP_SYS(sendto),
-		SCMP_SYS(sendmmsg),	// getaddrinfo() (32-bit only?)
-		SCMP_SYS(ioctl),	// getaddrinfo() (32-bit only?) [FIXME: Filter for FIONREAD]
-		SCMP_SYS(recvfrom),	// getaddrinfo() (32-bit only?)
-
-		// Needed for network access on Kubuntu 20.04 for some reason.
-		SCMP_SYS(getpid), SCMP_SYS(uname),
-
-		// cURL and OpenSSL
-		SCMP_SYS(bind),		// getaddrinfo() [curl_thread_create_thunk(), curl-7.68.0]
-#ifdef __SNR_getrandom
-		SCMP_SYS(getrandom),
-#endif /* __SNR_getrandom */
-		SCMP_SYS(getpeername), SCMP_SYS(getsockname),
-		SCMP_SYS(getsockopt), SCMP_SYS(madvise), SCMP_SYS(mprotect),
-		SCMP_SYS(setsockopt), SCMP_SYS(socket),
-		SCMP_SYS(socketcall),	// FIXME: Enhanced filtering? [cURL+GnuTLS only?]
-		SCMP_SYS(socketpair), SCMP_SYS(sysinfo),
-		SCMP_SYS(rt_sigprocmask),	// Ubuntu 20.04: __GI_getaddrinfo() ->
-						// gaih_inet() ->
-						// _nss_myhostname_gethostbyname4_r()
-
-		// libnss_resolve.so (systemd-resolved)
-		SCMP_SYS(geteuid),
-		SCMP_SYS(sendmsg),	// libpthread.so [_nss_resolve_gethostbyname4_r() from libnss_resolve.so]
-
-		// FIXME: Manjaro is using these syscalls for some reason...
-		SCMP_SYS(prctl), SCMP_SYS(mremap), SCMP_SYS(ppoll),
-
-		// cURL's "easy" functions use multi internally, which uses pipe().
-		// Some update, either cURL 8.4.0 -> 8.5.0 or glibc 2.38 -> 2.39,
-		// is now using the pipe2() syscall.
-		SCMP_SYS(pipe2),
-
-		// Needed on 32-bit Ubuntu 16.04 (glibc-2.23, cURL 7.47.0) for some reason...
-		// (called from getaddrinfo())
-		SCMP_SYS(time),
-
-		-1	// End of whitelist
-	};
-	param.syscall_wl = syscall_wl;
-	param.threading = true;		// libcurl uses multi-threading.
-#elif defined(HAVE_PLEDGE)
-	// Promises:
-	// - stdio: General stdio functionality.
-	// - rpath: Read from ~/.config/rom-properties/ and ~/.cache/rom-properties/
-	// - wpath: Write to ~/.cache/rom-properties/
-	// - cpath: Create ~/.cache/rom-properties/ if it doesn't exist.
-	// - inet: Internet access.
-	// - fattr: Modify file attributes, e.g. mtime.
-	// - dns: Resolve hostnames.
-	// - getpw: Get user's home directory if HOME is empty.
-	param.promises = "stdio rpath wpath cpath inet fattr dns getpw";
-#elif defined(HAVE_TAME)
-	// NOTE: stdio includes fattr, e.g. utimes().
-	param.tame_flags = TAME_STDIO | TAME_RPATH | TAME_WPATH | TAME_CPATH |
-	                   TAME_INET | TAME_DNS | TAME_GETPW;
-#else
-	param.dummy = 0;
-#endif
-	rp_secure_enable(param);
-
-#ifdef __GLIBC__
-	// Reduce /etc/localtime stat() calls.
-	// References:
-	// - https://lwn.net/Articles/944499/
-	// - https://gitlab.com/procps-ng/procps/-/merge_requests/119
-	setenv("TZ", ":/etc/localtime", 0);
-#endif /* __GLIBC__ */
-
-	// Store argv[0] globally.
-	argv0 = argv[0];
-
-	if (argc < 2) {
-		show_usage();
-		return EXIT_FAILURE;
-	}
-
-	// Check for arguments. (simple non-getopt version)
-	bool force = false;
-	int optind = 1;
-	for (; optind < argc; optind++) {
-		if (!argv[optind] || argv[optind][0] != '-') {
-			// End of options.
-			break;
-		}
-
-		// Allow multiple options in one argument, e.g. '-vf'.
-		for (int i = 1; argv[optind][i] != '\0'; i++) {
-			switch (argv[optind][i]) {
-				case 'v':
-					// Verbose mode is enabled.
-					verbose = true;
-					break;
-				case 'f':
-					// Force download is enabled.
-					force = true;
-					break;
-				default:
-					// Invalid parameter.
-					show_error(_T("Unrecognized option: %c"), argv[optind][i]);
-					show_usage();
-					return EXIT_FAILURE;
-			}
-		}
-	}
-
-	if (optind >= argc) {
-		show_error(_T("No cache key specified."));
-		show_usage();
-		return EXIT_FAILURE;
-	}
-	const TCHAR *const cache_key = argv[optind];
+	task.cache_key = cache_key;
 
 	// Check the cache key prefix. The prefix indicates the system
 	// and identifies the online database used.
@@ -507,14 +344,14 @@ int RP_C_API _tmain(int argc, TCHAR *argv[])
 		// - Does not contain any slashes.
 		// - First slash is either the first or the last character.
 		SHOW_ERROR(_T("Cache key '%s' is invalid."), cache_key);
-		return EXIT_FAILURE;
+		return -EINVAL;
 	}
 
 	const ptrdiff_t prefix_len = (slash_pos - cache_key);
 	if (prefix_len <= 0) {
 		// Empty prefix.
 		SHOW_ERROR(_T("Cache key '%s' is invalid."), cache_key);
-		return EXIT_FAILURE;
+		return -EINVAL;
 	}
 
 	// Cache key must include a lowercase file extension.
@@ -522,7 +359,7 @@ int RP_C_API _tmain(int argc, TCHAR *argv[])
 	if (!lastdot) {
 		// No dot...
 		SHOW_ERROR(_T("Cache key '%s' is invalid."), cache_key);
-		return EXIT_FAILURE;
+		return -EINVAL;
 	}
 	if ((!_tcscmp(lastdot, _T(".png"))) != 0 ||
 	    (!_tcscmp(lastdot, _T(".jpg"))) != 0)
@@ -534,12 +371,12 @@ int RP_C_API _tmain(int argc, TCHAR *argv[])
 		// .txt is supported for sys/ only.
 		if (_tcsncmp(cache_key, _T("sys/"), 4) != 0) {
 			SHOW_ERROR(_T("Cache key '%s' is invalid."), cache_key);
-			return EXIT_FAILURE;
+			return -EINVAL;
 		}
 	} else {
 		// Not a supported file extension.
 		SHOW_ERROR(_T("Cache key '%s' is invalid."), cache_key);
-		return EXIT_FAILURE;
+		return -EINVAL;
 	}
 
 	// urlencode the cache key.
@@ -550,12 +387,11 @@ int RP_C_API _tmain(int argc, TCHAR *argv[])
 	if (!slash_pos) {
 		// Shouldn't happen, since a slash was found earlier...
 		SHOW_ERROR(_T("Cache key '%s' is invalid."), cache_key);
-		return EXIT_FAILURE;
+		return -EINVAL;
 	}
 
 	// Determine the full URL based on the cache key.
 	bool ok = false;
-	bool check_newer = false;	// for [sys]: always check, but only download if newer
 	TCHAR full_url[256];
 	if ((prefix_len == 3 && (!_tcsncmp(cache_key, _T("wii"), 3) || !_tcsncmp(cache_key, _T("3ds"), 3))) ||
 	    (prefix_len == 4 && !_tcsncmp(cache_key, _T("wiiu"), 4)) ||
@@ -572,7 +408,7 @@ int RP_C_API _tmain(int argc, TCHAR *argv[])
 		if (filename_len <= 4) {
 			// Can't remove the extension...
 			SHOW_ERROR(_T("Cache key '%s' is invalid."), cache_key);
-			return EXIT_FAILURE;
+			return -EINVAL;
 		}
 		filename_len -= 4;
 
@@ -606,7 +442,7 @@ int RP_C_API _tmain(int argc, TCHAR *argv[])
 				else if (!_tcsncmp(cache_key, _T("sys"), 3))
 				{
 					ok = true;
-					check_newer = true;
+					task.check_newer = true;
 				}
 				break;
 			case 4:
@@ -643,28 +479,20 @@ int RP_C_API _tmain(int argc, TCHAR *argv[])
 	if (!ok) {
 		// Prefix is not supported.
 		SHOW_ERROR(_T("Cache key '%s' has an unsupported prefix."), cache_key);
-		return EXIT_FAILURE;
+		return -EINVAL;
 	}
+	task.full_url = full_url;
 
 	if (verbose) {
 		_ftprintf(stderr, _T("URL: %s\n"), full_url);
 	}
 
-	// Make sure we have a valid cache directory.
-	const string &cache_dir = LibCacheCommon::getCacheDirectory();
-	if (cache_dir.empty()) {
-		// Cache directory is invalid...
-		// This may happen if bubblewrap is in use.
-		SHOW_ERROR(_T("Unable to access cache directory. Check the sandbox environment!"));
-		return EXIT_FAILURE;
-	}
-
 	// Get the cache filename.
 	tstring cache_filename = LibCacheCommon::getCacheFilename(cache_key);
 	if (cache_filename.empty()) {
 		// Invalid cache filename.
 		SHOW_ERROR(_T("Cache key '%s' is invalid."), cache_key);
-		return EXIT_FAILURE;
+		return -EINVAL;
 	}
 	if (verbose) {
 		_ftprintf(stderr, _T("Cache Filename: %s\n"), cache_filename.c_str());
@@ -675,15 +503,18 @@ int RP_C_API _tmain(int argc, TCHAR *argv[])
 		cache_filename.reserve(cache_filename.size() + 8);
 		cache_filename.insert(0, _T("\\\\?\\"));
 	}
+	task.cache_filename = std::move(cache_filename);
 
 	// Get the cache file information.
 	off64_t filesize = 0;
 	time_t filemtime = -1;
-	int ret = get_file_size_and_mtime(cache_filename.c_str(), &filesize, &filemtime);
+	int ret = get_file_size_and_mtime(task.cache_filename.c_str(), &filesize, &filemtime);
 	if (ret == 0) {
+		task.filemtime = filemtime;
+
 		// Check if the file is 0 bytes.
 		// TODO: How should we handle errors?
-		if (filesize == 0 && !check_newer) {
+		if (filesize == 0 && !task.check_newer) {
 			// File is 0 bytes, which indicates it didn't exist on the server.
 			// If the file is older than a week, try to redownload it.
 			// NOTE: Not used for "check_newer" files, e.g. "sys/".
@@ -693,7 +524,7 @@ int RP_C_API _tmain(int argc, TCHAR *argv[])
 				// Less than a week old.
 				if (likely(!force)) {
 					SHOW_INFO(_T("Negative cache file for '%s' has not expired; not redownloading."), cache_key);
-					return EXIT_FAILURE;
+					return -EEXIST;
 				} else {
 					SHOW_INFO(_T("Negative cache file for '%s' has not expired, but -f was specified. Redownloading anyway."), cache_key);
 				}
@@ -701,59 +532,60 @@ int RP_C_API _tmain(int argc, TCHAR *argv[])
 
 			// More than a week old.
 			// Delete the cache file and try to download it again.
-			if (_tremove(cache_filename.c_str()) != 0) {
+			if (_tremove(task.cache_filename.c_str()) != 0) {
 				SHOW_ERROR(_T("Error deleting negative cache file for '%s': %s"), cache_key, _tcserror(errno));
-				return EXIT_FAILURE;
+				return -EIO;
 			}
 		} else if (filesize > 0) {
 			// File is larger than 0 bytes, which indicates
 			// it was previously cached successfully
-			if (unlikely(check_newer)) {
+			if (unlikely(task.check_newer)) {
 				SHOW_INFO(_T("Cache file for '%s' is already downloaded, but this cache key is set to download-if-newer."), cache_key);
+				// Get the stored ETag for If-None-Match revalidation.
+				task.etag = getFileEtag(task.cache_filename.c_str());
 			} else if (unlikely(force)) {
 				SHOW_INFO(_T("Cache file for '%s' is already downloaded, but -f was specified. Redownloading anyway."), cache_key);
-				if (_tremove(cache_filename.c_str()) != 0) {
+				if (_tremove(task.cache_filename.c_str()) != 0) {
 					SHOW_ERROR(_T("Error deleting cache file for '%s': %s"), cache_key, _tcserror(errno));
-					return EXIT_FAILURE;
+					return -EIO;
 				}
 			} else {
 				SHOW_INFO(_T("Cache file for '%s' is already downloaded."), cache_key);
-				return EXIT_SUCCESS;
+				return 1;
 			}
 		}
 	} else if (ret == -ENOENT) {
 		// File not found. We'll need to download it.
 		// Make sure the path structure exists.
-		int ret = rmkdir(cache_filename, 0700);
+		ret = rmkdir(task.cache_filename, 0700);
 		if (ret != 0) {
 			SHOW_ERROR(_T("Error creating directory structure: %s"), _tcserror(-ret));
-			return EXIT_FAILURE;
+			return ret;
 		}
 	} else {
 		// Other error.
 		SHOW_ERROR(_T("Error checking cache file for '%s': %s"), cache_key, _tcserror(-ret));
-		return EXIT_FAILURE;
+		return ret;
 	}
 
-	// Attempt to download the file.
-	// TODO: IDownloaderFactory?
-#ifdef _WIN32
-	unique_ptr<IDownloader> m_downloader(new WinInetDownloader());
-#else /* !_WIN32 */
-	unique_ptr<IDownloader> m_downloader(new CurlDownloader());
-#endif /* _WIN32 */
-
-	// TODO: Configure this somewhere?
-	m_downloader->setMaxSize(4*1024*1024);
+	// The file should be downloaded.
+	return 0;
+}
 
-	if (check_newer && filemtime >= 0) {
-		// Only download if the file on the server is newer than
-		// what's in our cache directory.
-		m_downloader->setIfModifiedSince(filemtime);
-	}
+/**
+ * Process a completed download for a cache key.
+ * Writes the downloaded data to the cache file, or a 0-byte
+ * negative cache file if the download failed.
+ * @param task	[in] Download task.
+ * @param req	[in] Completed batch request.
+ * @return EXIT_SUCCESS on success; EXIT_FAILURE on error.
+ */
+static int save_cache_file(const KeyTask &task, const IDownloader::BatchRequest &req)
+{
+	const TCHAR *const cache_key = task.cache_key;
+	const tstring &cache_filename = task.cache_filename;
 
-	m_downloader->setUrl(full_url);
-	ret = m_downloader->download();
+	const int ret = req.result;
 	if (ret != 0) {
 		// Error downloading the file.
 		if (ret < 0) {
@@ -764,7 +596,7 @@ int RP_C_API _tmain(int argc, TCHAR *argv[])
 			if (f_out) {
 				fclose(f_out);
 			}
-		} else if (ret == 304 && check_newer) {
+		} else if (ret == 304 && task.check_newer) {
 			// HTTP 304 Not Modified
 			SHOW_ERROR(_T("File has not been modified on the server. Not redownloading."));
 			return EXIT_SUCCESS;
@@ -787,7 +619,7 @@ int RP_C_API _tmain(int argc, TCHAR *argv[])
 		return EXIT_FAILURE;
 	}
 
-	if (m_downloader->dataSize() <= 0) {
+	if (req.data.empty()) {
 		// No data downloaded...
 		SHOW_ERROR(_T("Error downloading file: 0 bytes received"));
 		return EXIT_FAILURE;
@@ -802,16 +634,16 @@ int RP_C_API _tmain(int argc, TCHAR *argv[])
 
 	// Write the file to the cache.
 	// TODO: Verify the size.
-	const size_t dataSize = m_downloader->dataSize();
-	size_t size = fwrite(m_downloader->data(), 1, dataSize, f_out);
+	const size_t dataSize = req.data.size();
+	size_t size = fwrite(req.data.data(), 1, dataSize, f_out);
 	fflush(f_out);
 
 	// Save the file origin information.
 #ifdef _WIN32
 	// TODO: Figure out how to setFileOriginInfo() on Windows using an open file handle.
-	setFileOriginInfo(f_out, cache_filename.c_str(), full_url, m_downloader->mtime());
+	setFileOriginInfo(f_out, cache_filename.c_str(), task.full_url.c_str(), req.etag.c_str(), req.mtime);
 #else /* !_WIN32 */
-	setFileOriginInfo(f_out, full_url, m_downloader->mtime());
+	setFileOriginInfo(f_out, task.full_url.c_str(), req.etag.c_str(), req.mtime);
 #endif /* _WIN32 */
 	fclose(f_out);
 
@@ -821,3 +653,322 @@ int RP_C_API _tmain(int argc, TCHAR *argv[])
 		unlikely(dataSize == 1) ? "" : "s");
 	return EXIT_SUCCESS;
 }
+
+/**
+ * Process a set of cache keys: prepare, download, and save.
+ * @param downloader	[in] Downloader to use.
+ * @param keys		[in] Cache keys.
+ * @param count		[in] Number of cache keys.
+ * @param force		[in] If true, download even if the cache file exists.
+ * @return EXIT_SUCCESS if all keys succeeded; EXIT_FAILURE otherwise.
+ */
+static int process_cache_keys(IDownloader *downloader, const TCHAR *const *keys, int count, bool force)
+{
+	// Prepare each cache key.
+	bool any_failed = false;
+	vector<KeyTask> tasks;
+	tasks.reserve(count);
+	for (int i = 0; i < count; i++) {
+		KeyTask task;
+		const int ret = prepare_cache_key(keys[i], force, task);
+		if (ret == 0) {
+			tasks.push_back(std::move(task));
+		} else if (ret < 0) {
+			any_failed = true;
+		}
+		// ret == 1: Cached copy is up to date. Nothing to do.
+	}
+
+	if (tasks.empty()) {
+		// Nothing to download.
+		return (any_failed ? EXIT_FAILURE : EXIT_SUCCESS);
+	}
+
+	// Download all cache keys in one batch. CurlDownloader runs the
+	// transfers concurrently with connection reuse and HTTP/2
+	// multiplexing; other downloaders run them sequentially.
+	vector<IDownloader::BatchRequest> requests(tasks.size());
+	for (size_t i = 0; i < tasks.size(); i++) {
+		requests[i].url = tasks[i].full_url;
+		if (tasks[i].check_newer && tasks[i].filemtime >= 0) {
+			// Only download if the file on the server is newer than
+			// what's in our cache directory.
+			requests[i].if_modified_since = tasks[i].filemtime;
+		}
+		// If an ETag was stored, revalidate with If-None-Match.
+		// A 304 response means the cached copy is still valid.
+		requests[i].if_none_match = tasks[i].etag;
+	}
+	const int ret = downloader->downloadBatch(requests);
+	if (ret != 0) {
+		SHOW_ERROR(_T("Error downloading files: %s"), _tcserror(-ret));
+		return EXIT_FAILURE;
+	}
+
+	// Save the downloaded files.
+	for (size_t i = 0; i < tasks.size(); i++) {
+		if (save_cache_file(tasks[i], requests[i]) != EXIT_SUCCESS) {
+			any_failed = true;
+		}
+	}
+	return (any_failed ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+/**
+ * Daemon mode main loop.
+ *
+ * Reads one cache key per line from stdin and processes it,
+ * keeping the downloader instance (and hence libcurl's connection
+ * and TLS session caches) warm between requests. One status line
+ * is written to stdout per key: "ok <cache_key>" or "err <cache_key>".
+ *
+ * The loop exits cleanly on EOF, so the parent process can shut
+ * the daemon down by closing its end of the pipe.
+ *
+ * @param downloader	[in] Downloader to use.
+ * @return EXIT_SUCCESS on clean EOF.
+ */
+static int daemon_loop(IDownloader *downloader)
+{
+	TCHAR line[1024];
+	while (_fgetts(line, _countof(line), stdin) != nullptr) {
+		// Remove the trailing newline.
+		size_t len = _tcslen(line);
+		while (len > 0 && (line[len-1] == _T('\n') || line[len-1] == _T('\r'))) {
+			line[--len] = _T('\0');
+		}
+		if (len == 0) {
+			// Empty line. Ignore it.
+			continue;
+		}
+
+		const TCHAR *const key = line;
+		const int ret = process_cache_keys(downloader, &key, 1, false);
+		_tprintf(ret == EXIT_SUCCESS ? _T("ok %s\n") : _T("err %s\n"), key);
+		fflush(stdout);
+	}
+	return EXIT_SUCCESS;
+}
+
+/**
+ * rp-download: Download images from supported online databases.
+ * @param cache_key Cache key(s), e.g. "ds/cover/US/ADAE.png"
+ * @return 0 on success; non-zero on error.
+ *
+ * TODO:
+ * - More error codes based on the error.
+ */
+int RP_C_API _tmain(int argc, TCHAR *argv[])
+{
+	// Create a downloader based on OS:
+	// - Linux: CurlDownloader
+	// - Windows: WinInetDownloader
+
+	// Syntax: rp-download cache_key
+	// Example: rp-download ds/coverM/US/ADAE.png
+
+	// If http_proxy or https_proxy are set, they will be used
+	// by the downloader code if supported.
+
+	// Restrict DLL lookups.
+	rp_secure_restrict_dll_lookups();
+	// Reduce process integrity, if available.
+	rp_secure_reduce_integrity();
+
+	// Set OS-specific security options.
+	rp_secure_param_t param;
+#if defined(_WIN32)
+	param.bHighSec = FALSE;
+#elif defined(HAVE_SECCOMP)
+	static constexpr int syscall_wl[] = {
+		// Syscalls used by rp-download.
+		// TODO: Add more syscalls.
+		// FIXME: glibc-2.31 uses 64-bit time syscalls that may not be
+		// defined in earlier versions, including Ubuntu 14.04.
+		SCMP_SYS(clock_gettime),
+#if defined(__SNR_clock_gettime64) || defined(__NR_clock_gettime64)
+		SCMP_SYS(clock_gettime64),
+#endif /* __SNR_clock_gettime64 || __NR_clock_gettime64 */
+		SCMP_SYS(close),
+		SCMP_SYS(fcntl),     SCMP_SYS(fcntl64),		// gcc profiling
+		SCMP_SYS(fsetxattr),
+		SCMP_SYS(getxattr),	// stored ETag for If-None-Match
+		SCMP_SYS(fstat),     SCMP_SYS(fstat64),		// __GI___fxstat() [printf()]
+		SCMP_SYS(fstatat64), SCMP_SYS(newfstatat),	// Ubuntu 19.10 (32-bit)
+		SCMP_SYS(futex),
+		SCMP_SYS(getdents), SCMP_SYS(getdents64),
+		SCMP_SYS(getppid),	// for bubblewrap verification
+		SCMP_SYS(getrusage),
+		SCMP_SYS(gettimeofday),	// 32-bit only?
+		SCMP_SYS(getuid),	// TODO: Only use geteuid()?
+		SCMP_SYS(lseek), SCMP_SYS(_llseek),
+		//SCMP_SYS(lstat), SCMP_SYS(lstat64),	// Not sure if used?
+		SCMP_SYS(mkdir), SCMP_SYS(mmap), SCMP_SYS(mmap2),
+		SCMP_SYS(munmap),
+		SCMP_SYS(open),		// Ubuntu 16.04
+		SCMP_SYS(openat),	// glibc-2.31
+#if defined(__SNR_openat2)
+		SCMP_SYS(openat2),	// Linux 5.6
+#elif defined(__NR_openat2)
+		__NR_openat2,		// Linux 5.6
+#endif /* __SNR_openat2 || __NR_openat2 */
+		SCMP_SYS(poll), SCMP_SYS(select),
+		SCMP_SYS(stat), SCMP_SYS(stat64),
+		SCMP_SYS(unlink),	// to delete expired cache files
+		SCMP_SYS(utimensat),
+
+#if defined(__SNR_statx) || defined(__NR_statx)
+		SCMP_SYS(getcwd),	// called by glibc's statx()
+		SCMP_SYS(statx),
+#endif /* __SNR_statx || __NR_statx */
+
+		// glibc ncsd
+		// TODO: Restrict connect() to AF_UNIX.
+		SCMP_SYS(connect), SCMP_SYS(recvmsg), SCMP_SYS(sendto),
+		SCMP_SYS(sendmmsg),	// getaddrinfo() (32-bit only?)
+		SCMP_SYS(ioctl),	// getaddrinfo() (32-bit only?) [FIXME: Filter for FIONREAD]
+		SCMP_SYS(recvfrom),	// getaddrinfo() (32-bit only?)
+
+		// Needed for network access on Kubuntu 20.04 for some reason.
+		SCMP_SYS(getpid), SCMP_SYS(uname),
+
+		// cURL and OpenSSL
+		SCMP_SYS(bind),		// getaddrinfo() [curl_thread_create_thunk(), curl-7.68.0]
+#ifdef __SNR_getrandom
+		SCMP_SYS(getrandom),
+#endif /* __SNR_getrandom */
+		SCMP_SYS(getpeername), SCMP_SYS(getsockname),
+		SCMP_SYS(getsockopt), SCMP_SYS(madvise), SCMP_SYS(mprotect),
+		SCMP_SYS(setsockopt), SCMP_SYS(socket),
+		SCMP_SYS(socketcall),	// FIXME: Enhanced filtering? [cURL+GnuTLS only?]
+		SCMP_SYS(socketpair), SCMP_SYS(sysinfo),
+		SCMP_SYS(rt_sigprocmask),	// Ubuntu 20.04: __GI_getaddrinfo() ->
+						// gaih_inet() ->
+						// _nss_myhostname_gethostbyname4_r()
+
+		// libnss_resolve.so (systemd-resolved)
+		SCMP_SYS(geteuid),
+		SCMP_SYS(sendmsg),	// libpthread.so [_nss_resolve_gethostbyname4_r() from libnss_resolve.so]
+
+		// FIXME: Manjaro is using these syscalls for some reason...
+		SCMP_SYS(prctl), SCMP_SYS(mremap), SCMP_SYS(ppoll),
+
+		// cURL's "easy" functions use multi internally, which uses pipe().
+		// Some update, either cURL 8.4.0 -> 8.5.0 or glibc 2.38 -> 2.39,
+		// is now using the pipe2() syscall.
+		SCMP_SYS(pipe2),
+
+		// Needed on 32-bit Ubuntu 16.04 (glibc-2.23, cURL 7.47.0) for some reason...
+		// (called from getaddrinfo())
+		SCMP_SYS(time),
+
+		-1	// End of whitelist
+	};
+	param.syscall_wl = syscall_wl;
+	param.threading = true;		// libcurl uses multi-threading.
+#elif defined(HAVE_PLEDGE)
+	// Promises:
+	// - stdio: General stdio functionality.
+	// - rpath: Read from ~/.config/rom-properties/ and ~/.cache/rom-properties/
+	// - wpath: Write to ~/.cache/rom-properties/
+	// - cpath: Create ~/.cache/rom-properties/ if it doesn't exist.
+	// - inet: Internet access.
+	// - fattr: Modify file attributes, e.g. mtime.
+	// - dns: Resolve hostnames.
+	// - getpw: Get user's home directory if HOME is empty.
+	param.promises = "stdio rpath wpath cpath inet fattr dns getpw";
+#elif defined(HAVE_TAME)
+	// NOTE: stdio includes fattr, e.g. utimes().
+	param.tame_flags = TAME_STDIO | TAME_RPATH | TAME_WPATH | TAME_CPATH |
+	                   TAME_INET | TAME_DNS | TAME_GETPW;
+#else
+	param.dummy = 0;
+#endif
+	rp_secure_enable(param);
+
+#ifdef __GLIBC__
+	// Reduce /etc/localtime stat() calls.
+	// References:
+	// - https://lwn.net/Articles/944499/
+	// - https://gitlab.com/procps-ng/procps/-/merge_requests/119
+	setenv("TZ", ":/etc/localtime", 0);
+#endif /* __GLIBC__ */
+
+	// Store argv[0] globally.
+	argv0 = argv[0];
+
+	if (argc < 2) {
+		show_usage();
+		return EXIT_FAILURE;
+	}
+
+	// Check for arguments. (simple non-getopt version)
+	bool force = false;
+	bool daemon_mode = false;
+	int optind = 1;
+	for (; optind < argc; optind++) {
+		if (!argv[optind] || argv[optind][0] != '-') {
+			// End of options.
+			break;
+		}
+
+		// Allow multiple options in one argument, e.g. '-vf'.
+		for (int i = 1; argv[optind][i] != '\0'; i++) {
+			switch (argv[optind][i]) {
+				case 'v':
+					// Verbose mode is enabled.
+					verbose = true;
+					break;
+				case 'f':
+					// Force download is enabled.
+					force = true;
+					break;
+				case 'd':
+					// Daemon mode: process cache keys from stdin.
+					daemon_mode = true;
+					break;
+				default:
+					// Invalid parameter.
+					show_error(_T("Unrecognized option: %c"), argv[optind][i]);
+					show_usage();
+					return EXIT_FAILURE;
+			}
+		}
+	}
+
+	if (optind >= argc && !daemon_mode) {
+		show_error(_T("No cache key specified."));
+		show_usage();
+		return EXIT_FAILURE;
+	}
+
+	// Make sure we have a valid cache directory.
+	const string &cache_dir = LibCacheCommon::getCacheDirectory();
+	if (cache_dir.empty()) {
+		// Cache directory is invalid...
+		// This may happen if bubblewrap is in use.
+		SHOW_ERROR(_T("Unable to access cache directory. Check the sandbox environment!"));
+		return EXIT_FAILURE;
+	}
+
+	// Create the downloader.
+	// TODO: IDownloaderFactory?
+#ifdef _WIN32
+	unique_ptr<IDownloader> m_downloader(new WinInetDownloader());
+#else /* !_WIN32 */
+	unique_ptr<IDownloader> m_downloader(new CurlDownloader());
+#endif /* _WIN32 */
+
+	// TODO: Configure this somewhere?
+	m_downloader->setMaxSize(4*1024*1024);
+
+	if (daemon_mode) {
+		// Daemon mode: Process cache keys from stdin, one per line.
+		// This keeps the downloader (and its TLS sessions) warm
+		// across downloads, amortizing process startup costs.
+		return daemon_loop(m_downloader.get());
+	}
+
+	// One-shot mode: Process the cache keys from the command line.
+	return process_cache_keys(m_downloader.get(), &argv[optind], argc - optind, force);
+}
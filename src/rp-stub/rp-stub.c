@@ -35,6 +35,12 @@
 #include <string.h>
 #include <unistd.h>
 
+#ifdef HAVE_RP_MAGIC_DB
+// Generated magic-number database. (see rp_magic_db_parser.py)
+#  include "rp_magic_db.h"
+#  include <fcntl.h>
+#endif /* HAVE_RP_MAGIC_DB */
+
 #include "tcharx.h"	// for DIR_SEP_CHR
 
 /**
@@ -127,6 +133,8 @@ static void show_help(const char *argv0)
 			{"  -a, --autoext",	NOP_C_("rp-stub|Help", "Generate the output filename based on the source filename.")},
 			{"               ",	NOP_C_("rp-stub|Help", "(WARNING: May overwrite an existing file without prompting.)")},
 			{"  -n, --noxdg",	NOP_C_("rp-stub|Help", "Don't include XDG thumbnail metadata.")},
+			{"  -b, --batch",	NOP_C_("rp-stub|Help", "Read tab-separated source/output filename pairs from stdin.")},
+			{"             ",	NOP_C_("rp-stub|Help", "(The library is only loaded and initialized once.)")},
 		};
 		static const struct opt_t *const thumb_opts_end = &thumb_opts[ARRAY_SIZE(thumb_opts)];
 
@@ -216,6 +224,106 @@ static int ATTR_PRINTF(2, 3) print_opt_error(const char *argv0, const char *form
 	return ret;
 }
 
+// Result code for files rejected by the magic-number database.
+// Matches TCreateThumbnail.hpp: RPCT_ERROR_SOURCE_FILE_NOT_SUPPORTED.
+#define RP_STUB_RESULT_NOT_SUPPORTED 3
+
+/**
+ * Check the magic-number database to see if a file might be thumbnailable.
+ *
+ * The database is generated at build time from RomDataFactory.cpp's
+ * romDataFns_magic[] table. If the file's header matches only classes
+ * without thumbnail support (e.g. ELF binaries in mixed directories),
+ * it can be rejected without loading libromdata at all.
+ *
+ * NOTE: Many classes probe without a 32-bit magic number, so a file
+ * that matches nothing must still be handed to the library.
+ *
+ * @param source_file Source filename
+ * @return 1 if the file might be thumbnailable; 0 if it definitely isn't.
+ */
+static int rp_magic_db_may_thumbnail(const char *source_file)
+{
+#ifdef HAVE_RP_MAGIC_DB
+	uint8_t header[RP_MAGIC_DB_MAX_READ];
+
+	const int fd = open(source_file, O_RDONLY | O_CLOEXEC);
+	if (fd < 0) {
+		// Cannot open the file.
+		// Let the library report the error.
+		return 1;
+	}
+	const ssize_t sz = read(fd, header, sizeof(header));
+	close(fd);
+	if (sz < 4) {
+		// Too small for any magic number.
+		// Let the library decide.
+		return 1;
+	}
+
+	int matched = 0;
+	for (size_t i = 0; i < ARRAY_SIZE(rp_magic_db); i++) {
+		const RpMagicDbEntry *const entry = &rp_magic_db[i];
+		if (entry->address + 4 > (size_t)sz) {
+			// Magic number is beyond the end of the file.
+			continue;
+		}
+		const uint8_t *const b = &header[entry->address];
+		const uint32_t magic = ((uint32_t)b[0] << 24) |
+		                       ((uint32_t)b[1] << 16) |
+		                       ((uint32_t)b[2] <<  8) |
+		                        (uint32_t)b[3];
+		if (magic == entry->magic) {
+			if (entry->attrs & RP_MAGIC_DB_ATTR_HAS_THUMBNAIL) {
+				// Identified as a thumbnailable class.
+				return 1;
+			}
+			matched = 1;
+		}
+	}
+
+	// If the file matched only non-thumbnailable classes, reject it.
+	// If it matched nothing, the library has to probe it.
+	return !matched;
+#else /* !HAVE_RP_MAGIC_DB */
+	RP_UNUSED(source_file);
+	return 1;
+#endif /* HAVE_RP_MAGIC_DB */
+}
+
+/**
+ * Create an output filename based on the source filename.
+ * The file extension is replaced with ".png".
+ * @param source_file Source filename
+ * @return Newly-allocated output filename. (must be free()'d by the caller)
+ */
+static char *create_output_filename(const char *source_file)
+{
+	const size_t output_len = strlen(source_file);
+	char *const output_file = malloc(output_len + 16);
+	strcpy(output_file, source_file);
+
+	// Find the current extension and replace it.
+	char *const dotpos = strrchr(output_file, '.');
+	if (!dotpos) {
+		// No file extension. Add it.
+		strlcat(output_file, ".png", output_len + 16);
+	} else {
+		// If the dot is after the last slash, we already have a file extension.
+		// Otherwise, we don't have one, and need to add it.
+		char *const slashpos = strrchr(output_file, DIR_SEP_CHR);
+		if (slashpos < dotpos) {
+			// We already have a file extension.
+			strcpy(dotpos, ".png");
+		} else {
+			// No file extension.
+			strlcat(output_file, ".png", output_len + 16);
+		}
+	}
+
+	return output_file;
+}
+
 int main(int argc, char *argv[])
 {
 	/**
@@ -262,6 +370,7 @@ int main(int argc, char *argv[])
 		{"size",	required_argument,	NULL, 's'},
 		{"autoext",	no_argument,		NULL, 'a'},
 		{"noxdg",	no_argument,		NULL, 'n'},
+		{"batch",	no_argument,		NULL, 'b'},
 		{"config",	no_argument,		NULL, 'c'},
 		{"RomDataView",	no_argument,		NULL, 'R'},
 		{"debug",	no_argument,		NULL, 'd'},
@@ -276,8 +385,9 @@ int main(int argc, char *argv[])
 	int maximum_size = 256;
 	unsigned int flags = 0;
 	bool autoext = false;
+	bool batch = false;
 	int c, option_index;
-	while ((c = getopt_long(argc, argv, "s:acdnhRV", long_options, &option_index)) != -1) {
+	while ((c = getopt_long(argc, argv, "s:abcdnhRV", long_options, &option_index)) != -1) {
 		switch (c) {
 			case 's': {
 				char *endptr = NULL;
@@ -299,6 +409,11 @@ int main(int argc, char *argv[])
 				autoext = true;
 				break;
 
+			case 'b':
+				// Batch mode: Read filenames from stdin.
+				batch = true;
+				break;
+
 			case 'c':
 				// Show the configuration dialog.
 				mode = MODE_CONFIG;
@@ -340,7 +455,13 @@ int main(int argc, char *argv[])
 	// TODO: Options for RomDataView mode?
 	rp_stub_do_security_options(mode == MODE_CONFIG);
 
-	if (mode == MODE_THUMBNAIL) {
+	if (mode == MODE_THUMBNAIL && batch) {
+		// Batch mode: Filenames are read from stdin.
+		if (optind < argc) {
+			print_opt_error(argv[0], "%s", C_("rp-stub", "--batch reads file parameters from stdin"));
+			return EXIT_FAILURE;
+		}
+	} else if (mode == MODE_THUMBNAIL) {
 		// Thumbnailing mode.
 		// We must have 2 filenames specified.
 		if (optind == argc) {
@@ -358,6 +479,19 @@ int main(int argc, char *argv[])
 		}
 	}
 
+	if (mode == MODE_THUMBNAIL && !batch) {
+		// Check the magic-number database first.
+		// Files identified as a non-thumbnailable class are
+		// rejected without loading libromdata.
+		if (!rp_magic_db_may_thumbnail(argv[optind])) {
+			if (is_debug) {
+				fprintf(stderr, C_("rp-stub", "Source file rejected by the magic-number database."));
+				putc('\n', stderr);
+			}
+			return RP_STUB_RESULT_NOT_SUPPORTED;
+		}
+	}
+
 	// Search for a usable rom-properties library.
 	// TODO: Desktop override option?
 	const char *symname;
@@ -392,32 +526,85 @@ int main(int argc, char *argv[])
 			setenv("TZ", ":/etc/localtime", 0);
 #endif /* __GLIBC__ */
 
+			if (batch) {
+				// Batch mode: Read requests from stdin, one per line:
+				//   source_file '\t' output_file
+				// If a line has no output filename and --autoext was
+				// specified, the output filename is derived from the
+				// source filename.
+				//
+				// The library is only loaded and initialized once, so
+				// thumbnailing a directory of ROMs is bounded by decode
+				// time instead of per-process startup.
+				//
+				// The result of each request is printed to stdout:
+				//   status '\t' source_file
+				char *line = NULL;
+				size_t line_buf_len = 0;
+				ssize_t line_len;
+				while ((line_len = getline(&line, &line_buf_len, stdin)) >= 0) {
+					// Remove the trailing newline.
+					if (line_len > 0 && line[line_len-1] == '\n') {
+						line[line_len-1] = '\0';
+						line_len--;
+					}
+					if (line_len <= 0) {
+						// Skip empty lines.
+						continue;
+					}
+
+					const char *const batch_source = line;
+					char *batch_output = strchr(line, '\t');
+					bool batch_output_alloc = false;
+					if (batch_output) {
+						*batch_output++ = '\0';
+					} else if (autoext) {
+						batch_output = create_output_filename(batch_source);
+						batch_output_alloc = true;
+					} else {
+						fprintf(stderr, C_("rp-stub", "*** ERROR: batch request has no output file: %s"), batch_source);
+						putc('\n', stderr);
+						continue;
+					}
+
+					if (!rp_magic_db_may_thumbnail(batch_source)) {
+						// Rejected by the magic-number database.
+						printf("%d\t%s\n", RP_STUB_RESULT_NOT_SUPPORTED, batch_source);
+						fflush(stdout);
+						if (batch_output_alloc) {
+							free(batch_output);
+						}
+						continue;
+					}
+
+					if (is_debug) {
+						// tr: NOTE: Not positional. Don't change argument positions!
+						// tr: Only localize "Calling function:".
+						fprintf(stderr, C_("rp-stub", "Calling function: %s(\"%s\", \"%s\", %d, %u);"),
+							symname, batch_source, batch_output, maximum_size, flags);
+						putc('\n', stderr);
+					}
+					const int bret = ((PFN_RP_CREATE_THUMBNAIL2)pfn)(batch_source, batch_output, maximum_size, flags);
+
+					// Print the result so the caller can track completion.
+					printf("%d\t%s\n", bret, batch_source);
+					fflush(stdout);
+
+					if (batch_output_alloc) {
+						free(batch_output);
+					}
+				}
+				free(line);
+				ret = 0;
+				break;
+			}
+
 			// Create the thumbnail.
 			const char *const source_file = argv[optind];
 			char *output_file;
 			if (autoext) {
 				// Create the output filename based on the input filename.
-				size_t output_len = strlen(source_file);
-				output_file = malloc(output_len + 16);
-				strcpy(output_file, source_file);
-
-				// Find the current extension and replace it.
-				char *const dotpos = strrchr(output_file, '.');
-				if (!dotpos) {
-					// No file extension. Add it.
-					strlcat(output_file, ".png", output_len + 16);
-				} else {
-					// If the dot is after the last slash, we already have a file extension.
-					// Otherwise, we don't have one, and need to add it.
-					char *const slashpos = strrchr(output_file, DIR_SEP_CHR);
-					if (slashpos < dotpos) {
-						// We already have a file extension.
-						strcpy(dotpos, ".png");
-					} else {
-						// No file extension.
-						strlcat(output_file, ".png", output_len + 16);
-					}
-				}
+				output_file = create_output_filename(source_file);
 			} else {
 				// Use the specified output filename.
 				output_file = argv[optind+1];
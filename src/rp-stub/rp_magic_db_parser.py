@@ -0,0 +1,106 @@
+#!/usr/bin/env python3
+# Magic-number database builder
+#
+# Extracts the 32-bit magic number table from RomDataFactory.cpp
+# (romDataFns_magic[]) and prints a compact standalone C header.
+# This lets rp-stub reject files that are identified as a class
+# without thumbnail support, without loading libromdata.
+#
+# Syntax: rp_magic_db_parser.py infile outfile
+#
+# infile is RomDataFactory.cpp. Only GetRomDataFns_addr() entries
+# within the romDataFns_magic[] array are parsed.
+#
+
+# NOTE: All exceptions will be ignored and printed
+# to the console.
+
+import re
+import sys
+
+if len(sys.argv) != 3:
+	print('Magic-number database builder')
+	print(f'Syntax: {sys.argv[0]} infile outfile')
+	sys.exit(1)
+
+infile = sys.argv[1]
+outfile = sys.argv[2]
+
+# Entry regex: GetRomDataFns_addr(Class, attrs, address, magic),
+re_entry = re.compile(
+	r"GetRomDataFns_addr\(\s*(\w+)\s*,\s*([^,]+?)\s*,\s*(0[xX][0-9A-Fa-f]+|\d+)\s*,\s*('.{4}'|0[xX][0-9A-Fa-f]+U?)\s*\)\s*,")
+
+def parse_magic(token):
+	"""Convert a magic token ('ABCD' or 0x...) to a 32-bit integer."""
+	if token.startswith("'"):
+		# Multi-character literal: 4 bytes, big-endian.
+		chars = token[1:-1]
+		if len(chars) != 4:
+			raise ValueError(f'Invalid multi-char literal: {token}')
+		value = 0
+		for ch in chars:
+			value = (value << 8) | ord(ch)
+		return value
+	# Hex literal, possibly with a 'U' suffix.
+	if token.endswith('U'):
+		token = token[:-1]
+	return int(token, 16)
+
+entries = []	# (class_name, address, magic, has_thumbnail)
+in_magic_table = False
+with open(infile, 'r', encoding='utf-8') as f_in:
+	for line in f_in:
+		stripped = line.strip()
+		if not in_magic_table:
+			if stripped.startswith('static constexpr RomDataFns romDataFns_magic[]'):
+				in_magic_table = True
+			continue
+		if stripped.startswith('};'):
+			# End of romDataFns_magic[].
+			break
+		if stripped.startswith('//'):
+			# Commented-out entry.
+			continue
+		m = re_entry.search(line)
+		if not m:
+			continue
+		class_name = m.group(1)
+		attrs = m.group(2)
+		address = int(m.group(3), 0)
+		magic = parse_magic(m.group(4))
+		has_thumbnail = 'ATTR_HAS_THUMBNAIL' in attrs
+		entries.append((class_name, address, magic, has_thumbnail))
+
+if not entries:
+	print(f'*** ERROR: No romDataFns_magic[] entries found in {infile}.')
+	sys.exit(1)
+
+max_read = max(address for (_, address, _, _) in entries) + 4
+
+with open(outfile, 'w', encoding='utf-8') as f_out:
+	f_out.write(
+		'/** Magic-number database. (generated by rp_magic_db_parser.py) **/\n'
+		'/** Extracted from RomDataFactory.cpp: romDataFns_magic[] **/\n'
+		'/** DO NOT EDIT MANUALLY! **/\n'
+		'\n'
+		'#pragma once\n'
+		'\n'
+		'#include <stdint.h>\n'
+		'\n'
+		'/** Entry attributes **/\n'
+		'#define RP_MAGIC_DB_ATTR_HAS_THUMBNAIL 0x01\n'
+		'\n'
+		'/** Number of header bytes needed to check every entry **/\n'
+		f'#define RP_MAGIC_DB_MAX_READ {max_read}\n'
+		'\n'
+		'typedef struct _RpMagicDbEntry {\n'
+		'\tuint32_t address;\t/* address of the magic number within the file */\n'
+		'\tuint32_t magic;\t\t/* 32-bit big-endian value at that address */\n'
+		'\tuint8_t attrs;\t\t/* RP_MAGIC_DB_ATTR_* */\n'
+		'} RpMagicDbEntry;\n'
+		'\n'
+		'static const RpMagicDbEntry rp_magic_db[] = {\n')
+	for (class_name, address, magic, has_thumbnail) in entries:
+		attrs = 'RP_MAGIC_DB_ATTR_HAS_THUMBNAIL' if has_thumbnail else '0'
+		f_out.write(f'\t{{{address:#x}, {magic:#010x}, {attrs}}},\t/* {class_name} */\n')
+	f_out.write('};\n')
@@ -26,10 +26,21 @@ using LibRpFile::RpFile;
 #include "librpfile/scsi/scsi_protocol.h"
 #include "librpfile/scsi/ata_protocol.h"
 
+// for the device interrogation cache
+#ifdef __linux__
+#  include <fcntl.h>
+#  include <sys/ioctl.h>
+#  include <sys/stat.h>
+#  include <sys/sysmacros.h>
+#  include <unistd.h>
+#  include <linux/fs.h>
+#endif /* __linux__ */
+
 // C++ STL classes
 using std::array;
 using std::ios;
 using std::ostream;
+using std::string;
 
 class StreamStateSaver {
 	ios &stream;	// Stream being adjusted.
@@ -56,6 +67,176 @@ public:
 	}
 };
 
+/** Device interrogation cache **/
+
+// SCSI INQUIRY and ATA IDENTIFY DEVICE responses are cached per device
+// node in the XDG cache directory and revalidated using the kernel's
+// disk sequence number (BLKGETDISKSEQ), which increments on media
+// change and device reattachment. Repeated invocations against the
+// same drive skip the slow SCSI commands.
+// NOTE: Linux 5.15+ only. If BLKGETDISKSEQ isn't available, the
+// commands are issued every time, same as before.
+#if defined(__linux__) && defined(BLKGETDISKSEQ)
+#  define RP_DEVICE_CACHE_SUPPORTED 1
+#endif
+
+#ifdef RP_DEVICE_CACHE_SUPPORTED
+
+enum DeviceCacheType : uint32_t {
+	DEVCACHE_SCSI_INQUIRY		= 0,
+	DEVCACHE_ATA_IDENTIFY		= 1,
+	DEVCACHE_ATA_IDENTIFY_PACKET	= 2,
+};
+
+struct DeviceCacheHeader {
+	char magic[8];		// devcache_magic
+	uint32_t type;		// DeviceCacheType
+	uint32_t size;		// Payload size
+	uint64_t rdev;		// st_rdev of the device node
+	uint64_t diskseq;	// Disk sequence number
+};
+
+static const char devcache_magic[8] = {'R','P','D','E','V','C',1,0};
+
+/**
+ * Get a device node's rdev and disk sequence number.
+ * @param filename	[in] Device node filename
+ * @param rdev		[out] st_rdev
+ * @param diskseq	[out] Disk sequence number
+ * @return 0 on success; negative POSIX error code on error.
+ */
+static int getDeviceSeq(const char *filename, uint64_t *rdev, uint64_t *diskseq)
+{
+	struct stat sb;
+	if (stat(filename, &sb) != 0)
+		return -errno;
+	if (!S_ISBLK(sb.st_mode))
+		return -ENOTBLK;
+	*rdev = static_cast<uint64_t>(sb.st_rdev);
+
+	const int fd = open(filename, O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+	if (fd < 0)
+		return -errno;
+
+	int ret = 0;
+	uint64_t seq = 0;
+	if (ioctl(fd, BLKGETDISKSEQ, &seq) != 0) {
+		ret = -errno;
+	}
+	close(fd);
+	*diskseq = seq;
+	return ret;
+}
+
+/**
+ * Get the cache filename for a device interrogation response.
+ * $XDG_CACHE_HOME/rom-properties/devcache-<major>-<minor>-<type>.bin
+ * ($HOME/.cache is used if $XDG_CACHE_HOME is not set.)
+ * @param rdev	[in] Device st_rdev
+ * @param type	[in] DeviceCacheType
+ * @return Cache filename, or empty string on error.
+ */
+static string getDeviceCacheFilename(uint64_t rdev, uint32_t type)
+{
+	string path;
+	const char *const xdg_cache_home = getenv("XDG_CACHE_HOME");
+	if (xdg_cache_home && xdg_cache_home[0] == '/') {
+		path = xdg_cache_home;
+	} else {
+		const char *const home = getenv("HOME");
+		if (!home || home[0] != '/')
+			return {};
+		path = home;
+		path += "/.cache";
+	}
+
+	path += "/rom-properties";
+	if (mkdir(path.c_str(), 0777) != 0 && errno != EEXIST)
+		return {};
+
+	path += rp_sprintf("/devcache-%u-%u-%u.bin",
+		major(rdev), minor(rdev), type);
+	return path;
+}
+
+/**
+ * Read a cached device interrogation response.
+ * @param filename	[in] Device node filename
+ * @param type		[in] DeviceCacheType
+ * @param resp		[out] Response buffer
+ * @param size		[in] Size of resp
+ * @return True if a valid cached response was loaded; false if not.
+ */
+static bool readDeviceCache(const char *filename, uint32_t type, void *resp, size_t size)
+{
+	uint64_t rdev = 0, diskseq = 0;
+	if (getDeviceSeq(filename, &rdev, &diskseq) != 0)
+		return false;
+
+	const string cache_filename = getDeviceCacheFilename(rdev, type);
+	if (cache_filename.empty())
+		return false;
+
+	FILE *f = fopen(cache_filename.c_str(), "rb");
+	if (!f)
+		return false;
+
+	DeviceCacheHeader header;
+	bool ok = false;
+	do {
+		if (fread(&header, 1, sizeof(header), f) != sizeof(header))
+			break;
+		if (memcmp(header.magic, devcache_magic, sizeof(devcache_magic)) != 0)
+			break;
+		if (header.type != type || header.size != size)
+			break;
+		if (header.rdev != rdev || header.diskseq != diskseq) {
+			// Stale: the device or media has changed.
+			break;
+		}
+		if (fread(resp, 1, size, f) != size)
+			break;
+		ok = true;
+	} while (0);
+	fclose(f);
+	return ok;
+}
+
+/**
+ * Save a device interrogation response to the cache.
+ * Failure is non-fatal; the next invocation will issue the command again.
+ * @param filename	[in] Device node filename
+ * @param type		[in] DeviceCacheType
+ * @param resp		[in] Response buffer
+ * @param size		[in] Size of resp
+ */
+static void writeDeviceCache(const char *filename, uint32_t type, const void *resp, size_t size)
+{
+	uint64_t rdev = 0, diskseq = 0;
+	if (getDeviceSeq(filename, &rdev, &diskseq) != 0)
+		return;
+
+	const string cache_filename = getDeviceCacheFilename(rdev, type);
+	if (cache_filename.empty())
+		return;
+
+	FILE *f = fopen(cache_filename.c_str(), "wb");
+	if (!f)
+		return;
+
+	DeviceCacheHeader header;
+	memcpy(header.magic, devcache_magic, sizeof(devcache_magic));
+	header.type = type;
+	header.size = static_cast<uint32_t>(size);
+	header.rdev = rdev;
+	header.diskseq = diskseq;
+	fwrite(&header, 1, sizeof(header), f);
+	fwrite(resp, 1, size, f);
+	fclose(f);
+}
+
+#endif /* RP_DEVICE_CACHE_SUPPORTED */
+
 /** ScsiInquiry **/
 
 ScsiInquiry::ScsiInquiry(RpFile *file)
@@ -65,12 +246,21 @@ ScsiInquiry::ScsiInquiry(RpFile *file)
 ostream& operator<<(ostream& os, const ScsiInquiry& si)
 {
 	SCSI_RESP_INQUIRY_STD resp;
-	int ret = si.file->scsi_inquiry(&resp);
-	if (ret != 0) {
-		// TODO: Decode the error.
-		os << "-- " << rp_sprintf(C_("rpcli", "SCSI INQUIRY failed: %08X"),
-			static_cast<unsigned int>(ret)) << '\n';
-		return os;
+#ifdef RP_DEVICE_CACHE_SUPPORTED
+	const char *const device_filename = si.file->filename();
+	if (!readDeviceCache(device_filename, DEVCACHE_SCSI_INQUIRY, &resp, sizeof(resp)))
+#endif /* RP_DEVICE_CACHE_SUPPORTED */
+	{
+		int ret = si.file->scsi_inquiry(&resp);
+		if (ret != 0) {
+			// TODO: Decode the error.
+			os << "-- " << rp_sprintf(C_("rpcli", "SCSI INQUIRY failed: %08X"),
+				static_cast<unsigned int>(ret)) << '\n';
+			return os;
+		}
+#ifdef RP_DEVICE_CACHE_SUPPORTED
+		writeDeviceCache(device_filename, DEVCACHE_SCSI_INQUIRY, &resp, sizeof(resp));
+#endif /* RP_DEVICE_CACHE_SUPPORTED */
 	}
 
 	// SCSI device information.
@@ -167,19 +357,29 @@ AtaIdentifyDevice::AtaIdentifyDevice(RpFile *file, bool packet)
 ostream& operator<<(ostream& os, const AtaIdentifyDevice& si)
 {
 	ATA_RESP_IDENTIFY_DEVICE resp;
-	int ret;
-	if (si.packet) {
-		ret = si.file->ata_identify_packet_device(&resp);
-	} else {
-		ret = si.file->ata_identify_device(&resp);
-	}
+#ifdef RP_DEVICE_CACHE_SUPPORTED
+	const char *const device_filename = si.file->filename();
+	const uint32_t cache_type = (si.packet ? DEVCACHE_ATA_IDENTIFY_PACKET : DEVCACHE_ATA_IDENTIFY);
+	if (!readDeviceCache(device_filename, cache_type, &resp, sizeof(resp)))
+#endif /* RP_DEVICE_CACHE_SUPPORTED */
+	{
+		int ret;
+		if (si.packet) {
+			ret = si.file->ata_identify_packet_device(&resp);
+		} else {
+			ret = si.file->ata_identify_device(&resp);
+		}
 
-	if (ret != 0) {
-		// TODO: Decode the error.
-		os << "-- " << rp_sprintf(C_("rpcli", "ATA %s failed: %08X"),
-			(si.packet ? "IDENTIFY PACKET DEVICE" : "IDENTIFY DEVICE"),
-			static_cast<unsigned int>(ret)) << '\n';
-		return os;
+		if (ret != 0) {
+			// TODO: Decode the error.
+			os << "-- " << rp_sprintf(C_("rpcli", "ATA %s failed: %08X"),
+				(si.packet ? "IDENTIFY PACKET DEVICE" : "IDENTIFY DEVICE"),
+				static_cast<unsigned int>(ret)) << '\n';
+			return os;
+		}
+#ifdef RP_DEVICE_CACHE_SUPPORTED
+		writeDeviceCache(device_filename, cache_type, &resp, sizeof(resp));
+#endif /* RP_DEVICE_CACHE_SUPPORTED */
 	}
 
 	// ATA device information.
@@ -67,10 +67,18 @@ using namespace LibRpTexture;
 #include "tcharx.h"
 
 // C++ STL classes
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <sstream>
+#include <thread>
 using std::cout;
 using std::cerr;
 using std::locale;
 using std::ofstream;
+using std::ostream;
+using std::ostringstream;
 using std::shared_ptr;
 using std::string;
 using std::unique_ptr;
@@ -113,6 +121,15 @@ DELAYLOAD_TEST_FUNCTION_IMPL1(textdomain, nullptr);
 #  define T2U8c(tcs) (tcs)
 #endif /* _WIN32 */
 
+// for the pass-through copy buffer
+#include "aligned_malloc.h"
+
+#ifdef HAVE_COPY_FILE_RANGE
+#  include <fcntl.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif /* HAVE_COPY_FILE_RANGE */
+
 struct ExtractParam {
 	const TCHAR *filename;	// Target filename. Can be null due to argv[argc]
 	int imageType;		// Image Type. -1 = iconAnimData, MUST be between -1 and IMG_INT_MAX
@@ -125,18 +142,271 @@ struct ExtractParam {
 	{}
 };
 
+/**
+ * Check if the source file is itself a PNG image.
+ * If so, image extraction can copy the file directly instead of
+ * re-encoding the decoded pixels. (e.g. cached covers)
+ * @param filename Source filename
+ * @return True if the file starts with the PNG magic; false if not.
+ */
+static bool SourceFileIsPng(const TCHAR *filename)
+{
+	if (!filename)
+		return false;
+
+	// NOTE: Opening without FM_OPEN_READ_GZ: a gzipped PNG
+	// wouldn't be a valid pass-through source.
+	unique_ptr<RpFile> file(new RpFile(filename, RpFile::FM_OPEN_READ));
+	if (!file->isOpen())
+		return false;
+
+	uint8_t magic[8];
+	if (file->read(magic, sizeof(magic)) != sizeof(magic))
+		return false;
+
+	static constexpr uint8_t png_magic[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+	return !memcmp(magic, png_magic, sizeof(png_magic));
+}
+
+/**
+ * Copy a file's raw contents to a new file without re-encoding.
+ * Used for pass-through extraction when the source is already a PNG.
+ *
+ * copy_file_range() is used if available, so the kernel can copy
+ * between the files directly (possibly using filesystem reflinks).
+ * Otherwise, the data is copied through a large aligned buffer.
+ *
+ * @param src_filename	[in] Source filename
+ * @param dest_filename	[in] Destination filename
+ * @return 0 on success; negative POSIX error code on error.
+ */
+static int CopyFileRaw(const TCHAR *src_filename, const TCHAR *dest_filename)
+{
+#ifdef HAVE_COPY_FILE_RANGE
+	const int fd_src = open(src_filename, O_RDONLY | O_CLOEXEC);
+	if (fd_src >= 0) {
+		const int fd_dest = open(dest_filename, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+		if (fd_dest >= 0) {
+			struct stat sb;
+			if (fstat(fd_src, &sb) == 0 && S_ISREG(sb.st_mode)) {
+				off_t remaining = sb.st_size;
+				while (remaining > 0) {
+					const ssize_t cnt = copy_file_range(fd_src, nullptr,
+						fd_dest, nullptr, remaining, 0);
+					if (cnt <= 0)
+						break;
+					remaining -= cnt;
+				}
+				if (remaining <= 0) {
+					close(fd_dest);
+					close(fd_src);
+					return 0;
+				}
+			}
+			close(fd_dest);
+		}
+		close(fd_src);
+	}
+	// copy_file_range() failed, e.g. a cross-filesystem copy on
+	// an older kernel. Fall back to a buffered copy.
+	// (The destination is re-created below, discarding any
+	// partially-copied data.)
+#endif /* HAVE_COPY_FILE_RANGE */
+
+	FILE *const f_src = _tfopen(src_filename, _T("rb"));
+	if (!f_src) {
+		return (errno != 0) ? -errno : -EIO;
+	}
+	FILE *const f_dest = _tfopen(dest_filename, _T("wb"));
+	if (!f_dest) {
+		const int err = (errno != 0) ? -errno : -EIO;
+		fclose(f_src);
+		return err;
+	}
+
+	// Copy through a large aligned buffer.
+	static constexpr size_t COPY_BUF_SIZE = 1U << 20;
+	auto buf = aligned_uptr<uint8_t>(16, COPY_BUF_SIZE);
+	int ret = 0;
+	while (!feof(f_src)) {
+		const size_t sz_read = fread(buf.get(), 1, COPY_BUF_SIZE, f_src);
+		if (ferror(f_src)) {
+			ret = -EIO;
+			break;
+		}
+		if (sz_read == 0)
+			break;
+		if (fwrite(buf.get(), 1, sz_read, f_dest) != sz_read) {
+			ret = (errno != 0) ? -errno : -EIO;
+			break;
+		}
+	}
+	fclose(f_src);
+	if (fclose(f_dest) != 0 && ret == 0) {
+		ret = (errno != 0) ? -errno : -EIO;
+	}
+	return ret;
+}
+
+/** Per-stage timing instrumentation (--bench) **/
+
+// Enabled with the --bench command line option.
+static bool bench_enabled = false;
+
+// Aggregate totals across all files.
+// NOTE: Atomics, since DoFile() may run on -P worker threads.
+struct BenchTotals {
+	std::atomic<uint64_t> us_open{0};	// RpFile open
+	std::atomic<uint64_t> us_probe{0};	// RomDataFactory::create()
+	std::atomic<uint64_t> us_output{0};	// text/JSON output (includes lazy field/metadata loads)
+	std::atomic<uint64_t> us_extract{0};	// image extraction (includes image decode)
+	std::atomic<uint64_t> bytes{0};		// total file size
+	std::atomic<unsigned int> files{0};	// number of files processed
+};
+static BenchTotals bench_totals;
+
+/**
+ * Get a monotonic timestamp for --bench, in microseconds.
+ * @return Timestamp, in microseconds.
+ */
+static inline uint64_t bench_now_us(void)
+{
+	return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+/**
+ * Print the aggregate --bench totals to stderr.
+ */
+static void PrintBenchTotals(void)
+{
+	const unsigned int files = bench_totals.files.load();
+	if (files == 0)
+		return;
+
+	const uint64_t us_open = bench_totals.us_open.load();
+	const uint64_t us_probe = bench_totals.us_probe.load();
+	const uint64_t us_output = bench_totals.us_output.load();
+	const uint64_t us_extract = bench_totals.us_extract.load();
+	const uint64_t us_total = us_open + us_probe + us_output + us_extract;
+
+	// NOTE: Not localized; this is diagnostic output for performance reports.
+	cerr << "== " << rp_sprintf("bench totals: files=%u, bytes=%llu",
+		files, static_cast<unsigned long long>(bench_totals.bytes.load())) << '\n';
+	cerr << "-- " << rp_sprintf("open=%0.3fms, probe=%0.3fms, output=%0.3fms, extract=%0.3fms, total=%0.3fms",
+		us_open / 1000.0, us_probe / 1000.0, us_output / 1000.0,
+		us_extract / 1000.0, us_total / 1000.0) << '\n';
+	cerr << "-- " << rp_sprintf("per file: open=%0.3fms, probe=%0.3fms, output=%0.3fms, extract=%0.3fms, total=%0.3fms",
+		us_open / 1000.0 / files, us_probe / 1000.0 / files,
+		us_output / 1000.0 / files, us_extract / 1000.0 / files,
+		us_total / 1000.0 / files) << '\n';
+	cerr.flush();
+}
+
+/** Verification operations (--verify) **/
+
+// Enabled with the --verify command line option.
+static bool verify_enabled = false;
+
+/**
+ * Run read-only verification ROM operations. (--verify)
+ *
+ * Runs every enabled ROM operation that doesn't require a writable
+ * file or a save filename, e.g. Wii partition hash verification.
+ *
+ * @param romData RomData object
+ * @param os_err Stream for progress/error messages
+ */
+static void DoVerify(RomData *romData, ostream &os_err)
+{
+	const vector<RomData::RomOp> ops = romData->romOps();
+	bool found = false;
+	for (size_t i = 0; i < ops.size(); i++) {
+		const RomData::RomOp &op = ops[i];
+		if (!(op.flags & RomData::RomOp::ROF_ENABLED) ||
+		     (op.flags & (RomData::RomOp::ROF_REQ_WRITABLE | RomData::RomOp::ROF_SAVE_FILE)))
+		{
+			// Not a read-only verification operation.
+			continue;
+		}
+		found = true;
+
+		// Remove the UI mnemonics from the description.
+		string desc = op.desc;
+		desc.erase(std::remove(desc.begin(), desc.end(), '&'), desc.end());
+		os_err << "-- " << rp_sprintf(C_("rpcli", "Running '%s'..."), desc.c_str()) << '\n';
+		os_err.flush();
+
+		RomData::RomOpParams params;
+		const int ret = romData->doRomOp(static_cast<int>(i), &params);
+		if (!params.msg.empty()) {
+			os_err << "   " << params.msg << '\n';
+		} else if (ret == 0) {
+			os_err << "   " << C_("rpcli", "Done") << '\n';
+		} else {
+			os_err << "   " << rp_sprintf(C_("rpcli", "Failed: %s"), strerror(-ret)) << '\n';
+		}
+		os_err.flush();
+	}
+
+	if (!found) {
+		os_err << "-- " << C_("rpcli", "No verification operations are available for this ROM.") << '\n';
+		os_err.flush();
+	}
+}
+
+/** JSON lines output mode (--json-lines) **/
+
+// One self-contained JSON object per file, written and flushed as each
+// file completes, with no array wrapper. Errors are emitted as
+// structured records that include the filename.
+static bool json_lines = false;
+
+/**
+ * Escape a string for inclusion in a JSON record.
+ * @param str String (UTF-8)
+ * @return Escaped string, without the surrounding quotes.
+ */
+static string JsonEscape(const char *str)
+{
+	string ret;
+	ret.reserve(strlen(str) + 8);
+	for (; *str != '\0'; str++) {
+		const uint8_t c = static_cast<uint8_t>(*str);
+		switch (c) {
+			case '"':	ret += "\\\"";	break;
+			case '\\':	ret += "\\\\";	break;
+			case '\b':	ret += "\\b";	break;
+			case '\f':	ret += "\\f";	break;
+			case '\n':	ret += "\\n";	break;
+			case '\r':	ret += "\\r";	break;
+			case '\t':	ret += "\\t";	break;
+			default:
+				if (c < 0x20) {
+					// Other control characters must be escaped.
+					ret += rp_sprintf("\\u%04X", c);
+				} else {
+					ret += static_cast<char>(c);
+				}
+				break;
+		}
+	}
+	return ret;
+}
+
 /**
 * Extracts images from romdata
 * @param romData RomData containing the images
 * @param extract Vector of image extraction parameters
+* @param os_err Stream for progress/error messages (default is stderr)
 */
-static void ExtractImages(const RomData *romData, const vector<ExtractParam> &extract)
+static void ExtractImages(const RomData *romData, const vector<ExtractParam> &extract, ostream &os_err = cerr)
 {
 	const uint32_t supported = romData->supportedImageTypes();
 	for (const ExtractParam &p : extract) {
 		if (!p.filename) continue;
 		bool found = false;
-		
+
 		if (p.imageType >= 0 && (supported & (1U << p.imageType))) {
 			// normal image
 			bool isMipmap = (unlikely(p.mipmapLevel >= 0));
@@ -155,68 +425,68 @@ static void ExtractImages(const RomData *romData, const vector<ExtractParam> &ex
 			if (image && image->isValid()) {
 				found = true;
 				if (likely(!isMipmap)) {
-					cerr << "-- " <<
+					os_err << "-- " <<
 						// tr: %1$s == image type name, %2$s == output filename
 						rp_sprintf_p(C_("rpcli", "Extracting %1$s into '%2$s'"),
 							RomData::getImageTypeName(imageType),
 							T2U8c(p.filename)) << '\n';
 				} else {
-					cerr << "-- " <<
+					os_err << "-- " <<
 						// tr: %s == output filename
 						rp_sprintf_p(C_("rpcli", "Extracting mipmap level %d into '%s'"),
 							p.mipmapLevel, T2U8c(p.filename)) << '\n';
 				}
-				cerr.flush();
+				os_err.flush();
 				int errcode = RpPng::save(p.filename, image);
 				if (errcode != 0) {
 					// tr: %1$s == filename, %2%s == error message
-					cerr << rp_sprintf_p(C_("rpcli", "Couldn't create file '%1$s': %2$s"),
+					os_err << rp_sprintf_p(C_("rpcli", "Couldn't create file '%1$s': %2$s"),
 						T2U8c(p.filename), strerror(-errcode)) << '\n';
 				} else {
-					cerr << "   " << C_("rpcli", "Done") << '\n';
+					os_err << "   " << C_("rpcli", "Done") << '\n';
 				}
-				cerr.flush();
+				os_err.flush();
 			}
 		} else if (p.imageType == -1) {
 			// iconAnimData image
 			auto iconAnimData = romData->iconAnimData();
 			if (iconAnimData && iconAnimData->count != 0 && iconAnimData->seq_count != 0) {
 				found = true;
-				cerr << "-- " << rp_sprintf(C_("rpcli", "Extracting animated icon into '%s'"), T2U8c(p.filename)) << '\n';
-				cerr.flush();
+				os_err << "-- " << rp_sprintf(C_("rpcli", "Extracting animated icon into '%s'"), T2U8c(p.filename)) << '\n';
+				os_err.flush();
 				int errcode = RpPng::save(p.filename, iconAnimData);
 				if (errcode == -ENOTSUP) {
-					cerr << "   " << C_("rpcli", "APNG not supported, extracting only the first frame") << '\n';
-					cerr.flush();
+					os_err << "   " << C_("rpcli", "APNG not supported, extracting only the first frame") << '\n';
+					os_err.flush();
 					// falling back to outputting the first frame
 					errcode = RpPng::save(p.filename, iconAnimData->frames[iconAnimData->seq_index[0]]);
 				}
 				if (errcode != 0) {
-					cerr << "   " <<
+					os_err << "   " <<
 						rp_sprintf_p(C_("rpcli", "Couldn't create file '%1$s': %2$s"),
 							T2U8c(p.filename), strerror(-errcode)) << '\n';
 				} else {
-					cerr << "   " << C_("rpcli", "Done") << '\n';
+					os_err << "   " << C_("rpcli", "Done") << '\n';
 				}
-				cerr.flush();
+				os_err.flush();
 			}
 		}
 
 		if (!found) {
 			// TODO: Return an error code?
 			if (p.imageType == -1) {
-				cerr << "-- " << C_("rpcli", "Animated icon not found") << '\n';
+				os_err << "-- " << C_("rpcli", "Animated icon not found") << '\n';
 			} else if (p.mipmapLevel >= 0) {
-				cerr << "-- " <<
+				os_err << "-- " <<
 					rp_sprintf(C_("rpcli", "Mipmap level %d not found"), p.mipmapLevel) << '\n';
 			} else {
 				const RomData::ImageType imageType =
 					static_cast<RomData::ImageType>(p.imageType);
-				cerr << "-- " <<
+				os_err << "-- " <<
 					rp_sprintf(C_("rpcli", "Image '%s' not found"),
 						RomData::getImageTypeName(imageType)) << '\n';
 			}
-			cerr.flush();
+			os_err.flush();
 		}
 	}
 }
@@ -228,71 +498,306 @@ static void ExtractImages(const RomData *romData, const vector<ExtractParam> &ex
  * @param extract Vector of image extraction parameters
  * @param lc Language code (0 for default)
  * @param flags ROMOutput flags (see OutputFlags)
+ * @param os Output stream (default is stdout)
+ * @param os_err Stream for progress/error messages (default is stderr)
  */
 static void DoFile(const TCHAR *filename, bool json, const vector<ExtractParam> &extract,
-	uint32_t lc = 0, unsigned int flags = 0)
+	uint32_t lc = 0, unsigned int flags = 0, ostream &os = cout, ostream &os_err = cerr)
 {
 	RomDataPtr romData;
 
+	// Metadata-only runs (--fast) hint the factory so it can
+	// skip work that only matters for full extraction.
+	const unsigned int cr_attrs = (flags & OF_MetadataOnly)
+		? RomDataFactory::RDA_INTENT_METADATA_ONLY
+		: 0;
+
+	// Per-stage timestamps for --bench.
+	// NOTE: steady_clock reads are cheap enough to take unconditionally;
+	// only the reporting is gated on bench_enabled.
+	uint64_t bt_open = 0, bt_probe = 0, bt_output = 0, bt_extract = 0;
+	off64_t bench_size = 0;
+	uint64_t bt = bench_now_us();
+
 	if (likely(!FileSystem::is_directory(filename))) {
 		// File: Open the file and call RomDataFactory::create() with the opened file.
 
 		// FIXME: Make T2U8c() unnecessary here.
-		fputs("== ", stderr);
-		fprintf(stderr, C_("rpcli", "Reading file '%s'..."), T2U8c(filename));
-		fputc('\n', stderr);
-		fflush(stderr);
+		os_err << "== " << rp_sprintf(C_("rpcli", "Reading file '%s'..."), T2U8c(filename)) << '\n';
+		os_err.flush();
 
 		shared_ptr<RpFile> file = std::make_shared<RpFile>(filename, RpFile::FM_OPEN_READ_GZ);
+		bt_open = bench_now_us() - bt;
 		if (!file->isOpen()) {
 			// TODO: Return an error code?
-			fputs("-- ", stderr);
-			fprintf(stderr, C_("rpcli", "Couldn't open file: %s"), strerror(file->lastError()));
-			fputc('\n', stderr);
-			fflush(stderr);
+			os_err << "-- " << rp_sprintf(C_("rpcli", "Couldn't open file: %s"), strerror(file->lastError())) << '\n';
+			os_err.flush();
 			if (json) {
-				printf("{\"error\":\"couldn't open file\",\"code\":%d}\n", file->lastError());
-				fflush(stdout);
+				if (unlikely(json_lines)) {
+					os << rp_sprintf("{\"error\":\"couldn't open file\",\"code\":%d,\"filename\":\"%s\"}\n",
+						file->lastError(), JsonEscape(T2U8c(filename)).c_str());
+				} else {
+					os << rp_sprintf("{\"error\":\"couldn't open file\",\"code\":%d}\n", file->lastError());
+				}
+				os.flush();
 			}
 			return;
 		}
 
-		romData = RomDataFactory::create(file);
+		bench_size = file->size();
+		bt = bench_now_us();
+		romData = RomDataFactory::create(file, cr_attrs);
+		bt_probe = bench_now_us() - bt;
 	} else {
 		// Directory: Call RomDataFactory::create() with the filename.
 
 		// FIXME: Make T2U8c() unnecessary here.
-		fputs("== ", stderr);
-		fprintf(stderr, C_("rpcli", "Reading directory '%s'..."), T2U8c(filename));
-		fputc('\n', stderr);
-		fflush(stderr);
+		os_err << "== " << rp_sprintf(C_("rpcli", "Reading directory '%s'..."), T2U8c(filename)) << '\n';
+		os_err.flush();
 
-		romData = RomDataFactory::create(filename);
+		bt = bench_now_us();
+		romData = RomDataFactory::create(filename, cr_attrs);
+		bt_probe = bench_now_us() - bt;
 	}
 
 	if (romData) {
+		bt = bench_now_us();
 		if (json) {
-			fputs("-- ", stderr);
-			fputs(C_("rpcli", "Outputting JSON data"), stderr);
-			fputc('\n', stderr);
-			fflush(stderr);
-
-			cout << JSONROMOutput(romData.get(), lc, flags) << '\n';
+			os_err << "-- " << C_("rpcli", "Outputting JSON data") << '\n';
+			os_err.flush();
+
+			if (unlikely(json_lines)) {
+				// NDJSON: one minimal JSON object per line.
+				string buf;
+				JSONROMOutput(romData.get(), lc, flags).writeNdjsonLine(buf);
+				os << buf;
+			} else {
+				os << JSONROMOutput(romData.get(), lc, flags) << '\n';
+			}
 		} else {
-			cout << ROMOutput(romData.get(), lc, flags) << '\n';
+			os << ROMOutput(romData.get(), lc, flags) << '\n';
+		}
+		os.flush();
+		bt_output = bench_now_us() - bt;
+		bt = bench_now_us();
+		ExtractImages(romData.get(), extract, os_err);
+		bt_extract = bench_now_us() - bt;
+
+		if (unlikely(verify_enabled)) {
+			DoVerify(romData.get(), os_err);
 		}
-		cout.flush();
-		ExtractImages(romData.get(), extract);
 	} else {
-		fputs("-- ", stderr);
-		fputs(C_("rpcli", "ROM is not supported"), stderr);
-		fputc('\n', stderr);
-		fflush(stderr);
+		os_err << "-- " << C_("rpcli", "ROM is not supported") << '\n';
+		os_err.flush();
 
 		if (json) {
-			fputs("{\"error\":\"rom is not supported\"}\n", stdout);
-			fflush(stdout);
+			if (unlikely(json_lines)) {
+				os << rp_sprintf("{\"error\":\"rom is not supported\",\"filename\":\"%s\"}\n",
+					JsonEscape(T2U8c(filename)).c_str());
+			} else {
+				os << "{\"error\":\"rom is not supported\"}\n";
+			}
+			os.flush();
 		}
+
+		// If image extraction was requested and the source file is
+		// itself a PNG (e.g. a cached cover), copy it directly
+		// instead of failing. No decode/re-encode is needed.
+		if (!extract.empty() && SourceFileIsPng(filename)) {
+			for (const ExtractParam &p : extract) {
+				if (!p.filename || p.mipmapLevel >= 0)
+					continue;
+				os_err << "-- " <<
+					// tr: %s == output filename
+					rp_sprintf(C_("rpcli", "Copying source PNG image into '%s'"), T2U8c(p.filename)) << '\n';
+				os_err.flush();
+				const int errcode = CopyFileRaw(filename, p.filename);
+				if (errcode != 0) {
+					// tr: %1$s == filename, %2%s == error message
+					os_err << "   " <<
+						rp_sprintf_p(C_("rpcli", "Couldn't create file '%1$s': %2$s"),
+							T2U8c(p.filename), strerror(-errcode)) << '\n';
+				} else {
+					os_err << "   " << C_("rpcli", "Done") << '\n';
+				}
+				os_err.flush();
+			}
+		}
+	}
+
+	if (unlikely(bench_enabled)) {
+		// NOTE: Header parsing happens in the subclass constructor
+		// (probe stage), and lazy field/metadata loads happen during
+		// output, so those stages include more than their names imply.
+		// NOTE 2: Not localized; this is diagnostic output for
+		// performance reports.
+		const uint64_t bt_total = bt_open + bt_probe + bt_output + bt_extract;
+		os_err << "-- " << rp_sprintf(
+			"bench: class=%s, size=%llu, open=%0.3fms, probe=%0.3fms, output=%0.3fms, extract=%0.3fms, total=%0.3fms",
+			(romData ? romData->className() : "(none)"),
+			static_cast<unsigned long long>(bench_size),
+			bt_open / 1000.0, bt_probe / 1000.0, bt_output / 1000.0,
+			bt_extract / 1000.0, bt_total / 1000.0) << '\n';
+		os_err.flush();
+
+		bench_totals.us_open += bt_open;
+		bench_totals.us_probe += bt_probe;
+		bench_totals.us_output += bt_output;
+		bench_totals.us_extract += bt_extract;
+		bench_totals.bytes += static_cast<uint64_t>(bench_size);
+		bench_totals.files++;
+	}
+}
+
+/** Parallel file processing (-P) **/
+
+struct ParallelJob {
+	const TCHAR *filename;	// points into argv[]
+	vector<ExtractParam> extract;
+	uint32_t lc;
+	unsigned int flags;
+
+	// Each worker owns its job's output buffers. The main thread
+	// prints them in input order as jobs complete.
+	ostringstream ss_out;
+	ostringstream ss_err;
+
+	ParallelJob(const TCHAR *filename, vector<ExtractParam> &&extract, uint32_t lc, unsigned int flags)
+		: filename(filename)
+		, extract(std::move(extract))
+		, lc(lc)
+		, flags(flags)
+	{
+		// NOTE: cout/cerr were constructed with the classic locale,
+		// so the buffers need to match. Otherwise, numeric grouping
+		// from the user's locale would break the JSON output.
+		ss_out.imbue(locale::classic());
+		ss_err.imbue(locale::classic());
+	}
+};
+
+/**
+ * Process queued files using a worker pool.
+ * Results are printed in input order as jobs complete.
+ * @param jobs Queued jobs
+ * @param json Is program running in json mode?
+ * @param nthreads Number of worker threads (0 for the number of CPU cores)
+ * @param first True if no file output has been printed yet (for JSON separators)
+ */
+static void RunParallelJobs(vector<unique_ptr<ParallelJob> > &jobs, bool json, unsigned int nthreads, bool first)
+{
+	std::atomic<unsigned int> next_job(0);
+	std::mutex done_mutex;
+	std::condition_variable done_cv;
+	vector<uint8_t> done(jobs.size(), 0);
+
+	if (nthreads == 0) {
+		nthreads = std::thread::hardware_concurrency();
+		if (nthreads == 0) {
+			// Couldn't determine the number of CPU cores.
+			nthreads = 1;
+		}
+	}
+	nthreads = std::min(nthreads, static_cast<unsigned int>(jobs.size()));
+
+	vector<std::thread> workers;
+	workers.reserve(nthreads);
+	for (unsigned int t = 0; t < nthreads; t++) {
+		workers.emplace_back([&jobs, &next_job, &done_mutex, &done_cv, &done, json]() {
+			while (true) {
+				const unsigned int i = next_job.fetch_add(1);
+				if (i >= jobs.size())
+					break;
+
+				ParallelJob *const job = jobs[i].get();
+				DoFile(job->filename, json, job->extract, job->lc, job->flags,
+					job->ss_out, job->ss_err);
+
+				std::lock_guard<std::mutex> lock(done_mutex);
+				done[i] = 1;
+				done_cv.notify_all();
+			}
+		});
+	}
+
+	// Print the results in input order as jobs complete.
+	for (size_t i = 0; i < jobs.size(); i++) {
+		{
+			std::unique_lock<std::mutex> lock(done_mutex);
+			done_cv.wait(lock, [&done, i]() { return done[i] != 0; });
+		}
+
+		if (first) {
+			first = false;
+		} else if (json && !json_lines) {
+			cout << ",\n";
+		}
+		cerr << jobs[i]->ss_err.str();
+		cerr.flush();
+		cout << jobs[i]->ss_out.str();
+		cout.flush();
+
+		// Free the job's buffers early.
+		jobs[i].reset();
+	}
+
+	for (std::thread &thr : workers) {
+		thr.join();
+	}
+}
+
+/**
+ * Process a NUL-delimited list of filenames from a file. (--files-from)
+ * Results are streamed out as each filename is read, so e.g.
+ * `find ... -print0 | rpcli --files-from -` runs as a single process.
+ * @param listFilename List filename, or "-" for stdin
+ * @param json Is program running in json mode?
+ * @param lc Language code (0 for default)
+ * @param flags ROMOutput flags (see OutputFlags)
+ * @param first True if no file output has been printed yet (for JSON separators)
+ */
+static void DoFilesFrom(const TCHAR *listFilename, bool json, uint32_t lc, unsigned int flags, bool &first)
+{
+	std::istream *is;
+	std::ifstream ifs;
+	if (!_tcscmp(listFilename, _T("-"))) {
+		// Read the file list from stdin.
+		is = &std::cin;
+	} else {
+		ifs.open(listFilename, std::ios::in | std::ios::binary);
+		if (!ifs.is_open()) {
+			// TODO: Return an error code?
+			fputs("-- ", stderr);
+			fprintf(stderr, C_("rpcli", "Couldn't open file list '%s'"), T2U8c(listFilename));
+			fputc('\n', stderr);
+			fflush(stderr);
+			return;
+		}
+		is = &ifs;
+	}
+
+	// NOTE: No per-file image extraction parameters in list mode.
+	const vector<ExtractParam> extract;
+
+	string path;
+	while (std::getline(*is, path, '\0')) {
+		if (path.empty())
+			continue;
+
+		if (first) {
+			first = false;
+		} else if (json && !json_lines) {
+			cout << ",\n";
+			cout.flush();
+		}
+
+#ifdef _WIN32
+		// Paths in the list are UTF-8.
+		const std::tstring ts_path = U82T_s(path);
+		DoFile(ts_path.c_str(), json, extract, lc, flags);
+#else /* !_WIN32 */
+		DoFile(path.c_str(), json, extract, lc, flags);
+#endif /* _WIN32 */
 	}
 }
 
@@ -480,11 +985,11 @@ static void ShowUsage(void)
 {
 	// TODO: Use argv[0] instead of hard-coding 'rpcli'?
 
-#ifdef ENABLE_DECRYPTION	
-	fputs(C_("rpcli", "Usage: rpcli [-k] [-c] [-p] [-j] [-l lang] [[-xN outfile]... [-mN outfile]... [-a apngoutfile] filename]..."), stderr);
+#ifdef ENABLE_DECRYPTION
+	fputs(C_("rpcli", "Usage: rpcli [-k] [-c] [-p] [-j] [-P[N]] [-l lang] [[-xN outfile]... [-mN outfile]... [-a apngoutfile] filename]..."), stderr);
 	fputc('\n', stderr);
 #else /* !ENABLE_DECRYPTION */
-	fputs(C_("rpcli", "Usage: rpcli [-c] [-p] [-j] [-l lang] [[-xN outfile]... [-mN outfile]... [-a apngoutfile] filename]..."), stderr);
+	fputs(C_("rpcli", "Usage: rpcli [-c] [-p] [-j] [-P[N]] [-l lang] [[-xN outfile]... [-mN outfile]... [-a apngoutfile] filename]..."), stderr);
 	fputc('\n', stderr);
 #endif /* ENABLE_DECRYPTION */
 
@@ -502,6 +1007,7 @@ static void ShowUsage(void)
 		{"  -p:  ", NOP_C_("rpcli", "Print system path information.")},
 		{"  -d:  ", NOP_C_("rpcli", "Skip ListData fields with more than 10 items. [text only]")},
 		{"  -j:  ", NOP_C_("rpcli", "Use JSON output format.")},
+		{"  -P:  ", NOP_C_("rpcli", "Process files in parallel. (-PN: use N worker threads)")},
 		{"  -l:  ", NOP_C_("rpcli", "Retrieve the specified language from the ROM image.")},
 		{"  -xN: ", NOP_C_("rpcli", "Extract image N to outfile in PNG format.")},
 		{"  -mN: ", NOP_C_("rpcli", "Extract mipmap level N to outfile in PNG format.")},
@@ -513,6 +1019,23 @@ static void ShowUsage(void)
 		fputs(pgettext_expr("rpcli", p.desc), stderr);
 		fputc('\n', stderr);
 	}
+
+	// Long options
+	fputs("  --files-from file:\n\t", stderr);
+	fputs(C_("rpcli", "Process a NUL-delimited list of filenames from 'file'. ('-' for stdin)"), stderr);
+	fputc('\n', stderr);
+	fputs("  --fast:\n\t", stderr);
+	fputs(C_("rpcli", "Metadata-only fast path: output the system name and metadata properties only."), stderr);
+	fputc('\n', stderr);
+	fputs("  --bench:\n\t", stderr);
+	fputs(C_("rpcli", "Print per-file and aggregate per-stage timing information."), stderr);
+	fputc('\n', stderr);
+	fputs("  --verify:\n\t", stderr);
+	fputs(C_("rpcli", "Run read-only verification operations, e.g. Wii partition hash verification."), stderr);
+	fputc('\n', stderr);
+	fputs("  --json-lines:\n\t", stderr);
+	fputs(C_("rpcli", "JSON lines (NDJSON) output: one JSON object per file, flushed per file."), stderr);
+	fputc('\n', stderr);
 	fputc('\n', stderr);
 
 #ifdef RP_OS_SCSI_SUPPORTED
@@ -634,17 +1157,22 @@ int RP_C_API _tmain(int argc, TCHAR *argv[])
 			} else if (argv[i][1] == _T('J')) {
 				json = true;
 				flags |= OF_JSON_NoPrettyPrint;
+			} else if (!_tcscmp(argv[i], _T("--json-lines"))) {
+				// NDJSON: one self-contained JSON object per file,
+				// flushed as each file completes. No array wrapper.
+				json = true;
+				json_lines = true;
 			}
 		}
 	}
-	if (json) {
+	if (json && !json_lines) {
 		cout << "[\n";
 		cout.flush();
 	}
 
 #ifdef _WIN32
 	// Initialize GDI+.
-	const ULONG_PTR gdipToken = GdiplusHelper::InitGDIPlus();
+	const ULONG_PTR gdipToken = GdiplusHelper::AcquireGDIPlus();
 	assert(gdipToken != 0);
 	if (gdipToken == 0) {
 		fputs("*** ERROR: GDI+ initialization failed.", stderr);
@@ -662,6 +1190,11 @@ int RP_C_API _tmain(int argc, TCHAR *argv[])
 	uint32_t lc = 0;
 	bool first = true;
 	int ret = 0;
+
+	// Parallel file processing. (-P)
+	bool parallel = false;
+	unsigned int nthreads = 0;	// 0 == number of CPU cores
+	vector<unique_ptr<ParallelJob> > jobs;
 	for (int i = 1; i < argc; i++){
 		if (argv[i][0] == _T('-')){
 			switch (argv[i][1]) {
@@ -759,6 +1292,22 @@ int RP_C_API _tmain(int argc, TCHAR *argv[])
 			case _T('j'): // do nothing
 			case _T('J'): // still do nothing
 				break;
+			case _T('P'): {
+				// Process files in parallel using a worker pool.
+				// An optional number immediately after 'P' specifies
+				// the number of worker threads.
+				// TODO: Switch from _ttol() to _tcstol() and implement better error checking?
+				const long num = (argv[i][2] != _T('\0')) ? _ttol(argv[i] + 2) : 0;
+				if (num < 0 || num > 1024) {
+					fprintf(stderr, C_("rpcli", "Warning: ignoring invalid thread count %ld"), num);
+					fputc('\n', stderr);
+					fflush(stderr);
+					break;
+				}
+				parallel = true;
+				nthreads = static_cast<unsigned int>(num);
+				break;
+			}
 #ifdef RP_OS_SCSI_SUPPORTED
 			case _T('i'):
 				// These commands take precedence over the usual rpcli functionality.
@@ -789,6 +1338,40 @@ int RP_C_API _tmain(int argc, TCHAR *argv[])
 				}
 				break;
 #endif /* RP_OS_SCSI_SUPPORTED */
+			case _T('-'):
+				// Long option.
+				if (!_tcscmp(argv[i], _T("--files-from"))) {
+					// Process a NUL-delimited list of filenames
+					// from the specified file. ('-' for stdin)
+					if (i + 1 >= argc) {
+						fputs(C_("rpcli", "Warning: no filename specified for '--files-from'"), stderr);
+						fputc('\n', stderr);
+						fflush(stderr);
+						break;
+					}
+					DoFilesFrom(argv[++i], json, lc, flags, first);
+					break;
+				} else if (!_tcscmp(argv[i], _T("--fast"))) {
+					// Metadata-only fast path: output the system
+					// name and metadata properties only.
+					flags |= LibRpBase::OF_MetadataOnly;
+					break;
+				} else if (!_tcscmp(argv[i], _T("--bench"))) {
+					// Print per-file and aggregate per-stage
+					// timing information.
+					bench_enabled = true;
+					break;
+				} else if (!_tcscmp(argv[i], _T("--verify"))) {
+					// Run read-only verification ROM operations,
+					// e.g. Wii partition hash verification.
+					verify_enabled = true;
+					break;
+				} else if (!_tcscmp(argv[i], _T("--json-lines"))) {
+					// NDJSON mode. (already handled in the pre-scan)
+					break;
+				}
+				// Unknown long option.
+				// fall-through
 			default:
 				// FIXME: Unicode character on Windows.
 				fprintf(stderr, C_("rpcli", "Warning: skipping unknown switch '%c'"), argv[i][1]);
@@ -797,9 +1380,22 @@ int RP_C_API _tmain(int argc, TCHAR *argv[])
 				break;
 			}
 		} else {
+			if (parallel
+#ifdef RP_OS_SCSI_SUPPORTED
+			    // NOTE: Device inquiries are still processed sequentially.
+			    && !inq_scsi && !inq_ata && !inq_ata_packet
+#endif /* RP_OS_SCSI_SUPPORTED */
+			   )
+			{
+				// Queue the file for the worker pool.
+				jobs.emplace_back(new ParallelJob(argv[i], std::move(extract), lc, flags));
+				extract.clear();
+				continue;
+			}
+
 			if (first) {
 				first = false;
-			} else if (json) {
+			} else if (json && !json_lines) {
 				cout << ",\n";
 				cout.flush();
 			}
@@ -830,14 +1426,25 @@ int RP_C_API _tmain(int argc, TCHAR *argv[])
 			extract.clear();
 		}
 	}
-	if (json) {
+	if (!jobs.empty()) {
+		// Process the queued files using the worker pool.
+		RunParallelJobs(jobs, json, nthreads, first);
+	}
+
+	if (json && !json_lines) {
 		cout << "]\n";
 		cout.flush();
 	}
 
+	if (unlikely(bench_enabled)) {
+		// Print the aggregate --bench totals.
+		PrintBenchTotals();
+	}
+
 #ifdef _WIN32
 	// Shut down GDI+.
-	GdiplusHelper::ShutdownGDIPlus(gdipToken);
+	GdiplusHelper::ReleaseGDIPlus();
+	GdiplusHelper::ShutdownSharedGDIPlus();
 #endif /* _WIN32 */
 
 	return ret;
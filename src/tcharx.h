@@ -40,6 +40,7 @@ typedef char TCHAR;
 #define _istalpha(c) isalpha(c)
 
 // stdio.h
+#define _fgetts(s, n, stream) fgets((s), (n), (stream))
 #define _fputts(s, stream) fputs((s), (stream))
 #define _fputtc(c, stream) fputc((c), (stream))
 
@@ -6,6 +6,15 @@
 
 // Reference: https://hackingcpp.com/cpp/recipe/uninitialized_numeric_array.html
 
+// C includes (C++ namespace)
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+// C++ includes
+#include <new>
+#include <type_traits>
 #include <vector>
 
 namespace rp {
@@ -39,4 +48,210 @@ public:
 template<typename T>
 using uvector = std::vector<T, default_init_allocator<T> >;
 
+/**
+ * Small-buffer variant of uvector.
+ *
+ * The first N elements are stored inline, so typical header buffers
+ * and read scratch space (usually ≤64 bytes) never touch the heap.
+ * Larger buffers spill to malloc() and grow with realloc(), which
+ * lets the allocator extend the block in place instead of always
+ * doing an allocate+copy cycle.
+ *
+ * Like uvector, elements are NOT initialized on resize().
+ * Restricted to trivially-copyable types for that reason.
+ *
+ * Only the subset of std::vector's interface used by this codebase
+ * is implemented.
+ */
+template<typename T, size_t N = (64 / sizeof(T) > 0 ? 64 / sizeof(T) : 1)>
+class suvector
+{
+	static_assert(std::is_trivially_copyable<T>::value,
+		"suvector only supports trivially-copyable types.");
+	static_assert(N > 0, "suvector requires at least one inline element.");
+
+public:
+	typedef T value_type;
+	typedef size_t size_type;
+	typedef T* iterator;
+	typedef const T* const_iterator;
+	typedef T& reference;
+	typedef const T& const_reference;
+
+	suvector()
+		: m_data(inlineData())
+		, m_size(0)
+		, m_capacity(N)
+	{}
+
+	explicit suvector(size_type n)
+		: m_data(inlineData())
+		, m_size(0)
+		, m_capacity(N)
+	{
+		resize(n);
+	}
+
+	~suvector()
+	{
+		if (m_data != inlineData()) {
+			free(m_data);
+		}
+	}
+
+	suvector(const suvector &other)
+		: m_data(inlineData())
+		, m_size(0)
+		, m_capacity(N)
+	{
+		resize(other.m_size);
+		memcpy(m_data, other.m_data, other.m_size * sizeof(T));
+	}
+
+	suvector &operator=(const suvector &other)
+	{
+		if (this != &other) {
+			resize(other.m_size);
+			memcpy(m_data, other.m_data, other.m_size * sizeof(T));
+		}
+		return *this;
+	}
+
+	suvector(suvector &&other) noexcept
+		: m_data(inlineData())
+		, m_size(other.m_size)
+		, m_capacity(N)
+	{
+		if (other.m_data != other.inlineData()) {
+			// Steal the heap buffer.
+			m_data = other.m_data;
+			m_capacity = other.m_capacity;
+		} else {
+			// Inline storage can't be stolen; copy it.
+			memcpy(m_data, other.m_data, other.m_size * sizeof(T));
+		}
+		other.m_data = other.inlineData();
+		other.m_size = 0;
+		other.m_capacity = N;
+	}
+
+	suvector &operator=(suvector &&other) noexcept
+	{
+		if (this != &other) {
+			if (m_data != inlineData()) {
+				free(m_data);
+			}
+			m_data = inlineData();
+			m_size = other.m_size;
+			m_capacity = N;
+			if (other.m_data != other.inlineData()) {
+				m_data = other.m_data;
+				m_capacity = other.m_capacity;
+			} else {
+				memcpy(m_data, other.m_data, other.m_size * sizeof(T));
+			}
+			other.m_data = other.inlineData();
+			other.m_size = 0;
+			other.m_capacity = N;
+		}
+		return *this;
+	}
+
+	/**
+	 * Reserve space for at least n elements.
+	 * Existing elements are preserved.
+	 * @param n Minimum capacity, in elements.
+	 */
+	void reserve(size_type n)
+	{
+		if (n <= m_capacity)
+			return;
+
+		// Grow geometrically to keep push_back() amortized O(1).
+		size_type new_cap = m_capacity + (m_capacity / 2);
+		if (new_cap < n) {
+			new_cap = n;
+		}
+
+		T *new_data;
+		if (m_data == inlineData()) {
+			// First heap allocation: copy out of the inline buffer.
+			new_data = static_cast<T*>(malloc(new_cap * sizeof(T)));
+			if (new_data) {
+				memcpy(new_data, m_data, m_size * sizeof(T));
+			}
+		} else {
+			// Already on the heap: realloc() may extend in place.
+			new_data = static_cast<T*>(realloc(m_data, new_cap * sizeof(T)));
+		}
+		if (!new_data) {
+			// Match std::vector's behavior on allocation failure.
+			throw std::bad_alloc();
+		}
+		m_data = new_data;
+		m_capacity = new_cap;
+	}
+
+	/**
+	 * Resize the vector.
+	 * NOTE: New elements are NOT initialized.
+	 * @param n New size, in elements.
+	 */
+	void resize(size_type n)
+	{
+		reserve(n);
+		m_size = n;
+	}
+
+	void push_back(const T &val)
+	{
+		reserve(m_size + 1);
+		m_data[m_size++] = val;
+	}
+
+	void clear(void)
+	{
+		// NOTE: Heap storage is not released, same as std::vector.
+		m_size = 0;
+	}
+
+	size_type size(void) const { return m_size; }
+	size_type capacity(void) const { return m_capacity; }
+	bool empty(void) const { return (m_size == 0); }
+
+	T *data(void) { return m_data; }
+	const T *data(void) const { return m_data; }
+
+	iterator begin(void) { return m_data; }
+	const_iterator begin(void) const { return m_data; }
+	iterator end(void) { return m_data + m_size; }
+	const_iterator end(void) const { return m_data + m_size; }
+
+	reference operator[](size_type i)
+	{
+		assert(i < m_size);
+		return m_data[i];
+	}
+	const_reference operator[](size_type i) const
+	{
+		assert(i < m_size);
+		return m_data[i];
+	}
+
+private:
+	T *inlineData(void)
+	{
+		return reinterpret_cast<T*>(m_inline);
+	}
+	const T *inlineData(void) const
+	{
+		return reinterpret_cast<const T*>(m_inline);
+	}
+
+	T *m_data;
+	size_type m_size;
+	size_type m_capacity;	// in elements; always >= N
+	alignas(T) uint8_t m_inline[N * sizeof(T)];
+};
+
 }
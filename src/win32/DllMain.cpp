@@ -43,9 +43,6 @@
 #include "librptexture/img/RpGdiplusBackend.hpp"
 using namespace LibRpTexture;
 
-// GDI+ token.
-static ULONG_PTR gdipToken = 0;
-
 #include "libi18n/config.libi18n.h"
 #if defined(_MSC_VER) && defined(ENABLE_NLS)
 // MSVC: Exception handling for /DELAYLOAD.
@@ -112,11 +109,8 @@ STDAPI DllCanUnloadNow(void)
 	// Unload modules needed for High-DPI, if necessary.
 	rp_DpiUnloadModules();
 
-	// Shut down GDI+ if it was initialized.
-	if (gdipToken != 0) {
-		GdiplusHelper::ShutdownGDIPlus(gdipToken);
-		gdipToken = 0;
-	}
+	// Shut down the shared GDI+ session if it was started.
+	GdiplusHelper::ShutdownSharedGDIPlus();
 
 	// Not in use.
 	return S_OK;
@@ -148,14 +142,10 @@ _Check_return_ STDAPI DllGetClassObject(_In_ REFCLSID rclsid, _In_ REFIID riid,
 	}
 #endif /* defined(_MSC_VER) && defined(ENABLE_NLS) */
 
-	// Initialize GDI+.
-	if (gdipToken == 0) {
-		gdipToken = GdiplusHelper::InitGDIPlus();
-		assert(gdipToken != 0);
-		if (gdipToken == 0) {
-			return E_OUTOFMEMORY;
-		}
-	}
+	// NOTE: GDI+ is no longer started here. RpGdiplusBackend
+	// acquires a reference to the shared GDI+ session when the
+	// first rp_image is created, so processes that never convert
+	// an image don't pay for GdiplusStartup().
 
 	// Register RpGdiplusBackend and AchWin32.
 	rp_image::setBackendCreatorFn(RpGdiplusBackend::creator_fn);
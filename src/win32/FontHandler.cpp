@@ -14,8 +14,10 @@
 #include "libwin32common/w32err.hpp"
 
 // C++ STL classes
+#include <mutex>
 using std::array;
 using std::tstring;
+using std::unordered_map;
 using std::unordered_set;
 using std::vector;
 
@@ -91,6 +93,122 @@ public:
 	int updateFonts(bool force = false);
 };
 
+/** Process-wide font cache **/
+
+// Property sheets in Explorer's long-lived process repeatedly create
+// identical bold and monospaced fonts. Cache created HFONTs process-wide,
+// keyed by the LOGFONT fields that affect the result (face, height,
+// weight, italic, quality), and refcount them so a font is only deleted
+// when no dialog is using it. lfHeight is derived from the dialog font,
+// so per-monitor DPI differences produce distinct keys.
+struct CachedFont {
+	HFONT hFont;
+	int ref_cnt;
+};
+static std::mutex font_cache_mutex;
+static unordered_map<tstring, CachedFont> font_cache;
+
+// Cached monospaced font face name.
+// EnumFontFamiliesEx() enumerates every installed font, so only do it once.
+// NOTE: Cached even if no suitable font was found. (empty string)
+static tstring mono_face_cache;
+static bool mono_face_cached = false;
+
+/**
+ * Build a font cache key from a LOGFONT.
+ * @param lf LOGFONT
+ * @return Cache key.
+ */
+static tstring font_cache_key(const LOGFONT &lf)
+{
+	TCHAR buf[64];
+	_sntprintf(buf, _countof(buf), _T(":%ld:%ld:%u:%u"),
+		lf.lfHeight, lf.lfWeight, lf.lfItalic, lf.lfQuality);
+	tstring key(lf.lfFaceName);
+	key += buf;
+	return key;
+}
+
+/**
+ * Get a font from the process-wide font cache, creating it if necessary.
+ * Call font_cache_release() when done with the font.
+ * @param lf LOGFONT describing the font.
+ * @return HFONT, or nullptr on error.
+ */
+static HFONT font_cache_acquire(const LOGFONT &lf)
+{
+	const tstring key = font_cache_key(lf);
+
+	std::lock_guard<std::mutex> lock(font_cache_mutex);
+	auto iter = font_cache.find(key);
+	if (iter != font_cache.end()) {
+		// Font is already cached.
+		iter->second.ref_cnt++;
+		return iter->second.hFont;
+	}
+
+	// Create the font and add it to the cache.
+	HFONT hFont = CreateFontIndirect(&lf);
+	if (!hFont) {
+		// Unable to create the font.
+		return nullptr;
+	}
+	font_cache.emplace(key, CachedFont{hFont, 1});
+	return hFont;
+}
+
+/**
+ * Release a font obtained from font_cache_acquire().
+ *
+ * NOTE: Unreferenced fonts are kept in the cache so the next
+ * property sheet can reuse them; they're deleted by
+ * font_cache_invalidate() on theme/DPI changes.
+ *
+ * @param hFont HFONT to release.
+ */
+static void font_cache_release(HFONT hFont)
+{
+	if (!hFont) {
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(font_cache_mutex);
+	for (auto &p : font_cache) {
+		if (p.second.hFont == hFont) {
+			assert(p.second.ref_cnt > 0);
+			if (p.second.ref_cnt > 0) {
+				p.second.ref_cnt--;
+			}
+			return;
+		}
+	}
+	assert(!"HFONT was not found in the font cache.");
+}
+
+/**
+ * Invalidate the process-wide font cache.
+ * Deletes all unreferenced fonts and clears the cached monospaced
+ * font face name. Referenced fonts are kept; their keys still
+ * describe them correctly, so they remain reusable.
+ *
+ * This should be called on theme or DPI changes.
+ */
+static void font_cache_invalidate(void)
+{
+	std::lock_guard<std::mutex> lock(font_cache_mutex);
+	for (auto iter = font_cache.begin(); iter != font_cache.end(); ) {
+		if (iter->second.ref_cnt == 0) {
+			DeleteFont(iter->second.hFont);
+			iter = font_cache.erase(iter);
+		} else {
+			++iter;
+		}
+	}
+
+	mono_face_cache.clear();
+	mono_face_cached = false;
+}
+
 /** FontHandlerPrivate **/
 
 FontHandlerPrivate::FontHandlerPrivate(HWND hWnd)
@@ -103,10 +221,10 @@ FontHandlerPrivate::FontHandlerPrivate(HWND hWnd)
 FontHandlerPrivate::~FontHandlerPrivate()
 {
 	if (hFontBold) {
-		DeleteFont(hFontBold);
+		font_cache_release(hFontBold);
 	}
 	if (hFontMono) {
-		DeleteFont(hFontMono);
+		font_cache_release(hFontMono);
 	}
 }
 
@@ -147,6 +265,20 @@ int CALLBACK FontHandlerPrivate::MonospacedFontEnumProc(
  */
 int FontHandlerPrivate::findMonospacedFont(LOGFONT *plfFontMono)
 {
+	// Check if the face name was already determined.
+	{
+		std::lock_guard<std::mutex> lock(font_cache_mutex);
+		if (mono_face_cached) {
+			if (mono_face_cache.empty()) {
+				// No monospaced font was found previously.
+				return -ENOENT;
+			}
+			_tcscpy_s(plfFontMono->lfFaceName, _countof(plfFontMono->lfFaceName),
+				mono_face_cache.c_str());
+			return 0;
+		}
+	}
+
 	// Enumerate all monospaced fonts.
 	// Reference: http://www.catch22.net/tuts/fixed-width-font-enumeration
 	unordered_set<tstring> enum_fonts;
@@ -206,6 +338,15 @@ int FontHandlerPrivate::findMonospacedFont(LOGFONT *plfFontMono)
 		}
 	}
 
+	// Cache the face name so the font enumeration
+	// doesn't have to be repeated for every dialog.
+	// NOTE: Negative results are cached, too.
+	{
+		std::lock_guard<std::mutex> lock(font_cache_mutex);
+		mono_face_cache = (mono_font ? mono_font : _T(""));
+		mono_face_cached = true;
+	}
+
 	if (!mono_font) {
 		// No monospaced font found.
 		return -ENOENT;
@@ -243,9 +384,9 @@ bool FontHandlerPrivate::isClearTypeEnabled(void)
 int FontHandlerPrivate::initBoldFont(void)
 {
 	if (!hWnd) {
-		// No window. Delete the font.
+		// No window. Release the font.
 		if (hFontBold) {
-			DeleteFont(hFontBold);
+			font_cache_release(hFontBold);
 			hFontBold = nullptr;
 		}
 		return -EBADF;
@@ -267,19 +408,19 @@ int FontHandlerPrivate::initBoldFont(void)
 		return -EIO;
 	}
 
-	// Adjust the font weight and create the new font.
+	// Adjust the font weight and get the new font.
 	lfFontBold.lfWeight = FW_BOLD;
-	HFONT hFontBoldNew = CreateFontIndirect(&lfFontBold);
+	HFONT hFontBoldNew = font_cache_acquire(lfFontBold);
 	if (!hFontBoldNew) {
 		// Unable to create the new font.
 		return -w32err_to_posix(GetLastError());
 	}
 
-	// Delete the old font and save the new one.
+	// Release the old font and save the new one.
 	HFONT hFontBoldOld = hFontBold;
 	hFontBold = hFontBoldNew;
 	if (hFontBoldOld) {
-		DeleteFont(hFontBoldOld);
+		font_cache_release(hFontBoldOld);
 	}
 
 	// Font created.
@@ -293,9 +434,9 @@ int FontHandlerPrivate::initBoldFont(void)
 int FontHandlerPrivate::initMonospacedFont(void)
 {
 	if (!hWnd) {
-		// No window. Delete the font.
+		// No window. Release the font.
 		if (hFontMono) {
-			DeleteFont(hFontMono);
+			font_cache_release(hFontMono);
 			hFontMono = nullptr;
 		}
 		return -EBADF;
@@ -322,12 +463,12 @@ int FontHandlerPrivate::initMonospacedFont(void)
 		return -ENOENT;
 	}
 
-	// Create the monospaced font.
+	// Get the monospaced font.
 	// If ClearType is enabled, use DEFAULT_QUALITY;
 	// otherwise, use NONANTIALIASED_QUALITY.
 	const bool bIsClearType = isClearTypeEnabled();
 	lfFontMono.lfQuality = (bIsClearType ? DEFAULT_QUALITY : NONANTIALIASED_QUALITY);
-	HFONT hFontMonoNew = CreateFontIndirect(&lfFontMono);
+	HFONT hFontMonoNew = font_cache_acquire(lfFontMono);
 	if (!hFontMonoNew) {
 		// Unable to create the new font.
 		return -w32err_to_posix(GetLastError());
@@ -338,11 +479,11 @@ int FontHandlerPrivate::initMonospacedFont(void)
 		SetWindowFont(hWnd, hFontMonoNew, false);
 	}
 
-	// Delete the old font and save the new one.
+	// Release the old font and save the new one.
 	HFONT hFontMonoOld = hFontMono;
 	hFontMono = hFontMonoNew;
 	if (hFontMonoOld) {
-		DeleteFont(hFontMonoOld);
+		font_cache_release(hFontMonoOld);
 	}
 
 	// Font created.
@@ -357,13 +498,13 @@ int FontHandlerPrivate::initMonospacedFont(void)
 int FontHandlerPrivate::updateFonts(bool force)
 {
 	if (!hWnd) {
-		// No window. Delete the fonts.
+		// No window. Release the fonts.
 		if (hFontBold) {
-			DeleteFont(hFontBold);
+			font_cache_release(hFontBold);
 			hFontBold = nullptr;
 		}
 		if (hFontMono) {
-			DeleteFont(hFontMono);
+			font_cache_release(hFontMono);
 			hFontMono = nullptr;
 		}
 		return -EBADF;
@@ -377,6 +518,11 @@ int FontHandlerPrivate::updateFonts(bool force)
 		return 0;
 	}
 
+	// Theme or DPI change: drop any cached fonts that are
+	// no longer referenced, and re-enumerate the monospaced
+	// font face in initMonospacedFont().
+	font_cache_invalidate();
+
 	// Update fonts if they were previously created.
 	if (hFontBold) {
 		initBoldFont();
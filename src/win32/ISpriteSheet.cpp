@@ -23,7 +23,17 @@ using LibRpTexture::rp_image_ptr;
 #include "file/RpFile_windres.hpp"
 
 // C++ STL classes
+#include <mutex>
+#include <unordered_map>
 using std::shared_ptr;
+using std::string;
+
+// Process-wide cache of decoded sprite sheets, keyed by sheet parameters.
+// Sprite sheet objects are usually short-lived, so this caches the decoded
+// sheet for the lifetime of the process instead of the object.
+// rp_image is reference-counted, so all instances share the same pixel data.
+static std::mutex map_imgCache_mutex;
+static std::unordered_map<string, rp_image_ptr> map_imgCache;
 
 /**
  * Sprite sheet loader
@@ -130,6 +140,20 @@ HBITMAP ISpriteSheet::getIcon(int col, int row, bool gray, UINT dpi) const
 	rp_image_ptr &imgSpriteSheet = gray
 		? const_cast<ISpriteSheet*>(this)->m_imgGray
 		: const_cast<ISpriteSheet*>(this)->m_img;
+	if (!imgSpriteSheet) {
+		// Check the process-wide cache first.
+		// NOTE: getResourceID() is deterministic from these parameters,
+		// so the parameters themselves are used as the cache key.
+		char cache_key[32];
+		snprintf(cache_key, sizeof(cache_key), "%dx%d-%d-%d",
+			m_width, m_height, gray, m_flipH);
+		std::lock_guard<std::mutex> lock(map_imgCache_mutex);
+		auto iter = map_imgCache.find(cache_key);
+		if (iter != map_imgCache.end()) {
+			imgSpriteSheet = iter->second;
+		}
+	}
+
 	if (!imgSpriteSheet) {
 		// Load the sprite sheet.
 		LPCTSTR resourceID = getResourceID(m_width, m_height, gray);
@@ -185,6 +209,13 @@ HBITMAP ISpriteSheet::getIcon(int col, int row, bool gray, UINT dpi) const
 				imgSpriteSheet = flipimg;
 			}
 		}
+
+		// Cache the decoded sprite sheet.
+		char cache_key[32];
+		snprintf(cache_key, sizeof(cache_key), "%dx%d-%d-%d",
+			m_width, m_height, gray, m_flipH);
+		std::lock_guard<std::mutex> lock(map_imgCache_mutex);
+		map_imgCache.emplace(cache_key, imgSpriteSheet);
 	}
 
 	if (m_flipH) {
@@ -17,8 +17,11 @@ using namespace LibRpFile;
 using LibWin32UI::RegKey;
 
 // C++ STL classes.
+#include <mutex>
+#include <unordered_map>
 using std::tstring;
 using std::unique_ptr;
+using std::unordered_map;
 
 // COM smart pointer typedefs.
 #ifndef _MSC_VER
@@ -200,22 +203,56 @@ LONG RP_ExtractIcon_Private::DoExtractIconA(_In_ IExtractIconA *pExtractIconA,
 	return ERROR_SUCCESS;
 }
 
+/** Negative-result cache **/
+
+// Whether a usable fallback icon handler exists for a given
+// association key is a property of the registry, not of the file.
+// Cache failures that occur before the file is involved so that a
+// directory full of unsupported files doesn't repeat the registry
+// walk and COM instantiation for every single file.
+static std::mutex fallback_neg_cache_mutex;
+static unordered_map<tstring, LONG> fallback_neg_cache;
+
+/**
+ * Record a file-independent fallback failure for an association key.
+ * @param assoc_name Name of the association key. (extension or ProgID)
+ * @param lResult Win32 error code.
+ * @return lResult (for tail calls)
+ */
+static LONG Fallback_cacheNegative(const tstring &assoc_name, LONG lResult)
+{
+	std::lock_guard<std::mutex> lock(fallback_neg_cache_mutex);
+	fallback_neg_cache.emplace(assoc_name, lResult);
+	return lResult;
+}
+
 /**
  * Fallback icon handler function. (internal)
  * This function reads the RP_Fallback key for fallback data.
  * @param hkey_Assoc	[in] File association key to check
+ * @param assoc_name	[in] Name of the association key (extension or ProgID; for the negative cache)
  * @param phiconLarge	[out,opt] Large icon
  * @param phiconSmall	[out,opt] Small icon
  * @param nIconSize	[in] Icon sizes (LOWORD == large icon size; HIWORD == small icon size)
  * @return ERROR_SUCCESS on success; Win32 error code on error.
  */
-LONG RP_ExtractIcon_Private::Fallback_int(RegKey &hkey_Assoc,
+LONG RP_ExtractIcon_Private::Fallback_int(RegKey &hkey_Assoc, const tstring &assoc_name,
 	_Outptr_opt_ HICON *phiconLarge, _Outptr_opt_ HICON *phiconSmall, UINT nIconSize)
 {
+	// If this association previously failed before reaching the
+	// file, it will fail again. Don't redo the COM instantiation.
+	{
+		std::lock_guard<std::mutex> lock(fallback_neg_cache_mutex);
+		auto iter = fallback_neg_cache.find(assoc_name);
+		if (iter != fallback_neg_cache.end()) {
+			return iter->second;
+		}
+	}
+
 	// Is RP_Fallback present?
 	RegKey hkey_RP_Fallback(hkey_Assoc, _T("RP_Fallback"), KEY_READ, false);
 	if (!hkey_RP_Fallback.isOpen()) {
-		return hkey_RP_Fallback.lOpenRes();
+		return Fallback_cacheNegative(assoc_name, hkey_RP_Fallback.lOpenRes());
 	}
 
 	// Get the DefaultIcon key.
@@ -223,13 +260,13 @@ LONG RP_ExtractIcon_Private::Fallback_int(RegKey &hkey_Assoc,
 	const tstring defaultIcon = hkey_RP_Fallback.read_expand(_T("DefaultIcon"), &dwType);
 	if (defaultIcon.empty()) {
 		// No default icon.
-		return ERROR_FILE_NOT_FOUND;
+		return Fallback_cacheNegative(assoc_name, ERROR_FILE_NOT_FOUND);
 	} else if (defaultIcon == _T("%1")) {
 		// Forward to the IconHandler.
 		const tstring iconHandler = hkey_RP_Fallback.read(_T("IconHandler"));
 		if (iconHandler.empty()) {
 			// No IconHandler.
-			return ERROR_FILE_NOT_FOUND;
+			return Fallback_cacheNegative(assoc_name, ERROR_FILE_NOT_FOUND);
 		}
 
 		// Parse the CLSID string.
@@ -239,7 +276,7 @@ LONG RP_ExtractIcon_Private::Fallback_int(RegKey &hkey_Assoc,
 		HRESULT hr = CLSIDFromString(iconHandler.c_str(), &clsidIconHandler);
 		if (FAILED(hr)) {
 			// Failed to convert the CLSID from string.
-			return ERROR_FILE_NOT_FOUND;
+			return Fallback_cacheNegative(assoc_name, ERROR_FILE_NOT_FOUND);
 		}
 
 		// Get the class object.
@@ -247,7 +284,7 @@ LONG RP_ExtractIcon_Private::Fallback_int(RegKey &hkey_Assoc,
 		hr = CoGetClassObject(clsidIconHandler, CLSCTX_INPROC_SERVER, nullptr, IID_PPV_ARGS(&pCF));
 		if (FAILED(hr) || !pCF) {
 			// Failed to get the IClassFactory.
-			return ERROR_FILE_NOT_FOUND;
+			return Fallback_cacheNegative(assoc_name, ERROR_FILE_NOT_FOUND);
 		}
 
 		// Try getting the IExtractIconW interface.
@@ -269,7 +306,7 @@ LONG RP_ExtractIcon_Private::Fallback_int(RegKey &hkey_Assoc,
 				return lResult;
 			} else {
 				// Failed to get an IExtractIcon interface from the fallback class.
-				return ERROR_FILE_NOT_FOUND;
+				return Fallback_cacheNegative(assoc_name, ERROR_FILE_NOT_FOUND);
 			}
 		}
 
@@ -317,7 +354,7 @@ LONG RP_ExtractIcon_Private::Fallback(HICON *phiconLarge, HICON *phiconSmall, UI
 		// TODO: Get the correct top-level registry key.
 		RegKey hkcr_ProgID(HKEY_CLASSES_ROOT, progID.c_str(), KEY_READ, false);
 		if (hkcr_ProgID.isOpen()) {
-			LONG lResult = Fallback_int(hkcr_ProgID, phiconLarge, phiconSmall, nIconSize);
+			LONG lResult = Fallback_int(hkcr_ProgID, progID, phiconLarge, phiconSmall, nIconSize);
 			if (lResult == ERROR_SUCCESS) {
 				// ProgID icon extracted.
 				return lResult;
@@ -326,5 +363,5 @@ LONG RP_ExtractIcon_Private::Fallback(HICON *phiconLarge, HICON *phiconSmall, UI
 	}
 
 	// Check the filetype key.
-	return Fallback_int(hkcr_Assoc, phiconLarge, phiconSmall, nIconSize);
+	return Fallback_int(hkcr_Assoc, tstring(wfile_ext), phiconLarge, phiconSmall, nIconSize);
 }
@@ -87,12 +87,13 @@ private:
 	 * Fallback icon handler function. (internal)
 	 * This function reads the RP_Fallback key for fallback data.
 	 * @param hkey_Assoc	[in] File association key to check
+	 * @param assoc_name	[in] Name of the association key (extension or ProgID; for the negative cache)
 	 * @param phiconLarge	[out,opt] Large icon
 	 * @param phiconSmall	[out,opt] Small icon
 	 * @param nIconSize	[in] Icon sizes (LOWORD == large icon size; HIWORD == small icon size)
 	 * @return ERROR_SUCCESS on success; Win32 error code on error.
 	 */
-	LONG Fallback_int(LibWin32UI::RegKey &hkey_Assoc,
+	LONG Fallback_int(LibWin32UI::RegKey &hkey_Assoc, const std::tstring &assoc_name,
 		_Outptr_opt_ HICON *phiconLarge, _Outptr_opt_ HICON *phiconSmall, UINT nIconSize);
 
 public:
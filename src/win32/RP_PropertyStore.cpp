@@ -28,8 +28,11 @@ using namespace LibRomData;
 #include "file/RpFile_IStream.hpp"
 
 // C++ STL classes
+#include <mutex>
 using std::array;
 using std::shared_ptr;
+using std::unique_ptr;
+using std::vector;
 using std::wstring;
 
 // CLSID
@@ -166,6 +169,118 @@ static inline HRESULT InitPropVariantFromInt8(_In_ CHAR iVal, _Out_ PROPVARIANT
 	return S_OK;
 }
 
+/** Property cache **/
+
+// Explorer re-creates the property handler and queries it aggressively:
+// the details pane, column refreshes, and tooltips can each trigger a
+// full IInitializeWithStream::Initialize() for the same file within a
+// few seconds. Cache the converted property values per file, keyed on
+// the stream's (name, size, mtime), so repeat bursts skip RomData
+// creation and metadata extraction entirely.
+namespace {
+
+struct CachedProps {
+	wstring name;		// Stream name from IStream::Stat()
+	ULONGLONG size;		// Stream size
+	FILETIME mtime;		// Stream modification time
+
+	// Converted properties
+	vector<const PROPERTYKEY*> prop_key;
+	vector<PROPVARIANT> prop_val;
+
+	~CachedProps()
+	{
+		// Clear property variants.
+		for (PROPVARIANT &pv : prop_val) {
+			PropVariantClear(&pv);
+		}
+	}
+};
+
+// Most recently used entries are at the end of the vector.
+static constexpr size_t PROP_CACHE_MAX_ENTRIES = 16U;
+static vector<unique_ptr<CachedProps> > prop_cache;
+static std::mutex prop_cache_mutex;
+
+/**
+ * Look up cached property values for a stream.
+ * @param name	[in] Stream name
+ * @param size	[in] Stream size
+ * @param mtime	[in] Stream modification time
+ * @param d	[out] RP_PropertyStore_Private to fill on a cache hit
+ * @return True if a matching cache entry was found.
+ */
+static bool prop_cache_lookup(const wstring &name, ULONGLONG size, const FILETIME &mtime,
+	RP_PropertyStore_Private *d)
+{
+	std::lock_guard<std::mutex> lock(prop_cache_mutex);
+	for (auto iter = prop_cache.begin(); iter != prop_cache.end(); ++iter) {
+		CachedProps *const entry = iter->get();
+		if (entry->name != name || entry->size != size ||
+		    CompareFileTime(&entry->mtime, &mtime) != 0)
+		{
+			continue;
+		}
+
+		// Found a match. Copy the properties.
+		d->prop_key = entry->prop_key;
+		d->prop_val.reserve(entry->prop_val.size());
+		for (const PROPVARIANT &pv : entry->prop_val) {
+			PROPVARIANT prop_var;
+			PropVariantInit(&prop_var);
+			PropVariantCopy(&prop_var, &pv);
+			d->prop_val.emplace_back(prop_var);
+		}
+
+		// Move the entry to the end. (most recently used)
+		unique_ptr<CachedProps> tmp = std::move(*iter);
+		prop_cache.erase(iter);
+		prop_cache.emplace_back(std::move(tmp));
+		return true;
+	}
+	return false;
+}
+
+/**
+ * Store property values for a stream in the cache.
+ * @param name	[in] Stream name
+ * @param size	[in] Stream size
+ * @param mtime	[in] Stream modification time
+ * @param d	[in] RP_PropertyStore_Private with the converted properties
+ */
+static void prop_cache_store(const wstring &name, ULONGLONG size, const FILETIME &mtime,
+	const RP_PropertyStore_Private *d)
+{
+	unique_ptr<CachedProps> entry(new CachedProps);
+	entry->name = name;
+	entry->size = size;
+	entry->mtime = mtime;
+	entry->prop_key = d->prop_key;
+	entry->prop_val.reserve(d->prop_val.size());
+	for (const PROPVARIANT &pv : d->prop_val) {
+		PROPVARIANT prop_var;
+		PropVariantInit(&prop_var);
+		PropVariantCopy(&prop_var, &pv);
+		entry->prop_val.emplace_back(prop_var);
+	}
+
+	std::lock_guard<std::mutex> lock(prop_cache_mutex);
+	// Remove any stale entry for the same file.
+	for (auto iter = prop_cache.begin(); iter != prop_cache.end(); ++iter) {
+		if ((*iter)->name == name) {
+			prop_cache.erase(iter);
+			break;
+		}
+	}
+	if (prop_cache.size() >= PROP_CACHE_MAX_ENTRIES) {
+		// Evict the least recently used entry.
+		prop_cache.erase(prop_cache.begin());
+	}
+	prop_cache.emplace_back(std::move(entry));
+}
+
+}
+
 RP_PropertyStore_Private::RP_PropertyStore_Private()
 	: file(nullptr)
 	, pstream(nullptr)
@@ -220,6 +335,30 @@ IFACEMETHODIMP RP_PropertyStore::Initialize(_In_ IStream *pstream, DWORD grfMode
 	// Ignoring grfMode for now. (always read-only)
 	RP_UNUSED(grfMode);
 
+	RP_D(RP_PropertyStore);
+
+	// Check the property cache first.
+	// If the stream can be identified by name/size/mtime and we've
+	// processed the same file recently, we can skip RomData creation
+	// and metadata extraction entirely.
+	STATSTG statstg;
+	wstring statName;
+	bool canCache = false;
+	if (pstream->Stat(&statstg, STATFLAG_DEFAULT) == S_OK) {
+		if (statstg.pwcsName) {
+			statName.assign(statstg.pwcsName);
+			CoTaskMemFree(statstg.pwcsName);
+			canCache = !statName.empty();
+		}
+		if (canCache && prop_cache_lookup(statName, statstg.cbSize.QuadPart, statstg.mtime, d)) {
+			// Cache hit. The properties have been copied into
+			// d->prop_key / d->prop_val.
+			d->pstream = pstream;
+			d->grfMode = grfMode;
+			return S_OK;
+		}
+	}
+
 	// Create an IRpFile wrapper for the IStream.
 	shared_ptr<RpFile_IStream> file = std::make_shared<RpFile_IStream>(pstream, true);
 	if (file->lastError() != 0) {
@@ -231,7 +370,6 @@ IFACEMETHODIMP RP_PropertyStore::Initialize(_In_ IStream *pstream, DWORD grfMode
 	// shared_ptr<> will automatically unreference the old
 	// file if one is set.
 	// TODO: Use shared_ptr::swap<> instead? (same for elsewhere...)
-	RP_D(RP_PropertyStore);
 	d->file = file;
 
 	// Save the IStream and grfMode.
@@ -250,6 +388,10 @@ IFACEMETHODIMP RP_PropertyStore::Initialize(_In_ IStream *pstream, DWORD grfMode
 	const RomMetaData *metaData = d->romData->metaData();
 	if (!metaData || metaData->empty()) {
 		// No metadata properties.
+		// Cache the empty result so repeat queries don't reparse.
+		if (canCache) {
+			prop_cache_store(statName, statstg.cbSize.QuadPart, statstg.mtime, d);
+		}
 		return S_OK;
 	}
 
@@ -468,6 +610,11 @@ IFACEMETHODIMP RP_PropertyStore::Initialize(_In_ IStream *pstream, DWORD grfMode
 		d->prop_val.emplace_back(prop_var);
 	}
 
+	// Save the converted properties in the cache.
+	if (canCache) {
+		prop_cache_store(statName, statstg.cbSize.QuadPart, statstg.mtime, d);
+	}
+
 	return S_OK;
 }
 
@@ -25,6 +25,9 @@
 #include "MessageWidget.hpp"
 #include "OptionsMenuButton.hpp"
 
+// MSVCRT-specific [for _beginthreadex()]
+#include <process.h>
+
 // libwin32ui
 #include "libwin32ui/AutoGetDC.hpp"
 using LibWin32UI::AutoGetDC_font;
@@ -72,6 +75,8 @@ RP_ShellPropSheetExt_Private::RP_ShellPropSheetExt_Private(RP_ShellPropSheetExt
 	: q_ptr(q)
 	, hDlgSheet(nullptr)
 	, tfilename(tfilename)
+	, hLoadThread(nullptr)
+	, lblLoading(nullptr)
 	, fontHandler(nullptr)
 	, lblSysInfo(nullptr)
 	, lblBanner(nullptr)
@@ -95,6 +100,14 @@ RP_ShellPropSheetExt_Private::RP_ShellPropSheetExt_Private(RP_ShellPropSheetExt
 
 RP_ShellPropSheetExt_Private::~RP_ShellPropSheetExt_Private()
 {
+	// Wait for the RomData loader thread to finish, if it's running.
+	// The thread uses tfilename and writes to romData.
+	if (hLoadThread) {
+		WaitForSingleObject(hLoadThread, INFINITE);
+		CloseHandle(hLoadThread);
+		hLoadThread = nullptr;
+	}
+
 	// Delete the banner and icon frames.
 	delete lblBanner;
 	delete lblIcon;
@@ -911,6 +924,14 @@ int RP_ShellPropSheetExt_Private::initListData(_In_ HWND hWndTab,
 		checkboxes = field.data.list_data.mxd.checkboxes;
 	}
 
+	// Maximum number of rows to measure with GDI for column widths.
+	// The ListView is LVS_OWNERDATA, so the control itself doesn't
+	// care about the row count; the only remaining per-row GDI work
+	// is the text measurement for the column widths. Measuring a
+	// bounded sample keeps dialog creation time independent of the
+	// row count for large lists, e.g. XDVDFS file listings.
+	static constexpr int LV_MEASURE_ROWS_MAX = 100;
+
 	int lv_row_num = 0;
 	int nl_max = 0;	// Highest number of newlines in any string.
 	for (const auto &data_row : *list_data) {
@@ -992,12 +1013,19 @@ int RP_ShellPropSheetExt_Private::initListData(_In_ HWND hWndTab,
 					}
 				}
 
-				int nl_count;
-				const int width = LibWin32UI::measureStringForListView(hDC, tstr, &nl_count);
-				if (col < colCount) {
-					lvData.col_widths[col] = std::max(lvData.col_widths[col], width);
+				if (lv_row_num < LV_MEASURE_ROWS_MAX) {
+					int nl_count;
+					const int width = LibWin32UI::measureStringForListView(hDC, tstr, &nl_count);
+					if (col < colCount) {
+						lvData.col_widths[col] = std::max(lvData.col_widths[col], width);
+					}
+					nl_max = std::max(nl_max, nl_count);
+				} else {
+					// Row sample limit reached. Skip the GDI measurement,
+					// but still count newlines for the icon sizing.
+					const int nl_count = static_cast<int>(std::count(tstr.cbegin(), tstr.cend(), _T('\n')));
+					nl_max = std::max(nl_max, nl_count);
 				}
-				nl_max = std::max(nl_max, nl_count);
 
 				// TODO: Store the icon index if necessary.
 				lv_row_data.emplace_back(std::move(tstr));
@@ -2100,6 +2128,128 @@ void RP_ShellPropSheetExt_Private::initDialog(void)
 	isFullyInit = true;
 }
 
+/**
+ * Start the RomData loader thread.
+ * Shows the "Loading..." placeholder and returns immediately;
+ * WM_RPPSE_ROMDATA_READY is posted to hDlgSheet when done.
+ */
+void RP_ShellPropSheetExt_Private::startRomDataLoadThread(void)
+{
+	if (hLoadThread) {
+		// Loader thread is already running.
+		return;
+	}
+
+	// Show a "Loading..." placeholder while the loader thread runs.
+	if (!lblLoading) {
+		RECT rectDlg;
+		GetClientRect(hDlgSheet, &rectDlg);
+		// tr: Placeholder text shown while the ROM is being parsed.
+		const tstring tsLoading = U82T_c(C_("RomDataView", "Loading ROM data..."));
+		lblLoading = CreateWindowEx(WS_EX_NOPARENTNOTIFY | WS_EX_TRANSPARENT | dwExStyleRTL,
+			WC_STATIC, tsLoading.c_str(),
+			WS_CHILD | WS_VISIBLE | SS_CENTER,
+			0, rectDlg.bottom / 2, rectDlg.right, 16,
+			hDlgSheet, (HMENU)IDC_STATIC, nullptr, nullptr);
+		SetWindowFont(lblLoading, GetWindowFont(hDlgSheet), false);
+	}
+
+	// Create the loader thread.
+	hLoadThread = (HANDLE)_beginthreadex(nullptr, 0, RomDataLoadThreadProc, this, 0, nullptr);
+	if (!hLoadThread) {
+		// Couldn't create the thread. Load synchronously instead.
+		// WM_RPPSE_ROMDATA_READY will be processed by the message loop.
+		RomDataLoadThreadProc(this);
+	}
+}
+
+/**
+ * RomData loader thread procedure.
+ *
+ * Opens the RomData object and materializes its fields and
+ * internal images, then posts WM_RPPSE_ROMDATA_READY to the
+ * property page dialog.
+ *
+ * This function should be created in a separate thread using _beginthreadex().
+ * @param lpParameter RP_ShellPropSheetExt_Private*
+ * @return 0 on success; non-zero on error.
+ */
+unsigned int WINAPI RP_ShellPropSheetExt_Private::RomDataLoadThreadProc(LPVOID lpParameter)
+{
+	auto *const d = static_cast<RP_ShellPropSheetExt_Private*>(lpParameter);
+
+	// Get the appropriate RomData class for this ROM.
+	RomDataPtr romData = RomDataFactory::create(d->tfilename);
+	if (romData) {
+		// Materialize the field data. (may require file I/O)
+		romData->fields();
+
+		// Cache the internal images so loadImages() on the
+		// UI thread doesn't have to do any file I/O.
+		const uint32_t imgbf = romData->supportedImageTypes();
+		if (imgbf & RomData::IMGBF_INT_BANNER) {
+			romData->image(RomData::IMG_INT_BANNER);
+		}
+		if (imgbf & RomData::IMGBF_INT_ICON) {
+			romData->image(RomData::IMG_INT_ICON);
+			romData->iconAnimData();
+		}
+	}
+	d->romData = std::move(romData);
+
+	// Tell the dialog the RomData object is ready.
+	// NOTE: If the dialog has already been destroyed, PostMessage()
+	// fails harmlessly; the destructor waits for this thread.
+	PostMessage(d->hDlgSheet, WM_RPPSE_ROMDATA_READY, 0, 0);
+	return (d->romData ? 0 : 1);
+}
+
+/**
+ * The RomData loader thread has finished.
+ * Called by WM_RPPSE_ROMDATA_READY on the UI thread.
+ * Populates the dialog if the RomData object was loaded.
+ */
+void RP_ShellPropSheetExt_Private::romDataLoadFinished(void)
+{
+	// Reap the loader thread handle.
+	if (hLoadThread) {
+		WaitForSingleObject(hLoadThread, INFINITE);
+		CloseHandle(hLoadThread);
+		hLoadThread = nullptr;
+	}
+
+	// Remove the "Loading..." placeholder.
+	if (lblLoading) {
+		DestroyWindow(lblLoading);
+		lblLoading = nullptr;
+	}
+
+	assert(!isFullyInit);
+	if (isFullyInit) {
+		// Dialog is already initialized.
+		return;
+	}
+	if (!romData) {
+		// Unable to get a RomData object.
+		return;
+	}
+
+	// Load the images.
+	loadImages();
+	// Initialize the dialog.
+	initDialog();
+	// We can close the RomData's underlying IRpFile now.
+	romData->close();
+
+	// Create the "Options" button in the parent window.
+	createOptionsButton();
+
+	// Start the icon animation timer.
+	if (lblIcon) {
+		lblIcon->startAnimTimer();
+	}
+}
+
 /** RP_ShellPropSheetExt **/
 
 RP_ShellPropSheetExt::RP_ShellPropSheetExt()
@@ -2749,30 +2899,27 @@ INT_PTR CALLBACK RP_ShellPropSheetExt_Private::DlgProc(HWND hDlg, UINT uMsg, WPA
 				break;
 			}
 
-			// Get the appropriate RomData class for this ROM.
-			d->romData = RomDataFactory::create(d->tfilename);
-			if (!d->romData) {
-				// Unable to get a RomData object.
-				break;
-			}
-
-			// Load the images.
-			d->loadImages();
-			// Initialize the dialog.
-			d->initDialog();
-			// We can close the RomData's underlying IRpFile now.
-			d->romData->close();
+			// Load the RomData object on a worker thread so the
+			// property sheet shows up immediately, even if the
+			// file is on a slow (e.g. network) file system.
+			// The dialog is populated once the loader thread
+			// posts WM_RPPSE_ROMDATA_READY.
+			d->startRomDataLoadThread();
 
-			// Create the "Options" button in the parent window.
-			d->createOptionsButton();
+			// Continue normal processing.
+			break;
+		}
 
-			// Start the icon animation timer.
-			if (d->lblIcon) {
-				d->lblIcon->startAnimTimer();
+		case WM_RPPSE_ROMDATA_READY: {
+			auto *const d = reinterpret_cast<RP_ShellPropSheetExt_Private*>(GetWindowLongPtr(hDlg, GWLP_USERDATA));
+			if (!d) {
+				// No RP_ShellPropSheetExt_Private. Can't do anything...
+				return false;
 			}
 
-			// Continue normal processing.
-			break;
+			// The RomData loader thread has finished.
+			d->romDataLoadFinished();
+			return true;
 		}
 
 		case WM_DESTROY: {
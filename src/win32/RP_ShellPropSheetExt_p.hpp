@@ -23,6 +23,11 @@
 // Bitfield is last due to multiple controls per field.
 #define IDC_RFT_BITFIELD(idx, bit)	(0x7000 + ((idx) * 32) + (bit))
 
+// Sent to the property page dialog by the RomData loader thread
+// when the RomData object is ready. (no parameters)
+// NOTE: Above the PSM_* range to avoid conflicts with the property sheet.
+#define WM_RPPSE_ROMDATA_READY		(WM_USER + 0x200)
+
 // librpbase
 namespace LibRpBase {
 	class RomData;
@@ -77,8 +82,19 @@ public:
 	// ROM filename (malloc'd; free on delete)
 	TCHAR *tfilename;
 	// ROM data (Not opened until the properties tab is shown.)
+	// NOTE: Written by the loader thread; only read by the UI thread
+	// after WM_RPPSE_ROMDATA_READY has been received.
 	LibRpBase::RomDataPtr romData;
 
+	// RomData loader thread.
+	// RomData parsing and field/image loading is done on a worker
+	// thread so the property sheet opens immediately, even if the
+	// file is on a slow (e.g. network) file system.
+	HANDLE hLoadThread;
+	// "Loading..." placeholder label, shown while the loader
+	// thread is running. Destroyed once the fields are populated.
+	HWND lblLoading;
+
 	// Font handler
 	FontHandler fontHandler;
 
@@ -315,6 +331,35 @@ private:
 	 */
 	int updateField(int fieldIdx);
 
+public:
+	/**
+	 * Start the RomData loader thread.
+	 * Shows the "Loading..." placeholder and returns immediately;
+	 * WM_RPPSE_ROMDATA_READY is posted to hDlgSheet when done.
+	 */
+	void startRomDataLoadThread(void);
+
+	/**
+	 * The RomData loader thread has finished.
+	 * Called by WM_RPPSE_ROMDATA_READY on the UI thread.
+	 * Populates the dialog if the RomData object was loaded.
+	 */
+	void romDataLoadFinished(void);
+
+private:
+	/**
+	 * RomData loader thread procedure.
+	 *
+	 * Opens the RomData object and materializes its fields and
+	 * internal images, then posts WM_RPPSE_ROMDATA_READY to the
+	 * property page dialog.
+	 *
+	 * This function should be created in a separate thread using _beginthreadex().
+	 * @param lpParameter RP_ShellPropSheetExt_Private*
+	 * @return 0 on success; non-zero on error.
+	 */
+	static unsigned int WINAPI RomDataLoadThreadProc(LPVOID lpParameter);
+
 public:
 	/**
 	 * Initialize the dialog. (hDlgSheet)
@@ -17,7 +17,11 @@ using namespace LibRpFile;
 using LibWin32UI::RegKey;
 
 // C++ STL classes.
+#include <mutex>
+#include <unordered_map>
 using std::string;
+using std::tstring;
+using std::unordered_map;
 using std::wstring;
 
 // COM smart pointer typedefs.
@@ -28,28 +32,62 @@ _COM_SMARTPTR_TYPEDEF(IClassFactory, IID_IClassFactory);
 _COM_SMARTPTR_TYPEDEF(IInitializeWithStream, IID_IInitializeWithStream);
 _COM_SMARTPTR_TYPEDEF(IThumbnailProvider,    IID_IThumbnailProvider);
 
+/** Negative-result cache **/
+
+// Whether a usable fallback thumbnail handler exists for a given
+// association key is a property of the registry, not of the file.
+// Cache failures that occur before the file is involved so that a
+// directory full of unsupported files doesn't repeat the registry
+// walk and COM instantiation for every single file.
+static std::mutex fallback_neg_cache_mutex;
+static unordered_map<tstring, HRESULT> fallback_neg_cache;
+
+/**
+ * Record a file-independent fallback failure for an association key.
+ * @param assoc_name Name of the association key. (extension or ProgID)
+ * @param hr Failed HRESULT.
+ * @return hr (for tail calls)
+ */
+static HRESULT Fallback_cacheNegative(const tstring &assoc_name, HRESULT hr)
+{
+	std::lock_guard<std::mutex> lock(fallback_neg_cache_mutex);
+	fallback_neg_cache.emplace(assoc_name, hr);
+	return hr;
+}
+
 /**
  * Fallback thumbnail handler function. (internal)
  * @param hkey_Assoc File association key to check.
+ * @param assoc_name Name of the association key. (extension or ProgID; for the negative cache)
  * @param cx
  * @param phbmp
  * @param pdwAlpha
  * @return HRESULT.
  */
-HRESULT RP_ThumbnailProvider_Private::Fallback_int(RegKey &hkey_Assoc,
+HRESULT RP_ThumbnailProvider_Private::Fallback_int(RegKey &hkey_Assoc, const tstring &assoc_name,
 	UINT cx, HBITMAP *phbmp, WTS_ALPHATYPE *pdwAlpha)
 {
+	// If this association previously failed before reaching the
+	// file, it will fail again. Don't redo the COM instantiation.
+	{
+		std::lock_guard<std::mutex> lock(fallback_neg_cache_mutex);
+		auto iter = fallback_neg_cache.find(assoc_name);
+		if (iter != fallback_neg_cache.end()) {
+			return iter->second;
+		}
+	}
+
 	// Is RP_Fallback present?
 	RegKey hkey_RP_Fallback(hkey_Assoc, _T("RP_Fallback"), KEY_READ, false);
 	if (!hkey_RP_Fallback.isOpen()) {
-		return hkey_RP_Fallback.lOpenRes();
+		return Fallback_cacheNegative(assoc_name, hkey_RP_Fallback.lOpenRes());
 	}
 
 	// Get the IThumbnailProvider key.
 	const tstring clsid_reg = hkey_RP_Fallback.read(_T("IThumbnailProvider"));
 	if (clsid_reg.empty()) {
 		// No CLSID.
-		return E_FAIL;
+		return Fallback_cacheNegative(assoc_name, E_FAIL);
 	}
 
 	// Parse the CLSID string.
@@ -59,7 +97,7 @@ HRESULT RP_ThumbnailProvider_Private::Fallback_int(RegKey &hkey_Assoc,
 	HRESULT hr = CLSIDFromString(clsid_reg.c_str(), &clsidThumbnailProvider);
 	if (FAILED(hr)) {
 		// Failed to convert the CLSID from string.
-		return hr;
+		return Fallback_cacheNegative(assoc_name, hr);
 	}
 
 	// Get the class object.
@@ -67,7 +105,7 @@ HRESULT RP_ThumbnailProvider_Private::Fallback_int(RegKey &hkey_Assoc,
 	hr = CoGetClassObject(clsidThumbnailProvider, CLSCTX_INPROC_SERVER, nullptr, IID_PPV_ARGS(&pCF));
 	if (FAILED(hr) || !pCF) {
 		// Failed to get the IClassFactory.
-		return hr;
+		return Fallback_cacheNegative(assoc_name, (FAILED(hr) ? hr : E_FAIL));
 	}
 
 	// Try getting the IInitializeWithStream interface.
@@ -76,7 +114,7 @@ HRESULT RP_ThumbnailProvider_Private::Fallback_int(RegKey &hkey_Assoc,
 	hr = pCF->CreateInstance(nullptr, IID_PPV_ARGS(&pInitializeWithStream));
 	if (FAILED(hr) || !pInitializeWithStream) {
 		// Failed to get the IInitializeWithStream.
-		return hr;
+		return Fallback_cacheNegative(assoc_name, (FAILED(hr) ? hr : E_FAIL));
 	}
 
 	// Rewind the file.
@@ -121,7 +159,8 @@ HRESULT RP_ThumbnailProvider_Private::Fallback(UINT cx, HBITMAP *phbmp, WTS_ALPH
 	}
 
 	// Open the filetype key in HKCR.
-	RegKey hkey_Assoc(HKEY_CLASSES_ROOT, U82T_c(ext), KEY_READ, false);
+	const tstring t_ext = U82T_c(ext);
+	RegKey hkey_Assoc(HKEY_CLASSES_ROOT, t_ext.c_str(), KEY_READ, false);
 	if (!hkey_Assoc.isOpen()) {
 		return hkey_Assoc.lOpenRes();
 	}
@@ -133,7 +172,7 @@ HRESULT RP_ThumbnailProvider_Private::Fallback(UINT cx, HBITMAP *phbmp, WTS_ALPH
 		// TODO: Get the correct top-level registry key.
 		RegKey hkcr_ProgID(HKEY_CLASSES_ROOT, progID.c_str(), KEY_READ, false);
 		if (hkcr_ProgID.isOpen()) {
-			HRESULT hr = Fallback_int(hkcr_ProgID, cx, phbmp, pdwAlpha);
+			HRESULT hr = Fallback_int(hkcr_ProgID, progID, cx, phbmp, pdwAlpha);
 			if (SUCCEEDED(hr)) {
 				// ProgID thumbnail extracted.
 				return hr;
@@ -142,5 +181,5 @@ HRESULT RP_ThumbnailProvider_Private::Fallback(UINT cx, HBITMAP *phbmp, WTS_ALPH
 	}
 
 	// Extract the thumbnail from the filetype key.
-	return Fallback_int(hkey_Assoc, cx, phbmp, pdwAlpha);
+	return Fallback_int(hkey_Assoc, t_ext, cx, phbmp, pdwAlpha);
 }
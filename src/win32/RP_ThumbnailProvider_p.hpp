@@ -69,12 +69,13 @@ private:
 	/**
 	 * Fallback thumbnail handler function. (internal)
 	 * @param hkey_Assoc File association key to check.
+	 * @param assoc_name Name of the association key. (extension or ProgID; for the negative cache)
 	 * @param cx
 	 * @param phbmp
 	 * @param pdwAlpha
 	 * @return HRESULT.
 	 */
-	HRESULT Fallback_int(LibWin32UI::RegKey &hkey_Assoc,
+	HRESULT Fallback_int(LibWin32UI::RegKey &hkey_Assoc, const std::tstring &assoc_name,
 		UINT cx, HBITMAP *phbmp, WTS_ALPHATYPE *pdwAlpha);
 
 public:
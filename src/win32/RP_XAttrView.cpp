@@ -31,6 +31,9 @@ using LibWin32UI::LoadDialog_i18n;
 // NOTE: Does not depend on the Windows SDK.
 #include "librpfile/xattr/dos_attrs.h"
 
+// MSVCRT-specific [for _beginthreadex()]
+#include <process.h>
+
 // C++ STL classes
 using std::array;
 using std::tstring;
@@ -58,6 +61,7 @@ RP_XAttrView_Private::RP_XAttrView_Private(RP_XAttrView *q, LPTSTR tfilename)
 	: q_ptr(q)
 	, hDlgSheet(nullptr)
 	, tfilename(tfilename)
+	, hLoadThread(nullptr)
 	, dwExStyleRTL(LibWin32UI::isSystemRTL())
 	, colorAltRow(0)	// initialized later
 	, isDarkModeEnabled(false)
@@ -66,6 +70,14 @@ RP_XAttrView_Private::RP_XAttrView_Private(RP_XAttrView *q, LPTSTR tfilename)
 
 RP_XAttrView_Private::~RP_XAttrView_Private()
 {
+	// Wait for the xattr loader thread to finish, if it's running.
+	// The thread uses tfilename and writes to xattrReader.
+	if (hLoadThread) {
+		WaitForSingleObject(hLoadThread, INFINITE);
+		CloseHandle(hLoadThread);
+		hLoadThread = nullptr;
+	}
+
 	free(tfilename);
 }
 
@@ -178,26 +190,18 @@ int RP_XAttrView_Private::loadADS(void)
 }
 
 /**
- * Load the attributes from the specified file.
- * The attributes will be loaded into the display widgets.
+ * Load the attributes into the display widgets.
+ * The XAttrReader object must have been loaded by the
+ * loader thread first.
  * @return 0 on success; negative POSIX error code on error.
  */
 int RP_XAttrView_Private::loadAttributes(void)
 {
-	if (!tfilename) {
-		// No filename.
-		xattrReader.reset();
-		return -EIO;
-	}
-
-	// Open an XAttrReader.
-	xattrReader.reset(new XAttrReader(tfilename));
-	int err = xattrReader->lastError();
-	if (err != 0) {
-		// Error reading attributes.
+	if (!xattrReader) {
+		// No attributes were loaded.
 		// TODO: Cancel tab loading?
-		xattrReader.reset();
-		return err;
+		clearDisplayWidgets();
+		return -EIO;
 	}
 
 	// Load the attributes.
@@ -234,6 +238,82 @@ void RP_XAttrView_Private::clearDisplayWidgets()
 	ListView_DeleteAllItems(GetDlgItem(hDlgSheet, IDC_XATTRVIEW_LISTVIEW_ADS));
 }
 
+/**
+ * Start the xattr loader thread.
+ * Returns immediately; WM_RPXAV_XATTRS_READY is posted
+ * to hDlgSheet when done.
+ */
+void RP_XAttrView_Private::startXAttrLoadThread(void)
+{
+	if (hLoadThread) {
+		// Loader thread is already running.
+		return;
+	}
+
+	if (!tfilename) {
+		// No filename.
+		xattrReader.reset();
+		clearDisplayWidgets();
+		return;
+	}
+
+	// Create the loader thread.
+	hLoadThread = (HANDLE)_beginthreadex(nullptr, 0, XAttrLoadThreadProc, this, 0, nullptr);
+	if (!hLoadThread) {
+		// Couldn't create the thread. Load synchronously instead.
+		// WM_RPXAV_XATTRS_READY will be processed by the message loop.
+		XAttrLoadThreadProc(this);
+	}
+}
+
+/**
+ * xattr loader thread procedure.
+ *
+ * Opens an XAttrReader for the file, then posts
+ * WM_RPXAV_XATTRS_READY to the property page dialog.
+ *
+ * This function should be created in a separate thread using _beginthreadex().
+ * @param lpParameter RP_XAttrView_Private*
+ * @return 0 on success; non-zero on error.
+ */
+unsigned int WINAPI RP_XAttrView_Private::XAttrLoadThreadProc(LPVOID lpParameter)
+{
+	auto *const d = static_cast<RP_XAttrView_Private*>(lpParameter);
+
+	// Open an XAttrReader. (may require file I/O)
+	unique_ptr<XAttrReader> xattrReader(new XAttrReader(d->tfilename));
+	if (xattrReader->lastError() != 0) {
+		// Error reading attributes.
+		xattrReader.reset();
+	}
+	d->xattrReader = std::move(xattrReader);
+
+	// Tell the dialog the XAttrReader object is ready.
+	// NOTE: If the dialog has already been destroyed, PostMessage()
+	// fails harmlessly; the destructor waits for this thread.
+	PostMessage(d->hDlgSheet, WM_RPXAV_XATTRS_READY, 0, 0);
+	return (d->xattrReader ? 0 : 1);
+}
+
+/**
+ * The xattr loader thread has finished.
+ * Called by WM_RPXAV_XATTRS_READY on the UI thread.
+ * Populates the display widgets if attributes were loaded.
+ */
+void RP_XAttrView_Private::xattrLoadFinished(void)
+{
+	// Reap the loader thread handle.
+	if (hLoadThread) {
+		WaitForSingleObject(hLoadThread, INFINITE);
+		CloseHandle(hLoadThread);
+		hLoadThread = nullptr;
+	}
+
+	// Load the attributes into the display widgets.
+	// TODO: Cancel tab loading if it fails?
+	loadAttributes();
+}
+
 /**
  * Initialize the dialog. (hDlgSheet)
  * Called by WM_INITDIALOG.
@@ -275,9 +355,10 @@ void RP_XAttrView_Private::initDialog(void)
 	// Initialize the alternate row color.
 	colorAltRow = LibWin32UI::ListView_GetBkColor_AltRow(hListViewADS);
 
-	// Load attributes.
-	// TODO: Cancel tab loading if it fails?
-	loadAttributes();
+	// Start the xattr loader thread.
+	// The display widgets will be populated when
+	// WM_RPXAV_XATTRS_READY is received.
+	startXAttrLoadThread();
 
 	// Window is fully initialized.
 	isFullyInit = true;
@@ -623,6 +704,18 @@ INT_PTR CALLBACK RP_XAttrView_Private::DlgProc(HWND hDlg, UINT uMsg, WPARAM wPar
 			return d->DlgProc_WM_NOTIFY(hDlg, reinterpret_cast<NMHDR*>(lParam));
 		}
 
+		case WM_RPXAV_XATTRS_READY: {
+			auto *const d = reinterpret_cast<RP_XAttrView_Private*>(GetWindowLongPtr(hDlg, GWLP_USERDATA));
+			if (!d) {
+				// No RP_XAttrView_Private. Can't do anything...
+				return false;
+			}
+
+			// The xattr loader thread has finished.
+			d->xattrLoadFinished();
+			return true;
+		}
+
 		case WM_SYSCOLORCHANGE:
 		case WM_THEMECHANGED: {
 			auto* const d = reinterpret_cast<RP_XAttrView_Private*>(GetWindowLongPtr(hDlg, GWLP_USERDATA));
@@ -17,6 +17,11 @@ namespace LibRpFile {
 // TCHAR
 #include "tcharx.h"
 
+// Sent to the property page dialog by the xattr loader thread
+// when the XAttrReader object is ready. (no parameters)
+// NOTE: Above the PSM_* range to avoid conflicts with the property sheet.
+#define WM_RPXAV_XATTRS_READY		(WM_USER + 0x200)
+
 /** RP_XAttrView_Private **/
 // Workaround for RP_D() expecting the no-underscore naming convention.
 #define RP_XAttrViewPrivate RP_XAttrView_Private
@@ -45,7 +50,17 @@ public:
 public:
 	HWND hDlgSheet;				// Property sheet
 	LPTSTR tfilename;			// Opened file
-	std::unique_ptr<LibRpFile::XAttrReader> xattrReader;	// XAttrReader
+
+	// XAttrReader
+	// NOTE: Written by the loader thread; only read by the UI thread
+	// after WM_RPXAV_XATTRS_READY has been received.
+	std::unique_ptr<LibRpFile::XAttrReader> xattrReader;
+
+	// xattr loader thread.
+	// Attribute reading is done on a worker thread so the property
+	// sheet opens immediately, even if the file is on a slow
+	// (e.g. network) file system.
+	HANDLE hLoadThread;
 
 	// wtsapi32.dll for Remote Desktop status. (WinXP and later)
 	LibWin32UI::WTSSessionNotification wts;
@@ -86,8 +101,9 @@ private:
 
 public:
 	/**
-	 * Load the attributes from the specified file.
-	 * The attributes will be loaded into the display widgets.
+	 * Load the attributes into the display widgets.
+	 * The XAttrReader object must have been loaded by the
+	 * loader thread first.
 	 * @return 0 on success; negative POSIX error code on error.
 	 */
 	int loadAttributes(void);
@@ -97,6 +113,34 @@ public:
 	 */
 	void clearDisplayWidgets();
 
+public:
+	/**
+	 * Start the xattr loader thread.
+	 * Returns immediately; WM_RPXAV_XATTRS_READY is posted
+	 * to hDlgSheet when done.
+	 */
+	void startXAttrLoadThread(void);
+
+	/**
+	 * The xattr loader thread has finished.
+	 * Called by WM_RPXAV_XATTRS_READY on the UI thread.
+	 * Populates the display widgets if attributes were loaded.
+	 */
+	void xattrLoadFinished(void);
+
+private:
+	/**
+	 * xattr loader thread procedure.
+	 *
+	 * Opens an XAttrReader for the file, then posts
+	 * WM_RPXAV_XATTRS_READY to the property page dialog.
+	 *
+	 * This function should be created in a separate thread using _beginthreadex().
+	 * @param lpParameter RP_XAttrView_Private*
+	 * @return 0 on success; non-zero on error.
+	 */
+	static unsigned int WINAPI XAttrLoadThreadProc(LPVOID lpParameter);
+
 public:
 	/**
 	 * Initialize the dialog. (hDlgSheet)
@@ -210,6 +210,92 @@ static inline HBITMAP toHBITMAP_mask(const rp_image_const_ptr &image)
 	return toHBITMAP_mask(image.get());
 }
 
+/**
+ * Convert an ARGB32 or CI8 rp_image to a 32-bit DIB section directly.
+ * Alpha transparency is preserved.
+ *
+ * This skips GDI+ entirely, which matters for the common
+ * thumbnail case: no GDI+ locking, and no dependency on the
+ * image using RpGdiplusBackend.
+ *
+ * @param image rp_image. (must be ARGB32 or CI8)
+ * @return HBITMAP, or nullptr on error.
+ */
+static HBITMAP toHBITMAP_alpha_dib(const rp_image *image)
+{
+	assert(image->format() == rp_image::Format::ARGB32 ||
+	       image->format() == rp_image::Format::CI8);
+
+	BITMAPINFO bmi;
+	BITMAPINFOHEADER *const bmiHeader = &bmi.bmiHeader;
+
+	// Initialize the BITMAPINFOHEADER.
+	// Reference: https://docs.microsoft.com/en-us/windows/win32/api/wingdi/ns-wingdi-bitmapinfoheader
+	bmiHeader->biSize = sizeof(BITMAPINFOHEADER);
+	bmiHeader->biWidth = image->width();
+	bmiHeader->biHeight = -image->height();	// Top-down
+	bmiHeader->biPlanes = 1;
+	bmiHeader->biBitCount = 32;
+	bmiHeader->biCompression = BI_RGB;
+	bmiHeader->biSizeImage = 0;	// TODO?
+	bmiHeader->biXPelsPerMeter = 0;	// TODO
+	bmiHeader->biYPelsPerMeter = 0;	// TODO
+	bmiHeader->biClrUsed = 0;
+	bmiHeader->biClrImportant = 0;
+
+	// Create the bitmap.
+	uint8_t *pvBits;
+	HBITMAP hBitmap = CreateDIBSection(nullptr, &bmi, DIB_RGB_COLORS,
+		reinterpret_cast<void**>(&pvBits), nullptr, 0);
+	if (!hBitmap) {
+		// Could not create the bitmap.
+		return nullptr;
+	}
+
+	const int src_stride = image->stride();
+	if (image->format() == rp_image::Format::CI8) {
+		// Decode CI8 directly into the DIB section.
+		// NOTE: Windows doesn't really like CI8+alpha, so the
+		// DIB section is always 32-bit; this is just a palette
+		// lookup per pixel, without the GDI+ detour.
+		const uint32_t *const palette = image->palette();
+		const unsigned int palette_len = image->palette_len();
+		const uint8_t *src = static_cast<const uint8_t*>(image->bits());
+		uint32_t *dest = reinterpret_cast<uint32_t*>(pvBits);
+		const int width = image->width();
+		for (int y = image->height(); y > 0; y--) {
+			for (int x = 0; x < width; x++) {
+				const uint8_t px = src[x];
+				*dest++ = (px < palette_len) ? palette[px] : 0;
+			}
+			src += src_stride;
+		}
+
+		// Bitmap is ready.
+		return hBitmap;
+	}
+
+	// Copy the ARGB32 image data into the DIB section.
+	// HBITMAP stride is a multiple of 4, so we can assume that
+	// it's equal to row_bytes.
+	const size_t row_bytes = image->width() * 4;
+	if (row_bytes == static_cast<size_t>(src_stride)) {
+		// Copy the entire image all at once.
+		memcpy(pvBits, image->bits(), src_stride * image->height());
+	} else {
+		// Copy one line at a time.
+		const uint8_t *src = static_cast<const uint8_t*>(image->bits());
+		for (int y = image->height(); y > 0; y--) {
+			memcpy(pvBits, src, row_bytes);
+			pvBits += row_bytes;
+			src += src_stride;
+		}
+	}
+
+	// Bitmap is ready.
+	return hBitmap;
+}
+
 /**
  * Convert an rp_image to HBITMAP.
  * @return image rp_image.
@@ -300,6 +386,16 @@ HBITMAP toHBITMAP_alpha(const rp_image *image, SIZE size, bool nearest)
 		return nullptr;
 	}
 
+	// Fast path: ARGB32 or CI8 with no resizing can be converted
+	// to a 32-bit DIB section directly, skipping GDI+ entirely.
+	if ((image->format() == rp_image::Format::ARGB32 ||
+	     image->format() == rp_image::Format::CI8) &&
+	    (size.cx <= 0 || size.cy <= 0 ||
+	     (size.cx == image->width() && size.cy == image->height())))
+	{
+		return toHBITMAP_alpha_dib(image);
+	}
+
 	// We should be using the RpGdiplusBackend.
 	const RpGdiplusBackend *backend =
 		dynamic_cast<const RpGdiplusBackend*>(image->backend());
@@ -350,18 +446,10 @@ HICON toHICON(const rp_image *image)
 		}
 	}
 
-	// We should be using the RpGdiplusBackend.
-	const RpGdiplusBackend *backend =
-		dynamic_cast<const RpGdiplusBackend*>(image->backend());
-	assert(backend != nullptr);
-	if (!backend) {
-		// Incorrect backend set.
-		return nullptr;
-	}
-
 	// Convert to HBITMAP first.
-	// TODO: Const-ness stuff.
-	hBitmap = const_cast<RpGdiplusBackend*>(backend)->toHBITMAP_alpha();
+	// NOTE: toHBITMAP_alpha() uses the direct DIB section path
+	// for ARGB32 and CI8, and falls back to GDI+ otherwise.
+	hBitmap = toHBITMAP_alpha(image);
 	if (!hBitmap)
 		goto cleanup;
 
@@ -515,14 +603,9 @@ HICON toHICON(HBITMAP hBitmap)
 		}
 
 		// Create a new temporary bitmap.
-		const RpGdiplusBackend* backend =
-			dynamic_cast<const RpGdiplusBackend*>(img->backend());
-		assert(backend != nullptr);
-		if (!backend) {
-			// Incorrect backend set.
-			return nullptr;
-		}
-		hBmpTmp = const_cast<RpGdiplusBackend*>(backend)->toHBITMAP_alpha();
+		// NOTE: fromHBITMAP() returns ARGB32, so this takes
+		// the direct DIB section path.
+		hBmpTmp = toHBITMAP_alpha(img.get());
 		if (hBmpTmp) {
 			hBitmap = hBmpTmp;
 		}
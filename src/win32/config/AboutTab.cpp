@@ -214,17 +214,20 @@ protected:
 	void initProgramTitleText(void);
 
 	/**
-	 * Initialize the "Credits" tab.
+	 * Build the "Credits" tab RTF document.
+	 * Called lazily by setTabContents().
 	 */
 	void initCreditsTab(void);
 
 	/**
-	 * Initialize the "Libraries" tab.
+	 * Build the "Libraries" tab RTF document.
+	 * Called lazily by setTabContents().
 	 */
 	void initLibrariesTab(void);
 
 	/**
-	 * Initialize the "Support" tab.
+	 * Build the "Support" tab RTF document.
+	 * Called lazily by setTabContents().
 	 */
 	void initSupportTab(void);
 
@@ -981,7 +984,8 @@ void AboutTabPrivate::initProgramTitleText(void)
 }
 
 /**
- * Initialize the "Credits" tab.
+ * Build the "Credits" tab RTF document.
+ * Called lazily by setTabContents().
  */
 void AboutTabPrivate::initCreditsTab(void)
 {
@@ -1064,17 +1068,11 @@ void AboutTabPrivate::initCreditsTab(void)
 	}
 
 	sCredits += '}';
-
-	// Add the "Credits" tab.
-	const tstring tsTabTitle = U82T_c(C_("AboutTab", "Credits"));
-	TCITEM tcItem;
-	tcItem.mask = TCIF_TEXT;
-	tcItem.pszText = const_cast<LPTSTR>(tsTabTitle.c_str());
-	TabCtrl_InsertItem(GetDlgItem(hWndPropSheet, IDC_ABOUT_TABCONTROL), 0, &tcItem);
 }
 
 /**
- * Initialize the "Libraries" tab.
+ * Build the "Libraries" tab RTF document.
+ * Called lazily by setTabContents().
  */
 void AboutTabPrivate::initLibrariesTab(void)
 {
@@ -1239,17 +1237,11 @@ void AboutTabPrivate::initLibrariesTab(void)
 #endif /* HAVE_GETTEXT && LIBINTL_VERSION */
 
 	sLibraries += '}';
-
-	// Add the "Libraries" tab.
-	const tstring tsTabTitle = U82T_c(C_("AboutTab", "Libraries"));
-	TCITEM tcItem;
-	tcItem.mask = TCIF_TEXT;
-	tcItem.pszText = const_cast<LPTSTR>(tsTabTitle.c_str());
-	TabCtrl_InsertItem(GetDlgItem(hWndPropSheet, IDC_ABOUT_TABCONTROL), 1, &tcItem);
 }
 
 /**
- * Initialize the "Support" tab.
+ * Build the "Support" tab RTF document.
+ * Called lazily by setTabContents().
  */
 void AboutTabPrivate::initSupportTab(void)
 {
@@ -1283,13 +1275,6 @@ void AboutTabPrivate::initSupportTab(void)
 	sSupport += RTF_BR RTF_TAB RTF_BULLET " David Korth <";
 	sSupport += rtfFriendlyLink("mailto:gerbilsoft@gerbilsoft.com", "gerbilsoft@gerbilsoft.com");
 	sSupport += ">}";
-
-	// Add the "Support" tab.
-	const tstring tsTabTitle = U82T_c(C_("AboutTab", "Support"));
-	TCITEM tcItem;
-	tcItem.mask = TCIF_TEXT;
-	tcItem.pszText = const_cast<LPTSTR>(tsTabTitle.c_str());
-	TabCtrl_InsertItem(GetDlgItem(hWndPropSheet, IDC_ABOUT_TABCONTROL), 2, &tcItem);
 }
 
 /**
@@ -1315,14 +1300,26 @@ void AboutTabPrivate::setTabContents(int index)
 	// NOTE: EM_SETTEXTEX doesn't seem to work.
 	// We'll need to stream in the text instead.
 	// Reference: https://devblogs.microsoft.com/oldnewthing/20070110-13/?p=28463
+	// NOTE 2: The RTF documents are built lazily on first
+	// selection, so opening the dialog doesn't pay for all
+	// three tabs up front.
 	switch (index) {
 		case 0:
+			if (sCredits.empty()) {
+				initCreditsTab();
+			}
 			rtfCtx_main.str = &sCredits;
 			break;
 		case 1:
+			if (sLibraries.empty()) {
+				initLibrariesTab();
+			}
 			rtfCtx_main.str = &sLibraries;
 			break;
 		case 2:
+			if (sSupport.empty()) {
+				initSupportTab();
+			}
 			rtfCtx_main.str = &sSupport;
 			break;
 		default:
@@ -1501,10 +1498,20 @@ void AboutTabPrivate::initDialog(void)
 	SendMessage(hUpdateCheck, EM_SETEVENTMASK, 0, (LPARAM)(eventMask | ENM_LINK));
 	SendMessage(hUpdateCheck, EM_AUTOURLDETECT, AURL_ENABLEURL, 0);
 
-	// Initialize the tab text.
-	initCreditsTab();
-	initLibrariesTab();
-	initSupportTab();
+	// Add the tab items.
+	// NOTE: The RTF documents are built lazily by setTabContents(),
+	// so only the tab titles are needed here.
+	static const std::array<const char*, MAX_TABS> tabTitles = {{
+		NOP_C_("AboutTab", "Credits"),
+		NOP_C_("AboutTab", "Libraries"),
+		NOP_C_("AboutTab", "Support"),
+	}};
+	for (int i = 0; i < MAX_TABS; i++) {
+		const tstring tsTabTitle = U82T_c(pgettext_expr("AboutTab", tabTitles[i]));
+		tcItem.mask = TCIF_TEXT;
+		tcItem.pszText = const_cast<LPTSTR>(tsTabTitle.c_str());
+		TabCtrl_InsertItem(hTabControl, i, &tcItem);
+	}
 
 	// Subclass the RichEdit controls.
 	// TODO: Error handling?
@@ -523,7 +523,7 @@ int CALLBACK rp_show_config_dialog(
 	}
 
 	// Initialize GDI+.
-	ULONG_PTR gdipToken = GdiplusHelper::InitGDIPlus();
+	const ULONG_PTR gdipToken = GdiplusHelper::AcquireGDIPlus();
 	assert(gdipToken != 0);
 	if (gdipToken == 0) {
 		return EXIT_FAILURE;
@@ -547,7 +547,8 @@ int CALLBACK rp_show_config_dialog(
 	}
 
 	// Shut down GDI+.
-	GdiplusHelper::ShutdownGDIPlus(gdipToken);
+	GdiplusHelper::ReleaseGDIPlus();
+	GdiplusHelper::ShutdownSharedGDIPlus();
 
 	// Uninitialize COM.
 	CoUninitialize();